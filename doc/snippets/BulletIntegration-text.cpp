@@ -0,0 +1,70 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <btBulletDynamicsCommon.h>
+#include <Magnum/PixelFormat.h>
+#include <Magnum/GL/Renderer.h>
+#include <Magnum/Text/AbstractFont.h>
+#include <Magnum/Text/GlyphCacheGL.h>
+
+#include "Magnum/BulletIntegration/DebugDraw.h"
+
+#define DOXYGEN_ELLIPSIS(...) __VA_ARGS__
+
+using namespace Magnum;
+
+/* Make sure the name doesn't conflict with any other snippets to avoid linker
+   warnings, unlike with `int main()` there now has to be a declaration to
+   avoid -Wmisssing-prototypes */
+void mainBulletIntegrationText();
+void mainBulletIntegrationText() {
+{
+btDiscreteDynamicsWorld btDDWorld{nullptr, nullptr, nullptr, nullptr};
+btDynamicsWorld* btWorld = &btDDWorld;
+Text::AbstractFont& font = *static_cast<Text::AbstractFont*>(nullptr);
+Vector2i windowSize;
+/* [DebugDraw-text] */
+/* Glyph cache shared with other text rendering in the app */
+Text::GlyphCacheGL glyphCache{PixelFormat::R8Unorm, {512, 512}};
+font.fillGlyphCache(glyphCache, "abcdefghijklmnopqrstuvwxyz"
+                                "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+                                "0123456789.,:-+ ");
+
+BulletIntegration::DebugDraw debugDraw;
+debugDraw
+    .setMode(BulletIntegration::DebugDraw::Mode::DrawWireframe|
+             BulletIntegration::DebugDraw::Mode::DrawText)
+    .setTextFont(font, glyphCache, 16.0f);
+btWorld->setDebugDrawer(&debugDraw);
+DOXYGEN_ELLIPSIS()
+
+/* Every frame */
+GL::Renderer::enable(GL::Renderer::Feature::Blending);
+debugDraw.setViewportSize(windowSize);
+btWorld->debugDrawWorld();
+/* [DebugDraw-text] */
+}
+}
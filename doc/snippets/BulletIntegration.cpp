@@ -25,11 +25,20 @@
 */
 
 #include <btBulletDynamicsCommon.h>
+#include <BulletSoftBody/btSoftBody.h>
+#include <BulletSoftBody/btSoftRigidDynamicsWorld.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Containers/String.h>
 #include <Magnum/SceneGraph/Object.h>
+#include <Magnum/Shaders/PhongGL.h>
 #include <Magnum/SceneGraph/MatrixTransformation3D.h>
 
 #include "Magnum/BulletIntegration/DebugDraw.h"
 #include "Magnum/BulletIntegration/MotionState.h"
+#include "Magnum/BulletIntegration/Profiler.h"
+#include "Magnum/BulletIntegration/RigidBodySynchronizer.h"
+#include "Magnum/BulletIntegration/ShapeMeshCache.h"
+#include "Magnum/BulletIntegration/SoftBodyMesh.h"
 
 #define DOXYGEN_ELLIPSIS(...) __VA_ARGS__
 
@@ -61,6 +70,79 @@ btWorld->debugDrawWorld();
 /* [DebugDraw-usage-per-frame] */
 }
 
+{
+btDiscreteDynamicsWorld btDDWorld{nullptr, nullptr, nullptr, nullptr};
+btDynamicsWorld* btWorld = &btDDWorld;
+Matrix4 projection, cameraTransformation;
+/* [DebugDraw-compact] */
+BulletIntegration::DebugDraw debugDraw{
+    BulletIntegration::DebugDraw::Flag::PackedColors|
+    BulletIntegration::DebugDraw::Flag::HalfFloatPositions};
+DOXYGEN_ELLIPSIS()
+
+/* Every frame */
+debugDraw
+    .setPositionOrigin(cameraTransformation.translation())
+    .setTransformationProjectionMatrix(projection*cameraTransformation.inverted());
+btWorld->debugDrawWorld();
+/* [DebugDraw-compact] */
+}
+
+{
+btDiscreteDynamicsWorld btDDWorld{nullptr, nullptr, nullptr, nullptr};
+btDynamicsWorld* btWorld = &btDDWorld;
+Matrix4 projection, cameraTransformation;
+/* [DebugDraw-culling] */
+BulletIntegration::DebugDraw debugDraw{
+    BulletIntegration::DebugDraw::Flag::FrustumCulling};
+debugDraw.setContactPointCullDistance(50.0f);
+DOXYGEN_ELLIPSIS()
+
+/* Every frame, the frustum is extracted from the matrix */
+debugDraw
+    .setPositionOrigin(cameraTransformation.translation())
+    .setTransformationProjectionMatrix(projection*cameraTransformation.inverted());
+btWorld->debugDrawWorld();
+/* [DebugDraw-culling] */
+}
+
+{
+btDiscreteDynamicsWorld btDDWorld{nullptr, nullptr, nullptr, nullptr};
+btCollisionWorld* btWorld = &btDDWorld;
+struct {
+    void parallelFor(std::size_t, void(*)(std::size_t)) {}
+} scheduler;
+/* [DebugDraw-threads] */
+BulletIntegration::DebugDraw debugDraw{
+    BulletIntegration::DebugDraw::Flag::ThreadSafe};
+btWorld->setDebugDrawer(&debugDraw);
+DOXYGEN_ELLIPSIS()
+
+/* Every frame, split the objects among worker threads, each calling
+   btCollisionWorld::debugDrawObject() for its range */
+scheduler.parallelFor(btWorld->getNumCollisionObjects(), DOXYGEN_ELLIPSIS(nullptr));
+
+/* Once all threads finish, merge their data and draw everything */
+btWorld->getDebugDrawer()->flushLines();
+/* [DebugDraw-threads] */
+}
+
+#if BT_BULLET_VERSION >= 284
+{
+btDiscreteDynamicsWorld btDDWorld{nullptr, nullptr, nullptr, nullptr};
+btDiscreteDynamicsWorld* btWorld = &btDDWorld;
+BulletIntegration::DebugDraw debugDraw;
+/* [DebugDraw-static] */
+btWorld->setDebugDrawer(&debugDraw);
+DOXYGEN_ELLIPSIS()
+
+/* Every frame, after the simulation step */
+debugDraw.updateStaticObjects(*btWorld);
+btWorld->debugDrawWorld();
+/* [DebugDraw-static] */
+}
+#endif
+
 #ifndef BT_USE_DOUBLE_PRECISION
 {
 /* The include is already above, so doing it again here should be harmless */
@@ -80,6 +162,20 @@ static_cast<void>(c);
 }
 #endif
 
+#ifndef BT_USE_DOUBLE_PRECISION
+{
+btCollisionWorld::AllHitsRayResultCallback callback{{}, {}};
+/* [Integration-bulk] */
+/* Hit points of a btCollisionWorld::rayTest() */
+Containers::ArrayView<const btVector3> hitPoints{
+    &callback.m_hitPointWorld[0], std::size_t(callback.m_hitPointWorld.size())};
+
+Containers::Array<Vector3> positions{NoInit, hitPoints.size()};
+BulletIntegration::convertInto(hitPoints, positions);
+/* [Integration-bulk] */
+}
+#endif
+
 #ifndef BT_USE_DOUBLE_PRECISION
 {
 /* -Wnonnull in GCC 11+  "helpfully" says "this is null" if I don't initialize
@@ -110,4 +206,125 @@ rigidBody->setMotionState(&motionState->btMotionState());
 /* [MotionState-usage-after] */
 }
 #endif
+
+#ifndef BT_USE_DOUBLE_PRECISION
+{
+btDiscreteDynamicsWorld btDDWorld{nullptr, nullptr, nullptr, nullptr};
+Containers::ArrayView<SceneGraph::Object<SceneGraph::MatrixTransformation3D>> objects;
+Float timeStep{};
+/* [RigidBodySynchronizer-usage] */
+btDynamicsWorld* btWorld = DOXYGEN_ELLIPSIS(&btDDWorld);
+BulletIntegration::RigidBodySynchronizer synchronizer;
+synchronizer.reserve(objects.size());
+
+auto collisionShape = new btBoxShape{{0.5f, 0.5f, 0.5f}};
+for(SceneGraph::Object<SceneGraph::MatrixTransformation3D>& object: objects) {
+    auto rigidBody = new btRigidBody{20.0f, nullptr, collisionShape};
+    rigidBody->setWorldTransform(btTransform(object.transformationMatrix()));
+    btWorld->addRigidBody(rigidBody);
+    synchronizer.add(*rigidBody, object);
+}
+
+/* Every frame */
+btWorld->stepSimulation(timeStep);
+synchronizer.synchronize();
+/* [RigidBodySynchronizer-usage] */
+}
+#endif
+
+{
+btDiscreteDynamicsWorld btDDWorld{nullptr, nullptr, nullptr, nullptr};
+btDynamicsWorld* btWorld = &btDDWorld;
+Float frameTime{};
+auto drawEverything = []{};
+/* [RigidBodySynchronizer-interpolation] */
+BulletIntegration::RigidBodySynchronizer synchronizer{
+    BulletIntegration::RigidBodySynchronizer::Flag::Interpolated};
+DOXYGEN_ELLIPSIS()
+
+/* Every frame, step the simulation with a fixed 240 Hz step, synchronizing
+   after each step */
+constexpr Float timeStep = 1.0f/240.0f;
+static Float accumulator = 0.0f;
+accumulator += frameTime;
+while(accumulator >= timeStep) {
+    btWorld->stepSimulation(timeStep, 0);
+    synchronizer.synchronize();
+    accumulator -= timeStep;
+}
+
+/* Then update only the objects that changed and draw */
+synchronizer.interpolate(accumulator/timeStep);
+drawEverything();
+/* [RigidBodySynchronizer-interpolation] */
+}
+
+{
+btSoftRigidDynamicsWorld btSRDWorld{nullptr, nullptr, nullptr, nullptr};
+btSoftBody& cloth = *static_cast<btSoftBody*>(nullptr);
+Float timeStep{};
+Matrix4 transformationMatrix, projectionMatrix;
+/* [SoftBodyMesh-usage] */
+btSoftRigidDynamicsWorld* btWorld = DOXYGEN_ELLIPSIS(&btSRDWorld);
+BulletIntegration::SoftBodyMesh clothMesh{cloth};
+Shaders::PhongGL shader;
+
+/* Every frame */
+btWorld->stepSimulation(timeStep);
+clothMesh.update();
+shader
+    .setTransformationMatrix(transformationMatrix)
+    .setNormalMatrix(transformationMatrix.normalMatrix())
+    .setProjectionMatrix(projectionMatrix)
+    .draw(clothMesh.mesh());
+/* [SoftBodyMesh-usage] */
+}
+
+{
+btDiscreteDynamicsWorld btDDWorld{nullptr, nullptr, nullptr, nullptr};
+btDynamicsWorld* btWorld = &btDDWorld;
+Float timeStep{};
+/* [Profiler-usage] */
+BulletIntegration::Profiler profiler;
+DOXYGEN_ELLIPSIS()
+
+/* Every frame */
+btWorld->stepSimulation(timeStep);
+profiler.endFrame();
+for(const BulletIntegration::Profiler::Sample& sample: profiler.samples())
+    Debug{} << Debug::nospace << Containers::String{DirectInit, sample.depth*2, ' '} << Debug::nospace
+        << sample.name << sample.time << "ms in" << sample.callCount << "calls";
+
+if(profiler.phaseTime(BulletIntegration::Profiler::Phase::Solver) > 5.0f)
+    Warning{} << "Solver took" << profiler.phaseTime(BulletIntegration::Profiler::Phase::Solver) << "ms";
+/* [Profiler-usage] */
+}
+
+{
+btDiscreteDynamicsWorld btDDWorld{nullptr, nullptr, nullptr, nullptr};
+btDynamicsWorld* btWorld = &btDDWorld;
+Matrix4 projectionMatrix;
+/* [ShapeMeshCache-usage] */
+BulletIntegration::ShapeMeshCache meshCache;
+Shaders::PhongGL shader;
+shader.setProjectionMatrix(projectionMatrix);
+
+/* Every frame */
+const Matrix4 cameraMatrix = DOXYGEN_ELLIPSIS({});
+for(int i = 0; i != btWorld->getNumCollisionObjects(); ++i) {
+    btCollisionObject& object = *btWorld->getCollisionObjectArray()[i];
+    Containers::Pair<GL::Mesh*, Matrix4> mesh =
+        meshCache.get(*object.getCollisionShape());
+    if(!mesh.first()) continue;
+
+    const Matrix4 transformationMatrix = cameraMatrix*
+        Matrix4{Math::Matrix4<btScalar>{object.getWorldTransform()}}*
+        mesh.second();
+    shader
+        .setTransformationMatrix(transformationMatrix)
+        .setNormalMatrix(transformationMatrix.normalMatrix())
+        .draw(*mesh.first());
+}
+/* [ShapeMeshCache-usage] */
+}
 }
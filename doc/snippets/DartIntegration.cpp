@@ -26,11 +26,17 @@
 */
 
 #include <dart/simulation/World.hpp>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Pointer.h>
 
 #include "Magnum/SceneGraph/Scene.h"
 #include "Magnum/SceneGraph/Object.h"
 #include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/Shaders/PhongGL.h"
+#include "Magnum/DartIntegration/InstancedDrawer.h"
 #include "Magnum/DartIntegration/World.h"
+#include "Magnum/DartIntegration/WorldBatch.h"
 
 #define DOXYGEN_ELLIPSIS(...) __VA_ARGS__
 
@@ -98,7 +104,7 @@ for(UnsignedInt i = 0; i < simulationSteps; ++i) {
 
         /* Get updated shapes -- ones that either the materials or the meshes
           have changed */
-        std::vector<std::reference_wrapper<DartIntegration::Object>>
+        Containers::ArrayView<const Containers::Reference<DartIntegration::Object>>
             updatedObjects = world.updatedShapeObjects();
 
         updateMeshesAndMaterials(updatedObjects);
@@ -108,6 +114,71 @@ for(UnsignedInt i = 0; i < simulationSteps; ++i) {
     }
 }
 /* [World-loop] */
+
+/* [World-incremental] */
+world.setFlags(DartIntegration::World::Flag::IncrementalRefresh);
+
+/* Walks the skeleton trees only if something got added or removed since the
+   last refresh, otherwise just updates the existing objects */
+world.refresh();
+/* [World-incremental] */
+
+/* [World-parallel] */
+world
+    .setFlags(DartIntegration::World::Flag::IncrementalRefresh)
+    /* Use all available hardware threads */
+    .setThreadCount(0);
+/* [World-parallel] */
+
+/* [World-simulation] */
+/* Step the DART world in real time on a separate thread */
+world.startSimulation();
+
+/* Every frame, picks up the latest transformations */
+world.refresh();
+
+/* Stop before modifying the DART world */
+world.stopSimulation();
+/* [World-simulation] */
+
+{
+SceneGraph::Camera3D& camera = *static_cast<SceneGraph::Camera3D*>(nullptr);
+/* [InstancedDrawer-usage] */
+Shaders::PhongGL shader{Shaders::PhongGL::Configuration{}
+    .setFlags(Shaders::PhongGL::Flag::InstancedTransformation|
+              Shaders::PhongGL::Flag::VertexColor)};
+DartIntegration::InstancedDrawer drawer;
+
+/* Every frame, after refreshing the world */
+world.refresh();
+drawer.draw(shader, camera, world.shapeObjects());
+/* [InstancedDrawer-usage] */
+}
+
+{
+std::size_t rolloutCount{};
+SceneGraph::Scene<SceneGraph::MatrixTransformation3D> scene;
+/* [WorldBatch-usage] */
+DartIntegration::WorldBatch batch;
+batch.setThreadCount(0);
+
+Containers::Array<dart::simulation::WorldPtr> dartWorlds;
+Containers::Array<Containers::Pointer<DartIntegration::World>> worlds;
+for(std::size_t i = 0; i != rolloutCount; ++i) {
+    arrayAppend(dartWorlds, createWorldInDart());
+    auto* root = new SceneGraph::Object<SceneGraph::MatrixTransformation3D>{&scene};
+    arrayAppend(worlds, Containers::pointer<DartIntegration::World>(batch, *root,
+        *dartWorlds.back(), DartIntegration::World::Flag::IncrementalRefresh|
+                            DartIntegration::World::Flag::ShareDrawData));
+}
+
+/* Every frame, step all worlds but update the scene graph only for the first
+   one that's being visualized */
+batch.step();
+const Containers::Reference<DartIntegration::World> visualized[]{*worlds[0]};
+batch.refresh(visualized);
+/* [WorldBatch-usage] */
+}
 }
 
 }
@@ -25,13 +25,21 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <vector>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/ArrayViewStl.h>
 #include <Corrade/Utility/DebugStl.h>
 
 #include "Magnum/Magnum.h"
 #include "Magnum/EigenIntegration/GeometryIntegration.h"
 #include "Magnum/EigenIntegration/DynamicMatrixIntegration.h"
+#include "Magnum/EigenIntegration/SparseMatrixIntegration.h"
+#include "Magnum/EigenIntegration/TensorIntegration.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
 #include "Magnum/Math/Matrix3.h"
 #include "Magnum/Math/Matrix4.h"
+#include "Magnum/Trade/MeshData.h"
 
 #define DOXYGEN_ELLIPSIS(...) __VA_ARGS__
 
@@ -119,6 +127,47 @@ static_cast<void>(rowView);
 static_cast<void>(map);
 }
 
+{
+/* [DynamicMatrixIntegration-vectors] */
+Trade::MeshData mesh = DOXYGEN_ELLIPSIS(Trade::MeshData{MeshPrimitive::Points, 0});
+
+/* An Eigen::Map<Eigen::Matrix3Xf, Eigen::Unaligned, Eigen::OuterStride<>>
+   with a column for each vertex */
+auto positions = EigenIntegration::arrayCast(
+    mesh.mutableAttribute<Vector3>(Trade::MeshAttribute::Position));
+
+/* Center the mesh in-place */
+const Eigen::Vector3f center = positions.rowwise().mean();
+positions.colwise() -= center;
+
+/* Get back a view on the vertex positions */
+Containers::StridedArrayView1D<Vector3> view =
+    EigenIntegration::arrayCast(positions);
+/* [DynamicMatrixIntegration-vectors] */
+static_cast<void>(view);
+}
+
+{
+/* [DynamicMatrixIntegration-contiguous] */
+Eigen::MatrixXf a = DOXYGEN_ELLIPSIS({});
+Float data[15];
+Containers::StridedArrayView2D<Float> view{data, {3, 5}};
+
+/* An Eigen::Map<Eigen::Matrix<Float, Eigen::Dynamic, Eigen::Dynamic,
+   Eigen::RowMajor>, Eigen::Unaligned, Eigen::OuterStride<>> */
+auto map = EigenIntegration::arrayCast<Eigen::Unaligned>(view);
+Eigen::MatrixXf b = a*map;
+
+/* A view onto a column-major Eigen matrix has the first dimension contiguous,
+   transpose it twice to get the original column-major layout again */
+Containers::StridedArrayView2D<Float> aView = EigenIntegration::arrayCast(a);
+auto aMap = EigenIntegration::arrayCast<Eigen::Aligned16>(
+    aView.transposed<0, 1>()).transpose();
+/* [DynamicMatrixIntegration-contiguous] */
+static_cast<void>(b);
+static_cast<void>(aMap);
+}
+
 {
 /* The include is already above, so doing it again here should be harmless */
 /* [GeometryIntegration] */
@@ -136,4 +185,63 @@ auto c = Matrix4d(Eigen::Isometry3d::Identity());
 static_cast<void>(b);
 static_cast<void>(c);
 }
+
+{
+/* [GeometryIntegration-convertInto] */
+std::vector<Eigen::Isometry3f, Eigen::aligned_allocator<Eigen::Isometry3f>> poses = DOXYGEN_ELLIPSIS({});
+
+Containers::Array<Matrix4> transformations{NoInit, poses.size()};
+EigenIntegration::convertInto(Containers::stridedArrayView(poses),
+    Containers::stridedArrayView(transformations));
+/* [GeometryIntegration-convertInto] */
+}
+
+{
+/* The include is already above, so doing it again here should be harmless */
+/* [SparseMatrixIntegration] */
+#include <Magnum/EigenIntegration/SparseMatrixIntegration.h>
+
+DOXYGEN_ELLIPSIS()
+
+Trade::MeshData mesh = DOXYGEN_ELLIPSIS(Trade::MeshData{MeshPrimitive::Triangles, 0});
+
+/* Vertex adjacency, put into a Laplacian L = D - A */
+Containers::Array<UnsignedInt> indices = mesh.indicesAsArray();
+EigenIntegration::SparseMatrixData<Float> adjacency =
+    EigenIntegration::meshAdjacency(indices, mesh.vertexCount());
+Eigen::Map<Eigen::SparseMatrix<Float>> a =
+    EigenIntegration::mapSparseMatrix(adjacency);
+Eigen::SparseMatrix<Float> l = -a;
+for(Eigen::Index i = 0; i != a.outerSize(); ++i)
+    l.coeffRef(i, i) = a.col(i).sum();
+
+/* Copy the result back to Corrade arrays */
+EigenIntegration::SparseMatrixData<Float> laplacian =
+    EigenIntegration::sparseMatrixData(l);
+/* [SparseMatrixIntegration] */
+static_cast<void>(laplacian);
+}
+
+{
+/* The include is already above, so doing it again here should be harmless */
+/* [TensorIntegration] */
+#include <Magnum/EigenIntegration/TensorIntegration.h>
+
+DOXYGEN_ELLIPSIS()
+
+/* A batch of 16 RGBA images, each 256x256, stored one after another */
+Containers::Array<Float> data{16*256*256*4};
+Containers::StridedArrayView4D<Float> images{data, {16, 256, 256, 4}};
+
+/* Average of the whole batch, per pixel and channel */
+Eigen::Tensor<Float, 3, Eigen::RowMajor> average =
+    EigenIntegration::arrayCast(images).mean(Eigen::array<Eigen::Index, 1>{{0}});
+
+/* And back to a view, for example to wrap it in an image for saving */
+Containers::StridedArrayView3D<Float> averageView =
+    EigenIntegration::arrayCast(average);
+ImageView2D image{PixelFormat::RGBA32F, {256, 256}, averageView.asContiguous()};
+/* [TensorIntegration] */
+static_cast<void>(image);
+}
 }
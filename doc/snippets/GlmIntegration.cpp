@@ -26,7 +26,12 @@
 
 #include "Magnum/Magnum.h"
 #include "Magnum/Math/Matrix3.h"
+#include <vector>
+#include <Corrade/Containers/ArrayViewStl.h>
+
+#include "Magnum/Math/Matrix4.h"
 #include "Magnum/GlmIntegration/Integration.h"
+#include "Magnum/GlmIntegration/ArrayIntegration.h"
 
 #if GLM_VERSION < 96
 #define GLM_FORCE_RADIANS /* Otherwise 0.9.5 spits a lot of loud messages :/ */
@@ -38,6 +43,8 @@
 #endif
 #include "Magnum/GlmIntegration/GtxIntegration.h"
 
+#define DOXYGEN_ELLIPSIS(...) __VA_ARGS__
+
 using namespace Magnum;
 using namespace Magnum::Math::Literals;
 
@@ -75,6 +82,60 @@ static_cast<void>(b);
 static_cast<void>(c);
 }
 
+{
+/* The include is already above, so doing it again here should be harmless */
+/* [ArrayIntegration] */
+#include <Magnum/GlmIntegration/ArrayIntegration.h>
+
+std::vector<glm::vec3> positions = DOXYGEN_ELLIPSIS({});
+std::vector<glm::mat4> transformations = DOXYGEN_ELLIPSIS({});
+
+/* Reinterpreting glm::vec3 as Vector3, without a copy */
+Containers::ArrayView<Vector3> magnumPositions =
+    GlmIntegration::arrayCast(Containers::arrayView(positions));
+
+/* Picking a Magnum subclass explicitly */
+Containers::ArrayView<const Matrix4> magnumTransformations =
+    GlmIntegration::arrayCast<const Matrix4>(Containers::arrayView(transformations));
+
+/* Copying back to a GLM buffer with a single memcpy() */
+std::vector<glm::vec3> out(positions.size());
+GlmIntegration::convertInto(Containers::stridedArrayView(magnumPositions),
+                            Containers::stridedArrayView(out));
+/* [ArrayIntegration] */
+static_cast<void>(magnumTransformations);
+}
+
+{
+/* [ArrayIntegration-traits] */
+struct Instance {
+    glm::mat4 transformation;
+    glm::vec4 color;
+};
+std::vector<Instance> instances = DOXYGEN_ELLIPSIS({});
+
+static_assert(GlmIntegration::IsLayoutCompatible<glm::mat4, Matrix4>::value,
+    "can't reinterpret glm::mat4 as a Matrix4");
+Containers::StridedArrayView1D<Matrix4> transformations =
+    Containers::arrayCast<Matrix4>(Containers::stridedArrayView(instances)
+        .slice(&Instance::transformation));
+/* [ArrayIntegration-traits] */
+static_cast<void>(transformations);
+}
+
+{
+/* [ArrayIntegration-debugPacked] */
+std::vector<glm::vec3> positions{{1.0f, 2.0f, 3.0f}, {0.5f, -1.0f, 0.0f}};
+Debug{} << GlmIntegration::debugPacked(Containers::arrayView(positions));
+    // 1 2 3
+    // 0.5 -1 0
+
+glm::mat2 rotation{0.0f, 1.0f, -1.0f, 0.0f};
+Debug{} << GlmIntegration::debugPacked(Containers::arrayView(&rotation, 1));
+    // 0 1, -1 0
+/* [ArrayIntegration-debugPacked] */
+}
+
 #if GLM_VERSION >= 97
 {
 /* The include is already above, so doing it again here should be harmless */
@@ -116,11 +116,24 @@ GL::Renderer::disable(GL::Renderer::Feature::Blending);
 redraw();
 /* [Context-usage-per-frame] */
 }
+
+{
+/* [Context-needsRedraw] */
+_imgui.drawFrame();
+
+// ...
+
+swapBuffers();
+if(_imgui.needsRedraw())
+    redraw();
+/* [Context-needsRedraw] */
+}
 }
 
 void viewportEvent(ViewportEvent& event) override;
 void pointerPressEvent(PointerEvent& event) override;
 void pointerReleaseEvent(PointerEvent& event) override;
+void pointerMoveEvent(PointerMoveEvent& event) override;
 
 ImGuiIntegration::Context _imgui{Vector2i{}};
 Float _supersamplingRatio{};
@@ -143,6 +156,15 @@ void MyApp::pointerReleaseEvent(PointerEvent& event) {
     // ...
 }
 
+void MyApp::pointerMoveEvent(PointerMoveEvent& event) {
+    /* Even if ImGui doesn't capture the event, the UI may need to react to
+       it, with needsRedraw() indicating when to stop */
+    redraw();
+    if(_imgui.handlePointerMoveEvent(event)) return;
+
+    // ...
+}
+
 // ...
 /* [Context-events] */
 
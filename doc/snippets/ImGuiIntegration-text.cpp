@@ -0,0 +1,73 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <imgui.h>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/PluginManager/Manager.h>
+#include <Corrade/Utility/Path.h>
+#include <Magnum/Text/AbstractFont.h>
+
+#include "Magnum/ImGuiIntegration/Context.h"
+#include "Magnum/ImGuiIntegration/FontLoader.h"
+
+using namespace Magnum;
+
+/* Make sure the name doesn't conflict with any other snippets to avoid linker
+   warnings, unlike with `int main()` there now has to be a declaration to
+   avoid -Wmisssing-prototypes */
+void mainImGuiIntegrationText();
+void mainImGuiIntegrationText() {
+{
+/* [FontLoader-usage] */
+PluginManager::Manager<Text::AbstractFont> manager;
+ImGuiIntegration::FontLoader loader{manager, "FreeTypeFont"};
+
+ImGui::CreateContext();
+Containers::Optional<Containers::Array<char>> data =
+    Utility::Path::read("NotoSans-Regular.ttf");
+loader.addFont(*ImGui::GetIO().Fonts, *data, 16.0f);
+
+ImGuiIntegration::Context imgui{*ImGui::GetCurrentContext(), {640, 480}};
+/* [FontLoader-usage] */
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+{
+PluginManager::Manager<Text::AbstractFont> manager;
+ImGuiIntegration::FontLoader loader{manager};
+Containers::Array<char> data;
+/* [FontLoader-distance-field] */
+ImGuiContext* context = ImGui::CreateContext();
+ImGuiIntegration::Context imgui{*context, {640, 480}};
+imgui.setFlags(ImGuiIntegration::Context::Flag::DistanceFieldFonts);
+
+/* Bake at 32 pixels, ImGui scales that for all other sizes */
+loader.addDistanceFieldFont(*ImGui::GetIO().Fonts, data, 32.0f);
+/* [FontLoader-distance-field] */
+}
+#endif
+}
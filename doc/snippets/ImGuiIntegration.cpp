@@ -26,13 +26,22 @@
 */
 
 #include <imgui.h>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/StringView.h>
 #include <Corrade/Utility/Resource.h>
+#include <Magnum/Image.h>
+#include <Magnum/GL/DefaultFramebuffer.h>
 #include <Magnum/GL/Renderer.h>
+#include <Magnum/GL/TextureArray.h>
 #include <Magnum/Math/Color.h>
 
 #include "Magnum/ImGuiIntegration/Integration.h"
 #include "Magnum/ImGuiIntegration/Context.h"
+#include "Magnum/ImGuiIntegration/OffscreenPanel.h"
+#include "Magnum/ImGuiIntegration/SharedResources.h"
+#include "Magnum/ImGuiIntegration/ThumbnailAtlas.h"
+#include "Magnum/ImGuiIntegration/Widgets.h"
 
 using namespace Magnum;
 
@@ -99,4 +108,93 @@ ImGui::GetIO().Fonts->AddFontFromMemoryTTF(
 // ...
 /* [Context-custom-fonts-resource] */
 }
+
+{
+/* [Context-shared-resources] */
+ImGuiIntegration::SharedResources resources;
+resources.atlas().AddFontFromFileTTF("SourceSansPro-Regular.ttf", 16.0f);
+
+ImGuiIntegration::Context main{resources, {1280, 720}};
+ImGuiIntegration::Context panel{resources, {256, 256}};
+
+// ...
+/* [Context-shared-resources] */
+}
+
+{
+/* [OffscreenPanel-usage] */
+ImGuiIntegration::OffscreenPanel panel{{512, 256}};
+panel.setUpdateRate(30.0f);
+
+ImGuiIntegration::Context imgui{Vector2{panel.size()}, panel.size(),
+    panel.size()};
+
+// in the draw event
+if(panel.beginFrame(imgui)) {
+    ImGui::Begin("Status");
+    ImGui::Text("Hello from the scene!");
+    ImGui::End();
+    panel.endFrame(imgui);
+}
+
+GL::defaultFramebuffer.bind();
+// draw the scene, using panel.texture() on a quad
+/* [OffscreenPanel-usage] */
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+{
+ImGuiIntegration::Context imgui{{640, 480}};
+/* [Context-registerTexture] */
+GL::Texture2DArray thumbnails;
+// fill the layers with asset thumbnails ...
+
+ImGuiIntegration::RegisteredTexture thumbnail =
+    imgui.registerTexture(thumbnails, 3);
+
+// in every frame
+ImGuiIntegration::image(thumbnail, {64.0f, 64.0f});
+
+// once the thumbnail isn't needed anymore
+imgui.unregisterTexture(thumbnail);
+/* [Context-registerTexture] */
+}
+#endif
+
+{
+ImGuiIntegration::Context imgui{{640, 480}};
+struct Asset {
+    UnsignedLong hash;
+    Containers::Optional<Image2D> thumbnail;
+};
+Containers::Array<Asset> assets;
+/* [ThumbnailAtlas-usage] */
+ImGuiIntegration::ThumbnailAtlas atlas{{64, 64}};
+
+// in every frame
+imgui.newFrame();
+atlas.nextFrame();
+
+for(Asset& asset: assets) {
+    if(ImGuiIntegration::image(atlas, asset.hash, {64.0f, 64.0f}))
+        continue;
+
+    // not in the atlas yet or evicted, upload if already loaded
+    if(asset.thumbnail && atlas.add(asset.hash, *asset.thumbnail))
+        ImGuiIntegration::image(atlas, asset.hash, {64.0f, 64.0f});
+    else
+        ImGui::Dummy({64.0f, 64.0f});
+}
+/* [ThumbnailAtlas-usage] */
+}
+
+{
+/* [OffscreenPanel-blending] */
+GL::Renderer::setBlendFunction(
+    GL::Renderer::BlendFunction::SourceAlpha,
+    GL::Renderer::BlendFunction::OneMinusSourceAlpha,
+    GL::Renderer::BlendFunction::One,
+    GL::Renderer::BlendFunction::OneMinusSourceAlpha);
+/* [OffscreenPanel-blending] */
+}
 }
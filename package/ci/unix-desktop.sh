@@ -37,8 +37,10 @@ cmake .. \
     -DMAGNUM_WITH_SCENETOOLS=OFF \
     -DMAGNUM_WITH_SHADERS=ON \
     -DMAGNUM_WITH_SHADERTOOLS=OFF \
-    -DMAGNUM_WITH_TEXT=OFF \
-    -DMAGNUM_WITH_TEXTURETOOLS=OFF \
+    `# Text and TextureTools are optional, enabled here to test text drawing` \
+    `# in BulletIntegration and the font loader in ImGuiIntegration` \
+    -DMAGNUM_WITH_TEXT=ON \
+    -DMAGNUM_WITH_TEXTURETOOLS=ON \
     -DMAGNUM_WITH_OPENGLTESTER=ON \
     -DMAGNUM_WITH_ANYIMAGEIMPORTER=ON \
     -DMAGNUM_WITH_SDL2APPLICATION=ON \
@@ -84,6 +86,7 @@ cmake .. \
     -DMAGNUM_WITH_OVR=OFF \
     -DMAGNUM_BUILD_TESTS=ON \
     -DMAGNUM_BUILD_GL_TESTS=ON \
+    -DMAGNUM_BUILD_BENCHMARKS=${RUN_BENCHMARKS:-OFF} \
     -G Ninja
 ninja $NINJA_JOBS
 
@@ -92,5 +95,14 @@ ninja $NINJA_JOBS
 ASAN_OPTIONS="color=always" LSAN_OPTIONS="color=always" CORRADE_TEST_COLOR=ON ctest -V -E "GLTest|Dart"
 ASAN_OPTIONS="color=always" LSAN_OPTIONS="color=always suppressions=$(pwd)/../package/ci/leaksanitizer.conf" CORRADE_TEST_COLOR=ON ctest -V -R Dart -E GLTest
 
+# On nodes with a GPU run all benchmarks, including the GL ones, and save
+# the results to benchmark-results/ in the build directory. With
+# PLATFORM_GL_API set to EGL the tests create a headless context so there
+# doesn't need to be any display, MAGNUM_DEVICE can be used to pick a GPU on
+# multi-GPU nodes.
+if [ "$RUN_BENCHMARKS" == "ON" ]; then
+    ninja MagnumIntegrationBenchmarkResults
+fi
+
 # Test install, after running the tests as for them it shouldn't be needed
 ninja install
@@ -0,0 +1,239 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ConvertShape.h"
+
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
+#include <Magnum/Mesh.h>
+#include <Magnum/Math/Functions.h>
+#include <Magnum/Math/Matrix4.h>
+#include <Magnum/MeshTools/GenerateNormals.h>
+#include <Magnum/MeshTools/Transform.h>
+#include <Magnum/Primitives/Capsule.h>
+#include <Magnum/Primitives/Cube.h>
+#include <Magnum/Primitives/Icosphere.h>
+#include <BulletCollision/BroadphaseCollision/btBroadphaseProxy.h>
+#include <BulletCollision/CollisionShapes/btBoxShape.h>
+#include <BulletCollision/CollisionShapes/btCapsuleShape.h>
+#include <BulletCollision/CollisionShapes/btConvexHullShape.h>
+#include <BulletCollision/CollisionShapes/btSphereShape.h>
+#include <BulletCollision/CollisionShapes/btStridingMeshInterface.h>
+#include <BulletCollision/CollisionShapes/btTriangleMeshShape.h>
+#include <LinearMath/btConvexHullComputer.h>
+
+#include "Magnum/BulletIntegration/Integration.h"
+#include "Magnum/BulletIntegration/Implementation/ConvertShape.h"
+
+namespace Magnum { namespace BulletIntegration {
+
+using namespace Math::Literals;
+
+namespace Implementation {
+
+namespace {
+
+struct Vertex {
+    Vector3 position;
+    Vector3 normal;
+};
+
+/* Makes a non-indexed mesh with flat normals out of a triangle soup */
+Trade::MeshData flatMesh(Containers::Array<Vector3>&& positions) {
+    Containers::Array<char> vertexData{NoInit, positions.size()*sizeof(Vertex)};
+    auto vertices = Containers::arrayCast<Vertex>(vertexData);
+    for(std::size_t i = 0; i != positions.size(); ++i)
+        vertices[i].position = positions[i];
+
+    Containers::StridedArrayView1D<Vector3> vertexPositions = Containers::stridedArrayView(vertices).slice(&Vertex::position);
+    Containers::StridedArrayView1D<Vector3> vertexNormals = Containers::stridedArrayView(vertices).slice(&Vertex::normal);
+    MeshTools::generateFlatNormalsInto(vertexPositions, vertexNormals);
+
+    return Trade::MeshData{MeshPrimitive::Triangles, std::move(vertexData), {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position, vertexPositions},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Normal, vertexNormals}
+    }};
+}
+
+Trade::MeshData convexHullMesh(const btConvexHullShape& shape) {
+    if(!shape.getNumPoints()) return flatMesh({});
+
+    btConvexHullComputer hull;
+    hull.compute(&shape.getUnscaledPoints()->x(), sizeof(btVector3), shape.getNumPoints(), btScalar(0.0), btScalar(0.0));
+
+    /* Each face is a convex polygon with counterclockwise winding when looking
+       from the outside, triangulate it as a fan */
+    Containers::Array<Vector3> positions;
+    for(int i = 0; i != hull.faces.size(); ++i) {
+        const btConvexHullComputer::Edge* const first = &hull.edges[hull.faces[i]];
+        const Vector3 a{Math::Vector3<btScalar>{hull.vertices[first->getSourceVertex()]}};
+        const btConvexHullComputer::Edge* edge = first->getNextEdgeOfFace();
+        const btConvexHullComputer::Edge* next = edge->getNextEdgeOfFace();
+        while(next != first) {
+            arrayAppend(positions, {a,
+                Vector3{Math::Vector3<btScalar>{hull.vertices[edge->getSourceVertex()]}},
+                Vector3{Math::Vector3<btScalar>{hull.vertices[next->getSourceVertex()]}}});
+            edge = next;
+            next = next->getNextEdgeOfFace();
+        }
+    }
+
+    return flatMesh(std::move(positions));
+}
+
+template<class T> Vector3 triangleMeshVertex(const unsigned char* vertexBase, int vertexStride, UnsignedInt index) {
+    const T* const vertex = reinterpret_cast<const T*>(vertexBase + std::size_t(index)*vertexStride);
+    return Vector3{Float(vertex[0]), Float(vertex[1]), Float(vertex[2])};
+}
+
+template<class T> void triangleMeshIndices(const unsigned char* indexBase, int indexStride, int face, UnsignedInt(&indices)[3]) {
+    const T* const triangle = reinterpret_cast<const T*>(indexBase + std::size_t(face)*indexStride);
+    indices[0] = triangle[0];
+    indices[1] = triangle[1];
+    indices[2] = triangle[2];
+}
+
+Trade::MeshData triangleMeshMesh(const btTriangleMeshShape& shape) {
+    const btStridingMeshInterface& meshInterface = *shape.getMeshInterface();
+
+    Containers::Array<Vector3> positions;
+    for(int part = 0; part != meshInterface.getNumSubParts(); ++part) {
+        const unsigned char* vertexBase;
+        const unsigned char* indexBase;
+        int vertexCount, vertexStride, indexStride, faceCount;
+        PHY_ScalarType vertexType, indexType;
+        meshInterface.getLockedReadOnlyVertexIndexBase(&vertexBase, vertexCount, vertexType, vertexStride, &indexBase, indexStride, faceCount, indexType, part);
+
+        /* Bullet supports just float and double vertices, anything else is
+           skipped the same way Bullet itself does */
+        if(vertexType == PHY_FLOAT || vertexType == PHY_DOUBLE) {
+            arrayReserve(positions, positions.size() + std::size_t(faceCount)*3);
+            for(int face = 0; face != faceCount; ++face) {
+                UnsignedInt indices[3];
+                if(indexType == PHY_INTEGER)
+                    triangleMeshIndices<UnsignedInt>(indexBase, indexStride, face, indices);
+                else if(indexType == PHY_SHORT)
+                    triangleMeshIndices<UnsignedShort>(indexBase, indexStride, face, indices);
+                else if(indexType == PHY_UCHAR)
+                    triangleMeshIndices<UnsignedByte>(indexBase, indexStride, face, indices);
+                else break;
+
+                for(UnsignedInt index: indices) arrayAppend(positions,
+                    vertexType == PHY_FLOAT ?
+                        triangleMeshVertex<float>(vertexBase, vertexStride, index) :
+                        triangleMeshVertex<double>(vertexBase, vertexStride, index));
+            }
+        }
+
+        meshInterface.unLockReadOnlyVertexBase(part);
+    }
+
+    return flatMesh(std::move(positions));
+}
+
+}
+
+bool shapeMeshKey(const btCollisionShape& shape, ShapeMeshKey& key, Matrix4& transformation) {
+    key = {shape.getShapeType(), 0, nullptr};
+
+    switch(shape.getShapeType()) {
+        case BOX_SHAPE_PROXYTYPE:
+            /* The half-extents already include the local scaling, the cube
+               primitive is 2x2x2 */
+            transformation = Matrix4::scaling(Vector3{Math::Vector3<btScalar>{static_cast<const btBoxShape&>(shape).getHalfExtentsWithMargin()}});
+            return true;
+
+        case SPHERE_SHAPE_PROXYTYPE:
+            transformation = Matrix4::scaling(Vector3{Float(static_cast<const btSphereShape&>(shape).getRadius())});
+            return true;
+
+        case CAPSULE_SHAPE_PROXYTYPE: {
+            const auto& capsule = static_cast<const btCapsuleShape&>(shape);
+            const Float radius = capsule.getRadius();
+
+            /* The capsule primitive has an unit radius and the cylinder
+               length depends on the aspect ratio, so it's quantized to make
+               capsules of similar proportions share the same mesh */
+            key.parameter = (UnsignedInt(Math::round(Float(capsule.getHalfHeight())/radius*1024.0f)) << 2)|capsule.getUpAxis();
+
+            /* The primitive is along the Y axis */
+            Matrix4 rotation{Math::IdentityInit};
+            if(capsule.getUpAxis() == 0)
+                rotation = Matrix4::rotationZ(-90.0_degf);
+            else if(capsule.getUpAxis() == 2)
+                rotation = Matrix4::rotationX(90.0_degf);
+            transformation = rotation*Matrix4::scaling(Vector3{radius});
+            return true;
+        }
+
+        /* The mesh of these is made from unscaled vertex data, so it stays the
+           same even if the scaling changes */
+        case CONVEX_HULL_SHAPE_PROXYTYPE:
+        case TRIANGLE_MESH_SHAPE_PROXYTYPE:
+            key.shape = &shape;
+            transformation = Matrix4::scaling(Vector3{Math::Vector3<btScalar>{shape.getLocalScaling()}});
+            return true;
+    }
+
+    return false;
+}
+
+Trade::MeshData shapeMesh(const btCollisionShape& shape, const ShapeMeshKey& key) {
+    switch(key.type) {
+        case BOX_SHAPE_PROXYTYPE:
+            return Primitives::cubeSolid();
+        case SPHERE_SHAPE_PROXYTYPE:
+            return Primitives::icosphereSolid(2);
+        case CAPSULE_SHAPE_PROXYTYPE:
+            return Primitives::capsule3DSolid(4, 1, 16, (key.parameter >> 2)/1024.0f);
+        case CONVEX_HULL_SHAPE_PROXYTYPE:
+            return convexHullMesh(static_cast<const btConvexHullShape&>(shape));
+        case TRIANGLE_MESH_SHAPE_PROXYTYPE:
+            return triangleMeshMesh(static_cast<const btTriangleMeshShape&>(shape));
+    }
+
+    CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+}
+
+Containers::Optional<Trade::MeshData> convertShape(const btCollisionShape& shape) {
+    Implementation::ShapeMeshKey key;
+    Matrix4 transformation;
+    if(!Implementation::shapeMeshKey(shape, key, transformation))
+        return {};
+
+    /* The normal matrix of a non-uniform scaling doesn't preserve the normal
+       length, so renormalize them after */
+    Trade::MeshData mesh = MeshTools::transform3D(Implementation::shapeMesh(shape, key), transformation);
+    for(Vector3& normal: mesh.mutableAttribute<Vector3>(Trade::MeshAttribute::Normal))
+        normal = normal.normalized();
+
+    return Containers::optional(std::move(mesh));
+}
+
+}}
@@ -0,0 +1,82 @@
+#ifndef Magnum_BulletIntegration_ConvertShape_h
+#define Magnum_BulletIntegration_ConvertShape_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::BulletIntegration::convertShape()
+ * @m_since_latest_{integration}
+ */
+
+#include <Corrade/Containers/Optional.h>
+#include <Magnum/Trade/MeshData.h>
+
+#include "Magnum/BulletIntegration/visibility.h"
+
+class btCollisionShape;
+
+namespace Magnum { namespace BulletIntegration {
+
+/**
+@brief Convert a Bullet collision shape to mesh data
+@m_since_latest_{integration}
+
+Returns a @ref MeshPrimitive::Triangles mesh with
+@ref Trade::MeshAttribute::Position and @ref Trade::MeshAttribute::Normal
+attributes in the local coordinate system of the shape, or
+@ref Corrade::Containers::NullOpt if the shape is not supported. The following
+Bullet shapes are supported:
+
+-   @cpp btBoxShape @ce, made from @ref Primitives::cubeSolid() scaled to
+    the half-extents including the collision margin
+-   @cpp btSphereShape @ce, made from @ref Primitives::icosphereSolid()
+-   @cpp btCapsuleShape @ce and its @cpp btCapsuleShapeX @ce and
+    @cpp btCapsuleShapeZ @ce variants, made from
+    @ref Primitives::capsule3DSolid()
+-   @cpp btConvexHullShape @ce, triangulated from a convex hull of its points
+    with flat normals. The collision margin isn't included.
+-   @cpp btBvhTriangleMeshShape @ce and other shapes derived from
+    @cpp btTriangleMeshShape @ce, converted from all parts of the
+    @cpp btStridingMeshInterface @ce with flat normals
+
+The following Bullet shapes are not supported:
+
+-   @cpp btCompoundShape @ce, convert its child shapes and apply their
+    local transformations instead
+-   @cpp btStaticPlaneShape @ce, which is an infinite plane
+-   @cpp btCylinderShape @ce, @cpp btConeShape @ce, @cpp btMultiSphereShape @ce
+    and other convex and concave shapes
+
+The local scaling set on the shape is applied. The convex hull and triangle
+mesh shapes produce a non-indexed mesh, the others an indexed one. To draw
+many shapes, use @ref ShapeMeshCache instead, which shares the meshes among
+identical shapes.
+*/
+MAGNUM_BULLETINTEGRATION_EXPORT Containers::Optional<Trade::MeshData> convertShape(const btCollisionShape& shape);
+
+}}
+
+#endif
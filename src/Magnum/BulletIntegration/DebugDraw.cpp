@@ -27,11 +27,53 @@
 
 #include "DebugDraw.h"
 
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <Corrade/Containers/EnumSet.hpp>
 #include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Pointer.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Algorithms.h>
 #include <Magnum/Math/Color.h>
+#include <Magnum/Math/Distance.h>
+#include <Magnum/Math/Intersection.h>
+#include <Magnum/Math/Functions.h>
+#include <Magnum/Math/Half.h>
+#include <Magnum/Math/Matrix3.h>
+#include <Magnum/Math/Packing.h>
+#ifdef MAGNUM_BULLETINTEGRATION_HAS_TEXT
+#include <Magnum/Text/AbstractFont.h>
+#include <Magnum/Text/AbstractShaper.h>
+#include <Magnum/Text/Alignment.h>
+#include <Magnum/Text/GlyphCacheGL.h>
+#include <Magnum/Text/RendererGL.h>
+#endif
+
+#include "Magnum/instrumentationIntegration.h"
+
+#if BT_BULLET_VERSION >= 284
+#include <BulletCollision/CollisionDispatch/btCollisionObject.h>
+#include <BulletCollision/CollisionDispatch/btCollisionWorld.h>
+#include <BulletCollision/CollisionShapes/btCollisionShape.h>
+#include <BulletCollision/NarrowPhaseCollision/btPersistentManifold.h>
+#endif
 
 namespace Magnum { namespace BulletIntegration {
 
+struct DebugDraw::ThreadData {
+    std::thread::id thread;
+    Containers::Array<char> bufferData;
+    Containers::Array<PrimitiveInstance> primitiveInstances[3];
+};
+
+struct DebugDraw::ThreadState {
+    std::uint64_t id;
+    std::mutex mutex;
+    Containers::Array<Containers::Pointer<ThreadData>> threads;
+};
+
 Debug& operator<<(Debug& debug, const DebugDraw::Mode value) {
     switch(value) {
         /* LCOV_EXCL_START */
@@ -64,12 +106,183 @@ Debug& operator<<(Debug& debug, const DebugDraw::Mode value) {
     return debug << "BulletIntegration::DebugDraw::Mode(" << Debug::nospace << Debug::hex << UnsignedInt(Int(value)) << Debug::nospace << ")";
 }
 
-DebugDraw::DebugDraw(const std::size_t initialBufferCapacity): _mesh{GL::MeshPrimitive::Lines} {
-    _mesh.addVertexBuffer(_buffer, 0, Shaders::VertexColorGL3D::Position{}, Shaders::VertexColorGL3D::Color3{});
-    arrayReserve(_bufferData, initialBufferCapacity*4);
+Debug& operator<<(Debug& debug, const DebugDraw::Flag value) {
+    debug << "BulletIntegration::DebugDraw::Flag" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case DebugDraw::Flag::value: return debug << "::" #value;
+        _c(DoubleBuffered)
+        _c(PackedColors)
+        _c(HalfFloatPositions)
+        _c(InstancedPrimitives)
+        _c(FrustumCulling)
+        _c(ThreadSafe)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "(" << Debug::nospace << Debug::hex << UnsignedByte(value) << Debug::nospace << ")";
+}
+
+Debug& operator<<(Debug& debug, const DebugDraw::Flags value) {
+    return Containers::enumSetDebugOutput(debug, value, "BulletIntegration::DebugDraw::Flags{}", {
+        DebugDraw::Flag::DoubleBuffered,
+        DebugDraw::Flag::PackedColors,
+        DebugDraw::Flag::HalfFloatPositions,
+        DebugDraw::Flag::InstancedPrimitives,
+        DebugDraw::Flag::FrustumCulling,
+        DebugDraw::Flag::ThreadSafe});
+}
+
+namespace {
+
+enum: UnsignedInt {
+    BoxPrimitive,
+    SpherePrimitive,
+    TransformPrimitive
+};
+
+constexpr UnsignedInt BoxVertexCount = 24;
+constexpr UnsignedInt SphereSegmentCount = 32;
+constexpr UnsignedInt SphereVertexCount = 3*SphereSegmentCount*2;
+constexpr UnsignedInt TransformVertexCount = 6;
+
+/* Used by Flag::ThreadSafe. Instance IDs are never reused, so the per-thread
+   cache can't point to data of an instance that no longer exists. */
+std::atomic<std::uint64_t> threadSafeInstanceCounter{0};
+struct ThreadCache {
+    std::uint64_t instanceId;
+    void* data;
+};
+CORRADE_THREAD_LOCAL ThreadCache threadCache{};
+
+/* Reallocates the buffer storage only if the data don't fit, growing
+   geometrically to not have to reallocate again next time. Otherwise just
+   updates the existing storage. */
+void uploadGrowing(GL::Buffer& buffer, std::size_t& capacity, const Containers::ArrayView<const void> data) {
+    if(data.size() > capacity) {
+        capacity = Math::max(data.size(), 2*capacity);
+        buffer.setData({nullptr, capacity}, GL::BufferUsage::DynamicDraw);
+    }
+    buffer.setSubData(0, data);
+}
+
+}
+
+void DebugDraw::setupLineMesh(GL::Mesh& mesh, GL::Buffer& buffer) const {
+    /* Half-float positions are padded to four bytes to have the colors
+       aligned */
+    const Shaders::VertexColorGL3D::Position position{_flags & Flag::HalfFloatPositions ?
+        Shaders::VertexColorGL3D::Position::DataType::Half :
+        Shaders::VertexColorGL3D::Position::DataType::Float};
+    const GLintptr positionPadding = _flags & Flag::HalfFloatPositions ? 2 : 0;
+
+    buffer = GL::Buffer{GL::Buffer::TargetHint::Array};
+    mesh = GL::Mesh{GL::MeshPrimitive::Lines};
+    if(_flags & Flag::PackedColors)
+        mesh.addVertexBuffer(buffer, 0, position, positionPadding,
+            Shaders::VertexColorGL3D::Color4{
+                Shaders::VertexColorGL3D::Color4::DataType::UnsignedByte,
+                Shaders::VertexColorGL3D::Color4::DataOption::Normalized});
+    else
+        mesh.addVertexBuffer(buffer, 0, position, positionPadding,
+            Shaders::VertexColorGL3D::Color3{});
+}
+
+DebugDraw::DebugDraw(const Flags flags, const std::size_t initialBufferCapacity): _flags{flags} {
+    _colorOffset = flags & Flag::HalfFloatPositions ? sizeof(Vector3h) + 2 : sizeof(Vector3);
+    _vertexSize = _colorOffset + (flags & Flag::PackedColors ? sizeof(Color4ub) : sizeof(Color3));
+
+    for(std::size_t i = 0, count = flags & Flag::DoubleBuffered ? 2 : 1; i != count; ++i)
+        setupLineMesh(_meshes[i], _buffers[i]);
+    arrayReserve(_bufferData, initialBufferCapacity*2*_vertexSize);
+
+    if(flags & Flag::ThreadSafe) {
+        _threadState.emplace();
+        /* Starting from 1 to not match the default-initialized cache */
+        _threadState->id = ++threadSafeInstanceCounter;
+    }
+
+    if(flags & Flag::InstancedPrimitives) {
+        _instancedShader = Shaders::FlatGL3D{Shaders::FlatGL3D::Configuration{}
+            .setFlags(Shaders::FlatGL3D::Flag::VertexColor|
+                      Shaders::FlatGL3D::Flag::InstancedTransformation)};
+
+        /* Unit wireframe box, sphere made of three circles and an axis
+           triad, the triad having interleaved per-vertex colors matching
+           what btIDebugDraw::drawTransform() uses */
+        Containers::Array<Vector3> data{NoInit, BoxVertexCount + SphereVertexCount + TransformVertexCount*2};
+        Vector3* out = data;
+        const auto corner = [](UnsignedInt c) {
+            return Vector3{c & 1 ? 1.0f : -1.0f, c & 2 ? 1.0f : -1.0f, c & 4 ? 1.0f : -1.0f};
+        };
+        for(UnsignedInt i = 0; i != 8; ++i) for(UnsignedInt bit: {1, 2, 4}) {
+            if(i & bit) continue;
+            *out++ = corner(i);
+            *out++ = corner(i|bit);
+        }
+        for(UnsignedInt axis = 0; axis != 3; ++axis) {
+            for(UnsignedInt i = 0; i != SphereSegmentCount; ++i) {
+                for(UnsignedInt j: {i, i + 1}) {
+                    const Rad angle{Constants::tau()*j/SphereSegmentCount};
+                    Vector3 point;
+                    point[axis] = Math::cos(angle);
+                    point[(axis + 1) % 3] = Math::sin(angle);
+                    *out++ = point;
+                }
+            }
+        }
+        for(UnsignedInt axis = 0; axis != 3; ++axis) {
+            Color3 color{0.3f};
+            color[axis] = 1.0f;
+            *out++ = {};
+            *out++ = color;
+            Vector3 end;
+            end[axis] = 1.0f;
+            *out++ = end;
+            *out++ = color;
+        }
+        CORRADE_INTERNAL_ASSERT(out == data.end());
+
+        _primitiveBuffer = GL::Buffer{GL::Buffer::TargetHint::Array};
+        _primitiveBuffer.setData(data, GL::BufferUsage::StaticDraw);
+
+        for(GL::Buffer& buffer: _instanceBuffers)
+            buffer = GL::Buffer{GL::Buffer::TargetHint::Array};
+
+        _primitiveMeshes[BoxPrimitive] = GL::Mesh{GL::MeshPrimitive::Lines};
+        _primitiveMeshes[BoxPrimitive]
+            .setCount(BoxVertexCount)
+            .addVertexBuffer(_primitiveBuffer, 0, Shaders::FlatGL3D::Position{})
+            .addVertexBufferInstanced(_instanceBuffers[BoxPrimitive], 1, 0,
+                Shaders::FlatGL3D::TransformationMatrix{},
+                Shaders::FlatGL3D::Color3{});
+        _primitiveMeshes[SpherePrimitive] = GL::Mesh{GL::MeshPrimitive::Lines};
+        _primitiveMeshes[SpherePrimitive]
+            .setCount(SphereVertexCount)
+            .addVertexBuffer(_primitiveBuffer, BoxVertexCount*sizeof(Vector3),
+                Shaders::FlatGL3D::Position{})
+            .addVertexBufferInstanced(_instanceBuffers[SpherePrimitive], 1, 0,
+                Shaders::FlatGL3D::TransformationMatrix{},
+                Shaders::FlatGL3D::Color3{});
+        /* The triad has per-vertex colors, so the instance color is
+           skipped */
+        _primitiveMeshes[TransformPrimitive] = GL::Mesh{GL::MeshPrimitive::Lines};
+        _primitiveMeshes[TransformPrimitive]
+            .setCount(TransformVertexCount)
+            .addVertexBuffer(_primitiveBuffer, (BoxVertexCount + SphereVertexCount)*sizeof(Vector3),
+                Shaders::FlatGL3D::Position{},
+                Shaders::FlatGL3D::Color3{})
+            .addVertexBufferInstanced(_instanceBuffers[TransformPrimitive], 1, 0,
+                Shaders::FlatGL3D::TransformationMatrix{},
+                GLintptr(sizeof(Color3)));
+    }
 }
 
-DebugDraw::DebugDraw(NoCreateT) noexcept: _shader{NoCreate}, _buffer{NoCreate}, _mesh{NoCreate} {}
+DebugDraw::DebugDraw(const std::size_t initialBufferCapacity): DebugDraw{Flags{}, initialBufferCapacity} {}
+
+DebugDraw::DebugDraw(NoCreateT) noexcept: _shader{NoCreate} {}
 
 DebugDraw::DebugDraw(DebugDraw&&) noexcept = default;
 
@@ -85,16 +298,103 @@ int DebugDraw::getDebugMode() const {
     return int(_mode);
 }
 
+void DebugDraw::writePosition(char* const out, const Vector3& relativePosition) const {
+    if(_flags & Flag::HalfFloatPositions) {
+        const Math::Vector3<UnsignedShort> packed = Math::packHalf(relativePosition);
+        std::memcpy(out, packed.data(), sizeof(packed));
+    } else std::memcpy(out, relativePosition.data(), sizeof(relativePosition));
+}
+
+void DebugDraw::writePosition(char* const out, const btVector3& position) const {
+    /* Subtracting in the original precision to not lose anything in case
+       Bullet is built with doubles */
+    writePosition(out, Vector3{Math::Vector3<btScalar>{position} - Math::Vector3<btScalar>{_positionOrigin}});
+}
+
+void DebugDraw::writeColor(char* const out, const Color3& color) const {
+    if(_flags & Flag::PackedColors) {
+        const Color4ub packed{Math::pack<Color3ub>(Math::clamp(color, 0.0f, 1.0f)), 255};
+        std::memcpy(out + _colorOffset, packed.data(), sizeof(packed));
+    } else std::memcpy(out + _colorOffset, color.data(), sizeof(color));
+}
+
+DebugDraw::ThreadData& DebugDraw::threadData() {
+    /* Fast path, the thread was already registered with this instance the
+       last time it was drawing */
+    if(threadCache.instanceId == _threadState->id)
+        return *static_cast<ThreadData*>(threadCache.data);
+
+    /* Otherwise find the data for this thread or register a new one. The
+       data are heap-allocated, so a reallocation of the list doesn't
+       affect other threads that are writing to their data. */
+    std::lock_guard<std::mutex> lock{_threadState->mutex};
+    const std::thread::id thread = std::this_thread::get_id();
+    ThreadData* data = nullptr;
+    for(Containers::Pointer<ThreadData>& i: _threadState->threads) {
+        if(i->thread == thread) {
+            data = i.get();
+            break;
+        }
+    }
+    if(!data) {
+        data = arrayAppend(_threadState->threads, Containers::pointer<ThreadData>())->get();
+        data->thread = thread;
+    }
+
+    threadCache = {_threadState->id, data};
+    return *data;
+}
+
+Containers::Array<char>& DebugDraw::lineData() {
+    if(_baking) return _staticBufferData;
+    return _threadState ? threadData().bufferData : _bufferData;
+}
+
+Containers::Array<DebugDraw::PrimitiveInstance>& DebugDraw::primitiveInstanceData(const UnsignedInt primitive) {
+    return _threadState ? threadData().primitiveInstances[primitive] : _primitiveInstances[primitive];
+}
+
+bool DebugDraw::isLineCulled(const btVector3& from, const btVector3& to) const {
+    /* Static geometry is baked whole as the view changes */
+    if(!(_flags & Flag::FrustumCulling) || _baking) return false;
+
+    /* Conservative, the line is culled only if both points are outside of
+       the same plane */
+    const Vector3 a{Math::Vector3<btScalar>{from}};
+    const Vector3 b{Math::Vector3<btScalar>{to}};
+    for(std::size_t i = 0; i != 6; ++i) {
+        if(Math::Distance::pointPlaneScaled(a, _frustum[i]) < 0.0f &&
+           Math::Distance::pointPlaneScaled(b, _frustum[i]) < 0.0f)
+            return true;
+    }
+    return false;
+}
+
 void DebugDraw::drawLine(const btVector3& from, const btVector3& to, const btVector3& color) {
-    drawLine(from, to, color, color);
+    if(isLineCulled(from, to)) return;
+
+    /* Convert and pack the color just once and copy it to the other
+       vertex */
+    char* const out = arrayAppend(lineData(), NoInit, 2*_vertexSize).data();
+    writePosition(out, from);
+    writeColor(out, Color3{Math::Vector3<btScalar>{color}});
+    writePosition(out + _vertexSize, to);
+    std::memcpy(out + _vertexSize + _colorOffset, out + _colorOffset, _vertexSize - _colorOffset);
+
+    /* See below for why */
+    #if BT_BULLET_VERSION < 284
+    flushLines();
+    #endif
 }
 
 void DebugDraw::drawLine(const btVector3& from, const btVector3& to, const btVector3& fromColor, const btVector3& toColor) {
-    arrayAppend(_bufferData, {
-        Vector3{Math::Vector3<btScalar>{from}},
-        Vector3{Math::Vector3<btScalar>{fromColor}},
-        Vector3{Math::Vector3<btScalar>{to}},
-        Vector3{Math::Vector3<btScalar>{toColor}}});
+    if(isLineCulled(from, to)) return;
+
+    char* const out = arrayAppend(lineData(), NoInit, 2*_vertexSize).data();
+    writePosition(out, from);
+    writeColor(out, Color3{Math::Vector3<btScalar>{fromColor}});
+    writePosition(out + _vertexSize, to);
+    writeColor(out + _vertexSize, Color3{Math::Vector3<btScalar>{toColor}});
 
     /* The flushLines() API was added at some point between 2.83 and 2.83.4,
        but that's below the resolution of the constant below. Moreover, 284
@@ -110,7 +410,52 @@ void DebugDraw::drawLine(const btVector3& from, const btVector3& to, const btVec
     #endif
 }
 
+DebugDraw& DebugDraw::reserveLines(const std::size_t count) {
+    Containers::Array<char>& data = lineData();
+    arrayReserve(data, data.size() + count*2*_vertexSize);
+    return *this;
+}
+
+DebugDraw& DebugDraw::addLines(const Containers::StridedArrayView1D<const Vector3>& positions, const Color3& color) {
+    CORRADE_ASSERT(positions.size() % 2 == 0,
+        "BulletIntegration::DebugDraw::addLines(): expected an even position count, got" << positions.size(), *this);
+    if(positions.isEmpty()) return *this;
+
+    /* Pack the color just once and then only copy it */
+    char* out = arrayAppend(lineData(), NoInit, positions.size()*_vertexSize).data();
+    writeColor(out, color);
+    const char* const packedColor = out + _colorOffset;
+    const std::size_t colorSize = _vertexSize - _colorOffset;
+    writePosition(out, positions[0] - _positionOrigin);
+    for(std::size_t i = 1; i != positions.size(); ++i) {
+        out += _vertexSize;
+        writePosition(out, positions[i] - _positionOrigin);
+        std::memcpy(out + _colorOffset, packedColor, colorSize);
+    }
+
+    return *this;
+}
+
+DebugDraw& DebugDraw::addLines(const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const Color3>& colors) {
+    CORRADE_ASSERT(positions.size() % 2 == 0,
+        "BulletIntegration::DebugDraw::addLines(): expected an even position count, got" << positions.size(), *this);
+    CORRADE_ASSERT(colors.size() == positions.size(),
+        "BulletIntegration::DebugDraw::addLines(): expected" << positions.size() << "colors but got" << colors.size(), *this);
+
+    char* out = arrayAppend(lineData(), NoInit, positions.size()*_vertexSize).data();
+    for(std::size_t i = 0; i != positions.size(); ++i) {
+        writePosition(out, positions[i] - _positionOrigin);
+        writeColor(out, colors[i]);
+        out += _vertexSize;
+    }
+
+    return *this;
+}
+
 void DebugDraw::drawContactPoint(const btVector3& pointOnB, const btVector3& normalOnB, const btScalar distance, const int, const btVector3& color) {
+    if((Vector3{Math::Vector3<btScalar>{pointOnB}} - _positionOrigin).dot() > Math::pow<2>(_contactPointCullDistance))
+        return;
+
     drawLine(pointOnB, pointOnB + normalOnB*distance, color);
 }
 
@@ -118,22 +463,300 @@ void DebugDraw::reportErrorWarning(const char *warningString) {
     Warning() << "DebugDraw:" << warningString;
 }
 
-void DebugDraw::draw3dText(const btVector3&, const char*) {
-    /** @todo Implement once debug text drawing is implemented. */
+#ifdef MAGNUM_BULLETINTEGRATION_HAS_TEXT
+DebugDraw& DebugDraw::setTextFont(Text::AbstractFont& font, Text::GlyphCacheGL& glyphCache, const Float size) {
+    _glyphCache = &glyphCache;
+    _textShaper = font.createShaper();
+    _textRenderer.emplace(glyphCache);
+    _textRenderer->setAlignment(Text::Alignment::MiddleCenter);
+    if(!_textShader.id()) _textShader = Shaders::VectorGL2D{};
+    _textSize = size;
+    return *this;
+}
+
+void DebugDraw::draw3dText(const btVector3& location, const char* const textString) {
+    if(!_textRenderer) return;
+
+    /* Project the label to the screen, skip it if it's behind the camera or
+       outside of the view */
+    const Vector4 clip = _transformationProjectionMatrix*Vector4{Vector3{Math::Vector3<btScalar>{location}}, 1.0f};
+    if(clip.w() <= 0.0f) return;
+    const Vector2 ndc = clip.xy()/clip.w();
+    if((Math::abs(ndc) > Vector2{1.0f}).any()) return;
+
+    /* The renderer is shared, so with multiple threads drawing it has to be
+       locked */
+    std::unique_lock<std::mutex> lock;
+    if(_threadState) lock = std::unique_lock<std::mutex>{_threadState->mutex};
+
+    /* Cursor is in pixels relative to the viewport center */
+    _textRenderer->setCursor(ndc*_viewportSize*0.5f);
+    _textRenderer->render(*_textShaper, _textSize, textString);
+}
+#else
+/* Without the Text library there's nothing to draw the labels with */
+void DebugDraw::draw3dText(const btVector3&, const char*) {}
+#endif
+
+void DebugDraw::addPrimitiveInstance(const UnsignedInt primitive, const Math::Matrix4<btScalar>& transformation, const btVector3& color) {
+    /* Cull with a bounding sphere. The unit box has the farthest corner at
+       a distance of sqrt(3), which is enough for the sphere and the triad as
+       well. */
+    if(_flags & Flag::FrustumCulling) {
+        const Matrix4 transformationf{transformation};
+        const Float scaling = Math::sqrt(Math::max(Math::max(
+            transformationf[0].xyz().dot(),
+            transformationf[1].xyz().dot()),
+            transformationf[2].xyz().dot()));
+        if(!Math::Intersection::sphereFrustum(transformationf.translation(), Math::sqrt(3.0f)*scaling, _frustum))
+            return;
+    }
+
+    /* Subtracting the origin in the original precision, same as with lines */
+    Math::Matrix4<btScalar> relativeTransformation = transformation;
+    relativeTransformation.translation() -= Math::Vector3<btScalar>{_positionOrigin};
+    arrayAppend(primitiveInstanceData(primitive), InPlaceInit,
+        Matrix4{relativeTransformation},
+        Color3{Math::Vector3<btScalar>{color}});
+
+    /* See drawLine() for why */
+    #if BT_BULLET_VERSION < 284
+    flushLines();
+    #endif
+}
+
+void DebugDraw::drawBox(const btVector3& bbMin, const btVector3& bbMax, const btVector3& color) {
+    if(!(_flags & Flag::InstancedPrimitives) || _baking)
+        return btIDebugDraw::drawBox(bbMin, bbMax, color);
+
+    const Math::Vector3<btScalar> min{bbMin}, max{bbMax};
+    addPrimitiveInstance(BoxPrimitive,
+        Math::Matrix4<btScalar>::translation((min + max)*btScalar(0.5))*
+        Math::Matrix4<btScalar>::scaling((max - min)*btScalar(0.5)), color);
+}
+
+void DebugDraw::drawBox(const btVector3& bbMin, const btVector3& bbMax, const btTransform& transform, const btVector3& color) {
+    if(!(_flags & Flag::InstancedPrimitives) || _baking)
+        return btIDebugDraw::drawBox(bbMin, bbMax, transform, color);
+
+    const Math::Vector3<btScalar> min{bbMin}, max{bbMax};
+    addPrimitiveInstance(BoxPrimitive,
+        Math::Matrix4<btScalar>{transform}*
+        Math::Matrix4<btScalar>::translation((min + max)*btScalar(0.5))*
+        Math::Matrix4<btScalar>::scaling((max - min)*btScalar(0.5)), color);
+}
+
+void DebugDraw::drawAabb(const btVector3& from, const btVector3& to, const btVector3& color) {
+    if(!(_flags & Flag::InstancedPrimitives) || _baking)
+        return btIDebugDraw::drawAabb(from, to, color);
+
+    drawBox(from, to, color);
+}
+
+void DebugDraw::drawSphere(const btScalar radius, const btTransform& transform, const btVector3& color) {
+    if(!(_flags & Flag::InstancedPrimitives) || _baking)
+        return btIDebugDraw::drawSphere(radius, transform, color);
+
+    addPrimitiveInstance(SpherePrimitive,
+        Math::Matrix4<btScalar>{transform}*
+        Math::Matrix4<btScalar>::scaling(Math::Vector3<btScalar>{radius}), color);
+}
+
+void DebugDraw::drawSphere(const btVector3& position, const btScalar radius, const btVector3& color) {
+    if(!(_flags & Flag::InstancedPrimitives) || _baking)
+        return btIDebugDraw::drawSphere(position, radius, color);
+
+    addPrimitiveInstance(SpherePrimitive,
+        Math::Matrix4<btScalar>::translation(Math::Vector3<btScalar>{position})*
+        Math::Matrix4<btScalar>::scaling(Math::Vector3<btScalar>{radius}), color);
+}
+
+void DebugDraw::drawTransform(const btTransform& transform, const btScalar orthoLength) {
+    if(!(_flags & Flag::InstancedPrimitives) || _baking)
+        return btIDebugDraw::drawTransform(transform, orthoLength);
+
+    /* The color is taken from the vertex data */
+    addPrimitiveInstance(TransformPrimitive,
+        Math::Matrix4<btScalar>{transform}*
+        Math::Matrix4<btScalar>::scaling(Math::Vector3<btScalar>{orthoLength}), btVector3{1, 1, 1});
+}
+
+#if BT_BULLET_VERSION >= 284
+namespace {
+
+bool isStaticObject(const btCollisionObject& object) {
+    return object.isStaticObject() || object.getActivationState() == ISLAND_SLEEPING;
+}
+
+}
+
+bool DebugDraw::updateStaticObjects(btCollisionWorld& world) {
+    CORRADE_ASSERT(world.getDebugDrawer() == this,
+        "BulletIntegration::DebugDraw::updateStaticObjects(): the instance is not set as a debug drawer of the world", false);
+
+    /* Check if any baked object moved or woke up, or if there's a new
+       object that could be baked. Objects that have the visualization
+       disabled by the user are left untouched. */
+    bool dirty = false;
+    for(const StaticObject& baked: _staticObjects) {
+        if(!isStaticObject(*baked.object) ||
+           Math::Matrix4<btScalar>{baked.object->getWorldTransform()} != baked.transformation)
+        {
+            dirty = true;
+            break;
+        }
+    }
+    if(!dirty) for(std::int_fast32_t i = 0; i != world.getNumCollisionObjects(); ++i) {
+        const btCollisionObject& object = *world.getCollisionObjectArray()[i];
+        if(!(object.getCollisionFlags() & btCollisionObject::CF_DISABLE_VISUALIZE_OBJECT) && isStaticObject(object)) {
+            dirty = true;
+            break;
+        }
+    }
+    if(!dirty) return false;
+
+    /* Make everything baked previously drawn by Bullet again, and then bake
+       everything that's static now from scratch */
+    for(const StaticObject& baked: _staticObjects)
+        baked.object->setCollisionFlags(baked.object->getCollisionFlags() & ~btCollisionObject::CF_DISABLE_VISUALIZE_OBJECT);
+    arrayResize(_staticObjects, 0);
+    arrayResize(_staticBufferData, 0);
+    _staticPositionOrigin = _positionOrigin;
+
+    /* Drawn the same way as btCollisionWorld::debugDrawWorld() does, except
+       that everything goes to the static buffer */
+    _baking = true;
+    const DefaultColors colors = getDefaultColors();
+    for(std::int_fast32_t i = 0; i != world.getNumCollisionObjects(); ++i) {
+        btCollisionObject& object = *world.getCollisionObjectArray()[i];
+        if((object.getCollisionFlags() & btCollisionObject::CF_DISABLE_VISUALIZE_OBJECT) || !isStaticObject(object))
+            continue;
+
+        if(_mode & Mode::DrawWireframe) {
+            btVector3 color;
+            switch(object.getActivationState()) {
+                case ACTIVE_TAG:
+                    color = colors.m_activeObject;
+                    break;
+                case ISLAND_SLEEPING:
+                    color = colors.m_deactivatedObject;
+                    break;
+                case WANTS_DEACTIVATION:
+                    color = colors.m_wantsDeactivationObject;
+                    break;
+                case DISABLE_DEACTIVATION:
+                    color = colors.m_disabledDeactivationObject;
+                    break;
+                case DISABLE_SIMULATION:
+                    color = colors.m_disabledSimulationObject;
+                    break;
+                default:
+                    color = btVector3{btScalar(1.0), btScalar(0.0), btScalar(0.0)};
+            }
+            object.getCustomDebugColor(color);
+            world.debugDrawObject(object.getWorldTransform(), object.getCollisionShape(), color);
+        }
+        if(_mode & Mode::DrawAabb) {
+            btVector3 min, max;
+            object.getCollisionShape()->getAabb(object.getWorldTransform(), min, max);
+            const btVector3 contactThreshold{gContactBreakingThreshold, gContactBreakingThreshold, gContactBreakingThreshold};
+            drawAabb(min - contactThreshold, max + contactThreshold, colors.m_aabb);
+        }
+
+        object.setCollisionFlags(object.getCollisionFlags() | btCollisionObject::CF_DISABLE_VISUALIZE_OBJECT);
+        arrayAppend(_staticObjects, InPlaceInit, &object, Math::Matrix4<btScalar>{object.getWorldTransform()});
+    }
+    _baking = false;
+
+    if(!_staticBuffer.id()) setupLineMesh(_staticMesh, _staticBuffer);
+    _staticBuffer.setData(_staticBufferData, GL::BufferUsage::StaticDraw);
+    _staticMesh.setCount(_staticBufferData.size()/_vertexSize);
+
+    return true;
 }
 
+void DebugDraw::clearStaticObjects() {
+    for(const StaticObject& baked: _staticObjects)
+        baked.object->setCollisionFlags(baked.object->getCollisionFlags() & ~btCollisionObject::CF_DISABLE_VISUALIZE_OBJECT);
+    arrayResize(_staticObjects, 0);
+    arrayResize(_staticBufferData, 0);
+    if(_staticBuffer.id()) _staticMesh.setCount(0);
+}
+#endif
+
 void DebugDraw::flushLines() {
-    /* Update buffer with new data */
-    _buffer.setData(_bufferData, GL::BufferUsage::DynamicDraw);
+    MAGNUM_INTEGRATION_CPU_ZONE("BulletIntegration::DebugDraw::flushLines()");
+    MAGNUM_INTEGRATION_GPU_ZONE("BulletIntegration::DebugDraw::flushLines()");
+
+    /* Positions are relative to the origin, add it back */
+    const Matrix4 transformationProjectionMatrix = _transformationProjectionMatrix*Matrix4::translation(_positionOrigin);
 
-    /* Update shader and draw */
-    _mesh.setCount(_bufferData.size()/2);
-    _shader
-        .setTransformationProjectionMatrix(_transformationProjectionMatrix)
-        .draw(_mesh);
+    /* Baked static geometry, relative to the origin at the time it was
+       baked */
+    if(!_staticBufferData.isEmpty()) _shader
+        .setTransformationProjectionMatrix(_transformationProjectionMatrix*Matrix4::translation(_staticPositionOrigin))
+        .draw(_staticMesh);
+
+    /* Merge data collected by all threads. Assumes no thread is drawing
+       anymore, so no locking is done. The per-thread arrays keep their
+       capacity for the next frame. */
+    if(_threadState) for(Containers::Pointer<ThreadData>& data: _threadState->threads) {
+        if(!data->bufferData.isEmpty()) {
+            Utility::copy(data->bufferData, arrayAppend(_bufferData, NoInit, data->bufferData.size()));
+            arrayResize(data->bufferData, 0);
+        }
+        for(UnsignedInt i = 0; i != Containers::arraySize(_primitiveInstances); ++i) {
+            if(data->primitiveInstances[i].isEmpty()) continue;
+            Utility::copy(data->primitiveInstances[i], arrayAppend(_primitiveInstances[i], NoInit, data->primitiveInstances[i].size()));
+            arrayResize(data->primitiveInstances[i], 0);
+        }
+    }
 
-    /* Clear buffer to receive new data */
-    arrayResize(_bufferData, 0);
+    if(!_bufferData.isEmpty()) {
+        GL::Mesh& mesh = _meshes[_currentBuffer];
+        uploadGrowing(_buffers[_currentBuffer], _bufferCapacities[_currentBuffer], _bufferData);
+
+        /* Update shader and draw */
+        mesh.setCount(_bufferData.size()/_vertexSize);
+        _shader
+            .setTransformationProjectionMatrix(transformationProjectionMatrix)
+            .draw(mesh);
+
+        /* Use the other buffer next time, if enabled */
+        if(_flags & Flag::DoubleBuffered) _currentBuffer ^= 1;
+
+        /* Clear buffer to receive new data */
+        arrayResize(_bufferData, 0);
+    }
+
+    /* All text labels in a single draw */
+    #ifdef MAGNUM_BULLETINTEGRATION_HAS_TEXT
+    if(_textRenderer && _textRenderer->glyphCount()) {
+        _textShader
+            .setTransformationProjectionMatrix(Matrix3::projection(_viewportSize))
+            .setColor(_textColor)
+            .bindVectorTexture(_glyphCache->texture())
+            .draw(_textRenderer->mesh());
+        _textRenderer->clear();
+    }
+    #endif
+
+    /* One instanced draw for each primitive type */
+    bool instancedShaderSetUp = false;
+    for(UnsignedInt i = 0; i != Containers::arraySize(_primitiveInstances); ++i) {
+        if(_primitiveInstances[i].isEmpty()) continue;
+
+        if(!instancedShaderSetUp) {
+            _instancedShader.setTransformationProjectionMatrix(transformationProjectionMatrix);
+            instancedShaderSetUp = true;
+        }
+
+        uploadGrowing(_instanceBuffers[i], _instanceBufferCapacities[i], _primitiveInstances[i]);
+        _primitiveMeshes[i].setInstanceCount(_primitiveInstances[i].size());
+        _instancedShader.draw(_primitiveMeshes[i]);
+
+        arrayResize(_primitiveInstances[i], 0);
+    }
 }
 
 }}
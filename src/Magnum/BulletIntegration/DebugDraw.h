@@ -32,15 +32,27 @@
  */
 
 #include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Pointer.h>
 #include <Corrade/Utility/Macros.h>
 #include <LinearMath/btIDebugDraw.h>
 #include <Magnum/GL/Buffer.h>
 #include <Magnum/GL/Mesh.h>
+#include <Magnum/Math/Constants.h>
+#include <Magnum/Math/Frustum.h>
 #include <Magnum/Math/Matrix4.h>
+#include <Magnum/Shaders/FlatGL.h>
 #include <Magnum/Shaders/VertexColorGL.h>
 
 #include "Magnum/BulletIntegration/Integration.h"
 
+#ifdef MAGNUM_BULLETINTEGRATION_HAS_TEXT
+#include <Magnum/Shaders/VectorGL.h>
+#include <Magnum/Text/Text.h>
+#endif
+
+class btCollisionObject;
+class btCollisionWorld;
+
 namespace Magnum { namespace BulletIntegration {
 
 /**
@@ -58,6 +70,103 @@ Set up an instance and attach it to Bullet world:
 Then, at every frame, call this:
 
 @snippet BulletIntegration.cpp DebugDraw-usage-per-frame
+
+@section BulletIntegration-DebugDraw-buffers GPU buffer management
+
+The collected lines are uploaded into a GPU buffer that keeps its capacity
+across frames, growing geometrically only if there's more lines than ever
+before. With @ref Flag::DoubleBuffered the class alternates between two
+buffers, so an upload doesn't have to wait for the GPU to finish drawing from
+the buffer filled previously.
+
+By default, each vertex is a 32-bit float position and a 32-bit float RGB
+color, which is 48 bytes per line. With @ref Flag::PackedColors the colors are
+stored as normalized 8-bit RGBA values and with @ref Flag::HalfFloatPositions
+the positions are stored as half-floats, getting down to 24 bytes per line
+with both. Because half-floats have only 11 bits of precision, the positions
+are stored relative to @ref positionOrigin(), which you should set close to
+the camera position before the lines are drawn:
+
+@snippet BulletIntegration.cpp DebugDraw-compact
+
+@section BulletIntegration-DebugDraw-instanced Instanced primitives
+
+Bullet draws boxes, spheres, bounding boxes and coordinate frames as a series
+of individual lines, which for example for a bounding box means 12 line
+segments. With @ref Flag::InstancedPrimitives these are instead collected as
+a transformation and color of a unit wireframe box, sphere or axis triad and
+drawn with a single instanced draw call for each primitive type, using
+@ref Shaders::FlatGL3D with @ref Shaders::FlatGL3D::Flag::InstancedTransformation.
+
+@section BulletIntegration-DebugDraw-culling Culling
+
+In large worlds, most of the debug geometry is usually outside of the view.
+With @ref Flag::FrustumCulling, a view frustum is extracted from the matrix
+passed to @ref setTransformationProjectionMatrix() and lines and primitives
+coming from Bullet that are completely outside of it are dropped right away,
+without being converted or uploaded. Additionally, contact points can be
+dropped beyond a distance from the @ref positionOrigin() set with
+@ref setContactPointCullDistance():
+
+@snippet BulletIntegration.cpp DebugDraw-culling
+
+Lines added with @ref addLines() are not culled.
+
+@section BulletIntegration-DebugDraw-threads Drawing from multiple threads
+
+By default, all drawing is expected to happen from a single thread. With
+@ref Flag::ThreadSafe, each thread that draws into the instance gets its own
+line and primitive buffers, so for example disjoint ranges of collision
+objects can be passed to @cpp btCollisionWorld::debugDrawObject() @ce from
+multiple threads in parallel. The thread buffers are then merged together in
+@cpp flushLines() @ce, which has to be called only after all threads finish
+drawing:
+
+@snippet BulletIntegration.cpp DebugDraw-threads
+
+Registering a thread with the instance is guarded by a mutex, but after that
+the drawing is without any locking. The buffers are kept for the lifetime of
+the instance, so it's advised to use a fixed thread pool.
+
+@section BulletIntegration-DebugDraw-static Baking static geometry
+
+Static collision shapes such as terrain or level geometry produce the same
+lines every frame. Calling @ref updateStaticObjects() every frame before
+@cpp btCollisionWorld::debugDrawWorld() @ce bakes wireframes and bounding
+boxes of all static and sleeping objects into a retained mesh and excludes
+them from per-frame drawing using @cpp btCollisionObject::CF_DISABLE_VISUALIZE_OBJECT @ce.
+The mesh is rebuilt only when a baked object moves or wakes up, or when a new
+object becomes static:
+
+@snippet BulletIntegration.cpp DebugDraw-static
+
+The baked geometry is drawn in every @cpp flushLines() @ce call and isn't
+affected by @ref Flag::FrustumCulling. Objects that have
+@cpp btCollisionObject::CF_DISABLE_VISUALIZE_OBJECT @ce set by the user are
+left untouched.
+
+@note Baking static geometry is available only with Bullet 2.83.5 and newer.
+
+@section BulletIntegration-DebugDraw-text Text
+
+Text labels drawn by Bullet with @ref Mode::DrawText or
+@ref Mode::DrawFeaturesText are rendered once a font is set with
+@ref setTextFont(). The labels are projected to the screen using the matrix
+passed to @ref setTransformationProjectionMatrix() and rendered through a
+single @ref Text::RendererGL into one mesh, so all labels in a frame are
+drawn with a single draw call using @ref Shaders::VectorGL2D. The glyph cache
+is not owned by the class and can be shared with other text rendering in the
+application, the font is expected to have all glyphs that the labels use
+already present in it. As with any other text rendering, blending has to be
+enabled for the labels to be drawn properly:
+
+@snippet BulletIntegration-text.cpp DebugDraw-text
+
+@note Text drawing is available only if the @ref Text library was found when
+    building BulletIntegration, in which case the
+    @cpp MAGNUM_BULLETINTEGRATION_HAS_TEXT @ce macro is defined in
+    @cpp Magnum/BulletIntegration/configure.h @ce. Otherwise text labels
+    drawn by Bullet are ignored.
 */
 class MAGNUM_BULLETINTEGRATION_EXPORT DebugDraw: public btIDebugDraw {
     public:
@@ -91,7 +200,10 @@ class MAGNUM_BULLETINTEGRATION_EXPORT DebugDraw: public btIDebugDraw {
             /** Enable text drawing */
             DrawText = DBG_DrawText,
 
-            /** Profile timings */
+            /**
+             * Profile timings. Not acted on by Bullet itself, see
+             * @ref Profiler for a way to access the timings.
+             */
             ProfileTimings = DBG_ProfileTimings,
 
             /** Enable Sat Comparison */
@@ -132,14 +244,98 @@ class MAGNUM_BULLETINTEGRATION_EXPORT DebugDraw: public btIDebugDraw {
          */
         typedef Containers::EnumSet<Mode> Modes;
 
+        /**
+         * @brief Flag
+         * @m_since_latest_{integration}
+         *
+         * @see @ref Flags, @ref DebugDraw(Flags, std::size_t), @ref flags()
+         */
+        enum class Flag: UnsignedByte {
+            /**
+             * Alternate between two GPU buffers in consecutive
+             * `flushLines()` calls to avoid an implicit synchronization
+             * with the GPU when updating a buffer that's still being drawn
+             * from. Doubles the GPU memory used.
+             */
+            DoubleBuffered = 1 << 0,
+
+            /**
+             * Store vertex colors as normalized 8-bit RGBA values instead
+             * of 32-bit float RGB values.
+             */
+            PackedColors = 1 << 1,
+
+            /**
+             * Store vertex positions as half-floats instead of 32-bit floats.
+             * The positions are relative to @ref positionOrigin(), set it
+             * close to the camera to keep the precision loss in the visible
+             * area low.
+             * @requires_gl30 Extension @gl_extension{ARB,half_float_vertex}
+             * @requires_gles30 Extension @gl_extension{OES,vertex_half_float}
+             *      in OpenGL ES 2.0.
+             * @requires_webgl20 Half-float vertex attributes are not
+             *      available in WebGL 1.0.
+             */
+            HalfFloatPositions = 1 << 2,
+
+            /**
+             * Draw boxes, spheres, bounding boxes and coordinate frames as
+             * instanced unit meshes instead of individual lines. See
+             * @ref BulletIntegration-DebugDraw-instanced for more
+             * information.
+             * @requires_gl33 Extension @gl_extension{ARB,instanced_arrays}
+             * @requires_gles30 Extension @gl_extension{ANGLE,instanced_arrays},
+             *      @gl_extension{EXT,instanced_arrays} or
+             *      @gl_extension{NV,instanced_arrays} in OpenGL ES 2.0.
+             * @requires_webgl20 Extension @webgl_extension{ANGLE,instanced_arrays}
+             *      in WebGL 1.0.
+             */
+            InstancedPrimitives = 1 << 3,
+
+            /**
+             * Drop lines and primitives that are outside of the view frustum
+             * extracted from @ref setTransformationProjectionMatrix(). See
+             * @ref BulletIntegration-DebugDraw-culling for more
+             * information.
+             */
+            FrustumCulling = 1 << 4,
+
+            /**
+             * Allow lines and primitives to be drawn from multiple threads
+             * in parallel. See @ref BulletIntegration-DebugDraw-threads for
+             * more information.
+             */
+            ThreadSafe = 1 << 5
+        };
+
+        /**
+         * @brief Flags
+         * @m_since_latest_{integration}
+         *
+         * @see @ref DebugDraw(Flags, std::size_t), @ref flags()
+         */
+        typedef Containers::EnumSet<Flag> Flags;
+
         /**
          * @brief Constructor
+         * @param flags                     Flags
          * @param initialBufferCapacity     Amount of lines for which to
          *      reserve memory in the buffer vector.
+         * @m_since_latest_{integration}
          *
          * Sets up @ref Shaders::VertexColorGL3D, @ref GL::Buffer and
          * @ref GL::Mesh for physics debug rendering.
          */
+        explicit DebugDraw(Flags flags, std::size_t initialBufferCapacity = 0);
+
+        /**
+         * @brief Constructor
+         * @param initialBufferCapacity     Amount of lines for which to
+         *      reserve memory in the buffer vector.
+         *
+         * Equivalent to calling @ref DebugDraw(Flags, std::size_t) with
+         * empty @p flags.
+         */
         explicit DebugDraw(std::size_t initialBufferCapacity = 0);
 
         /**
@@ -166,6 +362,12 @@ class MAGNUM_BULLETINTEGRATION_EXPORT DebugDraw: public btIDebugDraw {
         /** @brief Copying is not allowed */
         DebugDraw& operator=(const DebugDraw&) = delete;
 
+        /**
+         * @brief Flags
+         * @m_since_latest_{integration}
+         */
+        Flags flags() const { return _flags; }
+
         /** @brief Debug mode */
         Modes mode() const { return _mode; }
 
@@ -189,12 +391,180 @@ class MAGNUM_BULLETINTEGRATION_EXPORT DebugDraw: public btIDebugDraw {
             return *this;
         }
 
-        /** @brief Set transformation projection matrix used for rendering */
+        /**
+         * @brief Set transformation projection matrix used for rendering
+         *
+         * If @ref Flag::FrustumCulling is enabled, the view frustum used for
+         * culling is extracted from it as well, which means it should be set
+         * before the lines for given frame get drawn.
+         */
         DebugDraw& setTransformationProjectionMatrix(const Matrix4& matrix) {
             _transformationProjectionMatrix = matrix;
+            if(_flags & Flag::FrustumCulling)
+                _frustum = Frustum::fromMatrix(matrix);
             return *this;
         }
 
+        /**
+         * @brief Contact point cull distance
+         * @m_since_latest_{integration}
+         */
+        Float contactPointCullDistance() const {
+            return _contactPointCullDistance;
+        }
+
+        /**
+         * @brief Set contact point cull distance
+         * @return Reference to self (for method chaining)
+         * @m_since_latest_{integration}
+         *
+         * Contact points farther than @p distance from
+         * @ref positionOrigin() are not drawn. Independent of
+         * @ref Flag::FrustumCulling. Default is
+         * @ref Constants::inf(), i.e. no contact points are dropped.
+         */
+        DebugDraw& setContactPointCullDistance(Float distance) {
+            _contactPointCullDistance = distance;
+            return *this;
+        }
+
+        /**
+         * @brief Origin of stored vertex positions
+         * @m_since_latest_{integration}
+         */
+        Vector3 positionOrigin() const { return _positionOrigin; }
+
+        /**
+         * @brief Set origin of stored vertex positions
+         * @return Reference to self (for method chaining)
+         * @m_since_latest_{integration}
+         *
+         * Line positions are stored relative to this point, which is then
+         * added back when drawing. Useful mainly with
+         * @ref Flag::HalfFloatPositions to keep the precision loss close to
+         * the camera low. Affects only lines drawn after the call, so it
+         * should be set before the lines for given frame get drawn. Default
+         * is a zero vector.
+         */
+        DebugDraw& setPositionOrigin(const Vector3& origin) {
+            _positionOrigin = origin;
+            return *this;
+        }
+
+        /**
+         * @brief Reserve memory for lines
+         * @return Reference to self (for method chaining)
+         * @m_since_latest_{integration}
+         *
+         * Ensures there's enough capacity for @p count more lines on top of
+         * the lines already collected since the last flush, so the following
+         * @ref addLines() or Bullet-issued line drawing doesn't need to
+         * reallocate.
+         */
+        DebugDraw& reserveLines(std::size_t count);
+
+        /**
+         * @brief Add lines of a single color
+         * @return Reference to self (for method chaining)
+         * @m_since_latest_{integration}
+         *
+         * Bulk alternative to lines drawn by Bullet, useful for drawing
+         * additional visualization together with the physics world. Each two
+         * consecutive items in @p positions form a line, expects that the
+         * count is even. The color is converted to the vertex format just
+         * once and then copied to all vertices. The lines get drawn in the
+         * next `flushLines()` together with everything else, so call it
+         * before @cpp btDynamicsWorld::debugDrawWorld() @ce.
+         * @see @ref reserveLines()
+         */
+        DebugDraw& addLines(const Containers::StridedArrayView1D<const Vector3>& positions, const Color3& color);
+
+        /**
+         * @brief Add lines with per-vertex colors
+         * @return Reference to self (for method chaining)
+         * @m_since_latest_{integration}
+         *
+         * Like @ref addLines(const Containers::StridedArrayView1D<const Vector3>&, const Color3&),
+         * but with a color for each item in @p positions. Expects that
+         * @p colors has the same size as @p positions.
+         */
+        DebugDraw& addLines(const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const Color3>& colors);
+
+        #ifdef MAGNUM_BULLETINTEGRATION_HAS_TEXT
+        /**
+         * @brief Set font for drawing text labels
+         * @param font          Font to shape the text with
+         * @param glyphCache    Glyph cache filled with glyphs of @p font
+         * @param size          Font size in pixels
+         * @return Reference to self (for method chaining)
+         * @m_since_latest_{integration}
+         *
+         * Both @p font and @p glyphCache are expected to be alive for the
+         * whole instance lifetime. Until this function is called, text
+         * labels drawn by Bullet are ignored. See
+         * @ref BulletIntegration-DebugDraw-text for more information.
+         * @note Available only if the @ref Text library was found when
+         *      building BulletIntegration.
+         * @see @ref setViewportSize(), @ref setTextColor()
+         */
+        DebugDraw& setTextFont(Text::AbstractFont& font, Text::GlyphCacheGL& glyphCache, Float size);
+
+        /**
+         * @brief Set viewport size
+         * @return Reference to self (for method chaining)
+         * @m_since_latest_{integration}
+         *
+         * Used to position and size text labels in pixels. Should be set
+         * before the labels for given frame get drawn.
+         * @note Available only if the @ref Text library was found when
+         *      building BulletIntegration.
+         */
+        DebugDraw& setViewportSize(const Vector2i& size) {
+            _viewportSize = Vector2{size};
+            return *this;
+        }
+
+        /**
+         * @brief Set text color
+         * @return Reference to self (for method chaining)
+         * @m_since_latest_{integration}
+         *
+         * Default is @cpp 0xffffffff_rgbaf @ce.
+         * @note Available only if the @ref Text library was found when
+         *      building BulletIntegration.
+         */
+        DebugDraw& setTextColor(const Color4& color) {
+            _textColor = color;
+            return *this;
+        }
+        #endif
+
+        #if BT_BULLET_VERSION >= 284
+        /**
+         * @brief Bake static and sleeping objects
+         * @return Whether the baked geometry was rebuilt
+         * @m_since_latest_{integration}
+         *
+         * Expects that the instance is set as a debug drawer of @p world.
+         * See @ref BulletIntegration-DebugDraw-static for more information.
+         * @note Available only with Bullet 2.83.5 and newer.
+         * @see @ref clearStaticObjects()
+         */
+        bool updateStaticObjects(btCollisionWorld& world);
+
+        /**
+         * @brief Clear baked static objects
+         * @m_since_latest_{integration}
+         *
+         * Makes all objects baked by @ref updateStaticObjects() drawn by
+         * Bullet again and clears the baked geometry. Should be called before
+         * the baked objects get destroyed if the instance is meant to be used
+         * further.
+         * @note Available only with Bullet 2.83.5 and newer.
+         */
+        void clearStaticObjects();
+        #endif
+
     private:
         void setDebugMode(int debugMode) override;
         int getDebugMode() const override;
@@ -203,6 +573,25 @@ class MAGNUM_BULLETINTEGRATION_EXPORT DebugDraw: public btIDebugDraw {
         void drawContactPoint(const btVector3& pointOnB, const btVector3& normalOnB, btScalar distance, int lifeTime, const btVector3& color) override;
         void reportErrorWarning(const char *warningString) override;
         void draw3dText(const btVector3& location, const char* textString) override;
+        void drawBox(const btVector3& bbMin, const btVector3& bbMax, const btVector3& color) override;
+        void drawBox(const btVector3& bbMin, const btVector3& bbMax, const btTransform& transform, const btVector3& color) override;
+        void drawAabb(const btVector3& from, const btVector3& to, const btVector3& color) override;
+        void drawSphere(btScalar radius, const btTransform& transform, const btVector3& color) override;
+        void drawSphere(const btVector3& position, btScalar radius, const btVector3& color) override;
+        void drawTransform(const btTransform& transform, btScalar orthoLength) override;
+        struct ThreadData;
+        struct ThreadState;
+        struct PrimitiveInstance;
+
+        void setupLineMesh(GL::Mesh& mesh, GL::Buffer& buffer) const;
+        ThreadData& threadData();
+        Containers::Array<char>& lineData();
+        Containers::Array<PrimitiveInstance>& primitiveInstanceData(UnsignedInt primitive);
+        bool isLineCulled(const btVector3& from, const btVector3& to) const;
+        void addPrimitiveInstance(UnsignedInt primitive, const Math::Matrix4<btScalar>& transformation, const btVector3& color);
+        void writePosition(char* out, const Vector3& relativePosition) const;
+        void writePosition(char* out, const btVector3& position) const;
+        void writeColor(char* out, const Color3& color) const;
         void flushLines()
             /* See comment in drawLine() for detailed rant */
             #if BT_BULLET_VERSION >= 284
@@ -211,20 +600,86 @@ class MAGNUM_BULLETINTEGRATION_EXPORT DebugDraw: public btIDebugDraw {
             ;
 
         Modes _mode{};
+        Flags _flags;
 
         Matrix4 _transformationProjectionMatrix;
+        Vector3 _positionOrigin;
+        /* Used by Flag::FrustumCulling */
+        Frustum _frustum;
+        Float _contactPointCullDistance{Constants::inf()};
         Shaders::VertexColorGL3D _shader;
 
-        GL::Buffer _buffer;
-        GL::Mesh _mesh;
-        Containers::Array<Vector3> _bufferData;
+        /* The second buffer and mesh is created only with
+           Flag::DoubleBuffered. Capacity is in bytes. */
+        GL::Buffer _buffers[2]{GL::Buffer{NoCreate}, GL::Buffer{NoCreate}};
+        GL::Mesh _meshes[2]{GL::Mesh{NoCreate}, GL::Mesh{NoCreate}};
+        std::size_t _bufferCapacities[2]{};
+        UnsignedInt _currentBuffer{};
+        /* Layout depends on Flag::PackedColors and Flag::HalfFloatPositions,
+           colors are right after the position */
+        UnsignedInt _colorOffset{}, _vertexSize{};
+        Containers::Array<char> _bufferData;
+
+        /* Used by Flag::InstancedPrimitives. Indexed by a box, sphere and
+           transform primitive, the static vertex data of all three are in a
+           single buffer. */
+        struct PrimitiveInstance {
+            Matrix4 transformation;
+            Color3 color;
+        };
+        Shaders::FlatGL3D _instancedShader{NoCreate};
+        GL::Buffer _primitiveBuffer{NoCreate};
+        GL::Buffer _instanceBuffers[3]{GL::Buffer{NoCreate}, GL::Buffer{NoCreate}, GL::Buffer{NoCreate}};
+        GL::Mesh _primitiveMeshes[3]{GL::Mesh{NoCreate}, GL::Mesh{NoCreate}, GL::Mesh{NoCreate}};
+        std::size_t _instanceBufferCapacities[3]{};
+        Containers::Array<PrimitiveInstance> _primitiveInstances[3];
+
+        /* Used by Flag::ThreadSafe */
+        Containers::Pointer<ThreadState> _threadState;
+
+        /* Used by updateStaticObjects(). The lines are collected into a
+           separate buffer while baking. */
+        struct StaticObject {
+            btCollisionObject* object;
+            Math::Matrix4<btScalar> transformation;
+        };
+        bool _baking{};
+        Vector3 _staticPositionOrigin;
+        GL::Buffer _staticBuffer{NoCreate};
+        GL::Mesh _staticMesh{NoCreate};
+        Containers::Array<StaticObject> _staticObjects;
+        Containers::Array<char> _staticBufferData;
+
+        #ifdef MAGNUM_BULLETINTEGRATION_HAS_TEXT
+        /* Used by setTextFont(), all labels go into a single renderer */
+        Text::GlyphCacheGL* _glyphCache{};
+        Containers::Pointer<Text::AbstractShaper> _textShaper;
+        Containers::Pointer<Text::RendererGL> _textRenderer;
+        Shaders::VectorGL2D _textShader{NoCreate};
+        Float _textSize{};
+        Vector2 _viewportSize{1.0f};
+        Color4 _textColor{1.0f};
+        #endif
 };
 
 CORRADE_ENUMSET_OPERATORS(DebugDraw::Modes)
+CORRADE_ENUMSET_OPERATORS(DebugDraw::Flags)
 
 /** @debugoperatorenum{Magnum::BulletIntegration::DebugDraw::Mode} */
 MAGNUM_BULLETINTEGRATION_EXPORT Debug& operator<<(Debug& debug, DebugDraw::Mode value);
 
+/**
+ * @debugoperatorclassenum{DebugDraw,DebugDraw::Flag}
+ * @m_since_latest_{integration}
+ */
+MAGNUM_BULLETINTEGRATION_EXPORT Debug& operator<<(Debug& debug, DebugDraw::Flag value);
+
+/**
+ * @debugoperatorclassenum{DebugDraw,DebugDraw::Flags}
+ * @m_since_latest_{integration}
+ */
+MAGNUM_BULLETINTEGRATION_EXPORT Debug& operator<<(Debug& debug, DebugDraw::Flags value);
+
 }}
 
 #endif
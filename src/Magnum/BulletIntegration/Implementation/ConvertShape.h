@@ -0,0 +1,70 @@
+#ifndef Magnum_BulletIntegration_Implementation_ConvertShape_h
+#define Magnum_BulletIntegration_Implementation_ConvertShape_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstddef>
+#include <functional>
+#include <Magnum/Magnum.h>
+#include <Magnum/Trade/Trade.h>
+
+#include "Magnum/BulletIntegration/visibility.h"
+
+class btCollisionShape;
+
+namespace Magnum { namespace BulletIntegration { namespace Implementation {
+
+/* Identifies a unit mesh that's shared among all identical shapes. Boxes and
+   spheres have just one unit mesh each, the capsule mesh depends on the axis
+   and the aspect ratio quantized to a 1/1024th of the radius. Convex hulls
+   and triangle meshes are identified by the shape pointer. */
+struct ShapeMeshKey {
+    Int type;
+    UnsignedInt parameter;
+    const void* shape;
+
+    bool operator==(const ShapeMeshKey& other) const {
+        return type == other.type && parameter == other.parameter && shape == other.shape;
+    }
+};
+
+struct ShapeMeshKeyHash {
+    std::size_t operator()(const ShapeMeshKey& key) const {
+        return std::hash<const void*>{}(key.shape) ^ (std::size_t(key.type) << 1) ^ (std::size_t(key.parameter) << 8);
+    }
+};
+
+/* Returns false if the shape isn't supported. Otherwise fills the key of the
+   unit mesh and the transformation that makes the unit mesh match the
+   shape. */
+MAGNUM_BULLETINTEGRATION_LOCAL bool shapeMeshKey(const btCollisionShape& shape, ShapeMeshKey& key, Matrix4& transformation);
+
+/* Creates the unit mesh for a key returned from shapeMeshKey() */
+MAGNUM_BULLETINTEGRATION_LOCAL Trade::MeshData shapeMesh(const btCollisionShape& shape, const ShapeMeshKey& key);
+
+}}}
+
+#endif
@@ -0,0 +1,103 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Integration.h"
+
+#include <cstring>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Magnum/Math/Matrix4.h>
+
+namespace Magnum { namespace BulletIntegration {
+
+void convertInto(const Containers::StridedArrayView1D<const btVector3>& src, const Containers::StridedArrayView1D<Math::Vector3<btScalar>>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "BulletIntegration::convertInto(): expected source and destination views to have the same size, got" << src.size() << "and" << dst.size(), );
+
+    const std::size_t size = src.size();
+    std::size_t i = 0;
+
+    /* If the destination is contiguous, a full four-component store
+       overwrites the first component of the next vector, which then gets
+       overwritten again in the next iteration. The last element has to go
+       through the scalar path to not write past the end. */
+    #if defined(BT_USE_SSE) && !defined(BT_USE_DOUBLE_PRECISION)
+    if(dst.stride() == sizeof(Math::Vector3<btScalar>)) {
+        char* out = static_cast<char*>(dst.data());
+        for(; i + 1 < size; ++i, out += sizeof(Math::Vector3<btScalar>))
+            _mm_storeu_ps(reinterpret_cast<float*>(out), src[i].get128());
+    }
+    #endif
+
+    for(; i != size; ++i)
+        std::memcpy(dst[i].data(), src[i].m_floats, sizeof(Math::Vector3<btScalar>));
+}
+
+void convertInto(const Containers::StridedArrayView1D<const Math::Vector3<btScalar>>& src, const Containers::StridedArrayView1D<btVector3>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "BulletIntegration::convertInto(): expected source and destination views to have the same size, got" << src.size() << "and" << dst.size(), );
+
+    const std::size_t size = src.size();
+    std::size_t i = 0;
+
+    /* If the source is contiguous, a four-component load reads the first
+       component of the next vector as well, which is then cleared. Again
+       the last element has to go through the scalar path to not read past
+       the end. */
+    #if defined(BT_USE_SSE) && !defined(BT_USE_DOUBLE_PRECISION)
+    if(src.stride() == sizeof(Math::Vector3<btScalar>)) {
+        const char* in = static_cast<const char*>(src.data());
+        for(; i + 1 < size; ++i, in += sizeof(Math::Vector3<btScalar>)) {
+            dst[i].set128(_mm_loadu_ps(reinterpret_cast<const float*>(in)));
+            dst[i].setW(0.0f);
+        }
+    }
+    #endif
+
+    for(; i != size; ++i) {
+        std::memcpy(dst[i].m_floats, src[i].data(), sizeof(Math::Vector3<btScalar>));
+        dst[i].setW(btScalar(0.0));
+    }
+}
+
+void convertInto(const Containers::StridedArrayView1D<const btTransform>& src, const Containers::StridedArrayView1D<Math::Matrix4<btScalar>>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "BulletIntegration::convertInto(): expected source and destination views to have the same size, got" << src.size() << "and" << dst.size(), );
+
+    /* Same as RectangularMatrixConverter<4, 4, btScalar, btTransform>::from(),
+       but without going through a temporary */
+    for(std::size_t i = 0, size = src.size(); i != size; ++i)
+        src[i].getOpenGLMatrix(dst[i].data());
+}
+
+void convertInto(const Containers::StridedArrayView1D<const Math::Matrix4<btScalar>>& src, const Containers::StridedArrayView1D<btTransform>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "BulletIntegration::convertInto(): expected source and destination views to have the same size, got" << src.size() << "and" << dst.size(), );
+
+    for(std::size_t i = 0, size = src.size(); i != size; ++i)
+        dst[i].setFromOpenGLMatrix(src[i].data());
+}
+
+}}
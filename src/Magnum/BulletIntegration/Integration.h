@@ -53,9 +53,17 @@ Example usage:
 
 @snippet BulletIntegration.cpp Integration
 
+For converting large arrays of vectors or transformations, such as contact
+points, soft body nodes or ray cast results, use
+@ref Magnum::BulletIntegration::convertInto() "BulletIntegration::convertInto()",
+which operates on whole strided views at once:
+
+@snippet BulletIntegration.cpp Integration-bulk
+
 @see @ref types-thirdparty-integration
 */
 
+#include <Corrade/Containers/Containers.h>
 #include <LinearMath/btMatrix3x3.h>
 #include <LinearMath/btTransform.h>
 #include <Magnum/Math/RectangularMatrix.h>
@@ -118,4 +126,51 @@ template<> struct QuaternionConverter<btScalar, btQuaternion> {
 }}}
 #endif
 
+namespace Magnum { namespace BulletIntegration {
+
+/**
+@brief Convert a list of Bullet vectors
+@m_since_latest_{integration}
+
+Expects that both views have the same size. Equivalent to converting each
+element separately, but the fourth padding component of the source
+@m_class{m-doc-external} [btVector3](https://pybullet.org/Bullet/BulletFull/classbtVector3.html)
+is used to copy a whole 128-bit register at once if Bullet is built with SSE
+and the destination is contiguous.
+*/
+MAGNUM_BULLETINTEGRATION_EXPORT void convertInto(const Containers::StridedArrayView1D<const btVector3>& src, const Containers::StridedArrayView1D<Math::Vector3<btScalar>>& dst);
+
+/**
+@brief Convert a list of vectors to Bullet vectors
+@m_since_latest_{integration}
+
+Expects that both views have the same size. The fourth padding component of
+the destination @m_class{m-doc-external} [btVector3](https://pybullet.org/Bullet/BulletFull/classbtVector3.html)
+is set to zero. If Bullet is built with SSE and the source is contiguous, a
+whole 128-bit register is copied at once.
+*/
+MAGNUM_BULLETINTEGRATION_EXPORT void convertInto(const Containers::StridedArrayView1D<const Math::Vector3<btScalar>>& src, const Containers::StridedArrayView1D<btVector3>& dst);
+
+/**
+@brief Convert a list of Bullet transformations
+@m_since_latest_{integration}
+
+Expects that both views have the same size. Equivalent to converting each
+element separately, but the result is written directly into the destination
+memory.
+*/
+MAGNUM_BULLETINTEGRATION_EXPORT void convertInto(const Containers::StridedArrayView1D<const btTransform>& src, const Containers::StridedArrayView1D<Math::Matrix4<btScalar>>& dst);
+
+/**
+@brief Convert a list of transformations to Bullet transformations
+@m_since_latest_{integration}
+
+Expects that both views have the same size. Equivalent to converting each
+element separately, but the result is written directly into the destination
+memory.
+*/
+MAGNUM_BULLETINTEGRATION_EXPORT void convertInto(const Containers::StridedArrayView1D<const Math::Matrix4<btScalar>>& src, const Containers::StridedArrayView1D<btTransform>& dst);
+
+}}
+
 #endif
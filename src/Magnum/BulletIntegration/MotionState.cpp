@@ -27,22 +27,118 @@
 
 #include "MotionState.h"
 
+#include <Magnum/Math/DualQuaternion.h>
 #include <Magnum/Math/Matrix4.h>
 #include <Magnum/Math/Functions.h>
+#include <Magnum/SceneGraph/DualQuaternionTransformation.h>
+#include <Magnum/SceneGraph/MatrixTransformation3D.h>
+#include <Magnum/SceneGraph/RigidMatrixTransformation3D.h>
+#include <Magnum/SceneGraph/TranslationRotationScalingTransformation3D.h>
 
 #include "Magnum/BulletIntegration/Integration.h"
 
 #ifdef BT_USE_DOUBLE_PRECISION
 #include <Magnum/SceneGraph/AbstractFeature.hpp>
+#include <Magnum/SceneGraph/Object.hpp>
 #endif
 
 namespace Magnum { namespace BulletIntegration {
 
+namespace Implementation {
+
+namespace {
+
+/* Bullet sometimes reports NaNs for all the parameters and nobody is sure
+   why: https://pybullet.org/Bullet/phpBB3/viewtopic.php?t=12080. The setters
+   return false in that case, the caller is responsible for warning. */
+
+bool isNan(const Math::Matrix4<btScalar>& matrix) {
+    for(std::size_t i = 0; i != 4; ++i)
+        if(Math::isNan(matrix[i]).any()) return true;
+    return false;
+}
+
+bool isNan(const Math::Vector3<btScalar>& position, const Math::Quaternion<btScalar>& rotation) {
+    return Math::isNan(position).any() || Math::isNan(rotation.vector()).any() || Math::isNan(rotation.scalar());
+}
+
+bool setTranslationRotation(SceneGraph::AbstractBasicTranslationRotation3D<btScalar>& transformation, const btTransform& worldTrans) {
+    const auto position = Math::Vector3<btScalar>{worldTrans.getOrigin()};
+    const auto axis = Math::Vector3<btScalar>{worldTrans.getRotation().getAxis()};
+    const auto rotation = Math::Rad<btScalar>{worldTrans.getRotation().getAngle()};
+    if(Math::isNan(position).any() || Math::isNan(axis).any() || Math::isNan(rotation))
+        return false;
+
+    transformation.resetTransformation()
+        .rotate(rotation, axis.normalized())
+        .translate(position);
+    return true;
+}
+
+/* The matrix-based transformations take the basis and origin as-is, without
+   going through a quaternion at all */
+template<class T> bool setMatrix(SceneGraph::AbstractBasicTranslationRotation3D<btScalar>& transformation, const btTransform& worldTrans) {
+    const Math::Matrix4<btScalar> matrix{worldTrans};
+    if(isNan(matrix)) return false;
+
+    static_cast<T&>(transformation).setTransformation(matrix);
+    return true;
+}
+
+bool setDualQuaternion(SceneGraph::AbstractBasicTranslationRotation3D<btScalar>& transformation, const btTransform& worldTrans) {
+    const auto position = Math::Vector3<btScalar>{worldTrans.getOrigin()};
+    const auto rotation = Math::Quaternion<btScalar>{worldTrans.getRotation()};
+    if(isNan(position, rotation)) return false;
+
+    /* The quaternion Bullet calculates from the basis is normalized only
+       approximately, while setTransformation() asserts on that */
+    static_cast<SceneGraph::BasicDualQuaternionTransformation<btScalar>&>(transformation).setTransformation(
+        Math::DualQuaternion<btScalar>::translation(position)*
+        Math::DualQuaternion<btScalar>{rotation.normalized()});
+    return true;
+}
+
+bool setTranslationRotationScaling(SceneGraph::AbstractBasicTranslationRotation3D<btScalar>& transformation, const btTransform& worldTrans) {
+    const auto position = Math::Vector3<btScalar>{worldTrans.getOrigin()};
+    const auto rotation = Math::Quaternion<btScalar>{worldTrans.getRotation()};
+    if(isNan(position, rotation)) return false;
+
+    /* Scaling is left untouched, Bullet doesn't have any */
+    static_cast<SceneGraph::BasicTranslationRotationScalingTransformation3D<btScalar>&>(transformation)
+        .setTranslation(position)
+        .setRotation(rotation.normalized());
+    return true;
+}
+
+}
+
+TransformationSetter transformationSetter(SceneGraph::AbstractBasicTranslationRotation3D<btScalar>&) {
+    return setTranslationRotation;
+}
+
+TransformationSetter transformationSetter(SceneGraph::BasicMatrixTransformation3D<btScalar>&) {
+    return setMatrix<SceneGraph::BasicMatrixTransformation3D<btScalar>>;
+}
+
+TransformationSetter transformationSetter(SceneGraph::BasicRigidMatrixTransformation3D<btScalar>&) {
+    return setMatrix<SceneGraph::BasicRigidMatrixTransformation3D<btScalar>>;
+}
+
+TransformationSetter transformationSetter(SceneGraph::BasicDualQuaternionTransformation<btScalar>&) {
+    return setDualQuaternion;
+}
+
+TransformationSetter transformationSetter(SceneGraph::BasicTranslationRotationScalingTransformation3D<btScalar>&) {
+    return setTranslationRotationScaling;
+}
+
+}
+
 /* The original btMotionState is not dllexported on Windows, so the constructor
    and destructor of this class have to be non-inline in order to avoid the
    need for having btMotionState constructor exported */
 
-MotionState::MotionState(SceneGraph::AbstractBasicObject3D<btScalar>& object, SceneGraph::AbstractBasicTranslationRotation3D<btScalar>& transformation): SceneGraph::AbstractBasicFeature3D<btScalar>{object}, _transformation(transformation) {}
+MotionState::MotionState(SceneGraph::AbstractBasicObject3D<btScalar>& object, SceneGraph::AbstractBasicTranslationRotation3D<btScalar>& transformation, Implementation::TransformationSetter setter): SceneGraph::AbstractBasicFeature3D<btScalar>{object}, _transformation(transformation), _setter{setter} {}
 
 MotionState::~MotionState() = default;
 
@@ -53,25 +149,15 @@ void MotionState::getWorldTransform(btTransform& worldTrans) const {
 }
 
 void MotionState::setWorldTransform(const btTransform& worldTrans) {
-    const auto position = Math::Vector3<btScalar>{worldTrans.getOrigin()};
-    const auto axis = Math::Vector3<btScalar>{worldTrans.getRotation().getAxis()};
-    const auto rotation = Math::Rad<btScalar>{worldTrans.getRotation().getAngle()};
-
-    /* Bullet sometimes reports NaNs for all the parameters and nobody is sure
-       why: https://pybullet.org/Bullet/phpBB3/viewtopic.php?t=12080. The body
-       gets stuck in that state, so print the warning just once. */
-    if(Math::isNan(position).any() || Math::isNan(axis).any() || Math::isNan(rotation)) {
+    /** @todo Verify that all objects have common parent */
+    if(!_setter(_transformation, worldTrans)) {
+        /* The body gets stuck in the NaN state, so print the warning just
+           once */
         if(!_broken) {
             Warning{} << "BulletIntegration::MotionState: Bullet reported NaN transform for" << this << Debug::nospace << ", ignoring";
             _broken = true;
         }
-        return;
     }
-
-    /** @todo Verify that all objects have common parent */
-    _transformation.resetTransformation()
-        .rotate(rotation, axis.normalized())
-        .translate(position);
 }
 
 }}
@@ -36,11 +36,25 @@
 #include <LinearMath/btMotionState.h>
 #include <Magnum/SceneGraph/AbstractFeature.h>
 #include <Magnum/SceneGraph/AbstractTranslationRotation3D.h>
+#include <Magnum/SceneGraph/SceneGraph.h>
 
 #include "Magnum/BulletIntegration/visibility.h"
 
 namespace Magnum { namespace BulletIntegration {
 
+namespace Implementation {
+    /* Returns false if the transform contains NaNs and it wasn't applied */
+    typedef bool(*TransformationSetter)(SceneGraph::AbstractBasicTranslationRotation3D<btScalar>&, const btTransform&);
+
+    /* Overloads picking a direct path for concrete transformation types, the
+       most derived one wins for a particular SceneGraph::Object */
+    MAGNUM_BULLETINTEGRATION_EXPORT TransformationSetter transformationSetter(SceneGraph::AbstractBasicTranslationRotation3D<btScalar>&);
+    MAGNUM_BULLETINTEGRATION_EXPORT TransformationSetter transformationSetter(SceneGraph::BasicMatrixTransformation3D<btScalar>&);
+    MAGNUM_BULLETINTEGRATION_EXPORT TransformationSetter transformationSetter(SceneGraph::BasicRigidMatrixTransformation3D<btScalar>&);
+    MAGNUM_BULLETINTEGRATION_EXPORT TransformationSetter transformationSetter(SceneGraph::BasicDualQuaternionTransformation<btScalar>&);
+    MAGNUM_BULLETINTEGRATION_EXPORT TransformationSetter transformationSetter(SceneGraph::BasicTranslationRotationScalingTransformation3D<btScalar>&);
+}
+
 /**
 @brief Bullet Physics motion state
 
@@ -75,6 +89,10 @@ Keep in mind that changes to a rigid body using
 non-static objects and while @cpp btDynamicsWorld::stepSimulation() @ce is
 called.
 
+For scenes with a large amount of dynamic bodies, consider using
+@ref RigidBodySynchronizer instead, which updates all bodies in a single pass
+after the simulation step.
+
 @attention All objects with a @ref MotionState attached that are part of the
     same Bullet world need to have a single common parent object, otherwise the
     transformations will not propagate correctly.
@@ -84,8 +102,19 @@ class MAGNUM_BULLETINTEGRATION_EXPORT MotionState: public SceneGraph::AbstractBa
         /**
          * @brief Constructor
          * @param object    Object this motion state belongs to
+         *
+         * If the object uses @ref SceneGraph::BasicMatrixTransformation3D "SceneGraph::MatrixTransformation3D",
+         * @ref SceneGraph::BasicRigidMatrixTransformation3D "SceneGraph::RigidMatrixTransformation3D",
+         * @ref SceneGraph::BasicDualQuaternionTransformation "SceneGraph::DualQuaternionTransformation"
+         * or @ref SceneGraph::BasicTranslationRotationScalingTransformation3D "SceneGraph::TranslationRotationScalingTransformation3D",
+         * the Bullet transformation is converted to the native
+         * representation of given transformation type directly. Other
+         * transformation implementations go through
+         * @ref SceneGraph::AbstractBasicTranslationRotation3D::rotate() "rotate()"
+         * and @relativeref{SceneGraph::AbstractBasicTranslationRotation3D,translate()}
+         * with the rotation decomposed to an axis and angle.
          */
-        template<class T> MotionState(T& object): MotionState{object, object} {}
+        template<class T> MotionState(T& object): MotionState{object, object, Implementation::transformationSetter(object)} {}
 
         ~MotionState();
 
@@ -108,9 +137,10 @@ class MAGNUM_BULLETINTEGRATION_EXPORT MotionState: public SceneGraph::AbstractBa
         void setWorldTransform(const btTransform& worldTrans) override;
 
     private:
-        explicit MotionState(SceneGraph::AbstractBasicObject3D<btScalar>& object, SceneGraph::AbstractBasicTranslationRotation3D<btScalar>& transformation);
+        explicit MotionState(SceneGraph::AbstractBasicObject3D<btScalar>& object, SceneGraph::AbstractBasicTranslationRotation3D<btScalar>& transformation, Implementation::TransformationSetter setter);
 
         SceneGraph::AbstractBasicTranslationRotation3D<btScalar>& _transformation;
+        Implementation::TransformationSetter _setter;
         bool _broken{false};
 };
 
@@ -0,0 +1,125 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Profiler.h"
+
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Utility/Debug.h>
+#include <LinearMath/btQuickprof.h>
+
+namespace Magnum { namespace BulletIntegration {
+
+using namespace Containers::Literals;
+
+namespace {
+
+#ifndef BT_NO_PROFILE
+void collect(CProfileIterator& iterator, const UnsignedInt depth, Containers::Array<Profiler::Sample>& samples) {
+    /* Enter_Parent() resets the iterator to the first child, so the position
+       has to be restored after each recursion. The trees are small, so the
+       quadratic complexity doesn't really matter. */
+    iterator.First();
+    for(int i = 0; !iterator.Is_Done(); ++i) {
+        arrayAppend(samples, InPlaceInit,
+            Containers::StringView{iterator.Get_Current_Name(), Containers::StringViewFlag::Global},
+            depth,
+            UnsignedInt(iterator.Get_Current_Total_Calls()),
+            Float(iterator.Get_Current_Total_Time()));
+
+        iterator.Enter_Child(i);
+        collect(iterator, depth + 1, samples);
+        iterator.Enter_Parent();
+
+        iterator.First();
+        for(int j = 0; j <= i && !iterator.Is_Done(); ++j)
+            iterator.Next();
+    }
+}
+#endif
+
+}
+
+Profiler::Profiler() = default;
+
+Profiler& Profiler::endFrame() {
+    arrayClear(_samples);
+    for(Float& i: _phaseTimes) i = 0.0f;
+    _frameTime = 0.0f;
+
+    #ifndef BT_NO_PROFILE
+    if(CProfileIterator* const iterator = CProfileManager::Get_Iterator()) {
+        collect(*iterator, 0, _samples);
+        CProfileManager::Release_Iterator(iterator);
+    }
+    _frameTime = Float(CProfileManager::Get_Time_Since_Reset());
+
+    /* Scope names as used in btCollisionWorld and btDiscreteDynamicsWorld */
+    for(const Sample& sample: _samples) {
+        Phase phase;
+        if(sample.name == "updateAabbs"_s || sample.name == "calculateOverlappingPairs"_s)
+            phase = Phase::Broadphase;
+        else if(sample.name == "dispatchAllCollisionPairs"_s)
+            phase = Phase::Narrowphase;
+        else if(sample.name == "solveConstraints"_s)
+            phase = Phase::Solver;
+        else if(sample.name == "predictUnconstraintMotion"_s || sample.name == "integrateTransforms"_s)
+            phase = Phase::Integration;
+        else continue;
+
+        _phaseTimes[UnsignedInt(phase)] += sample.time;
+    }
+
+    CProfileManager::Reset();
+    CProfileManager::Increment_Frame_Counter();
+    #endif
+
+    return *this;
+}
+
+Float Profiler::phaseTime(const Phase phase) const {
+    CORRADE_ASSERT(UnsignedInt(phase) < Containers::arraySize(_phaseTimes),
+        "BulletIntegration::Profiler::phaseTime(): invalid phase" << phase, {});
+    return _phaseTimes[UnsignedInt(phase)];
+}
+
+Debug& operator<<(Debug& debug, const Profiler::Phase value) {
+    debug << "BulletIntegration::Profiler::Phase" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case Profiler::Phase::value: return debug << "::" #value;
+        _c(Broadphase)
+        _c(Narrowphase)
+        _c(Solver)
+        _c(Integration)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "(" << Debug::nospace << Debug::hex << UnsignedByte(value) << Debug::nospace << ")";
+}
+
+}}
@@ -0,0 +1,180 @@
+#ifndef Magnum_BulletIntegration_Profiler_h
+#define Magnum_BulletIntegration_Profiler_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::BulletIntegration::Profiler
+ * @m_since_latest_{integration}
+ */
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StringView.h>
+#include <Magnum/Magnum.h>
+
+#include "Magnum/BulletIntegration/visibility.h"
+
+namespace Magnum { namespace BulletIntegration {
+
+/**
+@brief Bullet profiler adapter
+@m_since_latest_{integration}
+
+Collects samples of the Bullet built-in profiler, which are measured in
+@cpp BT_PROFILE() @ce scopes inside Bullet and accessible through
+@cpp CProfileManager @ce, and exposes them as a flat per-frame array.
+
+@section BulletIntegration-Profiler-usage Usage
+
+Call @ref endFrame() once after each frame's simulation steps. It copies
+all samples collected since the previous call and resets the Bullet profiler
+for the next frame. The samples can be then printed or shown for example in an
+ImGui window using @ref ImGuiIntegration, indented by their
+@ref Sample::depth:
+
+@snippet BulletIntegration.cpp Profiler-usage
+
+Times of the main simulation phases, summed over all simulation steps in the
+frame, are available through @ref phaseTime(). That's useful for example for
+logging only the phase which caused a step time spike.
+
+The @ref DebugDraw::Mode::ProfileTimings debug mode isn't acted on by Bullet
+itself, use this class to access the timings instead.
+
+@attention If Bullet is built with @cpp BT_NO_PROFILE @ce, the profiler isn't
+    present and @ref samples() are always empty. Since Bullet 2.87 the
+    profiler is also per-thread and only samples from the main thread are
+    collected.
+*/
+class MAGNUM_BULLETINTEGRATION_EXPORT Profiler {
+    public:
+        /**
+         * @brief Simulation phase
+         *
+         * @see @ref phaseTime()
+         */
+        enum class Phase: UnsignedByte {
+            /**
+             * Broadphase. Combination of the @cpp "updateAabbs" @ce and
+             * @cpp "calculateOverlappingPairs" @ce samples.
+             */
+            Broadphase,
+
+            /**
+             * Narrowphase. The @cpp "dispatchAllCollisionPairs" @ce sample.
+             */
+            Narrowphase,
+
+            /** Constraint solver. The @cpp "solveConstraints" @ce sample. */
+            Solver,
+
+            /**
+             * Integration. Combination of the
+             * @cpp "predictUnconstraintMotion" @ce and
+             * @cpp "integrateTransforms" @ce samples.
+             */
+            Integration
+        };
+
+        /**
+         * @brief Profiler sample
+         *
+         * @see @ref samples()
+         */
+        struct Sample {
+            /**
+             * @brief Name
+             *
+             * Name of the @cpp BT_PROFILE() @ce scope. Bullet uses string
+             * literals for these, so the view is
+             * @ref Containers::StringViewFlag::Global "global".
+             */
+            Containers::StringView name;
+
+            /**
+             * @brief Depth in the profile tree
+             *
+             * Top-level samples have a depth of @cpp 0 @ce. Samples are
+             * ordered depth-first, so children of a sample always directly
+             * follow it.
+             */
+            UnsignedInt depth;
+
+            /** @brief How many times the scope was entered in the frame */
+            UnsignedInt callCount;
+
+            /** @brief Total time spent in the scope in the frame, in milliseconds */
+            Float time;
+        };
+
+        /** @brief Constructor */
+        explicit Profiler();
+
+        /**
+         * @brief End a frame
+         * @return Reference to self (for method chaining)
+         *
+         * Replaces @ref samples(), @ref frameTime() and @ref phaseTime()
+         * with data collected since the previous call and resets the Bullet
+         * profiler.
+         */
+        Profiler& endFrame();
+
+        /**
+         * @brief Samples from the last frame
+         *
+         * Populated by @ref endFrame().
+         */
+        Containers::ArrayView<const Sample> samples() const { return _samples; }
+
+        /**
+         * @brief Duration of the last frame
+         *
+         * Time between the two last @ref endFrame() calls, in milliseconds.
+         */
+        Float frameTime() const { return _frameTime; }
+
+        /**
+         * @brief Time spent in a simulation phase in the last frame
+         *
+         * Sum of times of samples corresponding to given @p phase, in
+         * milliseconds. If the phase wasn't present in the last frame,
+         * returns @cpp 0.0f @ce.
+         */
+        Float phaseTime(Phase phase) const;
+
+    private:
+        Containers::Array<Sample> _samples;
+        Float _frameTime{};
+        Float _phaseTimes[4]{};
+};
+
+/** @debugoperatorclassenum{Profiler,Profiler::Phase} */
+MAGNUM_BULLETINTEGRATION_EXPORT Debug& operator<<(Debug& debug, Profiler::Phase value);
+
+}}
+
+#endif
@@ -0,0 +1,254 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "RigidBodySynchronizer.h"
+
+#include <Corrade/Containers/EnumSet.hpp>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Utility/Debug.h>
+#include <BulletDynamics/Dynamics/btRigidBody.h>
+#include <Magnum/Math/Functions.h>
+#include <Magnum/Math/Quaternion.h>
+
+#include "Magnum/BulletIntegration/Integration.h"
+
+namespace Magnum { namespace BulletIntegration {
+
+struct RigidBodySynchronizer::Body {
+    btRigidBody* body;
+    SceneGraph::AbstractBasicTranslationRotation3D<btScalar>* transformation;
+    Implementation::TransformationSetter setter;
+    /* Same as MotionState::_broken */
+    bool broken;
+    /* Whether the body got updated in the last synchronize(), used only with
+       Flag::Interpolated */
+    bool moved;
+    /* Whether interpolate() placed the body at least once, used only with
+       Flag::Interpolated. Until then it's marked as changed even if it
+       doesn't move, otherwise static, kinematic or sleeping bodies would
+       never get their initial transformation. */
+    bool placed;
+};
+
+struct RigidBodySynchronizer::Transformation {
+    Math::Quaternion<btScalar> rotation;
+    Math::Vector3<btScalar> translation;
+};
+
+namespace {
+
+bool isNan(const Math::Quaternion<btScalar>& rotation, const Math::Vector3<btScalar>& translation) {
+    return Math::isNan(rotation.vector()).any() || Math::isNan(rotation.scalar()) || Math::isNan(translation).any();
+}
+
+}
+
+RigidBodySynchronizer::RigidBodySynchronizer(const Flags flags): _flags{flags} {}
+
+RigidBodySynchronizer::RigidBodySynchronizer(RigidBodySynchronizer&&) noexcept = default;
+
+RigidBodySynchronizer::~RigidBodySynchronizer() = default;
+
+RigidBodySynchronizer& RigidBodySynchronizer::operator=(RigidBodySynchronizer&&) noexcept = default;
+
+void RigidBodySynchronizer::reserve(const std::size_t capacity) {
+    arrayReserve(_bodies, capacity);
+    if(_flags & Flag::Interpolated) {
+        arrayReserve(_previous, capacity);
+        arrayReserve(_current, capacity);
+    }
+}
+
+std::size_t RigidBodySynchronizer::add(btRigidBody& body, SceneGraph::AbstractBasicTranslationRotation3D<btScalar>& transformation, const Implementation::TransformationSetter setter) {
+    const std::size_t id = _bodies.size();
+    arrayAppend(_bodies, InPlaceInit, &body, &transformation, setter, false, false, false);
+
+    if(_flags & Flag::Interpolated) {
+        /* Both previous and current is the initial body transformation, so
+           the first interpolate() places it regardless of alpha */
+        const btTransform& worldTrans = body.getWorldTransform();
+        const Transformation initial{
+            Math::Quaternion<btScalar>{worldTrans.getRotation()},
+            Math::Vector3<btScalar>{worldTrans.getOrigin()}};
+        arrayAppend(_previous, initial);
+        arrayAppend(_current, initial);
+
+        /* Grow the bit array with a doubling capacity */
+        if(_changed.size() <= id) {
+            Containers::BitArray changed{ValueInit, Math::max(_changed.size()*2, std::size_t{64})};
+            for(std::size_t i = 0; i != id; ++i)
+                if(_changed[i]) changed.set(i);
+            _changed = std::move(changed);
+        }
+        _changed.set(id);
+    }
+
+    return id;
+}
+
+void RigidBodySynchronizer::remove(btRigidBody& body) {
+    std::size_t i = 0;
+    for(; i != _bodies.size(); ++i)
+        if(_bodies[i].body == &body) break;
+    CORRADE_ASSERT(i != _bodies.size(),
+        "BulletIntegration::RigidBodySynchronizer::remove(): body not found", );
+
+    const std::size_t last = _bodies.size() - 1;
+    if(i != last) {
+        _bodies[i] = _bodies[last];
+        if(_flags & Flag::Interpolated) {
+            _previous[i] = _previous[last];
+            _current[i] = _current[last];
+            if(_changed[last]) _changed.set(i);
+            else _changed.reset(i);
+        }
+    }
+    arrayRemoveSuffix(_bodies);
+    if(_flags & Flag::Interpolated) {
+        arrayRemoveSuffix(_previous);
+        arrayRemoveSuffix(_current);
+        _changed.reset(last);
+    }
+}
+
+std::size_t RigidBodySynchronizer::synchronize() {
+    if(_flags & Flag::Interpolated) {
+        std::size_t count = 0;
+        for(std::size_t i = 0; i != _bodies.size(); ++i) {
+            Body& b = _bodies[i];
+            _previous[i] = _current[i];
+
+            bool moved = false;
+            if(b.body->isActive() && !b.body->isStaticOrKinematicObject()) {
+                const btTransform& worldTrans = b.body->getWorldTransform();
+                const auto rotation = Math::Quaternion<btScalar>{worldTrans.getRotation()};
+                const auto translation = Math::Vector3<btScalar>{worldTrans.getOrigin()};
+                if(!isNan(rotation, translation)) {
+                    _current[i] = {rotation, translation};
+                    moved = true;
+                    ++count;
+                } else if(!b.broken) {
+                    Warning{} << "BulletIntegration::RigidBodySynchronizer::synchronize(): Bullet reported NaN transform for" << b.body << Debug::nospace << ", ignoring";
+                    b.broken = true;
+                }
+            }
+
+            /* If the body moved in the previous step but not in this one, the
+               last interpolate() call still didn't put it to its final
+               place, so it's marked as changed one more time. Same if it
+               wasn't placed at all yet. */
+            if(moved || b.moved || !b.placed) _changed.set(i);
+            else _changed.reset(i);
+            b.moved = moved;
+        }
+
+        return count;
+    }
+
+    std::size_t count = 0;
+    for(Body& b: _bodies) {
+        /* Same condition as in btDiscreteDynamicsWorld::synchronizeMotionStates()
+           and synchronizeSingleMotionState() */
+        if(!b.body->isActive() || b.body->isStaticOrKinematicObject())
+            continue;
+
+        /* See MotionState::setWorldTransform() for details */
+        if(!b.setter(*b.transformation, b.body->getWorldTransform())) {
+            if(!b.broken) {
+                Warning{} << "BulletIntegration::RigidBodySynchronizer::synchronize(): Bullet reported NaN transform for" << b.body << Debug::nospace << ", ignoring";
+                b.broken = true;
+            }
+            continue;
+        }
+
+        ++count;
+    }
+
+    return count;
+}
+
+Containers::BitArrayView RigidBodySynchronizer::changed() const {
+    CORRADE_ASSERT(_flags & Flag::Interpolated,
+        "BulletIntegration::RigidBodySynchronizer::changed(): the synchronizer wasn't created with Flag::Interpolated", {});
+    return _changed.prefix(_bodies.size());
+}
+
+Math::Matrix4<btScalar> RigidBodySynchronizer::interpolatedTransformation(const std::size_t id, const btScalar alpha) const {
+    CORRADE_ASSERT(_flags & Flag::Interpolated,
+        "BulletIntegration::RigidBodySynchronizer::interpolatedTransformation(): the synchronizer wasn't created with Flag::Interpolated", {});
+    CORRADE_ASSERT(id < _bodies.size(),
+        "BulletIntegration::RigidBodySynchronizer::interpolatedTransformation(): index" << id << "out of range for" << _bodies.size() << "bodies", {});
+
+    const Transformation& previous = _previous[id];
+    const Transformation& current = _current[id];
+    return Math::Matrix4<btScalar>::from(
+        Math::lerpShortestPath(previous.rotation, current.rotation, alpha).toMatrix(),
+        Math::lerp(previous.translation, current.translation, alpha));
+}
+
+std::size_t RigidBodySynchronizer::interpolate(const btScalar alpha) {
+    CORRADE_ASSERT(_flags & Flag::Interpolated,
+        "BulletIntegration::RigidBodySynchronizer::interpolate(): the synchronizer wasn't created with Flag::Interpolated", {});
+
+    std::size_t count = 0;
+    for(std::size_t i = 0; i != _bodies.size(); ++i) {
+        if(!_changed[i]) continue;
+
+        const Transformation& previous = _previous[i];
+        const Transformation& current = _current[i];
+        const btTransform worldTrans{
+            btQuaternion(Math::lerpShortestPath(previous.rotation, current.rotation, alpha)),
+            btVector3(Math::lerp(previous.translation, current.translation, alpha))};
+
+        /* NaNs were filtered out in synchronize() already */
+        _bodies[i].setter(*_bodies[i].transformation, worldTrans);
+        _bodies[i].placed = true;
+        ++count;
+    }
+
+    return count;
+}
+
+Debug& operator<<(Debug& debug, const RigidBodySynchronizer::Flag value) {
+    debug << "BulletIntegration::RigidBodySynchronizer::Flag" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case RigidBodySynchronizer::Flag::value: return debug << "::" #value;
+        _c(Interpolated)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "(" << Debug::nospace << Debug::hex << UnsignedByte(value) << Debug::nospace << ")";
+}
+
+Debug& operator<<(Debug& debug, const RigidBodySynchronizer::Flags value) {
+    return Containers::enumSetDebugOutput(debug, value, "BulletIntegration::RigidBodySynchronizer::Flags{}", {
+        RigidBodySynchronizer::Flag::Interpolated});
+}
+
+}}
@@ -0,0 +1,258 @@
+#ifndef Magnum_BulletIntegration_RigidBodySynchronizer_h
+#define Magnum_BulletIntegration_RigidBodySynchronizer_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::BulletIntegration::RigidBodySynchronizer
+ * @m_since_latest_{integration}
+ */
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/BitArray.h>
+#include <Corrade/Containers/EnumSet.h>
+#include <Magnum/Math/Matrix4.h>
+
+#include "Magnum/BulletIntegration/MotionState.h"
+
+class btRigidBody;
+
+namespace Magnum { namespace BulletIntegration {
+
+/**
+@brief Batch rigid body transformation synchronizer
+@m_since_latest_{integration}
+
+An alternative to @ref MotionState for scenes with many dynamic bodies. Instead
+of Bullet calling a virtual @cpp btMotionState::setWorldTransform() @ce for
+every active body inside @cpp btDynamicsWorld::stepSimulation() @ce, the
+rigid bodies and their scene graph objects are registered in a single
+contiguous list and their transformations are copied over in one pass after
+the simulation step.
+
+@section BulletIntegration-RigidBodySynchronizer-usage Usage
+
+Create the @cpp btRigidBody @ce without a motion state, place it where the
+scene graph object is and @ref add() both to the synchronizer. Then call
+@ref synchronize() after each simulation step:
+
+@snippet BulletIntegration.cpp RigidBodySynchronizer-usage
+
+Only bodies that are active, i.e. not sleeping, and are neither static nor
+kinematic are updated, matching what Bullet does for bodies with a motion
+state. The transformation that gets applied is the one from the last internal
+simulation step, without the sub-step interpolation Bullet does for motion
+states.
+
+@section BulletIntegration-RigidBodySynchronizer-interpolation Interpolated transformations
+
+When the simulation runs with a fixed time step that's independent of the
+rendering rate, enable @ref Flag::Interpolated. The synchronizer then keeps the
+previous and current transformation of each body in a packed array and
+@ref synchronize() no longer touches the scene graph. Instead, call
+@ref interpolate() before drawing each frame, with the fraction of the time
+step that passed since the last simulation step. Only bodies that are marked
+in @ref changed() get updated:
+
+@snippet BulletIntegration.cpp RigidBodySynchronizer-interpolation
+
+For rendering that doesn't go through the scene graph, the interpolated
+transformation of particular body can be retrieved with
+@ref interpolatedTransformation() and iterated with the @ref changed() bits.
+
+@attention Same as with @ref MotionState, all objects that are part of the
+    same Bullet world need to have a single common parent object, otherwise the
+    transformations will not propagate correctly.
+*/
+class MAGNUM_BULLETINTEGRATION_EXPORT RigidBodySynchronizer {
+    public:
+        /**
+         * @brief Flag
+         *
+         * @see @ref Flags, @ref RigidBodySynchronizer(Flags), @ref flags()
+         */
+        enum class Flag: UnsignedByte {
+            /**
+             * Keep the previous and current transformation of each body and
+             * apply them to the scene graph interpolated with
+             * @ref interpolate(). See
+             * @ref BulletIntegration-RigidBodySynchronizer-interpolation for
+             * more information.
+             */
+            Interpolated = 1 << 0
+        };
+
+        /**
+         * @brief Flags
+         *
+         * @see @ref RigidBodySynchronizer(Flags), @ref flags()
+         */
+        typedef Containers::EnumSet<Flag> Flags;
+
+        /** @brief Constructor */
+        explicit RigidBodySynchronizer(Flags flags = {});
+
+        /** @brief Copying is not allowed */
+        RigidBodySynchronizer(const RigidBodySynchronizer&) = delete;
+
+        /** @brief Move constructor */
+        RigidBodySynchronizer(RigidBodySynchronizer&&) noexcept;
+
+        ~RigidBodySynchronizer();
+
+        /** @brief Copying is not allowed */
+        RigidBodySynchronizer& operator=(const RigidBodySynchronizer&) = delete;
+
+        /** @brief Move assignment */
+        RigidBodySynchronizer& operator=(RigidBodySynchronizer&&) noexcept;
+
+        /** @brief Flags */
+        Flags flags() const { return _flags; }
+
+        /** @brief Count of registered bodies */
+        std::size_t size() const { return _bodies.size(); }
+
+        /**
+         * @brief Reserve memory for given count of bodies
+         *
+         * Useful to avoid reallocations when adding a large amount of bodies
+         * at once.
+         */
+        void reserve(std::size_t capacity);
+
+        /**
+         * @brief Add a rigid body
+         * @param body      Rigid body
+         * @param object    Scene graph object the body transformation is
+         *      copied to
+         * @return Index of the body in the synchronizer
+         *
+         * The @p body is expected to not have a motion state, otherwise its
+         * transformation would get synchronized twice. Both @p body and
+         * @p object are expected to stay alive until removed with
+         * @ref remove() or until the synchronizer is destructed. The
+         * transformation is applied the same way as described in the
+         * @ref MotionState::MotionState() "MotionState constructor"
+         * documentation, i.e. with a direct path for common transformation
+         * types.
+         */
+        template<class T> std::size_t add(btRigidBody& body, T& object) {
+            return add(body, object, Implementation::transformationSetter(object));
+        }
+
+        /**
+         * @brief Remove a rigid body
+         *
+         * Expects that @p body was added before. To keep the list contiguous,
+         * the last body is moved into the freed slot, changing its index.
+         */
+        void remove(btRigidBody& body);
+
+        /**
+         * @brief Synchronize transformations
+         * @return Count of bodies that got updated
+         *
+         * Copies the world transformation of all active bodies that are
+         * neither static nor kinematic to their scene graph objects. Call
+         * after @cpp btDynamicsWorld::stepSimulation() @ce.
+         *
+         * If @ref Flag::Interpolated is set, the scene graph isn't touched.
+         * Instead, the current transformations become the previous ones, the
+         * new world transformation of updated bodies is saved as current and
+         * @ref changed() is recalculated. Call this function after each
+         * internal simulation step in that case, as the interpolation happens
+         * only between results of two consecutive calls.
+         */
+        std::size_t synchronize();
+
+        /**
+         * @brief Bodies that changed since last frame
+         *
+         * Expects that @ref Flag::Interpolated is set. Size of the view is
+         * the same as @ref size(), bits are indexed the same as the IDs
+         * returned from @ref add(). A bit is set for a body that moved in the
+         * last @ref synchronize() or the one before, i.e. a body whose
+         * transformation in the scene graph isn't final yet. Newly added
+         * bodies are marked as changed as well, until the first
+         * @ref interpolate() call places them, regardless of how many
+         * @ref synchronize() calls happen in between.
+         */
+        Containers::BitArrayView changed() const;
+
+        /**
+         * @brief Interpolated transformation of a body
+         * @param id        Body ID returned from @ref add()
+         * @param alpha     Interpolation factor between the previous and
+         *      current simulation step, in range @f$ [0, 1] @f$
+         *
+         * Expects that @ref Flag::Interpolated is set. The translation is
+         * interpolated linearly, the rotation with
+         * @ref Math::lerpShortestPath(const Quaternion<T>&, const Quaternion<T>&, T).
+         */
+        Math::Matrix4<btScalar> interpolatedTransformation(std::size_t id, btScalar alpha) const;
+
+        /**
+         * @brief Apply interpolated transformations to the scene graph
+         * @param alpha     Interpolation factor between the previous and
+         *      current simulation step, in range @f$ [0, 1] @f$
+         * @return Count of bodies that got updated
+         *
+         * Expects that @ref Flag::Interpolated is set. Updates only objects
+         * of bodies marked in @ref changed().
+         */
+        std::size_t interpolate(btScalar alpha);
+
+    private:
+        struct Body;
+        struct Transformation;
+
+        std::size_t add(btRigidBody& body, SceneGraph::AbstractBasicTranslationRotation3D<btScalar>& transformation, Implementation::TransformationSetter setter);
+
+        Flags _flags;
+        Containers::Array<Body> _bodies;
+        /* Used only with Flag::Interpolated, the bit array is allocated with
+           a larger capacity to amortize the reallocations in add() */
+        Containers::Array<Transformation> _previous, _current;
+        Containers::BitArray _changed;
+};
+
+CORRADE_ENUMSET_OPERATORS(RigidBodySynchronizer::Flags)
+
+/**
+ * @debugoperatorclassenum{RigidBodySynchronizer,RigidBodySynchronizer::Flag}
+ * @m_since_latest_{integration}
+ */
+MAGNUM_BULLETINTEGRATION_EXPORT Debug& operator<<(Debug& debug, RigidBodySynchronizer::Flag value);
+
+/**
+ * @debugoperatorclassenum{RigidBodySynchronizer,RigidBodySynchronizer::Flags}
+ * @m_since_latest_{integration}
+ */
+MAGNUM_BULLETINTEGRATION_EXPORT Debug& operator<<(Debug& debug, RigidBodySynchronizer::Flags value);
+
+}}
+
+#endif
@@ -0,0 +1,82 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ShapeMeshCache.h"
+
+#include <unordered_map>
+#include <Magnum/GL/Mesh.h>
+#include <Magnum/MeshTools/Compile.h>
+#include <Magnum/Trade/MeshData.h>
+
+#include "Magnum/BulletIntegration/Implementation/ConvertShape.h"
+
+namespace Magnum { namespace BulletIntegration {
+
+struct ShapeMeshCache::State {
+    /* The map nodes don't move on rehash, so pointers to the meshes stay
+       valid */
+    std::unordered_map<Implementation::ShapeMeshKey, GL::Mesh, Implementation::ShapeMeshKeyHash> meshes;
+};
+
+ShapeMeshCache::ShapeMeshCache(): _state{InPlaceInit} {}
+
+ShapeMeshCache::ShapeMeshCache(ShapeMeshCache&&) noexcept = default;
+
+ShapeMeshCache::~ShapeMeshCache() = default;
+
+ShapeMeshCache& ShapeMeshCache::operator=(ShapeMeshCache&&) noexcept = default;
+
+std::size_t ShapeMeshCache::meshCount() const {
+    return _state->meshes.size();
+}
+
+Containers::Pair<GL::Mesh*, Matrix4> ShapeMeshCache::get(const btCollisionShape& shape) {
+    Implementation::ShapeMeshKey key;
+    Matrix4 transformation;
+    if(!Implementation::shapeMeshKey(shape, key, transformation))
+        return {nullptr, Matrix4{Math::IdentityInit}};
+
+    auto found = _state->meshes.find(key);
+    if(found == _state->meshes.end())
+        found = _state->meshes.emplace(key, MeshTools::compile(Implementation::shapeMesh(shape, key))).first;
+
+    return {&found->second, transformation};
+}
+
+bool ShapeMeshCache::remove(const btCollisionShape& shape) {
+    Implementation::ShapeMeshKey key;
+    Matrix4 transformation;
+    if(!Implementation::shapeMeshKey(shape, key, transformation) || !key.shape)
+        return false;
+
+    return _state->meshes.erase(key);
+}
+
+void ShapeMeshCache::clear() {
+    _state->meshes.clear();
+}
+
+}}
@@ -0,0 +1,147 @@
+#ifndef Magnum_BulletIntegration_ShapeMeshCache_h
+#define Magnum_BulletIntegration_ShapeMeshCache_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::BulletIntegration::ShapeMeshCache
+ * @m_since_latest_{integration}
+ */
+
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/Containers/Pointer.h>
+#include <Magnum/GL/GL.h>
+#include <Magnum/Math/Matrix4.h>
+
+#include "Magnum/BulletIntegration/visibility.h"
+
+class btCollisionShape;
+
+namespace Magnum { namespace BulletIntegration {
+
+/**
+@brief Cache of collision shape meshes
+@m_since_latest_{integration}
+
+Converts Bullet collision shapes to a @ref GL::Mesh using the same code as
+@ref convertShape() and shares the meshes among identical shapes, which makes
+it suitable for a solid visualization of a large amount of collision objects.
+
+@section BulletIntegration-ShapeMeshCache-usage Usage
+
+Query the mesh with @ref get() for each collision object. Together with the
+mesh, a transformation that makes the shared mesh match given shape is
+returned, which is meant to be applied after the collision object
+transformation. The mesh has @ref Shaders::GenericGL3D::Position and
+@ref Shaders::GenericGL3D::Normal attributes:
+
+@snippet BulletIntegration.cpp ShapeMeshCache-usage
+
+As the returned mesh pointers are the same for all shapes using the same mesh,
+they can also be used for grouping the collision objects and drawing them
+instanced, with the returned transformation being a part of the per-instance
+data.
+
+@section BulletIntegration-ShapeMeshCache-sharing Mesh sharing
+
+All @cpp btBoxShape @ce and @cpp btSphereShape @ce instances share a single
+unit mesh each, with their dimensions expressed in the returned
+transformation. For @cpp btCapsuleShape @ce the mesh depends on the up axis
+and the ratio of the half-height and radius, which is quantized to a 1/1024th
+of the radius, so capsules of the same proportions share a mesh as well.
+
+Meshes of @cpp btConvexHullShape @ce and @cpp btTriangleMeshShape @ce
+subclasses are made from their vertex data and are thus identified by the
+shape pointer. Their local scaling is returned in the transformation, so it
+can change without the mesh having to be recreated. If the shape gets
+destroyed or its vertex data change, call @ref remove() to ensure a stale
+mesh isn't returned for a different shape allocated at the same address.
+*/
+class MAGNUM_BULLETINTEGRATION_EXPORT ShapeMeshCache {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * The cache is initially empty, meshes are created on first
+         * @ref get() call for a particular shape.
+         */
+        explicit ShapeMeshCache();
+
+        /** @brief Copying is not allowed */
+        ShapeMeshCache(const ShapeMeshCache&) = delete;
+
+        /** @brief Move constructor */
+        ShapeMeshCache(ShapeMeshCache&&) noexcept;
+
+        ~ShapeMeshCache();
+
+        /** @brief Copying is not allowed */
+        ShapeMeshCache& operator=(const ShapeMeshCache&) = delete;
+
+        /** @brief Move assignment */
+        ShapeMeshCache& operator=(ShapeMeshCache&&) noexcept;
+
+        /**
+         * @brief Count of meshes in the cache
+         *
+         * Shapes sharing the same mesh are counted just once.
+         */
+        std::size_t meshCount() const;
+
+        /**
+         * @brief Mesh for given shape
+         *
+         * Returns a mesh and a transformation that makes it match the
+         * @p shape, creating the mesh if it's not in the cache yet. If the
+         * shape isn't supported by @ref convertShape(), returns
+         * @cpp nullptr @ce and an identity transformation. The mesh pointer
+         * stays valid until the entry is removed with @ref remove() or
+         * @ref clear() or the cache is destroyed.
+         */
+        Containers::Pair<GL::Mesh*, Matrix4> get(const btCollisionShape& shape);
+
+        /**
+         * @brief Remove a mesh made for given shape
+         *
+         * Removes the mesh identified by the pointer of a
+         * @cpp btConvexHullShape @ce or a @cpp btTriangleMeshShape @ce
+         * subclass. Returns @cpp false @ce if there's no such mesh in the
+         * cache or if the mesh is shared with other shapes, in which case it's
+         * kept.
+         */
+        bool remove(const btCollisionShape& shape);
+
+        /** @brief Remove all meshes */
+        void clear();
+
+    private:
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+}}
+
+#endif
@@ -0,0 +1,127 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "SoftBodyMesh.h"
+
+#include <Corrade/Containers/StridedArrayView.h>
+#include <BulletSoftBody/btSoftBody.h>
+#include <Magnum/Mesh.h>
+#include <Magnum/Math/Vector3.h>
+#include <Magnum/Shaders/GenericGL.h>
+
+#include "Magnum/BulletIntegration/Integration.h"
+
+namespace Magnum { namespace BulletIntegration {
+
+namespace {
+
+/* Interleaved position and normal */
+constexpr std::size_t VertexSize = 2*sizeof(Vector3);
+
+void copyVertexData(const btSoftBody& softBody, const Containers::ArrayView<char> data) {
+    const std::size_t count = data.size()/VertexSize;
+    if(!count) return;
+
+    const Containers::StridedArrayView1D<Vector3> positions{data, reinterpret_cast<Vector3*>(data.data()), count, VertexSize};
+    const Containers::StridedArrayView1D<Vector3> normals{data, reinterpret_cast<Vector3*>(data.data() + sizeof(Vector3)), count, VertexSize};
+
+    #ifndef BT_USE_DOUBLE_PRECISION
+    const Containers::StridedArrayView1D<const btSoftBody::Node> nodes = Containers::arrayView(&softBody.m_nodes[0], count);
+    convertInto(nodes.slice(&btSoftBody::Node::m_x), positions);
+    convertInto(nodes.slice(&btSoftBody::Node::m_n), normals);
+    #else
+    /* GL needs floats, so there's no way around a per-element cast */
+    for(std::size_t i = 0; i != count; ++i) {
+        positions[i] = Vector3{Math::Vector3<btScalar>{softBody.m_nodes[i].m_x}};
+        normals[i] = Vector3{Math::Vector3<btScalar>{softBody.m_nodes[i].m_n}};
+    }
+    #endif
+}
+
+}
+
+SoftBodyMesh::SoftBodyMesh(btSoftBody& softBody): _softBody{&softBody}, _nodeCount{UnsignedInt(softBody.m_nodes.size())} {
+    /* Index buffer from faces, or from links if there are no faces. Indices
+       are calculated from node pointers relative to the first node. */
+    const btSoftBody::Node* const firstNode = _nodeCount ? &softBody.m_nodes[0] : nullptr;
+    const bool hasFaces = softBody.m_faces.size() != 0;
+    Containers::Array<UnsignedInt> indices;
+    if(hasFaces) {
+        indices = Containers::Array<UnsignedInt>{NoInit, std::size_t(softBody.m_faces.size())*3};
+        for(std::size_t i = 0, count = softBody.m_faces.size(); i != count; ++i)
+            for(std::size_t j = 0; j != 3; ++j)
+                indices[i*3 + j] = UnsignedInt(softBody.m_faces[i].m_n[j] - firstNode);
+    } else {
+        indices = Containers::Array<UnsignedInt>{NoInit, std::size_t(softBody.m_links.size())*2};
+        for(std::size_t i = 0, count = softBody.m_links.size(); i != count; ++i)
+            for(std::size_t j = 0; j != 2; ++j)
+                indices[i*2 + j] = UnsignedInt(softBody.m_links[i].m_n[j] - firstNode);
+    }
+
+    _indexBuffer = GL::Buffer{GL::Buffer::TargetHint::ElementArray};
+    _indexBuffer.setData(indices, GL::BufferUsage::StaticDraw);
+
+    /* Both vertex buffers get the initial data so the mesh is usable even
+       before the first update() */
+    _vertexData = Containers::Array<char>{NoInit, _nodeCount*VertexSize};
+    copyVertexData(softBody, _vertexData);
+    for(std::size_t i = 0; i != 2; ++i) {
+        _vertexBuffers[i] = GL::Buffer{GL::Buffer::TargetHint::Array};
+        _vertexBuffers[i].setData(_vertexData, GL::BufferUsage::DynamicDraw);
+        _meshes[i] = GL::Mesh{hasFaces ? GL::MeshPrimitive::Triangles : GL::MeshPrimitive::Lines};
+        _meshes[i]
+            .addVertexBuffer(_vertexBuffers[i], 0,
+                Shaders::GenericGL3D::Position{},
+                Shaders::GenericGL3D::Normal{})
+            .setIndexBuffer(_indexBuffer, 0, MeshIndexType::UnsignedInt, 0, _nodeCount ? _nodeCount - 1 : 0)
+            .setCount(indices.size());
+    }
+}
+
+SoftBodyMesh::SoftBodyMesh(NoCreateT) noexcept: _softBody{} {}
+
+SoftBodyMesh::SoftBodyMesh(SoftBodyMesh&&) noexcept = default;
+
+SoftBodyMesh::~SoftBodyMesh() = default;
+
+SoftBodyMesh& SoftBodyMesh::operator=(SoftBodyMesh&&) noexcept = default;
+
+SoftBodyMesh& SoftBodyMesh::update() {
+    CORRADE_ASSERT(_softBody,
+        "BulletIntegration::SoftBodyMesh::update(): the instance was constructed with NoCreate", *this);
+    CORRADE_ASSERT(UnsignedInt(_softBody->m_nodes.size()) == _nodeCount,
+        "BulletIntegration::SoftBodyMesh::update(): expected" << _nodeCount << "nodes but the soft body has" << _softBody->m_nodes.size(), *this);
+
+    copyVertexData(*_softBody, _vertexData);
+
+    /* The size stays the same, so it's just a content replacement without
+       any reallocation */
+    _currentBuffer ^= 1;
+    _vertexBuffers[_currentBuffer].setSubData(0, _vertexData);
+    return *this;
+}
+
+}}
@@ -0,0 +1,168 @@
+#ifndef Magnum_BulletIntegration_SoftBodyMesh_h
+#define Magnum_BulletIntegration_SoftBodyMesh_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::BulletIntegration::SoftBodyMesh
+ * @m_since_latest_{integration}
+ */
+
+#include <Corrade/Containers/Array.h>
+#include <Magnum/GL/Buffer.h>
+#include <Magnum/GL/Mesh.h>
+
+#include "Magnum/BulletIntegration/visibility.h"
+
+class btSoftBody;
+
+namespace Magnum { namespace BulletIntegration {
+
+/**
+@brief Soft body mesh
+@m_since_latest_{integration}
+
+Keeps a @ref GL::Mesh with the geometry of a @cpp btSoftBody @ce, such as a
+piece of cloth, for rendering. The index buffer is built from the soft body
+faces once on construction and only the node positions and normals get
+uploaded on every @ref update().
+
+@section BulletIntegration-SoftBodyMesh-usage Usage
+
+Create the mesh for a soft body that's already set up and call @ref update()
+after each simulation step. The mesh has
+@ref Shaders::GenericGL3D::Position and @ref Shaders::GenericGL3D::Normal
+attributes, so it can be drawn with for example @ref Shaders::PhongGL:
+
+@snippet BulletIntegration.cpp SoftBodyMesh-usage
+
+If the soft body has faces, the mesh is made of @ref GL::MeshPrimitive::Triangles.
+Otherwise, for example for ropes, it's made of @ref GL::MeshPrimitive::Lines
+built from the soft body links.
+
+@section BulletIntegration-SoftBodyMesh-buffers GPU buffer management
+
+The vertex data are uploaded to one of two GPU buffers in an alternating
+fashion, so an upload doesn't have to wait for the GPU to finish drawing from
+the buffer filled in the previous frame. Both buffers are allocated to their
+final size on construction and the upload only replaces their contents, which
+means there's no allocation on every frame even with many soft bodies.
+
+The topology of the soft body is expected to stay the same for the whole
+lifetime of the mesh. If nodes or faces get added or removed, for example when
+the cloth is torn, create a new instance.
+*/
+class MAGNUM_BULLETINTEGRATION_EXPORT SoftBodyMesh {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * Creates the index buffer from soft body faces or links, two vertex
+         * buffers and meshes and uploads the initial positions and normals.
+         * The @p softBody is expected to stay alive for the whole lifetime of
+         * the instance.
+         */
+        explicit SoftBodyMesh(btSoftBody& softBody);
+
+        /**
+         * @brief Construct without creating the underlying OpenGL objects
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * for deferring the initialization to a later point, for example if
+         * the OpenGL context is not yet created. Move another instance over it
+         * to make it useful.
+         */
+        explicit SoftBodyMesh(NoCreateT) noexcept;
+
+        /** @brief Copying is not allowed */
+        SoftBodyMesh(const SoftBodyMesh&) = delete;
+
+        /** @brief Move constructor */
+        SoftBodyMesh(SoftBodyMesh&&) noexcept;
+
+        ~SoftBodyMesh();
+
+        /** @brief Copying is not allowed */
+        SoftBodyMesh& operator=(const SoftBodyMesh&) = delete;
+
+        /** @brief Move assignment */
+        SoftBodyMesh& operator=(SoftBodyMesh&&) noexcept;
+
+        /** @brief Soft body */
+        btSoftBody& softBody() { return *_softBody; }
+        const btSoftBody& softBody() const { return *_softBody; } /**< @overload */
+
+        /**
+         * @brief Mesh
+         *
+         * Returns the mesh containing data from the last @ref update() call.
+         * The returned reference changes with every @ref update().
+         */
+        GL::Mesh& mesh() { return _meshes[_currentBuffer]; }
+
+        /**
+         * @brief Index buffer
+         *
+         * Contains triangle indices built from soft body faces, or line
+         * indices built from links if the soft body has no faces, as
+         * @ref MeshIndexType::UnsignedInt.
+         */
+        GL::Buffer& indexBuffer() { return _indexBuffer; }
+
+        /**
+         * @brief Vertex buffer
+         *
+         * The buffer used by @ref mesh(), containing interleaved positions
+         * and normals from the last @ref update() call as two
+         * @ref Vector3 per node. The returned reference changes with every
+         * @ref update().
+         */
+        GL::Buffer& vertexBuffer() { return _vertexBuffers[_currentBuffer]; }
+
+        /**
+         * @brief Update the mesh
+         * @return Reference to self (for method chaining)
+         *
+         * Copies the current node positions and normals to the other GPU
+         * buffer and makes it current. Expects that the count of soft body
+         * nodes didn't change since construction. Bullet updates the node
+         * normals only if the soft body has faces.
+         */
+        SoftBodyMesh& update();
+
+    private:
+        btSoftBody* _softBody;
+        UnsignedInt _nodeCount{};
+        std::size_t _currentBuffer{};
+        GL::Buffer _indexBuffer{NoCreate};
+        GL::Buffer _vertexBuffers[2]{GL::Buffer{NoCreate}, GL::Buffer{NoCreate}};
+        GL::Mesh _meshes[2]{GL::Mesh{NoCreate}, GL::Mesh{NoCreate}};
+        Containers::Array<char> _vertexData;
+};
+
+}}
+
+#endif
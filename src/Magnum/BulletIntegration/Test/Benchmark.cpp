@@ -0,0 +1,233 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/* See MotionStateTest.cpp for why the root header is included */
+#include <btBulletDynamicsCommon.h>
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Magnum/Math/Matrix4.h>
+#include <Magnum/SceneGraph/MatrixTransformation3D.h>
+#include <Magnum/SceneGraph/Object.h>
+#include <Magnum/SceneGraph/Scene.h>
+
+#include "Magnum/BulletIntegration/Integration.h"
+#include "Magnum/BulletIntegration/MotionState.h"
+#include "Magnum/BulletIntegration/RigidBodySynchronizer.h"
+
+#ifdef BT_USE_DOUBLE_PRECISION
+#include <Magnum/SceneGraph/Object.hpp>
+#include <Magnum/SceneGraph/AbstractFeature.hpp>
+#include <Magnum/SceneGraph/MatrixTransformation3D.hpp>
+#endif
+
+namespace Magnum { namespace BulletIntegration { namespace Test { namespace {
+
+typedef SceneGraph::Object<SceneGraph::BasicMatrixTransformation3D<btScalar>> Object3D;
+typedef SceneGraph::Scene<SceneGraph::BasicMatrixTransformation3D<btScalar>> Scene3D;
+
+struct Benchmark: TestSuite::Tester {
+    explicit Benchmark();
+
+    void motionStateSetWorldTransform();
+    void rigidBodySynchronizerSynchronize();
+    void rigidBodySynchronizerInterpolate();
+
+    void convertVectorsPerElement();
+    void convertVectors();
+    void convertTransformationsPerElement();
+    void convertTransformations();
+};
+
+const struct {
+    const char* name;
+    std::size_t count;
+} CountData[]{
+    {"1k", 1000},
+    {"10k", 10000},
+    {"100k", 100000}
+};
+
+Benchmark::Benchmark() {
+    addInstancedBenchmarks({&Benchmark::motionStateSetWorldTransform,
+                            &Benchmark::rigidBodySynchronizerSynchronize,
+                            &Benchmark::rigidBodySynchronizerInterpolate,
+
+                            &Benchmark::convertVectorsPerElement,
+                            &Benchmark::convertVectors,
+                            &Benchmark::convertTransformationsPerElement,
+                            &Benchmark::convertTransformations}, 10,
+        Containers::arraySize(CountData));
+}
+
+/* Transformations with a different rotation for each body, so the
+   conversions can't get optimized for an identity */
+Containers::Array<btTransform> transformations(std::size_t count) {
+    Containers::Array<btTransform> out{NoInit, count};
+    for(std::size_t i = 0; i != count; ++i)
+        out[i] = btTransform{
+            btQuaternion{btVector3{btScalar(1.0), btScalar(i % 7), btScalar(0.5)}.normalized(), btScalar(i)*btScalar(0.01)},
+            btVector3{btScalar(i), btScalar(0.5), btScalar(-1.0)*btScalar(i)}};
+    return out;
+}
+
+void Benchmark::motionStateSetWorldTransform() {
+    auto&& data = CountData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Scene3D scene;
+    Containers::Array<Object3D> objects{DirectInit, data.count, &scene};
+    Containers::Array<btMotionState*> motionStates{NoInit, data.count};
+    for(std::size_t i = 0; i != data.count; ++i)
+        motionStates[i] = &objects[i].addFeature<MotionState>().btMotionState();
+    const Containers::Array<btTransform> worldTransforms = transformations(data.count);
+
+    /* This is what btDiscreteDynamicsWorld::synchronizeMotionStates() does
+       for every active body */
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 0; i != data.count; ++i)
+            motionStates[i]->setWorldTransform(worldTransforms[i]);
+    }
+
+    CORRADE_COMPARE(objects[data.count - 1].transformationMatrix(), Math::Matrix4<btScalar>{worldTransforms[data.count - 1]});
+}
+
+void Benchmark::rigidBodySynchronizerSynchronize() {
+    auto&& data = CountData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Scene3D scene;
+    Containers::Array<Object3D> objects{DirectInit, data.count, &scene};
+    btSphereShape collisionShape{btScalar(1.0)};
+    Containers::Array<btRigidBody> bodies{DirectInit, data.count, btScalar(1.0), nullptr, &collisionShape};
+    const Containers::Array<btTransform> worldTransforms = transformations(data.count);
+
+    RigidBodySynchronizer synchronizer;
+    synchronizer.reserve(data.count);
+    for(std::size_t i = 0; i != data.count; ++i) {
+        bodies[i].setWorldTransform(worldTransforms[i]);
+        synchronizer.add(bodies[i], objects[i]);
+    }
+
+    std::size_t count = 0;
+    CORRADE_BENCHMARK(1)
+        count += synchronizer.synchronize();
+
+    CORRADE_COMPARE(count, data.count);
+    CORRADE_COMPARE(objects[data.count - 1].transformationMatrix(), Math::Matrix4<btScalar>{worldTransforms[data.count - 1]});
+}
+
+void Benchmark::rigidBodySynchronizerInterpolate() {
+    auto&& data = CountData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Scene3D scene;
+    Containers::Array<Object3D> objects{DirectInit, data.count, &scene};
+    btSphereShape collisionShape{btScalar(1.0)};
+    Containers::Array<btRigidBody> bodies{DirectInit, data.count, btScalar(1.0), nullptr, &collisionShape};
+    const Containers::Array<btTransform> worldTransforms = transformations(data.count);
+
+    RigidBodySynchronizer synchronizer{RigidBodySynchronizer::Flag::Interpolated};
+    synchronizer.reserve(data.count);
+    for(std::size_t i = 0; i != data.count; ++i)
+        synchronizer.add(bodies[i], objects[i]);
+    for(std::size_t i = 0; i != data.count; ++i)
+        bodies[i].setWorldTransform(worldTransforms[i]);
+    synchronizer.synchronize();
+
+    std::size_t count = 0;
+    CORRADE_BENCHMARK(1)
+        count += synchronizer.interpolate(btScalar(0.5));
+
+    CORRADE_COMPARE(count, data.count);
+}
+
+void Benchmark::convertVectorsPerElement() {
+    auto&& data = CountData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Array<btVector3> in{NoInit, data.count};
+    for(std::size_t i = 0; i != data.count; ++i)
+        in[i] = btVector3{btScalar(i), btScalar(0.5), btScalar(-1.0)*btScalar(i)};
+    Containers::Array<Math::Vector3<btScalar>> out{NoInit, data.count};
+
+    /* Baseline to compare convertInto() to */
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 0; i != data.count; ++i)
+            out[i] = Math::Vector3<btScalar>{in[i]};
+    }
+
+    CORRADE_COMPARE(out[data.count - 1], Math::Vector3<btScalar>{in[data.count - 1]});
+}
+
+void Benchmark::convertVectors() {
+    auto&& data = CountData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Array<btVector3> in{NoInit, data.count};
+    for(std::size_t i = 0; i != data.count; ++i)
+        in[i] = btVector3{btScalar(i), btScalar(0.5), btScalar(-1.0)*btScalar(i)};
+    Containers::Array<Math::Vector3<btScalar>> out{NoInit, data.count};
+
+    CORRADE_BENCHMARK(1)
+        convertInto(in, out);
+
+    CORRADE_COMPARE(out[data.count - 1], Math::Vector3<btScalar>{in[data.count - 1]});
+}
+
+void Benchmark::convertTransformationsPerElement() {
+    auto&& data = CountData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const Containers::Array<btTransform> in = transformations(data.count);
+    Containers::Array<Math::Matrix4<btScalar>> out{NoInit, data.count};
+
+    /* Baseline to compare convertInto() to */
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 0; i != data.count; ++i)
+            out[i] = Math::Matrix4<btScalar>{in[i]};
+    }
+
+    CORRADE_COMPARE(out[data.count - 1], Math::Matrix4<btScalar>{in[data.count - 1]});
+}
+
+void Benchmark::convertTransformations() {
+    auto&& data = CountData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const Containers::Array<btTransform> in = transformations(data.count);
+    Containers::Array<Math::Matrix4<btScalar>> out{NoInit, data.count};
+
+    CORRADE_BENCHMARK(1)
+        convertInto(in, out);
+
+    CORRADE_COMPARE(out[data.count - 1], Math::Matrix4<btScalar>{in[data.count - 1]});
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::BulletIntegration::Test::Benchmark)
@@ -0,0 +1,196 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Magnum/Mesh.h>
+#include <Magnum/Math/Functions.h>
+#include <Magnum/Math/FunctionsBatch.h>
+#include <Magnum/Math/Range.h>
+#include <Magnum/Trade/MeshData.h>
+#include <BulletCollision/CollisionShapes/btBoxShape.h>
+#include <BulletCollision/CollisionShapes/btBvhTriangleMeshShape.h>
+#include <BulletCollision/CollisionShapes/btCapsuleShape.h>
+#include <BulletCollision/CollisionShapes/btConvexHullShape.h>
+#include <BulletCollision/CollisionShapes/btSphereShape.h>
+#include <BulletCollision/CollisionShapes/btStaticPlaneShape.h>
+#include <BulletCollision/CollisionShapes/btTriangleMesh.h>
+
+#include "Magnum/BulletIntegration/ConvertShape.h"
+
+namespace Magnum { namespace BulletIntegration { namespace Test { namespace {
+
+struct ConvertShapeTest: TestSuite::Tester {
+    explicit ConvertShapeTest();
+
+    void box();
+    void sphere();
+    void capsule();
+    void convexHull();
+    void triangleMesh();
+    void unsupported();
+};
+
+const struct {
+    const char* name;
+    int axis;
+    Vector3 max;
+} CapsuleData[]{
+    {"X", 0, {1.5f, 0.5f, 0.5f}},
+    {"Y", 1, {0.5f, 1.5f, 0.5f}},
+    {"Z", 2, {0.5f, 0.5f, 1.5f}},
+};
+
+ConvertShapeTest::ConvertShapeTest() {
+    addTests({&ConvertShapeTest::box,
+              &ConvertShapeTest::sphere});
+
+    addInstancedTests({&ConvertShapeTest::capsule},
+        Containers::arraySize(CapsuleData));
+
+    addTests({&ConvertShapeTest::convexHull,
+              &ConvertShapeTest::triangleMesh,
+              &ConvertShapeTest::unsupported});
+}
+
+Range3D bounds(const Trade::MeshData& mesh) {
+    return Math::minmax(mesh.attribute<Vector3>(Trade::MeshAttribute::Position));
+}
+
+void ConvertShapeTest::box() {
+    btBoxShape shape{{1.0f, 2.0f, 3.0f}};
+
+    Containers::Optional<Trade::MeshData> mesh = convertShape(shape);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->primitive(), MeshPrimitive::Triangles);
+    CORRADE_VERIFY(mesh->isIndexed());
+    CORRADE_VERIFY(mesh->hasAttribute(Trade::MeshAttribute::Normal));
+    CORRADE_COMPARE(bounds(*mesh), (Range3D{{-1.0f, -2.0f, -3.0f}, {1.0f, 2.0f, 3.0f}}));
+}
+
+void ConvertShapeTest::sphere() {
+    btSphereShape shape{2.0f};
+
+    Containers::Optional<Trade::MeshData> mesh = convertShape(shape);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->primitive(), MeshPrimitive::Triangles);
+    CORRADE_VERIFY(mesh->hasAttribute(Trade::MeshAttribute::Normal));
+    for(const Vector3& position: mesh->attribute<Vector3>(Trade::MeshAttribute::Position)) {
+        CORRADE_ITERATION(position);
+        CORRADE_COMPARE(position.length(), 2.0f);
+    }
+}
+
+void ConvertShapeTest::capsule() {
+    auto&& data = CapsuleData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Radius 0.5, total height 3 */
+    Containers::Optional<Trade::MeshData> mesh;
+    if(data.axis == 0)
+        mesh = convertShape(btCapsuleShapeX{0.5f, 2.0f});
+    else if(data.axis == 1)
+        mesh = convertShape(btCapsuleShape{0.5f, 2.0f});
+    else
+        mesh = convertShape(btCapsuleShapeZ{0.5f, 2.0f});
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->primitive(), MeshPrimitive::Triangles);
+    CORRADE_VERIFY(mesh->hasAttribute(Trade::MeshAttribute::Normal));
+    CORRADE_COMPARE(bounds(*mesh), (Range3D{-data.max, data.max}));
+}
+
+void ConvertShapeTest::convexHull() {
+    /* A cube with an extra point inside that shouldn't be a part of the
+       hull */
+    const Vector3 points[]{
+        {-1.0f, -1.0f, -1.0f},
+        { 1.0f, -1.0f, -1.0f},
+        {-1.0f,  1.0f, -1.0f},
+        { 1.0f,  1.0f, -1.0f},
+        { 0.0f,  0.0f,  0.0f},
+        {-1.0f, -1.0f,  1.0f},
+        { 1.0f, -1.0f,  1.0f},
+        {-1.0f,  1.0f,  1.0f},
+        { 1.0f,  1.0f,  1.0f},
+    };
+    btConvexHullShape shape;
+    for(const Vector3& point: points) shape.addPoint({point.x(), point.y(), point.z()}, false);
+    shape.recalcLocalAabb();
+    shape.setLocalScaling({2.0f, 1.0f, 1.0f});
+
+    Containers::Optional<Trade::MeshData> mesh = convertShape(shape);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->primitive(), MeshPrimitive::Triangles);
+    CORRADE_VERIFY(!mesh->isIndexed());
+
+    /* Six faces with two triangles each, the scaling is applied */
+    CORRADE_COMPARE(mesh->vertexCount(), 36);
+    CORRADE_COMPARE(bounds(*mesh), (Range3D{{-2.0f, -1.0f, -1.0f}, {2.0f, 1.0f, 1.0f}}));
+
+    /* Flat normals pointing outwards */
+    Containers::StridedArrayView1D<const Vector3> positions = mesh->attribute<Vector3>(Trade::MeshAttribute::Position);
+    Containers::StridedArrayView1D<const Vector3> normals = mesh->attribute<Vector3>(Trade::MeshAttribute::Normal);
+    for(std::size_t i = 0; i != normals.size(); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(normals[i].length(), 1.0f);
+        CORRADE_COMPARE(Math::abs(normals[i]).sum(), 1.0f);
+        CORRADE_COMPARE_AS(Math::dot(normals[i], positions[i]), 0.0f,
+            TestSuite::Compare::Greater);
+    }
+}
+
+void ConvertShapeTest::triangleMesh() {
+    btTriangleMesh triangles;
+    triangles.addTriangle({0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f});
+    triangles.addTriangle({1.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 0.0f}, {0.0f, 1.0f, 0.0f});
+    btBvhTriangleMeshShape shape{&triangles, true};
+    shape.setLocalScaling({1.0f, 3.0f, 1.0f});
+
+    Containers::Optional<Trade::MeshData> mesh = convertShape(shape);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->primitive(), MeshPrimitive::Triangles);
+    CORRADE_VERIFY(!mesh->isIndexed());
+    CORRADE_COMPARE_AS(mesh->attribute<Vector3>(Trade::MeshAttribute::Position), Containers::arrayView<Vector3>({
+        {0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 3.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f}, {1.0f, 3.0f, 0.0f}, {0.0f, 3.0f, 0.0f}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(mesh->attribute<Vector3>(Trade::MeshAttribute::Normal), Containers::arrayView<Vector3>({
+        Vector3::zAxis(), Vector3::zAxis(), Vector3::zAxis(),
+        Vector3::zAxis(), Vector3::zAxis(), Vector3::zAxis()
+    }), TestSuite::Compare::Container);
+}
+
+void ConvertShapeTest::unsupported() {
+    btStaticPlaneShape shape{{0.0f, 1.0f, 0.0f}, 0.0f};
+    CORRADE_VERIFY(!convertShape(shape));
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::BulletIntegration::Test::ConvertShapeTest)
@@ -0,0 +1,194 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Optional.h>
+#include <Magnum/GL/Framebuffer.h>
+#include <Magnum/GL/OpenGLTester.h>
+#include <Magnum/GL/Renderbuffer.h>
+#include <Magnum/GL/RenderbufferFormat.h>
+#include <Magnum/Math/Color.h>
+#ifndef MAGNUM_TARGET_WEBGL
+#include <Magnum/GL/TimeQuery.h>
+#endif
+
+#include "Magnum/BulletIntegration/DebugDraw.h"
+
+namespace Magnum { namespace BulletIntegration { namespace Test { namespace {
+
+struct DebugDrawGLBenchmark: GL::OpenGLTester {
+    explicit DebugDrawGLBenchmark();
+
+    void setup();
+    void teardown();
+
+    void drawLines();
+    void drawLinesBulk();
+    #ifndef MAGNUM_TARGET_WEBGL
+    void drawLinesGpu();
+
+    void timeQueryBegin();
+    std::uint64_t timeQueryEnd();
+    #endif
+
+    private:
+        GL::Renderbuffer _color{NoCreate};
+        GL::Framebuffer _framebuffer{NoCreate};
+        Containers::Optional<DebugDraw> _debugDraw;
+        Containers::Array<Vector3> _positions;
+        #ifndef MAGNUM_TARGET_WEBGL
+        GL::TimeQuery _timeQuery{NoCreate};
+        #endif
+};
+
+constexpr Vector2i Size{256, 256};
+
+/* The results are meant to be read as a cost per million lines */
+constexpr std::size_t LineCount = 1000000;
+
+const struct {
+    const char* name;
+    DebugDraw::Flags flags;
+} FlagData[]{
+    {"", {}},
+    {"double buffered", DebugDraw::Flag::DoubleBuffered},
+    {"packed colors, half-float positions", DebugDraw::Flag::PackedColors|DebugDraw::Flag::HalfFloatPositions},
+    {"frustum culling", DebugDraw::Flag::FrustumCulling},
+};
+
+DebugDrawGLBenchmark::DebugDrawGLBenchmark() {
+    addInstancedBenchmarks({&DebugDrawGLBenchmark::drawLines,
+                            &DebugDrawGLBenchmark::drawLinesBulk}, 10,
+        Containers::arraySize(FlagData),
+        &DebugDrawGLBenchmark::setup,
+        &DebugDrawGLBenchmark::teardown);
+
+    #ifndef MAGNUM_TARGET_WEBGL
+    addCustomInstancedBenchmarks({&DebugDrawGLBenchmark::drawLinesGpu}, 10,
+        Containers::arraySize(FlagData),
+        &DebugDrawGLBenchmark::setup,
+        &DebugDrawGLBenchmark::teardown,
+        &DebugDrawGLBenchmark::timeQueryBegin,
+        &DebugDrawGLBenchmark::timeQueryEnd,
+        BenchmarkUnits::Nanoseconds);
+    #endif
+}
+
+void DebugDrawGLBenchmark::setup() {
+    auto&& data = FlagData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    _color = GL::Renderbuffer{};
+    _color.setStorage(
+        #if !defined(MAGNUM_TARGET_GLES2) || !defined(MAGNUM_TARGET_WEBGL)
+        GL::RenderbufferFormat::RGBA8,
+        #else
+        GL::RenderbufferFormat::RGBA4,
+        #endif
+        Size);
+    _framebuffer = GL::Framebuffer{{{}, Size}};
+    _framebuffer
+        .attachRenderbuffer(GL::Framebuffer::ColorAttachment{0}, _color)
+        .bind();
+
+    /* A grid of short lines spread over the visible area, so nothing gets
+       culled even with culling enabled */
+    _positions = Containers::Array<Vector3>{NoInit, LineCount*2};
+    for(std::size_t i = 0; i != LineCount; ++i) {
+        const Vector3 a{Float(i % 1000)/500.0f - 1.0f, Float(i/1000)/500.0f - 1.0f, 0.0f};
+        _positions[i*2 + 0] = a;
+        _positions[i*2 + 1] = a + Vector3{0.001f, 0.001f, 0.0f};
+    }
+
+    /* Capacity reserved upfront to not measure the initial growth */
+    _debugDraw.emplace(data.flags, LineCount);
+    _debugDraw->setTransformationProjectionMatrix({});
+
+    /* One frame to get the buffers allocated */
+    _debugDraw->addLines(_positions, Color3{0.5f});
+    _debugDraw->flushLines();
+}
+
+void DebugDrawGLBenchmark::teardown() {
+    _debugDraw = Containers::NullOpt;
+    _positions = nullptr;
+    _framebuffer = GL::Framebuffer{NoCreate};
+    _color = GL::Renderbuffer{NoCreate};
+}
+
+#ifndef MAGNUM_TARGET_WEBGL
+void DebugDrawGLBenchmark::timeQueryBegin() {
+    _timeQuery = GL::TimeQuery{GL::TimeQuery::Target::TimeElapsed};
+    _timeQuery.begin();
+}
+
+std::uint64_t DebugDrawGLBenchmark::timeQueryEnd() {
+    _timeQuery.end();
+    return _timeQuery.result<UnsignedLong>();
+}
+#endif
+
+void DebugDrawGLBenchmark::drawLines() {
+    /* What Bullet does, one virtual call per line */
+    Containers::Array<btVector3> positions{NoInit, _positions.size()};
+    for(std::size_t i = 0; i != _positions.size(); ++i)
+        positions[i] = btVector3{_positions[i].x(), _positions[i].y(), _positions[i].z()};
+
+    btIDebugDraw& debugDraw = *_debugDraw;
+    const btVector3 color{btScalar(0.5), btScalar(0.5), btScalar(0.5)};
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 0; i != LineCount; ++i)
+            debugDraw.drawLine(positions[i*2 + 0], positions[i*2 + 1], color);
+        debugDraw.flushLines();
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void DebugDrawGLBenchmark::drawLinesBulk() {
+    CORRADE_BENCHMARK(1) {
+        _debugDraw->addLines(_positions, Color3{0.5f});
+        _debugDraw->flushLines();
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+#ifndef MAGNUM_TARGET_WEBGL
+void DebugDrawGLBenchmark::drawLinesGpu() {
+    /* Lines added outside of the measured section, which includes just the
+       upload and the draw */
+    _debugDraw->addLines(_positions, Color3{0.5f});
+
+    CORRADE_BENCHMARK(1)
+        _debugDraw->flushLines();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+#endif
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::BulletIntegration::Test::DebugDrawGLBenchmark)
@@ -0,0 +1,987 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <thread>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Magnum/Image.h>
+#include <Magnum/PixelFormat.h>
+#include <Magnum/GL/Context.h>
+#include <Magnum/GL/Extensions.h>
+#include <Magnum/GL/Framebuffer.h>
+#include <Magnum/GL/OpenGLTester.h>
+#include <Magnum/GL/Renderbuffer.h>
+#include <Magnum/GL/RenderbufferFormat.h>
+#include <Magnum/GL/Renderer.h>
+#include <Magnum/Math/Color.h>
+#ifndef MAGNUM_TARGET_GLES
+#include <Magnum/GL/PrimitiveQuery.h>
+#endif
+#include <btBulletCollisionCommon.h>
+
+#include "Magnum/BulletIntegration/DebugDraw.h"
+
+#ifdef MAGNUM_BULLETINTEGRATION_HAS_TEXT
+#include <Corrade/Containers/StringView.h>
+#include <Magnum/ImageView.h>
+#include <Magnum/Text/AbstractFont.h>
+#include <Magnum/Text/AbstractShaper.h>
+#include <Magnum/Text/GlyphCacheGL.h>
+#endif
+
+namespace Magnum { namespace BulletIntegration { namespace Test { namespace {
+
+struct DebugDrawGLTest: GL::OpenGLTester {
+    explicit DebugDrawGLTest();
+
+    void drawLines();
+    void drawLinesPositionOrigin();
+    void addLines();
+    void drawPrimitives();
+    void frustumCulling();
+    void contactPointCullDistance();
+    void threadSafe();
+    void drawMode();
+    void staticObjects();
+    #ifdef MAGNUM_BULLETINTEGRATION_HAS_TEXT
+    void drawText();
+    #endif
+
+    private:
+        void drawSetup();
+        void drawTeardown();
+
+        Image2D read();
+
+        GL::Renderbuffer _color{NoCreate};
+        GL::Framebuffer _framebuffer{NoCreate};
+};
+
+using namespace Math::Literals;
+
+const struct {
+    const char* name;
+    DebugDraw::Flags flags;
+} DrawLinesData[]{
+    {"", {}},
+    {"double buffered", DebugDraw::Flag::DoubleBuffered},
+    {"packed colors", DebugDraw::Flag::PackedColors},
+    {"half-float positions", DebugDraw::Flag::HalfFloatPositions},
+    {"packed colors, half-float positions, double buffered", DebugDraw::Flag::PackedColors|DebugDraw::Flag::HalfFloatPositions|DebugDraw::Flag::DoubleBuffered},
+};
+
+const struct {
+    const char* name;
+    DebugDraw::Flags flags;
+} DrawLinesPositionOriginData[]{
+    {"", {}},
+    {"half-float positions", DebugDraw::Flag::HalfFloatPositions},
+};
+
+const struct {
+    const char* name;
+    DebugDraw::Flags flags;
+} AddLinesData[]{
+    {"", {}},
+    {"packed colors", DebugDraw::Flag::PackedColors},
+};
+
+const struct {
+    const char* name;
+    DebugDraw::Flags flags;
+} DrawPrimitivesData[]{
+    {"lines", {}},
+    {"instanced", DebugDraw::Flag::InstancedPrimitives},
+    {"instanced, packed colors, half-float positions", DebugDraw::Flag::InstancedPrimitives|DebugDraw::Flag::PackedColors|DebugDraw::Flag::HalfFloatPositions},
+};
+
+const struct {
+    const char* name;
+    DebugDraw::Flags flags;
+    UnsignedInt expectedCount;
+} FrustumCullingData[]{
+    {"", {}, 4},
+    {"frustum culling", DebugDraw::Flag::FrustumCulling, 3},
+};
+
+const struct {
+    const char* name;
+    DebugDraw::Flags flags;
+} ThreadSafeData[]{
+    {"", DebugDraw::Flag::ThreadSafe},
+    {"double buffered", DebugDraw::Flag::ThreadSafe|DebugDraw::Flag::DoubleBuffered},
+};
+
+DebugDrawGLTest::DebugDrawGLTest() {
+    addInstancedTests({&DebugDrawGLTest::drawLines},
+        Containers::arraySize(DrawLinesData),
+        &DebugDrawGLTest::drawSetup,
+        &DebugDrawGLTest::drawTeardown);
+
+    addInstancedTests({&DebugDrawGLTest::drawLinesPositionOrigin},
+        Containers::arraySize(DrawLinesPositionOriginData),
+        &DebugDrawGLTest::drawSetup,
+        &DebugDrawGLTest::drawTeardown);
+
+    addInstancedTests({&DebugDrawGLTest::addLines},
+        Containers::arraySize(AddLinesData),
+        &DebugDrawGLTest::drawSetup,
+        &DebugDrawGLTest::drawTeardown);
+
+    addInstancedTests({&DebugDrawGLTest::drawPrimitives},
+        Containers::arraySize(DrawPrimitivesData),
+        &DebugDrawGLTest::drawSetup,
+        &DebugDrawGLTest::drawTeardown);
+
+    addInstancedTests({&DebugDrawGLTest::frustumCulling},
+        Containers::arraySize(FrustumCullingData),
+        &DebugDrawGLTest::drawSetup,
+        &DebugDrawGLTest::drawTeardown);
+
+    addInstancedTests({&DebugDrawGLTest::threadSafe},
+        Containers::arraySize(ThreadSafeData),
+        &DebugDrawGLTest::drawSetup,
+        &DebugDrawGLTest::drawTeardown);
+
+    addTests({&DebugDrawGLTest::contactPointCullDistance,
+              &DebugDrawGLTest::drawMode,
+              &DebugDrawGLTest::staticObjects},
+        &DebugDrawGLTest::drawSetup,
+        &DebugDrawGLTest::drawTeardown);
+
+    #ifdef MAGNUM_BULLETINTEGRATION_HAS_TEXT
+    addTests({&DebugDrawGLTest::drawText},
+        &DebugDrawGLTest::drawSetup,
+        &DebugDrawGLTest::drawTeardown);
+    #endif
+}
+
+constexpr Vector2i DrawSize{32, 32};
+
+/* NDC coordinate of a pixel center, to not have lines rasterized ambiguously
+   between two pixel rows or columns */
+constexpr Float pixelCenter(Int pixel) {
+    return (pixel + 0.5f)*2.0f/DrawSize.x() - 1.0f;
+}
+
+/* Horizontal line spanning the whole framebuffer width in given pixel row */
+void drawRow(btIDebugDraw& debugDraw, Int row, const Color3& color) {
+    debugDraw.drawLine(btVector3{-1.0f, pixelCenter(row), 0.0f},
+                       btVector3{1.0f, pixelCenter(row), 0.0f},
+                       btVector3{Math::Vector3<btScalar>{color}});
+}
+
+bool isHalfFloatSupported() {
+    #ifndef MAGNUM_TARGET_GLES
+    return GL::Context::current().isExtensionSupported<GL::Extensions::ARB::half_float_vertex>();
+    #elif defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    return GL::Context::current().isExtensionSupported<GL::Extensions::OES::vertex_half_float>();
+    #elif defined(MAGNUM_TARGET_GLES2)
+    return false;
+    #else
+    return true;
+    #endif
+}
+
+bool isInstancingSupported() {
+    #ifndef MAGNUM_TARGET_GLES
+    return GL::Context::current().isExtensionSupported<GL::Extensions::ARB::instanced_arrays>();
+    #elif defined(MAGNUM_TARGET_GLES2) && defined(MAGNUM_TARGET_WEBGL)
+    return GL::Context::current().isExtensionSupported<GL::Extensions::ANGLE::instanced_arrays>();
+    #elif defined(MAGNUM_TARGET_GLES2)
+    return GL::Context::current().isExtensionSupported<GL::Extensions::ANGLE::instanced_arrays>() ||
+           GL::Context::current().isExtensionSupported<GL::Extensions::EXT::instanced_arrays>() ||
+           GL::Context::current().isExtensionSupported<GL::Extensions::NV::instanced_arrays>();
+    #else
+    return true;
+    #endif
+}
+
+/* Flushes the lines and, where possible, returns how many primitives got
+   drawn as a result. Bullet 2.83 and older draw every line right away. */
+#if BT_BULLET_VERSION >= 284
+UnsignedInt flush(btIDebugDraw& debugDraw) {
+    #ifndef MAGNUM_TARGET_GLES
+    GL::PrimitiveQuery query{GL::PrimitiveQuery::Target::PrimitivesGenerated};
+    query.begin();
+    debugDraw.flushLines();
+    query.end();
+    return query.result<UnsignedInt>();
+    #else
+    debugDraw.flushLines();
+    return 0;
+    #endif
+}
+
+#ifndef MAGNUM_TARGET_GLES
+/* Draws the world and returns how many primitives got drawn. Some Bullet
+   versions flush the lines in debugDrawWorld() already, so both are inside
+   the query. */
+UnsignedInt drawWorld(btCollisionWorld& world) {
+    GL::PrimitiveQuery query{GL::PrimitiveQuery::Target::PrimitivesGenerated};
+    query.begin();
+    world.debugDrawWorld();
+    world.getDebugDrawer()->flushLines();
+    query.end();
+    return query.result<UnsignedInt>();
+}
+#endif
+#endif
+
+#ifdef MAGNUM_BULLETINTEGRATION_HAS_TEXT
+/* Every character is glyph 0 advancing by its size, so a two-character label
+   is two quads next to each other */
+struct TestShaper: Text::AbstractShaper {
+    using Text::AbstractShaper::AbstractShaper;
+
+    UnsignedInt doShape(Containers::StringView text, UnsignedInt begin, UnsignedInt end, Containers::ArrayView<const Text::FeatureRange>) override {
+        return (end == ~UnsignedInt{} ? text.size() : end) - begin;
+    }
+    void doGlyphIdsInto(const Containers::StridedArrayView1D<UnsignedInt>& ids) const override {
+        for(std::size_t i = 0; i != ids.size(); ++i)
+            ids[i] = 0;
+    }
+    void doGlyphOffsetsAdvancesInto(const Containers::StridedArrayView1D<Vector2>& offsets, const Containers::StridedArrayView1D<Vector2>& advances) const override {
+        for(std::size_t i = 0; i != offsets.size(); ++i) {
+            offsets[i] = {};
+            advances[i] = {8.0f, 0.0f};
+        }
+    }
+    void doGlyphClustersInto(const Containers::StridedArrayView1D<UnsignedInt>& clusters) const override {
+        for(std::size_t i = 0; i != clusters.size(); ++i)
+            clusters[i] = i;
+    }
+};
+
+struct TestFont: Text::AbstractFont {
+    Text::FontFeatures doFeatures() const override { return {}; }
+    bool doIsOpened() const override { return _opened; }
+    void doClose() override { _opened = false; }
+
+    Properties doOpenFile(Containers::StringView, Float size) override {
+        _opened = true;
+        return {size, 8.0f, 0.0f, 8.0f, 1};
+    }
+
+    void doGlyphIdsInto(const Containers::StridedArrayView1D<const char32_t>&, const Containers::StridedArrayView1D<UnsignedInt>& glyphs) override {
+        for(std::size_t i = 0; i != glyphs.size(); ++i)
+            glyphs[i] = 0;
+    }
+    Vector2 doGlyphSize(UnsignedInt) override { return {8.0f, 8.0f}; }
+    Vector2 doGlyphAdvance(UnsignedInt) override { return {8.0f, 0.0f}; }
+    Containers::Pointer<Text::AbstractShaper> doCreateShaper() override {
+        return Containers::pointer<TestShaper>(*this);
+    }
+
+    bool _opened = false;
+};
+#endif
+
+void DebugDrawGLTest::drawSetup() {
+    _color = GL::Renderbuffer{};
+    _color.setStorage(
+        #if !defined(MAGNUM_TARGET_GLES2) || !defined(MAGNUM_TARGET_WEBGL)
+        GL::RenderbufferFormat::RGBA8,
+        #else
+        GL::RenderbufferFormat::RGBA4,
+        #endif
+        DrawSize);
+
+    _framebuffer = GL::Framebuffer{{{}, DrawSize}};
+    _framebuffer
+        .attachRenderbuffer(GL::Framebuffer::ColorAttachment{0}, _color)
+        .clear(GL::FramebufferClear::Color)
+        .bind();
+}
+
+void DebugDrawGLTest::drawTeardown() {
+    _framebuffer = GL::Framebuffer{NoCreate};
+    _color = GL::Renderbuffer{NoCreate};
+}
+
+Image2D DebugDrawGLTest::read() {
+    return _framebuffer.read({{}, DrawSize}, {PixelFormat::RGBA8Unorm});
+}
+
+void DebugDrawGLTest::drawLines() {
+    auto&& data = DrawLinesData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    #if BT_BULLET_VERSION < 284
+    CORRADE_SKIP("Batched line drawing is available only with Bullet 2.83.5 and newer.");
+    #else
+    if(data.flags & DebugDraw::Flag::HalfFloatPositions && !isHalfFloatSupported())
+        CORRADE_SKIP("Half-float vertex attributes are not supported.");
+
+    DebugDraw debugDraw{data.flags};
+    btIDebugDraw& drawer = debugDraw;
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* First frame, a single line. The colors are all exactly representable
+       with packed colors as well. */
+    drawRow(drawer, 8, 0xff0000_rgbf);
+    const UnsignedInt count1 = flush(drawer);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    {
+        Image2D image = read();
+        Containers::StridedArrayView2D<const Color4ub> pixels = image.pixels<Color4ub>();
+        CORRADE_COMPARE(pixels[8][16], 0xff0000ff_rgba);
+        CORRADE_COMPARE(pixels[24][16], 0x00000000_rgba);
+    }
+
+    /* Second frame, more lines, which makes the buffer grow */
+    _framebuffer.clear(GL::FramebufferClear::Color);
+    drawRow(drawer, 4, 0x00ff00_rgbf);
+    drawRow(drawer, 16, 0x00ff00_rgbf);
+    drawRow(drawer, 24, 0x00ff00_rgbf);
+    const UnsignedInt count2 = flush(drawer);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    {
+        Image2D image = read();
+        Containers::StridedArrayView2D<const Color4ub> pixels = image.pixels<Color4ub>();
+        CORRADE_COMPARE(pixels[4][16], 0x00ff00ff_rgba);
+        CORRADE_COMPARE(pixels[16][16], 0x00ff00ff_rgba);
+        CORRADE_COMPARE(pixels[24][16], 0x00ff00ff_rgba);
+        CORRADE_COMPARE(pixels[8][16], 0x00000000_rgba);
+    }
+
+    /* Third frame, a single line again. The buffer capacity stays from the
+       previous frame, but the stale lines in it aren't drawn. With double
+       buffering this is the first buffer again. */
+    _framebuffer.clear(GL::FramebufferClear::Color);
+    drawRow(drawer, 28, 0x0000ff_rgbf);
+    const UnsignedInt count3 = flush(drawer);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    {
+        Image2D image = read();
+        Containers::StridedArrayView2D<const Color4ub> pixels = image.pixels<Color4ub>();
+        CORRADE_COMPARE(pixels[28][16], 0x0000ffff_rgba);
+        CORRADE_COMPARE(pixels[4][16], 0x00000000_rgba);
+        CORRADE_COMPARE(pixels[16][16], 0x00000000_rgba);
+        CORRADE_COMPARE(pixels[24][16], 0x00000000_rgba);
+    }
+
+    /* Flushing with nothing drawn does nothing */
+    const UnsignedInt count4 = flush(drawer);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    #ifndef MAGNUM_TARGET_GLES
+    CORRADE_COMPARE(count1, 1);
+    CORRADE_COMPARE(count2, 3);
+    CORRADE_COMPARE(count3, 1);
+    CORRADE_COMPARE(count4, 0);
+    #else
+    static_cast<void>(count1);
+    static_cast<void>(count2);
+    static_cast<void>(count3);
+    static_cast<void>(count4);
+    #endif
+    #endif
+}
+
+void DebugDrawGLTest::drawLinesPositionOrigin() {
+    auto&& data = DrawLinesPositionOriginData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    #if BT_BULLET_VERSION < 284
+    CORRADE_SKIP("Batched line drawing is available only with Bullet 2.83.5 and newer.");
+    #else
+    if(data.flags & DebugDraw::Flag::HalfFloatPositions && !isHalfFloatSupported())
+        CORRADE_SKIP("Half-float vertex attributes are not supported.");
+
+    /* The lines are far away from the world origin, at which point
+       half-floats have a precision of just 0.5. Relative to the origin set
+       close to them they're exact, and the origin is added back when
+       drawing. */
+    DebugDraw debugDraw{data.flags};
+    btIDebugDraw& drawer = debugDraw;
+    debugDraw
+        .setTransformationProjectionMatrix(Matrix4::translation({-1000.0f, 0.0f, 0.0f}))
+        .setPositionOrigin({1000.0f, 0.0f, 0.0f});
+    CORRADE_COMPARE(debugDraw.positionOrigin(), (Vector3{1000.0f, 0.0f, 0.0f}));
+
+    /* A line spanning the right half of the framebuffer only */
+    drawer.drawLine(btVector3{1000.0f, pixelCenter(8), 0.0f},
+                    btVector3{1001.0f, pixelCenter(8), 0.0f},
+                    btVector3{1.0f, 0.0f, 1.0f});
+    drawer.flushLines();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    Image2D image = read();
+    Containers::StridedArrayView2D<const Color4ub> pixels = image.pixels<Color4ub>();
+    CORRADE_COMPARE(pixels[8][17], 0xff00ffff_rgba);
+    CORRADE_COMPARE(pixels[8][30], 0xff00ffff_rgba);
+    CORRADE_COMPARE(pixels[8][14], 0x00000000_rgba);
+    CORRADE_COMPARE(pixels[9][17], 0x00000000_rgba);
+    #endif
+}
+
+void DebugDrawGLTest::addLines() {
+    auto&& data = AddLinesData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    #if BT_BULLET_VERSION < 284
+    CORRADE_SKIP("Batched line drawing is available only with Bullet 2.83.5 and newer.");
+    #else
+    DebugDraw debugDraw{data.flags};
+    btIDebugDraw& drawer = debugDraw;
+    debugDraw.reserveLines(6);
+
+    /* Lines added directly go to the same batch as lines drawn by Bullet,
+       in the order they were added */
+    drawRow(drawer, 4, 0xff0000_rgbf);
+    const Vector3 singleColorPositions[]{
+        {-1.0f, pixelCenter(8), 0.0f},
+        { 1.0f, pixelCenter(8), 0.0f},
+        {-1.0f, pixelCenter(12), 0.0f},
+        { 1.0f, pixelCenter(12), 0.0f},
+    };
+    debugDraw.addLines(singleColorPositions, 0x00ff00_rgbf);
+    const Vector3 perVertexColorPositions[]{
+        {-1.0f, pixelCenter(16), 0.0f},
+        { 1.0f, pixelCenter(16), 0.0f},
+        {-1.0f, pixelCenter(20), 0.0f},
+        { 1.0f, pixelCenter(20), 0.0f},
+    };
+    const Color3 perVertexColors[]{
+        0x0000ff_rgbf, 0x0000ff_rgbf,
+        0xffffff_rgbf, 0xffffff_rgbf
+    };
+    debugDraw.addLines(perVertexColorPositions, perVertexColors);
+    drawRow(drawer, 24, 0xff00ff_rgbf);
+
+    /* Adding no lines is a no-op */
+    debugDraw.addLines(Containers::StridedArrayView1D<const Vector3>{}, 0xffff00_rgbf);
+
+    const UnsignedInt count = flush(drawer);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    Image2D image = read();
+    Containers::StridedArrayView2D<const Color4ub> pixels = image.pixels<Color4ub>();
+    CORRADE_COMPARE(pixels[4][16], 0xff0000ff_rgba);
+    CORRADE_COMPARE(pixels[8][16], 0x00ff00ff_rgba);
+    CORRADE_COMPARE(pixels[12][16], 0x00ff00ff_rgba);
+    CORRADE_COMPARE(pixels[16][16], 0x0000ffff_rgba);
+    CORRADE_COMPARE(pixels[20][16], 0xffffffff_rgba);
+    CORRADE_COMPARE(pixels[24][16], 0xff00ffff_rgba);
+    CORRADE_COMPARE(pixels[28][16], 0x00000000_rgba);
+
+    #ifndef MAGNUM_TARGET_GLES
+    CORRADE_COMPARE(count, 6);
+    #else
+    static_cast<void>(count);
+    #endif
+    #endif
+}
+
+void DebugDrawGLTest::drawPrimitives() {
+    auto&& data = DrawPrimitivesData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    #if BT_BULLET_VERSION < 284
+    CORRADE_SKIP("Batched line drawing is available only with Bullet 2.83.5 and newer.");
+    #else
+    if(data.flags & DebugDraw::Flag::InstancedPrimitives && !isInstancingSupported())
+        CORRADE_SKIP("Instanced drawing is not supported.");
+    if(data.flags & DebugDraw::Flag::HalfFloatPositions && !isHalfFloatSupported())
+        CORRADE_SKIP("Half-float vertex attributes are not supported.");
+
+    DebugDraw debugDraw{data.flags};
+    btIDebugDraw& drawer = debugDraw;
+
+    /* The output should be the same regardless of whether the primitives
+       are instanced or drawn as individual lines. A bounding box is 12
+       lines, the edges along Z collapse to its corners. */
+    drawer.drawAabb(btVector3{pixelCenter(7), pixelCenter(7), -0.5f},
+                    btVector3{pixelCenter(24), pixelCenter(24), 0.5f},
+                    btVector3{1.0f, 1.0f, 1.0f});
+
+    /* A coordinate frame is 3 lines, with a reddish X, greenish Y and bluish
+       Z axis. The Z axis collapses to a point, which is then overwritten by
+       the others. */
+    drawer.drawTransform(btTransform{btMatrix3x3::getIdentity(), btVector3{pixelCenter(16), pixelCenter(16), 0.0f}}, 0.25f);
+
+    const UnsignedInt count = flush(drawer);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    Image2D image = read();
+    Containers::StridedArrayView2D<const Color4ub> pixels = image.pixels<Color4ub>();
+
+    /* Box edges */
+    CORRADE_COMPARE(pixels[7][12], 0xffffffff_rgba);
+    CORRADE_COMPARE(pixels[24][12], 0xffffffff_rgba);
+    CORRADE_COMPARE(pixels[12][7], 0xffffffff_rgba);
+    CORRADE_COMPARE(pixels[12][24], 0xffffffff_rgba);
+
+    /* Nothing inside the box except for the axes */
+    CORRADE_COMPARE(pixels[12][12], 0x00000000_rgba);
+    CORRADE_COMPARE(pixels[20][12], 0x00000000_rgba);
+    CORRADE_COMPARE(pixels[12][20], 0x00000000_rgba);
+
+    /* Axes */
+    const Color4ub x = pixels[16][18];
+    CORRADE_COMPARE_AS(x.r(), x.g(), TestSuite::Compare::Greater);
+    CORRADE_COMPARE_AS(x.r(), x.b(), TestSuite::Compare::Greater);
+    const Color4ub y = pixels[18][16];
+    CORRADE_COMPARE_AS(y.g(), y.r(), TestSuite::Compare::Greater);
+    CORRADE_COMPARE_AS(y.g(), y.b(), TestSuite::Compare::Greater);
+
+    /* Outside of everything */
+    CORRADE_COMPARE(pixels[2][2], 0x00000000_rgba);
+    CORRADE_COMPARE(pixels[28][28], 0x00000000_rgba);
+
+    #ifndef MAGNUM_TARGET_GLES
+    CORRADE_COMPARE(count, 12 + 3);
+    #else
+    static_cast<void>(count);
+    #endif
+    #endif
+}
+
+void DebugDrawGLTest::frustumCulling() {
+    auto&& data = FrustumCullingData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    #if BT_BULLET_VERSION < 284
+    CORRADE_SKIP("Batched line drawing is available only with Bullet 2.83.5 and newer.");
+    #else
+    /* The frustum is extracted from the matrix, an identity is the NDC
+       cube */
+    DebugDraw debugDraw{data.flags};
+    btIDebugDraw& drawer = debugDraw;
+    debugDraw.setTransformationProjectionMatrix(Matrix4{Math::IdentityInit});
+
+    /* A line inside is drawn always */
+    drawRow(drawer, 8, 0xff0000_rgbf);
+
+    /* A line outside is dropped if culling is enabled */
+    drawer.drawLine(btVector3{2.0f, pixelCenter(12), 0.0f},
+                    btVector3{3.0f, pixelCenter(12), 0.0f},
+                    btVector3{1.0f, 1.0f, 1.0f});
+
+    /* A line crossing the frustum isn't dropped even though both of its
+       endpoints are outside */
+    drawer.drawLine(btVector3{-3.0f, pixelCenter(16), 0.0f},
+                    btVector3{3.0f, pixelCenter(16), 0.0f},
+                    btVector3{0.0f, 1.0f, 0.0f});
+
+    /* Lines added directly aren't culled */
+    const Vector3 positions[]{
+        {2.0f, pixelCenter(20), 0.0f},
+        {3.0f, pixelCenter(20), 0.0f},
+    };
+    debugDraw.addLines(positions, 0xffffff_rgbf);
+
+    const UnsignedInt count = flush(drawer);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    Image2D image = read();
+    Containers::StridedArrayView2D<const Color4ub> pixels = image.pixels<Color4ub>();
+    CORRADE_COMPARE(pixels[8][16], 0xff0000ff_rgba);
+    CORRADE_COMPARE(pixels[16][16], 0x00ff00ff_rgba);
+    CORRADE_COMPARE(pixels[16][0], 0x00ff00ff_rgba);
+    CORRADE_COMPARE(pixels[16][31], 0x00ff00ff_rgba);
+
+    #ifndef MAGNUM_TARGET_GLES
+    CORRADE_COMPARE(count, data.expectedCount);
+    #else
+    static_cast<void>(count);
+    #endif
+    #endif
+}
+
+void DebugDrawGLTest::contactPointCullDistance() {
+    #if BT_BULLET_VERSION < 284
+    CORRADE_SKIP("Batched line drawing is available only with Bullet 2.83.5 and newer.");
+    #else
+    DebugDraw debugDraw;
+    btIDebugDraw& drawer = debugDraw;
+    CORRADE_COMPARE(debugDraw.contactPointCullDistance(), Constants::inf());
+
+    /* A contact point is drawn as a line along the normal, with the length
+       being the distance. The first is roughly 0.53 units from the origin,
+       the second roughly 0.82. */
+    debugDraw.setContactPointCullDistance(0.75f);
+    CORRADE_COMPARE(debugDraw.contactPointCullDistance(), 0.75f);
+    drawer.drawContactPoint(btVector3{-0.25f, pixelCenter(8), 0.0f},
+                            btVector3{1.0f, 0.0f, 0.0f}, 0.5f, 0,
+                            btVector3{1.0f, 0.0f, 0.0f});
+    drawer.drawContactPoint(btVector3{-0.25f, pixelCenter(28), 0.0f},
+                            btVector3{1.0f, 0.0f, 0.0f}, 0.5f, 0,
+                            btVector3{0.0f, 1.0f, 0.0f});
+    const UnsignedInt count1 = flush(drawer);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    {
+        Image2D image = read();
+        Containers::StridedArrayView2D<const Color4ub> pixels = image.pixels<Color4ub>();
+        CORRADE_COMPARE(pixels[8][16], 0xff0000ff_rgba);
+        CORRADE_COMPARE(pixels[8][8], 0x00000000_rgba);
+        CORRADE_COMPARE(pixels[8][24], 0x00000000_rgba);
+        CORRADE_COMPARE(pixels[28][16], 0x00000000_rgba);
+    }
+
+    /* Moving the origin closer to the second makes it drawn and the first
+       culled */
+    _framebuffer.clear(GL::FramebufferClear::Color);
+    debugDraw.setPositionOrigin({0.0f, 0.5f, 0.0f});
+    drawer.drawContactPoint(btVector3{-0.25f, pixelCenter(8), 0.0f},
+                            btVector3{1.0f, 0.0f, 0.0f}, 0.5f, 0,
+                            btVector3{1.0f, 0.0f, 0.0f});
+    drawer.drawContactPoint(btVector3{-0.25f, pixelCenter(28), 0.0f},
+                            btVector3{1.0f, 0.0f, 0.0f}, 0.5f, 0,
+                            btVector3{0.0f, 1.0f, 0.0f});
+    const UnsignedInt count2 = flush(drawer);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    {
+        Image2D image = read();
+        Containers::StridedArrayView2D<const Color4ub> pixels = image.pixels<Color4ub>();
+        CORRADE_COMPARE(pixels[8][16], 0x00000000_rgba);
+        CORRADE_COMPARE(pixels[28][16], 0x00ff00ff_rgba);
+    }
+
+    #ifndef MAGNUM_TARGET_GLES
+    CORRADE_COMPARE(count1, 1);
+    CORRADE_COMPARE(count2, 1);
+    #else
+    static_cast<void>(count1);
+    static_cast<void>(count2);
+    #endif
+    #endif
+}
+
+void DebugDrawGLTest::threadSafe() {
+    auto&& data = ThreadSafeData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    #if BT_BULLET_VERSION < 284
+    CORRADE_SKIP("Batched line drawing is available only with Bullet 2.83.5 and newer.");
+    #else
+    DebugDraw debugDraw{data.flags};
+    btIDebugDraw& drawer = debugDraw;
+
+    /* Each thread draws every fourth row, the main thread draws one more.
+       Everything gets merged together on flush. */
+    const auto drawRows = [&drawer](Int first, const Color3& color) {
+        for(Int row = first; row < DrawSize.y(); row += 4)
+            drawRow(drawer, row, color);
+    };
+    {
+        std::thread threads[]{
+            std::thread{drawRows, 0, 0xff0000_rgbf},
+            std::thread{drawRows, 1, 0x00ff00_rgbf},
+            std::thread{drawRows, 2, 0x0000ff_rgbf},
+        };
+        drawRow(drawer, 3, 0xffffff_rgbf);
+        for(std::thread& thread: threads) thread.join();
+    }
+    const UnsignedInt count1 = flush(drawer);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    {
+        Image2D image = read();
+        Containers::StridedArrayView2D<const Color4ub> pixels = image.pixels<Color4ub>();
+        for(Int row = 0; row < DrawSize.y(); row += 4) {
+            CORRADE_ITERATION(row);
+            CORRADE_COMPARE(pixels[row][16], 0xff0000ff_rgba);
+            CORRADE_COMPARE(pixels[row + 1][16], 0x00ff00ff_rgba);
+            CORRADE_COMPARE(pixels[row + 2][16], 0x0000ffff_rgba);
+        }
+        CORRADE_COMPARE(pixels[3][16], 0xffffffff_rgba);
+        CORRADE_COMPARE(pixels[7][16], 0x00000000_rgba);
+    }
+
+    /* Next frame, the same threads draw again but less. Lines from the
+       previous frame aren't drawn again. */
+    _framebuffer.clear(GL::FramebufferClear::Color);
+    {
+        std::thread thread{drawRows, 30, 0x00ffff_rgbf};
+        thread.join();
+    }
+    const UnsignedInt count2 = flush(drawer);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    {
+        Image2D image = read();
+        Containers::StridedArrayView2D<const Color4ub> pixels = image.pixels<Color4ub>();
+        CORRADE_COMPARE(pixels[30][16], 0x00ffffff_rgba);
+        CORRADE_COMPARE(pixels[0][16], 0x00000000_rgba);
+        CORRADE_COMPARE(pixels[1][16], 0x00000000_rgba);
+        CORRADE_COMPARE(pixels[2][16], 0x00000000_rgba);
+        CORRADE_COMPARE(pixels[3][16], 0x00000000_rgba);
+    }
+
+    #ifndef MAGNUM_TARGET_GLES
+    CORRADE_COMPARE(count1, 3*8 + 1);
+    CORRADE_COMPARE(count2, 1);
+    #else
+    static_cast<void>(count1);
+    static_cast<void>(count2);
+    #endif
+    #endif
+}
+
+void DebugDrawGLTest::drawMode() {
+    #if BT_BULLET_VERSION < 284
+    CORRADE_SKIP("Batched line drawing is available only with Bullet 2.83.5 and newer.");
+    #elif defined(MAGNUM_TARGET_GLES)
+    CORRADE_SKIP("Primitive queries are not available on OpenGL ES.");
+    #else
+    btDefaultCollisionConfiguration configuration;
+    btCollisionDispatcher dispatcher{&configuration};
+    btDbvtBroadphase broadphase;
+    btCollisionWorld world{&dispatcher, &broadphase, &configuration};
+
+    btBoxShape shape{btVector3{0.25f, 0.25f, 0.25f}};
+    btCollisionObject object;
+    object.setCollisionShape(&shape);
+    world.addCollisionObject(&object);
+
+    DebugDraw debugDraw;
+    btIDebugDraw& drawer = debugDraw;
+    world.setDebugDrawer(&debugDraw);
+    world.updateAabbs();
+
+    /* Nothing enabled by default, so nothing gets drawn */
+    CORRADE_COMPARE(drawer.getDebugMode(), btIDebugDraw::DBG_NoDebug);
+    CORRADE_COMPARE(drawWorld(world), 0);
+
+    /* The mode is what Bullet sees, a bounding box is 12 lines */
+    debugDraw.setMode(DebugDraw::Mode::DrawAabb);
+    CORRADE_COMPARE(drawer.getDebugMode(), btIDebugDraw::DBG_DrawAabb);
+    CORRADE_COMPARE(drawWorld(world), 12);
+
+    /* Wireframe adds the box edges on top */
+    debugDraw.setMode(DebugDraw::Mode::DrawAabb|DebugDraw::Mode::DrawWireframe);
+    CORRADE_COMPARE(drawWorld(world), 24);
+
+    /* Setting the mode from Bullet side is reflected as well */
+    drawer.setDebugMode(btIDebugDraw::DBG_DrawWireframe);
+    CORRADE_VERIFY(debugDraw.mode() == DebugDraw::Mode::DrawWireframe);
+    CORRADE_COMPARE(drawWorld(world), 12);
+    drawer.setDebugMode(btIDebugDraw::DBG_NoDebug);
+    CORRADE_COMPARE(drawWorld(world), 0);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    world.removeCollisionObject(&object);
+    #endif
+}
+
+void DebugDrawGLTest::staticObjects() {
+    #if BT_BULLET_VERSION < 284
+    CORRADE_SKIP("Baking static objects is available only with Bullet 2.83.5 and newer.");
+    #elif defined(MAGNUM_TARGET_GLES)
+    CORRADE_SKIP("Primitive queries are not available on OpenGL ES.");
+    #else
+    btDefaultCollisionConfiguration configuration;
+    btCollisionDispatcher dispatcher{&configuration};
+    btDbvtBroadphase broadphase;
+    btCollisionWorld world{&dispatcher, &broadphase, &configuration};
+
+    /* Collision objects are static by default */
+    btBoxShape shape{btVector3{0.25f, 0.25f, 0.25f}};
+    btCollisionObject staticObject;
+    staticObject.setCollisionShape(&shape);
+    staticObject.setWorldTransform(btTransform{btMatrix3x3::getIdentity(), btVector3{-0.5f, 0.0f, 0.0f}});
+    world.addCollisionObject(&staticObject);
+    btCollisionObject dynamicObject;
+    dynamicObject.setCollisionShape(&shape);
+    dynamicObject.setCollisionFlags(0);
+    dynamicObject.setWorldTransform(btTransform{btMatrix3x3::getIdentity(), btVector3{0.5f, 0.0f, 0.0f}});
+    world.addCollisionObject(&dynamicObject);
+    CORRADE_VERIFY(staticObject.isStaticObject());
+    CORRADE_VERIFY(!dynamicObject.isStaticObject());
+
+    DebugDraw debugDraw;
+    debugDraw.setMode(DebugDraw::Mode::DrawAabb);
+    world.setDebugDrawer(&debugDraw);
+    world.updateAabbs();
+
+    /* Nothing baked yet, both are drawn by Bullet */
+    CORRADE_COMPARE(drawWorld(world), 24);
+
+    /* The static object gets baked and isn't drawn by Bullet anymore, but
+       its baked lines are drawn on flush. In total still the same. */
+    CORRADE_VERIFY(debugDraw.updateStaticObjects(world));
+    CORRADE_VERIFY(staticObject.getCollisionFlags() & btCollisionObject::CF_DISABLE_VISUALIZE_OBJECT);
+    CORRADE_VERIFY(!(dynamicObject.getCollisionFlags() & btCollisionObject::CF_DISABLE_VISUALIZE_OBJECT));
+    CORRADE_COMPARE(drawWorld(world), 24);
+
+    /* Nothing changed, so nothing is rebuilt, and the baked lines are drawn
+       just once every frame */
+    CORRADE_VERIFY(!debugDraw.updateStaticObjects(world));
+    CORRADE_COMPARE(drawWorld(world), 24);
+    CORRADE_COMPARE(drawWorld(world), 24);
+
+    /* A sleeping object gets baked as well */
+    dynamicObject.setActivationState(ISLAND_SLEEPING);
+    CORRADE_VERIFY(debugDraw.updateStaticObjects(world));
+    CORRADE_VERIFY(dynamicObject.getCollisionFlags() & btCollisionObject::CF_DISABLE_VISUALIZE_OBJECT);
+    CORRADE_COMPARE(drawWorld(world), 24);
+
+    /* Waking it up rebuilds the geometry and makes it drawn by Bullet
+       again */
+    dynamicObject.activate(true);
+    CORRADE_VERIFY(debugDraw.updateStaticObjects(world));
+    CORRADE_VERIFY(!(dynamicObject.getCollisionFlags() & btCollisionObject::CF_DISABLE_VISUALIZE_OBJECT));
+    CORRADE_COMPARE(drawWorld(world), 24);
+
+    /* Moving a baked object rebuilds the geometry as well */
+    staticObject.setWorldTransform(btTransform{btMatrix3x3::getIdentity(), btVector3{-0.5f, 0.5f, 0.0f}});
+    world.updateAabbs();
+    CORRADE_VERIFY(debugDraw.updateStaticObjects(world));
+    CORRADE_COMPARE(drawWorld(world), 24);
+
+    /* Objects with visualization disabled by the user aren't touched */
+    btCollisionObject hiddenObject;
+    hiddenObject.setCollisionShape(&shape);
+    hiddenObject.setCollisionFlags(hiddenObject.getCollisionFlags()|btCollisionObject::CF_DISABLE_VISUALIZE_OBJECT);
+    world.addCollisionObject(&hiddenObject);
+    world.updateAabbs();
+    CORRADE_VERIFY(!debugDraw.updateStaticObjects(world));
+    CORRADE_COMPARE(drawWorld(world), 24);
+
+    /* Clearing makes Bullet draw the static object again and the baked
+       lines aren't drawn anymore */
+    debugDraw.clearStaticObjects();
+    CORRADE_VERIFY(!(staticObject.getCollisionFlags() & btCollisionObject::CF_DISABLE_VISUALIZE_OBJECT));
+    CORRADE_VERIFY(hiddenObject.getCollisionFlags() & btCollisionObject::CF_DISABLE_VISUALIZE_OBJECT);
+    CORRADE_COMPARE(drawWorld(world), 24);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    world.removeCollisionObject(&hiddenObject);
+    world.removeCollisionObject(&dynamicObject);
+    world.removeCollisionObject(&staticObject);
+
+    /* Baked wireframes have the same color as when drawn by Bullet, which
+       depends on the activation state. A static object with simulation
+       disabled is yellow by default. The box edges are at pixel centers. */
+    {
+        btDbvtBroadphase colorBroadphase;
+        btCollisionWorld colorWorld{&dispatcher, &colorBroadphase, &configuration};
+        btBoxShape colorShape{btVector3{pixelCenter(24), pixelCenter(24), pixelCenter(24)}};
+        btCollisionObject colorObject;
+        colorObject.setCollisionShape(&colorShape);
+        colorObject.forceActivationState(DISABLE_SIMULATION);
+        colorWorld.addCollisionObject(&colorObject);
+
+        DebugDraw colorDebugDraw;
+        colorDebugDraw.setMode(DebugDraw::Mode::DrawWireframe);
+        colorWorld.setDebugDrawer(&colorDebugDraw);
+        colorWorld.updateAabbs();
+
+        _framebuffer.clear(GL::FramebufferClear::Color);
+        drawWorld(colorWorld);
+        MAGNUM_VERIFY_NO_GL_ERROR();
+        {
+            Image2D image = read();
+            Containers::StridedArrayView2D<const Color4ub> pixels = image.pixels<Color4ub>();
+            CORRADE_COMPARE(pixels[16][24], 0xffff00ff_rgba);
+        }
+
+        _framebuffer.clear(GL::FramebufferClear::Color);
+        CORRADE_VERIFY(colorDebugDraw.updateStaticObjects(colorWorld));
+        CORRADE_VERIFY(colorObject.getCollisionFlags() & btCollisionObject::CF_DISABLE_VISUALIZE_OBJECT);
+        drawWorld(colorWorld);
+        MAGNUM_VERIFY_NO_GL_ERROR();
+        {
+            Image2D image = read();
+            Containers::StridedArrayView2D<const Color4ub> pixels = image.pixels<Color4ub>();
+            CORRADE_COMPARE(pixels[16][24], 0xffff00ff_rgba);
+        }
+
+        colorWorld.removeCollisionObject(&colorObject);
+    }
+    #endif
+}
+
+#ifdef MAGNUM_BULLETINTEGRATION_HAS_TEXT
+void DebugDrawGLTest::drawText() {
+    #if BT_BULLET_VERSION < 284
+    CORRADE_SKIP("Batched line drawing is available only with Bullet 2.83.5 and newer.");
+    #else
+    TestFont font;
+    CORRADE_VERIFY(font.openFile({}, 8.0f));
+
+    /* A single 8x8 glyph, with the whole cache filled so the padding around
+       it doesn't matter */
+    Text::GlyphCacheGL glyphCache{PixelFormat::R8Unorm, {16, 16}};
+    glyphCache.addGlyph(glyphCache.addFont(1, &font), 0, {}, {{1, 1}, {9, 9}});
+    for(Containers::StridedArrayView2D<UnsignedByte> slice: glyphCache.image().pixels<UnsignedByte>())
+        for(Containers::StridedArrayView1D<UnsignedByte> row: slice)
+            for(UnsignedByte& pixel: row) pixel = 255;
+    glyphCache.flushImage({{}, {16, 16}});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    DebugDraw debugDraw;
+    btIDebugDraw& drawer = debugDraw;
+
+    /* Without a font the labels are ignored */
+    drawer.draw3dText(btVector3{0.0f, 0.0f, 0.0f}, "ab");
+    CORRADE_COMPARE(flush(drawer), 0);
+    {
+        Image2D image = read();
+        CORRADE_COMPARE(image.pixels<Color4ub>()[16][16], 0x00000000_rgba);
+    }
+
+    debugDraw
+        .setTextFont(font, glyphCache, 8.0f)
+        .setViewportSize(DrawSize)
+        .setTextColor(0xffff00ff_rgbaf);
+
+    /* The label is centered at the projected position, the one outside of
+       the view is skipped. Two glyphs are two quads, so four triangles. */
+    drawer.draw3dText(btVector3{0.0f, 0.0f, 0.0f}, "ab");
+    drawer.draw3dText(btVector3{2.0f, 0.0f, 0.0f}, "ab");
+    const UnsignedInt count1 = flush(drawer);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    {
+        Image2D image = read();
+        Containers::StridedArrayView2D<const Color4ub> pixels = image.pixels<Color4ub>();
+        CORRADE_COMPARE(pixels[16][16], 0xffff00ff_rgba);
+        CORRADE_COMPARE(pixels[16][12], 0xffff00ff_rgba);
+        CORRADE_COMPARE(pixels[16][20], 0xffff00ff_rgba);
+        CORRADE_COMPARE(pixels[16][2], 0x00000000_rgba);
+        CORRADE_COMPARE(pixels[16][29], 0x00000000_rgba);
+        CORRADE_COMPARE(pixels[2][16], 0x00000000_rgba);
+        CORRADE_COMPARE(pixels[29][16], 0x00000000_rgba);
+    }
+
+    /* The labels are cleared after being drawn */
+    const UnsignedInt count2 = flush(drawer);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    #ifndef MAGNUM_TARGET_GLES
+    CORRADE_COMPARE(count1, 4);
+    CORRADE_COMPARE(count2, 0);
+    #else
+    static_cast<void>(count1);
+    static_cast<void>(count2);
+    #endif
+    #endif
+}
+#endif
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::BulletIntegration::Test::DebugDrawGLTest)
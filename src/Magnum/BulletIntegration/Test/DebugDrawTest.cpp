@@ -26,8 +26,10 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Containers/String.h>
 #include <Corrade/TestSuite/Tester.h>
+#include <Magnum/Math/Color.h>
 
 #include "Magnum/BulletIntegration/DebugDraw.h"
 
@@ -39,13 +41,22 @@ struct DebugDrawTest: TestSuite::Tester {
     void constructNoInit();
     void constructCopy();
 
+    void addLinesInvalid();
+
     void debugMode();
+    void debugFlag();
+    void debugFlags();
 };
 
 DebugDrawTest::DebugDrawTest() {
     addTests({&DebugDrawTest::constructNoInit,
               &DebugDrawTest::constructCopy,
-              &DebugDrawTest::debugMode});
+
+              &DebugDrawTest::addLinesInvalid,
+
+              &DebugDrawTest::debugMode,
+              &DebugDrawTest::debugFlag,
+              &DebugDrawTest::debugFlags});
 }
 
 void DebugDrawTest::constructNoInit() {
@@ -61,6 +72,27 @@ void DebugDrawTest::constructCopy() {
     CORRADE_VERIFY(!std::is_assignable<DebugDraw, const DebugDraw&>{});
 }
 
+void DebugDrawTest::addLinesInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    /* The checks happen before any GL state is touched, so a NoCreate
+       instance is enough */
+    DebugDraw debugDraw{NoCreate};
+
+    const Vector3 positions[3];
+    const Color3 colors[3];
+
+    Containers::String out;
+    Error redirectError{&out};
+    debugDraw.addLines(positions, Color3{1.0f, 0.2f, 0.4f});
+    debugDraw.addLines(positions, colors);
+    debugDraw.addLines(Containers::arrayView(positions).prefix(2), colors);
+    CORRADE_COMPARE(out,
+        "BulletIntegration::DebugDraw::addLines(): expected an even position count, got 3\n"
+        "BulletIntegration::DebugDraw::addLines(): expected an even position count, got 3\n"
+        "BulletIntegration::DebugDraw::addLines(): expected 2 colors but got 3\n");
+}
+
 void DebugDrawTest::debugMode() {
     Containers::String out;
 
@@ -68,6 +100,20 @@ void DebugDrawTest::debugMode() {
     CORRADE_COMPARE(out, "BulletIntegration::DebugDraw::Mode::DrawAabb BulletIntegration::DebugDraw::Mode(0xbaadcafe)\n");
 }
 
+void DebugDrawTest::debugFlag() {
+    Containers::String out;
+
+    Debug(&out) << DebugDraw::Flag::DoubleBuffered << DebugDraw::Flag::PackedColors << DebugDraw::Flag::ThreadSafe << DebugDraw::Flag(0xca);
+    CORRADE_COMPARE(out, "BulletIntegration::DebugDraw::Flag::DoubleBuffered BulletIntegration::DebugDraw::Flag::PackedColors BulletIntegration::DebugDraw::Flag::ThreadSafe BulletIntegration::DebugDraw::Flag(0xca)\n");
+}
+
+void DebugDrawTest::debugFlags() {
+    Containers::String out;
+
+    Debug(&out) << (DebugDraw::Flag::DoubleBuffered|DebugDraw::Flag::HalfFloatPositions|DebugDraw::Flag::InstancedPrimitives|DebugDraw::Flag::FrustumCulling|DebugDraw::Flag(0x80)) << DebugDraw::Flags{};
+    CORRADE_COMPARE(out, "BulletIntegration::DebugDraw::Flag::DoubleBuffered|BulletIntegration::DebugDraw::Flag::HalfFloatPositions|BulletIntegration::DebugDraw::Flag::InstancedPrimitives|BulletIntegration::DebugDraw::Flag::FrustumCulling|BulletIntegration::DebugDraw::Flag(0x80) BulletIntegration::DebugDraw::Flags{}\n");
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::BulletIntegration::Test::DebugDrawTest)
@@ -27,7 +27,10 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Containers/String.h>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
 #include <Magnum/Magnum.h>
 #include <Magnum/Math/Matrix4.h>
 
@@ -42,13 +45,23 @@ struct IntegrationTest: TestSuite::Tester {
     void matrix3();
     void matrix4();
     void quaternion();
+
+    void convertVectors();
+    void convertVectorsStrided();
+    void convertTransformations();
+    void convertInvalidSize();
 };
 
 IntegrationTest::IntegrationTest() {
     addTests({&IntegrationTest::vector,
               &IntegrationTest::matrix3,
               &IntegrationTest::matrix4,
-              &IntegrationTest::quaternion});
+              &IntegrationTest::quaternion,
+
+              &IntegrationTest::convertVectors,
+              &IntegrationTest::convertVectorsStrided,
+              &IntegrationTest::convertTransformations,
+              &IntegrationTest::convertInvalidSize});
 
     #ifdef BT_USE_DOUBLE_PRECISION
     Debug{} << "Using Bullet with BT_USE_DOUBLE_PRECISION enabled";
@@ -118,6 +131,97 @@ void IntegrationTest::quaternion() {
     CORRADE_VERIFY(btQuaternion{a} == b);
 }
 
+void IntegrationTest::convertVectors() {
+    const btVector3 a[]{
+        {btScalar(1.0), btScalar(2.0), btScalar(3.0)},
+        {btScalar(4.0), btScalar(5.0), btScalar(6.0)},
+        {btScalar(-7.0), btScalar(8.0), btScalar(-9.0)}
+    };
+    const Math::Vector3<btScalar> b[]{
+        {btScalar(1.0), btScalar(2.0), btScalar(3.0)},
+        {btScalar(4.0), btScalar(5.0), btScalar(6.0)},
+        {btScalar(-7.0), btScalar(8.0), btScalar(-9.0)}
+    };
+
+    /* The contiguous variants can have a SIMD path that writes into the
+       next element, put a sentinel after the end to verify it's not
+       touched */
+    Math::Vector3<btScalar> outB[4];
+    outB[3] = Math::Vector3<btScalar>{btScalar(1337.0)};
+    convertInto(a, Containers::arrayView(outB).prefix(3));
+    CORRADE_COMPARE_AS(Containers::arrayView(outB).prefix(3),
+        Containers::arrayView(b),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(outB[3], Math::Vector3<btScalar>{btScalar(1337.0)});
+
+    btVector3 outA[3];
+    convertInto(b, outA);
+    for(std::size_t i = 0; i != 3; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_VERIFY(outA[i] == a[i]);
+        CORRADE_COMPARE(outA[i].w(), btScalar(0.0));
+    }
+}
+
+void IntegrationTest::convertVectorsStrided() {
+    struct Data {
+        btVector3 bt;
+        Math::Vector3<btScalar> magnum;
+    } data[]{
+        {{btScalar(1.0), btScalar(2.0), btScalar(3.0)}, {}},
+        {{btScalar(4.0), btScalar(5.0), btScalar(6.0)}, {}},
+    };
+
+    Containers::StridedArrayView1D<Data> view = data;
+    convertInto(view.slice(&Data::bt), view.slice(&Data::magnum));
+    CORRADE_COMPARE(data[0].magnum, (Math::Vector3<btScalar>{btScalar(1.0), btScalar(2.0), btScalar(3.0)}));
+    CORRADE_COMPARE(data[1].magnum, (Math::Vector3<btScalar>{btScalar(4.0), btScalar(5.0), btScalar(6.0)}));
+
+    data[0].magnum = {btScalar(-1.0), btScalar(-2.0), btScalar(-3.0)};
+    data[1].magnum = {btScalar(-4.0), btScalar(-5.0), btScalar(-6.0)};
+    convertInto(view.slice(&Data::magnum), view.slice(&Data::bt));
+    CORRADE_VERIFY(data[0].bt == btVector3(btScalar(-1.0), btScalar(-2.0), btScalar(-3.0)));
+    CORRADE_VERIFY(data[1].bt == btVector3(btScalar(-4.0), btScalar(-5.0), btScalar(-6.0)));
+}
+
+void IntegrationTest::convertTransformations() {
+    const auto rotation = Math::Quaternion<btScalar>{{btScalar(1.0), btScalar(2.0), btScalar(3.0)}, btScalar(4.0)}.normalized();
+    const Math::Matrix4<btScalar> a[]{
+        Math::Matrix4<btScalar>::from(rotation.toMatrix(), {btScalar(1.0), btScalar(2.0), btScalar(3.0)}),
+        Math::Matrix4<btScalar>::translation({btScalar(-4.0), btScalar(5.0), btScalar(0.5)})
+    };
+
+    btTransform b[2];
+    convertInto(a, b);
+    for(std::size_t i = 0; i != 2; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(Math::Matrix4<btScalar>{b[i]}, a[i]);
+    }
+
+    Math::Matrix4<btScalar> out[2];
+    convertInto(b, out);
+    CORRADE_COMPARE_AS(Containers::arrayView(out),
+        Containers::arrayView(a),
+        TestSuite::Compare::Container);
+}
+
+void IntegrationTest::convertInvalidSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const btVector3 a[3];
+    Math::Vector3<btScalar> b[2];
+    const btTransform c[3];
+    Math::Matrix4<btScalar> d[2];
+
+    Containers::String out;
+    Error redirectError{&out};
+    convertInto(a, b);
+    convertInto(c, d);
+    CORRADE_COMPARE(out,
+        "BulletIntegration::convertInto(): expected source and destination views to have the same size, got 3 and 2\n"
+        "BulletIntegration::convertInto(): expected source and destination views to have the same size, got 3 and 2\n");
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::BulletIntegration::Test::IntegrationTest)
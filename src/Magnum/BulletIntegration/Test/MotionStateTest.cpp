@@ -33,9 +33,13 @@
 #include <btBulletDynamicsCommon.h>
 
 #include <Corrade/TestSuite/Tester.h>
+#include <Magnum/Math/DualQuaternion.h>
+#include <Magnum/SceneGraph/DualQuaternionTransformation.h>
 #include <Magnum/SceneGraph/MatrixTransformation3D.h>
 #include <Magnum/SceneGraph/Object.h>
+#include <Magnum/SceneGraph/RigidMatrixTransformation3D.h>
 #include <Magnum/SceneGraph/Scene.h>
+#include <Magnum/SceneGraph/TranslationRotationScalingTransformation3D.h>
 
 #include "Magnum/BulletIntegration/Integration.h"
 #include "Magnum/BulletIntegration/MotionState.h"
@@ -58,11 +62,30 @@ struct MotionStateTest: TestSuite::Tester {
 
     void test();
     void testAddFeature();
+    template<class T> void testTransformationType();
+};
+
+template<class> struct TransformationTypeName;
+template<> struct TransformationTypeName<SceneGraph::BasicMatrixTransformation3D<btScalar>> {
+    static const char* name() { return "MatrixTransformation3D"; }
+};
+template<> struct TransformationTypeName<SceneGraph::BasicRigidMatrixTransformation3D<btScalar>> {
+    static const char* name() { return "RigidMatrixTransformation3D"; }
+};
+template<> struct TransformationTypeName<SceneGraph::BasicDualQuaternionTransformation<btScalar>> {
+    static const char* name() { return "DualQuaternionTransformation"; }
+};
+template<> struct TransformationTypeName<SceneGraph::BasicTranslationRotationScalingTransformation3D<btScalar>> {
+    static const char* name() { return "TranslationRotationScalingTransformation3D"; }
 };
 
 MotionStateTest::MotionStateTest() {
     addTests({&MotionStateTest::test,
-              &MotionStateTest::testAddFeature});
+              &MotionStateTest::testAddFeature,
+              &MotionStateTest::testTransformationType<SceneGraph::BasicMatrixTransformation3D<btScalar>>,
+              &MotionStateTest::testTransformationType<SceneGraph::BasicRigidMatrixTransformation3D<btScalar>>,
+              &MotionStateTest::testTransformationType<SceneGraph::BasicDualQuaternionTransformation<btScalar>>,
+              &MotionStateTest::testTransformationType<SceneGraph::BasicTranslationRotationScalingTransformation3D<btScalar>>});
 }
 
 void MotionStateTest::test() {
@@ -126,6 +149,35 @@ void MotionStateTest::testAddFeature() {
     CORRADE_COMPARE(object.transformationMatrix(), transformation);
 }
 
+template<class T> void MotionStateTest::testTransformationType() {
+    setTestCaseTemplateName(TransformationTypeName<T>::name());
+
+    /* Like test(), but verifying that the direct paths for concrete
+       transformation types produce the same result */
+
+    btDefaultCollisionConfiguration collisionConfig;
+    btCollisionDispatcher dispatcher{&collisionConfig};
+    btDbvtBroadphase broadphase;
+    btDiscreteDynamicsWorld btWorld{&dispatcher, &broadphase, nullptr, &collisionConfig};
+    btWorld.setGravity(btVector3{btScalar(0.0), btScalar(0.0), btScalar(0.0)});
+
+    SceneGraph::Scene<T> scene;
+    SceneGraph::Object<T> object{&scene};
+
+    auto transformation = Math::Matrix4<btScalar>::translation({btScalar(1.0), btScalar(2.0), btScalar(3.0)})*Math::Matrix4<btScalar>::rotation(Math::Deg<btScalar>{btScalar(35.0)}, Math::Vector3<btScalar>{btScalar(1.0), btScalar(-2.0), btScalar(0.5)}.normalized());
+
+    MotionState motionState{object};
+    btSphereShape collisionShape{btScalar(0.0)};
+    btRigidBody rigidBody(btScalar(1.0), &motionState.btMotionState(), &collisionShape);
+    btWorld.addRigidBody(&rigidBody);
+
+    rigidBody.setWorldTransform(btTransform{transformation});
+
+    btWorld.stepSimulation(btScalar(1.0));
+
+    CORRADE_COMPARE(object.transformationMatrix(), transformation);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::BulletIntegration::Test::MotionStateTest)
@@ -0,0 +1,125 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/* See MotionStateTest.cpp for why the root header is included */
+#include <btBulletDynamicsCommon.h>
+
+#include <Corrade/Containers/String.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+
+#include "Magnum/BulletIntegration/Profiler.h"
+
+namespace Magnum { namespace BulletIntegration { namespace Test { namespace {
+
+struct ProfilerTest: TestSuite::Tester {
+    explicit ProfilerTest();
+
+    void construct();
+    void endFrame();
+
+    void debugPhase();
+};
+
+using namespace Containers::Literals;
+
+ProfilerTest::ProfilerTest() {
+    addTests({&ProfilerTest::construct,
+              &ProfilerTest::endFrame,
+
+              &ProfilerTest::debugPhase});
+}
+
+void ProfilerTest::construct() {
+    Profiler profiler;
+    CORRADE_VERIFY(profiler.samples().isEmpty());
+    CORRADE_COMPARE(profiler.frameTime(), 0.0f);
+    CORRADE_COMPARE(profiler.phaseTime(Profiler::Phase::Solver), 0.0f);
+}
+
+void ProfilerTest::endFrame() {
+    #ifdef BT_NO_PROFILE
+    CORRADE_SKIP("Bullet is built with BT_NO_PROFILE, can't test.");
+    #else
+    btDefaultCollisionConfiguration collisionConfig;
+    btCollisionDispatcher dispatcher{&collisionConfig};
+    btDbvtBroadphase broadphase;
+    btSequentialImpulseConstraintSolver solver;
+    btDiscreteDynamicsWorld btWorld{&dispatcher, &broadphase, &solver, &collisionConfig};
+
+    btSphereShape collisionShape{btScalar(1.0)};
+    btRigidBody rigidBody(btScalar(1.0), nullptr, &collisionShape);
+    btWorld.addRigidBody(&rigidBody);
+
+    /* Discard whatever was collected before */
+    Profiler profiler;
+    profiler.endFrame();
+
+    btWorld.stepSimulation(btScalar(1.0/60.0), 0);
+    btWorld.stepSimulation(btScalar(1.0/60.0), 0);
+    profiler.endFrame();
+
+    /* There should be a top-level stepSimulation sample called twice, with
+       all phases nested inside */
+    const Profiler::Sample* stepSimulation = nullptr;
+    bool solveConstraints = false;
+    for(const Profiler::Sample& sample: profiler.samples()) {
+        if(sample.name == "stepSimulation"_s && sample.depth == 0)
+            stepSimulation = &sample;
+        else if(sample.name == "solveConstraints"_s) {
+            CORRADE_COMPARE_AS(sample.depth, 0, TestSuite::Compare::Greater);
+            solveConstraints = true;
+        }
+    }
+    CORRADE_VERIFY(stepSimulation);
+    CORRADE_COMPARE(stepSimulation->callCount, 2);
+    CORRADE_VERIFY(stepSimulation->name.flags() & Containers::StringViewFlag::Global);
+    CORRADE_VERIFY(solveConstraints);
+    CORRADE_COMPARE_AS(profiler.frameTime(), stepSimulation->time, TestSuite::Compare::GreaterOrEqual);
+    CORRADE_COMPARE_AS(profiler.phaseTime(Profiler::Phase::Solver), 0.0f, TestSuite::Compare::GreaterOrEqual);
+
+    /* The Bullet profiler got reset, so the next frame has the samples still
+       present but not called at all */
+    profiler.endFrame();
+    for(const Profiler::Sample& sample: profiler.samples()) {
+        CORRADE_ITERATION(sample.name);
+        CORRADE_COMPARE(sample.callCount, 0);
+    }
+
+    btWorld.removeRigidBody(&rigidBody);
+    #endif
+}
+
+void ProfilerTest::debugPhase() {
+    Containers::String out;
+
+    Debug{&out} << Profiler::Phase::Narrowphase << Profiler::Phase(0xca);
+    CORRADE_COMPARE(out, "BulletIntegration::Profiler::Phase::Narrowphase BulletIntegration::Profiler::Phase(0xca)\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::BulletIntegration::Test::ProfilerTest)
@@ -0,0 +1,354 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/* See MotionStateTest.cpp for why the root header is included */
+#include <btBulletDynamicsCommon.h>
+
+#include <Corrade/Containers/String.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Magnum/SceneGraph/MatrixTransformation3D.h>
+#include <Magnum/SceneGraph/Object.h>
+#include <Magnum/SceneGraph/Scene.h>
+
+#include "Magnum/BulletIntegration/Integration.h"
+#include "Magnum/BulletIntegration/RigidBodySynchronizer.h"
+
+#ifdef BT_USE_DOUBLE_PRECISION
+#include <Magnum/SceneGraph/Object.hpp>
+#include <Magnum/SceneGraph/MatrixTransformation3D.hpp>
+#endif
+
+namespace Magnum { namespace BulletIntegration { namespace Test { namespace {
+
+using namespace Math::Literals;
+
+typedef SceneGraph::Object<SceneGraph::BasicMatrixTransformation3D<btScalar>> Object3D;
+typedef SceneGraph::Scene<SceneGraph::BasicMatrixTransformation3D<btScalar>> Scene3D;
+
+struct RigidBodySynchronizerTest: TestSuite::Tester {
+    explicit RigidBodySynchronizerTest();
+
+    void synchronize();
+    void synchronizeInactive();
+    void remove();
+    void removeNotFound();
+
+    void interpolate();
+    void interpolateAddedInactive();
+    void interpolateRemove();
+    void interpolateNotEnabled();
+
+    void debugFlag();
+    void debugFlags();
+};
+
+RigidBodySynchronizerTest::RigidBodySynchronizerTest() {
+    addTests({&RigidBodySynchronizerTest::synchronize,
+              &RigidBodySynchronizerTest::synchronizeInactive,
+              &RigidBodySynchronizerTest::remove,
+              &RigidBodySynchronizerTest::removeNotFound,
+
+              &RigidBodySynchronizerTest::interpolate,
+              &RigidBodySynchronizerTest::interpolateAddedInactive,
+              &RigidBodySynchronizerTest::interpolateRemove,
+              &RigidBodySynchronizerTest::interpolateNotEnabled,
+
+              &RigidBodySynchronizerTest::debugFlag,
+              &RigidBodySynchronizerTest::debugFlags});
+}
+
+void RigidBodySynchronizerTest::synchronize() {
+    btDefaultCollisionConfiguration collisionConfig;
+    btCollisionDispatcher dispatcher{&collisionConfig};
+    btDbvtBroadphase broadphase;
+    btDiscreteDynamicsWorld btWorld{&dispatcher, &broadphase, nullptr, &collisionConfig};
+    btWorld.setGravity(btVector3{btScalar(0.0), btScalar(0.0), btScalar(0.0)});
+
+    Scene3D scene;
+    Object3D object{&scene};
+
+    auto transformation = Math::Matrix4<btScalar>::translation({btScalar(1.0), btScalar(2.0), btScalar(3.0)})*Math::Matrix4<btScalar>::rotationX(Math::Deg<btScalar>{btScalar(45.0)});
+
+    /* No motion state, the synchronizer takes care of the updates */
+    btSphereShape collisionShape{btScalar(0.0)};
+    btRigidBody rigidBody(btScalar(1.0), nullptr, &collisionShape);
+    rigidBody.setWorldTransform(btTransform{transformation});
+    btWorld.addRigidBody(&rigidBody);
+
+    RigidBodySynchronizer synchronizer;
+    CORRADE_COMPARE(synchronizer.add(rigidBody, object), 0);
+    CORRADE_COMPARE(synchronizer.size(), 1);
+
+    /* Nothing happens without an explicit synchronize() call */
+    btWorld.stepSimulation(btScalar(1.0));
+    CORRADE_COMPARE(object.transformationMatrix(), Math::Matrix4<btScalar>{});
+
+    CORRADE_COMPARE(synchronizer.synchronize(), 1);
+    CORRADE_COMPARE(object.transformationMatrix(), transformation);
+}
+
+void RigidBodySynchronizerTest::synchronizeInactive() {
+    Scene3D scene;
+    Object3D staticObject{&scene};
+    Object3D kinematicObject{&scene};
+    Object3D sleepingObject{&scene};
+    Object3D activeObject{&scene};
+
+    auto transformation = Math::Matrix4<btScalar>::translation({btScalar(1.0), btScalar(2.0), btScalar(3.0)});
+
+    btSphereShape collisionShape{btScalar(0.0)};
+    /* Zero mass makes the body static */
+    btRigidBody staticBody(btScalar(0.0), nullptr, &collisionShape);
+    btRigidBody kinematicBody(btScalar(1.0), nullptr, &collisionShape);
+    kinematicBody.setCollisionFlags(kinematicBody.getCollisionFlags()|btCollisionObject::CF_KINEMATIC_OBJECT);
+    btRigidBody sleepingBody(btScalar(1.0), nullptr, &collisionShape);
+    sleepingBody.forceActivationState(ISLAND_SLEEPING);
+    btRigidBody activeBody(btScalar(1.0), nullptr, &collisionShape);
+    for(btRigidBody* body: {&staticBody, &kinematicBody, &sleepingBody, &activeBody})
+        body->setWorldTransform(btTransform{transformation});
+
+    RigidBodySynchronizer synchronizer;
+    synchronizer.add(staticBody, staticObject);
+    synchronizer.add(kinematicBody, kinematicObject);
+    synchronizer.add(sleepingBody, sleepingObject);
+    synchronizer.add(activeBody, activeObject);
+
+    /* Only the last one gets updated */
+    CORRADE_COMPARE(synchronizer.synchronize(), 1);
+    CORRADE_COMPARE(staticObject.transformationMatrix(), Math::Matrix4<btScalar>{});
+    CORRADE_COMPARE(kinematicObject.transformationMatrix(), Math::Matrix4<btScalar>{});
+    CORRADE_COMPARE(sleepingObject.transformationMatrix(), Math::Matrix4<btScalar>{});
+    CORRADE_COMPARE(activeObject.transformationMatrix(), transformation);
+}
+
+void RigidBodySynchronizerTest::remove() {
+    Scene3D scene;
+    Object3D a{&scene};
+    Object3D b{&scene};
+    Object3D c{&scene};
+
+    btSphereShape collisionShape{btScalar(0.0)};
+    btRigidBody bodyA(btScalar(1.0), nullptr, &collisionShape);
+    btRigidBody bodyB(btScalar(1.0), nullptr, &collisionShape);
+    btRigidBody bodyC(btScalar(1.0), nullptr, &collisionShape);
+    bodyA.setWorldTransform(btTransform{Math::Matrix4<btScalar>::translationX(btScalar(1.0))});
+    bodyB.setWorldTransform(btTransform{Math::Matrix4<btScalar>::translationX(btScalar(2.0))});
+    bodyC.setWorldTransform(btTransform{Math::Matrix4<btScalar>::translationX(btScalar(3.0))});
+
+    RigidBodySynchronizer synchronizer;
+    synchronizer.reserve(3);
+    synchronizer.add(bodyA, a);
+    synchronizer.add(bodyB, b);
+    synchronizer.add(bodyC, c);
+
+    synchronizer.remove(bodyA);
+    CORRADE_COMPARE(synchronizer.size(), 2);
+
+    /* The removed object isn't touched anymore, the other two are */
+    CORRADE_COMPARE(synchronizer.synchronize(), 2);
+    CORRADE_COMPARE(a.transformationMatrix(), Math::Matrix4<btScalar>{});
+    CORRADE_COMPARE(b.transformationMatrix(), Math::Matrix4<btScalar>::translationX(btScalar(2.0)));
+    CORRADE_COMPARE(c.transformationMatrix(), Math::Matrix4<btScalar>::translationX(btScalar(3.0)));
+
+    /* Removing the last item works too */
+    synchronizer.remove(bodyB);
+    CORRADE_COMPARE(synchronizer.size(), 1);
+    CORRADE_COMPARE(synchronizer.synchronize(), 1);
+}
+
+void RigidBodySynchronizerTest::removeNotFound() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    btSphereShape collisionShape{btScalar(0.0)};
+    btRigidBody body(btScalar(1.0), nullptr, &collisionShape);
+
+    RigidBodySynchronizer synchronizer;
+
+    Containers::String out;
+    Error redirectError{&out};
+    synchronizer.remove(body);
+    CORRADE_COMPARE(out, "BulletIntegration::RigidBodySynchronizer::remove(): body not found\n");
+}
+
+void RigidBodySynchronizerTest::interpolate() {
+    btDefaultCollisionConfiguration collisionConfig;
+    btCollisionDispatcher dispatcher{&collisionConfig};
+    btDbvtBroadphase broadphase;
+    btDiscreteDynamicsWorld btWorld{&dispatcher, &broadphase, nullptr, &collisionConfig};
+    btWorld.setGravity(btVector3{btScalar(0.0), btScalar(0.0), btScalar(0.0)});
+
+    Scene3D scene;
+    Object3D object{&scene};
+    Object3D staticObject{&scene};
+
+    btSphereShape collisionShape{btScalar(0.0)};
+    btRigidBody rigidBody(btScalar(1.0), nullptr, &collisionShape);
+    rigidBody.setWorldTransform(btTransform{Math::Matrix4<btScalar>::translationY(btScalar(2.0))});
+    btWorld.addRigidBody(&rigidBody);
+    btRigidBody staticBody(btScalar(0.0), nullptr, &collisionShape);
+    staticBody.setWorldTransform(btTransform{Math::Matrix4<btScalar>::translationZ(btScalar(3.0))});
+    btWorld.addRigidBody(&staticBody);
+
+    RigidBodySynchronizer synchronizer{RigidBodySynchronizer::Flag::Interpolated};
+    CORRADE_COMPARE(synchronizer.flags(), RigidBodySynchronizer::Flag::Interpolated);
+    synchronizer.add(rigidBody, object);
+    synchronizer.add(staticBody, staticObject);
+
+    /* Newly added bodies are marked as changed so they get placed initially */
+    CORRADE_COMPARE(synchronizer.changed().size(), 2);
+    CORRADE_VERIFY(synchronizer.changed()[0]);
+    CORRADE_VERIFY(synchronizer.changed()[1]);
+    CORRADE_COMPARE(synchronizer.interpolate(btScalar(0.5)), 2);
+    CORRADE_COMPARE(object.transformationMatrix(), Math::Matrix4<btScalar>::translationY(btScalar(2.0)));
+    CORRADE_COMPARE(staticObject.transformationMatrix(), Math::Matrix4<btScalar>::translationZ(btScalar(3.0)));
+
+    /* Step with a single fixed-size substep. The synchronize() doesn't touch
+       the scene graph, only the static body is now not changed. */
+    rigidBody.setLinearVelocity(btVector3{btScalar(1.0), btScalar(0.0), btScalar(0.0)});
+    btWorld.stepSimulation(btScalar(0.25), 0);
+    CORRADE_COMPARE(synchronizer.synchronize(), 1);
+    CORRADE_COMPARE(object.transformationMatrix(), Math::Matrix4<btScalar>::translationY(btScalar(2.0)));
+    CORRADE_VERIFY(synchronizer.changed()[0]);
+    CORRADE_VERIFY(!synchronizer.changed()[1]);
+
+    CORRADE_COMPARE(synchronizer.interpolatedTransformation(0, btScalar(0.5)),
+        Math::Matrix4<btScalar>::translation({btScalar(0.125), btScalar(2.0), btScalar(0.0)}));
+    CORRADE_COMPARE(synchronizer.interpolate(btScalar(0.5)), 1);
+    CORRADE_COMPARE(object.transformationMatrix(),
+        Math::Matrix4<btScalar>::translation({btScalar(0.125), btScalar(2.0), btScalar(0.0)}));
+
+    /* The body falls asleep, but it's still marked as changed for one more
+       step as it didn't reach its final position in the scene graph yet */
+    rigidBody.forceActivationState(ISLAND_SLEEPING);
+    CORRADE_COMPARE(synchronizer.synchronize(), 0);
+    CORRADE_VERIFY(synchronizer.changed()[0]);
+    CORRADE_COMPARE(synchronizer.interpolate(btScalar(0.5)), 1);
+    CORRADE_COMPARE(object.transformationMatrix(),
+        Math::Matrix4<btScalar>::translation({btScalar(0.25), btScalar(2.0), btScalar(0.0)}));
+
+    /* And then it's not anymore */
+    CORRADE_COMPARE(synchronizer.synchronize(), 0);
+    CORRADE_VERIFY(!synchronizer.changed()[0]);
+    CORRADE_COMPARE(synchronizer.interpolate(btScalar(0.5)), 0);
+
+    btWorld.removeRigidBody(&staticBody);
+    btWorld.removeRigidBody(&rigidBody);
+}
+
+void RigidBodySynchronizerTest::interpolateAddedInactive() {
+    Scene3D scene;
+    Object3D staticObject{&scene};
+    Object3D sleepingObject{&scene};
+
+    auto transformation = Math::Matrix4<btScalar>::translation({btScalar(1.0), btScalar(2.0), btScalar(3.0)});
+
+    btSphereShape collisionShape{btScalar(0.0)};
+    /* Zero mass makes the body static */
+    btRigidBody staticBody(btScalar(0.0), nullptr, &collisionShape);
+    btRigidBody sleepingBody(btScalar(1.0), nullptr, &collisionShape);
+    sleepingBody.forceActivationState(ISLAND_SLEEPING);
+    for(btRigidBody* body: {&staticBody, &sleepingBody})
+        body->setWorldTransform(btTransform{transformation});
+
+    RigidBodySynchronizer synchronizer{RigidBodySynchronizer::Flag::Interpolated};
+    synchronizer.add(staticBody, staticObject);
+    synchronizer.add(sleepingBody, sleepingObject);
+
+    /* The bodies don't move in the steps, but they're still marked as
+       changed in the synchronize() calls until the first interpolate() */
+    CORRADE_COMPARE(synchronizer.synchronize(), 0);
+    CORRADE_COMPARE(synchronizer.synchronize(), 0);
+    CORRADE_VERIFY(synchronizer.changed()[0]);
+    CORRADE_VERIFY(synchronizer.changed()[1]);
+    CORRADE_COMPARE(staticObject.transformationMatrix(), Math::Matrix4<btScalar>{});
+
+    CORRADE_COMPARE(synchronizer.interpolate(btScalar(0.5)), 2);
+    CORRADE_COMPARE(staticObject.transformationMatrix(), transformation);
+    CORRADE_COMPARE(sleepingObject.transformationMatrix(), transformation);
+
+    /* After that they're not marked anymore */
+    CORRADE_COMPARE(synchronizer.synchronize(), 0);
+    CORRADE_VERIFY(!synchronizer.changed()[0]);
+    CORRADE_VERIFY(!synchronizer.changed()[1]);
+    CORRADE_COMPARE(synchronizer.interpolate(btScalar(0.5)), 0);
+}
+
+void RigidBodySynchronizerTest::interpolateRemove() {
+    Scene3D scene;
+    Object3D a{&scene};
+    Object3D b{&scene};
+
+    btSphereShape collisionShape{btScalar(0.0)};
+    btRigidBody bodyA(btScalar(1.0), nullptr, &collisionShape);
+    btRigidBody bodyB(btScalar(1.0), nullptr, &collisionShape);
+    bodyB.setWorldTransform(btTransform{Math::Matrix4<btScalar>::translationX(btScalar(2.0))});
+
+    RigidBodySynchronizer synchronizer{RigidBodySynchronizer::Flag::Interpolated};
+    synchronizer.add(bodyA, a);
+    synchronizer.add(bodyB, b);
+
+    /* Body B gets moved to the first slot together with its transformations
+       and the changed bit */
+    synchronizer.remove(bodyA);
+    CORRADE_COMPARE(synchronizer.changed().size(), 1);
+    CORRADE_VERIFY(synchronizer.changed()[0]);
+    CORRADE_COMPARE(synchronizer.interpolatedTransformation(0, btScalar(1.0)),
+        Math::Matrix4<btScalar>::translationX(btScalar(2.0)));
+}
+
+void RigidBodySynchronizerTest::interpolateNotEnabled() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    RigidBodySynchronizer synchronizer;
+
+    Containers::String out;
+    Error redirectError{&out};
+    synchronizer.changed();
+    synchronizer.interpolatedTransformation(0, btScalar(0.5));
+    synchronizer.interpolate(btScalar(0.5));
+    CORRADE_COMPARE(out,
+        "BulletIntegration::RigidBodySynchronizer::changed(): the synchronizer wasn't created with Flag::Interpolated\n"
+        "BulletIntegration::RigidBodySynchronizer::interpolatedTransformation(): the synchronizer wasn't created with Flag::Interpolated\n"
+        "BulletIntegration::RigidBodySynchronizer::interpolate(): the synchronizer wasn't created with Flag::Interpolated\n");
+}
+
+void RigidBodySynchronizerTest::debugFlag() {
+    Containers::String out;
+
+    Debug(&out) << RigidBodySynchronizer::Flag::Interpolated << RigidBodySynchronizer::Flag(0xca);
+    CORRADE_COMPARE(out, "BulletIntegration::RigidBodySynchronizer::Flag::Interpolated BulletIntegration::RigidBodySynchronizer::Flag(0xca)\n");
+}
+
+void RigidBodySynchronizerTest::debugFlags() {
+    Containers::String out;
+
+    Debug(&out) << (RigidBodySynchronizer::Flag::Interpolated|RigidBodySynchronizer::Flag(0x80)) << RigidBodySynchronizer::Flags{};
+    CORRADE_COMPARE(out, "BulletIntegration::RigidBodySynchronizer::Flag::Interpolated|BulletIntegration::RigidBodySynchronizer::Flag(0x80) BulletIntegration::RigidBodySynchronizer::Flags{}\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::BulletIntegration::Test::RigidBodySynchronizerTest)
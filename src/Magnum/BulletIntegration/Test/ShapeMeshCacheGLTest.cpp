@@ -0,0 +1,221 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Magnum/GL/Mesh.h>
+#include <Magnum/GL/OpenGLTester.h>
+#include <BulletCollision/CollisionShapes/btBoxShape.h>
+#include <BulletCollision/CollisionShapes/btCapsuleShape.h>
+#include <BulletCollision/CollisionShapes/btConvexHullShape.h>
+#include <BulletCollision/CollisionShapes/btSphereShape.h>
+#include <BulletCollision/CollisionShapes/btStaticPlaneShape.h>
+
+#include "Magnum/BulletIntegration/ShapeMeshCache.h"
+
+namespace Magnum { namespace BulletIntegration { namespace Test { namespace {
+
+struct ShapeMeshCacheGLTest: GL::OpenGLTester {
+    explicit ShapeMeshCacheGLTest();
+
+    void construct();
+    void constructCopy();
+    void constructMove();
+
+    void primitive();
+    void capsule();
+    void convexHull();
+    void unsupported();
+    void clear();
+};
+
+ShapeMeshCacheGLTest::ShapeMeshCacheGLTest() {
+    addTests({&ShapeMeshCacheGLTest::construct,
+              &ShapeMeshCacheGLTest::constructCopy,
+              &ShapeMeshCacheGLTest::constructMove,
+
+              &ShapeMeshCacheGLTest::primitive,
+              &ShapeMeshCacheGLTest::capsule,
+              &ShapeMeshCacheGLTest::convexHull,
+              &ShapeMeshCacheGLTest::unsupported,
+              &ShapeMeshCacheGLTest::clear});
+}
+
+void ShapeMeshCacheGLTest::construct() {
+    ShapeMeshCache cache;
+    CORRADE_COMPARE(cache.meshCount(), 0);
+}
+
+void ShapeMeshCacheGLTest::constructCopy() {
+    CORRADE_VERIFY(!std::is_constructible<ShapeMeshCache, const ShapeMeshCache&>{});
+    CORRADE_VERIFY(!std::is_assignable<ShapeMeshCache, const ShapeMeshCache&>{});
+}
+
+void ShapeMeshCacheGLTest::constructMove() {
+    btBoxShape box{{1.0f, 1.0f, 1.0f}};
+
+    ShapeMeshCache a;
+    GL::Mesh* mesh = a.get(box).first();
+    CORRADE_VERIFY(mesh);
+
+    /* The mesh pointer stays the same after a move */
+    ShapeMeshCache b{std::move(a)};
+    CORRADE_COMPARE(b.meshCount(), 1);
+    CORRADE_COMPARE(b.get(box).first(), mesh);
+
+    ShapeMeshCache c;
+    c = std::move(b);
+    CORRADE_COMPARE(c.meshCount(), 1);
+    CORRADE_COMPARE(c.get(box).first(), mesh);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<ShapeMeshCache>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<ShapeMeshCache>::value);
+}
+
+void ShapeMeshCacheGLTest::primitive() {
+    btBoxShape box1{{1.0f, 2.0f, 3.0f}};
+    btBoxShape box2{{0.5f, 0.5f, 0.5f}};
+    btSphereShape sphere1{1.0f};
+    btSphereShape sphere2{3.0f};
+
+    ShapeMeshCache cache;
+    Containers::Pair<GL::Mesh*, Matrix4> box1Mesh = cache.get(box1);
+    Containers::Pair<GL::Mesh*, Matrix4> box2Mesh = cache.get(box2);
+    Containers::Pair<GL::Mesh*, Matrix4> sphere1Mesh = cache.get(sphere1);
+    Containers::Pair<GL::Mesh*, Matrix4> sphere2Mesh = cache.get(sphere2);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* Boxes share one mesh, spheres another, the size is in the
+       transformation */
+    CORRADE_COMPARE(cache.meshCount(), 2);
+    CORRADE_VERIFY(box1Mesh.first());
+    CORRADE_VERIFY(sphere1Mesh.first());
+    CORRADE_COMPARE(box2Mesh.first(), box1Mesh.first());
+    CORRADE_COMPARE(sphere2Mesh.first(), sphere1Mesh.first());
+    CORRADE_VERIFY(sphere1Mesh.first() != box1Mesh.first());
+    CORRADE_COMPARE_AS(box1Mesh.first()->count(), 0,
+        TestSuite::Compare::Greater);
+    CORRADE_COMPARE(box1Mesh.second(), Matrix4::scaling({1.0f, 2.0f, 3.0f}));
+    CORRADE_COMPARE(box2Mesh.second(), Matrix4::scaling(Vector3{0.5f}));
+    CORRADE_COMPARE(sphere1Mesh.second(), Matrix4::scaling(Vector3{1.0f}));
+    CORRADE_COMPARE(sphere2Mesh.second(), Matrix4::scaling(Vector3{3.0f}));
+
+    /* The shapes aren't pointer-keyed, so there's nothing to remove */
+    CORRADE_VERIFY(!cache.remove(box1));
+    CORRADE_COMPARE(cache.meshCount(), 2);
+}
+
+void ShapeMeshCacheGLTest::capsule() {
+    btCapsuleShape a{0.5f, 2.0f};
+    btCapsuleShape b{1.0f, 4.0f};
+    btCapsuleShape c{1.0f, 2.0f};
+    btCapsuleShapeX d{0.5f, 2.0f};
+
+    ShapeMeshCache cache;
+    Containers::Pair<GL::Mesh*, Matrix4> aMesh = cache.get(a);
+    Containers::Pair<GL::Mesh*, Matrix4> bMesh = cache.get(b);
+    Containers::Pair<GL::Mesh*, Matrix4> cMesh = cache.get(c);
+    Containers::Pair<GL::Mesh*, Matrix4> dMesh = cache.get(d);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* Same proportions share a mesh, different proportions or axis don't */
+    CORRADE_COMPARE(cache.meshCount(), 3);
+    CORRADE_COMPARE(bMesh.first(), aMesh.first());
+    CORRADE_VERIFY(cMesh.first() != aMesh.first());
+    CORRADE_VERIFY(dMesh.first() != aMesh.first());
+    CORRADE_COMPARE(aMesh.second(), Matrix4::scaling(Vector3{0.5f}));
+    CORRADE_COMPARE(bMesh.second(), Matrix4::scaling(Vector3{1.0f}));
+    CORRADE_COMPARE(dMesh.second().transformVector(Vector3::yAxis()), Vector3::xAxis(0.5f));
+}
+
+void ShapeMeshCacheGLTest::convexHull() {
+    btConvexHullShape a;
+    a.addPoint({0.0f, 0.0f, 0.0f}, false);
+    a.addPoint({1.0f, 0.0f, 0.0f}, false);
+    a.addPoint({0.0f, 1.0f, 0.0f}, false);
+    a.addPoint({0.0f, 0.0f, 1.0f});
+    btConvexHullShape b;
+    b.addPoint({0.0f, 0.0f, 0.0f}, false);
+    b.addPoint({1.0f, 0.0f, 0.0f}, false);
+    b.addPoint({0.0f, 1.0f, 0.0f}, false);
+    b.addPoint({0.0f, 0.0f, 1.0f});
+
+    ShapeMeshCache cache;
+    GL::Mesh* aMesh = cache.get(a).first();
+    GL::Mesh* bMesh = cache.get(b).first();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* Identified by the pointer, so identical hulls don't share */
+    CORRADE_VERIFY(aMesh);
+    CORRADE_VERIFY(bMesh);
+    CORRADE_VERIFY(aMesh != bMesh);
+    CORRADE_COMPARE(cache.meshCount(), 2);
+    /* Four triangles */
+    CORRADE_COMPARE(aMesh->count(), 12);
+
+    /* Scaling is in the transformation, the mesh stays the same */
+    a.setLocalScaling({2.0f, 2.0f, 2.0f});
+    Containers::Pair<GL::Mesh*, Matrix4> aScaledMesh = cache.get(a);
+    CORRADE_COMPARE(aScaledMesh.first(), aMesh);
+    CORRADE_COMPARE(aScaledMesh.second(), Matrix4::scaling(Vector3{2.0f}));
+
+    CORRADE_VERIFY(cache.remove(a));
+    CORRADE_COMPARE(cache.meshCount(), 1);
+    CORRADE_VERIFY(!cache.remove(a));
+    CORRADE_COMPARE(cache.get(b).first(), bMesh);
+}
+
+void ShapeMeshCacheGLTest::unsupported() {
+    btStaticPlaneShape plane{{0.0f, 1.0f, 0.0f}, 0.0f};
+
+    ShapeMeshCache cache;
+    Containers::Pair<GL::Mesh*, Matrix4> mesh = cache.get(plane);
+    CORRADE_VERIFY(!mesh.first());
+    CORRADE_COMPARE(mesh.second(), Matrix4{Math::IdentityInit});
+    CORRADE_COMPARE(cache.meshCount(), 0);
+    CORRADE_VERIFY(!cache.remove(plane));
+}
+
+void ShapeMeshCacheGLTest::clear() {
+    btBoxShape box{{1.0f, 1.0f, 1.0f}};
+    btSphereShape sphere{1.0f};
+
+    ShapeMeshCache cache;
+    cache.get(box);
+    cache.get(sphere);
+    CORRADE_COMPARE(cache.meshCount(), 2);
+
+    cache.clear();
+    CORRADE_COMPARE(cache.meshCount(), 0);
+
+    /* Meshes get recreated after */
+    CORRADE_VERIFY(cache.get(box).first());
+    CORRADE_COMPARE(cache.meshCount(), 1);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::BulletIntegration::Test::ShapeMeshCacheGLTest)
@@ -0,0 +1,246 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <utility>
+#include <Corrade/Containers/String.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Magnum/Mesh.h>
+#include <Magnum/GL/Buffer.h>
+#include <Magnum/GL/Mesh.h>
+#include <Magnum/GL/OpenGLTester.h>
+#include <Magnum/Math/Vector3.h>
+#include <BulletSoftBody/btSoftBody.h>
+
+#include "Magnum/BulletIntegration/SoftBodyMesh.h"
+
+namespace Magnum { namespace BulletIntegration { namespace Test { namespace {
+
+struct SoftBodyMeshGLTest: GL::OpenGLTester {
+    explicit SoftBodyMeshGLTest();
+
+    void constructFaces();
+    void constructLinks();
+    void constructMove();
+
+    void update();
+    void updateNodeCountChanged();
+};
+
+SoftBodyMeshGLTest::SoftBodyMeshGLTest() {
+    addTests({&SoftBodyMeshGLTest::constructFaces,
+              &SoftBodyMeshGLTest::constructLinks,
+              &SoftBodyMeshGLTest::constructMove,
+
+              &SoftBodyMeshGLTest::update,
+              &SoftBodyMeshGLTest::updateNodeCountChanged});
+}
+
+struct Vertex {
+    Vector3 position;
+    Vector3 normal;
+};
+
+const btVector3 Positions[]{
+    {0.0f, 0.0f, 0.0f},
+    {1.0f, 0.0f, 0.0f},
+    {0.0f, 1.0f, 0.0f},
+    {1.0f, 1.0f, 0.0f}
+};
+const btScalar Masses[]{1.0f, 1.0f, 1.0f, 1.0f};
+
+/* A quad made of two triangles, with normals set explicitly as Bullet
+   calculates them only during the simulation */
+void makeQuad(btSoftBody& softBody) {
+    softBody.appendFace(0, 1, 2);
+    softBody.appendFace(2, 1, 3);
+    softBody.appendLink(0, 1);
+    softBody.appendLink(1, 3);
+    softBody.appendLink(3, 2);
+    softBody.appendLink(2, 0);
+    for(int i = 0; i != softBody.m_nodes.size(); ++i)
+        softBody.m_nodes[i].m_n = btVector3{0.0f, 0.0f, 1.0f};
+}
+
+void SoftBodyMeshGLTest::constructFaces() {
+    btSoftBodyWorldInfo worldInfo;
+    btSoftBody softBody{&worldInfo, 4, Positions, Masses};
+    makeQuad(softBody);
+
+    SoftBodyMesh mesh{softBody};
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(&mesh.softBody(), &softBody);
+    CORRADE_COMPARE(mesh.mesh().primitive(), GL::MeshPrimitive::Triangles);
+    CORRADE_VERIFY(mesh.mesh().isIndexed());
+    CORRADE_COMPARE(mesh.mesh().count(), 6);
+
+    #ifndef MAGNUM_TARGET_GLES
+    /* The indices are made from the faces, not the links */
+    Containers::Array<char> indexData = mesh.indexBuffer().data();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE_AS(Containers::arrayCast<const UnsignedInt>(indexData),
+        Containers::arrayView<UnsignedInt>({0, 1, 2, 2, 1, 3}),
+        TestSuite::Compare::Container);
+
+    Containers::Array<char> vertexData = mesh.vertexBuffer().data();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    Containers::ArrayView<const Vertex> vertices = Containers::arrayCast<const Vertex>(vertexData);
+    CORRADE_COMPARE(vertices.size(), 4);
+    CORRADE_COMPARE(vertices[0].position, (Vector3{0.0f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(vertices[1].position, (Vector3{1.0f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(vertices[2].position, (Vector3{0.0f, 1.0f, 0.0f}));
+    CORRADE_COMPARE(vertices[3].position, (Vector3{1.0f, 1.0f, 0.0f}));
+    CORRADE_COMPARE(vertices[0].normal, Vector3::zAxis());
+    CORRADE_COMPARE(vertices[3].normal, Vector3::zAxis());
+    #else
+    CORRADE_SKIP("Buffer data queries are not available on OpenGL ES.");
+    #endif
+}
+
+void SoftBodyMeshGLTest::constructLinks() {
+    /* A rope with three segments, no faces */
+    btSoftBodyWorldInfo worldInfo;
+    btSoftBody softBody{&worldInfo, 4, Positions, Masses};
+    softBody.appendLink(0, 1);
+    softBody.appendLink(1, 3);
+    softBody.appendLink(3, 2);
+
+    SoftBodyMesh mesh{softBody};
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(mesh.mesh().primitive(), GL::MeshPrimitive::Lines);
+    CORRADE_VERIFY(mesh.mesh().isIndexed());
+    CORRADE_COMPARE(mesh.mesh().count(), 6);
+
+    #ifndef MAGNUM_TARGET_GLES
+    Containers::Array<char> indexData = mesh.indexBuffer().data();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE_AS(Containers::arrayCast<const UnsignedInt>(indexData),
+        Containers::arrayView<UnsignedInt>({0, 1, 1, 3, 3, 2}),
+        TestSuite::Compare::Container);
+    #else
+    CORRADE_SKIP("Buffer data queries are not available on OpenGL ES.");
+    #endif
+}
+
+void SoftBodyMeshGLTest::constructMove() {
+    btSoftBodyWorldInfo worldInfo;
+    btSoftBody softBody{&worldInfo, 4, Positions, Masses};
+    makeQuad(softBody);
+
+    SoftBodyMesh a{softBody};
+    const GLuint id = a.mesh().id();
+
+    SoftBodyMesh b{std::move(a)};
+    CORRADE_COMPARE(&b.softBody(), &softBody);
+    CORRADE_COMPARE(b.mesh().id(), id);
+
+    SoftBodyMesh c{NoCreate};
+    c = std::move(b);
+    CORRADE_COMPARE(&c.softBody(), &softBody);
+    CORRADE_COMPARE(c.mesh().id(), id);
+    CORRADE_COMPARE(c.mesh().count(), 6);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<SoftBodyMesh>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<SoftBodyMesh>::value);
+}
+
+void SoftBodyMeshGLTest::update() {
+    btSoftBodyWorldInfo worldInfo;
+    btSoftBody softBody{&worldInfo, 4, Positions, Masses};
+    makeQuad(softBody);
+
+    SoftBodyMesh mesh{softBody};
+    GL::Mesh* const initialMesh = &mesh.mesh();
+    GL::Buffer* const initialBuffer = &mesh.vertexBuffer();
+
+    /* Move one node and tilt its normal */
+    softBody.m_nodes[3].m_x = btVector3{1.0f, 1.0f, 2.0f};
+    softBody.m_nodes[3].m_n = btVector3{1.0f, 0.0f, 0.0f};
+    mesh.update();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* The other buffer and mesh is used now, the index count stays */
+    CORRADE_VERIFY(&mesh.mesh() != initialMesh);
+    CORRADE_VERIFY(&mesh.vertexBuffer() != initialBuffer);
+    CORRADE_COMPARE(mesh.mesh().count(), 6);
+
+    #ifndef MAGNUM_TARGET_GLES
+    {
+        Containers::Array<char> vertexData = mesh.vertexBuffer().data();
+        MAGNUM_VERIFY_NO_GL_ERROR();
+        Containers::ArrayView<const Vertex> vertices = Containers::arrayCast<const Vertex>(vertexData);
+        CORRADE_COMPARE(vertices.size(), 4);
+        CORRADE_COMPARE(vertices[2].position, (Vector3{0.0f, 1.0f, 0.0f}));
+        CORRADE_COMPARE(vertices[3].position, (Vector3{1.0f, 1.0f, 2.0f}));
+        CORRADE_COMPARE(vertices[2].normal, Vector3::zAxis());
+        CORRADE_COMPARE(vertices[3].normal, Vector3::xAxis());
+    }
+
+    /* The buffer used before wasn't touched */
+    {
+        Containers::Array<char> vertexData = initialBuffer->data();
+        MAGNUM_VERIFY_NO_GL_ERROR();
+        Containers::ArrayView<const Vertex> vertices = Containers::arrayCast<const Vertex>(vertexData);
+        CORRADE_COMPARE(vertices[3].position, (Vector3{1.0f, 1.0f, 0.0f}));
+    }
+    #endif
+
+    /* Next update goes back to the first buffer with the latest data */
+    softBody.m_nodes[0].m_x = btVector3{0.0f, 0.0f, -1.0f};
+    mesh.update();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(&mesh.mesh(), initialMesh);
+    CORRADE_COMPARE(&mesh.vertexBuffer(), initialBuffer);
+
+    #ifndef MAGNUM_TARGET_GLES
+    Containers::Array<char> vertexData = mesh.vertexBuffer().data();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    Containers::ArrayView<const Vertex> vertices = Containers::arrayCast<const Vertex>(vertexData);
+    CORRADE_COMPARE(vertices[0].position, (Vector3{0.0f, 0.0f, -1.0f}));
+    CORRADE_COMPARE(vertices[3].position, (Vector3{1.0f, 1.0f, 2.0f}));
+    #else
+    CORRADE_SKIP("Buffer data queries are not available on OpenGL ES.");
+    #endif
+}
+
+void SoftBodyMeshGLTest::updateNodeCountChanged() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    btSoftBodyWorldInfo worldInfo;
+    btSoftBody softBody{&worldInfo, 4, Positions, Masses};
+    makeQuad(softBody);
+
+    SoftBodyMesh mesh{softBody};
+    softBody.appendNode(btVector3{2.0f, 0.0f, 0.0f}, 1.0f);
+
+    Containers::String out;
+    Error redirectError{&out};
+    mesh.update();
+    CORRADE_COMPARE(out, "BulletIntegration::SoftBodyMesh::update(): expected 4 nodes but the soft body has 5\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::BulletIntegration::Test::SoftBodyMeshGLTest)
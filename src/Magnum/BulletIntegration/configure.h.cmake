@@ -25,4 +25,5 @@
 */
 
 #cmakedefine MAGNUM_BULLETINTEGRATION_BUILD_STATIC
+#cmakedefine MAGNUM_BULLETINTEGRATION_HAS_TEXT
 #cmakedefine MAGNUM_USE_EMSCRIPTEN_PORTS_BULLET
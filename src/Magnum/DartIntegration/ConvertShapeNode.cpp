@@ -52,6 +52,7 @@
 #include <Corrade/Utility/Path.h>
 #include <Magnum/Mesh.h>
 #include <Magnum/Math/Color.h>
+#include <Magnum/Math/Functions.h>
 #include <Magnum/MeshTools/GenerateNormals.h>
 #include <Magnum/MeshTools/Transform.h>
 #include <Magnum/Primitives/Capsule.h>
@@ -66,6 +67,8 @@
 #include <Magnum/Trade/SceneData.h>
 #include <Magnum/Trade/TextureData.h>
 
+#include "Magnum/DartIntegration/Implementation/ConvertShape.h"
+#include "Magnum/DartIntegration/Implementation/PrimitiveMeshCache.h"
 #include "Magnum/EigenIntegration/Integration.h"
 
 namespace Magnum { namespace DartIntegration {
@@ -76,8 +79,79 @@ ShapeData::ShapeData(Containers::Array<Trade::MeshData> meshes, Containers::Arra
 
 ShapeData::~ShapeData() = default;
 
+namespace Implementation {
+
+namespace {
+    enum class PrimitiveKind: UnsignedLong {
+        Box = 1,
+        Capsule,
+        Cone,
+        Cylinder,
+        Ellipsoid,
+        Sphere
+    };
+
+    UnsignedLong primitiveMeshKey(PrimitiveKind kind, UnsignedInt levelOfDetail, Float halfLength = 0.0f) {
+        return UnsignedLong(kind) << 40|UnsignedLong(levelOfDetail & 0xff) << 32|UnsignedInt(Int(Math::round(halfLength*1024.0f)));
+    }
+
+    /* Ring and segment count for given level of detail */
+    UnsignedInt detailCount(UnsignedInt levelOfDetail, UnsignedInt minimum) {
+        return levelOfDetail >= 5 ? minimum : Math::max(32u >> levelOfDetail, minimum);
+    }
+
+    /* Icosphere subdivision count for given level of detail */
+    UnsignedInt subdivisionCount(UnsignedInt full, UnsignedInt levelOfDetail) {
+        return levelOfDetail >= full ? 1 : Math::max(full - levelOfDetail, 1u);
+    }
+}
+
+UnsignedLong primitiveMeshKey(const dart::dynamics::Shape& shape, const UnsignedInt levelOfDetail) {
+    /* Has to match the mesh generation in convertShapeNode() below */
+    const std::string& type = shape.getType();
+    if(type == dart::dynamics::BoxShape::getStaticType())
+        return levelOfDetail ? 0 : primitiveMeshKey(PrimitiveKind::Box, 0);
+    if(type == dart::dynamics::CapsuleShape::getStaticType()) {
+        auto& capsuleShape = static_cast<const dart::dynamics::CapsuleShape&>(shape);
+        return primitiveMeshKey(PrimitiveKind::Capsule, levelOfDetail, 0.5f*Float(capsuleShape.getHeight())/Float(capsuleShape.getRadius()));
+    }
+    if(type == dart::dynamics::ConeShape::getStaticType()) {
+        auto& coneShape = static_cast<const dart::dynamics::ConeShape&>(shape);
+        return primitiveMeshKey(PrimitiveKind::Cone, levelOfDetail, 0.5f*Float(coneShape.getHeight())/Float(coneShape.getRadius()));
+    }
+    if(type == dart::dynamics::CylinderShape::getStaticType()) {
+        auto& cylinderShape = static_cast<const dart::dynamics::CylinderShape&>(shape);
+        return primitiveMeshKey(PrimitiveKind::Cylinder, levelOfDetail, 0.5f*Float(cylinderShape.getHeight())/Float(cylinderShape.getRadius()));
+    }
+    if(type == dart::dynamics::EllipsoidShape::getStaticType())
+        return primitiveMeshKey(PrimitiveKind::Ellipsoid, levelOfDetail);
+    if(type == dart::dynamics::SphereShape::getStaticType())
+        return primitiveMeshKey(PrimitiveKind::Sphere, levelOfDetail);
+    return 0;
+}
+
+}
+
 Containers::Optional<ShapeData> convertShapeNode(dart::dynamics::ShapeNode& shapeNode, ConvertShapeTypes convertTypes, Trade::AbstractImporter* importer) {
-    dart::dynamics::ShapePtr shape = shapeNode.getShape();
+    return convertShapeNode(shapeNode, convertTypes, 0, importer);
+}
+
+Containers::Optional<ShapeData> convertShapeNode(dart::dynamics::ShapeNode& shapeNode, ConvertShapeTypes convertTypes, const UnsignedInt levelOfDetail, Trade::AbstractImporter* importer) {
+    /* Get material information -- we ignore the alpha value. Note that this
+       material is not necessarily used for the MeshShapeNodes. The node
+       doesn't need to have a visual aspect if materials aren't requested. */
+    Color4 color;
+    if(convertTypes & ConvertShapeType::Material) {
+        Eigen::Vector4d col = shapeNode.getVisualAspect()->getRGBA();
+        color = Color4(col(0), col(1), col(2), col(3));
+    }
+
+    return Implementation::convertShape(shapeNode.getShape(), color, convertTypes, levelOfDetail, importer, nullptr);
+}
+
+namespace Implementation {
+
+Containers::Optional<ShapeData> convertShape(const dart::dynamics::ShapePtr& shape, const Color4& color, ConvertShapeTypes convertTypes, const UnsignedInt levelOfDetail, Trade::AbstractImporter* importer, std::mutex* const managerMutex) {
 
     if(shape->getType() == dart::dynamics::LineSegmentShape::getStaticType() ||
        shape->getType() == dart::dynamics::MultiSphereConvexHullShape::getStaticType() ||
@@ -90,14 +164,9 @@ Containers::Optional<ShapeData> convertShapeNode(dart::dynamics::ShapeNode& shap
 
     Containers::Array<Trade::MaterialAttributeData> nodeMaterialAttributes;
     if(convertTypes & ConvertShapeType::Material) {
-        /* Get material information -- we ignore the alpha value. Note that
-           this material is not necessarily used for the MeshShapeNodes */
-        Eigen::Vector4d col = shapeNode.getVisualAspect()->getRGBA();
-
         /* Get diffuse color from Dart ShapeNode */
         arrayAppend(nodeMaterialAttributes, InPlaceInit,
-            Trade::MaterialAttribute::DiffuseColor,
-            Color4(col(0), col(1), col(2), col(3)));
+            Trade::MaterialAttribute::DiffuseColor, color);
 
         /* Remove specular color from soft bodies (otherwise the default would
            be white) */
@@ -148,7 +217,7 @@ Containers::Optional<ShapeData> convertShapeNode(dart::dynamics::ShapeNode& shap
             Float halfLength = 0.5f*h/r;
 
             shapeData.meshes = Containers::Array<Trade::MeshData>(NoInit, 1);
-            new(&shapeData.meshes[0]) Trade::MeshData{Primitives::capsule3DSolid(32, 32, 32, halfLength)};
+            new(&shapeData.meshes[0]) Trade::MeshData{Primitives::capsule3DSolid(detailCount(levelOfDetail, 1), detailCount(levelOfDetail, 1), detailCount(levelOfDetail, 4), halfLength)};
 
             Matrix4 rot = Matrix4::rotationX(90.0_degf);
             MeshTools::transformVectorsInPlace(rot, shapeData.meshes[0].mutableAttribute<Vector3>(Trade::MeshAttribute::Position));
@@ -169,7 +238,7 @@ Containers::Optional<ShapeData> convertShapeNode(dart::dynamics::ShapeNode& shap
             Float halfLength = 0.5f*h/r;
 
             shapeData.meshes = Containers::Array<Trade::MeshData>(NoInit, 1);
-            new(&shapeData.meshes[0]) Trade::MeshData{Primitives::coneSolid(32, 32, halfLength, Primitives::ConeFlag::CapEnd)};
+            new(&shapeData.meshes[0]) Trade::MeshData{Primitives::coneSolid(detailCount(levelOfDetail, 1), detailCount(levelOfDetail, 4), halfLength, Primitives::ConeFlag::CapEnd)};
 
             Matrix4 rot = Matrix4::rotationX(90.0_degf);
             MeshTools::transformVectorsInPlace(rot, shapeData.meshes[0].mutableAttribute<Vector3>(Trade::MeshAttribute::Position));
@@ -190,7 +259,7 @@ Containers::Optional<ShapeData> convertShapeNode(dart::dynamics::ShapeNode& shap
             Float halfLength = 0.5f*h/r;
 
             shapeData.meshes = Containers::Array<Trade::MeshData>(NoInit, 1);
-            new(&shapeData.meshes[0]) Trade::MeshData{Primitives::cylinderSolid(32, 32, halfLength, Primitives::CylinderFlag::CapEnds)};
+            new(&shapeData.meshes[0]) Trade::MeshData{Primitives::cylinderSolid(detailCount(levelOfDetail, 1), detailCount(levelOfDetail, 4), halfLength, Primitives::CylinderFlag::CapEnds)};
 
             Matrix4 rot = Matrix4::rotationX(90.0_degf);
             MeshTools::transformVectorsInPlace(rot, shapeData.meshes[0].mutableAttribute<Vector3>(Trade::MeshAttribute::Position));
@@ -208,7 +277,7 @@ Containers::Optional<ShapeData> convertShapeNode(dart::dynamics::ShapeNode& shap
 
         if(convertTypes & ConvertShapeType::Mesh) {
             shapeData.meshes = Containers::Array<Trade::MeshData>(NoInit, 1);
-            new(&shapeData.meshes[0]) Trade::MeshData{Primitives::icosphereSolid(5)};
+            new(&shapeData.meshes[0]) Trade::MeshData{Primitives::icosphereSolid(subdivisionCount(5, levelOfDetail))};
         }
 
     /* Generic mesh */
@@ -303,8 +372,16 @@ Containers::Optional<ShapeData> convertShapeNode(dart::dynamics::ShapeNode& shap
 
         Containers::Array<Containers::Optional<Trade::TextureData>> textures(importer->textureCount());
         Containers::Array<Containers::Optional<Trade::ImageData2D>> images(importer->textureCount());
+        Containers::Array<Containers::Array<Trade::ImageData2D>> imageLevels(importer->textureCount());
 
         if(convertTypes & ConvertShapeType::Material) {
+            /* Image import instantiates AnyImageImporter and the concrete
+               image plugins from the importer's plugin manager, which isn't
+               thread-safe. Serialize it with other users of the manager if
+               called from an import thread. */
+            std::unique_lock<std::mutex> managerLock;
+            if(managerMutex) managerLock = std::unique_lock<std::mutex>{*managerMutex};
+
             for(UnsignedInt i = 0; i < importer->textureCount(); ++i) {
                 /* Cannot load, leave this element set to NullOpt */
                 Containers::Optional<Trade::TextureData> textureData = importer->texture(i);
@@ -320,6 +397,33 @@ Containers::Optional<ShapeData> convertShapeNode(dart::dynamics::ShapeNode& shap
                     continue;
                 }
 
+                /* Load pre-generated mip levels, if there are any. Stop at
+                   the first level that fails to load or doesn't match the
+                   base level format and expected size, the texture is usable
+                   without it. The storage is allocated from the base level,
+                   so a mismatched level would be a GL error on upload. */
+                const UnsignedInt levelCount = importer->image2DLevelCount(textureData->image());
+                for(UnsignedInt level = 1; level < levelCount; ++level) {
+                    Containers::Optional<Trade::ImageData2D> levelData = importer->image2D(textureData->image(), level);
+                    if(!levelData) {
+                        Warning{} << "DartIntegration::convertShapeNode(): cannot load texture image level" << level << Debug::nospace << ", skipping the rest";
+                        break;
+                    }
+
+                    const Vector2i expectedSize = Math::max(imageData->size() >> level, Vector2i{1});
+                    if(levelData->isCompressed() != imageData->isCompressed() ||
+                       (imageData->isCompressed() ?
+                            levelData->compressedFormat() != imageData->compressedFormat() :
+                            levelData->format() != imageData->format()) ||
+                       levelData->size() != expectedSize)
+                    {
+                        Warning{} << "DartIntegration::convertShapeNode(): texture image level" << level << "doesn't match the base level format or size" << expectedSize << Debug::nospace << ", skipping the rest";
+                        break;
+                    }
+
+                    arrayAppend(imageLevels[i], std::move(*levelData));
+                }
+
                 textures[i] = std::move(textureData);
                 images[i] = std::move(imageData);
             }
@@ -336,6 +440,7 @@ Containers::Optional<ShapeData> convertShapeNode(dart::dynamics::ShapeNode& shap
             for(UnsignedInt m = 0; m < materials.size(); m++)
                 new(&shapeData.materials[m]) Trade::PhongMaterialData{std::move(*materials[m])};
             shapeData.images = std::move(images);
+            shapeData.imageLevels = std::move(imageLevels);
             shapeData.textures = std::move(textures);
         }
 
@@ -401,7 +506,7 @@ Containers::Optional<ShapeData> convertShapeNode(dart::dynamics::ShapeNode& shap
 
         if(convertTypes & ConvertShapeType::Mesh) {
             shapeData.meshes = Containers::Array<Trade::MeshData>(NoInit, 1);
-            new(&shapeData.meshes[0]) Trade::MeshData{Primitives::icosphereSolid(4)};
+            new(&shapeData.meshes[0]) Trade::MeshData{Primitives::icosphereSolid(subdivisionCount(4, levelOfDetail))};
         }
     }
 
@@ -410,4 +515,6 @@ Containers::Optional<ShapeData> convertShapeNode(dart::dynamics::ShapeNode& shap
     return Containers::optional(std::move(shapeData));
 }
 
+}
+
 }}
@@ -99,6 +99,17 @@ struct MAGNUM_DARTINTEGRATION_EXPORT ShapeData {
      */
     Containers::Array<Containers::Optional<Trade::ImageData2D>> images;
 
+    /**
+     * @brief Additional image levels corresponding to meshes
+     * @m_since_latest_{integration}
+     *
+     * Mip levels after the base level in @ref images, as provided by the
+     * importer. Empty in case the image has just the base level or given
+     * mesh has no texture. If the base level is compressed, all additional
+     * levels are compressed as well.
+     */
+    Containers::Array<Containers::Array<Trade::ImageData2D>> imageLevels;
+
     /**
      * @brief Texture data corresponding to meshes
      *
@@ -162,6 +173,15 @@ to load such a `dart::dynamics::ShapeNode`. On the contrary, when you are
 trying to load a `dart::dynamics::MeshShape` and the importer is a @cpp nullptr @ce,
 the function will return @ref Corrade::Containers::NullOpt.
 
+Texture images are loaded through the importer as well, including all mip
+levels it provides, which are then put into @ref ShapeData::images and
+@ref ShapeData::imageLevels. Compressed images are passed through as-is,
+which means an importer delegating to @relativeref{Trade,AnyImageImporter} can
+be used to load pre-compressed DDS or KTX files with pre-generated mip levels.
+Basis Universal files can be loaded as well if the
+@relativeref{Trade,BasisImporter} plugin is configured to transcode to a
+compressed format supported by the GPU.
+
 @attention Soft meshes should be drawn with @ref GL::Renderer::Feature::FaceCulling
     enabled as each triangle is drawn twice (once with the original orientation
     and once with the reversed orientation).
@@ -170,6 +190,20 @@ the function will return @ref Corrade::Containers::NullOpt.
 */
 Containers::Optional<ShapeData> MAGNUM_DARTINTEGRATION_EXPORT convertShapeNode(dart::dynamics::ShapeNode& shapeNode, ConvertShapeTypes convertTypes, Trade::AbstractImporter* importer = nullptr);
 
+/**
+@brief Convert `dart::dynamics::ShapeNode` to meshes and material data at given level of detail
+@m_since_latest_{integration}
+
+Level @cpp 0 @ce is the same as
+@ref convertShapeNode(dart::dynamics::ShapeNode&, ConvertShapeTypes, Trade::AbstractImporter*).
+Each next level halves the count of rings and segments of `CapsuleShape`,
+`ConeShape` and `CylinderShape` meshes, and subdivides `EllipsoidShape` and
+`SphereShape` meshes one time fewer, until a minimal tessellation is reached.
+Meshes of other shapes are the same for all levels.
+@experimental
+*/
+Containers::Optional<ShapeData> MAGNUM_DARTINTEGRATION_EXPORT convertShapeNode(dart::dynamics::ShapeNode& shapeNode, ConvertShapeTypes convertTypes, UnsignedInt levelOfDetail, Trade::AbstractImporter* importer = nullptr);
+
 }}
 
 #endif
@@ -34,8 +34,10 @@
 #ifndef DOXYGEN_GENERATING_OUTPUT
 namespace Magnum { namespace DartIntegration {
 
+class InstancedDrawer;
 class Object;
 class World;
+class WorldBatch;
 
 }}
 #endif
@@ -0,0 +1,52 @@
+#ifndef Magnum_DartIntegration_Implementation_ConvertShape_h
+#define Magnum_DartIntegration_Implementation_ConvertShape_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <memory>
+#include <mutex>
+#include <Corrade/Containers/Optional.h>
+#include <Magnum/Math/Color.h>
+
+#include "Magnum/DartIntegration/ConvertShapeNode.h"
+
+namespace dart { namespace dynamics {
+    class Shape;
+}}
+
+namespace Magnum { namespace DartIntegration { namespace Implementation {
+
+/* The actual implementation of convertShapeNode(), taking the shape and
+   node color directly instead of the ShapeNode. Used by the asynchronous
+   import in World, which can't access the ShapeNode from a worker thread as
+   it may get destroyed in the meantime. If @p managerMutex is not null, it's
+   locked while loading texture images, as those go through plugins
+   instantiated from the (not thread-safe) plugin manager. */
+MAGNUM_DARTINTEGRATION_LOCAL Containers::Optional<ShapeData> convertShape(const std::shared_ptr<dart::dynamics::Shape>& shape, const Color4& color, ConvertShapeTypes convertTypes, UnsignedInt levelOfDetail, Trade::AbstractImporter* importer, std::mutex* managerMutex);
+
+}}}
+
+#endif
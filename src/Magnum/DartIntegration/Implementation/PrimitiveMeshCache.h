@@ -0,0 +1,79 @@
+#ifndef Magnum_DartIntegration_Implementation_PrimitiveMeshCache_h
+#define Magnum_DartIntegration_Implementation_PrimitiveMeshCache_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <Magnum/GL/Buffer.h>
+#include <Magnum/Trade/MeshData.h>
+
+#include "Magnum/DartIntegration/visibility.h"
+
+namespace dart { namespace dynamics {
+    class Shape;
+}}
+
+namespace Magnum { namespace DartIntegration { namespace Implementation {
+
+/* Unit primitive mesh shared among all objects with the same shape in a
+   World. Each object compiles its own GL::Mesh referencing the shared
+   buffers, the mesh data are kept for the vertex layout. */
+struct PrimitiveMesh {
+    explicit PrimitiveMesh(Trade::MeshData&& meshData);
+
+    Trade::MeshData meshData;
+    GL::Buffer indices, vertices;
+};
+
+/* Returns 0 if the shape isn't a primitive that can use a shared mesh or if
+   it has no such level of detail. Otherwise the upper 24 bits contain the
+   shape kind, the next 8 bits the level of detail and the lower 32 bits the
+   aspect ratio quantized to a 1/1024th of the radius for shapes whose mesh
+   depends on it. */
+MAGNUM_DARTINTEGRATION_LOCAL UnsignedLong primitiveMeshKey(const dart::dynamics::Shape& shape, UnsignedInt levelOfDetail = 0);
+
+typedef std::unordered_map<UnsignedLong, std::shared_ptr<PrimitiveMesh>> PrimitiveMeshes;
+
+struct PrimitiveMeshCache {
+    /* The objects keep a reference to the entries as well, entries that
+       aren't referenced by any object are pruned in World::refresh(). Points
+       to WorldSharedData::primitiveMeshes, which is shared by all worlds in
+       a WorldBatch. The level of detail count is per-world, as the levels
+       have different keys. */
+    PrimitiveMeshes* meshes;
+    /* Set by World::setLevelOfDetailCount() */
+    UnsignedInt levelOfDetailCount = 1;
+    /* Points to WorldSharedData::managerMutex. Locked by the object update
+       while converting a mesh shape, as the importer may load images through
+       the plugin manager that World import threads use as well. */
+    std::mutex* managerMutex{};
+};
+
+}}}
+
+#endif
@@ -0,0 +1,77 @@
+#ifndef Magnum_DartIntegration_Implementation_WorldSharedData_h
+#define Magnum_DartIntegration_Implementation_WorldSharedData_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pointer.h>
+#include <Corrade/PluginManager/Manager.h>
+#include <Magnum/Trade/AbstractImporter.h>
+
+#include "Magnum/DartIntegration/Object.h"
+#include "Magnum/DartIntegration/Implementation/PrimitiveMeshCache.h"
+
+namespace Magnum { namespace DartIntegration { namespace Implementation {
+
+/* Importer and caches used by a World. Each World has its own, unless it's
+   a part of a WorldBatch, in which case all worlds in the batch use the one
+   owned by the batch. Accessed only from the thread calling refresh(),
+   except for the plugin manager, which is used also by the import threads
+   of all worlds sharing this instance. The plugin manager isn't thread-safe,
+   so every instantiation or destruction of a plugin and every operation that
+   may do so --- such as image import in AssimpImporter, which goes through
+   AnyImageImporter --- has to be done with managerMutex locked. */
+struct WorldSharedData {
+    explicit WorldSharedData(PluginManager::Manager<Trade::AbstractImporter>* manager) {
+        /* If the manager is not passed from outside, maintain our own
+           instance */
+        if(!manager) {
+            managerStorage.emplace();
+            this->manager = &*managerStorage;
+        } else this->manager = manager;
+
+        /* Load Assimp importer */
+        importer = this->manager->loadAndInstantiate("AssimpImporter");
+    }
+
+    Containers::Optional<PluginManager::Manager<Trade::AbstractImporter>> managerStorage;
+    PluginManager::Manager<Trade::AbstractImporter>* manager;
+    std::mutex managerMutex;
+    Containers::Pointer<Trade::AbstractImporter> importer;
+    /* Draw data shared among objects with World::Flag::ShareDrawData.
+       Expired entries are pruned on every tree walk. */
+    std::unordered_map<std::string, std::weak_ptr<DrawData>> drawDataCache;
+    /* Unit primitive meshes shared by all objects */
+    PrimitiveMeshes primitiveMeshes;
+};
+
+}}}
+
+#endif
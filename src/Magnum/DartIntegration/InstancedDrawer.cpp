@@ -0,0 +1,195 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "InstancedDrawer.h"
+
+#include <unordered_map>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Magnum/GL/Buffer.h>
+#include <Magnum/GL/Mesh.h>
+#include <Magnum/Math/Color.h>
+#include <Magnum/Math/Matrix4.h>
+#include <Magnum/SceneGraph/AbstractObject.h>
+#include <Magnum/SceneGraph/Camera.h>
+#include <Magnum/Shaders/PhongGL.h>
+#include <Magnum/Trade/PhongMaterialData.h>
+
+#include "Magnum/DartIntegration/Object.h"
+
+namespace Magnum { namespace DartIntegration {
+
+namespace {
+
+/* Meshes of box, ellipsoid and sphere shapes are distinct GL::Mesh instances
+   sharing the same buffers from the World primitive mesh cache, so the group
+   is identified by the buffers if there are any and by the draw data
+   otherwise */
+struct GroupKey {
+    const void* source;
+    UnsignedInt mesh;
+
+    bool operator==(const GroupKey& other) const {
+        return source == other.source && mesh == other.mesh;
+    }
+};
+
+struct GroupKeyHash {
+    std::size_t operator()(const GroupKey& key) const {
+        return std::hash<const void*>{}(key.source) ^ (std::size_t(key.mesh) << 1);
+    }
+};
+
+struct Instance {
+    Matrix4 transformationMatrix;
+    Matrix3x3 normalMatrix;
+    Color4 color;
+};
+
+struct Group {
+    GL::Buffer buffer{GL::Buffer::TargetHint::Array};
+    Containers::Array<Instance> instances;
+    /* Mesh the instance buffer is attached to. Compared together with the
+       ID because a newly created mesh may end up at the same address. */
+    GL::Mesh* mesh{};
+    GLuint meshId{};
+    std::size_t frame{};
+};
+
+}
+
+struct InstancedDrawer::State {
+    std::unordered_map<GroupKey, Group, GroupKeyHash> groups;
+    std::size_t frame{};
+    UnsignedInt drawCallCount{};
+    Float levelOfDetailScreenSize = 0.25f;
+};
+
+InstancedDrawer::InstancedDrawer(): _state{InPlaceInit} {}
+
+InstancedDrawer::InstancedDrawer(InstancedDrawer&&) noexcept = default;
+
+InstancedDrawer::~InstancedDrawer() = default;
+
+InstancedDrawer& InstancedDrawer::operator=(InstancedDrawer&&) noexcept = default;
+
+UnsignedInt InstancedDrawer::drawCallCount() const {
+    return _state->drawCallCount;
+}
+
+Float InstancedDrawer::levelOfDetailScreenSize() const {
+    return _state->levelOfDetailScreenSize;
+}
+
+InstancedDrawer& InstancedDrawer::setLevelOfDetailScreenSize(const Float size) {
+    _state->levelOfDetailScreenSize = size;
+    return *this;
+}
+
+InstancedDrawer& InstancedDrawer::draw(Shaders::PhongGL& shader, SceneGraph::Camera3D& camera, const Containers::ArrayView<const Containers::Reference<Object>> objects) {
+    CORRADE_ASSERT(shader.flags() >= (Shaders::PhongGL::Flag::InstancedTransformation|Shaders::PhongGL::Flag::VertexColor),
+        "DartIntegration::InstancedDrawer::draw(): the shader has to have instanced transformation and vertex color enabled", *this);
+
+    State& state = *_state;
+    ++state.frame;
+
+    const Matrix4 projectionMatrix = camera.projectionMatrix();
+    const Matrix4 cameraMatrix = camera.cameraMatrix();
+
+    /* Gather per-instance data for all groups */
+    for(Object& object: objects) {
+        if(!object.shapeNode() || object.isLoading()) continue;
+
+        DrawData& drawData = object.drawData();
+        const Matrix4 absoluteTransformationMatrix = object.object().absoluteTransformationMatrix();
+        const Matrix4 transformationMatrix = absoluteTransformationMatrix*Matrix4::scaling(drawData.scaling);
+        const Matrix3x3 normalMatrix = transformationMatrix.normalMatrix();
+
+        /* Levels of detail exist only for single-mesh shapes. Each level is
+           a separate group, placed after the meshes. */
+        const UnsignedInt level = levelOfDetail(drawData, cameraMatrix*absoluteTransformationMatrix, projectionMatrix, state.levelOfDetailScreenSize);
+
+        for(UnsignedInt i = 0; i != drawData.meshes.size(); ++i) {
+            GL::Mesh& mesh = level ? drawData.levelsOfDetail[level - 1] : drawData.meshes[i];
+            GroupKey key;
+            if(level && !object._primitiveMeshLevels.isEmpty())
+                key = {object._primitiveMeshLevels[level - 1].get(), 0};
+            else if(!level && object._primitiveMesh)
+                key = {object._primitiveMesh.get(), 0};
+            else
+                key = {&drawData, level ? UnsignedInt(drawData.meshes.size()) + level - 1 : i};
+            Group& group = state.groups[key];
+
+            /* First object of the group in this frame, start from scratch.
+               If the mesh is different than the last time, the instance
+               attributes need to be attached again. */
+            if(group.frame != state.frame) {
+                group.frame = state.frame;
+                arrayRemoveSuffix(group.instances, group.instances.size());
+                if(group.mesh != &mesh || group.meshId != mesh.id() || object.hasUpdatedMesh()) {
+                    group.mesh = &mesh;
+                    group.meshId = mesh.id();
+                    mesh.addVertexBufferInstanced(group.buffer, 1, 0,
+                        Shaders::PhongGL::TransformationMatrix{},
+                        Shaders::PhongGL::NormalMatrix{},
+                        Shaders::PhongGL::Color4{});
+                }
+            }
+
+            arrayAppend(group.instances, InPlaceInit, transformationMatrix, normalMatrix,
+                i < drawData.materials.size() ? drawData.materials[i].diffuseColor() : Color4{1.0f});
+        }
+    }
+
+    shader
+        .setProjectionMatrix(projectionMatrix)
+        .setTransformationMatrix(cameraMatrix)
+        .setNormalMatrix(cameraMatrix.normalMatrix());
+
+    /* Draw all groups that got some instances in this frame, free the rest */
+    state.drawCallCount = 0;
+    for(auto it = state.groups.begin(); it != state.groups.end(); ) {
+        Group& group = it->second;
+        if(group.frame != state.frame) {
+            it = state.groups.erase(it);
+            continue;
+        }
+
+        /* Respecifying the whole storage lets the driver orphan the previous
+           contents instead of waiting until the GPU is done drawing them */
+        group.buffer.setData(group.instances, GL::BufferUsage::DynamicDraw);
+        group.mesh->setInstanceCount(Int(group.instances.size()));
+        shader.draw(*group.mesh);
+        /* Leave the mesh drawable the usual way */
+        group.mesh->setInstanceCount(1);
+
+        ++state.drawCallCount;
+        ++it;
+    }
+
+    return *this;
+}
+
+}}
@@ -0,0 +1,139 @@
+#ifndef Magnum_DartIntegration_InstancedDrawer_h
+#define Magnum_DartIntegration_InstancedDrawer_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::DartIntegration::InstancedDrawer
+ * @m_since_latest_{integration}
+ */
+
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/Pointer.h>
+#include <Corrade/Containers/Reference.h>
+#include <Magnum/SceneGraph/SceneGraph.h>
+#include <Magnum/Shaders/Shaders.h>
+
+#include "Magnum/DartIntegration/DartIntegration.h"
+#include "Magnum/DartIntegration/visibility.h"
+
+namespace Magnum { namespace DartIntegration {
+
+/**
+@brief Instanced drawer for DART shapes
+@m_since_latest_{integration}
+
+Groups shape @ref Object instances that share the same mesh and draws each
+group with a single instanced draw call. It's meant to be used together with a
+@ref World, in which case all box, ellipsoid and sphere shapes share the same
+mesh and, with @ref World::Flag::ShareDrawData enabled, also all identical
+mesh shapes. A fleet of identical robots is then drawn in just as many draw
+calls as a single one.
+
+@snippet DartIntegration.cpp InstancedDrawer-usage
+
+The shader is expected to have @ref Shaders::PhongGL::Flag::InstancedTransformation
+and @relativeref{Shaders::PhongGL,Flag::VertexColor} enabled. Each instance
+gets the absolute transformation of the object, including the
+@ref DrawData::scaling, and the diffuse color of the corresponding material
+from @ref DrawData::materials. Other material properties, such as the ambient
+or specular color, are taken from the shader and textures are not used.
+
+If the objects have @ref DrawData::levelsOfDetail, the level is selected for
+each object using @ref levelOfDetail() with
+@ref setLevelOfDetailScreenSize() and each level is drawn as a separate group.
+
+Objects that have no shape or are still @ref Object::isLoading() are skipped.
+Per-instance attributes are added to the first mesh of each group, so it
+shouldn't be drawn with a shader that makes use of vertex colors afterwards.
+
+@requires_gl33 Extension @gl_extension{ARB,instanced_arrays}
+@requires_gles30 Extension @gl_extension{ANGLE,instanced_arrays},
+    @gl_extension{EXT,instanced_arrays} or @gl_extension{NV,instanced_arrays}
+    in OpenGL ES 2.0.
+@requires_webgl20 Extension @webgl_extension{ANGLE,instanced_arrays} in
+    WebGL 1.0.
+
+@experimental
+*/
+class MAGNUM_DARTINTEGRATION_EXPORT InstancedDrawer {
+    public:
+        /** @brief Constructor */
+        explicit InstancedDrawer();
+
+        /** @brief Copying is not allowed */
+        InstancedDrawer(const InstancedDrawer&) = delete;
+
+        /** @brief Move constructor */
+        InstancedDrawer(InstancedDrawer&&) noexcept;
+
+        ~InstancedDrawer();
+
+        /** @brief Copying is not allowed */
+        InstancedDrawer& operator=(const InstancedDrawer&) = delete;
+
+        /** @brief Move assignment */
+        InstancedDrawer& operator=(InstancedDrawer&&) noexcept;
+
+        /**
+         * @brief Count of draw calls done in the last @ref draw()
+         *
+         * Equal to the count of distinct meshes among the drawn objects.
+         */
+        UnsignedInt drawCallCount() const;
+
+        /** @brief Screen size at which the full detail is used */
+        Float levelOfDetailScreenSize() const;
+
+        /**
+         * @brief Set screen size at which the full detail is used
+         * @return Reference to self (for method chaining)
+         *
+         * Passed to @ref levelOfDetail(), default is @cpp 0.25f @ce.
+         */
+        InstancedDrawer& setLevelOfDetailScreenSize(Float size);
+
+        /**
+         * @brief Draw objects
+         * @param shader    Shader to draw with
+         * @param camera    Camera to draw with
+         * @param objects   Objects to draw
+         * @return Reference to self (for method chaining)
+         *
+         * Meant to be called after every @ref World::refresh() with
+         * @ref World::shapeObjects(). Instance buffers of mesh groups that
+         * weren't drawn in this call are freed.
+         */
+        InstancedDrawer& draw(Shaders::PhongGL& shader, SceneGraph::Camera3D& camera, Containers::ArrayView<const Containers::Reference<Object>> objects);
+
+    private:
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+}}
+
+#endif
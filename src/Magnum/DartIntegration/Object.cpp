@@ -27,10 +27,14 @@
 
 #include "Object.h"
 
+#include <cmath>
+#include <mutex>
 #include <dart/dynamics/BodyNode.hpp>
 #include <dart/dynamics/MeshShape.hpp>
 #include <dart/dynamics/ShapeNode.hpp>
+#include <dart/dynamics/SoftBodyNode.hpp>
 #include <dart/dynamics/SoftMeshShape.hpp>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/PluginManager/Manager.h>
 #include <Corrade/Utility/Path.h>
 #include <Magnum/ImageView.h>
@@ -42,6 +46,7 @@
 #include <Magnum/Math/Color.h>
 #include <Magnum/Math/Matrix4.h>
 #include <Magnum/MeshTools/Compile.h>
+#include <Magnum/MeshTools/GenerateNormals.h>
 #include <Magnum/Trade/AbstractImporter.h>
 #include <Magnum/Trade/ImageData.h>
 #include <Magnum/Trade/MeshData.h>
@@ -49,6 +54,8 @@
 #include <Magnum/Trade/TextureData.h>
 
 #include "Magnum/DartIntegration/ConvertShapeNode.h"
+#include "Magnum/DartIntegration/Implementation/ConvertShape.h"
+#include "Magnum/DartIntegration/Implementation/PrimitiveMeshCache.h"
 #include "Magnum/EigenIntegration/GeometryIntegration.h"
 
 namespace Magnum { namespace DartIntegration {
@@ -57,14 +64,66 @@ DrawData::DrawData(Containers::Array<GL::Mesh> meshes, Containers::Array<Trade::
 
 DrawData::~DrawData() = default;
 
-Object::Object(SceneGraph::AbstractBasicObject3D<Float>& object, SceneGraph::AbstractBasicTranslationRotation3D<Float>& transformation, dart::dynamics::ShapeNode* node, dart::dynamics::BodyNode* body): SceneGraph::AbstractBasicFeature3D<Float>{object}, _transformation(transformation), _node{node}, _body{body}, _updated(false), _updatedMesh(false) {}
+UnsignedInt levelOfDetail(const DrawData& drawData, const Matrix4& transformationMatrix, const Matrix4& projectionMatrix, const Float fullDetailScreenSize) {
+    const UnsignedInt coarsest = drawData.levelsOfDetail.size();
+    if(!coarsest) return 0;
+
+    /* The W coordinate is 1 for an orthographic projection and the distance
+       along the view direction for a perspective one */
+    const Float w = (projectionMatrix*Vector4{transformationMatrix.translation(), 1.0f}).w();
+    if(w <= 0.0f) return coarsest;
+
+    /* Projected diameter relative to the viewport height, which spans two
+       units in NDC */
+    const Float radius = (drawData.scaling*transformationMatrix.scaling()).max();
+    const Float screenSize = radius*projectionMatrix[1][1]/w;
+    if(screenSize >= fullDetailScreenSize) return 0;
+    if(screenSize <= 0.0f) return coarsest;
+    return Math::min(UnsignedInt(std::log2(fullDetailScreenSize/screenSize)) + 1, coarsest);
+}
+
+namespace Implementation {
+
+PrimitiveMesh::PrimitiveMesh(Trade::MeshData&& meshData): meshData{std::move(meshData)}, indices{GL::Buffer::TargetHint::ElementArray}, vertices{GL::Buffer::TargetHint::Array} {
+    if(this->meshData.isIndexed())
+        indices.setData(this->meshData.indexData());
+    vertices.setData(this->meshData.vertexData());
+}
+
+/* The mesh data are kept around as a staging area for the positions and
+   normals streamed into the vertex buffer, and for the indices needed to
+   regenerate the normals */
+struct SoftMesh {
+    explicit SoftMesh(Trade::MeshData&& meshData): meshData{std::move(meshData)}, indices{GL::Buffer::TargetHint::ElementArray}, vertices{GL::Buffer::TargetHint::Array} {
+        indices.setData(this->meshData.indexData());
+        vertices.setData(this->meshData.vertexData(), GL::BufferUsage::DynamicDraw);
+    }
+
+    Trade::MeshData meshData;
+    GL::Buffer indices, vertices;
+};
+
+}
+
+Object::Object(SceneGraph::AbstractBasicObject3D<Float>& object, SceneGraph::AbstractBasicTranslationRotation3D<Float>& transformation, dart::dynamics::ShapeNode* node, dart::dynamics::BodyNode* body): SceneGraph::AbstractBasicFeature3D<Float>{object}, _transformation(transformation), _node{node}, _body{body}, _updated(false), _updatedMesh(false), _loading(false), _loadingJob{}, _updatedShapeObjectIndex{~UnsignedInt{}} {}
+
+DrawData& Object::drawData() {
+    CORRADE_ASSERT(!_loading,
+        "DartIntegration::Object::drawData(): the shape is still loading", *_drawData);
+    return *_drawData;
+}
 
 Object& Object::update(Trade::AbstractImporter* importer) {
+    return updateWithCache(importer, nullptr);
+}
+
+Object& Object::updateWithCache(Trade::AbstractImporter* importer, Implementation::PrimitiveMeshCache* const primitiveMeshCache) {
+    Implementation::ObjectTransformation transformation;
+    return applyUpdate(importer, primitiveMeshCache, calculateTransformation(transformation) ? &transformation : nullptr);
+}
+
+bool Object::calculateTransformation(Implementation::ObjectTransformation& out) const {
     using namespace Math::Literals;
-    /* If the object is has a shape and could not extract the DrawData, do not
-       update it; i.e., the user can choose to delete it */
-    if(_node && !extractDrawData(importer))
-        return *this;
 
     /* Get transform from DART */
     Matrix4 trans;
@@ -74,10 +133,8 @@ Object& Object::update(Trade::AbstractImporter* importer) {
         trans = Matrix4(Matrix4d(_node->getRelativeTransform()));
 
     /* Check if any value is NaN */
-    if(Math::isNan(trans.toVector()).any()) {
-        Warning{} << "DartIntegration::Object::update(): Received NaN values from DART. Ignoring this update.";
-        return *this;
-    }
+    if(Math::isNan(trans.toVector()).any())
+        return false;
 
     Quaternion quat = Quaternion::fromMatrix(trans.rotationScaling());
     Vector3 axis = quat.axis();
@@ -85,20 +142,38 @@ Object& Object::update(Trade::AbstractImporter* importer) {
     if(Math::abs(angle) <= 1e-5_radf) {
         axis = {1.f, 0.f, 0.f};
     }
-    axis = axis.normalized();
-    Vector3 t = trans.translation();
+    out.axis = axis.normalized();
+    out.angle = angle;
+    out.translation = trans.translation();
+    return true;
+}
+
+Object& Object::applyUpdate(Trade::AbstractImporter* importer, Implementation::PrimitiveMeshCache* const primitiveMeshCache, const Implementation::ObjectTransformation* const transformation) {
+    /* If the object is has a shape and could not extract the DrawData, do not
+       update it; i.e., the user can choose to delete it */
+    if(_node && !extractDrawData(importer, primitiveMeshCache))
+        return *this;
+
+    return applyTransformation(transformation);
+}
+
+Object& Object::applyTransformation(const Implementation::ObjectTransformation* const transformation) {
+    if(!transformation) {
+        Warning{} << "DartIntegration::Object::update(): Received NaN values from DART. Ignoring this update.";
+        return *this;
+    }
 
     /* Pass it to Magnum */
     _transformation.resetTransformation()
-        .rotate(angle, axis)
-        .translate(t);
+        .rotate(transformation->angle, transformation->axis)
+        .translate(transformation->translation);
 
     /* Set update flag */
     _updated = true;
     return *this;
 }
 
-bool Object::extractDrawData(Trade::AbstractImporter* importer) {
+bool Object::extractDrawData(Trade::AbstractImporter* importer, Implementation::PrimitiveMeshCache* const primitiveMeshCache) {
     _updatedMesh = false;
 
     /* This is not a valid object */
@@ -107,12 +182,19 @@ bool Object::extractDrawData(Trade::AbstractImporter* importer) {
     /* This object has no shape */
     if(!_node) return true;
 
+    /* The shape is being imported asynchronously, World calls
+       finishLoading() once it's done */
+    if(_loading) return true;
+
     UnsignedInt dataVariance = _node->getShape()->getDataVariance();
 
     if(_drawData && dataVariance == dart::dynamics::Shape::DataVariance::STATIC)
         return true;
 
-    bool firstTime = !_drawData;
+    /* If the data are shared with other objects, updating them in-place
+       would affect those as well. Load everything into a new instance
+       instead. */
+    bool firstTime = !_drawData || _drawData.use_count() > 1;
 
     dart::dynamics::ShapeNode& shapeNode = *this->shapeNode();
     dart::dynamics::ShapePtr shape = shapeNode.getShape();
@@ -131,49 +213,182 @@ bool Object::extractDrawData(Trade::AbstractImporter* importer) {
             loadType |= ConvertShapeType::Mesh;
     }
 
-    Containers::Optional<ShapeData> shapeData = convertShapeNode(shapeNode, loadType, importer);
+    ConvertShapeTypes convertTypes = loadType;
+
+    /* Soft meshes change only vertex positions, so the new ones and the
+       normals get streamed into the existing vertex buffer, keeping the
+       index buffer and the mesh layout. Faces of a soft body don't change in
+       practice, but if they do, the mesh is rebuilt from scratch. */
+    bool updatedSoftMesh = false;
+    if(!firstTime && _softMesh && (loadType & ConvertShapeType::Mesh) && updateSoftMesh()) {
+        updatedSoftMesh = true;
+        loadType &= ~ConvertShapeType::Mesh;
+        convertTypes &= ~ConvertShapeType::Mesh;
+        if(!loadType) {
+            _updatedMesh = true;
+            return true;
+        }
+    }
+
+    /* Primitives use a unit mesh shared with other objects of the same
+       shape, if there's a cache. If the mesh is already there, it doesn't
+       need to be generated again. */
+    UnsignedLong primitiveMeshKey = 0;
+    std::shared_ptr<Implementation::PrimitiveMesh> primitiveMesh;
+    if(primitiveMeshCache && (loadType & ConvertShapeType::Mesh) && (primitiveMeshKey = Implementation::primitiveMeshKey(*shape))) {
+        auto found = primitiveMeshCache->meshes->find(primitiveMeshKey);
+        if(found != primitiveMeshCache->meshes->end()) {
+            primitiveMesh = found->second;
+            convertTypes &= ~ConvertShapeType::Mesh;
+        }
+    }
+
+    /* Mesh shapes may import images through the plugin manager, which may
+       be used from World import threads at the same time */
+    std::unique_lock<std::mutex> managerLock;
+    if(importer && primitiveMeshCache && primitiveMeshCache->managerMutex && shape->getType() == dart::dynamics::MeshShape::getStaticType())
+        managerLock = std::unique_lock<std::mutex>{*primitiveMeshCache->managerMutex};
+
+    Containers::Optional<ShapeData> shapeData = convertShapeNode(shapeNode, convertTypes, importer);
+    if(managerLock) managerLock.unlock();
 
     /* Could not convertShapeNode to ShapeData */
     if(!shapeData) return false;
 
+    applyShapeData(*shapeData, loadType, firstTime, primitiveMeshCache, primitiveMeshKey, std::move(primitiveMesh));
+    if(updatedSoftMesh) _updatedMesh = true;
+    return true;
+}
+
+bool Object::updateSoftMesh() {
+    const auto& meshShape = static_cast<const dart::dynamics::SoftMeshShape&>(*_node->getShape());
+    const dart::dynamics::SoftBodyNode* bn = meshShape.getSoftBodyNode();
+    Trade::MeshData& meshData = _softMesh->meshData;
+    if(bn->getNumPointMasses() != meshData.vertexCount() ||
+       bn->getNumFaces()*3 != meshData.indexCount())
+        return false;
+
+    Containers::StridedArrayView1D<Vector3> positions = meshData.mutableAttribute<Vector3>(Trade::MeshAttribute::Position);
+    for(UnsignedInt i = 0; i < bn->getNumPointMasses(); ++i)
+        positions[i] = Vector3{Vector3d{bn->getPointMass(i)->getLocalPosition()}};
+
+    MeshTools::generateSmoothNormalsInto(meshData.indices<UnsignedInt>(), positions, meshData.mutableAttribute<Vector3>(Trade::MeshAttribute::Normal));
+
+    /* Respecifying the whole storage instead of setSubData() lets the driver
+       orphan the previous contents instead of waiting until the GPU is done
+       drawing from them */
+    _softMesh->vertices.setData(meshData.vertexData(), GL::BufferUsage::DynamicDraw);
+    return true;
+}
+
+void Object::finishLoading(ShapeData& shapeData) {
+    CORRADE_INTERNAL_ASSERT(_loading);
+    _loading = false;
+    applyShapeData(shapeData, ConvertShapeType::All, true, nullptr, 0, nullptr);
+}
+
+void Object::applyShapeData(ShapeData& shapeData, const ConvertShapeTypes loadType, const bool firstTime, Implementation::PrimitiveMeshCache* const primitiveMeshCache, const UnsignedLong primitiveMeshKey, std::shared_ptr<Implementation::PrimitiveMesh> primitiveMesh) {
     /* Create the DrawData structure, default scaling to identity */
-    if(firstTime) _drawData = DrawData{{}, {}, {}, Vector3{1.0f}};
+    if(firstTime) _drawData = std::make_shared<DrawData>(Containers::Array<GL::Mesh>{}, Containers::Array<Trade::PhongMaterialData>{}, Containers::Array<Containers::Optional<GL::Texture2D>>{}, Vector3{1.0f});
 
     /* Get the material */
     if(loadType & ConvertShapeType::Material) {
         /* Copy material data */
-        _drawData->materials = std::move(shapeData->materials);
+        _drawData->materials = std::move(shapeData.materials);
 
         /* Create textures */
-        _drawData->textures = Containers::Array<Containers::Optional<GL::Texture2D>>(shapeData->textures.size());
-        for(UnsignedInt i = 0; i < shapeData->textures.size(); i++) {
+        _drawData->textures = Containers::Array<Containers::Optional<GL::Texture2D>>(shapeData.textures.size());
+        for(UnsignedInt i = 0; i < shapeData.textures.size(); i++) {
             /* This is to preserve indexing for materials */
-            if(!shapeData->textures[i] || !shapeData->images[i]) continue;
-
-            (*(_drawData->textures[i] = GL::Texture2D{}))
-                .setMagnificationFilter(shapeData->textures[i]->magnificationFilter())
-                .setMinificationFilter(shapeData->textures[i]->minificationFilter(), shapeData->textures[i]->mipmapFilter())
-                .setWrapping(shapeData->textures[i]->wrapping().xy())
-                .setStorage(1, GL::TextureFormat::RGB8, shapeData->images[i]->size())
-                .setSubImage(0, {}, *shapeData->images[i])
-                .generateMipmap();
+            if(!shapeData.textures[i] || !shapeData.images[i]) continue;
+
+            /* Allocate only as many levels as the importer provided. Mips
+               are expected to be generated offline, no mip building happens
+               here. */
+            const Trade::ImageData2D& image = *shapeData.images[i];
+            const Containers::ArrayView<const Trade::ImageData2D> levels = i < shapeData.imageLevels.size() ? Containers::arrayView(shapeData.imageLevels[i]) : nullptr;
+            GL::Texture2D& texture = *(_drawData->textures[i] = GL::Texture2D{});
+            texture
+                .setMagnificationFilter(shapeData.textures[i]->magnificationFilter())
+                .setMinificationFilter(shapeData.textures[i]->minificationFilter(), shapeData.textures[i]->mipmapFilter())
+                .setWrapping(shapeData.textures[i]->wrapping().xy());
+
+            if(image.isCompressed()) {
+                texture
+                    .setStorage(levels.size() + 1, GL::textureFormat(image.compressedFormat()), image.size())
+                    .setCompressedSubImage(0, {}, image);
+                for(std::size_t level = 0; level != levels.size(); ++level)
+                    texture.setCompressedSubImage(level + 1, {}, levels[level]);
+            } else {
+                texture
+                    .setStorage(levels.size() + 1, GL::textureFormat(image.format()), image.size())
+                    .setSubImage(0, {}, image);
+                for(std::size_t level = 0; level != levels.size(); ++level)
+                    texture.setSubImage(level + 1, {}, levels[level]);
+            }
         }
     }
 
     /* Get scaling */
     if(loadType & ConvertShapeType::Primitive)
-        _drawData->scaling = shapeData->scaling;
+        _drawData->scaling = shapeData.scaling;
 
     /* Get meshes */
     if(loadType & ConvertShapeType::Mesh) {
-        _drawData->meshes = Containers::Array<GL::Mesh>(NoInit, shapeData->meshes.size());
-        for(UnsignedInt i = 0; i < shapeData->meshes.size(); i++)
-            new(&_drawData->meshes[i]) GL::Mesh{MeshTools::compile(shapeData->meshes[i])};
+        if(primitiveMeshKey) {
+            if(!primitiveMesh) {
+                CORRADE_INTERNAL_ASSERT(shapeData.meshes.size() == 1);
+                primitiveMesh = std::make_shared<Implementation::PrimitiveMesh>(std::move(shapeData.meshes[0]));
+                primitiveMeshCache->meshes->emplace(primitiveMeshKey, primitiveMesh);
+            }
+
+            /* Only a vertex array object referencing the shared buffers is
+               created, no data get uploaded */
+            _drawData->meshes = Containers::Array<GL::Mesh>(NoInit, 1);
+            new(&_drawData->meshes[0]) GL::Mesh{MeshTools::compile(primitiveMesh->meshData, primitiveMesh->indices, primitiveMesh->vertices)};
+            _primitiveMesh = std::move(primitiveMesh);
+            _softMesh = nullptr;
+
+            /* Coarser levels of detail are shared the same way. Boxes have
+               none. */
+            const dart::dynamics::ShapePtr& shape = _node->getShape();
+            const UnsignedInt levelCount = Implementation::primitiveMeshKey(*shape, 1) ? primitiveMeshCache->levelOfDetailCount - 1 : 0;
+            _drawData->levelsOfDetail = Containers::Array<GL::Mesh>(NoInit, levelCount);
+            _primitiveMeshLevels = Containers::Array<std::shared_ptr<Implementation::PrimitiveMesh>>{ValueInit, levelCount};
+            for(UnsignedInt i = 0; i != levelCount; ++i) {
+                std::shared_ptr<Implementation::PrimitiveMesh>& levelMesh = (*primitiveMeshCache->meshes)[Implementation::primitiveMeshKey(*shape, i + 1)];
+                if(!levelMesh) {
+                    Containers::Optional<ShapeData> levelData = Implementation::convertShape(shape, {}, ConvertShapeType::Mesh, i + 1, nullptr, nullptr);
+                    CORRADE_INTERNAL_ASSERT(levelData && levelData->meshes.size() == 1);
+                    levelMesh = std::make_shared<Implementation::PrimitiveMesh>(std::move(levelData->meshes[0]));
+                }
+
+                new(&_drawData->levelsOfDetail[i]) GL::Mesh{MeshTools::compile(levelMesh->meshData, levelMesh->indices, levelMesh->vertices)};
+                _primitiveMeshLevels[i] = levelMesh;
+            }
+        } else if(_node->getShape()->getType() == dart::dynamics::SoftMeshShape::getStaticType()) {
+            /* Keep the buffers and the data around for in-place updates in
+               updateSoftMesh() */
+            CORRADE_INTERNAL_ASSERT(shapeData.meshes.size() == 1);
+            _softMesh = std::make_shared<Implementation::SoftMesh>(std::move(shapeData.meshes[0]));
+            _drawData->meshes = Containers::Array<GL::Mesh>(NoInit, 1);
+            new(&_drawData->meshes[0]) GL::Mesh{MeshTools::compile(_softMesh->meshData, _softMesh->indices, _softMesh->vertices)};
+            _drawData->levelsOfDetail = nullptr;
+            _primitiveMesh = nullptr;
+            _primitiveMeshLevels = nullptr;
+        } else {
+            _drawData->meshes = Containers::Array<GL::Mesh>(NoInit, shapeData.meshes.size());
+            for(UnsignedInt i = 0; i < shapeData.meshes.size(); i++)
+                new(&_drawData->meshes[i]) GL::Mesh{MeshTools::compile(shapeData.meshes[i])};
+            _drawData->levelsOfDetail = nullptr;
+            _primitiveMesh = nullptr;
+            _primitiveMeshLevels = nullptr;
+            _softMesh = nullptr;
+        }
     }
 
     /* If we got here, everything went OK; update flag for rendering */
     _updatedMesh = !!loadType;
-    return true;
 }
 
 }}
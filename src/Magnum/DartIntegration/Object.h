@@ -31,13 +31,17 @@
  * @brief Class @ref Magnum::DartIntegration::Object, struct @ref Magnum::DartIntegration::DrawData
  */
 
+#include <memory>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/Optional.h>
 #include <Magnum/GL/GL.h>
+#include <Magnum/Math/Angle.h>
+#include <Magnum/Math/Vector3.h>
 #include <Magnum/SceneGraph/AbstractFeature.h>
 #include <Magnum/SceneGraph/AbstractTranslationRotation3D.h>
 #include <Magnum/Trade/Trade.h>
 
+#include "Magnum/DartIntegration/ConvertShapeNode.h"
 #include "Magnum/DartIntegration/visibility.h"
 
 namespace dart { namespace dynamics {
@@ -47,6 +51,18 @@ namespace dart { namespace dynamics {
 
 namespace Magnum { namespace DartIntegration {
 
+namespace Implementation {
+    struct PrimitiveMesh;
+    struct PrimitiveMeshCache;
+    struct SoftMesh;
+
+    struct ObjectTransformation {
+        Rad angle;
+        Vector3 axis;
+        Vector3 translation;
+    };
+}
+
 /**
 @brief Shape draw data
 
@@ -82,6 +98,19 @@ struct DrawData {
     /** @brief Meshes */
     Containers::Array<GL::Mesh> meshes;
 
+    /**
+     * @brief Lower levels of detail
+     * @m_since_latest_{integration}
+     *
+     * Coarser versions of the only item in @ref meshes, ordered from the
+     * most detailed, the first item being level @cpp 1 @ce. Filled only for
+     * primitive shapes managed by a @ref World with
+     * @ref World::setLevelOfDetailCount() set to more than @cpp 1 @ce and
+     * empty for boxes, which can't get any coarser.
+     * @see @ref levelOfDetail()
+     */
+    Containers::Array<GL::Mesh> levelsOfDetail;
+
     /** @brief Material data */
     Containers::Array<Trade::PhongMaterialData> materials;
 
@@ -92,6 +121,26 @@ struct DrawData {
     Vector3 scaling;
 };
 
+/**
+@brief Select a level of detail
+@param drawData             Draw data
+@param transformationMatrix Object transformation relative to the camera,
+    i.e. the camera matrix multiplied with the absolute object transformation
+@param projectionMatrix     Camera projection matrix
+@param fullDetailScreenSize Size relative to the viewport height at which
+    the full detail is used
+@m_since_latest_{integration}
+
+Estimates the object size on the screen from the largest component of
+@ref DrawData::scaling, assuming a unit mesh. Returns @cpp 0 @ce,
+corresponding to @ref DrawData::meshes, if the size is at least
+@p fullDetailScreenSize, and one level more for each halving of the size,
+corresponding to @ref DrawData::levelsOfDetail, up to the coarsest level
+available. Objects behind the camera get the coarsest level.
+@experimental
+*/
+MAGNUM_DARTINTEGRATION_EXPORT UnsignedInt levelOfDetail(const DrawData& drawData, const Matrix4& transformationMatrix, const Matrix4& projectionMatrix, Float fullDetailScreenSize = 0.25f);
+
 /**
 @brief DART Physics BodyNode or ShapeNode
 
@@ -156,8 +205,26 @@ class MAGNUM_DARTINTEGRATION_EXPORT Object: public SceneGraph::AbstractBasicFeat
         /** @brief Whether object mesh was updated */
         bool hasUpdatedMesh() const { return _updatedMesh; }
 
-        /** @brief Data for drawing */
-        DrawData& drawData() { return *_drawData; }
+        /**
+         * @brief Whether the object shape is still being loaded
+         *
+         * Can be @cpp true @ce only for objects managed by a @ref World with
+         * @ref World::Flag::AsyncImport enabled. In that case the
+         * @ref drawData() isn't available yet. Once the import finishes,
+         * the object appears in @ref World::updatedShapeObjects().
+         * @m_since_latest_{integration}
+         */
+        bool isLoading() const { return _loading; }
+
+        /**
+         * @brief Data for drawing
+         *
+         * If the object is managed by a @ref World with
+         * @ref World::Flag::ShareDrawData set, the instance may be shared
+         * with other objects. Expects that the object is not
+         * @ref isLoading().
+         */
+        DrawData& drawData();
 
         /** @brief Underlying DART `ShapeNode` */
         dart::dynamics::ShapeNode* shapeNode() { return _node; }
@@ -166,15 +233,54 @@ class MAGNUM_DARTINTEGRATION_EXPORT Object: public SceneGraph::AbstractBasicFeat
         dart::dynamics::BodyNode* bodyNode() { return _body; }
 
     private:
+        /* For the parallel refresh, which calculates the transformations on
+           worker threads and applies them serially after */
+        friend class World;
+        /* For grouping objects that share primitive mesh buffers */
+        friend class InstancedDrawer;
+
         explicit Object(SceneGraph::AbstractBasicObject3D<Float>& object, SceneGraph::AbstractBasicTranslationRotation3D<Float>& transformation, dart::dynamics::ShapeNode* node, dart::dynamics::BodyNode* body);
 
-        bool MAGNUM_DARTINTEGRATION_LOCAL extractDrawData(Trade::AbstractImporter* importer = nullptr);
+        /* The cache is non-null if the object is managed by a World */
+        bool MAGNUM_DARTINTEGRATION_LOCAL extractDrawData(Trade::AbstractImporter* importer, Implementation::PrimitiveMeshCache* primitiveMeshCache);
+        /* Returns false if DART gave back NaNs. Touches only the DART
+           skeleton the object belongs to, so it's safe to call in parallel
+           for objects of different skeletons. */
+        bool MAGNUM_DARTINTEGRATION_LOCAL calculateTransformation(Implementation::ObjectTransformation& out) const;
+        /* Called by World after an asynchronous import finished */
+        void MAGNUM_DARTINTEGRATION_LOCAL finishLoading(ShapeData& shapeData);
+        /* Streams new point mass positions and normals into the existing
+           soft mesh buffer. Returns false if the topology changed. */
+        bool MAGNUM_DARTINTEGRATION_LOCAL updateSoftMesh();
+        void MAGNUM_DARTINTEGRATION_LOCAL applyShapeData(ShapeData& shapeData, ConvertShapeTypes loadType, bool firstTime, Implementation::PrimitiveMeshCache* primitiveMeshCache, UnsignedLong primitiveMeshKey, std::shared_ptr<Implementation::PrimitiveMesh> primitiveMesh);
+        /* The transformation is null if calculateTransformation() failed */
+        Object& MAGNUM_DARTINTEGRATION_LOCAL applyUpdate(Trade::AbstractImporter* importer, Implementation::PrimitiveMeshCache* primitiveMeshCache, const Implementation::ObjectTransformation* transformation);
+        /* applyUpdate() without touching the draw data, used by World with
+           a simulation thread running */
+        Object& MAGNUM_DARTINTEGRATION_LOCAL applyTransformation(const Implementation::ObjectTransformation* transformation);
+        /* calculateTransformation() + applyUpdate() */
+        Object& MAGNUM_DARTINTEGRATION_LOCAL updateWithCache(Trade::AbstractImporter* importer, Implementation::PrimitiveMeshCache* primitiveMeshCache);
 
         SceneGraph::AbstractBasicTranslationRotation3D<Float>& _transformation;
         dart::dynamics::ShapeNode* _node;
         dart::dynamics::BodyNode* _body;
-        Containers::Optional<DrawData> _drawData;
-        bool _updated, _updatedMesh;
+        /* Shared among objects with World::Flag::ShareDrawData */
+        std::shared_ptr<DrawData> _drawData;
+        /* Buffers referenced by _drawData->meshes if they come from
+           the World primitive mesh cache */
+        std::shared_ptr<Implementation::PrimitiveMesh> _primitiveMesh;
+        /* Same for DrawData::levelsOfDetail */
+        Containers::Array<std::shared_ptr<Implementation::PrimitiveMesh>> _primitiveMeshLevels;
+        /* Buffers referenced by _drawData->meshes for soft mesh shapes,
+           updated in-place on every refresh */
+        std::shared_ptr<Implementation::SoftMesh> _softMesh;
+        bool _updated, _updatedMesh, _loading;
+        /* ID of the asynchronous import job, to discard results of jobs
+           submitted before the object got recreated */
+        std::size_t _loadingJob;
+        /* Position in World::updatedShapeObjects(), ~UnsignedInt{} if not
+           there */
+        UnsignedInt _updatedShapeObjectIndex;
 };
 
 }}
@@ -0,0 +1,172 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <dart/dynamics/BallJoint.hpp>
+#include <dart/dynamics/BodyNode.hpp>
+#include <dart/dynamics/BoxShape.hpp>
+#include <dart/dynamics/CylinderShape.hpp>
+#include <dart/dynamics/EllipsoidShape.hpp>
+#include <dart/dynamics/FreeJoint.hpp>
+#include <dart/dynamics/RevoluteJoint.hpp>
+#include <dart/dynamics/ShapeNode.hpp>
+#include <dart/dynamics/SoftBodyNode.hpp>
+#include <dart/dynamics/Skeleton.hpp>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pointer.h>
+#include <Corrade/Containers/String.h>
+#include <Corrade/Containers/StringStl.h>
+#include <Corrade/PluginManager/Manager.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/Path.h>
+#include <Magnum/Trade/AbstractImporter.h>
+#include <Magnum/Trade/ImageData.h>
+#include <Magnum/Trade/MeshData.h>
+#include <Magnum/Trade/PhongMaterialData.h>
+#include <Magnum/Trade/TextureData.h>
+
+#include "Magnum/DartIntegration/ConvertShapeNode.h"
+#include "Magnum/DartIntegration/Test/common.h"
+#include "Magnum/DartIntegration/Test/configure.h"
+
+#define DART_URDF (MAGNUM_DART_URDF_FOUND > 0 && DART_MAJOR_VERSION >= 6)
+#if DART_URDF
+    #if DART_MAJOR_VERSION == 6
+        #include <dart/utils/urdf/urdf.hpp>
+    #else
+        #include <dart/io/urdf/urdf.hpp>
+    #endif
+#endif
+
+namespace Magnum { namespace DartIntegration { namespace Test { namespace {
+
+struct ConvertShapeNodeBenchmark: TestSuite::Tester {
+    explicit ConvertShapeNodeBenchmark();
+
+    void setup();
+    void teardown();
+
+    void convert();
+
+    private:
+        PluginManager::Manager<Trade::AbstractImporter> _manager;
+        Containers::Pointer<Trade::AbstractImporter> _importer;
+        Containers::Array<dart::dynamics::SkeletonPtr> _skeletons;
+        Containers::Array<dart::dynamics::ShapeNode*> _shapeNodes;
+};
+
+enum class SceneType {
+    Primitives,
+    SoftBodies,
+    Meshes
+};
+
+const struct {
+    const char* name;
+    SceneType scene;
+    std::size_t count;
+    ConvertShapeTypes convertTypes;
+} SceneData[]{
+    {"primitives", SceneType::Primitives, 100, ConvertShapeType::All},
+    {"primitives, material and scaling only", SceneType::Primitives, 100, ConvertShapeType::Material|ConvertShapeType::Primitive},
+    {"soft bodies", SceneType::SoftBodies, 20, ConvertShapeType::All},
+    #if DART_URDF
+    {"meshes", SceneType::Meshes, 20, ConvertShapeType::All},
+    {"meshes, material and scaling only", SceneType::Meshes, 20, ConvertShapeType::Material|ConvertShapeType::Primitive},
+    #endif
+};
+
+ConvertShapeNodeBenchmark::ConvertShapeNodeBenchmark() {
+    addInstancedBenchmarks({&ConvertShapeNodeBenchmark::convert}, 10,
+        Containers::arraySize(SceneData),
+        &ConvertShapeNodeBenchmark::setup,
+        &ConvertShapeNodeBenchmark::teardown);
+
+    /* Needed for the URDF meshes */
+    _importer = _manager.loadAndInstantiate("AssimpImporter");
+}
+
+void ConvertShapeNodeBenchmark::setup() {
+    auto&& data = SceneData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    #if DART_URDF
+    #if DART_MAJOR_VERSION == 6
+    dart::utils::DartLoader loader;
+    #else
+    dart::io::DartLoader loader;
+    #endif
+    #endif
+
+    for(std::size_t i = 0; i != data.count; ++i) {
+        dart::dynamics::SkeletonPtr skeleton;
+        if(data.scene == SceneType::Primitives) {
+            skeleton = dart::dynamics::Skeleton::create("pendulum");
+            dart::dynamics::BodyNode* bn = makeRootBody(skeleton, "body1");
+            bn = addBody(skeleton, bn, "body2");
+            bn = addBody(skeleton, bn, "body3");
+            addBody(skeleton, bn, "body4");
+        } else if(data.scene == SceneType::SoftBodies) {
+            skeleton = dart::dynamics::Skeleton::create("soft");
+            addSoftBody<dart::dynamics::FreeJoint>(skeleton, "soft box");
+        }
+        #if DART_URDF
+        else if(data.scene == SceneType::Meshes) {
+            skeleton = loader.parseSkeleton(Utility::Path::join(DARTINTEGRATION_TEST_DIR, "urdf/test.urdf"));
+            CORRADE_VERIFY(skeleton);
+        }
+        #endif
+        else CORRADE_INTERNAL_ASSERT_UNREACHABLE();
+
+        for(std::size_t j = 0; j != skeleton->getNumBodyNodes(); ++j)
+            skeleton->getBodyNode(j)->eachShapeNodeWith<dart::dynamics::VisualAspect>([this](dart::dynamics::ShapeNode* node) {
+                arrayAppend(_shapeNodes, node);
+            });
+        arrayAppend(_skeletons, std::move(skeleton));
+    }
+}
+
+void ConvertShapeNodeBenchmark::teardown() {
+    _shapeNodes = nullptr;
+    _skeletons = nullptr;
+}
+
+void ConvertShapeNodeBenchmark::convert() {
+    auto&& data = SceneData[testCaseInstanceId()];
+
+    std::size_t converted = 0;
+    CORRADE_BENCHMARK(1) {
+        for(dart::dynamics::ShapeNode* node: _shapeNodes)
+            if(convertShapeNode(*node, data.convertTypes, _importer.get()))
+                ++converted;
+    }
+
+    CORRADE_COMPARE(converted, _shapeNodes.size());
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::DartIntegration::Test::ConvertShapeNodeBenchmark)
@@ -51,10 +51,12 @@
 #include <Corrade/Containers/StringStl.h>
 #include <Corrade/PluginManager/Manager.h>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
 #include <Corrade/Utility/Path.h>
 #include <Magnum/Math/Color.h>
 #include <Magnum/Trade/AbstractImporter.h>
 #include <Magnum/Trade/ImageData.h>
+#include <Magnum/Trade/MeshData.h>
 #include <Magnum/Trade/PhongMaterialData.h>
 #include <Magnum/Trade/TextureData.h>
 
@@ -78,6 +80,7 @@ struct ConvertShapeNodeTest: TestSuite::Tester {
     explicit ConvertShapeNodeTest();
 
     void basicShapes();
+    void levelOfDetail();
     void assimpImporter();
     void unsupportedShapes();
     void pendulum();
@@ -92,6 +95,7 @@ struct ConvertShapeNodeTest: TestSuite::Tester {
 
 ConvertShapeNodeTest::ConvertShapeNodeTest() {
     addTests({&ConvertShapeNodeTest::basicShapes,
+              &ConvertShapeNodeTest::levelOfDetail,
               &ConvertShapeNodeTest::assimpImporter,
               &ConvertShapeNodeTest::unsupportedShapes,
               &ConvertShapeNodeTest::pendulum,
@@ -176,6 +180,52 @@ void ConvertShapeNodeTest::basicShapes() {
     }
 }
 
+void ConvertShapeNodeTest::levelOfDetail() {
+    dart::dynamics::SkeletonPtr tmpSkel = dart::dynamics::Skeleton::create("LevelOfDetail");
+
+    dart::dynamics::BodyNodePtr bn = tmpSkel->createJointAndBodyNodePair<dart::dynamics::WeldJoint>(
+        nullptr, dart::dynamics::WeldJoint::Properties(), dart::dynamics::BodyNode::AspectProperties("LevelOfDetailBody")).second;
+
+    std::shared_ptr<dart::dynamics::CylinderShape> cylinder(new dart::dynamics::CylinderShape(1., 1.));
+    std::shared_ptr<dart::dynamics::SphereShape> sphere(new dart::dynamics::SphereShape(1.));
+    std::shared_ptr<dart::dynamics::BoxShape> box(new dart::dynamics::BoxShape(Eigen::Vector3d(1., 1., 1.)));
+    dart::dynamics::ShapeNode* cylinderNode = bn->createShapeNodeWith<dart::dynamics::VisualAspect>(cylinder);
+    dart::dynamics::ShapeNode* sphereNode = bn->createShapeNodeWith<dart::dynamics::VisualAspect>(sphere);
+    dart::dynamics::ShapeNode* boxNode = bn->createShapeNodeWith<dart::dynamics::VisualAspect>(box);
+
+    /* Level 0 is the same as the default */
+    for(dart::dynamics::ShapeNode* shapeNode: {cylinderNode, sphereNode, boxNode}) {
+        CORRADE_ITERATION(shapeNode->getShape()->getType());
+        Containers::Optional<ShapeData> full = convertShapeNode(*shapeNode, ConvertShapeType::Mesh);
+        Containers::Optional<ShapeData> level0 = convertShapeNode(*shapeNode, ConvertShapeType::Mesh, 0);
+        CORRADE_VERIFY(full);
+        CORRADE_VERIFY(level0);
+        CORRADE_COMPARE(level0->meshes[0].vertexCount(), full->meshes[0].vertexCount());
+    }
+
+    /* Each level is coarser than the previous, until the minimum */
+    for(dart::dynamics::ShapeNode* shapeNode: {cylinderNode, sphereNode}) {
+        CORRADE_ITERATION(shapeNode->getShape()->getType());
+        UnsignedInt previous = convertShapeNode(*shapeNode, ConvertShapeType::Mesh, 0)->meshes[0].vertexCount();
+        for(UnsignedInt level: {1, 2, 3}) {
+            CORRADE_ITERATION(level);
+            Containers::Optional<ShapeData> shapeData = convertShapeNode(*shapeNode, ConvertShapeType::Mesh, level);
+            CORRADE_VERIFY(shapeData);
+            CORRADE_COMPARE_AS(shapeData->meshes[0].vertexCount(), previous, TestSuite::Compare::Less);
+            previous = shapeData->meshes[0].vertexCount();
+        }
+
+        Containers::Optional<ShapeData> coarsest = convertShapeNode(*shapeNode, ConvertShapeType::Mesh, 100);
+        CORRADE_VERIFY(coarsest);
+        CORRADE_COMPARE_AS(coarsest->meshes[0].vertexCount(), 0u, TestSuite::Compare::Greater);
+        CORRADE_COMPARE_AS(coarsest->meshes[0].vertexCount(), previous, TestSuite::Compare::LessOrEqual);
+    }
+
+    /* Boxes are the same for all levels */
+    CORRADE_COMPARE(convertShapeNode(*boxNode, ConvertShapeType::Mesh, 3)->meshes[0].vertexCount(),
+                    convertShapeNode(*boxNode, ConvertShapeType::Mesh)->meshes[0].vertexCount());
+}
+
 void ConvertShapeNodeTest::assimpImporter() {
     {
         /* MeshShape */
@@ -556,6 +606,12 @@ void ConvertShapeNodeTest::texture() {
 
             CORRADE_COMPARE(shapeDataAll->textures.size(), 1);
             CORRADE_COMPARE(shapeDataAll->textures.size(), shapeDataMaterial->textures.size());
+
+            /* The PNG has just the base level */
+            CORRADE_COMPARE(shapeDataAll->imageLevels.size(), 1);
+            CORRADE_VERIFY(shapeDataAll->images[0]);
+            CORRADE_VERIFY(!shapeDataAll->images[0]->isCompressed());
+            CORRADE_VERIFY(shapeDataAll->imageLevels[0].isEmpty());
         }
     }
 }
@@ -0,0 +1,149 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <dart/dynamics/BallJoint.hpp>
+#include <dart/dynamics/BodyNode.hpp>
+#include <dart/dynamics/BoxShape.hpp>
+#include <dart/dynamics/CylinderShape.hpp>
+#include <dart/dynamics/EllipsoidShape.hpp>
+#include <dart/dynamics/RevoluteJoint.hpp>
+#include <dart/dynamics/SoftBodyNode.hpp>
+#include <dart/dynamics/Skeleton.hpp>
+#include <dart/simulation/World.hpp>
+#include <Corrade/Containers/String.h>
+#include <Magnum/GL/Context.h>
+#include <Magnum/GL/Extensions.h>
+#include <Magnum/GL/OpenGLTester.h>
+#include <Magnum/SceneGraph/Camera.h>
+#include <Magnum/SceneGraph/MatrixTransformation3D.h>
+#include <Magnum/SceneGraph/Object.hpp>
+#include <Magnum/SceneGraph/SceneGraph.h>
+#include <Magnum/Shaders/PhongGL.h>
+
+#include "Magnum/DartIntegration/InstancedDrawer.h"
+#include "Magnum/DartIntegration/World.h"
+
+#include "Magnum/DartIntegration/Test/common.h"
+
+namespace Magnum { namespace DartIntegration { namespace Test { namespace {
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+struct InstancedDrawerGLTest: GL::OpenGLTester {
+    explicit InstancedDrawerGLTest();
+
+    void draw();
+    void drawInvalidShader();
+};
+
+InstancedDrawerGLTest::InstancedDrawerGLTest() {
+    addTests({&InstancedDrawerGLTest::draw,
+              &InstancedDrawerGLTest::drawInvalidShader});
+}
+
+void InstancedDrawerGLTest::draw() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::instanced_arrays>())
+        CORRADE_SKIP(GL::Extensions::ARB::instanced_arrays::string() << "is not supported.");
+    #elif defined(MAGNUM_TARGET_GLES2)
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ANGLE::instanced_arrays>() &&
+       !GL::Context::current().isExtensionSupported<GL::Extensions::EXT::instanced_arrays>() &&
+       !GL::Context::current().isExtensionSupported<GL::Extensions::NV::instanced_arrays>())
+        CORRADE_SKIP("Required extension is not available.");
+    #endif
+
+    /* Two identical pendulums, each body having a box. The root has an
+       ellipsoid and the others a cylinder of the same aspect ratio. */
+    dart::simulation::WorldPtr world(new dart::simulation::World);
+    for(const char* name: {"pendulum1", "pendulum2"}) {
+        dart::dynamics::SkeletonPtr pendulum = dart::dynamics::Skeleton::create(name);
+        dart::dynamics::BodyNode* bn = makeRootBody(pendulum, "body1");
+        bn = addBody(pendulum, bn, "body2");
+        bn = addBody(pendulum, bn, "body3");
+        world->addSkeleton(pendulum);
+    }
+
+    Scene3D scene;
+    Object3D* obj = new Object3D{&scene};
+    Object3D* cameraObject = new Object3D{&scene};
+    SceneGraph::Camera3D camera{*cameraObject};
+
+    World dartWorld{*obj, *world};
+    CORRADE_COMPARE(dartWorld.shapeObjects().size(), 12);
+
+    Shaders::PhongGL shader{Shaders::PhongGL::Configuration{}
+        .setFlags(Shaders::PhongGL::Flag::InstancedTransformation|
+                  Shaders::PhongGL::Flag::VertexColor)};
+
+    /* All boxes, all ellipsoids and all cylinders are drawn at once */
+    InstancedDrawer drawer;
+    drawer.draw(shader, camera, dartWorld.shapeObjects());
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(drawer.drawCallCount(), 3);
+
+    /* The meshes are left drawable without instancing */
+    for(Object& dartObj: dartWorld.shapeObjects())
+        CORRADE_COMPARE(dartObj.drawData().meshes[0].instanceCount(), 1);
+
+    /* Drawing again after a refresh reuses the groups */
+    world->step();
+    dartWorld.refresh();
+    drawer.draw(shader, camera, dartWorld.shapeObjects());
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(drawer.drawCallCount(), 3);
+
+    /* With levels of detail, all objects are behind the camera so they get
+       the coarsest level, which is again shared */
+    dartWorld.setLevelOfDetailCount(3);
+    drawer.draw(shader, camera, dartWorld.shapeObjects());
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(drawer.drawCallCount(), 3);
+
+    /* Nothing to draw */
+    drawer.draw(shader, camera, nullptr);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(drawer.drawCallCount(), 0);
+}
+
+void InstancedDrawerGLTest::drawInvalidShader() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Scene3D scene;
+    SceneGraph::Camera3D camera{scene};
+    Shaders::PhongGL shader;
+
+    InstancedDrawer drawer;
+
+    Containers::String out;
+    Error redirectError{&out};
+    drawer.draw(shader, camera, nullptr);
+    CORRADE_COMPARE(out, "DartIntegration::InstancedDrawer::draw(): the shader has to have instanced transformation and vertex color enabled\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::DartIntegration::Test::InstancedDrawerGLTest)
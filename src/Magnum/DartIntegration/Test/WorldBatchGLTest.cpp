@@ -0,0 +1,464 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <dart/dynamics/BodyNode.hpp>
+#include <chrono>
+#include <thread>
+#include <assimp/defs.h> /* in assimp 3.0, version.h is missing this include for ASSIMP_API */
+#include <assimp/version.h>
+#include <dart/dynamics/Skeleton.hpp>
+#include <dart/simulation/World.hpp>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Pointer.h>
+#include <Corrade/Containers/String.h>
+#include <Corrade/Containers/StringStl.h>
+#include <Corrade/Utility/Path.h>
+#include <Magnum/GL/Mesh.h>
+#include <Magnum/GL/OpenGLTester.h>
+#include <Magnum/GL/Texture.h>
+#include <Magnum/SceneGraph/MatrixTransformation3D.h>
+#include <Magnum/SceneGraph/Object.hpp>
+#include <Magnum/SceneGraph/SceneGraph.h>
+
+#include "Magnum/DartIntegration/World.h"
+#include "Magnum/DartIntegration/WorldBatch.h"
+
+#include "Magnum/DartIntegration/Test/common.h"
+#include "Magnum/DartIntegration/Test/configure.h"
+
+#define DART_URDF (MAGNUM_DART_URDF_FOUND > 0 && DART_MAJOR_VERSION >= 6)
+#if DART_URDF
+    #if DART_MAJOR_VERSION == 6
+        #include <dart/utils/urdf/urdf.hpp>
+    #else
+        #include <dart/io/urdf/urdf.hpp>
+    #endif
+#endif
+
+namespace Magnum { namespace DartIntegration { namespace Test { namespace {
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+struct WorldBatchGLTest: GL::OpenGLTester {
+    explicit WorldBatchGLTest();
+
+    void construct();
+    void constructCopy();
+
+    void addRemoveWorlds();
+    void stepRefresh();
+    void refreshSelected();
+    void refreshStructureChange();
+    #if DART_URDF
+    void shareDrawData();
+    void asyncImport();
+    #endif
+
+    void stepSimulationRunning();
+    void notInBatch();
+};
+
+const struct {
+    const char* name;
+    UnsignedInt threadCount;
+} StepRefreshData[]{
+    {"", 1},
+    {"three threads", 3},
+};
+
+WorldBatchGLTest::WorldBatchGLTest() {
+    addTests({&WorldBatchGLTest::construct,
+              &WorldBatchGLTest::constructCopy,
+
+              &WorldBatchGLTest::addRemoveWorlds});
+
+    addInstancedTests({&WorldBatchGLTest::stepRefresh},
+        Containers::arraySize(StepRefreshData));
+
+    addTests({&WorldBatchGLTest::refreshSelected,
+              &WorldBatchGLTest::refreshStructureChange,
+              #if DART_URDF
+              &WorldBatchGLTest::shareDrawData,
+              &WorldBatchGLTest::asyncImport,
+              #endif
+
+              &WorldBatchGLTest::stepSimulationRunning,
+              &WorldBatchGLTest::notInBatch});
+}
+
+using namespace Math::Literals;
+
+/* Each world has two pendulums with two bodies each, tilted differently for
+   each world */
+dart::simulation::WorldPtr pendulumWorld(std::size_t id) {
+    dart::simulation::WorldPtr world(new dart::simulation::World);
+    for(std::size_t i = 0; i != 2; ++i) {
+        dart::dynamics::SkeletonPtr pendulum = dart::dynamics::Skeleton::create("pendulum" + std::to_string(i));
+        dart::dynamics::BodyNode* bn = makeRootBody(pendulum, "body1");
+        addBody(pendulum, bn, "body2");
+        pendulum->getDof(1)->setPosition(Double(Radd(10.0_deg*Double(id*2 + i + 1))));
+        world->addSkeleton(pendulum);
+    }
+    return world;
+}
+
+Matrix4 dartTransformation(dart::dynamics::ShapeNode& shape) {
+    Eigen::Isometry3d trans = shape.getTransform();
+    Eigen::AngleAxisd R = Eigen::AngleAxisd(trans.linear());
+    Eigen::Vector3d axis = R.axis();
+    Eigen::Vector3d T = trans.translation();
+    return Matrix4::translation(Vector3(T[0], T[1], T[2]))*
+        Matrix4::rotation(Rad(R.angle()), Vector3(axis(0), axis(1), axis(2)));
+}
+
+dart::dynamics::ShapeNode& lastShape(dart::simulation::World& world, std::size_t skeleton) {
+    dart::dynamics::BodyNode* bn = world.getSkeleton(skeleton)->getBodyNode(1);
+    return *bn->getShapeNodesWith<dart::dynamics::VisualAspect>().back();
+}
+
+void WorldBatchGLTest::construct() {
+    WorldBatch batch;
+    CORRADE_COMPARE(batch.threadCount(), 1);
+    CORRADE_VERIFY(batch.worlds().isEmpty());
+
+    /* Stepping and refreshing an empty batch does nothing */
+    batch.step();
+    batch.refresh();
+
+    batch.setThreadCount(3);
+    CORRADE_COMPARE(batch.threadCount(), 3);
+    batch.setThreadCount(0);
+    CORRADE_VERIFY(batch.threadCount() >= 1);
+}
+
+void WorldBatchGLTest::constructCopy() {
+    CORRADE_VERIFY(!std::is_constructible<WorldBatch, const WorldBatch&>{});
+    CORRADE_VERIFY(!std::is_constructible<WorldBatch, WorldBatch&&>{});
+    CORRADE_VERIFY(!std::is_assignable<WorldBatch, const WorldBatch&>{});
+    CORRADE_VERIFY(!std::is_assignable<WorldBatch, WorldBatch&&>{});
+}
+
+void WorldBatchGLTest::addRemoveWorlds() {
+    dart::simulation::WorldPtr world1 = pendulumWorld(0);
+    dart::simulation::WorldPtr world2 = pendulumWorld(1);
+    dart::simulation::WorldPtr world3 = pendulumWorld(2);
+
+    Scene3D scene;
+    Object3D* obj = new Object3D{&scene};
+
+    WorldBatch batch;
+    Containers::Pointer<World> a{InPlaceInit, batch, *obj, *world1};
+    Containers::Pointer<World> b{InPlaceInit, batch, *obj, *world2};
+    World c{batch, *obj, *world3};
+    CORRADE_COMPARE(a->batch(), &batch);
+    CORRADE_COMPARE(b->batch(), &batch);
+    CORRADE_COMPARE(c.batch(), &batch);
+
+    /* The initial refresh is done in the constructor as usual */
+    CORRADE_COMPARE(a->objects().size(), 12);
+
+    CORRADE_COMPARE(batch.worlds().size(), 3);
+    CORRADE_COMPARE(&*batch.worlds()[0], a.get());
+    CORRADE_COMPARE(&*batch.worlds()[1], b.get());
+    CORRADE_COMPARE(&*batch.worlds()[2], &c);
+
+    /* Removal keeps the order */
+    a = nullptr;
+    CORRADE_COMPARE(batch.worlds().size(), 2);
+    CORRADE_COMPARE(&*batch.worlds()[0], b.get());
+    CORRADE_COMPARE(&*batch.worlds()[1], &c);
+
+    /* A world outside of a batch has no batch */
+    World d{*obj, *world1};
+    CORRADE_COMPARE(d.batch(), nullptr);
+    CORRADE_COMPARE(batch.worlds().size(), 2);
+
+    b = nullptr;
+    CORRADE_COMPARE(batch.worlds().size(), 1);
+    CORRADE_COMPARE(&*batch.worlds()[0], &c);
+}
+
+void WorldBatchGLTest::stepRefresh() {
+    auto&& data = StepRefreshData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    dart::simulation::WorldPtr dartWorlds[5];
+    for(std::size_t i = 0; i != Containers::arraySize(dartWorlds); ++i)
+        dartWorlds[i] = pendulumWorld(i);
+
+    Scene3D scene;
+
+    WorldBatch batch;
+    batch.setThreadCount(data.threadCount);
+    CORRADE_COMPARE(batch.threadCount(), data.threadCount);
+
+    /* Mix worlds with and without incremental refreshes, the latter are
+       always refreshed on the calling thread */
+    Containers::Array<Containers::Pointer<World>> worlds;
+    for(std::size_t i = 0; i != Containers::arraySize(dartWorlds); ++i)
+        arrayAppend(worlds, Containers::pointer<World>(batch, *new Object3D{&scene}, *dartWorlds[i], i % 2 ? World::Flags{} : World::Flag::IncrementalRefresh));
+
+    for(int i = 0; i < 3; ++i) {
+        for(int j = 0; j < 10; ++j)
+            batch.step();
+        batch.refresh();
+
+        for(std::size_t j = 0; j != worlds.size(); ++j) {
+            CORRADE_ITERATION(i << j);
+            CORRADE_COMPARE(dartWorlds[j]->getTime(), (i + 1)*10*dartWorlds[j]->getTimeStep());
+            CORRADE_COMPARE(worlds[j]->objects().size(), 12);
+            CORRADE_VERIFY(worlds[j]->unusedObjects().empty());
+        }
+    }
+
+    for(std::size_t i = 0; i != worlds.size(); ++i) {
+        for(std::size_t j = 0; j != 2; ++j) {
+            CORRADE_ITERATION(i << j);
+            dart::dynamics::ShapeNode& shape = lastShape(*dartWorlds[i], j);
+            CORRADE_COMPARE(worlds[i]->objectFromDartFrame(&shape).object().absoluteTransformationMatrix(), dartTransformation(shape));
+        }
+    }
+}
+
+void WorldBatchGLTest::refreshSelected() {
+    dart::simulation::WorldPtr world1 = pendulumWorld(0);
+    dart::simulation::WorldPtr world2 = pendulumWorld(1);
+
+    Scene3D scene;
+
+    WorldBatch batch;
+    batch.setThreadCount(2);
+    World a{batch, *new Object3D{&scene}, *world1, World::Flag::IncrementalRefresh};
+    World b{batch, *new Object3D{&scene}, *world2, World::Flag::IncrementalRefresh};
+
+    dart::dynamics::ShapeNode& shapeA = lastShape(*world1, 0);
+    dart::dynamics::ShapeNode& shapeB = lastShape(*world2, 0);
+    const Matrix4 initialB = b.objectFromDartFrame(&shapeB).object().absoluteTransformationMatrix();
+
+    /* Both worlds get stepped but only the first refreshed */
+    for(int i = 0; i < 10; ++i)
+        batch.step();
+    const Containers::Reference<World> selected[]{a};
+    batch.refresh(selected);
+    CORRADE_VERIFY(world2->getTime() > 0.0);
+    CORRADE_COMPARE(a.objectFromDartFrame(&shapeA).object().absoluteTransformationMatrix(), dartTransformation(shapeA));
+    CORRADE_COMPARE(b.objectFromDartFrame(&shapeB).object().absoluteTransformationMatrix(), initialB);
+    CORRADE_VERIFY(initialB != dartTransformation(shapeB));
+
+    /* Stepping just the second world */
+    const double timeA = world1->getTime();
+    const Containers::Reference<World> second[]{b};
+    batch.step(second);
+    batch.refresh(second);
+    CORRADE_COMPARE(world1->getTime(), timeA);
+    CORRADE_COMPARE(b.objectFromDartFrame(&shapeB).object().absoluteTransformationMatrix(), dartTransformation(shapeB));
+}
+
+void WorldBatchGLTest::refreshStructureChange() {
+    dart::simulation::WorldPtr world1 = pendulumWorld(0);
+    dart::simulation::WorldPtr world2 = pendulumWorld(1);
+
+    Scene3D scene;
+
+    WorldBatch batch;
+    batch.setThreadCount(2);
+    World a{batch, *new Object3D{&scene}, *world1, World::Flag::IncrementalRefresh};
+    World b{batch, *new Object3D{&scene}, *world2, World::Flag::IncrementalRefresh};
+    CORRADE_COMPARE(a.objects().size(), 12);
+    CORRADE_COMPARE(b.objects().size(), 12);
+
+    /* A structure change in one world makes it do a full walk, while the
+       other is still refreshed in parallel */
+    dart::dynamics::SkeletonPtr removed = world1->getSkeleton(1);
+    world1->removeSkeleton(removed);
+    batch.step();
+    batch.refresh();
+    CORRADE_COMPARE(a.objects().size(), 6);
+    CORRADE_COMPARE(a.unusedObjects().size(), 6);
+    CORRADE_COMPARE(b.objects().size(), 12);
+    CORRADE_VERIFY(b.unusedObjects().empty());
+
+    /* Adding it back reuses the primitive meshes shared by both worlds */
+    world1->addSkeleton(removed);
+    batch.refresh();
+    CORRADE_COMPARE(a.objects().size(), 12);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    dart::dynamics::ShapeNode& shapeA = lastShape(*world1, 0);
+    dart::dynamics::ShapeNode& shapeB = lastShape(*world2, 0);
+    CORRADE_COMPARE(a.objectFromDartFrame(&shapeA).object().absoluteTransformationMatrix(), dartTransformation(shapeA));
+    CORRADE_COMPARE(b.objectFromDartFrame(&shapeB).object().absoluteTransformationMatrix(), dartTransformation(shapeB));
+}
+
+#if DART_URDF
+void WorldBatchGLTest::shareDrawData() {
+    #if DART_MAJOR_VERSION == 6
+    dart::utils::DartLoader loader;
+    #else
+    dart::io::DartLoader loader;
+    #endif
+
+    /* The same robot in two worlds */
+    const std::string filename = Utility::Path::join(DARTINTEGRATION_TEST_DIR, "urdf/test.urdf");
+    auto skel1 = loader.parseSkeleton(filename);
+    auto skel2 = loader.parseSkeleton(filename);
+    CORRADE_VERIFY(skel1);
+    CORRADE_VERIFY(skel2);
+
+    dart::simulation::WorldPtr world1(new dart::simulation::World);
+    dart::simulation::WorldPtr world2(new dart::simulation::World);
+    world1->addSkeleton(skel1);
+    world2->addSkeleton(skel2);
+
+    Scene3D scene;
+    Object3D* obj = new Object3D{&scene};
+
+    WorldBatch batch;
+    World a{batch, *obj, *world1, World::Flag::ShareDrawData};
+    World b{batch, *obj, *world2, World::Flag::ShareDrawData};
+    CORRADE_VERIFY(!a.shapeObjects().isEmpty());
+
+    /* The draw data instance is the same for both worlds */
+    for(std::size_t i = 0; i != skel1->getNumShapeNodes(); ++i) {
+        CORRADE_ITERATION(i);
+        dart::dynamics::ShapeNode* shape1 = skel1->getShapeNode(i);
+        dart::dynamics::ShapeNode* shape2 = skel2->getShapeNode(i);
+        if(!shape1->has<dart::dynamics::VisualAspect>()) continue;
+
+        DrawData& data1 = a.objectFromDartFrame(shape1).drawData();
+        DrawData& data2 = b.objectFromDartFrame(shape2).drawData();
+        CORRADE_VERIFY(data1.meshes.size());
+        CORRADE_COMPARE(&data1, &data2);
+    }
+}
+
+void WorldBatchGLTest::asyncImport() {
+    const UnsignedInt assimpVersion = aiGetVersionMajor()*100 + aiGetVersionMinor();
+    if(assimpVersion < 302)
+        CORRADE_SKIP("Current version of Assimp would not work on this test.");
+
+    #if DART_MAJOR_VERSION == 6
+    dart::utils::DartLoader loader;
+    #else
+    dart::io::DartLoader loader;
+    #endif
+
+    /* A textured robot in three worlds, each importing on its own threads
+       through the plugin manager of the batch */
+    const std::string filename = Utility::Path::join(DARTINTEGRATION_TEST_DIR, "urdf/test_texture.urdf");
+    dart::simulation::WorldPtr worlds[3];
+    for(dart::simulation::WorldPtr& world: worlds) {
+        auto skel = loader.parseSkeleton(filename);
+        CORRADE_VERIFY(skel);
+        world.reset(new dart::simulation::World);
+        world->addSkeleton(skel);
+    }
+
+    Scene3D scene;
+    Object3D* obj = new Object3D{&scene};
+
+    WorldBatch batch;
+    World a{batch, *obj, *worlds[0], World::Flag::AsyncImport};
+    World b{batch, *obj, *worlds[1], World::Flag::AsyncImport};
+    World c{batch, *obj, *worlds[2], World::Flag::AsyncImport};
+    b.setImportThreadCount(2);
+
+    for(std::size_t i = 0; i != 1000 && (a.pendingImportCount() || b.pendingImportCount() || c.pendingImportCount()); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+        batch.refresh();
+    }
+    CORRADE_COMPARE(a.pendingImportCount(), 0);
+    CORRADE_COMPARE(b.pendingImportCount(), 0);
+    CORRADE_COMPARE(c.pendingImportCount(), 0);
+
+    World* batchWorlds[]{&a, &b, &c};
+    for(std::size_t i = 0; i != Containers::arraySize(batchWorlds); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(batchWorlds[i]->shapeObjects().size(), 1);
+        Object& dartObj = batchWorlds[i]->shapeObjects()[0];
+        CORRADE_VERIFY(!dartObj.isLoading());
+        DrawData& data = dartObj.drawData();
+        CORRADE_VERIFY(data.meshes.size());
+        CORRADE_COMPARE(data.textures.size(), 1);
+        CORRADE_VERIFY(data.textures[0]);
+    }
+}
+#endif
+
+void WorldBatchGLTest::stepSimulationRunning() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    dart::simulation::WorldPtr world1 = pendulumWorld(0);
+    dart::simulation::WorldPtr world2 = pendulumWorld(1);
+
+    Scene3D scene;
+    Object3D* obj = new Object3D{&scene};
+
+    WorldBatch batch;
+    World a{batch, *obj, *world1};
+    World b{batch, *obj, *world2};
+    b.startSimulation();
+
+    Containers::String out;
+    {
+        Error redirectError{&out};
+        batch.step();
+    }
+    b.stopSimulation();
+    CORRADE_COMPARE(out, "DartIntegration::WorldBatch::step(): the simulation thread of world 1 is running\n");
+}
+
+void WorldBatchGLTest::notInBatch() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    dart::simulation::WorldPtr world1 = pendulumWorld(0);
+    dart::simulation::WorldPtr world2 = pendulumWorld(1);
+
+    Scene3D scene;
+    Object3D* obj = new Object3D{&scene};
+
+    WorldBatch batch;
+    WorldBatch another;
+    World a{batch, *obj, *world1};
+    World b{another, *obj, *world2};
+
+    const Containers::Reference<World> worlds[]{a, b};
+
+    Containers::String out;
+    {
+        Error redirectError{&out};
+        batch.step(worlds);
+        batch.refresh(worlds);
+    }
+    CORRADE_COMPARE(out,
+        "DartIntegration::WorldBatch::step(): world 1 is not a part of this batch\n"
+        "DartIntegration::WorldBatch::refresh(): world 1 is not a part of this batch\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::DartIntegration::Test::WorldBatchGLTest)
@@ -0,0 +1,426 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <dart/dynamics/BallJoint.hpp>
+#include <dart/dynamics/BodyNode.hpp>
+#include <dart/dynamics/BoxShape.hpp>
+#include <dart/dynamics/CylinderShape.hpp>
+#include <dart/dynamics/EllipsoidShape.hpp>
+#include <dart/dynamics/FreeJoint.hpp>
+#include <dart/dynamics/RevoluteJoint.hpp>
+#include <dart/dynamics/ShapeNode.hpp>
+#include <dart/dynamics/SoftBodyNode.hpp>
+#include <dart/dynamics/Skeleton.hpp>
+#include <dart/simulation/World.hpp>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pointer.h>
+#include <Corrade/Containers/Reference.h>
+#include <Corrade/Containers/String.h>
+#include <Corrade/Containers/StringStl.h>
+#include <Corrade/PluginManager/Manager.h>
+#include <Corrade/Utility/Path.h>
+#include <Magnum/GL/Context.h>
+#include <Magnum/GL/Extensions.h>
+#include <Magnum/GL/Framebuffer.h>
+#include <Magnum/GL/OpenGLTester.h>
+#include <Magnum/GL/Renderbuffer.h>
+#include <Magnum/GL/RenderbufferFormat.h>
+#include <Magnum/GL/Renderer.h>
+#ifndef MAGNUM_TARGET_WEBGL
+#include <Magnum/GL/TimeQuery.h>
+#endif
+#include <Magnum/SceneGraph/Camera.h>
+#include <Magnum/SceneGraph/MatrixTransformation3D.h>
+#include <Magnum/SceneGraph/Object.hpp>
+#include <Magnum/SceneGraph/SceneGraph.h>
+#include <Magnum/Shaders/PhongGL.h>
+#include <Magnum/Trade/AbstractImporter.h>
+
+#include "Magnum/DartIntegration/InstancedDrawer.h"
+#include "Magnum/DartIntegration/Object.h"
+#include "Magnum/DartIntegration/World.h"
+
+#include "Magnum/DartIntegration/Test/common.h"
+#include "Magnum/DartIntegration/Test/configure.h"
+
+#define DART_URDF (MAGNUM_DART_URDF_FOUND > 0 && DART_MAJOR_VERSION >= 6)
+#if DART_URDF
+    #if DART_MAJOR_VERSION == 6
+        #include <dart/utils/urdf/urdf.hpp>
+    #else
+        #include <dart/io/urdf/urdf.hpp>
+    #endif
+#endif
+
+namespace Magnum { namespace DartIntegration { namespace Test { namespace {
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+struct WorldGLBenchmark: GL::OpenGLTester {
+    explicit WorldGLBenchmark();
+
+    void setup();
+    void teardown();
+
+    void construct();
+    void refresh();
+    void update();
+    void extractDrawData();
+    void draw();
+    #ifndef MAGNUM_TARGET_WEBGL
+    void drawGpu();
+
+    void timeQueryBegin();
+    std::uint64_t timeQueryEnd();
+    #endif
+
+    private:
+        /* Returns false if the draw benchmarks can't run */
+        bool setupDraw(Containers::Optional<World>& world, Containers::Optional<Object3D>& cameraObject, Containers::Optional<SceneGraph::Camera3D>& camera);
+
+        PluginManager::Manager<Trade::AbstractImporter> _manager;
+        Containers::Pointer<Trade::AbstractImporter> _importer;
+        dart::simulation::WorldPtr _world;
+        Containers::Optional<Scene3D> _scene;
+        Containers::Array<dart::dynamics::ShapeNode*> _shapeNodes;
+
+        GL::Renderbuffer _color{NoCreate}, _depth{NoCreate};
+        GL::Framebuffer _framebuffer{NoCreate};
+        Containers::Optional<Shaders::PhongGL> _shader;
+        #ifndef MAGNUM_TARGET_WEBGL
+        GL::TimeQuery _timeQuery{NoCreate};
+        #endif
+};
+
+constexpr Vector2i Size{1024, 1024};
+
+enum class SceneType {
+    /* Pendulums that aren't stepped, so nothing changes between refreshes */
+    StaticPrimitives,
+    /* Swinging pendulums, transformations change on every step */
+    DynamicPrimitives,
+    /* Soft boxes, the mesh changes on every step */
+    SoftBodies,
+    /* Copies of the test URDF robot, transformations don't change */
+    StaticMeshes
+};
+
+const struct {
+    const char* name;
+    SceneType scene;
+    std::size_t count;
+    World::Flags flags;
+} SceneData[]{
+    {"static primitives", SceneType::StaticPrimitives, 100, {}},
+    {"static primitives, incremental", SceneType::StaticPrimitives, 100, World::Flag::IncrementalRefresh},
+    {"dynamic primitives", SceneType::DynamicPrimitives, 100, {}},
+    {"dynamic primitives, incremental", SceneType::DynamicPrimitives, 100, World::Flag::IncrementalRefresh},
+    {"soft bodies", SceneType::SoftBodies, 20, {}},
+    {"soft bodies, incremental", SceneType::SoftBodies, 20, World::Flag::IncrementalRefresh},
+    #if DART_URDF
+    {"static meshes", SceneType::StaticMeshes, 20, {}},
+    {"static meshes, shared draw data", SceneType::StaticMeshes, 20, World::Flag::ShareDrawData},
+    #endif
+};
+
+using namespace Math::Literals;
+
+WorldGLBenchmark::WorldGLBenchmark() {
+    addInstancedBenchmarks({&WorldGLBenchmark::construct,
+                            &WorldGLBenchmark::refresh,
+                            &WorldGLBenchmark::update,
+                            &WorldGLBenchmark::extractDrawData,
+                            &WorldGLBenchmark::draw}, 10,
+        Containers::arraySize(SceneData),
+        &WorldGLBenchmark::setup,
+        &WorldGLBenchmark::teardown);
+
+    #ifndef MAGNUM_TARGET_WEBGL
+    addCustomInstancedBenchmarks({&WorldGLBenchmark::drawGpu}, 10,
+        Containers::arraySize(SceneData),
+        &WorldGLBenchmark::setup,
+        &WorldGLBenchmark::teardown,
+        &WorldGLBenchmark::timeQueryBegin,
+        &WorldGLBenchmark::timeQueryEnd,
+        BenchmarkUnits::Nanoseconds);
+    #endif
+
+    /* Needed for the URDF meshes */
+    _importer = _manager.loadAndInstantiate("AssimpImporter");
+}
+
+void WorldGLBenchmark::setup() {
+    auto&& data = SceneData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    _world.reset(new dart::simulation::World);
+    _scene.emplace();
+
+    #if DART_URDF
+    #if DART_MAJOR_VERSION == 6
+    dart::utils::DartLoader loader;
+    #else
+    dart::io::DartLoader loader;
+    #endif
+    #endif
+
+    for(std::size_t i = 0; i != data.count; ++i) {
+        dart::dynamics::SkeletonPtr skeleton;
+        const std::string name = std::to_string(i);
+
+        if(data.scene == SceneType::StaticPrimitives ||
+           data.scene == SceneType::DynamicPrimitives) {
+            skeleton = dart::dynamics::Skeleton::create("pendulum" + name);
+            dart::dynamics::BodyNode* bn = makeRootBody(skeleton, "body1");
+            bn = addBody(skeleton, bn, "body2");
+            bn = addBody(skeleton, bn, "body3");
+            addBody(skeleton, bn, "body4");
+
+            /* Make the pendulum swing right away */
+            if(data.scene == SceneType::DynamicPrimitives) {
+                skeleton->getDof(1)->setPosition(Double(Radd(120.0_deg)));
+                skeleton->getDof(2)->setPosition(Double(Radd(20.0_deg)));
+            }
+        } else if(data.scene == SceneType::SoftBodies) {
+            skeleton = dart::dynamics::Skeleton::create("soft" + name);
+            addSoftBody<dart::dynamics::FreeJoint>(skeleton, "soft box");
+        }
+        #if DART_URDF
+        else if(data.scene == SceneType::StaticMeshes) {
+            skeleton = loader.parseSkeleton(Utility::Path::join(DARTINTEGRATION_TEST_DIR, "urdf/test.urdf"));
+            CORRADE_VERIFY(skeleton);
+            skeleton->setName("urdf" + name);
+        }
+        #endif
+        else CORRADE_INTERNAL_ASSERT_UNREACHABLE();
+
+        /* Spread the copies on a grid so they don't collide with each
+           other */
+        Eigen::Isometry3d tf(Eigen::Isometry3d::Identity());
+        tf.translation() = Eigen::Vector3d(Double(i % 10), Double(i/10), 0.0);
+        skeleton->getRootJoint()->setTransformFromParentBodyNode(tf);
+
+        _world->addSkeleton(skeleton);
+
+        for(std::size_t j = 0; j != skeleton->getNumBodyNodes(); ++j)
+            skeleton->getBodyNode(j)->eachShapeNodeWith<dart::dynamics::VisualAspect>([this](dart::dynamics::ShapeNode* node) {
+                arrayAppend(_shapeNodes, node);
+            });
+    }
+}
+
+void WorldGLBenchmark::teardown() {
+    _shader = Containers::NullOpt;
+    _framebuffer = GL::Framebuffer{NoCreate};
+    _depth = GL::Renderbuffer{NoCreate};
+    _color = GL::Renderbuffer{NoCreate};
+    _shapeNodes = nullptr;
+    _scene = Containers::NullOpt;
+    _world = nullptr;
+}
+
+void WorldGLBenchmark::construct() {
+    auto&& data = SceneData[testCaseInstanceId()];
+
+    /* The initial walk, which includes converting and uploading all shapes */
+    CORRADE_BENCHMARK(1) {
+        World world{_manager, *_scene, *_world, data.flags};
+        world.refresh();
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void WorldGLBenchmark::refresh() {
+    auto&& data = SceneData[testCaseInstanceId()];
+
+    World world{_manager, *_scene, *_world, data.flags};
+    world.refresh();
+    world.clearUpdatedShapeObjects();
+
+    /* Stepping is not measured. The static scenes are not stepped at all to
+       measure just the overhead of finding out nothing changed. */
+    if(data.scene != SceneType::StaticPrimitives &&
+       data.scene != SceneType::StaticMeshes)
+        world.step();
+
+    CORRADE_BENCHMARK(1)
+        world.refresh();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void WorldGLBenchmark::update() {
+    auto&& data = SceneData[testCaseInstanceId()];
+
+    /* Standalone objects without a World, the first update() extracts the
+       draw data, which is not measured here */
+    Object3D root{&*_scene};
+    Containers::Array<Containers::Reference<Object>> objects;
+    for(dart::dynamics::ShapeNode* node: _shapeNodes)
+        arrayAppend(objects, *new Object{*new Object3D{&root}, node});
+    for(Object& object: objects)
+        object.update(_importer.get());
+
+    if(data.scene != SceneType::StaticPrimitives &&
+       data.scene != SceneType::StaticMeshes)
+        _world->step();
+
+    CORRADE_BENCHMARK(1)
+        for(Object& object: objects)
+            object.update(_importer.get());
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void WorldGLBenchmark::extractDrawData() {
+    Object3D root{&*_scene};
+    Containers::Array<Containers::Reference<Object>> objects;
+    for(dart::dynamics::ShapeNode* node: _shapeNodes)
+        arrayAppend(objects, *new Object{*new Object3D{&root}, node});
+
+    /* The first update() converts the shape and uploads it to the GPU. The
+       transformation update is included, but it's negligible compared to
+       that. */
+    CORRADE_BENCHMARK(1)
+        for(Object& object: objects)
+            object.update(_importer.get());
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+bool WorldGLBenchmark::setupDraw(Containers::Optional<World>& world, Containers::Optional<Object3D>& cameraObject, Containers::Optional<SceneGraph::Camera3D>& camera) {
+    auto&& data = SceneData[testCaseInstanceId()];
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::instanced_arrays>())
+        return false;
+    #elif defined(MAGNUM_TARGET_GLES2)
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ANGLE::instanced_arrays>() &&
+       !GL::Context::current().isExtensionSupported<GL::Extensions::EXT::instanced_arrays>() &&
+       !GL::Context::current().isExtensionSupported<GL::Extensions::NV::instanced_arrays>())
+        return false;
+    #endif
+
+    /* Rendering offscreen so the benchmark doesn't depend on a default
+       framebuffer being present, which it isn't with a headless context */
+    _color = GL::Renderbuffer{};
+    _color.setStorage(
+        #if !defined(MAGNUM_TARGET_GLES2) || !defined(MAGNUM_TARGET_WEBGL)
+        GL::RenderbufferFormat::RGBA8,
+        #else
+        GL::RenderbufferFormat::RGBA4,
+        #endif
+        Size);
+    _depth = GL::Renderbuffer{};
+    _depth.setStorage(GL::RenderbufferFormat::DepthComponent16, Size);
+    _framebuffer = GL::Framebuffer{{{}, Size}};
+    _framebuffer
+        .attachRenderbuffer(GL::Framebuffer::ColorAttachment{0}, _color)
+        .attachRenderbuffer(GL::Framebuffer::BufferAttachment::Depth, _depth)
+        .bind();
+    GL::Renderer::enable(GL::Renderer::Feature::DepthTest);
+
+    _shader.emplace(Shaders::PhongGL::Configuration{}
+        .setFlags(Shaders::PhongGL::Flag::InstancedTransformation|
+                  Shaders::PhongGL::Flag::VertexColor));
+
+    world.emplace(_manager, *_scene, *_world, data.flags);
+    world->refresh();
+
+    /* Looking at the whole grid of copies from the front */
+    cameraObject.emplace(&*_scene);
+    cameraObject->translate({4.5f, 4.5f, 15.0f});
+    camera.emplace(*cameraObject);
+    camera->setProjectionMatrix(Matrix4::perspectiveProjection(60.0_degf, 1.0f, 0.1f, 100.0f));
+
+    return true;
+}
+
+void WorldGLBenchmark::draw() {
+    Containers::Optional<World> world;
+    Containers::Optional<Object3D> cameraObject;
+    Containers::Optional<SceneGraph::Camera3D> camera;
+    if(!setupDraw(world, cameraObject, camera))
+        CORRADE_SKIP("Instanced arrays are not supported.");
+
+    /* The first draw allocates the instance buffers, which is not measured */
+    InstancedDrawer drawer;
+    drawer.draw(*_shader, *camera, world->shapeObjects());
+
+    /* The clear is included so each iteration does the same amount of work
+       instead of the later ones being rejected by the depth test */
+    CORRADE_BENCHMARK(1) {
+        _framebuffer.clear(GL::FramebufferClear::Color|GL::FramebufferClear::Depth);
+        drawer.draw(*_shader, *camera, world->shapeObjects());
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+#ifndef MAGNUM_TARGET_WEBGL
+void WorldGLBenchmark::timeQueryBegin() {
+    _timeQuery = GL::TimeQuery{GL::TimeQuery::Target::TimeElapsed};
+    _timeQuery.begin();
+}
+
+std::uint64_t WorldGLBenchmark::timeQueryEnd() {
+    _timeQuery.end();
+    return _timeQuery.result<UnsignedLong>();
+}
+
+void WorldGLBenchmark::drawGpu() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::timer_query>())
+        CORRADE_SKIP(GL::Extensions::ARB::timer_query::string() << "is not supported.");
+    #else
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::disjoint_timer_query>())
+        CORRADE_SKIP(GL::Extensions::EXT::disjoint_timer_query::string() << "is not supported.");
+    #endif
+
+    Containers::Optional<World> world;
+    Containers::Optional<Object3D> cameraObject;
+    Containers::Optional<SceneGraph::Camera3D> camera;
+    if(!setupDraw(world, cameraObject, camera))
+        CORRADE_SKIP("Instanced arrays are not supported.");
+
+    InstancedDrawer drawer;
+    drawer.draw(*_shader, *camera, world->shapeObjects());
+
+    CORRADE_BENCHMARK(1) {
+        _framebuffer.clear(GL::FramebufferClear::Color|GL::FramebufferClear::Depth);
+        drawer.draw(*_shader, *camera, world->shapeObjects());
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+#endif
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::DartIntegration::Test::WorldGLBenchmark)
@@ -25,6 +25,8 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <chrono>
+#include <thread>
 #include <assimp/defs.h> /* in assimp 3.0, version.h is missing this include for ASSIMP_API */
 #include <assimp/version.h>
 #include <dart/dynamics/BallJoint.hpp>
@@ -41,9 +43,11 @@
 #include <dart/simulation/World.hpp>
 #include <Corrade/Containers/String.h>
 #include <Corrade/Containers/StringStl.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
 #include <Corrade/Utility/DebugStl.h> /* for std::string */
 #include <Corrade/Utility/Path.h>
 #include <Magnum/GL/Buffer.h>
+#include <Magnum/GL/Context.h>
 #include <Magnum/GL/Mesh.h>
 #include <Magnum/GL/OpenGLTester.h>
 #include <Magnum/GL/Texture.h>
@@ -81,6 +85,19 @@ struct DartIntegrationTest: GL::OpenGLTester {
     void urdf();
     void multiMesh();
     void texture();
+    void shareDrawData();
+    void asyncImport();
+    void asyncImportTexture();
+    void incrementalRefresh();
+    void parallelRefresh();
+    void sharedPrimitiveMeshes();
+    void levelsOfDetail();
+    void levelsOfDetailZero();
+    void simulationThread();
+    void simulationThreadStepWhileRunning();
+
+    void debugFlag();
+    void debugFlags();
 
     void simpleSimulation();
     void softSimulation();
@@ -92,9 +109,21 @@ DartIntegrationTest::DartIntegrationTest() {
               #if DART_URDF
               &DartIntegrationTest::urdf,
               &DartIntegrationTest::multiMesh,
-              &DartIntegrationTest::texture
+              &DartIntegrationTest::texture,
+              &DartIntegrationTest::shareDrawData,
+              &DartIntegrationTest::asyncImport,
+              &DartIntegrationTest::asyncImportTexture,
               #endif
-              });
+              &DartIntegrationTest::incrementalRefresh,
+              &DartIntegrationTest::parallelRefresh,
+              &DartIntegrationTest::sharedPrimitiveMeshes,
+              &DartIntegrationTest::levelsOfDetail,
+              &DartIntegrationTest::levelsOfDetailZero,
+              &DartIntegrationTest::simulationThread,
+              &DartIntegrationTest::simulationThreadStepWhileRunning,
+
+              &DartIntegrationTest::debugFlag,
+              &DartIntegrationTest::debugFlags});
 
     addBenchmarks({&DartIntegrationTest::simpleSimulation,
                    &DartIntegrationTest::softSimulation}, 3);
@@ -173,6 +202,19 @@ void DartIntegrationTest::soft() {
     auto objects = dartWorld.objects();
     CORRADE_COMPARE(objects.size(), 2);
     CORRADE_COMPARE(dartWorld.shapeObjects().size(), 1);
+
+    /* The vertex data get updated in-place, keeping the mesh */
+    Object& shapeObject = dartWorld.shapeObjects()[0];
+    const GLuint id = shapeObject.drawData().meshes[0].id();
+    const Int count = shapeObject.drawData().meshes[0].count();
+    for(int i = 0; i < 10; ++i)
+        dartWorld.step();
+    dartWorld.refresh();
+    CORRADE_VERIFY(shapeObject.hasUpdatedMesh());
+    CORRADE_COMPARE(shapeObject.drawData().meshes.size(), 1);
+    CORRADE_COMPARE(shapeObject.drawData().meshes[0].id(), id);
+    CORRADE_COMPARE(shapeObject.drawData().meshes[0].count(), count);
+    MAGNUM_VERIFY_NO_GL_ERROR();
 }
 
 #if DART_URDF
@@ -292,8 +334,528 @@ void DartIntegrationTest::texture() {
         CORRADE_VERIFY(mydata.textures[0]);
     }
 }
+
+void DartIntegrationTest::shareDrawData() {
+    #if DART_MAJOR_VERSION == 6
+    dart::utils::DartLoader loader;
+    #else
+    dart::io::DartLoader loader;
+    #endif
+
+    /* Load the same robot twice */
+    const std::string filename = Utility::Path::join(DARTINTEGRATION_TEST_DIR, "urdf/test.urdf");
+    auto skel1 = loader.parseSkeleton(filename);
+    auto skel2 = loader.parseSkeleton(filename);
+    CORRADE_VERIFY(skel1);
+    CORRADE_VERIFY(skel2);
+    skel2->setName("second");
+
+    dart::simulation::WorldPtr world(new dart::simulation::World);
+    world->addSkeleton(skel1);
+    world->addSkeleton(skel2);
+
+    Scene3D scene;
+    Object3D* obj = new Object3D{&scene};
+
+    World dartWorld{*obj, *world, World::Flag::ShareDrawData};
+    CORRADE_COMPARE(dartWorld.flags(), World::Flag::ShareDrawData);
+    CORRADE_VERIFY(!dartWorld.shapeObjects().isEmpty());
+
+    /* All objects should be reported as updated, including the ones that
+       reuse existing data */
+    CORRADE_COMPARE(dartWorld.updatedShapeObjects().size(), dartWorld.shapeObjects().size());
+
+    for(std::size_t i = 0; i != skel1->getNumShapeNodes(); ++i) {
+        CORRADE_ITERATION(i);
+        dart::dynamics::ShapeNode* shape1 = skel1->getShapeNode(i);
+        dart::dynamics::ShapeNode* shape2 = skel2->getShapeNode(i);
+        if(!shape1->has<dart::dynamics::VisualAspect>()) continue;
+        CORRADE_COMPARE(shape1->getShape()->getType(), dart::dynamics::MeshShape::getStaticType());
+
+        /* The draw data instance is the same for both */
+        DrawData& data1 = dartWorld.objectFromDartFrame(shape1).drawData();
+        DrawData& data2 = dartWorld.objectFromDartFrame(shape2).drawData();
+        CORRADE_VERIFY(data1.meshes.size());
+        CORRADE_COMPARE(&data1, &data2);
+    }
+
+    /* Without the flag, each has its own */
+    World dartWorldUnshared{*obj, *world};
+    for(std::size_t i = 0; i != skel1->getNumShapeNodes(); ++i) {
+        CORRADE_ITERATION(i);
+        dart::dynamics::ShapeNode* shape1 = skel1->getShapeNode(i);
+        dart::dynamics::ShapeNode* shape2 = skel2->getShapeNode(i);
+        if(!shape1->has<dart::dynamics::VisualAspect>()) continue;
+        CORRADE_VERIFY(&dartWorldUnshared.objectFromDartFrame(shape1).drawData() != &dartWorldUnshared.objectFromDartFrame(shape2).drawData());
+    }
+}
+
+void DartIntegrationTest::asyncImport() {
+    #if DART_MAJOR_VERSION == 6
+    dart::utils::DartLoader loader;
+    #else
+    dart::io::DartLoader loader;
+    #endif
+
+    const std::string filename = Utility::Path::join(DARTINTEGRATION_TEST_DIR, "urdf/test_multi_mesh.urdf");
+    auto tmpSkel = loader.parseSkeleton(filename);
+    CORRADE_VERIFY(tmpSkel);
+
+    dart::simulation::WorldPtr world(new dart::simulation::World);
+    world->addSkeleton(tmpSkel);
+
+    Scene3D scene;
+    Object3D* obj = new Object3D{&scene};
+
+    World dartWorld{*obj, *world, World::Flag::AsyncImport};
+    CORRADE_COMPARE(dartWorld.importThreadCount(), 1);
+    CORRADE_COMPARE(dartWorld.shapeObjects().size(), 1);
+
+    /* The constructor submitted the import. It may have finished already,
+       but the result is processed only in the next refresh(). */
+    Object& dartObj = dartWorld.shapeObjects()[0];
+    CORRADE_VERIFY(dartObj.isLoading());
+    CORRADE_COMPARE(dartWorld.pendingImportCount(), 1);
+    CORRADE_VERIFY(dartWorld.updatedShapeObjects().isEmpty());
+
+    /* The object transformation is updated even while loading */
+    CORRADE_VERIFY(dartObj.isUpdated());
+
+    /* Wait for the import to finish. Not calling step() in order to not
+       modify the DART world while the import is running. */
+    for(std::size_t i = 0; i != 1000 && dartWorld.pendingImportCount(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+        dartWorld.refresh();
+    }
+    CORRADE_COMPARE(dartWorld.pendingImportCount(), 0);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_COMPARE(dartWorld.shapeObjects().size(), 1);
+    CORRADE_VERIFY(!dartObj.isLoading());
+    CORRADE_COMPARE(dartWorld.updatedShapeObjects().size(), 1);
+    DrawData& mydata = dartObj.drawData();
+    CORRADE_COMPARE(mydata.meshes.size(), 2);
+    CORRADE_COMPARE(mydata.meshes.size(), mydata.materials.size());
+}
+
+void DartIntegrationTest::asyncImportTexture() {
+    /* Same as texture(), but with the images imported from multiple threads
+       through the shared plugin manager */
+    const UnsignedInt assimpVersion = aiGetVersionMajor()*100 + aiGetVersionMinor();
+    if(assimpVersion < 302)
+        CORRADE_SKIP("Current version of Assimp would not work on this test.");
+
+    #if DART_MAJOR_VERSION == 6
+    dart::utils::DartLoader loader;
+    #else
+    dart::io::DartLoader loader;
+    #endif
+
+    /* Load the same robot several times, so there's more than one import
+       running at the same time */
+    const std::string filename = Utility::Path::join(DARTINTEGRATION_TEST_DIR, "urdf/test_texture.urdf");
+    dart::simulation::WorldPtr world(new dart::simulation::World);
+    for(std::size_t i = 0; i != 4; ++i) {
+        auto tmpSkel = loader.parseSkeleton(filename);
+        CORRADE_VERIFY(tmpSkel);
+        world->addSkeleton(tmpSkel);
+    }
+
+    Scene3D scene;
+    Object3D* obj = new Object3D{&scene};
+
+    /* The constructor already started a single import thread, changing the
+       count recreates the threads with the jobs still queued */
+    World dartWorld{*obj, *world, World::Flag::AsyncImport};
+    dartWorld.setImportThreadCount(3);
+    CORRADE_COMPARE(dartWorld.importThreadCount(), 3);
+    CORRADE_COMPARE(dartWorld.shapeObjects().size(), 4);
+
+    for(std::size_t i = 0; i != 1000 && dartWorld.pendingImportCount(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+        dartWorld.refresh();
+    }
+    CORRADE_COMPARE(dartWorld.pendingImportCount(), 0);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_COMPARE(dartWorld.shapeObjects().size(), 4);
+    for(Object& dartObj: dartWorld.shapeObjects()) {
+        CORRADE_ITERATION(dartObj.shapeNode()->getName());
+        CORRADE_VERIFY(!dartObj.isLoading());
+        DrawData& mydata = dartObj.drawData();
+        CORRADE_VERIFY(mydata.meshes.size());
+        CORRADE_COMPARE(mydata.meshes.size(), mydata.materials.size());
+        CORRADE_COMPARE(mydata.textures.size(), 1);
+        CORRADE_VERIFY(mydata.textures[0]);
+    }
+}
 #endif
 
+void DartIntegrationTest::incrementalRefresh() {
+    dart::dynamics::SkeletonPtr pendulum = dart::dynamics::Skeleton::create("pendulum");
+    dart::dynamics::BodyNode* bn = makeRootBody(pendulum, "body1");
+    bn = addBody(pendulum, bn, "body2");
+    bn = addBody(pendulum, bn, "body3");
+    pendulum->getDof(1)->setPosition(Double(Radd(120.0_deg)));
+
+    dart::simulation::WorldPtr world(new dart::simulation::World);
+    world->addSkeleton(pendulum);
+
+    Scene3D scene;
+    Object3D* obj = new Object3D{&scene};
+
+    World dartWorld{*obj, *world};
+    CORRADE_COMPARE(dartWorld.flags(), World::Flags{});
+    std::size_t objectCount = dartWorld.objects().size();
+    CORRADE_COMPARE(objectCount, 9);
+
+    dartWorld.setFlags(World::Flag::IncrementalRefresh);
+    CORRADE_COMPARE(dartWorld.flags(), World::Flag::IncrementalRefresh);
+
+    /* The first refresh does a full walk, the following only update the
+       known objects. The transformations should be the same as with a full
+       walk. */
+    for(int i = 0; i < 3; ++i) {
+        for(int j = 0; j < 10; ++j)
+            dartWorld.step();
+        dartWorld.refresh();
+        CORRADE_COMPARE(dartWorld.objects().size(), objectCount);
+        CORRADE_VERIFY(dartWorld.unusedObjects().empty());
+    }
+
+    dart::dynamics::ShapeNode* shape = bn->getShapeNodesWith<dart::dynamics::VisualAspect>().back();
+    Eigen::Isometry3d trans = shape->getTransform();
+    Eigen::AngleAxisd R = Eigen::AngleAxisd(trans.linear());
+    Eigen::Vector3d axis = R.axis();
+    Eigen::Vector3d T = trans.translation();
+    CORRADE_COMPARE(dartWorld.objectFromDartFrame(shape).object().absoluteTransformationMatrix(),
+        Matrix4::translation(Vector3(T[0], T[1], T[2]))*
+        Matrix4::rotation(Rad(R.angle()), Vector3(axis(0), axis(1), axis(2))));
+
+    /* Adding a body is a structural change that gets picked up */
+    addBody(pendulum, bn, "body4");
+    dartWorld.refresh();
+    CORRADE_COMPARE(dartWorld.objects().size(), objectCount + 3);
+    CORRADE_VERIFY(dartWorld.unusedObjects().empty());
+
+    /* Removing a whole skeleton as well */
+    world->removeSkeleton(pendulum);
+    dartWorld.refresh();
+    CORRADE_COMPARE(dartWorld.objects().size(), 0);
+    CORRADE_COMPARE(dartWorld.unusedObjects().size(), objectCount + 3);
+
+    /* The unused list gets cleared on the next incremental refresh */
+    dartWorld.refresh();
+    CORRADE_VERIFY(dartWorld.unusedObjects().empty());
+}
+
+void DartIntegrationTest::parallelRefresh() {
+    /* Multiple independent skeletons so there's something to split among
+       the threads */
+    dart::simulation::WorldPtr world(new dart::simulation::World);
+    dart::dynamics::BodyNode* lastBodies[5];
+    for(std::size_t i = 0; i != Containers::arraySize(lastBodies); ++i) {
+        dart::dynamics::SkeletonPtr pendulum = dart::dynamics::Skeleton::create("pendulum" + std::to_string(i));
+        dart::dynamics::BodyNode* bn = makeRootBody(pendulum, "body1");
+        bn = addBody(pendulum, bn, "body2");
+        pendulum->getDof(1)->setPosition(Double(Radd(20.0_deg*Double(i + 1))));
+        world->addSkeleton(pendulum);
+        lastBodies[i] = bn;
+    }
+
+    Scene3D scene;
+    Object3D* obj = new Object3D{&scene};
+
+    World dartWorld{*obj, *world};
+    CORRADE_COMPARE(dartWorld.threadCount(), 1);
+
+    dartWorld
+        .setFlags(World::Flag::IncrementalRefresh)
+        .setThreadCount(3);
+    CORRADE_COMPARE(dartWorld.threadCount(), 3);
+
+    /* The first refresh does a full walk on the calling thread, the
+       following are parallel */
+    for(int i = 0; i < 3; ++i) {
+        for(int j = 0; j < 10; ++j)
+            dartWorld.step();
+        dartWorld.refresh();
+        CORRADE_COMPARE(dartWorld.objects().size(), 30);
+        CORRADE_VERIFY(dartWorld.unusedObjects().empty());
+    }
+
+    for(dart::dynamics::BodyNode* bn: lastBodies) {
+        CORRADE_ITERATION(bn->getSkeleton()->getName());
+        dart::dynamics::ShapeNode* shape = bn->getShapeNodesWith<dart::dynamics::VisualAspect>().back();
+        Eigen::Isometry3d trans = shape->getTransform();
+        Eigen::AngleAxisd R = Eigen::AngleAxisd(trans.linear());
+        Eigen::Vector3d axis = R.axis();
+        Eigen::Vector3d T = trans.translation();
+        CORRADE_COMPARE(dartWorld.objectFromDartFrame(shape).object().absoluteTransformationMatrix(),
+            Matrix4::translation(Vector3(T[0], T[1], T[2]))*
+            Matrix4::rotation(Rad(R.angle()), Vector3(axis(0), axis(1), axis(2))));
+    }
+
+    /* Going back to a single thread stops the workers */
+    dartWorld.setThreadCount(1);
+    CORRADE_COMPARE(dartWorld.threadCount(), 1);
+    dartWorld.step();
+    dartWorld.refresh();
+    CORRADE_COMPARE(dartWorld.objects().size(), 30);
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+/* ID of the index buffer referenced by a mesh, queried from its VAO. The
+   per-object GL::Mesh instances are always different, so this tells whether
+   they share the underlying data. */
+GLuint indexBufferId(GL::Mesh& mesh) {
+    GL::Context::current().resetState(GL::Context::State::EnterExternal);
+    glBindVertexArray(mesh.id());
+    GLint id;
+    glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &id);
+    glBindVertexArray(0);
+    GL::Context::current().resetState(GL::Context::State::ExitExternal);
+    return id;
+}
+#endif
+
+void DartIntegrationTest::sharedPrimitiveMeshes() {
+    /* Each body has a box, the root an ellipsoid and the others a cylinder
+       of the same aspect ratio */
+    dart::dynamics::SkeletonPtr pendulum = dart::dynamics::Skeleton::create("pendulum");
+    dart::dynamics::BodyNode* bn = makeRootBody(pendulum, "body1");
+    bn = addBody(pendulum, bn, "body2");
+    bn = addBody(pendulum, bn, "body3");
+
+    dart::simulation::WorldPtr world(new dart::simulation::World);
+    world->addSkeleton(pendulum);
+
+    Scene3D scene;
+    Object3D* obj = new Object3D{&scene};
+
+    World dartWorld{*obj, *world};
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* Each object has its own mesh, but the ones with the same shape
+       reference the same buffers */
+    #ifndef MAGNUM_TARGET_GLES2
+    GLuint boxBuffer{}, cylinderBuffer{};
+    std::size_t boxCount = 0, cylinderCount = 0;
+    /* CORRADE_VERIFY() returns from the lambda on failure, so it has to be
+       void */
+    auto checkShared = [&]() {
+        boxCount = cylinderCount = 0;
+        for(Object& dartObj: dartWorld.shapeObjects()) {
+            const std::string& type = dartObj.shapeNode()->getShape()->getType();
+            CORRADE_ITERATION(type);
+            DrawData& data = dartObj.drawData();
+            CORRADE_COMPARE(data.meshes.size(), 1);
+            CORRADE_VERIFY(data.meshes[0].count());
+            CORRADE_VERIFY(data.meshes[0].isIndexed());
+
+            GLuint* buffer;
+            if(type == dart::dynamics::BoxShape::getStaticType()) {
+                buffer = &boxBuffer;
+                ++boxCount;
+            } else if(type == dart::dynamics::CylinderShape::getStaticType()) {
+                buffer = &cylinderBuffer;
+                ++cylinderCount;
+            } else continue;
+
+            const GLuint id = indexBufferId(data.meshes[0]);
+            CORRADE_VERIFY(id);
+            if(!*buffer) *buffer = id;
+            else CORRADE_COMPARE(id, *buffer);
+        }
+    };
+
+    checkShared();
+    CORRADE_COMPARE(boxCount, 3);
+    CORRADE_COMPARE(cylinderCount, 2);
+    CORRADE_VERIFY(boxBuffer != cylinderBuffer);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    #endif
+
+    /* Removing the objects and adding them back reuses the cached meshes */
+    world->removeSkeleton(pendulum);
+    dartWorld.refresh();
+    CORRADE_COMPARE(dartWorld.unusedObjects().size(), 9);
+    world->addSkeleton(pendulum);
+    dartWorld.refresh();
+    CORRADE_COMPARE(dartWorld.shapeObjects().size(), 6);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* The buffers are still the same as before */
+    #ifndef MAGNUM_TARGET_GLES2
+    const GLuint previousBoxBuffer = boxBuffer;
+    const GLuint previousCylinderBuffer = cylinderBuffer;
+    checkShared();
+    CORRADE_COMPARE(boxCount, 3);
+    CORRADE_COMPARE(cylinderCount, 2);
+    CORRADE_COMPARE(boxBuffer, previousBoxBuffer);
+    CORRADE_COMPARE(cylinderBuffer, previousCylinderBuffer);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    #endif
+}
+
+void DartIntegrationTest::levelsOfDetail() {
+    /* Each body has a box, the root an ellipsoid and the other a cylinder */
+    dart::dynamics::SkeletonPtr pendulum = dart::dynamics::Skeleton::create("pendulum");
+    dart::dynamics::BodyNode* bn = makeRootBody(pendulum, "body1");
+    addBody(pendulum, bn, "body2");
+
+    dart::simulation::WorldPtr world(new dart::simulation::World);
+    world->addSkeleton(pendulum);
+
+    Scene3D scene;
+    Object3D* obj = new Object3D{&scene};
+
+    World dartWorld{*obj, *world};
+    CORRADE_COMPARE(dartWorld.levelOfDetailCount(), 1);
+    for(Object& dartObj: dartWorld.shapeObjects())
+        CORRADE_VERIFY(dartObj.drawData().levelsOfDetail.isEmpty());
+
+    /* Existing objects get updated right away */
+    dartWorld.clearUpdatedShapeObjects();
+    dartWorld.setLevelOfDetailCount(3);
+    CORRADE_COMPARE(dartWorld.levelOfDetailCount(), 3);
+    CORRADE_COMPARE(dartWorld.updatedShapeObjects().size(), 4);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    for(Object& dartObj: dartWorld.shapeObjects()) {
+        const std::string& type = dartObj.shapeNode()->getShape()->getType();
+        CORRADE_ITERATION(type);
+        DrawData& data = dartObj.drawData();
+        CORRADE_COMPARE(data.meshes.size(), 1);
+        if(type == dart::dynamics::BoxShape::getStaticType()) {
+            CORRADE_VERIFY(data.levelsOfDetail.isEmpty());
+            continue;
+        }
+
+        CORRADE_COMPARE(data.levelsOfDetail.size(), 2);
+        CORRADE_COMPARE_AS(data.levelsOfDetail[0].count(), data.meshes[0].count(), TestSuite::Compare::Less);
+        CORRADE_COMPARE_AS(data.levelsOfDetail[1].count(), data.levelsOfDetail[0].count(), TestSuite::Compare::Less);
+
+        /* Close to the camera it's the full detail, far away the coarsest,
+           behind the camera as well */
+        const Matrix4 projection = Matrix4::perspectiveProjection(60.0_degf, 1.0f, 0.01f, 1000.0f);
+        CORRADE_COMPARE(levelOfDetail(data, Matrix4::translation(Vector3::zAxis(-0.1f)), projection), 0);
+        CORRADE_COMPARE(levelOfDetail(data, Matrix4::translation(Vector3::zAxis(-500.0f)), projection), 2);
+        CORRADE_COMPARE(levelOfDetail(data, Matrix4::translation(Vector3::zAxis(1.0f)), projection), 2);
+    }
+
+    /* Going back to a single level */
+    dartWorld.setLevelOfDetailCount(1);
+    for(Object& dartObj: dartWorld.shapeObjects())
+        CORRADE_VERIFY(dartObj.drawData().levelsOfDetail.isEmpty());
+}
+
+void DartIntegrationTest::levelsOfDetailZero() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    dart::simulation::WorldPtr world(new dart::simulation::World);
+    Scene3D scene;
+    Object3D* obj = new Object3D{&scene};
+    World dartWorld{*obj, *world};
+
+    Containers::String out;
+    Error redirectError{&out};
+    dartWorld.setLevelOfDetailCount(0);
+    CORRADE_COMPARE(out, "DartIntegration::World::setLevelOfDetailCount(): expected at least one level\n");
+}
+
+void DartIntegrationTest::simulationThread() {
+    dart::dynamics::SkeletonPtr pendulum = dart::dynamics::Skeleton::create("pendulum");
+    dart::dynamics::BodyNode* bn = makeRootBody(pendulum, "body1");
+    bn = addBody(pendulum, bn, "body2");
+    pendulum->getDof(1)->setPosition(Double(Radd(120.0_deg)));
+
+    dart::simulation::WorldPtr world(new dart::simulation::World);
+    world->addSkeleton(pendulum);
+
+    Scene3D scene;
+    Object3D* obj = new Object3D{&scene};
+
+    World dartWorld{*obj, *world};
+    CORRADE_VERIFY(!dartWorld.isSimulationRunning());
+
+    dart::dynamics::ShapeNode* shape = bn->getShapeNodesWith<dart::dynamics::VisualAspect>().back();
+    const Matrix4 initial = dartWorld.objectFromDartFrame(shape).object().absoluteTransformationMatrix();
+
+    /* Run faster than real time to not have to wait long */
+    dartWorld.startSimulation(10000.0f);
+    CORRADE_VERIFY(dartWorld.isSimulationRunning());
+    CORRADE_COMPARE(dartWorld.objects().size(), 6);
+
+    /* Wait until the thread publishes a few snapshots */
+    bool moved = false;
+    for(int i = 0; i != 100 && !moved; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+        dartWorld.refresh();
+        moved = dartWorld.objectFromDartFrame(shape).object().absoluteTransformationMatrix() != initial;
+    }
+    CORRADE_VERIFY(moved);
+    CORRADE_COMPARE(dartWorld.objects().size(), 6);
+    CORRADE_VERIFY(dartWorld.unusedObjects().empty());
+
+    /* Stopping makes the world usable the usual way again */
+    dartWorld.stopSimulation();
+    CORRADE_VERIFY(!dartWorld.isSimulationRunning());
+    CORRADE_VERIFY(world->getTime() > 0.0);
+    dartWorld.step();
+    dartWorld.refresh();
+
+    Eigen::Isometry3d trans = shape->getTransform();
+    Eigen::AngleAxisd R = Eigen::AngleAxisd(trans.linear());
+    Eigen::Vector3d axis = R.axis();
+    Eigen::Vector3d T = trans.translation();
+    CORRADE_COMPARE(dartWorld.objectFromDartFrame(shape).object().absoluteTransformationMatrix(),
+        Matrix4::translation(Vector3(T[0], T[1], T[2]))*
+        Matrix4::rotation(Rad(R.angle()), Vector3(axis(0), axis(1), axis(2))));
+
+    /* Stopping again does nothing */
+    dartWorld.stopSimulation();
+    CORRADE_VERIFY(!dartWorld.isSimulationRunning());
+}
+
+void DartIntegrationTest::simulationThreadStepWhileRunning() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    dart::dynamics::SkeletonPtr pendulum = dart::dynamics::Skeleton::create("pendulum");
+    makeRootBody(pendulum, "body1");
+
+    dart::simulation::WorldPtr world(new dart::simulation::World);
+    world->addSkeleton(pendulum);
+
+    Scene3D scene;
+    Object3D* obj = new Object3D{&scene};
+
+    World dartWorld{*obj, *world};
+    dartWorld.startSimulation();
+
+    Containers::String out;
+    {
+        Error redirectError{&out};
+        dartWorld.step();
+        dartWorld.startSimulation();
+    }
+    CORRADE_COMPARE(out,
+        "DartIntegration::World::step(): the simulation thread is running\n"
+        "DartIntegration::World::startSimulation(): the simulation thread is already running\n");
+}
+
+void DartIntegrationTest::debugFlag() {
+    Containers::String out;
+    Debug{&out} << World::Flag::IncrementalRefresh << World::Flag(0xf0);
+    CORRADE_COMPARE(out, "DartIntegration::World::Flag::IncrementalRefresh DartIntegration::World::Flag(0xf0)\n");
+}
+
+void DartIntegrationTest::debugFlags() {
+    Containers::String out;
+    Debug{&out} << (World::Flag::IncrementalRefresh|World::Flag(0xf0)) << World::Flags{};
+    CORRADE_COMPARE(out, "DartIntegration::World::Flag::IncrementalRefresh|DartIntegration::World::Flag(0xf0) DartIntegration::World::Flags{}\n");
+}
+
 void DartIntegrationTest::simpleSimulation() {
     /* Create an empty Skeleton with the name "pendulum" */
     std::string name = "pendulum";
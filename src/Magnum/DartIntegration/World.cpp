@@ -27,46 +27,731 @@
 
 #include "World.h"
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
 #include <unordered_map>
-#include <unordered_set>
 #include <vector>
+#include <Corrade/Containers/EnumSet.hpp>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Reference.h>
 #include <Corrade/PluginManager/Manager.h>
+#include <dart/common/Signal.hpp>
 #include <dart/dynamics/BodyNode.hpp>
+#include <dart/dynamics/MeshShape.hpp>
 #include <dart/dynamics/ShapeNode.hpp>
+#include <dart/dynamics/Skeleton.hpp>
 #include <dart/simulation/World.hpp>
 
+#include "Magnum/instrumentationIntegration.h"
+#include "Magnum/DartIntegration/ConvertShapeNode.h"
+#include "Magnum/DartIntegration/WorldBatch.h"
+#include "Magnum/DartIntegration/Implementation/ConvertShape.h"
+#include "Magnum/DartIntegration/Implementation/WorldSharedData.h"
+
 namespace Magnum { namespace DartIntegration {
 
+namespace {
+
+/* Structure of a single skeleton at the time of the last tree walk */
+struct SkeletonStructure {
+    dart::dynamics::Skeleton* skeleton;
+    std::size_t bodyNodeCount;
+    std::size_t shapeNodeCount;
+};
+
+/* Position of an object in the dense arrays */
+struct ObjectIndex {
+    UnsignedInt object;
+    /* Index into either shapeObjects or bodyObjects */
+    UnsignedInt kind;
+};
+
+struct CalculatedTransformation {
+    Implementation::ObjectTransformation transformation;
+    /* False if DART returned NaNs */
+    bool valid;
+};
+
+/* Asynchronous import of a single shape. The shape and color are taken
+   directly so the job doesn't need to access the ShapeNode, which might get
+   destroyed in the meantime. */
+struct ImportJob {
+    std::size_t id;
+    dart::dynamics::Frame* frame;
+    dart::dynamics::ShapePtr shape;
+    Color4 color;
+    /* For Flag::ShareDrawData, empty otherwise */
+    std::string cacheKey;
+};
+
+struct ImportResult {
+    std::size_t id;
+    dart::dynamics::Frame* frame;
+    std::string cacheKey;
+    Containers::Optional<ShapeData> shapeData;
+};
+
+dart::dynamics::Frame* frameFor(Object& object) {
+    if(object.shapeNode()) return object.shapeNode();
+    return object.bodyNode();
+}
+
+/* Key for Flag::ShareDrawData, containing everything convertShapeNode()
+   depends on for a MeshShape. Empty if the shape can't be shared. */
+std::string drawDataCacheKey(dart::dynamics::ShapeNode& shapeNode) {
+    const dart::dynamics::ShapePtr& shape = shapeNode.getShape();
+    if(shape->getType() != dart::dynamics::MeshShape::getStaticType() ||
+       shape->getDataVariance() != dart::dynamics::Shape::DataVariance::STATIC)
+        return {};
+
+    const dart::dynamics::MeshShape& meshShape = static_cast<const dart::dynamics::MeshShape&>(*shape);
+
+    /* Meshes not coming from a file can't be matched */
+    std::string key = meshShape.getMeshPath();
+    if(key.empty()) return key;
+
+    /* The rest has a fixed size so there's no need for any delimiters. The
+       shape color is used as a fallback for material-less meshes even in
+       other color modes, so it's included always. */
+    const Eigen::Vector3d scale = meshShape.getScale();
+    const Eigen::Vector4d color = shapeNode.getVisualAspect()->getRGBA();
+    const Int colorMode = Int(meshShape.getColorMode());
+    const Int colorIndex = meshShape.getColorIndex();
+    key.append(reinterpret_cast<const char*>(scale.data()), sizeof(Double)*3);
+    key.append(reinterpret_cast<const char*>(color.data()), sizeof(Double)*4);
+    key.append(reinterpret_cast<const char*>(&colorMode), sizeof(Int));
+    key.append(reinterpret_cast<const char*>(&colorIndex), sizeof(Int));
+    return key;
+}
+
+}
+
 struct World::State {
     State(SceneGraph::AbstractBasicObject3D<Float>& object, dart::simulation::World& dartWorld): object(object), dartWorld(dartWorld) {}
 
+    ~State() {
+        stopSimulation();
+        stopImporters();
+        stopWorkers();
+        for(dart::common::Connection& connection: structuralChangeConnections)
+            connection.disconnect();
+        for(Object& object: objects)
+            delete &object;
+    }
+
+    Object& add(dart::dynamics::Frame* frame, std::unique_ptr<Object> object);
+    std::unique_ptr<Object> remove(UnsignedInt index);
+    void markUpdated(Object& object);
+
+    void calculateSkeletonTransformations(std::size_t skeleton);
+    void calculateTransformations();
+    void calculateTransformationsParallel();
+    void applyCalculatedTransformations();
+    void workerLoop();
+    void stopWorkers();
+
+    void importerLoop(Trade::AbstractImporter& importer);
+    void startImporters();
+    void submitImport(Object& object, dart::dynamics::ShapeNode& shapeNode, std::string&& cacheKey);
+    void finishImports();
+    void stopImporters();
+
+    void simulationLoop();
+    void stopSimulation();
+    void resetSnapshots();
+    void applySnapshot();
+
     SceneGraph::AbstractBasicObject3D<Float>& object;
-    Containers::Optional<PluginManager::Manager<Trade::AbstractImporter>> managerStorage;
-    PluginManager::Manager<Trade::AbstractImporter>* manager;
-    Containers::Pointer<Trade::AbstractImporter> importer;
+    /* Importer and caches, either sharedStorage or owned by the batch. The
+       objects reference entries in the caches, so they're deleted in the
+       destructor body before the storage goes away. */
+    Containers::Optional<Implementation::WorldSharedData> sharedStorage;
+    Implementation::WorldSharedData* shared;
+    WorldBatch* batch{};
     dart::simulation::World& dartWorld;
-    std::unordered_map<dart::dynamics::Frame*, std::unique_ptr<Object>> dartToMagnum;
+    /* All objects owned by the world, densely packed, plus their split into
+       ones with and without a shape. Removal swaps the last element into
+       the hole, the Object instances themselves stay at stable addresses as
+       SceneGraph keeps pointers to them. */
+    Containers::Array<Containers::Reference<Object>> objects;
+    Containers::Array<Containers::Reference<Object>> shapeObjects;
+    Containers::Array<Containers::Reference<Object>> bodyObjects;
+    std::unordered_map<dart::dynamics::Frame*, ObjectIndex> frameToObject;
     std::vector<std::unique_ptr<Object>> toRemove;
-    std::unordered_set<Object*> updatedShapeObjects;
+    /* Appended to at most once per object, the position is stored in the
+       object itself. Removal swaps the last element into the hole. */
+    Containers::Array<Containers::Reference<Object>> updatedShapeObjects;
+    /* Meshes point to shared->primitiveMeshes */
+    Implementation::PrimitiveMeshCache primitiveMeshCache;
+
+    World::Flags flags;
+    /* Set by the BodyNode structural change signals, by refreshStructure()
+       and if an object failed to update. Starts as true so the first
+       incremental refresh does a full walk. */
+    bool structureChanged = true;
+    /* Snapshot of the skeleton structure, filled only with
+       Flag::IncrementalRefresh or with the simulation thread running */
+    std::vector<SkeletonStructure> skeletonStructure;
+    std::vector<dart::common::Connection> structuralChangeConnections;
+
+    /* Objects grouped by skeleton, with skeletonObjectOffsets having one
+       more item than there's skeletons. Filled only with
+       Flag::IncrementalRefresh or with the simulation thread running, used
+       by the parallel refresh and the simulation thread. */
+    std::vector<Object*> skeletonObjects;
+    std::vector<std::size_t> skeletonObjectOffsets;
+    std::vector<CalculatedTransformation> calculatedTransformations;
+
+    /* Worker threads for the parallel refresh, the calling thread is used as
+       well so there's always threadCount - 1 of them */
+    UnsignedInt threadCount = 1;
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable workAvailable, workDone;
+    std::size_t generation = 0;
+    std::size_t busyWorkers = 0;
+    bool quit = false;
+    std::atomic<std::size_t> nextSkeleton{0};
+
+    /* Import threads for Flag::AsyncImport, each with its own importer
+       instance. The results are processed on the calling thread. */
+    UnsignedInt importThreadCount = 1;
+    std::vector<std::thread> importThreads;
+    std::vector<Containers::Pointer<Trade::AbstractImporter>> importThreadImporters;
+    std::mutex importMutex;
+    std::condition_variable importAvailable;
+    std::deque<ImportJob> importQueue;
+    std::vector<ImportResult> importResults;
+    bool importQuit = false;
+    std::size_t nextImportJob = 1;
+    std::size_t pendingImports = 0;
+
+    /* Simulation thread. It holds the mutex while stepping, the calling
+       thread locks it only if it needs to touch the DART world. The
+       transformations are passed through a triple buffer, snapshotFront
+       being used only by the calling thread, snapshotBack only by the
+       simulation thread and snapshotReady exchanged between the two, with
+       NewSnapshot set if the simulation thread published a snapshot that
+       wasn't consumed yet. */
+    enum: UnsignedInt { NewSnapshot = 1 << 2 };
+    bool simulating = false;
+    std::thread simulationThread;
+    std::mutex simulationMutex;
+    std::atomic<bool> simulationQuit{false};
+    std::chrono::steady_clock::duration simulationPeriod;
+    std::vector<CalculatedTransformation> snapshots[3];
+    UnsignedInt snapshotFront = 0;
+    UnsignedInt snapshotBack = 2;
+    std::atomic<UnsignedInt> snapshotReady{1};
 };
 
-World::World(PluginManager::Manager<Trade::AbstractImporter>* manager, SceneGraph::AbstractBasicObject3D<Float>& object, dart::simulation::World& world): _state{new State{object, world}} {
-    /* If the manager is not passed from outside, maintain our own instance */
-    if(!manager) {
-        _state->managerStorage.emplace();
-        _state->manager = &*_state->managerStorage;
-    } else _state->manager = manager;
+Object& World::State::add(dart::dynamics::Frame* const frame, std::unique_ptr<Object> object) {
+    Object& out = *object.release();
+    Containers::Array<Containers::Reference<Object>>& kindObjects = out.shapeNode() ? shapeObjects : bodyObjects;
+    frameToObject.emplace(frame, ObjectIndex{UnsignedInt(objects.size()), UnsignedInt(kindObjects.size())});
+    arrayAppend(objects, out);
+    arrayAppend(kindObjects, out);
+    return out;
+}
+
+std::unique_ptr<Object> World::State::remove(const UnsignedInt index) {
+    Object& object = objects[index];
+    auto found = frameToObject.find(frameFor(object));
+    const ObjectIndex objectIndex = found->second;
+    frameToObject.erase(found);
+
+    /* Move the last object into the hole and update its index */
+    Object& last = objects.back();
+    if(&last != &object) {
+        objects[index] = last;
+        frameToObject.at(frameFor(last)).object = index;
+    }
+    arrayRemoveSuffix(objects);
+
+    Containers::Array<Containers::Reference<Object>>& kindObjects = object.shapeNode() ? shapeObjects : bodyObjects;
+    Object& lastKind = kindObjects.back();
+    if(&lastKind != &object) {
+        kindObjects[objectIndex.kind] = lastKind;
+        frameToObject.at(frameFor(lastKind)).kind = objectIndex.kind;
+    }
+    arrayRemoveSuffix(kindObjects);
+
+    /* The object is going to be deleted, so it can't stay in the updated
+       list */
+    if(object._updatedShapeObjectIndex != ~UnsignedInt{}) {
+        Object& lastUpdated = updatedShapeObjects.back();
+        if(&lastUpdated != &object) {
+            updatedShapeObjects[object._updatedShapeObjectIndex] = lastUpdated;
+            lastUpdated._updatedShapeObjectIndex = object._updatedShapeObjectIndex;
+        }
+        arrayRemoveSuffix(updatedShapeObjects);
+        object._updatedShapeObjectIndex = ~UnsignedInt{};
+    }
+
+    return std::unique_ptr<Object>{&object};
+}
+
+void World::State::markUpdated(Object& object) {
+    if(object._updatedShapeObjectIndex != ~UnsignedInt{}) return;
+    object._updatedShapeObjectIndex = UnsignedInt(updatedShapeObjects.size());
+    arrayAppend(updatedShapeObjects, object);
+}
+
+void World::State::calculateSkeletonTransformations(const std::size_t skeleton) {
+    for(std::size_t i = skeletonObjectOffsets[skeleton], end = skeletonObjectOffsets[skeleton + 1]; i != end; ++i) {
+        CalculatedTransformation& calculated = calculatedTransformations[i];
+        calculated.valid = skeletonObjects[i]->calculateTransformation(calculated.transformation);
+    }
+}
+
+void World::State::calculateTransformations() {
+    /* Each skeleton is processed by just one thread, as DART lazily updates
+       joint transformations on access */
+    const std::size_t skeletonCount = skeletonObjectOffsets.size() - 1;
+    for(std::size_t skeleton; (skeleton = nextSkeleton.fetch_add(1, std::memory_order_relaxed)) < skeletonCount; )
+        calculateSkeletonTransformations(skeleton);
+}
+
+void World::State::calculateTransformationsParallel() {
+    nextSkeleton.store(0, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        busyWorkers = workers.size();
+        ++generation;
+    }
+    workAvailable.notify_all();
 
-    /* Load Assimp importer */
-    _state->importer = _state->manager->loadAndInstantiate("AssimpImporter");
+    /* Help with the work on the calling thread as well, then wait for the
+       workers to finish */
+    calculateTransformations();
+    std::unique_lock<std::mutex> lock{mutex};
+    workDone.wait(lock, [this]{ return busyWorkers == 0; });
 }
 
-World::~World() = default;
+void World::State::applyCalculatedTransformations() {
+    for(std::size_t i = 0; i != skeletonObjects.size(); ++i) {
+        Object& object = *skeletonObjects[i];
+        const CalculatedTransformation& calculated = calculatedTransformations[i];
+        object.clearUpdateFlag();
+        object.applyUpdate(shared->importer.get(), &primitiveMeshCache, calculated.valid ? &calculated.transformation : nullptr);
+        if(object.shapeNode() && object.hasUpdatedMesh())
+            markUpdated(object);
+        if(!object.isUpdated())
+            structureChanged = true;
+    }
+}
+
+void World::State::workerLoop() {
+    std::size_t seenGeneration = 0;
+    for(;;) {
+        {
+            std::unique_lock<std::mutex> lock{mutex};
+            workAvailable.wait(lock, [&]{ return quit || generation != seenGeneration; });
+            if(quit) return;
+            seenGeneration = generation;
+        }
+
+        calculateTransformations();
+
+        std::lock_guard<std::mutex> lock{mutex};
+        if(--busyWorkers == 0) workDone.notify_one();
+    }
+}
+
+void World::State::stopWorkers() {
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        quit = true;
+    }
+    workAvailable.notify_all();
+    for(std::thread& worker: workers) worker.join();
+    workers.clear();
+    quit = false;
+}
+
+void World::State::simulationLoop() {
+    std::chrono::steady_clock::time_point next = std::chrono::steady_clock::now();
+    while(!simulationQuit.load(std::memory_order_relaxed)) {
+        {
+            std::lock_guard<std::mutex> lock{simulationMutex};
+            dartWorld.step();
+
+            std::vector<CalculatedTransformation>& snapshot = snapshots[snapshotBack];
+            for(std::size_t i = 0; i != skeletonObjects.size(); ++i)
+                snapshot[i].valid = skeletonObjects[i]->calculateTransformation(snapshot[i].transformation);
+
+            snapshotBack = snapshotReady.exchange(snapshotBack|NewSnapshot, std::memory_order_acq_rel) & ~NewSnapshot;
+        }
+
+        /* If the simulation can't keep up, continue right away but don't try
+           to catch up with the lost steps */
+        next += simulationPeriod;
+        const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        if(next < now) next = now;
+        else std::this_thread::sleep_until(next);
+    }
+}
+
+void World::State::stopSimulation() {
+    if(!simulating) return;
+    simulationQuit.store(true, std::memory_order_relaxed);
+    simulationThread.join();
+    simulationQuit.store(false, std::memory_order_relaxed);
+    simulating = false;
+}
+
+void World::State::resetSnapshots() {
+    /* Called with the simulation thread paused. Any snapshot that wasn't
+       consumed yet is for the previous structure, so it gets dropped. */
+    for(std::vector<CalculatedTransformation>& snapshot: snapshots)
+        snapshot.resize(skeletonObjects.size());
+    snapshotFront = 0;
+    snapshotBack = 2;
+    snapshotReady.store(1, std::memory_order_release);
+}
+
+void World::State::applySnapshot() {
+    /* Nothing changed in the DART world since the last time */
+    if(!(snapshotReady.load(std::memory_order_acquire) & NewSnapshot))
+        return;
+    snapshotFront = snapshotReady.exchange(snapshotFront, std::memory_order_acq_rel) & ~NewSnapshot;
+
+    /* Shape data such as soft body meshes are read from DART directly, so
+       they can be updated only if the simulation thread isn't in the middle
+       of a step. Otherwise they're updated next time. */
+    std::unique_lock<std::mutex> lock{simulationMutex, std::try_to_lock};
+
+    const std::vector<CalculatedTransformation>& snapshot = snapshots[snapshotFront];
+    for(std::size_t i = 0; i != skeletonObjects.size(); ++i) {
+        Object& object = *skeletonObjects[i];
+        const CalculatedTransformation& calculated = snapshot[i];
+        object.clearUpdateFlag();
+        if(lock.owns_lock()) {
+            object.applyUpdate(shared->importer.get(), &primitiveMeshCache, calculated.valid ? &calculated.transformation : nullptr);
+            if(object.shapeNode() && object.hasUpdatedMesh())
+                markUpdated(object);
+        } else {
+            object._updatedMesh = false;
+            object.applyTransformation(calculated.valid ? &calculated.transformation : nullptr);
+        }
+        if(!object.isUpdated())
+            structureChanged = true;
+    }
+}
+
+void World::State::importerLoop(Trade::AbstractImporter& importer) {
+    for(;;) {
+        ImportJob job;
+        {
+            std::unique_lock<std::mutex> lock{importMutex};
+            importAvailable.wait(lock, [this]{ return importQuit || !importQueue.empty(); });
+            if(importQuit) return;
+            job = std::move(importQueue.front());
+            importQueue.pop_front();
+        }
+
+        ImportResult result{job.id, job.frame, std::move(job.cacheKey),
+            Implementation::convertShape(job.shape, job.color, ConvertShapeType::All, 0, &importer, &shared->managerMutex)};
+
+        std::lock_guard<std::mutex> lock{importMutex};
+        importResults.push_back(std::move(result));
+    }
+}
+
+void World::State::startImporters() {
+    UnsignedInt count = importThreadCount;
+    if(!count) {
+        count = std::thread::hardware_concurrency();
+        /* Can return 0 if the value is not computable */
+        if(!count) count = 1;
+    }
+
+    for(UnsignedInt i = 0; i != count; ++i) {
+        /* Plugin instantiation is not thread-safe, so it's done here and
+           not in the threads. The manager may be shared with import threads
+           of other worlds in a batch, which could be loading images through
+           it at the moment. */
+        Containers::Pointer<Trade::AbstractImporter> importer;
+        {
+            std::lock_guard<std::mutex> lock{shared->managerMutex};
+            importer = shared->manager->instantiate("AssimpImporter");
+        }
+        Trade::AbstractImporter* const importerPointer = importer.get();
+        importThreadImporters.push_back(std::move(importer));
+        importThreads.emplace_back([this, importerPointer]{ importerLoop(*importerPointer); });
+    }
+}
+
+void World::State::submitImport(Object& object, dart::dynamics::ShapeNode& shapeNode, std::string&& cacheKey) {
+    /* Create the threads on first use */
+    if(importThreads.empty()) startImporters();
+
+    const Eigen::Vector4d color = shapeNode.getVisualAspect()->getRGBA();
+    object._loading = true;
+    object._loadingJob = nextImportJob;
+    {
+        std::lock_guard<std::mutex> lock{importMutex};
+        importQueue.push_back(ImportJob{nextImportJob++, &shapeNode, shapeNode.getShape(), Color4(color(0), color(1), color(2), color(3)), std::move(cacheKey)});
+    }
+    ++pendingImports;
+    importAvailable.notify_one();
+}
+
+void World::State::finishImports() {
+    std::vector<ImportResult> results;
+    {
+        std::lock_guard<std::mutex> lock{importMutex};
+        std::swap(results, importResults);
+    }
+
+    for(ImportResult& result: results) {
+        --pendingImports;
+
+        /* Discard results for objects that got removed or recreated in the
+           meantime */
+        auto found = frameToObject.find(result.frame);
+        if(found == frameToObject.end()) continue;
+        Object& object = objects[found->second.object];
+        if(!object._loading || object._loadingJob != result.id) continue;
+
+        /* Same as a failed synchronous import, except that the object is
+           removed right away and not after the next tree walk */
+        if(!result.shapeData) {
+            object._loading = false;
+            toRemove.push_back(remove(found->second.object));
+            structureChanged = true;
+            continue;
+        }
+
+        /* If an import of the same shape finished earlier, reuse its data */
+        if(!result.cacheKey.empty()) {
+            auto cached = shared->drawDataCache.find(result.cacheKey);
+            if(cached != shared->drawDataCache.end() && (object._drawData = cached->second.lock())) {
+                object._loading = false;
+                markUpdated(object);
+                continue;
+            }
+        }
+
+        object.finishLoading(*result.shapeData);
+        markUpdated(object);
+        if(!result.cacheKey.empty())
+            shared->drawDataCache[result.cacheKey] = object._drawData;
+    }
+}
+
+void World::State::stopImporters() {
+    {
+        std::lock_guard<std::mutex> lock{importMutex};
+        importQuit = true;
+    }
+    importAvailable.notify_all();
+    for(std::thread& thread: importThreads) thread.join();
+    importThreads.clear();
+    {
+        /* Destroying the instances unregisters them from the manager */
+        std::lock_guard<std::mutex> lock{shared->managerMutex};
+        importThreadImporters.clear();
+    }
+    importQuit = false;
+
+    /* Jobs that didn't get processed yet stay in the queue for the next
+       threads */
+}
+
+World::World(PluginManager::Manager<Trade::AbstractImporter>* manager, WorldBatch* batch, SceneGraph::AbstractBasicObject3D<Float>& object, dart::simulation::World& world, const Flags flags): _state{new State{object, world}} {
+    _state->flags = flags;
+
+    /* Use the importer and caches of the batch, if there's any */
+    if(batch) {
+        _state->shared = &batch->shared();
+        _state->batch = batch;
+        batch->addWorld(*this);
+    } else {
+        _state->sharedStorage.emplace(manager);
+        _state->shared = &*_state->sharedStorage;
+    }
+    _state->primitiveMeshCache.meshes = &_state->shared->primitiveMeshes;
+    _state->primitiveMeshCache.managerMutex = &_state->shared->managerMutex;
+}
+
+World::~World() {
+    if(_state->batch) _state->batch->removeWorld(*this);
+}
+
+World::Flags World::flags() const { return _state->flags; }
+
+World& World::setFlags(const Flags flags) {
+    /* Enabling incremental refresh needs a full walk first to populate the
+       flat object list and connect the structural change signals */
+    if((flags & Flag::IncrementalRefresh) && !(_state->flags & Flag::IncrementalRefresh))
+        _state->structureChanged = true;
+    _state->flags = flags;
+    return *this;
+}
+
+UnsignedInt World::threadCount() const { return _state->threadCount; }
+
+World& World::setThreadCount(UnsignedInt count) {
+    if(!count) {
+        count = std::thread::hardware_concurrency();
+        /* Can return 0 if the value is not computable */
+        if(!count) count = 1;
+    }
+    if(count == _state->threadCount) return *this;
+
+    _state->stopWorkers();
+    _state->threadCount = count;
+    State* const state = _state.get();
+    for(UnsignedInt i = 1; i < count; ++i)
+        _state->workers.emplace_back([state]{ state->workerLoop(); });
+
+    return *this;
+}
+
+UnsignedInt World::importThreadCount() const { return _state->importThreadCount; }
+
+World& World::setImportThreadCount(const UnsignedInt count) {
+    if(count == _state->importThreadCount) return *this;
+
+    /* If there are no threads yet, they get created with the new count on
+       the next import. Otherwise recreate them right away to continue with
+       the queued jobs. */
+    const bool running = !_state->importThreads.empty();
+    _state->stopImporters();
+    _state->importThreadCount = count;
+    if(running) _state->startImporters();
+
+    return *this;
+}
+
+std::size_t World::pendingImportCount() const { return _state->pendingImports; }
+
+UnsignedInt World::levelOfDetailCount() const {
+    return _state->primitiveMeshCache.levelOfDetailCount;
+}
+
+World& World::setLevelOfDetailCount(const UnsignedInt count) {
+    CORRADE_ASSERT(count,
+        "DartIntegration::World::setLevelOfDetailCount(): expected at least one level", *this);
+    if(count == _state->primitiveMeshCache.levelOfDetailCount) return *this;
+
+    _state->primitiveMeshCache.levelOfDetailCount = count;
+
+    /* Regenerate the draw data of all objects using primitive meshes. The
+       full-detail mesh is taken from the cache again, only the levels get
+       generated. */
+    for(Object& object: _state->shapeObjects) {
+        if(!object._primitiveMesh) continue;
+        object._drawData = nullptr;
+        if(object.extractDrawData(_state->shared->importer.get(), &_state->primitiveMeshCache))
+            _state->markUpdated(object);
+    }
+
+    return *this;
+}
+
+World& World::refreshStructure() {
+    _state->structureChanged = true;
+    return *this;
+}
+
+bool World::structureChanged() const {
+    if(_state->structureChanged) return true;
+
+    const std::size_t skeletonCount = _state->dartWorld.getNumSkeletons();
+    if(skeletonCount != _state->skeletonStructure.size()) return true;
+
+    for(std::size_t i = 0; i != skeletonCount; ++i) {
+        const SkeletonStructure& structure = _state->skeletonStructure[i];
+        dart::dynamics::Skeleton* const skeleton = _state->dartWorld.getSkeleton(i).get();
+        if(skeleton != structure.skeleton ||
+           skeleton->getNumBodyNodes() != structure.bodyNodeCount ||
+           skeleton->getNumShapeNodes() != structure.shapeNodeCount)
+            return true;
+    }
+
+    return false;
+}
 
 World& World::refresh() {
+    MAGNUM_INTEGRATION_CPU_ZONE("DartIntegration::World::refresh()");
+
+    /* While the simulation thread runs, the DART world and the objects it
+       calculates transformations for can be touched only with the thread
+       paused. That's needed only if the structure changed, otherwise the
+       latest snapshot is applied. */
+    std::unique_lock<std::mutex> simulationLock{_state->simulationMutex, std::defer_lock};
+    if(_state->simulating && structureChanged())
+        simulationLock.lock();
+
+    _state->toRemove.clear();
+
+    /* Upload asynchronously imported data that are ready. Done before the
+       structure check as a failed import affects it. */
+    if(_state->pendingImports)
+        _state->finishImports();
+
+    if(_state->simulating && !simulationLock.owns_lock()) {
+        if(!structureChanged()) {
+            _state->applySnapshot();
+            return *this;
+        }
+
+        /* A failed asynchronous import removed an object. It stays alive in
+           unusedObjects() until the next refresh(), which pauses the
+           thread before deleting it. */
+        simulationLock.lock();
+    }
+
+    /* If nothing changed in the structure, update just the known objects */
+    if((_state->flags & Flag::IncrementalRefresh) && !structureChanged()) {
+        /* Calculate the transformations on multiple threads and then apply
+           them serially, as neither SceneGraph nor the importer and GL
+           upload in extractDrawData() are thread-safe */
+        if(_state->threadCount > 1) {
+            _state->calculateTransformationsParallel();
+            _state->applyCalculatedTransformations();
+            return *this;
+        }
+
+        for(Object& object: _state->objects) {
+            object.clearUpdateFlag();
+            if(object.shapeNode()) {
+                object.updateWithCache(_state->shared->importer.get(), &_state->primitiveMeshCache);
+                if(object.hasUpdatedMesh())
+                    _state->markUpdated(object);
+            } else object.update();
+
+            /* A full walk would remove objects that failed to update. Do
+               that in the next refresh() to keep the same semantics. */
+            if(!object.isUpdated())
+                _state->structureChanged = true;
+        }
+
+        return *this;
+    }
+
     /* Clear update flags */
-    for(auto& obj: _state->dartToMagnum)
-        obj.second->clearUpdateFlag();
+    for(Object& object: _state->objects)
+        object.clearUpdateFlag();
+
+    /* Drop cache entries that are not used by any object anymore. If the
+       caches are shared by a batch, this includes objects of other worlds
+       as well. */
+    for(auto it = _state->shared->drawDataCache.begin(); it != _state->shared->drawDataCache.end(); ) {
+        if(it->second.expired()) it = _state->shared->drawDataCache.erase(it);
+        else ++it;
+    }
+    for(auto it = _state->shared->primitiveMeshes.begin(); it != _state->shared->primitiveMeshes.end(); ) {
+        if(it->second.use_count() == 1) it = _state->shared->primitiveMeshes.erase(it);
+        else ++it;
+    }
 
     /* Parse all skeletons in _dartWorld */
     for(size_t i = 0; i < _state->dartWorld.getNumSkeletons(); ++i) {
@@ -74,75 +759,144 @@ World& World::refresh() {
             parseBodyNodeRecursive(_state->object, *_state->dartWorld.getSkeleton(i)->getRootBodyNode(j));
     }
 
-    /* Find unused objects */
-    std::vector<dart::dynamics::Frame*> unusedFrames;
-    for(auto& object_pair: _state->dartToMagnum) {
-        if(object_pair.second && !object_pair.second->isUpdated())
-            unusedFrames.push_back(object_pair.first);
+    /* Move out unused objects. Going backwards so the objects swapped into
+       the holes are always the already checked ones. */
+    for(std::size_t i = _state->objects.size(); i != 0; --i) {
+        if(!_state->objects[i - 1]->isUpdated())
+            _state->toRemove.push_back(_state->remove(i - 1));
     }
 
-    /* Clear unused objects */
-    _state->toRemove.clear();
-    for(dart::dynamics::Frame* frame: unusedFrames) {
-        auto it = _state->dartToMagnum.find(frame);
-        _state->toRemove.emplace_back(std::move(it->second));
-        _state->dartToMagnum.erase(it);
+    /* Snapshot the structure for the next incremental refresh or the
+       simulation thread */
+    if((_state->flags & Flag::IncrementalRefresh) || _state->simulating) {
+        for(dart::common::Connection& connection: _state->structuralChangeConnections)
+            connection.disconnect();
+        _state->structuralChangeConnections.clear();
+        _state->skeletonStructure.clear();
+        _state->skeletonObjects.clear();
+        _state->skeletonObjectOffsets.clear();
+        _state->skeletonObjectOffsets.push_back(0);
+
+        State* const state = _state.get();
+        for(std::size_t i = 0; i != _state->dartWorld.getNumSkeletons(); ++i) {
+            dart::dynamics::Skeleton* const skeleton = _state->dartWorld.getSkeleton(i).get();
+            _state->skeletonStructure.push_back({skeleton, skeleton->getNumBodyNodes(), skeleton->getNumShapeNodes()});
+
+            for(std::size_t j = 0; j != skeleton->getNumBodyNodes(); ++j) {
+                dart::dynamics::BodyNode* const bn = skeleton->getBodyNode(j);
+                _state->structuralChangeConnections.push_back(bn->onStructuralChange.connect([state](const dart::dynamics::BodyNode*) {
+                    state->structureChanged = true;
+                }));
+
+                auto found = _state->frameToObject.find(bn);
+                if(found != _state->frameToObject.end())
+                    _state->skeletonObjects.push_back(&_state->objects[found->second.object].get());
+                for(dart::dynamics::ShapeNode* shape: bn->getShapeNodesWith<dart::dynamics::VisualAspect>()) {
+                    auto found = _state->frameToObject.find(shape);
+                    if(found != _state->frameToObject.end())
+                        _state->skeletonObjects.push_back(&_state->objects[found->second.object].get());
+                }
+            }
+
+            _state->skeletonObjectOffsets.push_back(_state->skeletonObjects.size());
+        }
+
+        _state->calculatedTransformations.resize(_state->skeletonObjects.size());
+        if(_state->simulating) _state->resetSnapshots();
     }
 
+    _state->structureChanged = false;
     return *this;
 }
 
 World& World::step(bool resetCommand) {
+    CORRADE_ASSERT(!_state->simulating,
+        "DartIntegration::World::step(): the simulation thread is running", *this);
     _state->dartWorld.step(resetCommand);
     return *this;
 }
 
-std::vector<std::unique_ptr<Object>>& World::unusedObjects() {
-    return _state->toRemove;
+WorldBatch* World::batch() const { return _state->batch; }
+
+bool World::beginBatchedRefresh() {
+    /* The parallel calculation is possible only in the same case as with
+       setThreadCount(). Pending imports are processed by a regular refresh()
+       as well, as a failed import may change the structure. */
+    if(_state->simulating || _state->pendingImports || !(_state->flags & Flag::IncrementalRefresh) || structureChanged()) {
+        refresh();
+        return false;
+    }
+
+    _state->toRemove.clear();
+    return true;
 }
 
-std::vector<std::reference_wrapper<Object>> World::objects() {
-    std::vector<std::reference_wrapper<Object>> objs;
-    objs.reserve(_state->dartToMagnum.size());
-    for(auto& obj: _state->dartToMagnum)
-        objs.emplace_back(*obj.second);
+std::size_t World::batchedSkeletonCount() const {
+    return _state->skeletonObjectOffsets.size() - 1;
+}
+
+void World::calculateBatchedTransformations(const std::size_t skeleton) {
+    _state->calculateSkeletonTransformations(skeleton);
+}
 
-    return objs;
+void World::finishBatchedRefresh() {
+    _state->applyCalculatedTransformations();
 }
 
-std::vector<std::reference_wrapper<Object>> World::shapeObjects() {
-    std::vector<std::reference_wrapper<Object>> objs;
-    for(auto& obj: _state->dartToMagnum)
-        if(obj.second->shapeNode())
-            objs.emplace_back(*obj.second);
+World& World::startSimulation(const Float stepsPerSecond) {
+    CORRADE_ASSERT(!_state->simulating,
+        "DartIntegration::World::startSimulation(): the simulation thread is already running", *this);
 
-    return objs;
+    _state->simulationPeriod = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<Double>{stepsPerSecond ? 1.0/stepsPerSecond : _state->dartWorld.getTimeStep()});
+
+    /* Do a full walk to populate the flat object list the thread calculates
+       the transformations for */
+    _state->simulating = true;
+    _state->structureChanged = true;
+    refresh();
+
+    State* const state = _state.get();
+    _state->simulationThread = std::thread{[state]{ state->simulationLoop(); }};
+    return *this;
+}
+
+World& World::stopSimulation() {
+    _state->stopSimulation();
+    return *this;
 }
 
-std::vector<std::reference_wrapper<Object>> World::bodyObjects() {
-    std::vector<std::reference_wrapper<Object>> objs;
-    for(auto& obj: _state->dartToMagnum)
-        if(obj.second->bodyNode())
-            objs.emplace_back(std::ref(*obj.second));
+bool World::isSimulationRunning() const { return _state->simulating; }
+
+std::vector<std::unique_ptr<Object>>& World::unusedObjects() {
+    return _state->toRemove;
+}
+
+Containers::ArrayView<const Containers::Reference<Object>> World::objects() {
+    return _state->objects;
+}
 
-    return objs;
+Containers::ArrayView<const Containers::Reference<Object>> World::shapeObjects() {
+    return _state->shapeObjects;
 }
 
-std::vector<std::reference_wrapper<Object>> World::updatedShapeObjects() {
-    std::vector<std::reference_wrapper<Object>> objs;
-    objs.reserve(_state->updatedShapeObjects.size());
-    for(auto& obj: _state->updatedShapeObjects)
-        objs.emplace_back(*obj);
-    return objs;
+Containers::ArrayView<const Containers::Reference<Object>> World::bodyObjects() {
+    return _state->bodyObjects;
+}
+
+Containers::ArrayView<const Containers::Reference<Object>> World::updatedShapeObjects() {
+    return _state->updatedShapeObjects;
 }
 
 World& World::clearUpdatedShapeObjects() {
-    _state->updatedShapeObjects.clear();
+    for(Object& object: _state->updatedShapeObjects)
+        object._updatedShapeObjectIndex = ~UnsignedInt{};
+    /* Keeps the capacity for the next frame */
+    arrayRemoveSuffix(_state->updatedShapeObjects, _state->updatedShapeObjects.size());
     return *this;
 }
 
 Object& World::objectFromDartFrame(dart::dynamics::Frame* frame) {
-    return *_state->dartToMagnum.at(frame);
+    return _state->objects[_state->frameToObject.at(frame).object];
 }
 
 dart::simulation::World& World::world() { return _state->dartWorld; }
@@ -153,26 +907,55 @@ void World::parseBodyNodeRecursive(SceneGraph::AbstractBasicObject3D<Float>& par
 
     /* Create an object of the BodyNode to keep track of transformations */
     SceneGraph::AbstractBasicObject3D<Float>* object = nullptr;
-    auto it = _state->dartToMagnum.emplace(static_cast<dart::dynamics::Frame*>(&bn), nullptr);
-    if(it.second) {
+    Object* bodyObject;
+    auto found = _state->frameToObject.find(static_cast<dart::dynamics::Frame*>(&bn));
+    if(found == _state->frameToObject.end()) {
         object = objectCreator(parent);
-        it.first->second = dartObjectCreator(*object, &bn);
-    } else
-        object = static_cast<SceneGraph::AbstractBasicObject3D<Float>*>(&it.first->second->object());
+        bodyObject = &_state->add(&bn, dartObjectCreator(*object, &bn));
+    } else {
+        bodyObject = &_state->objects[found->second.object].get();
+        object = static_cast<SceneGraph::AbstractBasicObject3D<Float>*>(&bodyObject->object());
+    }
 
-    it.first->second->update();
+    bodyObject->update();
 
     for(auto& shape: visualShapes) {
-        auto it = _state->dartToMagnum.emplace(static_cast<dart::dynamics::Frame*>(shape), nullptr);
-        if(it.second) {
+        Object* shapeObject;
+        std::string cacheKey;
+        bool sharedDrawData = false;
+        auto found = _state->frameToObject.find(static_cast<dart::dynamics::Frame*>(shape));
+        if(found == _state->frameToObject.end()) {
             /* create object for the ShapeNode to keep track of inner transformations */
             auto shapeObj = objectCreator(*object);
-            it.first->second = dartShapeObjectCreator(*shapeObj, shape);
-        }
-
-        it.first->second->update(_state->importer.get());
-        if(it.first->second->hasUpdatedMesh())
-            _state->updatedShapeObjects.insert(it.first->second.get());
+            shapeObject = &_state->add(shape, dartShapeObjectCreator(*shapeObj, shape));
+
+            /* Reuse draw data of an identical shape, if there's any. Since
+               the shape is static, update() then won't touch the data. */
+            if(_state->flags & Flag::ShareDrawData) {
+                cacheKey = drawDataCacheKey(*shape);
+                if(!cacheKey.empty()) {
+                    auto cached = _state->shared->drawDataCache.find(cacheKey);
+                    if(cached != _state->shared->drawDataCache.end() && (shapeObject->_drawData = cached->second.lock()))
+                        sharedDrawData = true;
+                }
+            }
+
+            /* Otherwise import meshes in the background, if enabled. If
+               the importer plugin failed to load, let update() fail the
+               same way as without the flag. */
+            if(!sharedDrawData && (_state->flags & Flag::AsyncImport) && _state->shared->importer && shape->getShape()->getType() == dart::dynamics::MeshShape::getStaticType()) {
+                _state->submitImport(*shapeObject, *shape, std::move(cacheKey));
+                cacheKey = {};
+            }
+        } else shapeObject = &_state->objects[found->second.object].get();
+
+        shapeObject->updateWithCache(_state->shared->importer.get(), &_state->primitiveMeshCache);
+        if(shapeObject->hasUpdatedMesh() || (sharedDrawData && shapeObject->isUpdated()))
+            _state->markUpdated(*shapeObject);
+
+        /* Put freshly converted data into the cache */
+        if(!sharedDrawData && !cacheKey.empty() && shapeObject->_drawData)
+            _state->shared->drawDataCache[cacheKey] = shapeObject->_drawData;
     }
 
     /* Parse the children recursively, pass the newly created object as parent */
@@ -180,4 +963,27 @@ void World::parseBodyNodeRecursive(SceneGraph::AbstractBasicObject3D<Float>& par
         parseBodyNodeRecursive(*object, *bn.getChildBodyNode(i));
 }
 
+Debug& operator<<(Debug& debug, const World::Flag value) {
+    debug << "DartIntegration::World::Flag" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case World::Flag::value: return debug << "::" #value;
+        _c(IncrementalRefresh)
+        _c(ShareDrawData)
+        _c(AsyncImport)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "(" << Debug::nospace << Debug::hex << UnsignedByte(value) << Debug::nospace << ")";
+}
+
+Debug& operator<<(Debug& debug, const World::Flags value) {
+    return Containers::enumSetDebugOutput(debug, value, "DartIntegration::World::Flags{}", {
+        World::Flag::IncrementalRefresh,
+        World::Flag::ShareDrawData,
+        World::Flag::AsyncImport});
+}
+
 }}
@@ -31,14 +31,17 @@
  * @brief Class @ref Magnum::DartIntegration::World
  */
 
-#include <functional>
 #include <memory>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/EnumSet.h>
 #include <Corrade/Containers/Pointer.h>
+#include <Corrade/Containers/Reference.h>
 #include <Corrade/Utility/StlForwardVector.h>
 #include <Magnum/SceneGraph/AbstractFeature.h>
 #include <Magnum/SceneGraph/AbstractObject.h>
 #include <Magnum/Trade/AbstractImporter.h>
 
+#include "Magnum/DartIntegration/DartIntegration.h"
 #include "Magnum/DartIntegration/Object.h"
 
 namespace dart {
@@ -82,23 +85,148 @@ updated shapes you can do the following:
 
 @snippet DartIntegration.cpp World-loop
 
+@section DartIntegration-World-incremental Incremental refresh
+
+By default, @ref refresh() walks all skeletons and their body node trees on
+every call in order to discover added and removed bodies and shapes. For large
+worlds with a structure that doesn't change often, this walk can easily get
+more expensive than the simulation step itself. Enabling
+@ref Flag::IncrementalRefresh makes @ref refresh() walk the trees only if a
+structural change is detected, and otherwise update just the existing objects
+from a flat list:
+
+@snippet DartIntegration.cpp World-incremental
+
+@section DartIntegration-World-parallel Parallel refresh
+
+With @ref Flag::IncrementalRefresh enabled, the transformations of objects can
+be additionally calculated on multiple threads by calling
+@ref setThreadCount(). The work is split by skeletons, so it's beneficial only
+for worlds with many skeletons. The transformations are then applied to the
+scene graph serially on the calling thread, same as mesh and material updates.
+
+@snippet DartIntegration.cpp World-parallel
+
+@section DartIntegration-World-simulation Simulation thread
+
+Calling @ref step() and @ref refresh() one after another makes rendering and
+physics throttle each other. With @ref startSimulation(), the DART world is
+stepped on a dedicated thread at a fixed rate instead, which after each step
+publishes transformations of all objects into a lock-free triple buffer.
+@ref refresh() then only applies the latest published transformations, if
+there are any:
+
+@snippet DartIntegration.cpp World-simulation
+
+While the thread is running, the DART world shouldn't be modified from other
+threads. If a structural change is detected, for example after
+@ref refreshStructure() or a failed asynchronous import, @ref refresh() pauses
+the thread for the duration of a full walk. Shape data that change during the
+simulation, such as soft body meshes, are updated only if the thread isn't in
+the middle of a step at the time of the @ref refresh() call.
+
+@section DartIntegration-World-batch Many worlds
+
+If there's many independent worlds, for example for running many simulation
+rollouts at once, construct them as a part of a @ref WorldBatch. The worlds
+then share a single importer and mesh cache and can be stepped and refreshed
+in parallel, see @ref DartIntegration-WorldBatch for more information.
+
 @experimental
 */
 class MAGNUM_DARTINTEGRATION_EXPORT World {
     public:
+        /**
+         * @brief Flag
+         *
+         * @see @ref Flags, @ref setFlags()
+         * @m_since_latest_{integration}
+         */
+        enum class Flag: UnsignedByte {
+            /**
+             * Walk the DART skeleton trees in @ref refresh() only if the
+             * world structure changed since the last walk. The structure is
+             * considered changed if a skeleton got added to or removed from
+             * the world, if the count of body nodes or shape nodes in any
+             * skeleton changed, if a body node raised its
+             * @cpp onStructuralChange @ce signal, or if any object failed to
+             * update in the previous @ref refresh(). Otherwise only the
+             * already known objects are updated, without any lookup or
+             * allocation.
+             *
+             * Adding or removing a `VisualAspect` on an existing shape node
+             * isn't detected, call @ref refreshStructure() in that case.
+             */
+            IncrementalRefresh = 1 << 0,
+
+            /**
+             * Share a single @ref DrawData instance among all objects that
+             * have a static `MeshShape` with the same mesh path, scale,
+             * color mode and color. The meshes, textures and materials are
+             * then imported and uploaded to the GPU just once. The cache is
+             * reference-counted --- the shared data get destroyed once the
+             * last object using them is. If a shape stops being static, its
+             * object gets its own copy of the data.
+             *
+             * Because modifying @ref Object::drawData() of one object then
+             * affects all objects sharing it, this flag isn't enabled by
+             * default. It affects only objects created while the flag is
+             * set, so pass it to the constructor to have it apply to the
+             * initial @ref refresh() as well.
+             */
+            ShareDrawData = 1 << 1,
+
+            /**
+             * Import `MeshShape` data on background threads instead of
+             * stalling @ref refresh(). New objects with a mesh shape are
+             * then @ref Object::isLoading() until the import finishes,
+             * their transformation is updated but @ref Object::drawData()
+             * isn't available yet. Once the data are ready, a subsequent
+             * @ref refresh() uploads them to the GPU on the calling thread
+             * and the object appears in @ref updatedShapeObjects(). If the
+             * import fails, the object is put into @ref unusedObjects().
+             *
+             * Only the initial import is asynchronous, updates of shapes
+             * with a dynamic data variance are done on the calling thread
+             * as before. Primitive shapes are always converted on the
+             * calling thread, as they use shared meshes. Each import
+             * thread uses its own importer instance, see
+             * @ref setImportThreadCount().
+             *
+             * The plugin manager isn't thread-safe, so the import threads
+             * serialize all its use --- importer instantiation and texture
+             * image import, which goes through
+             * @relativeref{Trade,AnyImageImporter} and the concrete image
+             * plugins --- with the calling thread and with other worlds sharing the manager in a
+             * @ref WorldBatch. Geometry import runs in parallel. If a
+             * plugin manager is passed to the constructor, it shouldn't be
+             * used by anything else while imports are running.
+             */
+            AsyncImport = 1 << 2
+        };
+
+        /**
+         * @brief Flags
+         *
+         * @see @ref setFlags()
+         * @m_since_latest_{integration}
+         */
+        typedef Containers::EnumSet<Flag> Flags;
+
          /**
          * @brief Constructor
          * @param object    Parent object
          * @param world     DART world instance
+         * @param flags     Flags
          *
          * This constructor creates a private instance of
          * @ref Trade::AbstractImporter plugin manager for importing model
          * data. If you plan to use importer plugins elsewhere in your
          * application, it's advised to keep the plugin manager on the app side
-         * and construct the world using @ref World(PluginManager::Manager<Trade::AbstractImporter>&, T&, dart::simulation::World&)
+         * and construct the world using @ref World(PluginManager::Manager<Trade::AbstractImporter>&, T&, dart::simulation::World&, Flags)
          * instead.
          */
-        template<class T> explicit World(T& object, dart::simulation::World& world): World(nullptr, static_cast<SceneGraph::AbstractBasicObject3D<Float>&>(object), world) {
+        template<class T> explicit World(T& object, dart::simulation::World& world, Flags flags = {}): World(nullptr, nullptr, static_cast<SceneGraph::AbstractBasicObject3D<Float>&>(object), world, flags) {
             initializeCreators<T>();
         }
 
@@ -107,27 +235,200 @@ class MAGNUM_DARTINTEGRATION_EXPORT World {
          * @param importerManager   Importer plugin manager
          * @param object            Parent object
          * @param world             DART world instance
+         * @param flags             Flags
          *
          * The @p importerManager is expected to be in scope for the whole
          * lifetime of the @ref World instance.
          */
-        template<class T> explicit World(PluginManager::Manager<Trade::AbstractImporter>& importerManager, T& object, dart::simulation::World& world): World(&importerManager, static_cast<SceneGraph::AbstractBasicObject3D<Float>&>(object), world) {
+        template<class T> explicit World(PluginManager::Manager<Trade::AbstractImporter>& importerManager, T& object, dart::simulation::World& world, Flags flags = {}): World(&importerManager, nullptr, static_cast<SceneGraph::AbstractBasicObject3D<Float>&>(object), world, flags) {
+            initializeCreators<T>();
+        }
+
+        /**
+         * @brief Construct as a part of a world batch
+         * @param batch             World batch
+         * @param object            Parent object
+         * @param world             DART world instance
+         * @param flags             Flags
+         * @m_since_latest_{integration}
+         *
+         * The world uses the importer plugin manager, the importer instance
+         * and the mesh and draw data caches of @p batch instead of having
+         * its own, and gets added to @ref WorldBatch::worlds(). The
+         * @p batch is expected to be in scope for the whole lifetime of the
+         * @ref World instance. See @ref DartIntegration-WorldBatch for more
+         * information.
+         */
+        template<class T> explicit World(WorldBatch& batch, T& object, dart::simulation::World& world, Flags flags = {}): World(nullptr, &batch, static_cast<SceneGraph::AbstractBasicObject3D<Float>&>(object), world, flags) {
             initializeCreators<T>();
         }
 
         ~World();
 
-        /** @brief Refresh/regenerate meshes for all bodies in DART world */
+        /**
+         * @brief Flags
+         *
+         * @m_since_latest_{integration}
+         */
+        Flags flags() const;
+
+        /**
+         * @brief Set flags
+         * @return Reference to self (for method chaining)
+         *
+         * By default no flags are set, unless passed to the constructor.
+         * Enabling
+         * @ref Flag::IncrementalRefresh causes the next @ref refresh() to
+         * walk all skeleton trees in order to get the structure tracking
+         * up-to-date.
+         * @m_since_latest_{integration}
+         */
+        World& setFlags(Flags flags);
+
+        /**
+         * @brief Refresh/regenerate meshes for all bodies in DART world
+         *
+         * If @ref Flag::IncrementalRefresh is set, the skeleton trees are
+         * walked only if the world structure changed since the last call.
+         * See @ref DartIntegration-World-incremental for more information.
+         */
         World& refresh();
 
+        /**
+         * @brief Force a structure refresh
+         * @return Reference to self (for method chaining)
+         *
+         * Makes the next @ref refresh() walk all skeleton trees even if
+         * @ref Flag::IncrementalRefresh is set and no structural change was
+         * detected. Useful for changes that aren't tracked, such as adding
+         * or removing a `VisualAspect` on an existing shape node.
+         * @m_since_latest_{integration}
+         */
+        World& refreshStructure();
+
+        /**
+         * @brief Thread count used by @ref refresh()
+         *
+         * @m_since_latest_{integration}
+         */
+        UnsignedInt threadCount() const;
+
+        /**
+         * @brief Set thread count used by @ref refresh()
+         * @return Reference to self (for method chaining)
+         *
+         * Default is @cpp 1 @ce, which means everything is done on the
+         * calling thread. A value larger than @cpp 1 @ce spawns
+         * @cpp count - 1 @ce worker threads that calculate object
+         * transformations of independent skeletons in parallel with the
+         * calling thread. A value of @cpp 0 @ce uses the number of hardware
+         * threads. The threads are used only by refreshes that don't change
+         * the world structure if @ref Flag::IncrementalRefresh is set,
+         * otherwise everything is done on the calling thread. See
+         * @ref DartIntegration-World-parallel for more information.
+         *
+         * The DART world shouldn't be modified from other threads during
+         * @ref refresh().
+         * @m_since_latest_{integration}
+         */
+        World& setThreadCount(UnsignedInt count);
+
+        /**
+         * @brief Thread count used for asynchronous import
+         *
+         * @m_since_latest_{integration}
+         */
+        UnsignedInt importThreadCount() const;
+
+        /**
+         * @brief Set thread count used for asynchronous import
+         * @return Reference to self (for method chaining)
+         *
+         * Used only if @ref Flag::AsyncImport is set. Default is
+         * @cpp 1 @ce, a value of @cpp 0 @ce uses the number of hardware
+         * threads. The threads are created on the first asynchronous import.
+         * @m_since_latest_{integration}
+         */
+        World& setImportThreadCount(UnsignedInt count);
+
+        /**
+         * @brief Level of detail count for primitive shapes
+         *
+         * @m_since_latest_{integration}
+         */
+        UnsignedInt levelOfDetailCount() const;
+
+        /**
+         * @brief Set level of detail count for primitive shapes
+         * @return Reference to self (for method chaining)
+         *
+         * If more than @cpp 1 @ce, capsule, cone, cylinder, ellipsoid and
+         * sphere shape objects get @p count @cpp - 1 @ce coarser meshes in
+         * @ref DrawData::levelsOfDetail, generated with
+         * @ref convertShapeNode(dart::dynamics::ShapeNode&, ConvertShapeTypes, UnsignedInt, Trade::AbstractImporter*)
+         * and shared among all objects the same way as the full-detail
+         * meshes. Existing objects are updated right away and appear in
+         * @ref updatedShapeObjects(). Expects that @p count is not
+         * @cpp 0 @ce, default is @cpp 1 @ce.
+         * @see @ref levelOfDetail()
+         * @m_since_latest_{integration}
+         */
+        World& setLevelOfDetailCount(UnsignedInt count);
+
+        /**
+         * @brief Count of pending asynchronous imports
+         *
+         * Count of objects that are @ref Object::isLoading(), including the
+         * ones whose import finished but didn't get processed by
+         * @ref refresh() yet. Always @cpp 0 @ce if @ref Flag::AsyncImport
+         * isn't set.
+         * @m_since_latest_{integration}
+         */
+        std::size_t pendingImportCount() const;
+
         /**
          * @brief Do a DART world step
          *
          * The @p resetCommand parameter is passed to
-         * @cpp dart::simulation::World::step() @ce.
+         * @cpp dart::simulation::World::step() @ce. Expects that the
+         * simulation thread isn't running.
+         * @see @ref startSimulation()
          */
         World& step(bool resetCommand = true);
 
+        /**
+         * @brief Start stepping the DART world on a dedicated thread
+         * @param stepsPerSecond    Simulation rate. If @cpp 0.0f @ce, the
+         *      DART world time step is used, which makes the simulation run
+         *      in real time.
+         * @return Reference to self (for method chaining)
+         *
+         * Does a full @ref refresh() and then starts a thread that repeatedly
+         * calls @cpp dart::simulation::World::step() @ce and publishes
+         * transformations of all objects. Expects that the simulation thread
+         * isn't running already. See @ref DartIntegration-World-simulation
+         * for more information.
+         * @m_since_latest_{integration}
+         */
+        World& startSimulation(Float stepsPerSecond = 0.0f);
+
+        /**
+         * @brief Stop the simulation thread
+         * @return Reference to self (for method chaining)
+         *
+         * Waits until the thread finishes the current step. If the thread
+         * isn't running, does nothing.
+         * @m_since_latest_{integration}
+         */
+        World& stopSimulation();
+
+        /**
+         * @brief Whether the simulation thread is running
+         *
+         * @m_since_latest_{integration}
+         */
+        bool isSimulationRunning() const;
+
         /**
          * @brief Get unused objects
          *
@@ -141,25 +442,45 @@ class MAGNUM_DARTINTEGRATION_EXPORT World {
          */
         std::vector<std::unique_ptr<Object>>& unusedObjects();
 
-        /** @brief All objects managed by the world */
-        std::vector<std::reference_wrapper<Object>> objects();
+        /**
+         * @brief All objects managed by the world
+         *
+         * The objects are stored in a contiguous array in no particular
+         * order, the view is valid until the next @ref refresh() call. The
+         * @ref Object instances themselves are kept at the same address for
+         * as long as they're managed by the world.
+         */
+        Containers::ArrayView<const Containers::Reference<Object>> objects();
 
-        /** @brief All objects that have shapes */
-        std::vector<std::reference_wrapper<Object>> shapeObjects();
+        /**
+         * @brief All objects that have shapes
+         *
+         * A subset of @ref objects(), valid until the next @ref refresh()
+         * call.
+         */
+        Containers::ArrayView<const Containers::Reference<Object>> shapeObjects();
 
-        /** @brief All objects that do not have shapes */
-        std::vector<std::reference_wrapper<Object>> bodyObjects();
+        /**
+         * @brief All objects that do not have shapes
+         *
+         * A subset of @ref objects(), valid until the next @ref refresh()
+         * call.
+         */
+        Containers::ArrayView<const Containers::Reference<Object>> bodyObjects();
 
         /**
          * @brief All objects that have updated shapes
          *
          * This list gets appended to after every @ref refresh() call, you can
-         * use it to update your rendering structures. Be sure to call
+         * use it to update your rendering structures. Each object is listed
+         * at most once and objects that got removed from the world are
+         * removed from the list as well. Be sure to call
          * @ref clearUpdatedShapeObjects() once you have your rendering
          * structures updated to avoid updating objects that didn't change
-         * again.
+         * again. The view is valid until the next @ref refresh() or
+         * @ref clearUpdatedShapeObjects() call.
          */
-        std::vector<std::reference_wrapper<Object>> updatedShapeObjects();
+        Containers::ArrayView<const Containers::Reference<Object>> updatedShapeObjects();
 
         /**
          * @brief Clear list of updated shape objects
@@ -181,22 +502,58 @@ class MAGNUM_DARTINTEGRATION_EXPORT World {
         /** @brief Underlying DART world object */
         dart::simulation::World& world();
 
+        /**
+         * @brief World batch the world is a part of
+         *
+         * Returns @cpp nullptr @ce if the world wasn't constructed with
+         * @ref World(WorldBatch&, T&, dart::simulation::World&, Flags).
+         * @m_since_latest_{integration}
+         */
+        WorldBatch* batch() const;
+
     private:
+        friend WorldBatch;
         struct State;
 
-        explicit World(PluginManager::Manager<Trade::AbstractImporter>* importerManager, SceneGraph::AbstractBasicObject3D<Float>& object, dart::simulation::World& world);
+        explicit World(PluginManager::Manager<Trade::AbstractImporter>* importerManager, WorldBatch* batch, SceneGraph::AbstractBasicObject3D<Float>& object, dart::simulation::World& world, Flags flags);
 
         SceneGraph::AbstractBasicObject3D<Float>*(*objectCreator)(SceneGraph::AbstractBasicObject3D<Float>& parent);
         std::unique_ptr<Object>(*dartObjectCreator)(SceneGraph::AbstractBasicObject3D<Float>& parent, dart::dynamics::BodyNode* body);
         std::unique_ptr<Object>(*dartShapeObjectCreator)(SceneGraph::AbstractBasicObject3D<Float>& parent, dart::dynamics::ShapeNode* node);
 
+        bool MAGNUM_DARTINTEGRATION_LOCAL structureChanged() const;
         void MAGNUM_DARTINTEGRATION_LOCAL parseBodyNodeRecursive(SceneGraph::AbstractBasicObject3D<Float>& parent, dart::dynamics::BodyNode& bn);
 
         template<class T> void initializeCreators();
 
+        /* Used by WorldBatch::refresh(). If the transformations can be
+           calculated together with other worlds, returns true and the
+           calculation is then done with calculateBatchedTransformations()
+           for each skeleton, possibly from multiple threads, followed by
+           finishBatchedRefresh(). Otherwise does a regular refresh() and
+           returns false. */
+        bool MAGNUM_DARTINTEGRATION_LOCAL beginBatchedRefresh();
+        std::size_t MAGNUM_DARTINTEGRATION_LOCAL batchedSkeletonCount() const;
+        void MAGNUM_DARTINTEGRATION_LOCAL calculateBatchedTransformations(std::size_t skeleton);
+        void MAGNUM_DARTINTEGRATION_LOCAL finishBatchedRefresh();
+
         Containers::Pointer<State> _state;
 };
 
+CORRADE_ENUMSET_OPERATORS(World::Flags)
+
+/**
+@debugoperatorclassenum{World,World::Flag}
+@m_since_latest_{integration}
+*/
+MAGNUM_DARTINTEGRATION_EXPORT Debug& operator<<(Debug& debug, World::Flag value);
+
+/**
+@debugoperatorclassenum{World,World::Flags}
+@m_since_latest_{integration}
+*/
+MAGNUM_DARTINTEGRATION_EXPORT Debug& operator<<(Debug& debug, World::Flags value);
+
 template<class T> void World::initializeCreators() {
     objectCreator = [](SceneGraph::AbstractBasicObject3D<Float>& parent) -> SceneGraph::AbstractBasicObject3D<Float>* {
         return new T{static_cast<T*>(&parent)};
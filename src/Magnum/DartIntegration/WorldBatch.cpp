@@ -0,0 +1,264 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "WorldBatch.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <Corrade/Containers/GrowableArray.h>
+#include <dart/simulation/World.hpp>
+
+#include "Magnum/instrumentationIntegration.h"
+#include "Magnum/DartIntegration/World.h"
+#include "Magnum/DartIntegration/Implementation/WorldSharedData.h"
+
+namespace Magnum { namespace DartIntegration {
+
+namespace {
+
+struct SkeletonJob {
+    World* world;
+    std::size_t skeleton;
+};
+
+}
+
+struct WorldBatch::State {
+    explicit State(PluginManager::Manager<Trade::AbstractImporter>* manager): shared{manager} {}
+
+    ~State() { stopWorkers(); }
+
+    void run(std::size_t count, void(*function)(State&, std::size_t));
+    void runJobs();
+    void workerLoop();
+    void stopWorkers();
+
+    Implementation::WorldSharedData shared;
+    Containers::Array<Containers::Reference<World>> worlds;
+
+    /* Worker threads, the calling thread is used as well so there's always
+       threadCount - 1 of them. Jobs are picked by incrementing nextJob, so
+       a thread that's done with its job takes the next one that's not taken
+       yet. */
+    UnsignedInt threadCount = 1;
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable workAvailable, workDone;
+    std::size_t generation = 0;
+    std::size_t busyWorkers = 0;
+    bool quit = false;
+    void(*job)(State&, std::size_t){};
+    std::size_t jobCount = 0;
+    std::atomic<std::size_t> nextJob{0};
+
+    /* Inputs for the jobs, kept to not allocate on every call */
+    Containers::ArrayView<const Containers::Reference<World>> stepWorlds;
+    bool resetCommand;
+    Containers::Array<SkeletonJob> skeletonJobs;
+    Containers::Array<World*> batchedWorlds;
+};
+
+void WorldBatch::State::run(const std::size_t count, void(*const function)(State&, std::size_t)) {
+    job = function;
+    jobCount = count;
+    nextJob.store(0, std::memory_order_relaxed);
+
+    /* Wake up the workers only if there's enough work for more than one
+       thread */
+    const bool parallel = !workers.empty() && count > 1;
+    if(parallel) {
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            busyWorkers = workers.size();
+            ++generation;
+        }
+        workAvailable.notify_all();
+    }
+
+    /* Help with the work on the calling thread as well, then wait for the
+       workers to finish */
+    runJobs();
+    if(parallel) {
+        std::unique_lock<std::mutex> lock{mutex};
+        workDone.wait(lock, [this]{ return busyWorkers == 0; });
+    }
+}
+
+void WorldBatch::State::runJobs() {
+    for(std::size_t i; (i = nextJob.fetch_add(1, std::memory_order_relaxed)) < jobCount; )
+        job(*this, i);
+}
+
+void WorldBatch::State::workerLoop() {
+    std::size_t seenGeneration = 0;
+    for(;;) {
+        {
+            std::unique_lock<std::mutex> lock{mutex};
+            workAvailable.wait(lock, [&]{ return quit || generation != seenGeneration; });
+            if(quit) return;
+            seenGeneration = generation;
+        }
+
+        runJobs();
+
+        std::lock_guard<std::mutex> lock{mutex};
+        if(--busyWorkers == 0) workDone.notify_one();
+    }
+}
+
+void WorldBatch::State::stopWorkers() {
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        quit = true;
+    }
+    workAvailable.notify_all();
+    for(std::thread& worker: workers) worker.join();
+    workers.clear();
+    quit = false;
+}
+
+WorldBatch::WorldBatch(): _state{InPlaceInit, nullptr} {}
+
+WorldBatch::WorldBatch(PluginManager::Manager<Trade::AbstractImporter>& importerManager): _state{InPlaceInit, &importerManager} {}
+
+WorldBatch::~WorldBatch() {
+    CORRADE_ASSERT(_state->worlds.isEmpty(),
+        "DartIntegration::WorldBatch: destroyed while" << _state->worlds.size() << "worlds are still using it", );
+}
+
+Containers::ArrayView<const Containers::Reference<World>> WorldBatch::worlds() const {
+    return _state->worlds;
+}
+
+UnsignedInt WorldBatch::threadCount() const { return _state->threadCount; }
+
+WorldBatch& WorldBatch::setThreadCount(UnsignedInt count) {
+    if(!count) {
+        count = std::thread::hardware_concurrency();
+        /* Can return 0 if the value is not computable */
+        if(!count) count = 1;
+    }
+    if(count == _state->threadCount) return *this;
+
+    _state->stopWorkers();
+    _state->threadCount = count;
+    State* const state = _state.get();
+    for(UnsignedInt i = 1; i < count; ++i)
+        _state->workers.emplace_back([state]{ state->workerLoop(); });
+
+    return *this;
+}
+
+WorldBatch& WorldBatch::step(const bool resetCommand) {
+    return step(_state->worlds, resetCommand);
+}
+
+WorldBatch& WorldBatch::step(const Containers::ArrayView<const Containers::Reference<World>> worlds, const bool resetCommand) {
+    MAGNUM_INTEGRATION_CPU_ZONE("DartIntegration::WorldBatch::step()");
+
+    #ifndef CORRADE_NO_ASSERT
+    for(std::size_t i = 0; i != worlds.size(); ++i) {
+        CORRADE_ASSERT(worlds[i]->batch() == this,
+            "DartIntegration::WorldBatch::step(): world" << i << "is not a part of this batch", *this);
+        CORRADE_ASSERT(!worlds[i]->isSimulationRunning(),
+            "DartIntegration::WorldBatch::step(): the simulation thread of world" << i << "is running", *this);
+    }
+    #endif
+
+    _state->stepWorlds = worlds;
+    _state->resetCommand = resetCommand;
+    _state->run(worlds.size(), [](State& state, const std::size_t i) {
+        state.stepWorlds[i]->world().step(state.resetCommand);
+    });
+    _state->stepWorlds = {};
+
+    return *this;
+}
+
+WorldBatch& WorldBatch::refresh() {
+    return refresh(_state->worlds);
+}
+
+WorldBatch& WorldBatch::refresh(const Containers::ArrayView<const Containers::Reference<World>> worlds) {
+    MAGNUM_INTEGRATION_CPU_ZONE("DartIntegration::WorldBatch::refresh()");
+
+    /* Keeps the capacity for the next call */
+    arrayRemoveSuffix(_state->skeletonJobs, _state->skeletonJobs.size());
+    arrayRemoveSuffix(_state->batchedWorlds, _state->batchedWorlds.size());
+
+    /* Worlds that can't be refreshed in parallel get refreshed directly in
+       beginBatchedRefresh(), for the rest gather all their skeletons */
+    for(std::size_t i = 0; i != worlds.size(); ++i) {
+        World& world = worlds[i];
+        CORRADE_ASSERT(world.batch() == this,
+            "DartIntegration::WorldBatch::refresh(): world" << i << "is not a part of this batch", *this);
+        if(!world.beginBatchedRefresh()) continue;
+
+        arrayAppend(_state->batchedWorlds, &world);
+        for(std::size_t j = 0, count = world.batchedSkeletonCount(); j != count; ++j)
+            arrayAppend(_state->skeletonJobs, SkeletonJob{&world, j});
+    }
+
+    /* Each skeleton is processed by just one thread, as DART lazily updates
+       joint transformations on access */
+    _state->run(_state->skeletonJobs.size(), [](State& state, const std::size_t i) {
+        const SkeletonJob& job = state.skeletonJobs[i];
+        job.world->calculateBatchedTransformations(job.skeleton);
+    });
+
+    /* Apply serially, as neither SceneGraph nor the importer and GL upload
+       are thread-safe */
+    for(World* world: _state->batchedWorlds)
+        world->finishBatchedRefresh();
+
+    return *this;
+}
+
+Implementation::WorldSharedData& WorldBatch::shared() {
+    return _state->shared;
+}
+
+void WorldBatch::addWorld(World& world) {
+    arrayAppend(_state->worlds, world);
+}
+
+void WorldBatch::removeWorld(World& world) {
+    /* Shift the following worlds to keep the order */
+    for(std::size_t i = 0; i != _state->worlds.size(); ++i) {
+        if(&*_state->worlds[i] != &world) continue;
+        for(std::size_t j = i + 1; j != _state->worlds.size(); ++j)
+            _state->worlds[j - 1] = _state->worlds[j];
+        arrayRemoveSuffix(_state->worlds);
+        return;
+    }
+
+    CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+}}
@@ -0,0 +1,226 @@
+#ifndef Magnum_DartIntegration_WorldBatch_h
+#define Magnum_DartIntegration_WorldBatch_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::DartIntegration::WorldBatch
+ * @m_since_latest_{integration}
+ */
+
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/Pointer.h>
+#include <Corrade/Containers/Reference.h>
+#include <Corrade/PluginManager/PluginManager.h>
+#include <Magnum/Magnum.h>
+#include <Magnum/Trade/Trade.h>
+
+#include "Magnum/DartIntegration/DartIntegration.h"
+#include "Magnum/DartIntegration/visibility.h"
+
+namespace Magnum { namespace DartIntegration {
+
+namespace Implementation {
+    struct WorldSharedData;
+}
+
+/**
+@brief Batch of DART worlds
+@m_since_latest_{integration}
+
+Steps and refreshes many independent @ref World instances on a shared thread
+pool. Useful for example for running many simulation rollouts at once, where
+each @ref World is too small to benefit from @ref World::setThreadCount() on
+its own.
+
+@section DartIntegration-WorldBatch-usage Usage
+
+Construct the worlds with
+@ref World::World(WorldBatch&, T&, dart::simulation::World&, Flags), which
+adds them to the batch. Then call @ref step() and @ref refresh() on the batch
+instead of on each world. If only some of the worlds are rendered, pass just
+those to @ref refresh(Containers::ArrayView<const Containers::Reference<World>>),
+the others don't need their scene graph updated:
+
+@snippet DartIntegration.cpp WorldBatch-usage
+
+@section DartIntegration-WorldBatch-sharing Shared resources
+
+All worlds in the batch use the importer plugin manager, the importer instance
+and the mesh caches of the batch. Identical primitive shapes in different
+worlds then share a single unit mesh and, with @ref World::Flag::ShareDrawData
+enabled, identical mesh shapes in different worlds share a single
+@ref DrawData instance, meaning a mesh file used by all worlds is imported
+and uploaded to the GPU just once.
+
+Threads for @ref World::Flag::AsyncImport are still created for each world
+that has the flag enabled, each with its own importer instance, so
+@ref World::setImportThreadCount() applies to each world separately. As the
+plugin manager isn't thread-safe, all its use --- importer instantiation and
+destruction and texture image import --- is serialized across all import
+threads of all worlds in the batch and the thread calling @ref refresh(),
+only the geometry import runs in parallel. With many worlds importing at the
+same time it's thus better to keep the per-world thread count low.
+
+@section DartIntegration-WorldBatch-parallel Parallel stepping and refresh
+
+@ref step() calls @cpp dart::simulation::World::step() @ce for each world,
+with the worlds being distributed among the threads dynamically --- a thread
+that's done with a world picks the next one that's not taken yet, so worlds
+with vastly different complexity don't make the other threads idle.
+
+The @ref refresh() is done in parallel only for worlds that have
+@ref World::Flag::IncrementalRefresh enabled and have no structure change
+pending. For those, transformations of all skeletons of all such worlds are
+calculated in parallel, again distributed dynamically, and then applied
+serially on the calling thread, same as with @ref World::setThreadCount().
+The remaining worlds, such as the ones that are being refreshed for the first
+time, have pending asynchronous imports or have the simulation thread
+running, are refreshed with @ref World::refresh() directly on the calling
+thread, as the tree walk creates scene graph objects and uploads data to the
+GPU.
+
+The DART worlds shouldn't be modified from other threads during
+@ref step() and @ref refresh().
+*/
+class MAGNUM_DARTINTEGRATION_EXPORT WorldBatch {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * Creates a private instance of @ref Trade::AbstractImporter plugin
+         * manager for importing model data, shared by all worlds in the
+         * batch.
+         */
+        explicit WorldBatch();
+
+        /**
+         * @brief Construct with an external importer plugin manager
+         *
+         * The @p importerManager is expected to be in scope for the whole
+         * lifetime of the @ref WorldBatch instance.
+         */
+        explicit WorldBatch(PluginManager::Manager<Trade::AbstractImporter>& importerManager);
+
+        /** @brief Copying is not allowed */
+        WorldBatch(const WorldBatch&) = delete;
+
+        /**
+         * @brief Moving is not allowed
+         *
+         * The worlds keep a pointer to the batch.
+         */
+        WorldBatch(WorldBatch&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Expects that all worlds in the batch were already destroyed.
+         */
+        ~WorldBatch();
+
+        /** @brief Copying is not allowed */
+        WorldBatch& operator=(const WorldBatch&) = delete;
+
+        /** @brief Moving is not allowed */
+        WorldBatch& operator=(WorldBatch&&) = delete;
+
+        /**
+         * @brief Worlds in the batch
+         *
+         * In order they were constructed in, with destroyed worlds removed.
+         * The view is valid until a world is constructed or destroyed.
+         */
+        Containers::ArrayView<const Containers::Reference<World>> worlds() const;
+
+        /** @brief Thread count used by @ref step() and @ref refresh() */
+        UnsignedInt threadCount() const;
+
+        /**
+         * @brief Set thread count used by @ref step() and @ref refresh()
+         * @return Reference to self (for method chaining)
+         *
+         * Default is @cpp 1 @ce, which means everything is done on the
+         * calling thread. A value larger than @cpp 1 @ce spawns
+         * @cpp count - 1 @ce worker threads that work in parallel with the
+         * calling thread. A value of @cpp 0 @ce uses the number of hardware
+         * threads.
+         */
+        WorldBatch& setThreadCount(UnsignedInt count);
+
+        /**
+         * @brief Do a DART world step in all worlds
+         * @return Reference to self (for method chaining)
+         *
+         * Equivalent to calling @ref World::step() on all worlds in
+         * @ref worlds(), except that it's done in parallel. Expects that the
+         * simulation thread isn't running in any of the worlds.
+         */
+        WorldBatch& step(bool resetCommand = true);
+
+        /**
+         * @brief Do a DART world step in given worlds
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that all @p worlds are a part of this batch and that the
+         * simulation thread isn't running in any of them.
+         */
+        WorldBatch& step(Containers::ArrayView<const Containers::Reference<World>> worlds, bool resetCommand = true);
+
+        /**
+         * @brief Refresh all worlds
+         * @return Reference to self (for method chaining)
+         *
+         * Equivalent to calling @ref World::refresh() on all worlds in
+         * @ref worlds(), except that it's partially done in parallel. See
+         * @ref DartIntegration-WorldBatch-parallel for more information.
+         */
+        WorldBatch& refresh();
+
+        /**
+         * @brief Refresh given worlds
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that all @p worlds are a part of this batch. Worlds that
+         * aren't listed are not touched, their objects keep the
+         * transformations from their last refresh.
+         */
+        WorldBatch& refresh(Containers::ArrayView<const Containers::Reference<World>> worlds);
+
+    private:
+        friend World;
+        struct State;
+
+        Implementation::WorldSharedData& MAGNUM_DARTINTEGRATION_LOCAL shared();
+        void MAGNUM_DARTINTEGRATION_LOCAL addWorld(World& world);
+        void MAGNUM_DARTINTEGRATION_LOCAL removeWorld(World& world);
+
+        Containers::Pointer<State> _state;
+};
+
+}}
+
+#endif
@@ -41,16 +41,67 @@ from any @relativeref{Corrade,Containers::StridedArrayView1D} or
 
 @snippet EigenIntegration.cpp DynamicMatrixIntegration
 
+Views of @ref Math::Vector types, such as mesh attributes coming from
+@ref Trade::MeshData::mutableAttribute(), are mapped to an Eigen matrix with a
+compile-time row count instead, each column being one vector. Eigen can then
+use kernels specialized for the fixed column size. Such an Eigen expression can
+be converted back to a view of @ref Math::Vector types as well:
+
+@snippet EigenIntegration.cpp DynamicMatrixIntegration-vectors
+
 @see @ref types-thirdparty-integration
 */
 
 #include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
 #include <Magnum/Magnum.h>
+#include <Magnum/Math/TypeTraits.h>
+#include <Magnum/Math/Vector4.h>
 
 #include <Eigen/Core>
 
 namespace Magnum { namespace EigenIntegration {
 
+namespace Implementation {
+    /* Eigen matrix type with a column for each vector in a view */
+    template<class T> struct VectorMatrix {
+        typedef typename T::Type Scalar;
+        typedef Eigen::Matrix<typename T::Type, T::Size, Eigen::Dynamic> Type;
+    };
+    template<class T> struct VectorMatrix<const T> {
+        typedef const typename T::Type Scalar;
+        typedef const Eigen::Matrix<typename T::Type, T::Size, Eigen::Dynamic> Type;
+    };
+
+    /* Math vector type for each column of an Eigen matrix. Picking the
+       subclasses for 2, 3 and 4 components so they can be used directly with
+       Magnum APIs such as Trade::MeshData. */
+    template<std::size_t size, class T> struct ColumnVector {
+        typedef Math::Vector<size, T> Type;
+    };
+    template<class T> struct ColumnVector<2, T> {
+        typedef Math::Vector2<T> Type;
+    };
+    template<class T> struct ColumnVector<3, T> {
+        typedef Math::Vector3<T> Type;
+    };
+    template<class T> struct ColumnVector<4, T> {
+        typedef Math::Vector4<T> Type;
+    };
+
+    /* Eigen matrix type, const if T is const */
+    template<class T, int rows, int cols, int options = 0> struct MapMatrix {
+        typedef Eigen::Matrix<T, rows, cols, options> Type;
+    };
+    template<class T, int rows, int cols, int options> struct MapMatrix<const T, rows, cols, options> {
+        typedef const Eigen::Matrix<T, rows, cols, options> Type;
+    };
+
+    template<int alignment> inline bool isAligned(const void* data) {
+        return reinterpret_cast<std::uintptr_t>(data) % (alignment ? alignment : 1) == 0;
+    }
+}
+
 /**
 @brief Convert a @relativeref{Corrade,Containers::StridedArrayView2D} to Eigen's dynamic matrix type
 @m_since_latest
@@ -91,10 +142,122 @@ template<class T> inline Eigen::Map<Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dyna
 Since for a one-dimensional @relativeref{Corrade,Containers::StridedArrayView}
 there is no column or row version, we always return an Eigen column vector.
 */
-template<class T> inline Eigen::Map<Eigen::Matrix<T, Eigen::Dynamic, 1>, Eigen::Unaligned, Eigen::InnerStride<>> arrayCast(const Containers::StridedArrayView1D<T>& from) {
+template<class T
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    , typename std::enable_if<!Math::IsVector<typename std::remove_const<T>::type>::value, int>::type = 0
+    #endif
+> inline Eigen::Map<Eigen::Matrix<T, Eigen::Dynamic, 1>, Eigen::Unaligned, Eigen::InnerStride<>> arrayCast(const Containers::StridedArrayView1D<T>& from) {
     return Eigen::Map<Eigen::Matrix<T, Eigen::Dynamic, 1>, Eigen::Unaligned, Eigen::InnerStride<>>(reinterpret_cast<T*>(from.data()), from.size(), Eigen::InnerStride<>(from.stride()/sizeof(T)));
 }
 
+/**
+@brief Convert a @relativeref{Corrade,Containers::StridedArrayView1D} of vectors to Eigen's matrix type with a fixed row count
+@m_since_latest_{integration}
+
+Picked if @p T is a @ref Math::Vector or any of its subclasses, including
+@cpp const @ce ones. Returns an
+@cpp Eigen::Map<Eigen::Matrix<T::Type, T::Size, Eigen::Dynamic>, Eigen::Unaligned, Eigen::OuterStride<>> @ce,
+where each column is one vector of the view. As the vector components are
+always contiguous, the inner stride is known at compile time and only the
+outer stride is dynamic. Expects that the view stride is a multiple of the
+vector component size.
+*/
+template<class T
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    , typename std::enable_if<Math::IsVector<typename std::remove_const<T>::type>::value, int>::type = 0
+    #endif
+> inline Eigen::Map<typename Implementation::VectorMatrix<T>::Type, Eigen::Unaligned, Eigen::OuterStride<>> arrayCast(const Containers::StridedArrayView1D<T>& from) {
+    typedef typename Implementation::VectorMatrix<T>::Scalar Scalar;
+    typedef Eigen::Map<typename Implementation::VectorMatrix<T>::Type, Eigen::Unaligned, Eigen::OuterStride<>> Map;
+    CORRADE_ASSERT(from.stride() % std::ptrdiff_t(sizeof(Scalar)) == 0,
+        "EigenIntegration::arrayCast(): expected stride to be a multiple of" << sizeof(Scalar) << "but got" << from.stride(),
+        (Map{nullptr, T::Size, 0, Eigen::OuterStride<>{T::Size}}));
+    return Map{reinterpret_cast<Scalar*>(from.data()), T::Size, Eigen::Index(from.size()), Eigen::OuterStride<>{from.stride()/std::ptrdiff_t(sizeof(Scalar))}};
+}
+
+/**
+@brief Convert a contiguous @relativeref{Corrade,Containers::StridedArrayView2D} to Eigen's dynamic matrix type
+@m_since_latest_{integration}
+
+Unlike @ref arrayCast(const Containers::StridedArrayView2D<T>&), which can
+represent any view but makes Eigen fall back to scalar code, the returned
+@m_class{m-doc-external} [Eigen::Map](https://eigen.tuxfamily.org/dox/classEigen_1_1Map.html)
+has a compile-time inner stride of @cpp 1 @ce and the @p alignment passed
+through to Eigen, such as @cpp Eigen::Aligned16 @ce or
+@cpp Eigen::Unaligned @ce. That allows Eigen to use vectorized kernels in
+matrix products. Expects that the second dimension of the view is contiguous
+and that the view data are aligned to @p alignment. As rows are contiguous
+in that case, the result is a row-major matrix. For a view where the first
+dimension is contiguous instead, such as a view onto a column-major Eigen
+matrix, use its @relativeref{Corrade::Containers::StridedArrayView,transposed()}
+and transpose the result back on the Eigen side:
+
+@snippet EigenIntegration.cpp DynamicMatrixIntegration-contiguous
+*/
+template<int alignment, class T
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    , typename std::enable_if<!Math::IsVector<typename std::remove_const<T>::type>::value, int>::type = 0
+    #endif
+> inline Eigen::Map<typename Implementation::MapMatrix<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>::Type, alignment, Eigen::OuterStride<>> arrayCast(const Containers::StridedArrayView2D<T>& from) {
+    typedef Eigen::Map<typename Implementation::MapMatrix<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>::Type, alignment, Eigen::OuterStride<>> Map;
+    CORRADE_ASSERT(from.stride()[1] == std::ptrdiff_t(sizeof(T)) && from.stride()[0] % std::ptrdiff_t(sizeof(T)) == 0,
+        "EigenIntegration::arrayCast(): expected a view with contiguous rows of" << sizeof(T) << Debug::nospace << "-byte items but got a stride of" << from.stride()[0] << "and" << from.stride()[1],
+        (Map{nullptr, 0, 0, Eigen::OuterStride<>{0}}));
+    CORRADE_ASSERT(Implementation::isAligned<alignment>(from.data()),
+        "EigenIntegration::arrayCast(): expected the view data to be aligned to" << alignment << "bytes",
+        (Map{nullptr, 0, 0, Eigen::OuterStride<>{0}}));
+    return Map{static_cast<T*>(from.data()), Eigen::Index(from.size()[0]), Eigen::Index(from.size()[1]), Eigen::OuterStride<>{from.stride()[0]/std::ptrdiff_t(sizeof(T))}};
+}
+
+/**
+@brief Convert a contiguous @relativeref{Corrade,Containers::StridedArrayView1D} to Eigen's dynamic vector type
+@m_since_latest_{integration}
+
+Like @ref arrayCast(const Containers::StridedArrayView1D<T>&), but the
+returned @m_class{m-doc-external} [Eigen::Map](https://eigen.tuxfamily.org/dox/classEigen_1_1Map.html)
+has no stride and the @p alignment passed through to Eigen. Expects that the
+view is contiguous and its data are aligned to @p alignment.
+*/
+template<int alignment, class T
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    , typename std::enable_if<!Math::IsVector<typename std::remove_const<T>::type>::value, int>::type = 0
+    #endif
+> inline Eigen::Map<typename Implementation::MapMatrix<T, Eigen::Dynamic, 1>::Type, alignment> arrayCast(const Containers::StridedArrayView1D<T>& from) {
+    typedef Eigen::Map<typename Implementation::MapMatrix<T, Eigen::Dynamic, 1>::Type, alignment> Map;
+    CORRADE_ASSERT(from.isContiguous(),
+        "EigenIntegration::arrayCast(): expected a contiguous view of" << sizeof(T) << Debug::nospace << "-byte items but got a stride of" << from.stride(),
+        (Map{nullptr, 0}));
+    CORRADE_ASSERT(Implementation::isAligned<alignment>(from.data()),
+        "EigenIntegration::arrayCast(): expected the view data to be aligned to" << alignment << "bytes",
+        (Map{nullptr, 0}));
+    return Map{static_cast<T*>(from.data()), Eigen::Index(from.size())};
+}
+
+/**
+@brief Convert a contiguous @relativeref{Corrade,Containers::StridedArrayView1D} of vectors to Eigen's matrix type with a fixed row count
+@m_since_latest_{integration}
+
+Like @ref arrayCast(const Containers::StridedArrayView1D<T>&) for vector types,
+but the returned @m_class{m-doc-external} [Eigen::Map](https://eigen.tuxfamily.org/dox/classEigen_1_1Map.html)
+has no stride and the @p alignment passed through to Eigen. Expects that the
+view is contiguous and its data are aligned to @p alignment.
+*/
+template<int alignment, class T
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    , typename std::enable_if<Math::IsVector<typename std::remove_const<T>::type>::value, int>::type = 0
+    #endif
+> inline Eigen::Map<typename Implementation::VectorMatrix<T>::Type, alignment> arrayCast(const Containers::StridedArrayView1D<T>& from) {
+    typedef typename Implementation::VectorMatrix<T>::Scalar Scalar;
+    typedef Eigen::Map<typename Implementation::VectorMatrix<T>::Type, alignment> Map;
+    CORRADE_ASSERT(from.isContiguous(),
+        "EigenIntegration::arrayCast(): expected a contiguous view of" << sizeof(T) << Debug::nospace << "-byte items but got a stride of" << from.stride(),
+        (Map{nullptr, T::Size, 0}));
+    CORRADE_ASSERT(Implementation::isAligned<alignment>(from.data()),
+        "EigenIntegration::arrayCast(): expected the view data to be aligned to" << alignment << "bytes",
+        (Map{nullptr, T::Size, 0}));
+    return Map{reinterpret_cast<Scalar*>(from.data()), T::Size, Eigen::Index(from.size())};
+}
+
 /**
 @brief Convert an Eigen expression to @relativeref{Corrade,Containers::StridedArrayView1D}
 @m_since_latest
@@ -143,6 +306,35 @@ template<class Derived
     };
 }
 
+/**
+@brief Convert an Eigen expression with a fixed row count to a @relativeref{Corrade,Containers::StridedArrayView1D} of vectors
+@m_since_latest_{integration}
+
+Picked if the Eigen expression has more than one row and a dynamic column count
+known at compile time, such as the output of the vector @ref arrayCast(const Containers::StridedArrayView1D<T>&)
+overload. Each column is mapped to a @ref Math::Vector, or a
+@ref Math::Vector2, @ref Math::Vector3 or @ref Math::Vector4 for two, three
+and four rows. Expects that the column elements are contiguous in memory.
+*/
+template<class Derived
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    , typename std::enable_if<
+        Eigen::internal::traits<Derived>::RowsAtCompileTime != Eigen::Dynamic &&
+        Eigen::internal::traits<Derived>::RowsAtCompileTime != 1 &&
+        Eigen::internal::traits<Derived>::ColsAtCompileTime == Eigen::Dynamic, int>::type = 0
+    #endif
+> inline Containers::StridedArrayView1D<typename Implementation::ColumnVector<Eigen::internal::traits<Derived>::RowsAtCompileTime, typename Derived::Scalar>::Type> arrayCast(const Eigen::DenseCoeffsBase<Derived, Eigen::DirectWriteAccessors>& from) {
+    CORRADE_ASSERT(from.rowStride() == 1,
+        "EigenIntegration::arrayCast(): expected contiguous columns but got a row stride of" << from.rowStride(), {});
+    return {
+        /* We assume that the memory the Eigen expression is referencing is in
+           bounds, so the view size passed is ~std::size_t{} */
+        {const_cast<typename Derived::Scalar*>(&from(0,0)), ~std::size_t{}},
+        std::size_t(from.cols()),
+        std::ptrdiff_t(from.colStride()*sizeof(typename Derived::Scalar))
+    };
+}
+
 /**
 @brief Convert an Eigen reverse expression to @relativeref{Corrade,Containers::StridedArrayView1D}
 @m_since_latest
@@ -48,11 +48,20 @@ Example usage:
 
 @snippet EigenIntegration.cpp GeometryIntegration
 
+For converting large arrays of transformations or rotations, such as poses of
+a robot or an animation, use @ref Magnum::EigenIntegration::convertInto() "EigenIntegration::convertInto()",
+which copies the data directly without going through temporaries:
+
+@snippet EigenIntegration.cpp GeometryIntegration-convertInto
+
 @see @ref types-thirdparty-integration
 
 */
 
+#include <cstring>
 #include <Eigen/Geometry>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
 #include <Magnum/Math/Quaternion.h>
 #include <Magnum/Math/Range.h>
 
@@ -142,6 +151,88 @@ template<UnsignedInt dimensions, class T> struct RangeConverter<dimensions, T, E
 
 namespace EigenIntegration {
 
+namespace Implementation {
+    /* Magnum type having the same memory layout as given Eigen geometry
+       type. Transforms other than AffineCompact are a full square matrix, the
+       compact ones have the last row omitted in both. Eigen quaternions are
+       stored as x, y, z, w, same as Magnum. */
+    template<class> struct GeometryLayout {};
+    template<class T, int mode> struct GeometryLayout<Eigen::Transform<T, 2, mode>> {
+        typedef Math::RectangularMatrix<3, 3, T> Type;
+    };
+    template<class T, int mode> struct GeometryLayout<Eigen::Transform<T, 3, mode>> {
+        typedef Math::RectangularMatrix<4, 4, T> Type;
+    };
+    template<class T> struct GeometryLayout<Eigen::Transform<T, 2, Eigen::AffineCompact>> {
+        typedef Math::RectangularMatrix<3, 2, T> Type;
+    };
+    template<class T> struct GeometryLayout<Eigen::Transform<T, 3, Eigen::AffineCompact>> {
+        typedef Math::RectangularMatrix<4, 3, T> Type;
+    };
+    template<class T> struct GeometryLayout<Eigen::Quaternion<T>> {
+        typedef Math::Quaternion<T> Type;
+    };
+
+    template<class From, class To> void convertInto(const Containers::StridedArrayView1D<From>& src, const Containers::StridedArrayView1D<To>& dst) {
+        static_assert(sizeof(From) == sizeof(To), "types have a different size");
+        CORRADE_ASSERT(src.size() == dst.size(),
+            "EigenIntegration::convertInto(): expected source and destination views to have the same size, got" << src.size() << "and" << dst.size(), );
+
+        /* A single copy if both are contiguous, otherwise per-item. Casting to
+           a void pointer to avoid warnings about Eigen types not being
+           trivially copyable. */
+        if(src.isContiguous() && dst.isContiguous()) {
+            if(src.size()) std::memcpy(dst.data(), src.data(), src.size()*sizeof(From));
+            return;
+        }
+        for(std::size_t i = 0; i != src.size(); ++i)
+            std::memcpy(static_cast<void*>(&dst[i]), static_cast<const void*>(&src[i]), sizeof(From));
+    }
+}
+
+/**
+@brief Convert a list of Eigen transformations or quaternions
+@m_since_latest_{integration}
+
+Accepts a view on any Eigen type from the table in
+@ref Magnum/EigenIntegration/GeometryIntegration.h except
+@m_class{m-doc-external} [Eigen::Translation](https://eigen.tuxfamily.org/dox/classEigen_1_1Translation.html)
+and @m_class{m-doc-external} [Eigen::AlignedBox](https://eigen.tuxfamily.org/dox/classEigen_1_1AlignedBox.html)
+and a view on the equivalent Magnum type or any of its subclasses, such as
+@ref Magnum::Matrix4 "Matrix4" for
+@m_class{m-doc-external} [Eigen::Isometry3f](https://eigen.tuxfamily.org/dox/classEigen_1_1Transform.html).
+Expects that both views have the same size. Equivalent to converting each
+element separately, but as the types have the same memory layout, the data is
+copied directly, with a single copy if both views are contiguous. A
+@m_class{m-doc-external} [std::vector](https://en.cppreference.com/w/cpp/container/vector)
+of Eigen types can be passed through @relativeref{Corrade,Containers::stridedArrayView()}
+if @ref Corrade/Containers/ArrayViewStl.h is included.
+*/
+template<class From, class To
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    , typename std::enable_if<std::is_base_of<typename Implementation::GeometryLayout<typename std::remove_const<From>::type>::Type, To>::value, int>::type = 0
+    #endif
+> inline void convertInto(const Containers::StridedArrayView1D<From>& src, const Containers::StridedArrayView1D<To>& dst) {
+    Implementation::convertInto(src, dst);
+}
+
+/**
+@brief Convert a list of transformations or quaternions to Eigen types
+@m_since_latest_{integration}
+
+Inverse to the above. The data is copied as-is, which means for example that converting a
+@ref Magnum::Matrix4 "Matrix4" with a non-rigid transformation to an
+@m_class{m-doc-external} [Eigen::Isometry3f](https://eigen.tuxfamily.org/dox/classEigen_1_1Transform.html)
+isn't checked in any way, consistently with converting a single value.
+*/
+template<class From, class To
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    , typename std::enable_if<std::is_base_of<typename Implementation::GeometryLayout<To>::Type, typename std::remove_const<From>::type>::value, int>::type = 0
+    #endif
+> inline void convertInto(const Containers::StridedArrayView1D<From>& src, const Containers::StridedArrayView1D<To>& dst) {
+    Implementation::convertInto(src, dst);
+}
+
 /**
 @brief Convert a Magnum type to Eigen type
 @m_since{2019,10}
@@ -0,0 +1,279 @@
+#ifndef Magnum_EigenIntegration_SparseMatrixIntegration_h
+#define Magnum_EigenIntegration_SparseMatrixIntegration_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+@brief Conversion of Eigen sparse matrix types
+@m_since_latest_{integration}
+
+Complements @ref Magnum/EigenIntegration/DynamicMatrixIntegration.h with
+interoperability between @m_class{m-doc-external} [Eigen::SparseMatrix](https://eigen.tuxfamily.org/dox/classEigen_1_1SparseMatrix.html)
+and @ref Corrade::Containers::Array "Containers::Array". Data in the compressed
+sparse column (CSC) or compressed sparse row (CSR) format can be mapped to an
+@m_class{m-doc-external} [Eigen::Map](https://eigen.tuxfamily.org/dox/classEigen_1_1Map_3_01SparseMatrixType_01_4.html)
+using @ref EigenIntegration::mapSparseMatrix() without any copy, and copied
+from an Eigen sparse matrix to a @ref EigenIntegration::SparseMatrixData
+using @ref EigenIntegration::sparseMatrixData(). Additionally,
+@ref EigenIntegration::meshAdjacency() builds a vertex adjacency matrix
+directly from mesh indices, without going through an intermediate triplet
+list:
+
+@snippet EigenIntegration.cpp SparseMatrixIntegration
+
+@see @ref types-thirdparty-integration
+*/
+
+#include <algorithm>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
+#include <Magnum/Magnum.h>
+#include <Magnum/Math/Functions.h>
+
+#include <Eigen/SparseCore>
+
+namespace Magnum { namespace EigenIntegration {
+
+/**
+@brief Compressed sparse matrix data
+@m_since_latest_{integration}
+
+Owning counterpart to an @m_class{m-doc-external} [Eigen::Map](https://eigen.tuxfamily.org/dox/classEigen_1_1Map_3_01SparseMatrixType_01_4.html)
+of an @m_class{m-doc-external} [Eigen::SparseMatrix<T, options, I>](https://eigen.tuxfamily.org/dox/classEigen_1_1SparseMatrix.html)
+in the compressed form. The @p options are either @cpp Eigen::ColMajor @ce
+for the compressed sparse column (CSC) format or @cpp Eigen::RowMajor @ce for
+the compressed sparse row (CSR) format. The outer dimension is columns in the
+first case and rows in the second.
+@see @ref mapSparseMatrix(), @ref sparseMatrixData(), @ref meshAdjacency()
+*/
+template<class T, int options = Eigen::ColMajor, class I = int> struct SparseMatrixData {
+    /** @brief Row count */
+    Eigen::Index rows{};
+
+    /** @brief Column count */
+    Eigen::Index cols{};
+
+    /**
+     * @brief Outer indices
+     *
+     * Offset of the first non-zero item of each column (or row, for
+     * @cpp Eigen::RowMajor @ce) in @ref innerIndices and @ref values,
+     * followed by the total non-zero item count. The size is the outer
+     * dimension size plus one.
+     */
+    Containers::Array<I> outerIndices;
+
+    /**
+     * @brief Inner indices
+     *
+     * Row (or column, for @cpp Eigen::RowMajor @ce) index of each non-zero
+     * item, sorted for each outer index.
+     */
+    Containers::Array<I> innerIndices;
+
+    /** @brief Non-zero values */
+    Containers::Array<T> values;
+};
+
+/**
+@brief Map compressed sparse data to Eigen's sparse matrix type
+@m_since_latest_{integration}
+
+The @p options are either @cpp Eigen::ColMajor @ce for the compressed sparse
+column (CSC) format or @cpp Eigen::RowMajor @ce for the compressed sparse row
+(CSR) format. Expects that the size of @p outerIndices is the outer dimension
+size plus one and that @p innerIndices and @p values have the same size, at
+least as large as the non-zero item count given by the last item of
+@p outerIndices. The data are not copied, the returned
+@m_class{m-doc-external} [Eigen::Map](https://eigen.tuxfamily.org/dox/classEigen_1_1Map_3_01SparseMatrixType_01_4.html)
+points to the original memory.
+*/
+template<int options = Eigen::ColMajor, class T, class I
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    , typename std::enable_if<!std::is_const<T>::value && !std::is_const<I>::value, int>::type = 0
+    #endif
+> inline Eigen::Map<Eigen::SparseMatrix<T, options, I>> mapSparseMatrix(const Eigen::Index rows, const Eigen::Index cols, const Containers::ArrayView<I> outerIndices, const Containers::ArrayView<I> innerIndices, const Containers::ArrayView<T> values) {
+    CORRADE_ASSERT(outerIndices.size() == std::size_t((options & Eigen::RowMajor ? rows : cols) + 1),
+        "EigenIntegration::mapSparseMatrix(): expected" << (options & Eigen::RowMajor ? rows : cols) + 1 << "outer indices but got" << outerIndices.size(),
+        (Eigen::Map<Eigen::SparseMatrix<T, options, I>>{0, 0, 0, outerIndices.data(), innerIndices.data(), values.data()}));
+    CORRADE_ASSERT(innerIndices.size() == values.size() && values.size() >= std::size_t(outerIndices.back()),
+        "EigenIntegration::mapSparseMatrix(): expected" << outerIndices.back() << "inner indices and values but got" << innerIndices.size() << "and" << values.size(),
+        (Eigen::Map<Eigen::SparseMatrix<T, options, I>>{0, 0, 0, outerIndices.data(), innerIndices.data(), values.data()}));
+    return Eigen::Map<Eigen::SparseMatrix<T, options, I>>{rows, cols, Eigen::Index(outerIndices.back()), outerIndices.data(), innerIndices.data(), values.data()};
+}
+
+/**
+@overload
+@m_since_latest_{integration}
+
+Returns a map of a @cpp const @ce sparse matrix.
+*/
+template<int options = Eigen::ColMajor, class T, class I> inline Eigen::Map<const Eigen::SparseMatrix<T, options, I>> mapSparseMatrix(const Eigen::Index rows, const Eigen::Index cols, const Containers::ArrayView<const I> outerIndices, const Containers::ArrayView<const I> innerIndices, const Containers::ArrayView<const T> values) {
+    CORRADE_ASSERT(outerIndices.size() == std::size_t((options & Eigen::RowMajor ? rows : cols) + 1),
+        "EigenIntegration::mapSparseMatrix(): expected" << (options & Eigen::RowMajor ? rows : cols) + 1 << "outer indices but got" << outerIndices.size(),
+        (Eigen::Map<const Eigen::SparseMatrix<T, options, I>>{0, 0, 0, outerIndices.data(), innerIndices.data(), values.data()}));
+    CORRADE_ASSERT(innerIndices.size() == values.size() && values.size() >= std::size_t(outerIndices.back()),
+        "EigenIntegration::mapSparseMatrix(): expected" << outerIndices.back() << "inner indices and values but got" << innerIndices.size() << "and" << values.size(),
+        (Eigen::Map<const Eigen::SparseMatrix<T, options, I>>{0, 0, 0, outerIndices.data(), innerIndices.data(), values.data()}));
+    return Eigen::Map<const Eigen::SparseMatrix<T, options, I>>{rows, cols, Eigen::Index(outerIndices.back()), outerIndices.data(), innerIndices.data(), values.data()};
+}
+
+/**
+@brief Map sparse matrix data to Eigen's sparse matrix type
+@m_since_latest_{integration}
+
+Equivalent to calling @ref mapSparseMatrix(Eigen::Index, Eigen::Index, Containers::ArrayView<I>, Containers::ArrayView<I>, Containers::ArrayView<T>)
+with contents of @p data.
+*/
+template<class T, int options, class I> inline Eigen::Map<Eigen::SparseMatrix<T, options, I>> mapSparseMatrix(SparseMatrixData<T, options, I>& data) {
+    return mapSparseMatrix<options>(data.rows, data.cols, Containers::arrayView(data.outerIndices), Containers::arrayView(data.innerIndices), Containers::arrayView(data.values));
+}
+
+/**
+@overload
+@m_since_latest_{integration}
+*/
+template<class T, int options, class I> inline Eigen::Map<const Eigen::SparseMatrix<T, options, I>> mapSparseMatrix(const SparseMatrixData<T, options, I>& data) {
+    return mapSparseMatrix<options>(data.rows, data.cols, Containers::arrayView(data.outerIndices), Containers::arrayView(data.innerIndices), Containers::arrayView(data.values));
+}
+
+/**
+@brief Copy Eigen's sparse matrix to compressed sparse data
+@m_since_latest_{integration}
+
+The matrix doesn't need to be in the compressed form, the output always is.
+Use @ref mapSparseMatrix(SparseMatrixData<T, options, I>&) to get an Eigen
+sparse matrix view on the data again.
+*/
+template<class T, int options, class I> SparseMatrixData<T, options, I> sparseMatrixData(const Eigen::SparseMatrix<T, options, I>& matrix) {
+    SparseMatrixData<T, options, I> out;
+    out.rows = matrix.rows();
+    out.cols = matrix.cols();
+    out.outerIndices = Containers::Array<I>{NoInit, std::size_t(matrix.outerSize() + 1)};
+    out.innerIndices = Containers::Array<I>{NoInit, std::size_t(matrix.nonZeros())};
+    out.values = Containers::Array<T>{NoInit, std::size_t(matrix.nonZeros())};
+
+    /* If the matrix is already compressed, the data can be copied directly */
+    if(matrix.isCompressed()) {
+        std::copy_n(matrix.outerIndexPtr(), out.outerIndices.size(), out.outerIndices.data());
+        std::copy_n(matrix.innerIndexPtr(), out.innerIndices.size(), out.innerIndices.data());
+        std::copy_n(matrix.valuePtr(), out.values.size(), out.values.data());
+        return out;
+    }
+
+    /* Otherwise there are gaps after each outer vector, skip them */
+    I offset = 0;
+    for(Eigen::Index i = 0; i != matrix.outerSize(); ++i) {
+        out.outerIndices[i] = offset;
+        for(typename Eigen::SparseMatrix<T, options, I>::InnerIterator it(matrix, i); it; ++it) {
+            out.innerIndices[offset] = I(it.index());
+            out.values[offset] = it.value();
+            ++offset;
+        }
+    }
+    out.outerIndices[matrix.outerSize()] = offset;
+    return out;
+}
+
+/**
+@brief Build a vertex adjacency matrix from triangle mesh indices
+@m_since_latest_{integration}
+
+Returns a symmetric @p vertexCount × @p vertexCount matrix with @cpp T(1) @ce
+at positions @f$ (i, j) @f$ and @f$ (j, i) @f$ for every pair of vertices
+@f$ i \neq j @f$ sharing a triangle edge. As the matrix is symmetric, it's the
+same in the compressed sparse column and row format. The outer index array is
+calculated from vertex degrees and inner indices are then filled in directly,
+without going through an intermediate triplet list. Expects that the index
+count is divisible by three and all indices are less than @p vertexCount.
+Degenerate triangle edges are skipped.
+
+The output can be used as a base for building for example a graph or a
+cotangent Laplacian, which have the same sparsity pattern with an additional
+diagonal.
+*/
+template<class T = Float, class I = int> SparseMatrixData<T, Eigen::ColMajor, I> meshAdjacency(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const UnsignedInt vertexCount) {
+    CORRADE_ASSERT(indices.size() % 3 == 0,
+        "EigenIntegration::meshAdjacency(): expected index count to be divisible by 3, got" << indices.size(), {});
+
+    /* Count the edges adjacent to each vertex, including duplicates. The
+       first item is left at zero for the prefix sum below. */
+    Containers::Array<I> offsets{ValueInit, std::size_t(vertexCount) + 1};
+    for(std::size_t i = 0; i != indices.size(); ++i) {
+        const UnsignedInt a = indices[i];
+        const UnsignedInt b = indices[i % 3 == 2 ? i - 2 : i + 1];
+        CORRADE_ASSERT(a < vertexCount && b < vertexCount,
+            "EigenIntegration::meshAdjacency(): index" << Math::max(a, b) << "out of range for" << vertexCount << "vertices", {});
+        if(a == b) continue;
+        ++offsets[a + 1];
+        ++offsets[b + 1];
+    }
+    for(UnsignedInt i = 0; i != vertexCount; ++i)
+        offsets[i + 1] += offsets[i];
+
+    /* Fill in the neighbors of each vertex */
+    Containers::Array<I> neighbors{NoInit, std::size_t(offsets[vertexCount])};
+    {
+        Containers::Array<I> fill{NoInit, vertexCount};
+        std::copy_n(offsets.data(), vertexCount, fill.data());
+        for(std::size_t i = 0; i != indices.size(); ++i) {
+            const UnsignedInt a = indices[i];
+            const UnsignedInt b = indices[i % 3 == 2 ? i - 2 : i + 1];
+            if(a == b) continue;
+            neighbors[fill[a]++] = I(b);
+            neighbors[fill[b]++] = I(a);
+        }
+    }
+
+    /* Sort the neighbors of each vertex and remove duplicate edges shared by
+       two triangles, compacting the array in-place */
+    SparseMatrixData<T, Eigen::ColMajor, I> out;
+    out.rows = vertexCount;
+    out.cols = vertexCount;
+    out.outerIndices = Containers::Array<I>{NoInit, std::size_t(vertexCount) + 1};
+    I offset = 0;
+    for(UnsignedInt i = 0; i != vertexCount; ++i) {
+        out.outerIndices[i] = offset;
+        I* const begin = neighbors.data() + offsets[i];
+        I* end = neighbors.data() + offsets[i + 1];
+        std::sort(begin, end);
+        end = std::unique(begin, end);
+        /* The destination is never after the source, but can overlap */
+        for(I* it = begin; it != end; ++it)
+            neighbors[offset++] = *it;
+    }
+    out.outerIndices[vertexCount] = offset;
+
+    out.innerIndices = Containers::Array<I>{NoInit, std::size_t(offset)};
+    std::copy_n(neighbors.data(), offset, out.innerIndices.data());
+    out.values = Containers::Array<T>{DirectInit, std::size_t(offset), T(1)};
+    return out;
+}
+
+}}
+
+#endif
@@ -0,0 +1,188 @@
+#ifndef Magnum_EigenIntegration_TensorIntegration_h
+#define Magnum_EigenIntegration_TensorIntegration_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+@brief Conversion of Eigen tensor types
+@m_since_latest_{integration}
+
+Extends @ref Magnum/EigenIntegration/DynamicMatrixIntegration.h to three and
+more dimensions, making an @m_class{m-doc-external} [Eigen::TensorMap](https://eigen.tuxfamily.org/dox/unsupported/eigen_tensors.html)
+point to a @relativeref{Corrade,Containers::StridedArrayView3D},
+@relativeref{Corrade::Containers,StridedArrayView4D} or a view of a higher
+dimension count and, conversely, a view point to an Eigen tensor using
+@ref EigenIntegration::arrayCast(). This can be used for example to run
+batched kernels on a set of images or per-frame animation data without any
+copy:
+
+@snippet EigenIntegration.cpp TensorIntegration
+
+Unlike @m_class{m-doc-external} [Eigen::Map](https://eigen.tuxfamily.org/dox/classEigen_1_1Map.html),
+a tensor map has no way to express custom strides, so the view is expected to
+be contiguous. As @relativeref{Corrade,Containers::StridedArrayView} orders
+dimensions from the outermost to the innermost, it's mapped to a
+@cpp Eigen::RowMajor @ce tensor, with the indices in the same order as in the
+view. To map a sub-range of a larger contiguous buffer, such as a view of
+padded images, map the whole buffer and use the @m_class{m-doc-external} [slice()](https://eigen.tuxfamily.org/dox/unsupported/eigen_tensors.html)
+operation on the Eigen side.
+
+The header depends on the [Tensor module](https://eigen.tuxfamily.org/dox/unsupported/eigen_tensors.html)
+from Eigen's @cpp unsupported/ @ce directory, which is included in all Eigen
+3.3+ installations but isn't pulled in by the other headers of this library.
+
+@see @ref types-thirdparty-integration
+*/
+
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
+#include <Magnum/Magnum.h>
+
+#include <unsupported/Eigen/CXX11/Tensor>
+
+namespace Magnum { namespace EigenIntegration {
+
+namespace Implementation {
+    /* Eigen tensor type, const if T is const */
+    template<class T, unsigned dimensions> struct MapTensor {
+        typedef Eigen::Tensor<T, dimensions, Eigen::RowMajor> Type;
+    };
+    template<class T, unsigned dimensions> struct MapTensor<const T, dimensions> {
+        typedef const Eigen::Tensor<T, dimensions, Eigen::RowMajor> Type;
+    };
+
+    template<unsigned dimensions, class T, class Dimensions> Containers::StridedArrayView<dimensions, T> tensorView(T* const data, const Dimensions& tensorSize, const bool rowMajor) {
+        Containers::StridedDimensions<dimensions, std::size_t> size;
+        Containers::StridedDimensions<dimensions, std::ptrdiff_t> stride;
+        std::ptrdiff_t next = sizeof(T);
+        for(unsigned i = 0; i != dimensions; ++i) {
+            /* Row-major tensors have the last dimension contiguous, like a
+               contiguous view. Column-major have the first. */
+            const unsigned d = rowMajor ? dimensions - i - 1 : i;
+            size[d] = std::size_t(tensorSize[d]);
+            stride[d] = next;
+            next *= std::ptrdiff_t(tensorSize[d]);
+        }
+
+        return {
+            /* We assume that the memory the Eigen expression is referencing
+               is in bounds, so the view size passed is ~std::size_t{} */
+            {data, ~std::size_t{}}, size, stride
+        };
+    }
+}
+
+/**
+@brief Convert a contiguous @relativeref{Corrade,Containers::StridedArrayView} to Eigen's tensor type
+@m_since_latest_{integration}
+
+Returns an @cpp Eigen::TensorMap<Eigen::Tensor<T, dimensions, Eigen::RowMajor>> @ce,
+where @cpp tensor(i, j, k) @ce is the same item as @cpp view[i][j][k] @ce.
+Expects that the view is contiguous. For a view where the first dimension is
+contiguous instead, such as a view onto a column-major Eigen tensor, use the
+view @relativeref{Corrade::Containers::StridedArrayView,transposed()} to
+reverse the dimension order first. Available only for views of three or more
+dimensions, one- and two-dimensional views are converted to matrices with the
+@ref arrayCast(const Containers::StridedArrayView1D<T>&) and
+@ref arrayCast(const Containers::StridedArrayView2D<T>&) overloads.
+*/
+template<unsigned dimensions, class T
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    , typename std::enable_if<(dimensions >= 3), int>::type = 0
+    #endif
+> inline Eigen::TensorMap<typename Implementation::MapTensor<T, dimensions>::Type> arrayCast(const Containers::StridedArrayView<dimensions, T>& from) {
+    typedef Eigen::TensorMap<typename Implementation::MapTensor<T, dimensions>::Type> Map;
+    Eigen::DSizes<Eigen::Index, dimensions> size;
+    for(unsigned i = 0; i != dimensions; ++i)
+        size[i] = Eigen::Index(from.size()[i]);
+    CORRADE_ASSERT(from.isContiguous(),
+        "EigenIntegration::arrayCast(): expected a contiguous view of" << sizeof(T) << Debug::nospace << "-byte items",
+        (Map{nullptr, size}));
+    return Map{static_cast<T*>(from.data()), size};
+}
+
+/**
+@brief Convert an Eigen tensor to a @relativeref{Corrade,Containers::StridedArrayView}
+@m_since_latest_{integration}
+
+For a @cpp Eigen::RowMajor @ce tensor the view is contiguous and
+@cpp view[i][j][k] @ce is the same item as @cpp tensor(i, j, k) @ce,
+which makes it the inverse of @ref arrayCast(const Containers::StridedArrayView<dimensions, T>&).
+A @cpp Eigen::ColMajor @ce tensor keeps the index order as well, but the
+first dimension of the view is contiguous in that case.
+*/
+template<class T, int dimensions, int options, class I
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    , typename std::enable_if<(dimensions >= 3), int>::type = 0
+    #endif
+> inline Containers::StridedArrayView<dimensions, T> arrayCast(Eigen::Tensor<T, dimensions, options, I>& from) {
+    return Implementation::tensorView<dimensions>(from.data(), from.dimensions(), options & Eigen::RowMajor);
+}
+
+/**
+@overload
+@m_since_latest_{integration}
+*/
+template<class T, int dimensions, int options, class I
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    , typename std::enable_if<(dimensions >= 3), int>::type = 0
+    #endif
+> inline Containers::StridedArrayView<dimensions, const T> arrayCast(const Eigen::Tensor<T, dimensions, options, I>& from) {
+    return Implementation::tensorView<dimensions>(from.data(), from.dimensions(), options & Eigen::RowMajor);
+}
+
+/**
+@brief Convert an Eigen tensor map to a @relativeref{Corrade,Containers::StridedArrayView}
+@m_since_latest_{integration}
+
+Same as @ref arrayCast(Eigen::Tensor<T, dimensions, options, I>&), but for an
+@m_class{m-doc-external} [Eigen::TensorMap](https://eigen.tuxfamily.org/dox/unsupported/eigen_tensors.html)
+such as the one returned by @ref arrayCast(const Containers::StridedArrayView<dimensions, T>&).
+The view is @cpp const @ce if the mapped tensor type is @cpp const @ce.
+*/
+template<class T, int dimensions, int options, class I, int mapOptions
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    , typename std::enable_if<(dimensions >= 3), int>::type = 0
+    #endif
+> inline Containers::StridedArrayView<dimensions, T> arrayCast(const Eigen::TensorMap<Eigen::Tensor<T, dimensions, options, I>, mapOptions>& from) {
+    return Implementation::tensorView<dimensions>(const_cast<T*>(from.data()), from.dimensions(), options & Eigen::RowMajor);
+}
+
+/**
+@overload
+@m_since_latest_{integration}
+*/
+template<class T, int dimensions, int options, class I, int mapOptions
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    , typename std::enable_if<(dimensions >= 3), int>::type = 0
+    #endif
+> inline Containers::StridedArrayView<dimensions, const T> arrayCast(const Eigen::TensorMap<const Eigen::Tensor<T, dimensions, options, I>, mapOptions>& from) {
+    return Implementation::tensorView<dimensions>(from.data(), from.dimensions(), options & Eigen::RowMajor);
+}
+
+}}
+
+#endif
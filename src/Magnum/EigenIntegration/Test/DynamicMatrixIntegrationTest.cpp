@@ -25,9 +25,11 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <Corrade/Containers/String.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
 #include <Magnum/Magnum.h>
+#include <Magnum/Math/Vector3.h>
 
 #include "Magnum/EigenIntegration/DynamicMatrixIntegration.h"
 
@@ -40,16 +42,37 @@ struct DynamicMatrixIntegrationTest: TestSuite::Tester {
     void transpose();
     void reverse();
     void broadcasted();
+    void vectors();
+    void vectorsConst();
+    void vectorsInvalidStride();
+    void vectorsFromEigenNotContiguous();
+
+    void contiguous();
+    void contiguous1D();
+    void contiguousVectors();
+    void contiguousNotContiguous();
+    void contiguousNotAligned();
 };
 
 using Map2Df = Eigen::Map<Eigen::MatrixXf, Eigen::Unaligned, Eigen::Stride<Eigen::Dynamic, Eigen::Dynamic>>;
 using Map1Df = Eigen::Map<Eigen::VectorXf, Eigen::Unaligned, Eigen::InnerStride<>>;
+using Map3Xf = Eigen::Map<Eigen::Matrix3Xf, Eigen::Unaligned, Eigen::OuterStride<>>;
 
 DynamicMatrixIntegrationTest::DynamicMatrixIntegrationTest() {
     addTests({&DynamicMatrixIntegrationTest::block,
               &DynamicMatrixIntegrationTest::transpose,
               &DynamicMatrixIntegrationTest::reverse,
-              &DynamicMatrixIntegrationTest::broadcasted});
+              &DynamicMatrixIntegrationTest::broadcasted,
+              &DynamicMatrixIntegrationTest::vectors,
+              &DynamicMatrixIntegrationTest::vectorsConst,
+              &DynamicMatrixIntegrationTest::vectorsInvalidStride,
+              &DynamicMatrixIntegrationTest::vectorsFromEigenNotContiguous,
+
+              &DynamicMatrixIntegrationTest::contiguous,
+              &DynamicMatrixIntegrationTest::contiguous1D,
+              &DynamicMatrixIntegrationTest::contiguousVectors,
+              &DynamicMatrixIntegrationTest::contiguousNotContiguous,
+              &DynamicMatrixIntegrationTest::contiguousNotAligned});
 }
 
 void DynamicMatrixIntegrationTest::block() {
@@ -188,6 +211,168 @@ void DynamicMatrixIntegrationTest::broadcasted() {
     }
 }
 
+void DynamicMatrixIntegrationTest::vectors() {
+    /* Interleaved like a typical mesh vertex */
+    struct Vertex {
+        Vector3 position;
+        Float other;
+    } vertices[]{
+        {{1.0f, 2.0f, 3.0f}, 0.0f},
+        {{4.0f, 5.0f, 6.0f}, 0.0f},
+        {{7.0f, 8.0f, 9.0f}, 0.0f},
+        {{10.0f, 11.0f, 12.0f}, 0.0f}
+    };
+
+    Containers::StridedArrayView1D<Vector3> view = Containers::stridedArrayView(vertices).slice(&Vertex::position);
+    Map3Xf mapped = arrayCast(view);
+    CORRADE_COMPARE(mapped.rows(), 3);
+    CORRADE_COMPARE(mapped.cols(), 4);
+    CORRADE_COMPARE(mapped.outerStride(), 4);
+    for(Int i = 0; i != 4; ++i) {
+        CORRADE_ITERATION(i);
+        for(Int j = 0; j != 3; ++j) {
+            CORRADE_ITERATION(j);
+            CORRADE_COMPARE(mapped(j, i), view[i][j]);
+        }
+    }
+
+    /* Modifying the map modifies the original data */
+    mapped.colwise() -= Eigen::Vector3f{1.0f, 2.0f, 3.0f};
+    CORRADE_COMPARE(vertices[3].position, (Vector3{9.0f, 9.0f, 9.0f}));
+    CORRADE_COMPARE(vertices[3].other, 0.0f);
+
+    /* And back, with the original stride */
+    Containers::StridedArrayView1D<Vector3> view2 = arrayCast(mapped);
+    CORRADE_COMPARE(view2.data(), view.data());
+    CORRADE_COMPARE(view2.size(), 4);
+    CORRADE_COMPARE(view2.stride(), std::ptrdiff_t(sizeof(Vertex)));
+    CORRADE_COMPARE_AS(view2, view, TestSuite::Compare::Container);
+
+    /* A block with fixed rows also works */
+    Containers::StridedArrayView1D<Vector3> view3 = arrayCast(mapped.middleCols(1, 2));
+    CORRADE_COMPARE_AS(view3, view.slice(1, 3), TestSuite::Compare::Container);
+}
+
+void DynamicMatrixIntegrationTest::vectorsConst() {
+    const Vector2 data[]{{1.0f, 2.0f}, {3.0f, 4.0f}, {5.0f, 6.0f}};
+
+    Eigen::Map<const Eigen::Matrix2Xf, Eigen::Unaligned, Eigen::OuterStride<>> mapped = arrayCast(Containers::stridedArrayView(data));
+    CORRADE_COMPARE(mapped.cols(), 3);
+    CORRADE_COMPARE(mapped.outerStride(), 2);
+    CORRADE_COMPARE(mapped(1, 2), 6.0f);
+    CORRADE_COMPARE(mapped.rowwise().sum(), (Eigen::Vector2f{9.0f, 12.0f}));
+}
+
+void DynamicMatrixIntegrationTest::vectorsInvalidStride() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    char data[3*16]{};
+    Containers::StridedArrayView1D<Vector3> view{Containers::arrayView(data), reinterpret_cast<Vector3*>(data + 1), 3, 15};
+
+    Containers::String out;
+    Error redirectError{&out};
+    arrayCast(view);
+    CORRADE_COMPARE(out, "EigenIntegration::arrayCast(): expected stride to be a multiple of 4 but got 15\n");
+}
+
+void DynamicMatrixIntegrationTest::vectorsFromEigenNotContiguous() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Eigen::Matrix<Float, Eigen::Dynamic, 3> m = Eigen::Matrix<Float, Eigen::Dynamic, 3>::Zero(4, 3);
+
+    Containers::String out;
+    Error redirectError{&out};
+    arrayCast(m.transpose());
+    CORRADE_COMPARE(out, "EigenIntegration::arrayCast(): expected contiguous columns but got a row stride of 4\n");
+}
+
+void DynamicMatrixIntegrationTest::contiguous() {
+    alignas(16) Float data[4*6];
+    for(Int i = 0; i != 4*6; ++i)
+        data[i] = Float(i);
+
+    /* Every row has padding at the end */
+    Containers::StridedArrayView2D<Float> view = Containers::StridedArrayView2D<Float>{data, {4, 6}}.exceptSuffix({0, 1});
+    Eigen::Map<Eigen::Matrix<Float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>, Eigen::Aligned16, Eigen::OuterStride<>> mapped = arrayCast<Eigen::Aligned16>(view);
+    CORRADE_COMPARE(mapped.rows(), 4);
+    CORRADE_COMPARE(mapped.cols(), 5);
+    CORRADE_COMPARE(mapped.outerStride(), 6);
+    for(Int i = 0; i != 4; ++i) {
+        CORRADE_ITERATION(i);
+        for(Int j = 0; j != 5; ++j) {
+            CORRADE_ITERATION(j);
+            CORRADE_COMPARE(mapped(i, j), view[i][j]);
+        }
+    }
+
+    /* Same result as with the dynamic stride */
+    Map2Df mappedDynamic = arrayCast(view);
+    const Eigen::VectorXf v = Eigen::VectorXf::Random(5);
+    CORRADE_VERIFY((mapped*v).isApprox(mappedDynamic*v));
+
+    /* Const views work too */
+    Containers::StridedArrayView2D<const Float> constView = view;
+    Eigen::Map<const Eigen::Matrix<Float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>, Eigen::Unaligned, Eigen::OuterStride<>> constMapped = arrayCast<Eigen::Unaligned>(constView);
+    CORRADE_VERIFY(constMapped.isApprox(mapped));
+}
+
+void DynamicMatrixIntegrationTest::contiguous1D() {
+    alignas(16) Float data[6]{1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+
+    Eigen::Map<Eigen::VectorXf, Eigen::Aligned16> mapped = arrayCast<Eigen::Aligned16>(Containers::stridedArrayView(data));
+    CORRADE_COMPARE(mapped.size(), 6);
+    CORRADE_COMPARE(mapped.sum(), 21.0f);
+
+    /* Unaligned is fine with any offset */
+    Eigen::Map<Eigen::VectorXf> mappedUnaligned = arrayCast<Eigen::Unaligned>(Containers::stridedArrayView(data).exceptPrefix(1));
+    CORRADE_COMPARE(mappedUnaligned.size(), 5);
+    CORRADE_COMPARE(mappedUnaligned.sum(), 20.0f);
+}
+
+void DynamicMatrixIntegrationTest::contiguousVectors() {
+    const Vector3 data[]{{1.0f, 2.0f, 3.0f}, {4.0f, 5.0f, 6.0f}};
+
+    Eigen::Map<const Eigen::Matrix3Xf> mapped = arrayCast<Eigen::Unaligned>(Containers::stridedArrayView(data));
+    CORRADE_COMPARE(mapped.cols(), 2);
+    CORRADE_COMPARE(mapped(2, 1), 6.0f);
+    CORRADE_COMPARE(mapped.rowwise().sum(), (Eigen::Vector3f{5.0f, 7.0f, 9.0f}));
+}
+
+void DynamicMatrixIntegrationTest::contiguousNotContiguous() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Float data[4*5]{};
+    Vector3 vectors[4]{};
+    Containers::StridedArrayView2D<Float> view{data, {4, 5}};
+
+    Containers::String out;
+    Error redirectError{&out};
+    arrayCast<Eigen::Unaligned>(view.transposed<0, 1>());
+    arrayCast<Eigen::Unaligned>(view.every({1, 2}));
+    arrayCast<Eigen::Unaligned>(Containers::stridedArrayView(data).every(2));
+    arrayCast<Eigen::Unaligned>(Containers::stridedArrayView(vectors).every(2));
+    CORRADE_COMPARE(out,
+        "EigenIntegration::arrayCast(): expected a view with contiguous rows of 4-byte items but got a stride of 4 and 20\n"
+        "EigenIntegration::arrayCast(): expected a view with contiguous rows of 4-byte items but got a stride of 20 and 8\n"
+        "EigenIntegration::arrayCast(): expected a contiguous view of 4-byte items but got a stride of 8\n"
+        "EigenIntegration::arrayCast(): expected a contiguous view of 12-byte items but got a stride of 24\n");
+}
+
+void DynamicMatrixIntegrationTest::contiguousNotAligned() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    alignas(16) Float data[4*4]{};
+    Containers::StridedArrayView2D<Float> view{data, {4, 4}};
+
+    Containers::String out;
+    Error redirectError{&out};
+    arrayCast<Eigen::Aligned16>(view.exceptPrefix({0, 1}));
+    arrayCast<Eigen::Aligned16>(Containers::stridedArrayView(data).exceptPrefix(2));
+    CORRADE_COMPARE(out,
+        "EigenIntegration::arrayCast(): expected the view data to be aligned to 16 bytes\n"
+        "EigenIntegration::arrayCast(): expected the view data to be aligned to 16 bytes\n");
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::EigenIntegration::Test::DynamicMatrixIntegrationTest)
@@ -24,7 +24,11 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <vector>
+#include <Corrade/Containers/ArrayViewStl.h>
+#include <Corrade/Containers/String.h>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
 #include <Magnum/Magnum.h>
 #include <Magnum/Math/Matrix3.h>
 #include <Magnum/Math/Matrix4.h>
@@ -48,6 +52,12 @@ struct GeometryIntegrationTest: TestSuite::Tester {
     void transform3DAffineCompact();
 
     void box();
+
+    void convertTransforms();
+    void convertTransformsStrided();
+    void convertTransformsCompact();
+    void convertQuaternions();
+    void convertInvalidSize();
 };
 
 GeometryIntegrationTest::GeometryIntegrationTest() {
@@ -62,7 +72,13 @@ GeometryIntegrationTest::GeometryIntegrationTest() {
               &GeometryIntegrationTest::transform3DProjective,
               &GeometryIntegrationTest::transform3DAffineCompact,
 
-              &GeometryIntegrationTest::box});
+              &GeometryIntegrationTest::box,
+
+              &GeometryIntegrationTest::convertTransforms,
+              &GeometryIntegrationTest::convertTransformsStrided,
+              &GeometryIntegrationTest::convertTransformsCompact,
+              &GeometryIntegrationTest::convertQuaternions,
+              &GeometryIntegrationTest::convertInvalidSize});
 }
 
 using namespace Math::Literals;
@@ -219,6 +235,109 @@ void GeometryIntegrationTest::box() {
     CORRADE_VERIFY(Eigen::AlignedBox3d{a3}.isApprox(b3));
 }
 
+void GeometryIntegrationTest::convertTransforms() {
+    const Matrix4 a[]{
+        Matrix4::translation({-1.5f, 0.3f, 1.4f})*Matrix4::rotationY(25.0_degf),
+        Matrix4::rotationX(-60.0_degf),
+        Matrix4::translation({0.0f, 2.0f, 0.0f})
+    };
+
+    std::vector<Eigen::Isometry3f, Eigen::aligned_allocator<Eigen::Isometry3f>> b(3);
+    convertInto(Containers::stridedArrayView(a), Containers::stridedArrayView(b));
+    for(std::size_t i = 0; i != 3; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_VERIFY(b[i].isApprox(Eigen::Isometry3f(a[i])));
+    }
+
+    /* And back, deliberately with a Matrix<4, Float> instead of a Matrix4 */
+    Math::Matrix<4, Float> c[3];
+    convertInto(Containers::stridedArrayView(b), Containers::stridedArrayView(c));
+    for(std::size_t i = 0; i != 3; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(Matrix4{c[i]}, a[i]);
+    }
+}
+
+void GeometryIntegrationTest::convertTransformsStrided() {
+    struct Pose {
+        Matrix3 transformation;
+        Int id;
+    } a[]{
+        {Matrix3::translation({-1.5f, 0.3f})*Matrix3::rotation(25.0_degf), 0},
+        {Matrix3::scaling({2.0f, 0.5f}), 1},
+        {Matrix3::rotation(-60.0_degf), 2}
+    };
+
+    Eigen::Affine2f b[3];
+    convertInto(Containers::stridedArrayView(a).slice(&Pose::transformation), Containers::stridedArrayView(b));
+    for(std::size_t i = 0; i != 3; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_VERIFY(b[i].isApprox(Eigen::Affine2f(a[i].transformation)));
+    }
+
+    /* Back, into the first two items */
+    Pose c[3]{};
+    convertInto(Containers::stridedArrayView(b).every(2), Containers::stridedArrayView(c).slice(&Pose::transformation).exceptSuffix(1));
+    CORRADE_COMPARE(c[0].transformation, a[0].transformation);
+    CORRADE_COMPARE(c[1].transformation, a[2].transformation);
+    CORRADE_COMPARE(c[2].transformation, Matrix3{});
+    CORRADE_COMPARE(c[0].id, 0);
+    CORRADE_COMPARE(c[1].id, 0);
+}
+
+void GeometryIntegrationTest::convertTransformsCompact() {
+    Matrix4d a = Matrix4d::translation({-1.5, 0.3, 1.4})*
+        Matrix4d::rotationY(25.0_deg);
+    const Matrix4x3d a43[]{
+        Matrix4x3d{a[0].xyz(), a[1].xyz(), a[2].xyz(), a[3].xyz()},
+        Matrix4x3d{Math::IdentityInit}
+    };
+
+    Eigen::AffineCompact3d b[2];
+    convertInto(Containers::stridedArrayView(a43), Containers::stridedArrayView(b));
+    CORRADE_VERIFY(b[0].isApprox(Eigen::AffineCompact3d(a43[0])));
+    CORRADE_VERIFY(b[1].isApprox(Eigen::AffineCompact3d::Identity()));
+
+    Matrix4x3d c[2];
+    convertInto(Containers::stridedArrayView(b), Containers::stridedArrayView(c));
+    CORRADE_COMPARE_AS(Containers::arrayView(c), Containers::arrayView(a43), TestSuite::Compare::Container);
+}
+
+void GeometryIntegrationTest::convertQuaternions() {
+    const Quaternion a[]{
+        Quaternion::rotation(25.0_degf, Vector3::yAxis()),
+        Quaternion::rotation(-60.0_degf, Vector3::xAxis())
+    };
+
+    Eigen::Quaternionf b[2];
+    convertInto(Containers::stridedArrayView(a), Containers::stridedArrayView(b));
+    for(std::size_t i = 0; i != 2; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_VERIFY(b[i].isApprox(Eigen::Quaternionf(a[i])));
+    }
+
+    Quaternion c[2];
+    convertInto(Containers::stridedArrayView(b), Containers::stridedArrayView(c));
+    CORRADE_COMPARE_AS(Containers::arrayView(c), Containers::arrayView(a), TestSuite::Compare::Container);
+}
+
+void GeometryIntegrationTest::convertInvalidSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const Matrix4 a[3];
+    Eigen::Isometry3f b[2];
+    const Eigen::Quaternionf c[3];
+    Quaternion d[2];
+
+    Containers::String out;
+    Error redirectError{&out};
+    convertInto(Containers::stridedArrayView(a), Containers::stridedArrayView(b));
+    convertInto(Containers::stridedArrayView(c), Containers::stridedArrayView(d));
+    CORRADE_COMPARE(out,
+        "EigenIntegration::convertInto(): expected source and destination views to have the same size, got 3 and 2\n"
+        "EigenIntegration::convertInto(): expected source and destination views to have the same size, got 3 and 2\n");
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::EigenIntegration::Test::GeometryIntegrationTest)
@@ -0,0 +1,308 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <vector>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/ArrayViewStl.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Magnum/Magnum.h>
+#include <Magnum/Math/Matrix3.h>
+#include <Magnum/Math/Matrix4.h>
+#include <Magnum/Math/Quaternion.h>
+
+#include "Magnum/EigenIntegration/DynamicMatrixIntegration.h"
+#include "Magnum/EigenIntegration/GeometryIntegration.h"
+#include "Magnum/EigenIntegration/Integration.h"
+
+namespace Magnum { namespace EigenIntegration { namespace Test { namespace {
+
+struct IntegrationBenchmark: TestSuite::Tester {
+    explicit IntegrationBenchmark();
+
+    void transformsCastToEigen();
+    void transformsConvertIntoToEigen();
+    void transformsCastFromEigen();
+    void transformsConvertIntoFromEigen();
+    void quaternionsCastToEigen();
+    void quaternionsConvertIntoToEigen();
+
+    void gemvEigen();
+    void gemvDynamicStride();
+    void gemvContiguous();
+    void gemmEigen();
+    void gemmDynamicStride();
+    void gemmContiguous();
+
+    void pointsMagnum();
+    void pointsCopiedToEigen();
+    void pointsMappedScalars();
+    void pointsMappedVectors();
+    void pointsMappedVectorsContiguous();
+
+    private:
+        std::vector<Eigen::Affine3f, Eigen::aligned_allocator<Eigen::Affine3f>> _eigenTransforms;
+        Containers::Array<Matrix4> _transforms;
+        std::vector<Eigen::Quaternionf, Eigen::aligned_allocator<Eigen::Quaternionf>> _eigenQuaternions;
+        Containers::Array<Quaternion> _quaternions;
+
+        Eigen::MatrixXf _eigenA, _eigenB, _eigenC;
+        Eigen::VectorXf _eigenX, _eigenY;
+        Containers::Array<Float> _a, _b, _c, _x, _y;
+
+        Containers::Array<Vector3> _points, _transformedPoints;
+        Eigen::Matrix3Xf _eigenPoints;
+};
+
+/* Enough items to not fit into L1 but not large enough to not fit into L2 */
+constexpr std::size_t TransformCount = 1024;
+/* Large enough for the kernel choice to matter */
+constexpr std::size_t MatrixSize = 128;
+constexpr std::size_t PointCount = 16384;
+
+IntegrationBenchmark::IntegrationBenchmark() {
+    addBenchmarks({&IntegrationBenchmark::transformsCastToEigen,
+                   &IntegrationBenchmark::transformsConvertIntoToEigen,
+                   &IntegrationBenchmark::transformsCastFromEigen,
+                   &IntegrationBenchmark::transformsConvertIntoFromEigen,
+                   &IntegrationBenchmark::quaternionsCastToEigen,
+                   &IntegrationBenchmark::quaternionsConvertIntoToEigen,
+
+                   &IntegrationBenchmark::gemvEigen,
+                   &IntegrationBenchmark::gemvDynamicStride,
+                   &IntegrationBenchmark::gemvContiguous,
+                   &IntegrationBenchmark::gemmEigen,
+                   &IntegrationBenchmark::gemmDynamicStride,
+                   &IntegrationBenchmark::gemmContiguous,
+
+                   &IntegrationBenchmark::pointsMagnum,
+                   &IntegrationBenchmark::pointsCopiedToEigen,
+                   &IntegrationBenchmark::pointsMappedScalars,
+                   &IntegrationBenchmark::pointsMappedVectors,
+                   &IntegrationBenchmark::pointsMappedVectorsContiguous}, 10);
+
+    _eigenTransforms.resize(TransformCount);
+    _transforms = Containers::Array<Matrix4>{TransformCount};
+    _eigenQuaternions.resize(TransformCount);
+    _quaternions = Containers::Array<Quaternion>{TransformCount};
+    for(std::size_t i = 0; i != TransformCount; ++i) {
+        _transforms[i] = Matrix4::translation(Vector3{Float(i)})*Matrix4::rotationY(Deg(Float(i)));
+        _quaternions[i] = Quaternion::rotation(Deg(Float(i)), Vector3::yAxis());
+    }
+
+    /* The Magnum copies are row-major so the contiguous map can make use of
+       the compile-time inner stride while the Eigen ones are the default
+       column-major, representing the same matrices */
+    _eigenA = Eigen::MatrixXf::Random(MatrixSize, MatrixSize);
+    _eigenB = Eigen::MatrixXf::Random(MatrixSize, MatrixSize);
+    _eigenC = Eigen::MatrixXf::Zero(MatrixSize, MatrixSize);
+    _eigenX = Eigen::VectorXf::Random(MatrixSize);
+    _eigenY = Eigen::VectorXf::Zero(MatrixSize);
+    _a = Containers::Array<Float>{NoInit, MatrixSize*MatrixSize};
+    _b = Containers::Array<Float>{NoInit, MatrixSize*MatrixSize};
+    _c = Containers::Array<Float>{ValueInit, MatrixSize*MatrixSize};
+    _x = Containers::Array<Float>{NoInit, MatrixSize};
+    _y = Containers::Array<Float>{ValueInit, MatrixSize};
+    for(std::size_t row = 0; row != MatrixSize; ++row) {
+        for(std::size_t col = 0; col != MatrixSize; ++col) {
+            _a[row*MatrixSize + col] = _eigenA(row, col);
+            _b[row*MatrixSize + col] = _eigenB(row, col);
+        }
+        _x[row] = _eigenX(row);
+    }
+
+    _points = Containers::Array<Vector3>{NoInit, PointCount};
+    _transformedPoints = Containers::Array<Vector3>{ValueInit, PointCount};
+    _eigenPoints = Eigen::Matrix3Xf{3, PointCount};
+    for(std::size_t i = 0; i != PointCount; ++i)
+        _points[i] = Vector3{Float(i), Float(i % 7), Float(i % 13)};
+}
+
+void IntegrationBenchmark::transformsCastToEigen() {
+    CORRADE_BENCHMARK(10)
+        for(std::size_t i = 0; i != TransformCount; ++i)
+            _eigenTransforms[i] = cast<Eigen::Affine3f>(_transforms[i]);
+
+    CORRADE_COMPARE(Matrix4{_eigenTransforms.back()}, _transforms.back());
+}
+
+void IntegrationBenchmark::transformsConvertIntoToEigen() {
+    CORRADE_BENCHMARK(10)
+        convertInto(Containers::stridedArrayView(_transforms), Containers::stridedArrayView(_eigenTransforms));
+
+    CORRADE_COMPARE(Matrix4{_eigenTransforms.back()}, _transforms.back());
+}
+
+void IntegrationBenchmark::transformsCastFromEigen() {
+    convertInto(Containers::stridedArrayView(_transforms), Containers::stridedArrayView(_eigenTransforms));
+
+    Containers::Array<Matrix4> out{TransformCount};
+    CORRADE_BENCHMARK(10)
+        for(std::size_t i = 0; i != TransformCount; ++i)
+            out[i] = Matrix4{_eigenTransforms[i]};
+
+    CORRADE_COMPARE(out.back(), _transforms.back());
+}
+
+void IntegrationBenchmark::transformsConvertIntoFromEigen() {
+    convertInto(Containers::stridedArrayView(_transforms), Containers::stridedArrayView(_eigenTransforms));
+
+    Containers::Array<Matrix4> out{TransformCount};
+    CORRADE_BENCHMARK(10)
+        convertInto(Containers::stridedArrayView(_eigenTransforms), Containers::stridedArrayView(out));
+
+    CORRADE_COMPARE(out.back(), _transforms.back());
+}
+
+void IntegrationBenchmark::quaternionsCastToEigen() {
+    CORRADE_BENCHMARK(10)
+        for(std::size_t i = 0; i != TransformCount; ++i)
+            _eigenQuaternions[i] = cast<Eigen::Quaternionf>(_quaternions[i]);
+
+    CORRADE_COMPARE(Quaternion{_eigenQuaternions.back()}, _quaternions.back());
+}
+
+void IntegrationBenchmark::quaternionsConvertIntoToEigen() {
+    CORRADE_BENCHMARK(10)
+        convertInto(Containers::stridedArrayView(_quaternions), Containers::stridedArrayView(_eigenQuaternions));
+
+    CORRADE_COMPARE(Quaternion{_eigenQuaternions.back()}, _quaternions.back());
+}
+
+void IntegrationBenchmark::gemvEigen() {
+    CORRADE_BENCHMARK(10)
+        _eigenY.noalias() = _eigenA*_eigenX;
+
+    CORRADE_VERIFY(_eigenY.isApprox(_eigenA*_eigenX));
+}
+
+void IntegrationBenchmark::gemvDynamicStride() {
+    auto a = arrayCast(Containers::StridedArrayView2D<Float>{_a, {MatrixSize, MatrixSize}});
+    auto x = arrayCast(Containers::stridedArrayView(_x));
+    auto y = arrayCast(Containers::stridedArrayView(_y));
+    CORRADE_BENCHMARK(10)
+        y.noalias() = a*x;
+
+    CORRADE_VERIFY(y.isApprox(_eigenA*_eigenX));
+}
+
+void IntegrationBenchmark::gemvContiguous() {
+    auto a = arrayCast<Eigen::Unaligned>(Containers::StridedArrayView2D<Float>{_a, {MatrixSize, MatrixSize}});
+    auto x = arrayCast<Eigen::Unaligned>(Containers::stridedArrayView(_x));
+    auto y = arrayCast<Eigen::Unaligned>(Containers::stridedArrayView(_y));
+    CORRADE_BENCHMARK(10)
+        y.noalias() = a*x;
+
+    CORRADE_VERIFY(y.isApprox(_eigenA*_eigenX));
+}
+
+void IntegrationBenchmark::gemmEigen() {
+    CORRADE_BENCHMARK(10)
+        _eigenC.noalias() = _eigenA*_eigenB;
+
+    CORRADE_VERIFY(_eigenC.isApprox(_eigenA*_eigenB));
+}
+
+void IntegrationBenchmark::gemmDynamicStride() {
+    auto a = arrayCast(Containers::StridedArrayView2D<Float>{_a, {MatrixSize, MatrixSize}});
+    auto b = arrayCast(Containers::StridedArrayView2D<Float>{_b, {MatrixSize, MatrixSize}});
+    auto c = arrayCast(Containers::StridedArrayView2D<Float>{_c, {MatrixSize, MatrixSize}});
+    CORRADE_BENCHMARK(10)
+        c.noalias() = a*b;
+
+    CORRADE_VERIFY(c.isApprox(_eigenA*_eigenB));
+}
+
+void IntegrationBenchmark::gemmContiguous() {
+    auto a = arrayCast<Eigen::Unaligned>(Containers::StridedArrayView2D<Float>{_a, {MatrixSize, MatrixSize}});
+    auto b = arrayCast<Eigen::Unaligned>(Containers::StridedArrayView2D<Float>{_b, {MatrixSize, MatrixSize}});
+    auto c = arrayCast<Eigen::Unaligned>(Containers::StridedArrayView2D<Float>{_c, {MatrixSize, MatrixSize}});
+    CORRADE_BENCHMARK(10)
+        c.noalias() = a*b;
+
+    CORRADE_VERIFY(c.isApprox(_eigenA*_eigenB));
+}
+
+/* All following transform a list of points with the same matrix, once on the
+   Magnum side and then either copying the data to an Eigen matrix or mapping
+   them in various ways */
+const Matrix4 PointTransformation = Matrix4::translation({1.0f, 2.0f, 3.0f})*Matrix4::rotationZ(Deg(35.0f));
+
+void IntegrationBenchmark::pointsMagnum() {
+    CORRADE_BENCHMARK(10)
+        for(std::size_t i = 0; i != PointCount; ++i)
+            _transformedPoints[i] = PointTransformation.transformPoint(_points[i]);
+
+    CORRADE_COMPARE(_transformedPoints.back(), PointTransformation.transformPoint(_points.back()));
+}
+
+void IntegrationBenchmark::pointsCopiedToEigen() {
+    const Eigen::Affine3f transformation = cast<Eigen::Affine3f>(PointTransformation);
+    CORRADE_BENCHMARK(10) {
+        for(std::size_t i = 0; i != PointCount; ++i)
+            _eigenPoints.col(i) = cast<Eigen::Vector3f>(_points[i]);
+        _eigenPoints = transformation*_eigenPoints;
+        for(std::size_t i = 0; i != PointCount; ++i)
+            _transformedPoints[i] = Vector3{Eigen::Vector3f{_eigenPoints.col(i)}};
+    }
+
+    CORRADE_COMPARE(_transformedPoints.back(), PointTransformation.transformPoint(_points.back()));
+}
+
+void IntegrationBenchmark::pointsMappedScalars() {
+    const Eigen::Affine3f transformation = cast<Eigen::Affine3f>(PointTransformation);
+    /* Each row of the Eigen matrix is one point, so it's transposed */
+    auto in = arrayCast(Containers::arrayCast<2, const Float>(Containers::StridedArrayView1D<const Vector3>{_points}));
+    auto out = arrayCast(Containers::arrayCast<2, Float>(Containers::stridedArrayView(_transformedPoints)));
+    CORRADE_BENCHMARK(10)
+        out.transpose() = (transformation.linear()*in.transpose()).colwise() + transformation.translation();
+
+    CORRADE_COMPARE(_transformedPoints.back(), PointTransformation.transformPoint(_points.back()));
+}
+
+void IntegrationBenchmark::pointsMappedVectors() {
+    const Eigen::Affine3f transformation = cast<Eigen::Affine3f>(PointTransformation);
+    auto in = arrayCast(Containers::StridedArrayView1D<const Vector3>{_points});
+    auto out = arrayCast(Containers::stridedArrayView(_transformedPoints));
+    CORRADE_BENCHMARK(10)
+        out = (transformation.linear()*in).colwise() + transformation.translation();
+
+    CORRADE_COMPARE(_transformedPoints.back(), PointTransformation.transformPoint(_points.back()));
+}
+
+void IntegrationBenchmark::pointsMappedVectorsContiguous() {
+    const Eigen::Affine3f transformation = cast<Eigen::Affine3f>(PointTransformation);
+    auto in = arrayCast<Eigen::Unaligned>(Containers::StridedArrayView1D<const Vector3>{_points});
+    auto out = arrayCast<Eigen::Unaligned>(Containers::stridedArrayView(_transformedPoints));
+    CORRADE_BENCHMARK(10)
+        out = (transformation.linear()*in).colwise() + transformation.translation();
+
+    CORRADE_COMPARE(_transformedPoints.back(), PointTransformation.transformPoint(_points.back()));
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::EigenIntegration::Test::IntegrationBenchmark)
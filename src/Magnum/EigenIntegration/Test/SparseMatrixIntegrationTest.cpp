@@ -0,0 +1,264 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/String.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Magnum/Magnum.h>
+
+#include "Magnum/EigenIntegration/SparseMatrixIntegration.h"
+
+namespace Magnum { namespace EigenIntegration { namespace Test { namespace {
+
+struct SparseMatrixIntegrationTest: TestSuite::Tester {
+    explicit SparseMatrixIntegrationTest();
+
+    void map();
+    void mapRowMajor();
+    void mapConst();
+    void mapData();
+    void mapInvalidSize();
+
+    void copy();
+    void copyUncompressed();
+
+    void meshAdjacency();
+    void meshAdjacencyEmpty();
+    void meshAdjacencyInvalid();
+};
+
+SparseMatrixIntegrationTest::SparseMatrixIntegrationTest() {
+    addTests({&SparseMatrixIntegrationTest::map,
+              &SparseMatrixIntegrationTest::mapRowMajor,
+              &SparseMatrixIntegrationTest::mapConst,
+              &SparseMatrixIntegrationTest::mapData,
+              &SparseMatrixIntegrationTest::mapInvalidSize,
+
+              &SparseMatrixIntegrationTest::copy,
+              &SparseMatrixIntegrationTest::copyUncompressed,
+
+              &SparseMatrixIntegrationTest::meshAdjacency,
+              &SparseMatrixIntegrationTest::meshAdjacencyEmpty,
+              &SparseMatrixIntegrationTest::meshAdjacencyInvalid});
+}
+
+/* A 3x4 matrix
+
+    1 0 0 4
+    0 2 0 0
+    0 3 0 5
+
+   in the CSC format. The third column is empty. */
+Int CscOuterIndices[]{0, 1, 3, 3, 5};
+Int CscInnerIndices[]{0, 1, 2, 0, 2};
+Float CscValues[]{1.0f, 2.0f, 3.0f, 4.0f, 5.0f};
+
+Eigen::MatrixXf expected() {
+    Eigen::MatrixXf out = Eigen::MatrixXf::Zero(3, 4);
+    out(0, 0) = 1.0f;
+    out(1, 1) = 2.0f;
+    out(2, 1) = 3.0f;
+    out(0, 3) = 4.0f;
+    out(2, 3) = 5.0f;
+    return out;
+}
+
+void SparseMatrixIntegrationTest::map() {
+    Int outerIndices[5];
+    Int innerIndices[5];
+    Float values[5];
+    Utility::copy(CscOuterIndices, outerIndices);
+    Utility::copy(CscInnerIndices, innerIndices);
+    Utility::copy(CscValues, values);
+
+    Eigen::Map<Eigen::SparseMatrix<Float>> mapped = mapSparseMatrix(3, 4, Containers::arrayView(outerIndices), Containers::arrayView(innerIndices), Containers::arrayView(values));
+    CORRADE_COMPARE(mapped.rows(), 3);
+    CORRADE_COMPARE(mapped.cols(), 4);
+    CORRADE_COMPARE(mapped.nonZeros(), 5);
+    CORRADE_VERIFY(mapped.toDense().isApprox(expected()));
+
+    /* The data are referenced, not copied */
+    CORRADE_COMPARE(mapped.valuePtr(), values);
+    mapped.coeffRef(2, 1) = 7.0f;
+    CORRADE_COMPARE(values[2], 7.0f);
+}
+
+void SparseMatrixIntegrationTest::mapRowMajor() {
+    /* The same matrix in the CSR format */
+    const Int outerIndices[]{0, 2, 3, 5};
+    const Int innerIndices[]{0, 3, 1, 1, 3};
+    const Float values[]{1.0f, 4.0f, 2.0f, 3.0f, 5.0f};
+
+    Eigen::Map<const Eigen::SparseMatrix<Float, Eigen::RowMajor>> mapped = mapSparseMatrix<Eigen::RowMajor>(3, 4, Containers::arrayView(outerIndices), Containers::arrayView(innerIndices), Containers::arrayView(values));
+    CORRADE_COMPARE(mapped.outerSize(), 3);
+    CORRADE_VERIFY(Eigen::MatrixXf(mapped.toDense()).isApprox(expected()));
+}
+
+void SparseMatrixIntegrationTest::mapConst() {
+    Eigen::Map<const Eigen::SparseMatrix<Float>> mapped = mapSparseMatrix(3, 4, Containers::arrayView(static_cast<const Int*>(CscOuterIndices), 5), Containers::arrayView(static_cast<const Int*>(CscInnerIndices), 5), Containers::arrayView(static_cast<const Float*>(CscValues), 5));
+    CORRADE_VERIFY(mapped.toDense().isApprox(expected()));
+
+    /* Products work directly on the map */
+    const Eigen::VectorXf v = Eigen::VectorXf::Random(4);
+    CORRADE_VERIFY((mapped*v).isApprox(expected()*v));
+}
+
+void SparseMatrixIntegrationTest::mapData() {
+    SparseMatrixData<Float> data;
+    data.rows = 3;
+    data.cols = 4;
+    data.outerIndices = Containers::Array<Int>{NoInit, 5};
+    data.innerIndices = Containers::Array<Int>{NoInit, 5};
+    data.values = Containers::Array<Float>{NoInit, 5};
+    Utility::copy(CscOuterIndices, data.outerIndices);
+    Utility::copy(CscInnerIndices, data.innerIndices);
+    Utility::copy(CscValues, data.values);
+
+    Eigen::Map<Eigen::SparseMatrix<Float>> mapped = mapSparseMatrix(data);
+    CORRADE_COMPARE(mapped.valuePtr(), data.values.data());
+    CORRADE_VERIFY(mapped.toDense().isApprox(expected()));
+
+    const SparseMatrixData<Float>& constData = data;
+    Eigen::Map<const Eigen::SparseMatrix<Float>> constMapped = mapSparseMatrix(constData);
+    CORRADE_COMPARE(constMapped.valuePtr(), data.values.data());
+    CORRADE_VERIFY(constMapped.toDense().isApprox(expected()));
+}
+
+void SparseMatrixIntegrationTest::mapInvalidSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Int outerIndices[5]{0, 1, 3, 3, 5};
+    Int innerIndices[5]{};
+    Float values[5]{};
+
+    Containers::String out;
+    Error redirectError{&out};
+    mapSparseMatrix(3, 3, Containers::arrayView(outerIndices), Containers::arrayView(innerIndices), Containers::arrayView(values));
+    mapSparseMatrix<Eigen::RowMajor>(3, 4, Containers::arrayView(outerIndices), Containers::arrayView(innerIndices), Containers::arrayView(values));
+    mapSparseMatrix(3, 4, Containers::arrayView(outerIndices), Containers::arrayView(innerIndices).exceptSuffix(1), Containers::arrayView(values));
+    mapSparseMatrix(3, 4, Containers::arrayView(outerIndices), Containers::arrayView(innerIndices).exceptSuffix(1), Containers::arrayView(values).exceptSuffix(1));
+    CORRADE_COMPARE(out,
+        "EigenIntegration::mapSparseMatrix(): expected 4 outer indices but got 5\n"
+        "EigenIntegration::mapSparseMatrix(): expected 4 outer indices but got 5\n"
+        "EigenIntegration::mapSparseMatrix(): expected 5 inner indices and values but got 4 and 5\n"
+        "EigenIntegration::mapSparseMatrix(): expected 5 inner indices and values but got 4 and 4\n");
+}
+
+void SparseMatrixIntegrationTest::copy() {
+    Eigen::SparseMatrix<Float> matrix = expected().sparseView();
+    CORRADE_VERIFY(matrix.isCompressed());
+
+    SparseMatrixData<Float> data = sparseMatrixData(matrix);
+    CORRADE_COMPARE(data.rows, 3);
+    CORRADE_COMPARE(data.cols, 4);
+    CORRADE_COMPARE_AS(data.outerIndices, Containers::arrayView(CscOuterIndices), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(data.innerIndices, Containers::arrayView(CscInnerIndices), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(data.values, Containers::arrayView(CscValues), TestSuite::Compare::Container);
+}
+
+void SparseMatrixIntegrationTest::copyUncompressed() {
+    /* Reserving space for more items than needed leaves gaps */
+    Eigen::SparseMatrix<Float> matrix{3, 4};
+    matrix.reserve(Eigen::VectorXi::Constant(4, 3));
+    matrix.insert(0, 3) = 4.0f;
+    matrix.insert(2, 1) = 3.0f;
+    matrix.insert(1, 1) = 2.0f;
+    matrix.insert(0, 0) = 1.0f;
+    matrix.insert(2, 3) = 5.0f;
+    CORRADE_VERIFY(!matrix.isCompressed());
+
+    SparseMatrixData<Float> data = sparseMatrixData(matrix);
+    CORRADE_COMPARE_AS(data.outerIndices, Containers::arrayView(CscOuterIndices), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(data.innerIndices, Containers::arrayView(CscInnerIndices), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(data.values, Containers::arrayView(CscValues), TestSuite::Compare::Container);
+}
+
+void SparseMatrixIntegrationTest::meshAdjacency() {
+    /* Two triangles sharing the 1-2 edge, plus a degenerate one, and vertex 4
+       not referenced at all
+
+        0---1
+        |  /|
+        | / |
+        |/  |
+        2---3    4
+    */
+    const UnsignedInt indices[]{
+        0, 2, 1,
+        1, 2, 3,
+        3, 3, 1
+    };
+
+    SparseMatrixData<Float> data = EigenIntegration::meshAdjacency(indices, 5);
+    CORRADE_COMPARE(data.rows, 5);
+    CORRADE_COMPARE(data.cols, 5);
+    CORRADE_COMPARE_AS(data.outerIndices, Containers::arrayView<Int>({
+        0, 2, 5, 8, 10, 10
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(data.innerIndices, Containers::arrayView<Int>({
+        1, 2,
+        0, 2, 3,
+        0, 1, 3,
+        1, 2
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(data.values, Containers::arrayView<Float>({
+        1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f
+    }), TestSuite::Compare::Container);
+
+    /* The matrix is symmetric */
+    Eigen::MatrixXf dense = mapSparseMatrix(data).toDense();
+    CORRADE_VERIFY(dense.isApprox(dense.transpose()));
+}
+
+void SparseMatrixIntegrationTest::meshAdjacencyEmpty() {
+    SparseMatrixData<Double, Eigen::ColMajor, Long> data = EigenIntegration::meshAdjacency<Double, Long>(nullptr, 3);
+    CORRADE_COMPARE(data.rows, 3);
+    CORRADE_COMPARE(data.cols, 3);
+    CORRADE_COMPARE_AS(data.outerIndices, Containers::arrayView<Long>({
+        0, 0, 0, 0
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(data.innerIndices.size(), 0);
+    CORRADE_COMPARE(data.values.size(), 0);
+}
+
+void SparseMatrixIntegrationTest::meshAdjacencyInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const UnsignedInt indices[]{0, 1, 2, 3};
+
+    Containers::String out;
+    Error redirectError{&out};
+    EigenIntegration::meshAdjacency(indices, 4);
+    EigenIntegration::meshAdjacency(Containers::arrayView(indices).prefix(3), 2);
+    CORRADE_COMPARE(out,
+        "EigenIntegration::meshAdjacency(): expected index count to be divisible by 3, got 4\n"
+        "EigenIntegration::meshAdjacency(): index 2 out of range for 2 vertices\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::EigenIntegration::Test::SparseMatrixIntegrationTest)
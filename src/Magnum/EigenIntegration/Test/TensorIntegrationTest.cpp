@@ -0,0 +1,194 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/String.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Magnum/Magnum.h>
+
+#include "Magnum/EigenIntegration/TensorIntegration.h"
+
+namespace Magnum { namespace EigenIntegration { namespace Test { namespace {
+
+struct TensorIntegrationTest: TestSuite::Tester {
+    explicit TensorIntegrationTest();
+
+    void view3D();
+    void view3DConst();
+    void view4D();
+    void viewNotContiguous();
+
+    void tensor();
+    void tensorConst();
+    void tensorColumnMajor();
+    void tensorMap();
+    void tensorMapConst();
+};
+
+TensorIntegrationTest::TensorIntegrationTest() {
+    addTests({&TensorIntegrationTest::view3D,
+              &TensorIntegrationTest::view3DConst,
+              &TensorIntegrationTest::view4D,
+              &TensorIntegrationTest::viewNotContiguous,
+
+              &TensorIntegrationTest::tensor,
+              &TensorIntegrationTest::tensorConst,
+              &TensorIntegrationTest::tensorColumnMajor,
+              &TensorIntegrationTest::tensorMap,
+              &TensorIntegrationTest::tensorMapConst});
+}
+
+void TensorIntegrationTest::view3D() {
+    Float data[2*3*4];
+    for(std::size_t i = 0; i != Containers::arraySize(data); ++i)
+        data[i] = Float(i);
+    Containers::StridedArrayView3D<Float> view{data, {2, 3, 4}};
+
+    Eigen::TensorMap<Eigen::Tensor<Float, 3, Eigen::RowMajor>> tensor = arrayCast(view);
+    CORRADE_COMPARE(tensor.data(), data);
+    CORRADE_COMPARE(tensor.dimension(0), 2);
+    CORRADE_COMPARE(tensor.dimension(1), 3);
+    CORRADE_COMPARE(tensor.dimension(2), 4);
+    CORRADE_COMPARE(tensor(0, 0, 3), 3.0f);
+    CORRADE_COMPARE(tensor(0, 2, 1), 9.0f);
+    CORRADE_COMPARE(tensor(1, 1, 2), 18.0f);
+
+    /* The data are referenced, not copied */
+    tensor(1, 2, 3) = 1337.0f;
+    CORRADE_COMPARE(view[1][2][3], 1337.0f);
+}
+
+void TensorIntegrationTest::view3DConst() {
+    const Int data[2*2*2]{0, 1, 2, 3, 4, 5, 6, 7};
+    Containers::StridedArrayView3D<const Int> view{data, {2, 2, 2}};
+
+    Eigen::TensorMap<const Eigen::Tensor<Int, 3, Eigen::RowMajor>> tensor = arrayCast(view);
+    CORRADE_COMPARE(tensor.data(), data);
+    CORRADE_COMPARE(tensor(0, 1, 0), 2);
+    CORRADE_COMPARE(tensor(1, 0, 1), 5);
+
+    /* Reductions work directly on the map */
+    Eigen::Tensor<Int, 0, Eigen::RowMajor> sum = tensor.sum();
+    CORRADE_COMPARE(sum(), 28);
+}
+
+void TensorIntegrationTest::view4D() {
+    Double data[2*2*3*2];
+    for(std::size_t i = 0; i != Containers::arraySize(data); ++i)
+        data[i] = Double(i);
+    Containers::StridedArrayView4D<Double> view{data, {2, 2, 3, 2}};
+
+    Eigen::TensorMap<Eigen::Tensor<Double, 4, Eigen::RowMajor>> tensor = arrayCast(view);
+    CORRADE_COMPARE(tensor.dimension(3), 2);
+    CORRADE_COMPARE(tensor(1, 0, 2, 1), view[1][0][2][1]);
+    CORRADE_COMPARE(tensor(0, 1, 1, 0), view[0][1][1][0]);
+}
+
+void TensorIntegrationTest::viewNotContiguous() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Float data[2*3*4]{};
+    Containers::StridedArrayView3D<Float> view{data, {2, 3, 4}};
+
+    Containers::String out;
+    Error redirectError{&out};
+    arrayCast(view.every({1, 1, 2}));
+    arrayCast(view.transposed<0, 2>());
+    CORRADE_COMPARE(out,
+        "EigenIntegration::arrayCast(): expected a contiguous view of 4-byte items\n"
+        "EigenIntegration::arrayCast(): expected a contiguous view of 4-byte items\n");
+}
+
+void TensorIntegrationTest::tensor() {
+    Eigen::Tensor<Float, 3, Eigen::RowMajor> tensor{2, 3, 4};
+    tensor.setZero();
+    tensor(1, 2, 0) = 3.0f;
+
+    Containers::StridedArrayView3D<Float> view = arrayCast(tensor);
+    CORRADE_COMPARE(view.data(), tensor.data());
+    CORRADE_COMPARE(view.size(), (Containers::StridedDimensions<3, std::size_t>{2, 3, 4}));
+    CORRADE_COMPARE(view.stride(), (Containers::StridedDimensions<3, std::ptrdiff_t>{48, 16, 4}));
+    CORRADE_VERIFY(view.isContiguous());
+    CORRADE_COMPARE(view[1][2][0], 3.0f);
+
+    /* Round trip */
+    Eigen::TensorMap<Eigen::Tensor<Float, 3, Eigen::RowMajor>> map = arrayCast(view);
+    CORRADE_COMPARE(map.data(), tensor.data());
+    CORRADE_COMPARE(map(1, 2, 0), 3.0f);
+}
+
+void TensorIntegrationTest::tensorConst() {
+    Eigen::Tensor<Float, 3, Eigen::RowMajor> tensor{2, 3, 4};
+    tensor.setZero();
+    tensor(0, 1, 3) = 5.0f;
+
+    const Eigen::Tensor<Float, 3, Eigen::RowMajor>& constTensor = tensor;
+    Containers::StridedArrayView3D<const Float> view = arrayCast(constTensor);
+    CORRADE_COMPARE(view.data(), tensor.data());
+    CORRADE_COMPARE(view[0][1][3], 5.0f);
+}
+
+void TensorIntegrationTest::tensorColumnMajor() {
+    Eigen::Tensor<Float, 3> tensor{2, 3, 4};
+    tensor.setZero();
+    tensor(1, 2, 0) = 3.0f;
+    tensor(0, 1, 3) = 5.0f;
+
+    /* Index order is the same, but the first dimension is contiguous */
+    Containers::StridedArrayView3D<Float> view = arrayCast(tensor);
+    CORRADE_COMPARE(view.size(), (Containers::StridedDimensions<3, std::size_t>{2, 3, 4}));
+    CORRADE_COMPARE(view.stride(), (Containers::StridedDimensions<3, std::ptrdiff_t>{4, 8, 24}));
+    CORRADE_COMPARE(view[1][2][0], 3.0f);
+    CORRADE_COMPARE(view[0][1][3], 5.0f);
+
+    /* Reversing the dimension order makes it contiguous again */
+    CORRADE_VERIFY(view.transposed<0, 2>().isContiguous());
+}
+
+void TensorIntegrationTest::tensorMap() {
+    Float data[2*2*2*3]{};
+    Eigen::TensorMap<Eigen::Tensor<Float, 4, Eigen::RowMajor>> map{data, 2, 2, 2, 3};
+
+    Containers::StridedArrayView4D<Float> view = arrayCast(map);
+    CORRADE_COMPARE(view.data(), data);
+    CORRADE_COMPARE(view.size(), (Containers::StridedDimensions<4, std::size_t>{2, 2, 2, 3}));
+    CORRADE_VERIFY(view.isContiguous());
+
+    view[1][0][1][2] = 7.0f;
+    CORRADE_COMPARE(map(1, 0, 1, 2), 7.0f);
+}
+
+void TensorIntegrationTest::tensorMapConst() {
+    const Float data[2*2*2]{0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f};
+    Eigen::TensorMap<const Eigen::Tensor<Float, 3, Eigen::RowMajor>> map{data, 2, 2, 2};
+
+    Containers::StridedArrayView3D<const Float> view = arrayCast(map);
+    CORRADE_COMPARE(view.data(), data);
+    CORRADE_COMPARE(view[1][1][0], 6.0f);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::EigenIntegration::Test::TensorIntegrationTest)
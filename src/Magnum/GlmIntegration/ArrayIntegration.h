@@ -0,0 +1,393 @@
+#ifndef Magnum_GlmIntegration_ArrayIntegration_h
+#define Magnum_GlmIntegration_ArrayIntegration_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+@brief Conversion of GLM vector and matrix arrays
+@m_since_latest_{integration}
+
+While @ref Magnum/GlmIntegration/Integration.h converts a single value at a
+time, this header provides @ref GlmIntegration::arrayCast() for reinterpreting
+a whole @relativeref{Corrade,Containers::ArrayView} or
+@relativeref{Corrade,Containers::StridedArrayView1D} of GLM types as Magnum
+types and vice versa without any copy, and @ref GlmIntegration::convertInto()
+for copying data between such views with a single @cpp std::memcpy() @ce if
+both are contiguous. All vector and matrix types from the table in
+@ref Magnum/GlmIntegration/Integration.h are supported except for bool
+vectors, as @ref Math::BitVector stores the bits packed.
+
+Layout compatibility is checked at compile time using
+@ref GlmIntegration::IsLayoutCompatible --- if a GLM type has a different size
+than the Magnum type, which is the case for example with
+`glm::aligned_vec3` when `GLM_FORCE_DEFAULT_ALIGNED_GENTYPES` is defined, the
+conversion fails to compile and the per-value conversion has to be used
+instead. If the GLM type has a stricter alignment than the Magnum type, the
+view is additionally checked at runtime to be suitably aligned. A
+@m_class{m-doc-external} [std::vector](https://en.cppreference.com/w/cpp/container/vector)
+can be passed through @relativeref{Corrade,Containers::arrayView()} if
+@ref Corrade/Containers/ArrayViewStl.h is included:
+
+@snippet GlmIntegration.cpp ArrayIntegration
+
+@see @ref types-thirdparty-integration
+*/
+
+#include <cstring>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/GlmIntegration/Integration.h"
+#include "Magnum/GlmIntegration/visibility.h"
+
+namespace Magnum { namespace GlmIntegration {
+
+namespace Implementation {
+    #if GLM_VERSION < 990
+    #define GlmQualifier glm::precision
+    #else
+    #define GlmQualifier glm::qualifier /* thanks, GLM */
+    #endif
+
+    /* Magnum type with the same layout as given GLM type. Void for unknown
+       types so it can be used in a std::is_base_of check directly. */
+    template<class T> struct GlmLayout {
+        typedef void Type;
+    };
+    template<class T, GlmQualifier q> struct GlmLayout<glm::tvec2<T, q>> {
+        typedef Math::Vector2<T> Type;
+        enum: std::size_t { ColumnSize = 2 };
+    };
+    template<class T, GlmQualifier q> struct GlmLayout<glm::tvec3<T, q>> {
+        typedef Math::Vector3<T> Type;
+        enum: std::size_t { ColumnSize = 3 };
+    };
+    template<class T, GlmQualifier q> struct GlmLayout<glm::tvec4<T, q>> {
+        typedef Math::Vector4<T> Type;
+        enum: std::size_t { ColumnSize = 4 };
+    };
+    /* Bool vectors are one byte per component in GLM but a bitfield in
+       Magnum */
+    template<GlmQualifier q> struct GlmLayout<glm::tvec2<bool, q>> {
+        typedef void Type;
+    };
+    template<GlmQualifier q> struct GlmLayout<glm::tvec3<bool, q>> {
+        typedef void Type;
+    };
+    template<GlmQualifier q> struct GlmLayout<glm::tvec4<bool, q>> {
+        typedef void Type;
+    };
+    #define _c(cols, rows)                                                  \
+        template<class T, GlmQualifier q> struct GlmLayout<glm::tmat ## cols ## x ## rows<T, q>> { \
+            typedef Math::RectangularMatrix<cols, rows, T> Type;            \
+            enum: std::size_t { ColumnSize = rows };                        \
+        };
+    _c(2, 2)
+    _c(2, 3)
+    _c(2, 4)
+    _c(3, 2)
+    _c(3, 3)
+    _c(3, 4)
+    _c(4, 2)
+    _c(4, 3)
+    _c(4, 4)
+    #undef GlmQualifier
+    #undef _c
+
+    /* Either of the types is a GLM type and the other is the equivalent
+       Magnum type or its subclass, such as Vector3 for glm::vec3 or Matrix4
+       for glm::mat4 */
+    template<class From, class To> struct IsGlmCompatible: std::integral_constant<bool,
+        (std::is_base_of<typename GlmLayout<typename std::remove_const<From>::type>::Type, typename std::remove_const<To>::type>::value ||
+         std::is_base_of<typename GlmLayout<typename std::remove_const<To>::type>::Type, typename std::remove_const<From>::type>::value) &&
+        /* Not allowing to cast const away */
+        (!std::is_const<From>::value || std::is_const<To>::value)> {};
+
+    template<class Glm, class Magnum, bool = std::is_base_of<typename GlmLayout<Glm>::Type, Magnum>::value> struct IsLayoutCompatible: std::false_type {};
+    template<class Glm, class Magnum> struct IsLayoutCompatible<Glm, Magnum, true>: std::integral_constant<bool, sizeof(Glm) == sizeof(Magnum)> {};
+
+    template<class Glm, class Magnum, bool = IsLayoutCompatible<Glm, Magnum>::value> struct IsAlignmentCompatible: std::false_type {};
+    template<class Glm, class Magnum> struct IsAlignmentCompatible<Glm, Magnum, true>: std::integral_constant<bool, alignof(Glm) <= alignof(Magnum)> {};
+
+    template<class To, class From> inline bool isGlmAligned(const void* data, const std::ptrdiff_t stride) {
+        /* Only GLM types can be stricter aligned, Magnum types have the
+           alignment of the underlying scalar type */
+        return alignof(To) <= alignof(From) || (reinterpret_cast<std::uintptr_t>(data) % alignof(To) == 0 && stride % std::ptrdiff_t(alignof(To)) == 0);
+    }
+}
+
+/**
+@brief Whether a GLM type is bit-identical to a Magnum type
+@m_since_latest_{integration}
+
+Is @cpp true @ce if @p Glm is a GLM vector or matrix type from the table in
+@ref Magnum/GlmIntegration/Integration.h, @p Magnum is the equivalent Magnum
+type or any of its subclasses and both have the same size, @cpp false @ce
+otherwise. If @p Magnum is not specified, it's the equivalent
+@ref Math::Vector2, @ref Math::Vector3, @ref Math::Vector4 or
+@ref Math::RectangularMatrix. That's the case for all GLM types with the
+default and `packed_*` qualifiers, while for example `aligned_highp`
+three-component vectors are padded to four components. Bool vectors are never
+layout-compatible, as @ref Math::BitVector stores the bits packed.
+
+If the value is @cpp true @ce, a view on @p Glm can be reinterpreted as a view
+on @p Magnum using @relativeref{Corrade,Containers::arrayCast()}, such as when
+the data is a part of a larger structure, and vice versa, subject to
+@ref IsAlignmentCompatible. The @ref arrayCast(const Containers::StridedArrayView1D<From>&)
+helpers do that check implicitly.
+
+@snippet GlmIntegration.cpp ArrayIntegration-traits
+*/
+template<class Glm, class Magnum
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    = typename Implementation::GlmLayout<Glm>::Type
+    #endif
+> struct IsLayoutCompatible: Implementation::IsLayoutCompatible<Glm, Magnum> {};
+
+/**
+@brief Whether a GLM type has the same or a lower alignment than a Magnum type
+@m_since_latest_{integration}
+
+Is @cpp true @ce if @ref IsLayoutCompatible is @cpp true @ce for given types
+and @p Glm doesn't have a stricter alignment than @p Magnum, @cpp false @ce
+otherwise. If it's @cpp true @ce, any view on @p Magnum can be reinterpreted as
+a view on @p Glm. Otherwise, for example with `aligned_highp` four-component
+vectors, the view data and stride have to be aligned to
+@cpp alignof(Glm) @ce. Reinterpreting a view of @p Glm as @p Magnum is always
+possible if the types are layout-compatible.
+*/
+template<class Glm, class Magnum
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    = typename Implementation::GlmLayout<Glm>::Type
+    #endif
+> struct IsAlignmentCompatible: Implementation::IsAlignmentCompatible<Glm, Magnum> {};
+
+namespace Implementation {
+    template<class From, class To> struct IsLayoutCompatibleEither: std::integral_constant<bool,
+        GlmIntegration::IsLayoutCompatible<typename std::remove_const<From>::type, typename std::remove_const<To>::type>::value ||
+        GlmIntegration::IsLayoutCompatible<typename std::remove_const<To>::type, typename std::remove_const<From>::type>::value> {};
+}
+
+/**
+@brief Reinterpret a list of GLM types as Magnum types or vice versa
+@m_since_latest_{integration}
+
+One of @p From and @p To is expected to be a GLM vector or matrix type and the
+other the equivalent Magnum type or any of its subclasses, such as
+@ref Magnum::Matrix4 "Matrix4" for `glm::mat4` or
+@ref Magnum::Color3 "Color3" for `glm::vec3`. Both types are expected to have
+the same size, which is checked at compile time, and the view data and stride
+are expected to be suitably aligned if @p To is a GLM type with a stricter
+alignment than @p From. Casting a @cpp const @ce type to a mutable type isn't
+allowed. The returned view points to the original data. Call the function
+with the namespace qualified, as otherwise argument-dependent lookup would
+make it ambiguous with @relativeref{Corrade,Containers::arrayCast()}.
+@see @ref convertInto()
+*/
+template<class To, class From
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    , typename std::enable_if<Implementation::IsGlmCompatible<From, To>::value, int>::type = 0
+    #endif
+> Containers::StridedArrayView1D<To> arrayCast(const Containers::StridedArrayView1D<From>& from) {
+    static_assert(Implementation::IsLayoutCompatibleEither<From, To>::value,
+        "the GLM type has a different size than the Magnum type, use the per-value conversion instead");
+    CORRADE_ASSERT(Implementation::isGlmAligned<To, From>(from.data(), from.stride()),
+        "GlmIntegration::arrayCast(): expected the view to be aligned to" << alignof(To) << "bytes", {});
+    return Containers::arrayCast<To>(from);
+}
+
+/**
+@overload
+@m_since_latest_{integration}
+*/
+template<class To, class From
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    , typename std::enable_if<Implementation::IsGlmCompatible<From, To>::value, int>::type = 0
+    #endif
+> Containers::ArrayView<To> arrayCast(const Containers::ArrayView<From>& from) {
+    static_assert(Implementation::IsLayoutCompatibleEither<From, To>::value,
+        "the GLM type has a different size than the Magnum type, use the per-value conversion instead");
+    CORRADE_ASSERT(Implementation::isGlmAligned<To, From>(from.data(), sizeof(From)),
+        "GlmIntegration::arrayCast(): expected the view to be aligned to" << alignof(To) << "bytes", {});
+    return Containers::arrayCast<To>(from);
+}
+
+/**
+@brief Reinterpret a list of GLM types as equivalent Magnum types
+@m_since_latest_{integration}
+
+Same as calling @ref arrayCast(const Containers::StridedArrayView1D<From>&)
+with @p To being the equivalent Magnum type from the table in
+@ref Magnum/GlmIntegration/Integration.h, i.e. a @ref Math::Vector2,
+@ref Math::Vector3, @ref Math::Vector4 or a @ref Math::RectangularMatrix of
+given size. Use the explicit variant to get a subclass such as
+@ref Magnum::Matrix4 "Matrix4" instead.
+*/
+template<class From
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    , class To = typename Implementation::GlmLayout<typename std::remove_const<From>::type>::Type, typename std::enable_if<!std::is_void<To>::value, int>::type = 0
+    #endif
+> Containers::StridedArrayView1D<typename std::conditional<std::is_const<From>::value, const To, To>::type> arrayCast(const Containers::StridedArrayView1D<From>& from) {
+    /* Qualified to avoid ADL picking up Containers::arrayCast() */
+    return GlmIntegration::arrayCast<typename std::conditional<std::is_const<From>::value, const To, To>::type>(from);
+}
+
+/**
+@overload
+@m_since_latest_{integration}
+*/
+template<class From
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    , class To = typename Implementation::GlmLayout<typename std::remove_const<From>::type>::Type, typename std::enable_if<!std::is_void<To>::value, int>::type = 0
+    #endif
+> Containers::ArrayView<typename std::conditional<std::is_const<From>::value, const To, To>::type> arrayCast(const Containers::ArrayView<From>& from) {
+    /* Qualified to avoid ADL picking up Containers::arrayCast() */
+    return GlmIntegration::arrayCast<typename std::conditional<std::is_const<From>::value, const To, To>::type>(from);
+}
+
+/**
+@brief Convert a list of GLM types to Magnum types or vice versa
+@m_since_latest_{integration}
+
+Accepts the same type combinations as @ref arrayCast(const Containers::StridedArrayView1D<From>&).
+Expects that both views have the same size. Equivalent to converting each
+element separately, but as the types have the same memory layout, the data is
+copied directly, with a single copy if both views are contiguous.
+*/
+template<class From, class To
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    , typename std::enable_if<Implementation::IsGlmCompatible<From, To>::value && !std::is_const<To>::value, int>::type = 0
+    #endif
+> void convertInto(const Containers::StridedArrayView1D<From>& src, const Containers::StridedArrayView1D<To>& dst) {
+    static_assert(Implementation::IsLayoutCompatibleEither<From, To>::value,
+        "the GLM type has a different size than the Magnum type, use the per-value conversion instead");
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "GlmIntegration::convertInto(): expected source and destination views to have the same size, got" << src.size() << "and" << dst.size(), );
+
+    /* A single copy if both are contiguous, otherwise per-item */
+    if(src.isContiguous() && dst.isContiguous()) {
+        if(src.size()) std::memcpy(dst.data(), src.data(), src.size()*sizeof(From));
+        return;
+    }
+    for(std::size_t i = 0; i != src.size(); ++i)
+        std::memcpy(static_cast<void*>(&dst[i]), static_cast<const void*>(&src[i]), sizeof(From));
+}
+
+namespace Implementation {
+    template<class T> struct DebugPacked {
+        Containers::StridedArrayView2D<const T> values;
+        std::size_t columnSize;
+    };
+
+    #ifndef CORRADE_SINGLES_NO_DEBUG
+    MAGNUM_GLMINTEGRATION_EXPORT Utility::Debug& operator<<(Utility::Debug& debug, const DebugPacked<Float>& value);
+    MAGNUM_GLMINTEGRATION_EXPORT Utility::Debug& operator<<(Utility::Debug& debug, const DebugPacked<Double>& value);
+    MAGNUM_GLMINTEGRATION_EXPORT Utility::Debug& operator<<(Utility::Debug& debug, const DebugPacked<Int>& value);
+    MAGNUM_GLMINTEGRATION_EXPORT Utility::Debug& operator<<(Utility::Debug& debug, const DebugPacked<UnsignedInt>& value);
+    #endif
+}
+
+/**
+@brief Print a list of GLM vectors or matrices in a packed form
+@m_since_latest_{integration}
+
+Unlike printing each value with the debug output operators from
+@ref Magnum/GlmIntegration/Integration.h, which go through `glm::to_string()` and thus allocates a new string for
+each value, the returned instance formats the whole list into a single buffer
+and passes it to @relativeref{Corrade,Utility::Debug} at once. Each value is
+printed on a separate line, with components separated by a space and matrix
+columns separated by a comma. Floating-point values are printed with the same
+precision as @relativeref{Corrade,Utility::Debug} uses for them:
+
+@snippet GlmIntegration.cpp ArrayIntegration-debugPacked
+
+Accepts all GLM types for which @ref IsLayoutCompatible is @cpp true @ce and
+the underlying type is @ref Magnum::Float "Float", @ref Magnum::Double "Double",
+@ref Magnum::Int "Int" or @ref Magnum::UnsignedInt "UnsignedInt".
+@see @ref dumpBinary()
+*/
+template<class T
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    , typename std::enable_if<IsLayoutCompatible<typename std::remove_const<T>::type>::value, int>::type = 0
+    #endif
+> Implementation::DebugPacked<typename Implementation::GlmLayout<typename std::remove_const<T>::type>::Type::Type> debugPacked(const Containers::StridedArrayView1D<T>& values) {
+    typedef typename Implementation::GlmLayout<typename std::remove_const<T>::type> Layout;
+    return {Containers::arrayCast<2, const typename Layout::Type::Type>(values), Layout::ColumnSize};
+}
+
+/**
+@overload
+@m_since_latest_{integration}
+*/
+template<class T
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    , typename std::enable_if<IsLayoutCompatible<typename std::remove_const<T>::type>::value, int>::type = 0
+    #endif
+> Implementation::DebugPacked<typename Implementation::GlmLayout<typename std::remove_const<T>::type>::Type::Type> debugPacked(const Containers::ArrayView<T>& values) {
+    return debugPacked(Containers::StridedArrayView1D<T>{values});
+}
+
+/**
+@brief Dump a list of GLM vectors or matrices as binary data
+@m_since_latest_{integration}
+
+Returns a copy of the components of all values, tightly packed and in the
+native byte order, which is the cheapest way to capture large amounts of data
+for later inspection, for example by saving them with
+@relativeref{Corrade,Utility::Path::write()}. If the view is contiguous, the
+data is copied with a single @cpp std::memcpy() @ce. Accepts all GLM types for
+which @ref IsLayoutCompatible is @cpp true @ce.
+@see @ref debugPacked()
+*/
+template<class T
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    , typename std::enable_if<IsLayoutCompatible<typename std::remove_const<T>::type>::value, int>::type = 0
+    #endif
+> Containers::Array<char> dumpBinary(const Containers::StridedArrayView1D<T>& values) {
+    Containers::Array<char> out{NoInit, values.size()*sizeof(T)};
+    if(values.isContiguous()) {
+        if(values.size()) std::memcpy(out.data(), values.data(), out.size());
+    } else for(std::size_t i = 0; i != values.size(); ++i)
+        std::memcpy(out.data() + i*sizeof(T), static_cast<const void*>(&values[i]), sizeof(T));
+    return out;
+}
+
+/**
+@overload
+@m_since_latest_{integration}
+*/
+template<class T
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    , typename std::enable_if<IsLayoutCompatible<typename std::remove_const<T>::type>::value, int>::type = 0
+    #endif
+> Containers::Array<char> dumpBinary(const Containers::ArrayView<T>& values) {
+    return dumpBinary(Containers::StridedArrayView1D<T>{values});
+}
+
+}}
+
+#endif
@@ -39,8 +39,12 @@
 #endif
 #include "Magnum/GlmIntegration/GtxIntegration.h"
 
+#include "Magnum/GlmIntegration/ArrayIntegration.h"
 #include "Magnum/GlmIntegration/visibility.h"
 
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/Utility/Format.h>
 #include <glm/gtx/string_cast.hpp>
 
 namespace glm {
@@ -319,3 +323,52 @@ template MAGNUM_GLMINTEGRATION_EXPORT Corrade::Utility::Debug& operator<<(Corrad
 } /* Close the detail namespace */
 #endif
 }
+
+namespace Magnum { namespace GlmIntegration { namespace Implementation {
+
+namespace {
+
+template<class T> Utility::Debug& printPacked(Utility::Debug& debug, const DebugPacked<T>& value) {
+    const std::size_t count = value.values.size()[0];
+    const std::size_t componentCount = value.values.size()[1];
+
+    /* Format everything into a single buffer and print it at once. The
+       initial capacity is just a guess to avoid most reallocations. */
+    Containers::Array<char> out;
+    arrayReserve(out, count*componentCount*8);
+    char buffer[32];
+    for(std::size_t i = 0; i != count; ++i) {
+        if(i) arrayAppend(out, '\n');
+        const Containers::StridedArrayView1D<const T> components = value.values[i];
+        for(std::size_t j = 0; j != componentCount; ++j) {
+            if(j) {
+                if(j % value.columnSize == 0) arrayAppend(out, ',');
+                arrayAppend(out, ' ');
+            }
+            const std::size_t size = Utility::formatInto(Containers::MutableStringView{buffer, sizeof(buffer)}, "{}", components[j]);
+            arrayAppend(out, Containers::arrayView(buffer, size));
+        }
+    }
+
+    return debug << Containers::StringView{out.data(), out.size()};
+}
+
+}
+
+Utility::Debug& operator<<(Utility::Debug& debug, const DebugPacked<Float>& value) {
+    return printPacked(debug, value);
+}
+
+Utility::Debug& operator<<(Utility::Debug& debug, const DebugPacked<Double>& value) {
+    return printPacked(debug, value);
+}
+
+Utility::Debug& operator<<(Utility::Debug& debug, const DebugPacked<Int>& value) {
+    return printPacked(debug, value);
+}
+
+Utility::Debug& operator<<(Utility::Debug& debug, const DebugPacked<UnsignedInt>& value) {
+    return printPacked(debug, value);
+}
+
+}}}
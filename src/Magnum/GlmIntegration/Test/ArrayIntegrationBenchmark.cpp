@@ -0,0 +1,172 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h> /* GLM has STL stream output operators? */
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/GlmIntegration/ArrayIntegration.h"
+#include "Magnum/GlmIntegration/Integration.h"
+
+namespace Magnum { namespace GlmIntegration { namespace Test { namespace {
+
+struct ArrayIntegrationBenchmark: TestSuite::Tester {
+    explicit ArrayIntegrationBenchmark();
+
+    void vectorsConvertToGlm();
+    void vectorsConvertIntoToGlm();
+    void vectorsCastToGlm();
+    void vectorsConvertFromGlm();
+    void vectorsConvertIntoFromGlm();
+
+    void transformsConvertToGlm();
+    void transformsConvertIntoToGlm();
+    void transformsConvertIntoStridedToGlm();
+    void transformsCastToGlm();
+
+    private:
+        Containers::Array<Vector3> _vectors;
+        Containers::Array<glm::vec3> _glmVectors;
+        Containers::Array<Matrix4> _transforms;
+        Containers::Array<glm::mat4> _glmTransforms;
+};
+
+/* Same sizes as in EigenIntegrationBenchmark so the two are comparable */
+constexpr std::size_t VectorCount = 16384;
+constexpr std::size_t TransformCount = 1024;
+
+ArrayIntegrationBenchmark::ArrayIntegrationBenchmark() {
+    addBenchmarks({&ArrayIntegrationBenchmark::vectorsConvertToGlm,
+                   &ArrayIntegrationBenchmark::vectorsConvertIntoToGlm,
+                   &ArrayIntegrationBenchmark::vectorsCastToGlm,
+                   &ArrayIntegrationBenchmark::vectorsConvertFromGlm,
+                   &ArrayIntegrationBenchmark::vectorsConvertIntoFromGlm,
+
+                   &ArrayIntegrationBenchmark::transformsConvertToGlm,
+                   &ArrayIntegrationBenchmark::transformsConvertIntoToGlm,
+                   &ArrayIntegrationBenchmark::transformsConvertIntoStridedToGlm,
+                   &ArrayIntegrationBenchmark::transformsCastToGlm}, 10);
+
+    _vectors = Containers::Array<Vector3>{NoInit, VectorCount};
+    _glmVectors = Containers::Array<glm::vec3>{ValueInit, VectorCount};
+    for(std::size_t i = 0; i != VectorCount; ++i)
+        _vectors[i] = Vector3{Float(i), Float(i % 7), Float(i % 13)};
+
+    _transforms = Containers::Array<Matrix4>{NoInit, TransformCount};
+    _glmTransforms = Containers::Array<glm::mat4>{ValueInit, TransformCount};
+    for(std::size_t i = 0; i != TransformCount; ++i)
+        _transforms[i] = Matrix4::translation(Vector3{Float(i)})*Matrix4::rotationY(Deg(Float(i)));
+}
+
+void ArrayIntegrationBenchmark::vectorsConvertToGlm() {
+    CORRADE_BENCHMARK(10)
+        for(std::size_t i = 0; i != VectorCount; ++i)
+            _glmVectors[i] = glm::vec3(_vectors[i]);
+
+    CORRADE_COMPARE(Vector3{_glmVectors[VectorCount - 1]}, _vectors[VectorCount - 1]);
+}
+
+void ArrayIntegrationBenchmark::vectorsConvertIntoToGlm() {
+    CORRADE_BENCHMARK(10)
+        convertInto(Containers::stridedArrayView(_vectors), Containers::stridedArrayView(_glmVectors));
+
+    CORRADE_COMPARE(Vector3{_glmVectors[VectorCount - 1]}, _vectors[VectorCount - 1]);
+}
+
+void ArrayIntegrationBenchmark::vectorsCastToGlm() {
+    /* Baseline -- no copy at all, only touching the data through the view so
+       the cast isn't optimized out */
+    Float sum = 0.0f;
+    CORRADE_BENCHMARK(10) {
+        Containers::ArrayView<const glm::vec3> view = GlmIntegration::arrayCast<const glm::vec3>(Containers::arrayView(_vectors));
+        for(const glm::vec3& i: view) sum += i.y;
+    }
+
+    CORRADE_VERIFY(sum > 0.0f);
+}
+
+void ArrayIntegrationBenchmark::vectorsConvertFromGlm() {
+    convertInto(Containers::stridedArrayView(_vectors), Containers::stridedArrayView(_glmVectors));
+
+    Containers::Array<Vector3> out{ValueInit, VectorCount};
+    CORRADE_BENCHMARK(10)
+        for(std::size_t i = 0; i != VectorCount; ++i)
+            out[i] = Vector3{_glmVectors[i]};
+
+    CORRADE_COMPARE(out[VectorCount - 1], _vectors[VectorCount - 1]);
+}
+
+void ArrayIntegrationBenchmark::vectorsConvertIntoFromGlm() {
+    convertInto(Containers::stridedArrayView(_vectors), Containers::stridedArrayView(_glmVectors));
+
+    Containers::Array<Vector3> out{ValueInit, VectorCount};
+    CORRADE_BENCHMARK(10)
+        convertInto(Containers::stridedArrayView(_glmVectors), Containers::stridedArrayView(out));
+
+    CORRADE_COMPARE(out[VectorCount - 1], _vectors[VectorCount - 1]);
+}
+
+void ArrayIntegrationBenchmark::transformsConvertToGlm() {
+    CORRADE_BENCHMARK(10)
+        for(std::size_t i = 0; i != TransformCount; ++i)
+            _glmTransforms[i] = glm::mat4(_transforms[i]);
+
+    CORRADE_COMPARE(Matrix4{_glmTransforms[TransformCount - 1]}, _transforms[TransformCount - 1]);
+}
+
+void ArrayIntegrationBenchmark::transformsConvertIntoToGlm() {
+    CORRADE_BENCHMARK(10)
+        convertInto(Containers::stridedArrayView(_transforms), Containers::stridedArrayView(_glmTransforms));
+
+    CORRADE_COMPARE(Matrix4{_glmTransforms[TransformCount - 1]}, _transforms[TransformCount - 1]);
+}
+
+void ArrayIntegrationBenchmark::transformsConvertIntoStridedToGlm() {
+    /* Every second item, which forces the per-item copy path */
+    Containers::StridedArrayView1D<const Matrix4> src = Containers::stridedArrayView(_transforms).every(2);
+    Containers::StridedArrayView1D<glm::mat4> dst = Containers::stridedArrayView(_glmTransforms).every(2);
+    CORRADE_BENCHMARK(10)
+        convertInto(src, dst);
+
+    CORRADE_COMPARE(Matrix4{_glmTransforms[TransformCount - 2]}, _transforms[TransformCount - 2]);
+}
+
+void ArrayIntegrationBenchmark::transformsCastToGlm() {
+    Float sum = 0.0f;
+    CORRADE_BENCHMARK(10) {
+        Containers::ArrayView<const glm::mat4> view = GlmIntegration::arrayCast<const glm::mat4>(Containers::arrayView(_transforms));
+        for(const glm::mat4& i: view) sum += i[3][0];
+    }
+
+    CORRADE_VERIFY(sum > 0.0f);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::GlmIntegration::Test::ArrayIntegrationBenchmark)
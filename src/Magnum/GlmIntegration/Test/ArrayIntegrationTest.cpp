@@ -0,0 +1,340 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/* Enabling aligned types to test the traits with them, has to be done before
+   any GLM include */
+#define GLM_FORCE_ALIGNED_GENTYPES
+
+#include <vector>
+#include <Corrade/Containers/ArrayViewStl.h>
+#include <Corrade/Containers/String.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h> /* GLM has STL stream output operators? */
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/GlmIntegration/ArrayIntegration.h"
+
+namespace Magnum { namespace GlmIntegration { namespace Test { namespace {
+
+using namespace Math::Literals;
+
+struct ArrayIntegrationTest: TestSuite::Tester {
+    explicit ArrayIntegrationTest();
+
+    void layoutCompatible();
+    void layoutCompatibleAligned();
+
+    void castVectors();
+    void castVectorsConst();
+    void castVectorsStrided();
+    void castMatrices();
+    void castToGlm();
+    void castSubclass();
+
+    void convert();
+    void convertStrided();
+    void convertInvalidSize();
+
+    void debugPacked();
+    void debugPackedMatrix();
+    void dumpBinary();
+    void dumpBinaryStrided();
+};
+
+ArrayIntegrationTest::ArrayIntegrationTest() {
+    addTests({&ArrayIntegrationTest::layoutCompatible,
+              &ArrayIntegrationTest::layoutCompatibleAligned,
+
+              &ArrayIntegrationTest::castVectors,
+              &ArrayIntegrationTest::castVectorsConst,
+              &ArrayIntegrationTest::castVectorsStrided,
+              &ArrayIntegrationTest::castMatrices,
+              &ArrayIntegrationTest::castToGlm,
+              &ArrayIntegrationTest::castSubclass,
+
+              &ArrayIntegrationTest::convert,
+              &ArrayIntegrationTest::convertStrided,
+              &ArrayIntegrationTest::convertInvalidSize,
+
+              &ArrayIntegrationTest::debugPacked,
+              &ArrayIntegrationTest::debugPackedMatrix,
+              &ArrayIntegrationTest::dumpBinary,
+              &ArrayIntegrationTest::dumpBinaryStrided});
+}
+
+void ArrayIntegrationTest::layoutCompatible() {
+    CORRADE_VERIFY(IsLayoutCompatible<glm::vec2>::value);
+    CORRADE_VERIFY(IsLayoutCompatible<glm::ivec3>::value);
+    CORRADE_VERIFY(IsLayoutCompatible<glm::dvec4>::value);
+    CORRADE_VERIFY(IsLayoutCompatible<glm::mat3>::value);
+    CORRADE_VERIFY(IsLayoutCompatible<glm::dmat4x2>::value);
+    CORRADE_VERIFY(IsLayoutCompatible<glm::mediump_vec3>::value);
+
+    /* Subclasses */
+    CORRADE_VERIFY(IsLayoutCompatible<glm::vec3, Color3>::value);
+    CORRADE_VERIFY(IsLayoutCompatible<glm::mat4, Matrix4>::value);
+    CORRADE_VERIFY(IsLayoutCompatible<glm::dmat3, Matrix3d>::value);
+
+    /* Different type or size */
+    CORRADE_VERIFY(!IsLayoutCompatible<glm::vec3, Vector3d>::value);
+    CORRADE_VERIFY(!IsLayoutCompatible<glm::vec3, Vector4>::value);
+    CORRADE_VERIFY(!IsLayoutCompatible<glm::mat4, Matrix3>::value);
+
+    /* Bool vectors, non-GLM types */
+    CORRADE_VERIFY(!IsLayoutCompatible<glm::bvec3>::value);
+    CORRADE_VERIFY(!IsLayoutCompatible<glm::bvec3, Math::BitVector<3>>::value);
+    CORRADE_VERIFY(!IsLayoutCompatible<Vector3>::value);
+    CORRADE_VERIFY(!IsLayoutCompatible<Float>::value);
+
+    /* Default types have the same alignment */
+    CORRADE_VERIFY(IsAlignmentCompatible<glm::vec4>::value);
+    CORRADE_VERIFY(IsAlignmentCompatible<glm::mat4, Matrix4>::value);
+    CORRADE_VERIFY(!IsAlignmentCompatible<glm::bvec3>::value);
+
+    /* Usable in a constant expression */
+    constexpr bool compatible = IsLayoutCompatible<glm::vec3>::value;
+    CORRADE_VERIFY(compatible);
+}
+
+void ArrayIntegrationTest::layoutCompatibleAligned() {
+    #if GLM_VERSION >= 990 && defined(GLM_CONFIG_ALIGNED_GENTYPES) && GLM_CONFIG_ALIGNED_GENTYPES == GLM_ENABLE
+    /* Packed types are the same as the default */
+    CORRADE_VERIFY((IsLayoutCompatible<glm::vec<3, Float, glm::packed_highp>>::value));
+    CORRADE_VERIFY((IsAlignmentCompatible<glm::vec<3, Float, glm::packed_highp>>::value));
+
+    /* Aligned three-component vectors are padded */
+    CORRADE_VERIFY(!(IsLayoutCompatible<glm::vec<3, Float, glm::aligned_highp>>::value));
+    CORRADE_VERIFY(!(IsAlignmentCompatible<glm::vec<3, Float, glm::aligned_highp>>::value));
+
+    /* Four-component vectors have the same size but a stricter alignment */
+    CORRADE_VERIFY((IsLayoutCompatible<glm::vec<4, Float, glm::aligned_highp>>::value));
+    CORRADE_VERIFY(!(IsAlignmentCompatible<glm::vec<4, Float, glm::aligned_highp>>::value));
+    #else
+    CORRADE_SKIP("Aligned GLM types are not available.");
+    #endif
+}
+
+void ArrayIntegrationTest::castVectors() {
+    glm::vec3 data[]{
+        {1.0f, 2.0f, 3.0f},
+        {4.0f, 5.0f, 6.0f}
+    };
+
+    Containers::ArrayView<Vector3> out = GlmIntegration::arrayCast(Containers::arrayView(data));
+    CORRADE_COMPARE(static_cast<void*>(out.data()), static_cast<void*>(data));
+    CORRADE_COMPARE_AS(out, Containers::arrayView<Vector3>({
+        {1.0f, 2.0f, 3.0f},
+        {4.0f, 5.0f, 6.0f}
+    }), TestSuite::Compare::Container);
+
+    /* The data are referenced, not copied */
+    out[1].y() = 7.5f;
+    CORRADE_COMPARE(data[1].y, 7.5f);
+
+    glm::ivec2 ints[]{{3, -1}, {5, 7}};
+    Containers::StridedArrayView1D<Vector2i> outInts = GlmIntegration::arrayCast(Containers::stridedArrayView(ints));
+    CORRADE_COMPARE_AS(outInts, Containers::arrayView<Vector2i>({
+        {3, -1}, {5, 7}
+    }), TestSuite::Compare::Container);
+}
+
+void ArrayIntegrationTest::castVectorsConst() {
+    const std::vector<glm::dvec4> data{
+        {1.0, 2.0, 3.0, 4.0},
+        {5.0, 6.0, 7.0, 8.0}
+    };
+
+    Containers::ArrayView<const Vector4d> out = GlmIntegration::arrayCast(Containers::arrayView(data));
+    CORRADE_COMPARE(out.size(), 2);
+    CORRADE_COMPARE(out[1], (Vector4d{5.0, 6.0, 7.0, 8.0}));
+}
+
+void ArrayIntegrationTest::castVectorsStrided() {
+    struct Vertex {
+        glm::vec3 position;
+        glm::vec2 textureCoordinates;
+    } vertices[]{
+        {{1.0f, 2.0f, 3.0f}, {0.25f, 0.5f}},
+        {{4.0f, 5.0f, 6.0f}, {0.75f, 1.0f}}
+    };
+
+    Containers::StridedArrayView1D<Vertex> view = vertices;
+    Containers::StridedArrayView1D<Vector2> textureCoordinates = GlmIntegration::arrayCast(view.slice(&Vertex::textureCoordinates));
+    CORRADE_COMPARE(textureCoordinates.stride(), sizeof(Vertex));
+    CORRADE_COMPARE_AS(textureCoordinates, Containers::arrayView<Vector2>({
+        {0.25f, 0.5f}, {0.75f, 1.0f}
+    }), TestSuite::Compare::Container);
+}
+
+void ArrayIntegrationTest::castMatrices() {
+    const glm::mat3 data[]{
+        glm::mat3(Matrix3::rotation(35.0_degf)),
+        glm::mat3(Matrix3::translation({1.0f, 2.0f}))
+    };
+
+    /* The default is the RectangularMatrix base */
+    Containers::ArrayView<const Math::RectangularMatrix<3, 3, Float>> out = GlmIntegration::arrayCast(Containers::arrayView(data));
+    CORRADE_COMPARE(out[0], Matrix3::rotation(35.0_degf));
+    CORRADE_COMPARE(out[1], Matrix3::translation({1.0f, 2.0f}));
+
+    const glm::dmat4x3 dataRectangular[]{
+        glm::dmat4x3(Matrix4x3d{Vector3d{1.0}, Vector3d{2.0}, Vector3d{3.0}, Vector3d{4.0}})
+    };
+    Containers::ArrayView<const Math::RectangularMatrix<4, 3, Double>> outRectangular = GlmIntegration::arrayCast(Containers::arrayView(dataRectangular));
+    CORRADE_COMPARE(outRectangular[0][3], Vector3d{4.0});
+}
+
+void ArrayIntegrationTest::castToGlm() {
+    Matrix4 data[]{
+        Matrix4::translation({1.0f, 2.0f, 3.0f}),
+        Matrix4::scaling({2.0f, 3.0f, 4.0f})
+    };
+
+    Containers::ArrayView<glm::mat4> out = GlmIntegration::arrayCast<glm::mat4>(Containers::arrayView(data));
+    CORRADE_COMPARE(static_cast<void*>(out.data()), static_cast<void*>(data));
+    CORRADE_COMPARE(out[0][3].z, 3.0f);
+    CORRADE_COMPARE(out[1][2].z, 4.0f);
+
+    Containers::StridedArrayView1D<const glm::mat4> outConst = GlmIntegration::arrayCast<const glm::mat4>(Containers::stridedArrayView(data));
+    CORRADE_COMPARE(outConst[1][1].y, 3.0f);
+}
+
+void ArrayIntegrationTest::castSubclass() {
+    glm::vec3 data[]{
+        {1.0f, 0.5f, 0.25f}
+    };
+
+    Containers::ArrayView<Color3> out = GlmIntegration::arrayCast<Color3>(Containers::arrayView(data));
+    CORRADE_COMPARE(out[0].g(), 0.5f);
+
+    const glm::mat4 matrices[]{
+        glm::mat4(Matrix4::translation({1.0f, 2.0f, 3.0f}))
+    };
+    Containers::StridedArrayView1D<const Matrix4> outMatrices = GlmIntegration::arrayCast<const Matrix4>(Containers::stridedArrayView(matrices));
+    CORRADE_COMPARE(outMatrices[0].translation(), (Vector3{1.0f, 2.0f, 3.0f}));
+}
+
+void ArrayIntegrationTest::convert() {
+    const Vector3 data[]{
+        {1.0f, 2.0f, 3.0f},
+        {4.0f, 5.0f, 6.0f}
+    };
+
+    std::vector<glm::vec3> out(2);
+    GlmIntegration::convertInto(Containers::stridedArrayView(data), Containers::stridedArrayView(out));
+    CORRADE_COMPARE(out[0].z, 3.0f);
+    CORRADE_COMPARE(out[1].x, 4.0f);
+
+    Matrix3x2 back[2];
+    const glm::mat3x2 matrices[]{
+        glm::mat3x2(Matrix3x2{Vector2{1.0f}, Vector2{2.0f}, Vector2{3.0f}}),
+        glm::mat3x2(Matrix3x2{Vector2{4.0f}, Vector2{5.0f}, Vector2{6.0f}})
+    };
+    GlmIntegration::convertInto(Containers::stridedArrayView(matrices), Containers::stridedArrayView(back));
+    CORRADE_COMPARE(back[1][2], Vector2{6.0f});
+}
+
+void ArrayIntegrationTest::convertStrided() {
+    const glm::vec2 data[]{
+        {1.0f, 2.0f}, {3.0f, 4.0f}, {5.0f, 6.0f}, {7.0f, 8.0f}
+    };
+
+    Vector2 out[2];
+    GlmIntegration::convertInto(Containers::stridedArrayView(data).every(2), Containers::stridedArrayView(out));
+    CORRADE_COMPARE_AS(Containers::arrayView(out), Containers::arrayView<Vector2>({
+        {1.0f, 2.0f}, {5.0f, 6.0f}
+    }), TestSuite::Compare::Container);
+}
+
+void ArrayIntegrationTest::convertInvalidSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const glm::vec2 data[3]{};
+    Vector2 converted[2];
+
+    Containers::String out;
+    Error redirectError{&out};
+    GlmIntegration::convertInto(Containers::stridedArrayView(data), Containers::stridedArrayView(converted));
+    CORRADE_COMPARE(out, "GlmIntegration::convertInto(): expected source and destination views to have the same size, got 3 and 2\n");
+}
+
+void ArrayIntegrationTest::debugPacked() {
+    const glm::vec3 data[]{
+        {1.0f, 2.5f, -3.0f},
+        {0.7f, 0.0f, 1.0e-7f}
+    };
+    const glm::ivec2 ints[]{{1, -42}};
+    const glm::dvec4 doubles[]{{1.0, 0.123456789012, -2.0, 3.5}};
+
+    Containers::String out;
+    Debug{&out} << GlmIntegration::debugPacked(Containers::arrayView(data));
+    Debug{&out} << GlmIntegration::debugPacked(Containers::stridedArrayView(ints));
+    Debug{&out} << GlmIntegration::debugPacked(Containers::arrayView(doubles));
+    CORRADE_COMPARE(out,
+        "1 2.5 -3\n"
+        "0.7 0 1e-07\n"
+        "1 -42\n"
+        "1 0.123456789012 -2 3.5\n");
+}
+
+void ArrayIntegrationTest::debugPackedMatrix() {
+    const glm::mat2x3 data[]{
+        glm::mat2x3{1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f},
+        glm::mat2x3{7.0f, 8.0f, 9.0f, 10.0f, 11.0f, 12.0f}
+    };
+
+    Containers::String out;
+    Debug{&out} << GlmIntegration::debugPacked(Containers::arrayView(data));
+    CORRADE_COMPARE(out,
+        "1 2 3, 4 5 6\n"
+        "7 8 9, 10 11 12\n");
+}
+
+void ArrayIntegrationTest::dumpBinary() {
+    const glm::vec2 data[]{{1.0f, 2.0f}, {3.0f, 4.0f}};
+
+    Containers::Array<char> out = GlmIntegration::dumpBinary(Containers::arrayView(data));
+    CORRADE_COMPARE_AS(Containers::arrayCast<const Float>(out), Containers::arrayView<Float>({
+        1.0f, 2.0f, 3.0f, 4.0f
+    }), TestSuite::Compare::Container);
+}
+
+void ArrayIntegrationTest::dumpBinaryStrided() {
+    const glm::uvec2 data[]{{1, 2}, {3, 4}, {5, 6}};
+
+    Containers::Array<char> out = GlmIntegration::dumpBinary(Containers::stridedArrayView(data).every(2));
+    CORRADE_COMPARE_AS(Containers::arrayCast<const UnsignedInt>(out), Containers::arrayView<UnsignedInt>({
+        1, 2, 5, 6
+    }), TestSuite::Compare::Container);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::GlmIntegration::Test::ArrayIntegrationTest)
@@ -33,38 +33,377 @@
 
 #include "Context.h"
 
+#include <chrono>
 #include <cstring>
+#include <utility>
 #include <imgui.h>
+#include <Corrade/Containers/EnumSet.hpp>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Iterable.h>
 #include <Corrade/Containers/Reference.h>
+#include <Corrade/Utility/Algorithms.h>
 #include <Corrade/Utility/Resource.h>
 #include <Magnum/ImageView.h>
+#include <Magnum/PixelStorage.h>
 #include <Magnum/PixelFormat.h>
+#include <Magnum/GL/BufferImage.h>
 #include <Magnum/GL/Context.h>
 #include <Magnum/GL/DefaultFramebuffer.h>
 #include <Magnum/GL/Extensions.h>
+#include <Magnum/GL/MeshView.h>
 #include <Magnum/GL/PixelFormat.h>
 #include <Magnum/GL/Renderer.h>
 #include <Magnum/GL/Shader.h>
 #include <Magnum/GL/Texture.h>
+#ifndef MAGNUM_TARGET_GLES2
+#include <Magnum/GL/TextureArray.h>
+#endif
 #include <Magnum/GL/TextureFormat.h>
 #include <Magnum/GL/Version.h>
+#include <Magnum/Math/Functions.h>
 #include <Magnum/Math/Matrix3.h>
+#include <Magnum/Math/Range.h>
 
+#include "Magnum/instrumentationIntegration.h"
 #include "Magnum/ImGuiIntegration/Integration.h"
+#include "Magnum/ImGuiIntegration/SharedResources.h"
 #include "Magnum/ImGuiIntegration/Widgets.h"
 #include <vector>
 
 namespace Magnum { namespace ImGuiIntegration {
 
+namespace {
+
+void setupMesh(GL::Mesh& mesh, GL::Buffer& vertexBuffer) {
+    mesh.setPrimitive(GL::MeshPrimitive::Triangles);
+    mesh.addVertexBuffer(vertexBuffer, 0,
+        Shaders::FlatGL2D::Position{},
+        Shaders::FlatGL2D::TextureCoordinates{},
+        Shaders::FlatGL2D::Color4{
+            Shaders::FlatGL2D::Color4::DataType::UnsignedByte,
+            Shaders::FlatGL2D::Color4::DataOption::Normalized});
+}
+
+/* Merges overlapping and adjacent rectangles if the union doesn't cover more
+   area than the two rectangles separately, i.e. if no pixels that weren't
+   updated would get uploaded */
+void mergeUpdateRects(Containers::Array<Range2Di>& rects) {
+    for(bool merged = true; merged; ) {
+        merged = false;
+        for(std::size_t i = 0; i < rects.size() && !merged; ++i) {
+            for(std::size_t j = i + 1; j < rects.size(); ++j) {
+                const Range2Di& a = rects[i];
+                const Range2Di& b = rects[j];
+                /* Touching edges count as well */
+                if((a.max() < b.min()).any() || (b.max() < a.min()).any())
+                    continue;
+
+                const Range2Di join = Math::join(a, b);
+                const Range2Di intersection = Math::intersect(a, b);
+                if(join.size().product() > a.size().product() + b.size().product() - intersection.size().product())
+                    continue;
+
+                rects[i] = join;
+                arrayRemoveUnordered(rects, j);
+                merged = true;
+                break;
+            }
+        }
+    }
+}
+
+void trimTexturePool(Implementation::ImGuiTextureStorage& storage) {
+    while(storage.poolMemory > storage.poolCapacity) {
+        storage.poolMemory -= storage.pool.front().size.product()*4;
+        storage.pool.pop_front();
+    }
+}
+
+/* Scissor rectangle of a draw command in framebuffer coordinates, with the
+   origin at the bottom left */
+Range2Di clipRectangle(const ImDrawCmd& cmd, const Vector2& framebufferSize, const Vector2& supersamplingRatio) {
+    return Range2Di{Range2D{
+        {cmd.ClipRect.x, framebufferSize.y() - cmd.ClipRect.w},
+        {cmd.ClipRect.z, framebufferSize.y() - cmd.ClipRect.y}}
+            .scaled(supersamplingRatio)};
+}
+
+#ifndef MAGNUM_TARGET_GLES
+/* Segment count for the persistently mapped ring buffers. Three segments
+   allow the CPU to fill one while the GPU still reads from two previous
+   frames. */
+constexpr UnsignedInt RingSegmentCount = 3;
+#endif
+
+#ifndef MAGNUM_TARGET_GLES2
+/* Set on IDs returned by registerTexture() to distinguish them from plain
+   texture IDs coming from textureId(GL::Texture2D&). The remaining bits are
+   an index into the registry. */
+constexpr UnsignedInt RegisteredTextureBit = 0x80000000u;
+#endif
+
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+namespace Implementation {
+
+/* Like FlatGL2D with Textured|VertexColor, but additionally discarding
+   fragments outside of a per-vertex clip rectangle. Used by
+   Flag::ShaderClipping. The variant with texture arrays is used for drawing
+   array layers registered with Context::registerTexture(). */
+class ClipShaderGL: public GL::AbstractShaderProgram {
+    public:
+        typedef Shaders::FlatGL2D::Position Position;
+        typedef Shaders::FlatGL2D::TextureCoordinates TextureCoordinates;
+        typedef Shaders::FlatGL2D::Color4 Color4;
+        /* Min and max corner in framebuffer pixels, as unsigned shorts */
+        typedef GL::Attribute<3, Vector4> ClipRectangle;
+
+        explicit ClipShaderGL(bool textureArrays = false);
+
+        ClipShaderGL& setTransformationProjectionMatrix(const Matrix3& matrix) {
+            setUniform(_transformationProjectionMatrixUniform, matrix);
+            return *this;
+        }
+
+        ClipShaderGL& bindTexture(GL::Texture2D& texture) {
+            texture.bind(TextureUnit);
+            return *this;
+        }
+
+        /* Only for the texture array variant */
+        ClipShaderGL& bindTexture(GL::Texture2DArray& texture) {
+            texture.bind(TextureUnit);
+            return *this;
+        }
+
+        /* Only for the texture array variant */
+        ClipShaderGL& setTextureLayer(UnsignedInt layer) {
+            setUniform(_textureLayerUniform, Float(layer));
+            return *this;
+        }
+
+    private:
+        enum: Int { TextureUnit = 0 };
+
+        Int _transformationProjectionMatrixUniform,
+            _textureLayerUniform{-1};
+};
+
+static_assert(ClipShaderGL::ClipRectangle::Location != ClipShaderGL::Position::Location &&
+              ClipShaderGL::ClipRectangle::Location != ClipShaderGL::TextureCoordinates::Location &&
+              ClipShaderGL::ClipRectangle::Location != ClipShaderGL::Color4::Location,
+    "clip rectangle attribute location overlaps with a builtin attribute");
+
+ClipShaderGL::ClipShaderGL(const bool textureArrays) {
+    #ifndef MAGNUM_TARGET_GLES
+    const GL::Version version = GL::Version::GL300;
+    #else
+    const GL::Version version = GL::Version::GLES300;
+    #endif
+
+    GL::Shader vert{version, GL::Shader::Type::Vertex};
+    vert.addSource(R"GLSL(
+uniform highp mat3 transformationProjectionMatrix;
+
+in highp vec2 position;
+in mediump vec2 textureCoordinates;
+in lowp vec4 color;
+in highp vec4 clipRectangle;
+
+out mediump vec2 interpolatedTextureCoordinates;
+out lowp vec4 interpolatedColor;
+flat out highp vec4 interpolatedClipRectangle;
+
+void main() {
+    gl_Position = vec4((transformationProjectionMatrix*vec3(position, 1.0)).xy, 0.0, 1.0);
+    interpolatedTextureCoordinates = textureCoordinates;
+    interpolatedColor = color;
+    interpolatedClipRectangle = clipRectangle;
+}
+)GLSL");
+
+    GL::Shader frag{version, GL::Shader::Type::Fragment};
+    frag.addSource(textureArrays ? "#define TEXTURE_ARRAYS\n" : "");
+    frag.addSource(R"GLSL(
+precision highp float;
+
+#ifdef TEXTURE_ARRAYS
+uniform lowp sampler2DArray textureData;
+uniform highp float textureLayer;
+#else
+uniform lowp sampler2D textureData;
+#endif
+
+in mediump vec2 interpolatedTextureCoordinates;
+in lowp vec4 interpolatedColor;
+flat in highp vec4 interpolatedClipRectangle;
+
+out lowp vec4 fragmentColor;
+
+void main() {
+    if(any(lessThan(gl_FragCoord.xy, interpolatedClipRectangle.xy)) ||
+       any(greaterThanEqual(gl_FragCoord.xy, interpolatedClipRectangle.zw)))
+        discard;
+    #ifdef TEXTURE_ARRAYS
+    fragmentColor = interpolatedColor*texture(textureData, vec3(interpolatedTextureCoordinates, textureLayer));
+    #else
+    fragmentColor = interpolatedColor*texture(textureData, interpolatedTextureCoordinates);
+    #endif
+}
+)GLSL");
+
+    CORRADE_INTERNAL_ASSERT_OUTPUT(vert.compile() && frag.compile());
+
+    attachShaders({vert, frag});
+    bindAttributeLocation(Position::Location, "position");
+    bindAttributeLocation(TextureCoordinates::Location, "textureCoordinates");
+    bindAttributeLocation(Color4::Location, "color");
+    bindAttributeLocation(ClipRectangle::Location, "clipRectangle");
+    #ifndef MAGNUM_TARGET_GLES
+    bindFragmentDataLocation(0, "fragmentColor");
+    #endif
+    CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+
+    _transformationProjectionMatrixUniform = uniformLocation("transformationProjectionMatrix");
+    if(textureArrays)
+        _textureLayerUniform = uniformLocation("textureLayer");
+    setUniform(uniformLocation("textureData"), TextureUnit);
+}
+
+/* Like FlatGL2D with Textured|VertexColor, but interpreting the alpha channel
+   as a distance field. Used by Flag::DistanceFieldFonts for the font atlas
+   textures, optionally with the same clipping as ClipShaderGL. */
+class DistanceFieldShaderGL: public GL::AbstractShaderProgram {
+    public:
+        typedef Shaders::FlatGL2D::Position Position;
+        typedef Shaders::FlatGL2D::TextureCoordinates TextureCoordinates;
+        typedef Shaders::FlatGL2D::Color4 Color4;
+        typedef ClipShaderGL::ClipRectangle ClipRectangle;
+
+        explicit DistanceFieldShaderGL(bool clip);
+
+        DistanceFieldShaderGL& setTransformationProjectionMatrix(const Matrix3& matrix) {
+            setUniform(_transformationProjectionMatrixUniform, matrix);
+            return *this;
+        }
+
+        DistanceFieldShaderGL& bindTexture(GL::Texture2D& texture) {
+            texture.bind(TextureUnit);
+            return *this;
+        }
+
+    private:
+        enum: Int { TextureUnit = 0 };
+
+        Int _transformationProjectionMatrixUniform;
+};
+
+DistanceFieldShaderGL::DistanceFieldShaderGL(const bool clip) {
+    #ifndef MAGNUM_TARGET_GLES
+    const GL::Version version = GL::Version::GL300;
+    #else
+    const GL::Version version = GL::Version::GLES300;
+    #endif
+
+    GL::Shader vert{version, GL::Shader::Type::Vertex};
+    vert.addSource(clip ? "#define CLIP\n" : "");
+    vert.addSource(R"GLSL(
+uniform highp mat3 transformationProjectionMatrix;
+
+in highp vec2 position;
+in mediump vec2 textureCoordinates;
+in lowp vec4 color;
+#ifdef CLIP
+in highp vec4 clipRectangle;
+#endif
+
+out mediump vec2 interpolatedTextureCoordinates;
+out lowp vec4 interpolatedColor;
+#ifdef CLIP
+flat out highp vec4 interpolatedClipRectangle;
+#endif
+
+void main() {
+    gl_Position = vec4((transformationProjectionMatrix*vec3(position, 1.0)).xy, 0.0, 1.0);
+    interpolatedTextureCoordinates = textureCoordinates;
+    interpolatedColor = color;
+    #ifdef CLIP
+    interpolatedClipRectangle = clipRectangle;
+    #endif
+}
+)GLSL");
+
+    GL::Shader frag{version, GL::Shader::Type::Fragment};
+    frag.addSource(clip ? "#define CLIP\n" : "");
+    frag.addSource(R"GLSL(
+precision highp float;
+
+uniform lowp sampler2D textureData;
+
+in mediump vec2 interpolatedTextureCoordinates;
+in lowp vec4 interpolatedColor;
+#ifdef CLIP
+flat in highp vec4 interpolatedClipRectangle;
+#endif
+
+out lowp vec4 fragmentColor;
+
+void main() {
+    #ifdef CLIP
+    if(any(lessThan(gl_FragCoord.xy, interpolatedClipRectangle.xy)) ||
+       any(greaterThanEqual(gl_FragCoord.xy, interpolatedClipRectangle.zw)))
+        discard;
+    #endif
+    lowp vec4 texel = texture(textureData, interpolatedTextureCoordinates);
+    /* The edge is at 0.5, smoothed over roughly a pixel of the output
+       regardless of the scale the glyphs are drawn at */
+    mediump float smoothness = max(0.7*fwidth(texel.a), 1.0/255.0);
+    fragmentColor = interpolatedColor*vec4(texel.rgb, smoothstep(0.5 - smoothness, 0.5 + smoothness, texel.a));
+}
+)GLSL");
+
+    CORRADE_INTERNAL_ASSERT_OUTPUT(vert.compile() && frag.compile());
+
+    attachShaders({vert, frag});
+    bindAttributeLocation(Position::Location, "position");
+    bindAttributeLocation(TextureCoordinates::Location, "textureCoordinates");
+    bindAttributeLocation(Color4::Location, "color");
+    if(clip)
+        bindAttributeLocation(ClipRectangle::Location, "clipRectangle");
+    #ifndef MAGNUM_TARGET_GLES
+    bindFragmentDataLocation(0, "fragmentColor");
+    #endif
+    CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+
+    _transformationProjectionMatrixUniform = uniformLocation("transformationProjectionMatrix");
+    setUniform(uniformLocation("textureData"), TextureUnit);
+}
+
+}
+#endif
+
 Context::Context(const Vector2& size, const Vector2i& windowSize, const Vector2i& framebufferSize): Context{*ImGui::CreateContext(), size, windowSize, framebufferSize} {}
 
 Context::Context(const Vector2i& size): Context{Vector2{size}, size, size} {}
 
-Context::Context(ImGuiContext& context, const Vector2& size, const Vector2i& windowSize, const Vector2i& framebufferSize):
+Context::Context(ImGuiContext& context, const Vector2& size, const Vector2i& windowSize, const Vector2i& framebufferSize): Context{context, nullptr, size, windowSize, framebufferSize} {}
+
+Context::Context(SharedResources& resources, const Vector2& size, const Vector2i& windowSize, const Vector2i& framebufferSize): Context{*ImGui::CreateContext(&resources.atlas()), &resources, size, windowSize, framebufferSize} {}
+
+Context::Context(SharedResources& resources, const Vector2i& size): Context{resources, Vector2{size}, size, size} {}
+
+Context::Context(ImGuiContext& context, SharedResources* const sharedResources, const Vector2& size, const Vector2i& windowSize, const Vector2i& framebufferSize):
     _context{&context},
-    _shader{Shaders::FlatGL2D::Configuration{}
-        .setFlags(Shaders::FlatGL2D::Flag::Textured|Shaders::FlatGL2D::Flag::VertexColor)}
+    _sharedResources{sharedResources},
+    _shader{NoCreate}
 {
+    /* Compile a shader only if there isn't a shared one. The compilation is
+       finished in the first drawFrame() to give the driver a chance to do it
+       in parallel. */
+    if(!sharedResources) _shaderCompileState.emplace(Shaders::FlatGL2D::compile(Shaders::FlatGL2D::Configuration{}
+        .setFlags(Shaders::FlatGL2D::Flag::Textured|Shaders::FlatGL2D::Flag::VertexColor)));
+
     /* Ensure we use the context we're linked to */
     ImGui::SetCurrentContext(&context);
 
@@ -103,29 +442,66 @@ Context::Context(ImGuiContext& context, const Vector2& size, const Vector2i& win
        cache */
     relayout(size, windowSize, framebufferSize);
 
-    _mesh.setPrimitive(GL::MeshPrimitive::Triangles);
-    _mesh.addVertexBuffer(_vertexBuffer, 0,
-        Shaders::FlatGL2D::Position{},
-        Shaders::FlatGL2D::TextureCoordinates{},
-        Shaders::FlatGL2D::Color4{
-            Shaders::FlatGL2D::Color4::DataType::UnsignedByte,
-            Shaders::FlatGL2D::Color4::DataOption::Normalized});
+    setupMesh(_mesh, _vertexBuffer);
 
     _timeline.start();
 }
 
 Context::Context(ImGuiContext& context, const Vector2i& size): Context{context, Vector2{size}, size, size} {}
 
-Context::Context(NoCreateT) noexcept: _context{nullptr}, _shader{NoCreate}, _texture{NoCreate}, _vertexBuffer{NoCreate}, _indexBuffer{NoCreate}, _mesh{NoCreate} {}
+Context::Context(NoCreateT) noexcept: _context{nullptr}, _sharedResources{nullptr}, _shader{NoCreate}, _texture{NoCreate}, _vertexBuffer{NoCreate}, _indexBuffer{NoCreate}, _mesh{NoCreate} {}
 
-Context::Context(Context&& other) noexcept: _context{other._context}, _shader{Utility::move(other._shader)}, _texture{Utility::move(other._texture)}, _vertexBuffer{Utility::move(other._vertexBuffer)}, _indexBuffer{Utility::move(other._indexBuffer)}, _timeline{Utility::move(other._timeline)}, _mesh{Utility::move(other._mesh)}, _supersamplingRatio{other._supersamplingRatio}, _eventScaling{other._eventScaling} {
+Context::Context(Context&& other) noexcept: _context{other._context}, _sharedResources{other._sharedResources}, _shader{Utility::move(other._shader)}, _shaderCompileState{Utility::move(other._shaderCompileState)}, _texture{Utility::move(other._texture)}, _vertexBuffer{Utility::move(other._vertexBuffer)}, _indexBuffer{Utility::move(other._indexBuffer)}, _timeline{Utility::move(other._timeline)}, _mesh{Utility::move(other._mesh)}, _supersamplingRatio{other._supersamplingRatio}, _eventScaling{other._eventScaling}, _vertexData{Utility::move(other._vertexData)}, _indexData{Utility::move(other._indexData)}, _flags{other._flags}, _stateChangeStatistics{other._stateChangeStatistics}, _drawViews{Utility::move(other._drawViews)}, _textureStorage{Utility::move(other._textureStorage)}, _frameStatistics{other._frameStatistics}, _uploadedVertexDataSize{other._uploadedVertexDataSize}, _uploadedIndexDataSize{other._uploadedIndexDataSize}, _redrawFrames{other._redrawFrames}, _animating{other._animating}, _pointerMovePending{other._pointerMovePending}, _wantCaptureMouse{other._wantCaptureMouse}, _pendingPointerSource{other._pendingPointerSource}, _pendingPointerPosition{other._pendingPointerPosition}
+    #ifndef MAGNUM_TARGET_WEBGL
+    , _timeQueries{Utility::move(other._timeQueries[0]), Utility::move(other._timeQueries[1]), Utility::move(other._timeQueries[2])}, _timeQueryIndex{other._timeQueryIndex}, _timeQueriesPending{other._timeQueriesPending}
+    #endif
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    , _textureUploads{Utility::move(other._textureUploads)}
+    #endif
+    #ifndef MAGNUM_TARGET_GLES
+    , _ringVertexData{other._ringVertexData}, _ringIndexData{other._ringIndexData}, _ringVertexCapacity{other._ringVertexCapacity}, _ringIndexCapacity{other._ringIndexCapacity}, _ringSegment{other._ringSegment}
+    #endif
+    #ifndef MAGNUM_TARGET_GLES2
+    , _clipShader{Utility::move(other._clipShader)}, _clipBuffer{Utility::move(other._clipBuffer)}, _clipMesh{Utility::move(other._clipMesh)}, _clipData{Utility::move(other._clipData)}, _registeredTextures{Utility::move(other._registeredTextures)}, _arrayShader{Utility::move(other._arrayShader)}, _clipArrayShader{Utility::move(other._clipArrayShader)}, _distanceFieldShader{Utility::move(other._distanceFieldShader)}, _clipDistanceFieldShader{Utility::move(other._clipDistanceFieldShader)}
+    #endif
+{
     other._context = nullptr;
+    other._shaderCompileState = Containers::NullOpt;
+    #ifndef MAGNUM_TARGET_GLES
+    for(std::size_t i = 0; i != RingSegmentCount; ++i) {
+        _ringFences[i] = other._ringFences[i];
+        other._ringFences[i] = nullptr;
+    }
+    other._ringVertexData = nullptr;
+    other._ringIndexData = nullptr;
+    other._ringVertexCapacity = other._ringIndexCapacity = 0;
+    #endif
 }
 
 Context::~Context() {
+    #ifndef MAGNUM_TARGET_GLES
+    for(void* fence: _ringFences)
+        if(fence) glDeleteSync(static_cast<GLsync>(fence));
+    #endif
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    for(TextureUpload& upload: _textureUploads)
+        if(upload.fence) glDeleteSync(static_cast<GLsync>(upload.fence));
+    #endif
+
     if(_context) {
         /* Ensure we destroy the context we're linked to */
         ImGui::SetCurrentContext(_context);
+
+        /* The textures get deleted together with this instance, mark them as
+           destroyed for ImGui. Textures of a shared atlas are owned by
+           SharedResources and stay. */
+        if(!_sharedResources) for(ImTextureData* tex: ImGui::GetPlatformIO().Textures) {
+            if(!tex->BackendUserData) continue;
+            tex->BackendUserData = nullptr;
+            tex->SetTexID(ImTextureID_Invalid);
+            tex->SetStatus(ImTextureStatus_Destroyed);
+        }
+
         ImGui::DestroyContext();
     }
 }
@@ -133,7 +509,9 @@ Context::~Context() {
 Context& Context::operator=(Context&& other) noexcept {
     using Utility::swap;
     swap(_context, other._context);
+    swap(_sharedResources, other._sharedResources);
     swap(_shader, other._shader);
+    swap(_shaderCompileState, other._shaderCompileState);
     swap(_texture, other._texture);
     swap(_vertexBuffer, other._vertexBuffer);
     swap(_indexBuffer, other._indexBuffer);
@@ -141,9 +519,56 @@ Context& Context::operator=(Context&& other) noexcept {
     swap(_mesh, other._mesh);
     swap(_supersamplingRatio, other._supersamplingRatio);
     swap(_eventScaling, other._eventScaling);
+    swap(_vertexData, other._vertexData);
+    swap(_indexData, other._indexData);
+    swap(_flags, other._flags);
+    swap(_stateChangeStatistics, other._stateChangeStatistics);
+    swap(_drawViews, other._drawViews);
+    swap(_textureStorage, other._textureStorage);
+    swap(_frameStatistics, other._frameStatistics);
+    swap(_uploadedVertexDataSize, other._uploadedVertexDataSize);
+    swap(_uploadedIndexDataSize, other._uploadedIndexDataSize);
+    swap(_redrawFrames, other._redrawFrames);
+    swap(_animating, other._animating);
+    swap(_pointerMovePending, other._pointerMovePending);
+    swap(_wantCaptureMouse, other._wantCaptureMouse);
+    swap(_pendingPointerSource, other._pendingPointerSource);
+    swap(_pendingPointerPosition, other._pendingPointerPosition);
+    #ifndef MAGNUM_TARGET_WEBGL
+    swap(_timeQueries, other._timeQueries);
+    swap(_timeQueryIndex, other._timeQueryIndex);
+    swap(_timeQueriesPending, other._timeQueriesPending);
+    #endif
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    swap(_textureUploads, other._textureUploads);
+    #endif
+    #ifndef MAGNUM_TARGET_GLES
+    swap(_ringVertexData, other._ringVertexData);
+    swap(_ringIndexData, other._ringIndexData);
+    swap(_ringVertexCapacity, other._ringVertexCapacity);
+    swap(_ringIndexCapacity, other._ringIndexCapacity);
+    swap(_ringSegment, other._ringSegment);
+    swap(_ringFences, other._ringFences);
+    #endif
+    #ifndef MAGNUM_TARGET_GLES2
+    swap(_clipShader, other._clipShader);
+    swap(_clipBuffer, other._clipBuffer);
+    swap(_clipMesh, other._clipMesh);
+    swap(_clipData, other._clipData);
+    swap(_registeredTextures, other._registeredTextures);
+    swap(_arrayShader, other._arrayShader);
+    swap(_clipArrayShader, other._clipArrayShader);
+    swap(_distanceFieldShader, other._distanceFieldShader);
+    swap(_clipDistanceFieldShader, other._clipDistanceFieldShader);
+    #endif
     return *this;
 }
 
+bool Context::isShaderLinkFinished() {
+    if(_sharedResources) return _sharedResources->isShaderLinkFinished();
+    return !_shaderCompileState || _shaderCompileState->isLinkFinished();
+}
+
 ImGuiContext* Context::release() {
     ImGuiContext* context = _context;
     _context = nullptr;
@@ -155,6 +580,9 @@ void Context::relayout(const Vector2& size, const Vector2i& windowSize, const Ve
     /* Ensure we use the context we're linked to */
     ImGui::SetCurrentContext(_context);
 
+    /* The UI needs to be redrawn for the new size */
+    _redrawFrames = RedrawFrameCount;
+
     /* If size of the UI is 1024x576 with a 16px font but it's rendered to a
        3840x2160 framebuffer, we need to supersample the font 3,75x to get
        crisp enough look. This is the same as in Magnum::Ui::UserInterface. */
@@ -251,6 +679,136 @@ void Context::relayout(const Vector2i& size) {
     relayout(Vector2{size}, size, size);
 }
 
+Context& Context::setFlags(const Flags flags) {
+    #ifndef MAGNUM_TARGET_GLES
+    /* Persistently mapped buffers have an immutable storage, so go back to
+       regular buffers if the ring buffer is not wanted anymore */
+    if(!(flags & Flag::PersistentMappedBuffers) && _ringVertexCapacity)
+        destroyRingBuffers();
+    #endif
+
+    _flags = flags;
+    return *this;
+}
+
+#ifndef MAGNUM_TARGET_GLES
+void Context::destroyRingBuffers() {
+    for(void*& fence: _ringFences) if(fence) {
+        glDeleteSync(static_cast<GLsync>(fence));
+        fence = nullptr;
+    }
+
+    /* The buffers have an immutable storage, the only way to get rid of it is
+       to create new buffers. And because the mesh references the original
+       vertex buffer, it has to be recreated as well. Deleting a mapped buffer
+       unmaps it implicitly. */
+    _vertexBuffer = GL::Buffer{GL::Buffer::TargetHint::Array};
+    _indexBuffer = GL::Buffer{GL::Buffer::TargetHint::ElementArray};
+    _mesh = GL::Mesh{};
+    setupMesh(_mesh, _vertexBuffer);
+    /* The clip mesh references the original vertex buffer as well, it gets
+       recreated together with its buffer on next use */
+    _clipMesh = GL::Mesh{NoCreate};
+    _clipBuffer = GL::Buffer{NoCreate};
+
+    _ringVertexData = nullptr;
+    _ringIndexData = nullptr;
+    _ringVertexCapacity = _ringIndexCapacity = _ringSegment = 0;
+    _uploadedVertexDataSize = _uploadedIndexDataSize = ~std::size_t{};
+}
+#endif
+
+#ifndef MAGNUM_TARGET_GLES2
+void Context::prepareArrayShader(const bool clipInShader, const Matrix3& projection) {
+    if(clipInShader) {
+        if(!_clipArrayShader)
+            _clipArrayShader.emplace(true);
+        _clipArrayShader->setTransformationProjectionMatrix(projection);
+    } else {
+        if(!_arrayShader.id())
+            _arrayShader = Shaders::FlatGL2D{Shaders::FlatGL2D::Configuration{}
+                .setFlags(Shaders::FlatGL2D::Flag::Textured|
+                          Shaders::FlatGL2D::Flag::TextureArrays|
+                          Shaders::FlatGL2D::Flag::VertexColor)};
+        _arrayShader.setTransformationProjectionMatrix(projection);
+    }
+}
+
+void Context::prepareDistanceFieldShader(const bool clipInShader, const Matrix3& projection) {
+    Containers::Pointer<Implementation::DistanceFieldShaderGL>& shader = clipInShader ? _clipDistanceFieldShader : _distanceFieldShader;
+    if(!shader)
+        shader.emplace(clipInShader);
+    shader->setTransformationProjectionMatrix(projection);
+}
+
+bool Context::isFontTexture(const UnsignedInt id) const {
+    for(const Implementation::ImGuiTextureStorage::Texture& texture: textureStorage().textures)
+        if(texture.texture.id() == id) return true;
+    return false;
+}
+
+bool Context::prepareClipShader() {
+    #ifndef MAGNUM_TARGET_GLES
+    /* Flat interpolation needs GLSL 1.30 */
+    if(!GL::Context::current().isVersionSupported(GL::Version::GL300))
+        return false;
+    #endif
+
+    if(!_clipShader)
+        _clipShader.emplace();
+    /* Mesh ID can be zero even for a created mesh if VAOs are disabled, so
+       check the buffer instead */
+    if(!_clipBuffer.id()) {
+        _clipBuffer = GL::Buffer{GL::Buffer::TargetHint::Array};
+        _clipMesh = GL::Mesh{};
+        setupMesh(_clipMesh, _vertexBuffer);
+        _clipMesh.addVertexBuffer(_clipBuffer, 0,
+            Implementation::ClipShaderGL::ClipRectangle{
+                Implementation::ClipShaderGL::ClipRectangle::DataType::UnsignedShort});
+    }
+    return true;
+}
+
+RegisteredTexture Context::registerTextureInternal(const UnsignedInt id, const Int layer, const UnsignedInt sampler) {
+    /* Reuse a free entry if there's any */
+    std::size_t index = 0;
+    for(; index != _registeredTextures.size(); ++index)
+        if(!_registeredTextures[index].texture) break;
+    if(index == _registeredTextures.size())
+        arrayAppend(_registeredTextures, Implementation::RegisteredTextureData{});
+    _registeredTextures[index] = {id, sampler, layer};
+    return RegisteredTexture(RegisteredTextureBit|UnsignedInt(index));
+}
+
+RegisteredTexture Context::registerTexture(GL::Texture2D& texture, const UnsignedInt sampler) {
+    CORRADE_ASSERT(texture.id(),
+        "ImGuiIntegration::Context::registerTexture(): the texture is not created", {});
+    return registerTextureInternal(texture.id(), -1, sampler);
+}
+
+RegisteredTexture Context::registerTexture(GL::Texture2DArray& texture, const Int layer, const UnsignedInt sampler) {
+    CORRADE_ASSERT(texture.id(),
+        "ImGuiIntegration::Context::registerTexture(): the texture is not created", {});
+    CORRADE_ASSERT(layer >= 0,
+        "ImGuiIntegration::Context::registerTexture(): expected a non-negative layer, got" << layer, {});
+    return registerTextureInternal(texture.id(), layer, sampler);
+}
+
+void Context::unregisterTexture(const RegisteredTexture texture) {
+    const UnsignedInt index = UnsignedInt(texture) & ~RegisteredTextureBit;
+    CORRADE_ASSERT((UnsignedInt(texture) & RegisteredTextureBit) && index < _registeredTextures.size() && _registeredTextures[index].texture,
+        "ImGuiIntegration::Context::unregisterTexture(): texture" << Debug::hex << UnsignedInt(texture) << "is not registered", );
+    _registeredTextures[index].texture = 0;
+}
+
+std::size_t Context::registeredTextureCount() const {
+    std::size_t count = 0;
+    for(const Implementation::RegisteredTextureData& texture: _registeredTextures)
+        if(texture.texture) ++count;
+    return count;
+}
+#endif
+
 void Context::newFrame() {
     /* Ensure we use the context we're linked to */
     ImGui::SetCurrentContext(_context);
@@ -271,7 +829,23 @@ void Context::newFrame() {
     if(ImGui::GetFrameCount() != 0)
         io.DeltaTime = Math::max(io.DeltaTime, std::numeric_limits<float>::epsilon());
 
+    flushPendingPointerMove();
+
     ImGui::NewFrame();
+
+    /* Returned for coalesced pointer move events until the next frame */
+    _wantCaptureMouse = io.WantCaptureMouse;
+}
+
+void Context::flushPendingPointerMove() {
+    if(!_pointerMovePending) return;
+
+    ImGuiIO& io = ImGui::GetIO();
+    #if IMGUI_VERSION_NUM >= 18948
+    io.AddMouseSourceEvent(ImGuiMouseSource(_pendingPointerSource));
+    #endif
+    io.AddMousePosEvent(_pendingPointerPosition.x(), _pendingPointerPosition.y());
+    _pointerMovePending = false;
 }
 
 #define GL_CALL(_CALL)      _CALL
@@ -289,16 +863,50 @@ void Context::updateTexture(ImTextureData* tex){
         ImageView2D image(PixelFormat::RGBA8Unorm, {tex->Width, tex->Height}, 
         {tex->GetPixels(), std::size_t(tex->Width*tex->Height*tex->BytesPerPixel)});
 
-        GL::Texture2D *texture=new GL::Texture2D;
-        texture->setMagnificationFilter(GL::SamplerFilter::Linear)
-            .setMinificationFilter(GL::SamplerFilter::Linear)
-            #ifndef MAGNUM_TARGET_GLES2
-            .setStorage(1, GL::TextureFormat::RGBA8, image.size())
-            .setSubImage(0, {}, image)
-            #else
-            .setImage(0, GL::TextureFormat::RGBA, image)
+        /* Reuse a pooled texture of the same size, if there's any. Search
+           from the back to pick the most recently released one. */
+        Implementation::ImGuiTextureStorage& storage = textureStorage();
+        auto found = storage.pool.end();
+        for(auto it = storage.pool.rbegin(); it != storage.pool.rend(); ++it) {
+            if(it->size == image.size()) {
+                found = std::prev(it.base());
+                break;
+            }
+        }
+
+        GL::Texture2D *texture;
+        if(found != storage.pool.end()) {
+            storage.poolMemory -= found->size.product()*4;
+            storage.textures.splice(storage.textures.end(), storage.pool, found);
+            texture = &storage.textures.back().texture;
+            #ifdef MAGNUM_TARGET_GLES2
+            texture->setImage(0, GL::TextureFormat::RGBA, image);
             #endif
-            ;
+        } else {
+            storage.textures.push_back(Implementation::ImGuiTextureStorage::Texture{GL::Texture2D{}, image.size()});
+            texture = &storage.textures.back().texture;
+            texture->setMagnificationFilter(GL::SamplerFilter::Linear)
+                .setMinificationFilter(GL::SamplerFilter::Linear)
+                #ifndef MAGNUM_TARGET_GLES2
+                .setStorage(1, GL::TextureFormat::RGBA8, image.size())
+                #else
+                .setImage(0, GL::TextureFormat::RGBA, image)
+                #endif
+                ;
+        }
+        storage.memory += image.size().product()*4;
+        _frameStatistics.textureUploadSize += image.size().product()*4;
+
+        #ifndef MAGNUM_TARGET_GLES2
+        #ifndef MAGNUM_TARGET_WEBGL
+        if(_flags & Flag::AsyncTextureUploads)
+            uploadTextureAsync(*texture, *tex, {{}, image.size()});
+        else
+        #endif
+        {
+            texture->setSubImage(0, {}, image);
+        }
+        #endif
 
         tex->SetTexID(textureId(*texture));
         tex->BackendUserData=reinterpret_cast<void *>(texture);
@@ -311,30 +919,179 @@ void Context::updateTexture(ImTextureData* tex){
         CORRADE_INTERNAL_ASSERT(tex->Width > 0 && tex->Height > 0 && tex->BytesPerPixel == 4);
         
         GL::Texture2D *texture=reinterpret_cast<GL::Texture2D *>(tex->BackendUserData);
+
+        /* Merge overlapping and adjacent rectangles to reduce the upload
+           count */
+        Containers::Array<Range2Di> rects;
+        arrayReserve(rects, tex->Updates.Size);
+        for(const ImTextureRect& r: tex->Updates)
+            arrayAppend(rects, Range2Di::fromSize({r.x, r.y}, {r.w, r.h}));
+        mergeUpdateRects(rects);
+        for(const Range2Di& r: rects)
+            _frameStatistics.textureUploadSize += r.size().product()*tex->BytesPerPixel;
+
+        #ifndef MAGNUM_TARGET_GLES2
+        /* Upload directly from the atlas memory, with the row length and skip
+           selecting the rectangle */
+        const Containers::ArrayView<const void> pixels{tex->GetPixels(), std::size_t(tex->Width*tex->Height*tex->BytesPerPixel)};
+        for(const Range2Di& r: rects) {
+            #ifndef MAGNUM_TARGET_WEBGL
+            if(_flags & Flag::AsyncTextureUploads) {
+                uploadTextureAsync(*texture, *tex, r);
+                continue;
+            }
+            #endif
+
+            ImageView2D image{PixelStorage{}
+                .setRowLength(tex->Width)
+                .setSkip({r.min(), 0}),
+                PixelFormat::RGBA8Unorm, r.size(), pixels};
+            texture->setSubImage(0, r.min(), image);
+        }
+        #else
+        /* ES2 has no way to specify the row length without
+           EXT_unpack_subimage, copy the rectangles to a temporary memory
+           instead */
         std::vector<char> tmp;
-        for (ImTextureRect& r : tex->Updates)
+        for(const Range2Di& r: rects)
         {
-            tmp.resize(r.w*r.h*tex->BytesPerPixel);
+            tmp.resize(r.size().product()*tex->BytesPerPixel);
             char* out_p = tmp.data();
-            const int src_pitch = r.w * tex->BytesPerPixel;
-            for (int y = 0; y < r.h; y++, out_p += src_pitch)
-                memcpy(out_p, tex->GetPixelsAt(r.x, r.y + y), src_pitch);
-            
-            ImageView2D image(PixelFormat::RGBA8Unorm, {r.w, r.h}, 
-            {tmp.data(), std::size_t(r.w*r.h*tex->BytesPerPixel)});
-            texture->setSubImage(0, {r.x, r.y}, image);
+            const int src_pitch = r.sizeX() * tex->BytesPerPixel;
+            for (int y = 0; y < r.sizeY(); y++, out_p += src_pitch)
+                memcpy(out_p, tex->GetPixelsAt(r.min().x(), r.min().y() + y), src_pitch);
+
+            ImageView2D image(PixelFormat::RGBA8Unorm, r.size(),
+            {tmp.data(), tmp.size()});
+            texture->setSubImage(0, r.min(), image);
         }
+        #endif
         tex->SetStatus(ImTextureStatus_OK);
     }
     else if (tex->Status == ImTextureStatus_WantDestroy && tex->UnusedFrames > 0){
-        delete reinterpret_cast<GL::Texture2D *>(tex->BackendUserData);
+        /* Put the texture into the pool instead of deleting, evicting the
+           least recently released ones if over capacity */
+        Implementation::ImGuiTextureStorage& storage = textureStorage();
+        auto found = storage.textures.begin();
+        while(found != storage.textures.end() && &found->texture != tex->BackendUserData) ++found;
+        CORRADE_INTERNAL_ASSERT(found != storage.textures.end());
+        storage.memory -= found->size.product()*4;
+        storage.poolMemory += found->size.product()*4;
+        storage.pool.splice(storage.pool.end(), storage.textures, found);
+        trimTexturePool(storage);
         tex->BackendUserData=nullptr;
         tex->SetTexID(ImTextureID_Invalid);
         tex->SetStatus(ImTextureStatus_Destroyed);
     }
 }
 
+Implementation::ImGuiTextureStorage& Context::textureStorage() {
+    return _sharedResources ? _sharedResources->_textureStorage : _textureStorage;
+}
+
+const Implementation::ImGuiTextureStorage& Context::textureStorage() const {
+    return _sharedResources ? _sharedResources->_textureStorage : _textureStorage;
+}
+
+std::size_t Context::textureMemory() const {
+    const Implementation::ImGuiTextureStorage& storage = textureStorage();
+    return storage.memory + storage.poolMemory;
+}
+
+std::size_t Context::texturePoolMemory() const {
+    return textureStorage().poolMemory;
+}
+
+std::size_t Context::texturePoolCapacity() const {
+    return textureStorage().poolCapacity;
+}
+
+Context& Context::setTexturePoolCapacity(const std::size_t capacity) {
+    Implementation::ImGuiTextureStorage& storage = textureStorage();
+    storage.poolCapacity = capacity;
+    trimTexturePool(storage);
+    return *this;
+}
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+struct Context::TextureUpload {
+    explicit TextureUpload(): buffer{GL::Buffer::TargetHint::PixelUnpack}, capacity{}, fence{} {}
+
+    GL::Buffer buffer;
+    /* Size of the buffer storage, grown only when an upload doesn't fit */
+    std::size_t capacity;
+    /* GLsync, null if the GPU is done with the buffer and it can be reused */
+    void* fence;
+};
+
+void Context::uploadTextureAsync(GL::Texture2D& texture, ImTextureData& tex, const Range2Di& rect) {
+    /* Reuse a staging buffer the GPU is done with, or create a new one */
+    TextureUpload* upload = nullptr;
+    for(TextureUpload& i: _textureUploads) if(!i.fence) {
+        upload = &i;
+        break;
+    }
+    if(!upload) upload = &arrayAppend(_textureUploads, InPlaceInit);
+
+    /* Reallocate the staging memory only if it's too small, otherwise just
+       overwrite the part that's needed. The copy goes directly into the
+       mapped range. */
+    const std::size_t rowSize = rect.sizeX()*tex.BytesPerPixel;
+    const std::size_t dataSize = rowSize*rect.sizeY();
+    if(upload->capacity < dataSize) {
+        upload->buffer.setData({nullptr, dataSize}, GL::BufferUsage::StreamDraw);
+        upload->capacity = dataSize;
+    }
+    Containers::ArrayView<char> data = upload->buffer.map(0, dataSize,
+        GL::Buffer::MapFlag::Write|GL::Buffer::MapFlag::InvalidateRange);
+    CORRADE_INTERNAL_ASSERT(data);
+    for(Int y = 0; y != rect.sizeY(); ++y)
+        std::memcpy(data.data() + y*rowSize, tex.GetPixelsAt(rect.min().x(), rect.min().y() + y), rowSize);
+    CORRADE_INTERNAL_ASSERT_OUTPUT(upload->buffer.unmap());
+
+    /* The transfer is ordered before any following draw by GL itself, so the
+       texture can be used right away. The fence only guards reuse of the
+       staging buffer. The image borrows the buffer just for the transfer. */
+    GL::BufferImage2D image{GL::PixelFormat::RGBA, GL::PixelType::UnsignedByte,
+        rect.size(), std::move(upload->buffer), dataSize};
+    texture.setSubImage(0, rect.min(), image);
+    upload->buffer = image.release();
+    upload->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+#endif
+
+std::size_t Context::pendingTextureUploadCount() const {
+    std::size_t count = 0;
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    for(const TextureUpload& upload: _textureUploads)
+        if(upload.fence) ++count;
+    #endif
+    return count;
+}
+
 void Context::drawFrame() {
+    MAGNUM_INTEGRATION_CPU_ZONE("ImGuiIntegration::Context::drawFrame()");
+
+    /* With Flag::GpuTimeQuery, drawFrameInternal() runs its own time elapsed
+       query. Those can't be nested, so the GPU zone is omitted in that case
+       to not break GL::TimeQuery-based collectors. */
+    #ifndef MAGNUM_TARGET_WEBGL
+    if(_flags & Flag::GpuTimeQuery) return drawFrameInternal();
+    #endif
+
+    MAGNUM_INTEGRATION_GPU_ZONE("ImGuiIntegration::Context::drawFrame()");
+    drawFrameInternal();
+}
+
+void Context::drawFrameInternal() {
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    #ifndef MAGNUM_TARGET_WEBGL
+    /* Keep the GPU time from the previous frame unless a newer one arrives */
+    _frameStatistics = FrameStatistics{0, 0, 0, 0, 0, 0, 0, _frameStatistics.gpuTime};
+    #else
+    _frameStatistics = {};
+    #endif
+
     /* Ensure we use the context we're linked to */
     ImGui::SetCurrentContext(_context);
     ImGui::Render();
@@ -345,6 +1102,46 @@ void Context::drawFrame() {
 
     ImDrawData* drawData = ImGui::GetDrawData();
     CORRADE_INTERNAL_ASSERT(drawData); /* This is always valid after Render() */
+
+    #ifndef MAGNUM_TARGET_WEBGL
+    /* Collect results of GPU time queries from previous frames and start a
+       new one, if there's a free slot. The results are available with a
+       delay of a few frames, so the queries are used round-robin. */
+    GL::TimeQuery* timeQuery = nullptr;
+    if(_flags & Flag::GpuTimeQuery) {
+        for(std::size_t i = 0; i != Containers::arraySize(_timeQueries); ++i) {
+            if(!(_timeQueriesPending & (1 << i)) || !_timeQueries[i].resultAvailable())
+                continue;
+            _frameStatistics.gpuTime = _timeQueries[i].result<UnsignedLong>();
+            _timeQueriesPending &= ~(1 << i);
+        }
+
+        if(!(_timeQueriesPending & (1 << _timeQueryIndex))) {
+            if(!_timeQueries[_timeQueryIndex].id())
+                _timeQueries[_timeQueryIndex] = GL::TimeQuery{GL::TimeQuery::Target::TimeElapsed};
+            timeQuery = &_timeQueries[_timeQueryIndex];
+            timeQuery->begin();
+        }
+    }
+    #endif
+
+    _frameStatistics.drawListCount = drawData->CmdListsCount;
+    _frameStatistics.vertexCount = drawData->TotalVtxCount;
+    _frameStatistics.indexCount = drawData->TotalIdxCount;
+    for(std::int_fast32_t n = 0; n < drawData->CmdListsCount; ++n)
+        _frameStatistics.commandCount += drawData->CmdLists[n]->CmdBuffer.Size;
+
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    /* Make staging buffers of finished texture uploads available again */
+    for(TextureUpload& upload: _textureUploads) if(upload.fence) {
+        const GLenum result = glClientWaitSync(static_cast<GLsync>(upload.fence), 0, 0);
+        if(result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED) {
+            glDeleteSync(static_cast<GLsync>(upload.fence));
+            upload.fence = nullptr;
+        }
+    }
+    #endif
+
     if (drawData->Textures != nullptr)
         for (ImTextureData* tex : *drawData->Textures)
             if (tex->Status != ImTextureStatus_OK)
@@ -356,65 +1153,496 @@ void Context::drawFrame() {
         Matrix3::translation({-1.0f, 1.0f})*
         Matrix3::scaling({2.0f/Vector2(io.DisplaySize)})*
         Matrix3::scaling({1.0f, -1.0f});
-    _shader.setTransformationProjectionMatrix(projection);
+    if(_shaderCompileState) {
+        _shader = Shaders::FlatGL2D{Utility::move(*_shaderCompileState)};
+        _shaderCompileState = Containers::NullOpt;
+    }
+    Shaders::FlatGL2D& shader = _sharedResources ? _sharedResources->shader() : _shader;
+    shader.setTransformationProjectionMatrix(projection);
+
+    /* If base vertex is supported, pack all draw lists into a single vertex
+       and index buffer and upload them at once, instead of respecifying the
+       buffers for every draw list. Indices in ImGui are relative to the list
+       they belong to, so the per-list vertex offset is then added to the base
+       vertex of each command. Without base vertex support the buffers have to
+       be uploaded per-list. */
+    const bool combined = io.BackendFlags & ImGuiBackendFlags_RendererHasVtxOffset;
+
+    /* Known only if the retained mode compares the data with the previous
+       frame, used by needsRedraw() */
+    bool geometryChanged = false;
+
+    /* Offset of the current draw list in the combined buffers, in vertices
+       and indices. Stays at zero if the lists are uploaded one by one. */
+    UnsignedInt listVertexOffset = 0, listIndexOffset = 0;
+
+    #ifndef MAGNUM_TARGET_GLES
+    /* With persistently mapped buffers, the data are copied directly into the
+       mapped memory of a segment that's not used by the GPU anymore. The
+       segment offset is then handled the same way as the list offsets. */
+    const bool ring = combined && (_flags & Flag::PersistentMappedBuffers) &&
+        GL::Context::current().isExtensionSupported<GL::Extensions::ARB::buffer_storage>();
+    if(ring) {
+        /* (Re)allocate the buffers if the segments are too small, with some
+           headroom to avoid doing that again next frame */
+        if(UnsignedInt(drawData->TotalVtxCount) > _ringVertexCapacity || UnsignedInt(drawData->TotalIdxCount) > _ringIndexCapacity) {
+            const UnsignedInt vertexCapacity = Math::max(UnsignedInt(drawData->TotalVtxCount)*3/2, Math::max(_ringVertexCapacity, 4096u));
+            const UnsignedInt indexCapacity = Math::max(UnsignedInt(drawData->TotalIdxCount)*3/2, Math::max(_ringIndexCapacity, 8192u));
+            if(_ringVertexCapacity) destroyRingBuffers();
+
+            const std::size_t vertexSize = RingSegmentCount*vertexCapacity*sizeof(ImDrawVert);
+            const std::size_t indexSize = RingSegmentCount*indexCapacity*sizeof(ImDrawIdx);
+            _vertexBuffer.setStorage({nullptr, vertexSize},
+                GL::Buffer::StorageFlag::MapWrite|
+                GL::Buffer::StorageFlag::MapPersistent|
+                GL::Buffer::StorageFlag::MapCoherent);
+            _indexBuffer.setStorage({nullptr, indexSize},
+                GL::Buffer::StorageFlag::MapWrite|
+                GL::Buffer::StorageFlag::MapPersistent|
+                GL::Buffer::StorageFlag::MapCoherent);
+            const GL::Buffer::MapFlags mapFlags =
+                GL::Buffer::MapFlag::Write|
+                GL::Buffer::MapFlag::Persistent|
+                GL::Buffer::MapFlag::Coherent;
+            _ringVertexData = _vertexBuffer.map(0, vertexSize, mapFlags);
+            _ringIndexData = _indexBuffer.map(0, indexSize, mapFlags);
+            CORRADE_INTERNAL_ASSERT(_ringVertexData && _ringIndexData);
+            _ringVertexCapacity = vertexCapacity;
+            _ringIndexCapacity = indexCapacity;
+        }
+
+        /* Wait until the GPU is done with the segment. With three segments
+           this should rarely ever block. */
+        if(void*& fence = _ringFences[_ringSegment]) {
+            GLenum result;
+            do result = glClientWaitSync(static_cast<GLsync>(fence), GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+            while(result == GL_TIMEOUT_EXPIRED);
+            glDeleteSync(static_cast<GLsync>(fence));
+            fence = nullptr;
+        }
+
+        listVertexOffset = _ringSegment*_ringVertexCapacity;
+        listIndexOffset = _ringSegment*_ringIndexCapacity;
+        std::size_t vertexOffset = listVertexOffset*sizeof(ImDrawVert),
+            indexOffset = listIndexOffset*sizeof(ImDrawIdx);
+        for(std::int_fast32_t n = 0; n < drawData->CmdListsCount; ++n) {
+            const ImDrawList* cmdList = drawData->CmdLists[n];
+            const std::size_t vertexSize = std::size_t(cmdList->VtxBuffer.Size)*sizeof(ImDrawVert);
+            const std::size_t indexSize = std::size_t(cmdList->IdxBuffer.Size)*sizeof(ImDrawIdx);
+            if(vertexSize) Utility::copy(
+                Containers::arrayView(reinterpret_cast<const char*>(cmdList->VtxBuffer.Data), vertexSize),
+                _ringVertexData.sliceSize(vertexOffset, vertexSize));
+            if(indexSize) Utility::copy(
+                Containers::arrayView(reinterpret_cast<const char*>(cmdList->IdxBuffer.Data), indexSize),
+                _ringIndexData.sliceSize(indexOffset, indexSize));
+            vertexOffset += vertexSize;
+            indexOffset += indexSize;
+        }
+    } else
+    #endif
+    if(combined) {
+        const std::size_t vertexDataSize = std::size_t(drawData->TotalVtxCount)*sizeof(ImDrawVert);
+        const std::size_t indexDataSize = std::size_t(drawData->TotalIdxCount)*sizeof(ImDrawIdx);
+        /* Keep the allocations across frames, grow only if needed */
+        if(_vertexData.size() < vertexDataSize)
+            arrayResize(_vertexData, NoInit, vertexDataSize);
+        if(_indexData.size() < indexDataSize)
+            arrayResize(_indexData, NoInit, indexDataSize);
+
+        /* In the retained mode, the data are compared against what was
+           uploaded last time first. Lists are copied to the staging memory
+           only starting from the first difference, and if there's none, the
+           upload is skipped altogether. */
+        bool same = (_flags & Flag::RetainedBuffers) &&
+            vertexDataSize == _uploadedVertexDataSize &&
+            indexDataSize == _uploadedIndexDataSize;
+        std::size_t vertexOffset = 0, indexOffset = 0;
+        for(std::int_fast32_t n = 0; n < drawData->CmdListsCount; ++n) {
+            const ImDrawList* cmdList = drawData->CmdLists[n];
+            const std::size_t vertexSize = std::size_t(cmdList->VtxBuffer.Size)*sizeof(ImDrawVert);
+            const std::size_t indexSize = std::size_t(cmdList->IdxBuffer.Size)*sizeof(ImDrawIdx);
+            if(!same ||
+               (vertexSize && std::memcmp(cmdList->VtxBuffer.Data, _vertexData + vertexOffset, vertexSize) != 0) ||
+               (indexSize && std::memcmp(cmdList->IdxBuffer.Data, _indexData + indexOffset, indexSize) != 0))
+            {
+                same = false;
+                if(vertexSize) Utility::copy(
+                    Containers::arrayView(reinterpret_cast<const char*>(cmdList->VtxBuffer.Data), vertexSize),
+                    _vertexData.sliceSize(vertexOffset, vertexSize));
+                if(indexSize) Utility::copy(
+                    Containers::arrayView(reinterpret_cast<const char*>(cmdList->IdxBuffer.Data), indexSize),
+                    _indexData.sliceSize(indexOffset, indexSize));
+            }
+            vertexOffset += vertexSize;
+            indexOffset += indexSize;
+        }
+
+        if(_flags & Flag::RetainedBuffers) geometryChanged = !same;
+
+        if(!same) {
+            _vertexBuffer.setData(_vertexData.prefix(vertexDataSize),
+                GL::BufferUsage::StreamDraw);
+            _indexBuffer.setData(_indexData.prefix(indexDataSize),
+                GL::BufferUsage::StreamDraw);
+            _uploadedVertexDataSize = vertexDataSize;
+            _uploadedIndexDataSize = indexDataSize;
+        } else {
+            _frameStatistics.vertexCount = _frameStatistics.indexCount = 0;
+        }
+    }
+
+    /* The persistently mapped or per-list buffers don't contain anything
+       the retained mode could reuse */
+    if(!combined
+        #ifndef MAGNUM_TARGET_GLES
+        || ring
+        #endif
+    )
+        _uploadedVertexDataSize = _uploadedIndexDataSize = ~std::size_t{};
+
+    #ifndef MAGNUM_TARGET_GLES2
+    /* With clipping in the shader, the clip rectangle of each command is
+       written to all vertices it references. The scissor then stays at the
+       full framebuffer and consecutive commands can be drawn together
+       regardless of their clip rectangles. ImGui doesn't share vertices among
+       commands, so there are no conflicts. */
+    const bool clipInShader = combined && (_flags & Flag::ShaderClipping) &&
+        #ifndef MAGNUM_TARGET_GLES
+        !ring &&
+        #endif
+        prepareClipShader();
+    if(clipInShader) {
+        if(_clipData.size() < std::size_t(drawData->TotalVtxCount))
+            arrayResize(_clipData, NoInit, drawData->TotalVtxCount);
+
+        UnsignedInt vertexOffset = 0;
+        for(std::int_fast32_t n = 0; n < drawData->CmdListsCount; ++n) {
+            const ImDrawList* cmdList = drawData->CmdLists[n];
+            for(const ImDrawCmd& cmd: cmdList->CmdBuffer) {
+                if(cmd.UserCallback) continue;
+
+                const Range2Di clip = clipRectangle(cmd, fbSize, _supersamplingRatio);
+                const Vector4us packed{
+                    Vector2us{Math::clamp(clip.min(), Vector2i{0}, Vector2i{65535})},
+                    Vector2us{Math::clamp(clip.max(), Vector2i{0}, Vector2i{65535})}};
+                const ImDrawIdx* indices = cmdList->IdxBuffer.Data + cmd.IdxOffset;
+                Vector4us* vertices = _clipData + vertexOffset + cmd.VtxOffset;
+                for(UnsignedInt i = 0; i != cmd.ElemCount; ++i)
+                    vertices[indices[i]] = packed;
+            }
+            vertexOffset += cmdList->VtxBuffer.Size;
+        }
+
+        _clipBuffer.setData(_clipData.prefix(drawData->TotalVtxCount),
+            GL::BufferUsage::StreamDraw);
+        _clipShader->setTransformationProjectionMatrix(projection);
+        GL::Renderer::setScissor(Range2Di{Range2D{{}, fbSize}.scaled(_supersamplingRatio)});
+    }
+    /* Switched to the texture array variants for array layers registered
+       with registerTexture() */
+    GL::AbstractShaderProgram* program = clipInShader ?
+        static_cast<GL::AbstractShaderProgram*>(_clipShader.get()) : &shader;
+    GL::Mesh& mesh = clipInShader ? _clipMesh : _mesh;
+    bool arrayShaderPrepared = false;
+    /* Distance field fonts need flat interpolation as well */
+    const bool distanceField = (_flags & Flag::DistanceFieldFonts)
+        #ifndef MAGNUM_TARGET_GLES
+        && GL::Context::current().isVersionSupported(GL::Version::GL300)
+        #endif
+        ;
+    bool distanceFieldShaderPrepared = false;
+    UnsignedInt lastSampler = 0;
+    #else
+    constexpr bool clipInShader = false;
+    GL::AbstractShaderProgram* program = &shader;
+    GL::Mesh& mesh = _mesh;
+    #endif
+
+    /* State set by the previous draw command, to avoid redundant state
+       changes. Commands are not reordered, as that would change the order in
+       which they're composited. */
+    bool hasState = false;
+    Range2Di lastScissor;
+    std::size_t lastIndexOffset{};
+    /* Index buffer offset is tracked separately, as it's a state of the mesh
+       that user callbacks can't affect */
+    bool lastIndexOffsetValid = false;
+    GLuint lastTextureId{};
+    _stateChangeStatistics = {};
+
+    /* In the multi-draw mode, consecutive commands sharing the same scissor
+       rectangle and texture are collected into mesh views and submitted
+       together once the state changes. The views are then addressing the
+       whole index buffer. Commands that continue right where the previous
+       one ended are merged into a single view. The same is done when
+       clipping in the shader, where the scissor doesn't change. */
+    const bool batch = (_flags & Flag::MultiDraw) || clipInShader;
+    const GL::MeshIndexType indexType = sizeof(ImDrawIdx) == 2 ?
+        GL::MeshIndexType::UnsignedShort : GL::MeshIndexType::UnsignedInt;
+    if(batch) {
+        mesh.setIndexBuffer(_indexBuffer, 0, indexType);
+        lastIndexOffset = 0;
+        lastIndexOffsetValid = true;
+    }
+    UnsignedInt lastViewBaseVertex{}, lastViewIndexEnd{};
+    const auto flushDrawViews = [this, &program]() {
+        if(_drawViews.isEmpty()) return;
+        if(_drawViews.size() == 1)
+            program->draw(_drawViews[0]);
+        else
+            program->draw(Containers::Iterable<GL::MeshView>{_drawViews});
+        ++_frameStatistics.drawCallCount;
+        arrayRemoveSuffix(_drawViews, _drawViews.size());
+    };
 
     for(std::int_fast32_t n = 0; n < drawData->CmdListsCount; ++n) {
         const ImDrawList* cmdList = drawData->CmdLists[n];
 
-        _vertexBuffer.setData(
-            {cmdList->VtxBuffer.Data, std::size_t(cmdList->VtxBuffer.Size)},
-            GL::BufferUsage::StreamDraw);
-        _indexBuffer.setData(
-            {cmdList->IdxBuffer.Data, std::size_t(cmdList->IdxBuffer.Size)},
-            GL::BufferUsage::StreamDraw);
+        if(!combined) {
+            _vertexBuffer.setData(
+                {cmdList->VtxBuffer.Data, std::size_t(cmdList->VtxBuffer.Size)},
+                GL::BufferUsage::StreamDraw);
+            _indexBuffer.setData(
+                {cmdList->IdxBuffer.Data, std::size_t(cmdList->IdxBuffer.Size)},
+                GL::BufferUsage::StreamDraw);
+        }
 
         for(std::int_fast32_t c = 0; c < cmdList->CmdBuffer.Size; ++c) {
             const ImDrawCmd* pcmd = &cmdList->CmdBuffer[c];
 
             if(pcmd->UserCallback) {
+                /* Everything collected so far has to be drawn before the
+                   callback gets executed */
+                flushDrawViews();
+
                 /* User callback, registered via ImDrawList::AddCallback().
                    ImDrawCallback_ResetRenderState is a special callback value
                    used by the user to request the renderer to reset render
                    state. We do not have anything to do here though. */
                 if(pcmd->UserCallback != ImDrawCallback_ResetRenderState)
                     pcmd->UserCallback(cmdList, pcmd);
+                /* The callback could have changed the scissor or texture
+                   bindings behind our back, forget what was set */
+                hasState = false;
+                if(clipInShader)
+                    GL::Renderer::setScissor(Range2Di{Range2D{{}, fbSize}.scaled(_supersamplingRatio)});
                 continue;
             }
 
-            GL::Renderer::setScissor(Range2Di{Range2D{
-                {pcmd->ClipRect.x, fbSize.y() - pcmd->ClipRect.w},
-                {pcmd->ClipRect.z, fbSize.y() - pcmd->ClipRect.y}}
-                    .scaled(_supersamplingRatio)});
-
-            /* Only > 0 if ImGuiBackendFlags_RendererHasVtxOffset is set */
-            _mesh.setBaseVertex(pcmd->VtxOffset);
-            _mesh.setCount(pcmd->ElemCount);
-            _mesh.setIndexBuffer(_indexBuffer, pcmd->IdxOffset*sizeof(ImDrawIdx),
-                sizeof(ImDrawIdx) == 2
-                ? GL::MeshIndexType::UnsignedShort
-                : GL::MeshIndexType::UnsignedInt);
-
-            /* We're storing just texture IDs, so make a non-owning instance
-               around it, and assume it's already created */
-            GL::Texture2D texture = GL::Texture2D::wrap(
+            const Range2Di scissor = clipRectangle(*pcmd, fbSize, _supersamplingRatio);
+            /* We're storing just texture IDs */
+            const GLuint textureId =
                 #if IMGUI_VERSION_NUM >= 19131
-                pcmd->GetTexID(),
+                pcmd->GetTexID();
                 #else
-                reinterpret_cast<std::uintptr_t>(pcmd->GetTexID()),
+                reinterpret_cast<std::uintptr_t>(pcmd->GetTexID());
+                #endif
+
+            /* If the state differs, submit the views collected so far
+               before the state gets changed */
+            const bool scissorChanged = !clipInShader && (!hasState || scissor != lastScissor);
+            const bool textureChanged = !hasState || textureId != lastTextureId;
+            if(batch && (scissorChanged || textureChanged))
+                flushDrawViews();
+
+            if(scissorChanged) {
+                GL::Renderer::setScissor(scissor);
+                lastScissor = scissor;
+                ++_stateChangeStatistics.issued;
+            } else ++_stateChangeStatistics.skipped;
+
+            if(textureChanged) {
+                #ifndef MAGNUM_TARGET_GLES2
+                /* Registered textures have the layer and sampler looked up
+                   in the registry, everything else is a plain 2D texture */
+                const Implementation::RegisteredTextureData* registered = nullptr;
+                if(textureId & RegisteredTextureBit) {
+                    const UnsignedInt index = textureId & ~RegisteredTextureBit;
+                    CORRADE_ASSERT(index < _registeredTextures.size() && _registeredTextures[index].texture,
+                        "ImGuiIntegration::Context::drawFrame(): texture" << Debug::hex << textureId << "is not registered", );
+                    registered = &_registeredTextures[index];
+                }
+
+                if(registered && registered->layer != -1) {
+                    if(!arrayShaderPrepared) {
+                        prepareArrayShader(clipInShader, projection);
+                        arrayShaderPrepared = true;
+                    }
+
+                    GL::Texture2DArray texture = GL::Texture2DArray::wrap(registered->texture, GL::ObjectFlag::Created);
+                    if(clipInShader) {
+                        _clipArrayShader->bindTexture(texture)
+                            .setTextureLayer(registered->layer);
+                        program = _clipArrayShader.get();
+                    } else {
+                        _arrayShader.bindTexture(texture)
+                            .setTextureLayer(registered->layer);
+                        program = &_arrayShader;
+                    }
+                } else
+                #endif
+                {
+                    /* Make a non-owning instance around the ID, and assume
+                       it's already created */
+                    GL::Texture2D texture = GL::Texture2D::wrap(
+                        #ifndef MAGNUM_TARGET_GLES2
+                        registered ? registered->texture :
+                        #endif
+                        textureId, GL::ObjectFlag::Created);
+                    #ifndef MAGNUM_TARGET_GLES2
+                    /* Only the font atlas is a distance field, user
+                       textures are drawn as usual */
+                    if(distanceField && !registered && isFontTexture(textureId)) {
+                        if(!distanceFieldShaderPrepared) {
+                            prepareDistanceFieldShader(clipInShader, projection);
+                            distanceFieldShaderPrepared = true;
+                        }
+
+                        Implementation::DistanceFieldShaderGL& distanceFieldShader = clipInShader ? *_clipDistanceFieldShader : *_distanceFieldShader;
+                        distanceFieldShader.bindTexture(texture);
+                        program = &distanceFieldShader;
+                    } else if(clipInShader) {
+                        _clipShader->bindTexture(texture);
+                        program = _clipShader.get();
+                    } else
+                    #endif
+                    {
+                        shader.bindTexture(texture);
+                        program = &shader;
+                    }
+                }
+
+                #ifndef MAGNUM_TARGET_GLES2
+                /* The sampler overrides sampling state of whatever texture
+                   is bound to the same unit, so it has to be unbound again
+                   for textures that don't have it */
+                const UnsignedInt sampler = registered ? registered->sampler : 0;
+                if(sampler != lastSampler) {
+                    glBindSampler(0, sampler);
+                    lastSampler = sampler;
+                }
                 #endif
-                GL::ObjectFlag::Created);
 
-            _shader
-                .bindTexture(texture)
-                .draw(_mesh);
+                lastTextureId = textureId;
+                ++_stateChangeStatistics.issued;
+            } else ++_stateChangeStatistics.skipped;
+
+            hasState = true;
+
+            /* Base vertex is only > 0 if
+               ImGuiBackendFlags_RendererHasVtxOffset is set */
+            if(batch) {
+                const UnsignedInt baseVertex = listVertexOffset + pcmd->VtxOffset;
+                const UnsignedInt indexOffset = listIndexOffset + pcmd->IdxOffset;
+                if(!_drawViews.isEmpty() && lastViewBaseVertex == baseVertex && lastViewIndexEnd == indexOffset) {
+                    GL::MeshView& view = _drawViews.back();
+                    view.setCount(view.count() + pcmd->ElemCount);
+                } else {
+                    arrayAppend(_drawViews, InPlaceInit, mesh)
+                        .setCount(pcmd->ElemCount)
+                        .setBaseVertex(baseVertex)
+                        .setIndexOffset(indexOffset);
+                    lastViewBaseVertex = baseVertex;
+                }
+                lastViewIndexEnd = indexOffset + pcmd->ElemCount;
+                continue;
+            }
+
+            mesh.setBaseVertex(listVertexOffset + pcmd->VtxOffset);
+            mesh.setCount(pcmd->ElemCount);
+            const std::size_t indexOffset = (listIndexOffset + pcmd->IdxOffset)*sizeof(ImDrawIdx);
+            if(!lastIndexOffsetValid || indexOffset != lastIndexOffset) {
+                mesh.setIndexBuffer(_indexBuffer, indexOffset, indexType);
+                lastIndexOffset = indexOffset;
+                lastIndexOffsetValid = true;
+                ++_stateChangeStatistics.issued;
+            } else ++_stateChangeStatistics.skipped;
+
+            program->draw(mesh);
+            ++_frameStatistics.drawCallCount;
+        }
+
+        /* If each list is uploaded separately, the views have to be
+           submitted before the buffers get overwritten by the next list */
+        if(!combined) flushDrawViews();
+
+        if(combined) {
+            listVertexOffset += cmdList->VtxBuffer.Size;
+            listIndexOffset += cmdList->IdxBuffer.Size;
         }
     }
 
+    flushDrawViews();
+
+    #ifndef MAGNUM_TARGET_GLES2
+    /* Don't leave a custom sampler bound for code drawing after */
+    if(lastSampler) glBindSampler(0, 0);
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    /* Mark the segment as used by the GPU until all commands submitted so far
+       finish, continue with the next one in the next frame */
+    if(ring) {
+        _ringFences[_ringSegment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        _ringSegment = (_ringSegment + 1) % RingSegmentCount;
+    }
+    #endif
+
     /* Reset scissor rectangle back to the full framebuffer size. Instead the
        users would be required to disable the scissor right after as otherwise
        the framebuffer clear would only happen on whatever the last scissor
        was. (And I hope the floating-point precision is enough here.) */
     GL::Renderer::setScissor(Range2Di{Range2D{{}, fbSize}.scaled(_supersamplingRatio)});
+
+    #ifndef MAGNUM_TARGET_WEBGL
+    if(timeQuery) {
+        timeQuery->end();
+        _timeQueriesPending |= 1 << _timeQueryIndex;
+        _timeQueryIndex = (_timeQueryIndex + 1) % Containers::arraySize(_timeQueries);
+    }
+    #endif
+
+    /* Decide whether the next frame is needed even without new input. If
+       ImGui has an active item or a focused text input, there may be
+       animations or a blinking cursor. */
+    if(_redrawFrames) --_redrawFrames;
+    _animating = geometryChanged || _frameStatistics.textureUploadSize ||
+        io.WantTextInput || ImGui::IsAnyItemActive() || ImGui::IsAnyMouseDown();
+
+    _frameStatistics.cpuTime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+Debug& operator<<(Debug& debug, const Context::Flag value) {
+    debug << "ImGuiIntegration::Context::Flag" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case Context::Flag::value: return debug << "::" #value;
+        _c(PersistentMappedBuffers)
+        _c(MultiDraw)
+        _c(AsyncTextureUploads)
+        _c(GpuTimeQuery)
+        _c(RetainedBuffers)
+        _c(CoalescePointerMoveEvents)
+        _c(ShaderClipping)
+        _c(DistanceFieldFonts)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "(" << Debug::nospace << Debug::hex << UnsignedInt(value) << Debug::nospace << ")";
+}
+
+Debug& operator<<(Debug& debug, const Context::Flags value) {
+    return Containers::enumSetDebugOutput(debug, value, "ImGuiIntegration::Context::Flags{}", {
+        Context::Flag::PersistentMappedBuffers,
+        Context::Flag::MultiDraw,
+        Context::Flag::AsyncTextureUploads,
+        Context::Flag::GpuTimeQuery,
+        Context::Flag::RetainedBuffers,
+        Context::Flag::CoalescePointerMoveEvents,
+        Context::Flag::ShaderClipping,
+        Context::Flag::DistanceFieldFonts});
 }
 
 }}
@@ -35,12 +35,18 @@
  * @brief Class @ref Magnum::ImGuiIntegration::Context
  */
 
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/EnumSet.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pointer.h>
 #include <Corrade/Containers/String.h>
 #include <Magnum/Timeline.h>
 #include <Magnum/GL/AbstractShaderProgram.h>
 #include <Magnum/GL/Texture.h>
 #include <Magnum/GL/Buffer.h>
 #include <Magnum/GL/Mesh.h>
+#include <Magnum/GL/MeshView.h>
+#include <Magnum/GL/TimeQuery.h>
 #include <Magnum/Shaders/FlatGL.h>
 
 #include "Magnum/ImGuiIntegration/visibility.h"
@@ -54,10 +60,54 @@ struct ImTextureData;
 
 namespace Magnum { namespace ImGuiIntegration {
 
+class SharedResources;
+
 namespace Implementation {
     template<class Application, class = void> struct ApplicationClipboard;
+    #ifndef MAGNUM_TARGET_GLES2
+    class ClipShaderGL;
+    class DistanceFieldShaderGL;
+    #endif
+
+    /* ImGui-managed textures, in a list for stable addresses. Released
+       textures get moved into the pool, least recently released first, to be
+       reused by new textures of the same size. Owned either by a Context or,
+       for contexts sharing a font atlas, by SharedResources. */
+    struct ImGuiTextureStorage {
+        struct Texture {
+            GL::Texture2D texture;
+            Vector2i size;
+        };
+
+        std::list<Texture> textures, pool;
+        std::size_t memory{}, poolMemory{}, poolCapacity{16*1024*1024};
+    };
+
+    #ifndef MAGNUM_TARGET_GLES2
+    /* Entry of Context::registerTexture(). The texture ID is zero for free
+       entries, the layer is -1 for 2D textures. */
+    struct RegisteredTextureData {
+        UnsignedInt texture;
+        UnsignedInt sampler;
+        Int layer;
+    };
+    #endif
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+/**
+@brief Texture registered with a context
+@m_since_latest_{integration}
+
+Returned by @ref Context::registerTexture(), convert to an `ImTextureID`
+using @ref textureId(RegisteredTexture) or pass directly to
+@ref image(RegisteredTexture, const Vector2&, const Range2D&, const Color4&, const Color4&)
+and @ref imageButton(const char*, RegisteredTexture, const Vector2&, const Range2D&, const Color4&, const Color4&).
+@requires_gles30 Not available in OpenGL ES 2.0 and WebGL 1.0.
+*/
+enum class RegisteredTexture: UnsignedInt {};
+#endif
+
 /**
 @brief Dear ImGui context
 
@@ -100,7 +150,8 @@ setting cursors.
     * *required* to constantly @ref Platform::Sdl2Application::redraw() "redraw()",
     instead of just waiting on input events. While that's not a problem for
     games, for regular apps that unfortunately means your application will use
-    the CPU even when completely idle.
+    the CPU even when completely idle. To avoid that, redraw only if
+    @ref needsRedraw() returns @cpp true @ce.
 
 <b></b>
 
@@ -296,6 +347,11 @@ change ImGui's index type to 32-bit by adding the following line to the
 This doubles the size of the index buffer, resulting in potentially reduced
 draw performance, but is guaranteed to work on all GL versions.
 
+Base vertex support is also used to upload geometry of all ImGui draw lists
+with a single buffer data call per frame, instead of respecifying the vertex
+and index buffer for every draw list. Without it, the buffers are uploaded
+separately for each draw list.
+
 @section ImGuiIntegration-Context-custom-textures Drawing custom textures
 
 In order to draw a @ref GL::Texture2D instance, use the
@@ -304,6 +360,30 @@ In order to draw a @ref GL::Texture2D instance, use the
 ImGui APIs that accept a `ImTextureID`, use the @ref textureId() helper to
 create an ImGui texture ID from a @ref GL::Texture2D reference.
 
+Such textures are drawn with whatever sampling state is set on them, and
+only 2D textures can be used this way. A layer of a @ref GL::Texture2DArray
+or a texture with a custom sampler object can be registered with
+@ref registerTexture() instead. The registry keeps the layer and sampler
+for each returned @ref RegisteredTexture, so @ref drawFrame() binds them
+directly without changing the state of the texture itself:
+
+@snippet ImGuiIntegration.cpp Context-registerTexture
+
+Texture swizzle and filtering set on the texture itself are persistent
+texture state, so they don't need to be registered. Rectangle, cube map and
+3D textures are not supported.
+
+@section ImGuiIntegration-Context-async-shader Asynchronous shader compilation
+
+The shader used for drawing is compiled using
+@ref Shaders::FlatGL::compile(), and the compilation is finished only in the
+first @ref drawFrame() call. With @gl_extension{KHR,parallel_shader_compile}
+the driver compiles and links the shader on a background thread in the
+meantime, so the work can overlap with loading other assets instead of
+stalling the @ref Context construction. Use @ref isShaderLinkFinished() to
+check whether the first @ref drawFrame() would still need to wait for the
+driver. The same applies to @ref SharedResources.
+
 @section ImGuiIntegration-Context-multiple-contexts Multiple contexts
 
 Each instance of @ref Context creates a new ImGui context. You can also pass an
@@ -320,10 +400,224 @@ It's also possible to create a context-less instance using the
 @ref release(). Such instances, together with moved-out instances are empty and
 calling any API that interacts with ImGui is not allowed on these.
 
+@subsection ImGuiIntegration-Context-shared-resources Sharing resources between contexts
+
+By default, each @ref Context compiles its own shader and uploads its own copy
+of the font atlas. If many contexts are drawn into the same GL context ---
+for example one per render target or one for each in-world panel --- create a
+@ref SharedResources instance and pass it to the
+@ref Context(SharedResources&, const Vector2i&) constructor instead. All such
+contexts then share a single shader and a single font atlas, both in memory and
+on the GPU. Fonts need to be added to @ref SharedResources::atlas() before the
+first context using it draws a frame.
+
+@snippet ImGuiIntegration.cpp Context-shared-resources
+
+The @ref SharedResources instance has to outlive all contexts using it. This is
+also a step towards ImGui's multi-viewport support, where each platform window
+gets its own @ref Context with the resources shared.
+
 @experimental
 */
 class MAGNUM_IMGUIINTEGRATION_EXPORT Context {
     public:
+        /**
+         * @brief Flag
+         * @m_since_latest_{integration}
+         *
+         * @see @ref Flags, @ref setFlags()
+         */
+        enum class Flag: UnsignedInt {
+            /**
+             * Stream vertex and index data through triple-buffered
+             * persistently mapped buffers synchronized with fences, instead
+             * of respecifying the buffers every frame. ImGui geometry is then
+             * copied directly to the mapped memory. Used only if
+             * @ref ImGuiIntegration-Context-large-meshes "base vertex is supported"
+             * and @gl_extension{ARB,buffer_storage} is available, otherwise
+             * the default upload path is used.
+             * @requires_gl44 Extension @gl_extension{ARB,buffer_storage}
+             * @requires_gl Persistently mapped buffers are not available in
+             *      OpenGL ES or WebGL, the flag is ignored there.
+             */
+            PersistentMappedBuffers = 1 << 0,
+
+            /**
+             * Collect consecutive draw commands that share the same texture
+             * and clip rectangle and submit them together using
+             * @ref GL::AbstractShaderProgram::draw(const Containers::Iterable<MeshView>&),
+             * which translates to a single @fn_gl_keyword{MultiDrawElementsBaseVertex}
+             * call where supported and falls back to a sequence of draws
+             * otherwise.
+             */
+            MultiDraw = 1 << 1,
+
+            /**
+             * Upload ImGui-managed textures through pixel buffer objects.
+             * Texture data are copied into a mapped staging buffer and the
+             * transfer to the texture then happens asynchronously, without
+             * stalling the frame. The staging buffers are reused once a
+             * fence signals that the GPU is done with them, see
+             * @ref pendingTextureUploadCount().
+             * @requires_gles30 Pixel buffer objects are not available in
+             *      OpenGL ES 2.0, the flag is ignored there.
+             * @requires_gles Buffer mapping is not available in WebGL, the
+             *      flag is ignored there.
+             */
+            AsyncTextureUploads = 1 << 2,
+
+            /**
+             * Measure GPU time spent in @ref drawFrame() using
+             * @ref GL::TimeQuery and report it in
+             * @ref FrameStatistics::gpuTime. As the query results are
+             * available only with a delay, the reported value is from one of
+             * the previous frames. As time elapsed queries can't be nested,
+             * the @ref MAGNUM_INTEGRATION_GPU_ZONE() around
+             * @ref drawFrame() is omitted when this flag is set.
+             * @requires_gl33 Extension @gl_extension{ARB,timer_query}
+             * @requires_es_extension Extension
+             *      @gl_extension{EXT,disjoint_timer_query}
+             * @requires_gles Time queries are not supported in WebGL by this
+             *      implementation, the flag is ignored there.
+             */
+            GpuTimeQuery = 1 << 3,
+
+            /**
+             * Compare vertex and index data of all draw lists with data
+             * uploaded in the previous frame and skip the upload if nothing
+             * changed, drawing from the already resident GPU buffers. Useful
+             * for UIs that stay static for a long time. Used only if
+             * @ref ImGuiIntegration-Context-large-meshes "base vertex is supported",
+             * and has no effect in combination with
+             * @ref Flag::PersistentMappedBuffers, where the data are written
+             * directly to mapped memory.
+             * @see @ref FrameStatistics::vertexCount,
+             *      @ref FrameStatistics::indexCount
+             */
+            RetainedBuffers = 1 << 4,
+
+            /**
+             * Coalesce consecutive pointer move events that don't change the
+             * set of pressed pointers. Instead of submitting each such event
+             * to ImGui's input queue, @ref handlePointerMoveEvent() only
+             * remembers the latest position, which is then submitted before
+             * any other input event or in @ref newFrame(). Useful for
+             * high-poll-rate mice or after event processing stalls, when
+             * lots of move events arrive between two frames. With this flag,
+             * the return value of @ref handlePointerMoveEvent() for coalesced
+             * events reflects the state from the last @ref newFrame().
+             */
+            CoalescePointerMoveEvents = 1 << 5,
+
+            /**
+             * Clip in the shader instead of changing the scissor rectangle
+             * for every draw command. The clip rectangle of each command is
+             * uploaded as an additional per-vertex attribute and fragments
+             * outside of it are discarded, which means consecutive commands
+             * that use the same texture are drawn together regardless of
+             * their clip rectangles. Combined with @ref Flag::MultiDraw, a
+             * whole frame with just the font atlas can be drawn with a single
+             * draw call. Used only if
+             * @ref ImGuiIntegration-Context-large-meshes "base vertex is supported",
+             * and has no effect in combination with
+             * @ref Flag::PersistentMappedBuffers.
+             * @requires_gl30 GLSL 1.30 for flat interpolation, otherwise the
+             *      flag is ignored.
+             * @requires_gles30 Not supported in OpenGL ES 2.0 or WebGL 1.0,
+             *      the flag is ignored there.
+             */
+            ShaderClipping = 1 << 6,
+
+            /**
+             * Treat the alpha channel of the font atlas textures as a
+             * distance field. Glyphs are then crisp at any scale, which
+             * means a single small bake can be used for all font sizes and
+             * framebuffer-to-window ratios instead of supersampling the font.
+             * Meant to be used with fonts added via
+             * @ref FontLoader::addDistanceFieldFont(). Fonts rasterized the
+             * usual way have a sharper edge with this flag, other textures
+             * are not affected.
+             * @requires_gl30 GLSL 1.30, otherwise the flag is ignored.
+             * @requires_gles30 Not supported in OpenGL ES 2.0 or WebGL 1.0,
+             *      the flag is ignored there.
+             */
+            DistanceFieldFonts = 1 << 7
+        };
+
+        /**
+         * @brief Flags
+         * @m_since_latest_{integration}
+         *
+         * @see @ref setFlags()
+         */
+        typedef Containers::EnumSet<Flag> Flags;
+
+        /**
+         * @brief Frame statistics
+         * @m_since_latest_{integration}
+         *
+         * @see @ref frameStatistics()
+         */
+        struct FrameStatistics {
+            /** Count of draw lists drawn */
+            UnsignedInt drawListCount;
+
+            /** Count of draw commands in all draw lists, including callbacks */
+            UnsignedInt commandCount;
+
+            /**
+             * Count of draw calls issued. With @ref Flag::MultiDraw a single
+             * multi-draw call is counted as one.
+             */
+            UnsignedInt drawCallCount;
+
+            /**
+             * Count of vertices uploaded. @cpp 0 @ce if the upload was
+             * skipped by @ref Flag::RetainedBuffers.
+             */
+            UnsignedInt vertexCount;
+
+            /**
+             * Count of indices uploaded. @cpp 0 @ce if the upload was skipped
+             * by @ref Flag::RetainedBuffers.
+             */
+            UnsignedInt indexCount;
+
+            /** Size of texture data uploaded, in bytes */
+            std::size_t textureUploadSize;
+
+            /** CPU time spent in @ref drawFrame(), in nanoseconds */
+            UnsignedLong cpuTime;
+
+            /**
+             * GPU time spent in @ref drawFrame(), in nanoseconds. Filled only
+             * if @ref Flag::GpuTimeQuery is enabled, with a delay of a few
+             * frames. @cpp 0 @ce otherwise.
+             */
+            UnsignedLong gpuTime;
+        };
+
+        /**
+         * @brief State change statistics
+         * @m_since_latest_{integration}
+         *
+         * @see @ref stateChangeStatistics()
+         */
+        struct StateChangeStatistics {
+            /**
+             * Count of scissor, index buffer offset and texture binding
+             * changes issued in the last @ref drawFrame()
+             */
+            UnsignedInt issued;
+
+            /**
+             * Count of scissor, index buffer offset and texture binding
+             * changes skipped in the last @ref drawFrame() because they were
+             * the same as in the previous draw command
+             */
+            UnsignedInt skipped;
+        };
+
         /**
          * @brief Constructor
          * @param size                  Size of the user interface to which all
@@ -402,6 +696,41 @@ class MAGNUM_IMGUIINTEGRATION_EXPORT Context {
          */
         explicit Context(ImGuiContext& context, const Vector2i& size);
 
+        /**
+         * @brief Construct with shared resources
+         * @param resources             Shader and font atlas shared with other
+         *      contexts
+         * @param size                  Size of the user interface to which all
+         *      widgets are positioned
+         * @param windowSize            Size of the window to which all inputs
+         *      events are related
+         * @param framebufferSize       Size of the window framebuffer. On
+         *      some platforms with HiDPI screens may be different from window
+         *      size.
+         * @m_since_latest_{integration}
+         *
+         * Creates the ImGui context using @cpp ImGui::CreateContext() @ce
+         * with @ref SharedResources::atlas() as its font atlas and draws with
+         * @ref SharedResources::shader() instead of compiling a new shader.
+         * Textures of the atlas are uploaded by the first context that draws
+         * them and are then used by all others. Expects that @p resources
+         * stay alive for the whole lifetime of the context. See
+         * @ref ImGuiIntegration-Context-shared-resources for more
+         * information.
+         * @see @ref relayout(const Vector2&, const Vector2i&, const Vector2i&)
+         */
+        explicit Context(SharedResources& resources, const Vector2& size, const Vector2i& windowSize, const Vector2i& framebufferSize);
+
+        /**
+         * @brief Construct with shared resources without DPI awareness
+         * @m_since_latest_{integration}
+         *
+         * Equivalent to calling @ref Context(SharedResources&, const Vector2&, const Vector2i&, const Vector2i&)
+         * with @p size passed to the last three parameters.
+         * @see @ref relayout(const Vector2i&)
+         */
+        explicit Context(SharedResources& resources, const Vector2i& size);
+
         /**
          * @brief Construct without creating the underlying ImGui context
          *
@@ -442,6 +771,30 @@ class MAGNUM_IMGUIINTEGRATION_EXPORT Context {
          */
         ImGuiContext* context() { return _context; }
 
+        /**
+         * @brief Shared resources
+         * @m_since_latest_{integration}
+         *
+         * Returns @cpp nullptr @ce if the context wasn't created with
+         * @ref Context(SharedResources&, const Vector2&, const Vector2i&, const Vector2i&)
+         * or @ref Context(SharedResources&, const Vector2i&).
+         */
+        SharedResources* sharedResources() { return _sharedResources; }
+
+        /**
+         * @brief Whether the shader is linked
+         * @m_since_latest_{integration}
+         *
+         * Returns @cpp false @ce if the driver is still compiling or linking
+         * the shader in the background, in which case the next
+         * @ref drawFrame() will wait for it to finish. Always returns
+         * @cpp true @ce after the first @ref drawFrame(). If the context uses
+         * @ref SharedResources, returns
+         * @ref SharedResources::isShaderLinkFinished(). See
+         * @ref ImGuiIntegration-Context-async-shader for more information.
+         */
+        bool isShaderLinkFinished();
+
         /**
          * @brief Release the underlying ImGui context
          *
@@ -458,6 +811,64 @@ class MAGNUM_IMGUIINTEGRATION_EXPORT Context {
          */
         GL::Texture2D& atlasTexture() { return _texture; }
 
+        #if !defined(MAGNUM_TARGET_GLES2) || defined(DOXYGEN_GENERATING_OUTPUT)
+        /**
+         * @brief Register a 2D texture with a custom sampler
+         * @param texture   Texture
+         * @param sampler   OpenGL sampler object ID
+         * @m_since_latest_{integration}
+         *
+         * The texture is drawn with @p sampler bound, overriding sampling
+         * state set on the texture. Magnum doesn't wrap sampler objects, so
+         * the @p sampler is a raw ID created with @fn_gl{GenSamplers}. If
+         * it's @cpp 0 @ce, the texture is drawn the same way as when passed
+         * through @ref textureId(GL::Texture2D&). Neither the texture nor the
+         * sampler is owned by the context, they're expected to stay alive
+         * until @ref unregisterTexture() is called. See
+         * @ref ImGuiIntegration-Context-custom-textures for more information.
+         * @requires_gl33 Extension @gl_extension{ARB,sampler_objects} if
+         *      @p sampler is non-zero.
+         * @requires_gles30 Not available in OpenGL ES 2.0 and WebGL 1.0.
+         */
+        RegisteredTexture registerTexture(GL::Texture2D& texture, UnsignedInt sampler);
+
+        /**
+         * @brief Register a 2D array texture layer
+         * @param texture   Texture
+         * @param layer     Layer to draw
+         * @param sampler   OpenGL sampler object ID or @cpp 0 @ce
+         * @m_since_latest_{integration}
+         *
+         * Expects that @p layer is non-negative. Commands using the returned
+         * texture are drawn with a shader variant that samples given array
+         * layer, created on first use. Otherwise behaves the same as
+         * @ref registerTexture(GL::Texture2D&, UnsignedInt).
+         * @requires_gl30 Extension @gl_extension{EXT,texture_array}
+         * @requires_gles30 Not available in OpenGL ES 2.0 and WebGL 1.0.
+         */
+        RegisteredTexture registerTexture(GL::Texture2DArray& texture, Int layer, UnsignedInt sampler = 0);
+
+        /**
+         * @brief Unregister a texture
+         * @m_since_latest_{integration}
+         *
+         * Expects that @p texture was returned by @ref registerTexture() on
+         * this context and wasn't unregistered yet. The ID can be then reused
+         * for a newly registered texture, so it shouldn't be used in any draw
+         * commands anymore.
+         * @requires_gles30 Not available in OpenGL ES 2.0 and WebGL 1.0.
+         */
+        void unregisterTexture(RegisteredTexture texture);
+
+        /**
+         * @brief Count of registered textures
+         * @m_since_latest_{integration}
+         *
+         * @requires_gles30 Not available in OpenGL ES 2.0 and WebGL 1.0.
+         */
+        std::size_t registeredTextureCount() const;
+        #endif
+
         /**
          * @brief Relayout the context
          * @param size                  Size of the user interface to which all
@@ -490,6 +901,24 @@ class MAGNUM_IMGUIINTEGRATION_EXPORT Context {
          */
         void relayout(const Vector2i& size);
 
+        /**
+         * @brief Flags
+         * @m_since_latest_{integration}
+         *
+         * No flags are set by default.
+         * @see @ref setFlags()
+         */
+        Flags flags() const { return _flags; }
+
+        /**
+         * @brief Set flags
+         * @return Reference to self (for method chaining)
+         * @m_since_latest_{integration}
+         *
+         * The flags get applied in the next @ref drawFrame() call.
+         */
+        Context& setFlags(Flags flags);
+
         /**
          * @brief Start a new frame
          *
@@ -514,6 +943,110 @@ class MAGNUM_IMGUIINTEGRATION_EXPORT Context {
          */
         void drawFrame();
 
+        /**
+         * @brief Count of texture uploads in progress
+         * @m_since_latest_{integration}
+         *
+         * Count of staging buffers used by @ref Flag::AsyncTextureUploads
+         * that the GPU didn't finish transferring from yet. Always returns
+         * @cpp 0 @ce if the flag isn't set or is not supported.
+         */
+        std::size_t pendingTextureUploadCount() const;
+
+        /**
+         * @brief Memory used by ImGui-managed textures
+         * @m_since_latest_{integration}
+         *
+         * Size of all textures created by ImGui, such as font atlas pages, in
+         * bytes. Includes also textures released by ImGui and kept in a pool
+         * for reuse, see @ref texturePoolMemory(). Textures created by the
+         * application and drawn via @ref textureId() are not included.
+         */
+        std::size_t textureMemory() const;
+
+        /**
+         * @brief Memory used by pooled textures
+         * @m_since_latest_{integration}
+         *
+         * Size of textures that were released by ImGui and are kept for reuse
+         * by a subsequently created texture of the same size, in bytes. Never
+         * larger than @ref texturePoolCapacity().
+         */
+        std::size_t texturePoolMemory() const;
+
+        /**
+         * @brief Texture pool capacity
+         * @m_since_latest_{integration}
+         *
+         * Default is 16 MB.
+         * @see @ref setTexturePoolCapacity()
+         */
+        std::size_t texturePoolCapacity() const;
+
+        /**
+         * @brief Set texture pool capacity
+         * @return Reference to self (for method chaining)
+         * @m_since_latest_{integration}
+         *
+         * If the @ref texturePoolMemory() exceeds given capacity, the least
+         * recently released textures are deleted until it fits. Set to
+         * @cpp 0 @ce to disable the pool altogether. If the context was
+         * created with @ref SharedResources, the textures and the pool are
+         * shared as well and this sets the capacity for all contexts using
+         * the same @ref SharedResources instance.
+         */
+        Context& setTexturePoolCapacity(std::size_t capacity);
+
+        /**
+         * @brief Whether the UI needs to be redrawn
+         * @m_since_latest_{integration}
+         *
+         * Returns @cpp true @ce for a few frames after the context is
+         * created, after @ref relayout() and after any input event was
+         * passed to the event handling functions, such as
+         * @ref handlePointerPressEvent() or @ref handleKeyPressEvent(). It's
+         * also @cpp true @ce if the last @ref drawFrame() uploaded texture
+         * data, ImGui has an active item or a focused text input, or any
+         * mouse button is pressed. With @ref Flag::RetainedBuffers it's
+         * additionally @cpp true @ce if the UI geometry changed since the
+         * previous frame, which catches animations as well. Without the flag
+         * geometry changes aren't detected.
+         *
+         * If this function returns @cpp false @ce, the application can stop
+         * calling @ref Platform::Sdl2Application::redraw() "redraw()" and
+         * wait for input events instead, saving CPU and GPU time:
+         *
+         * @snippet ImGuiIntegration-sdl2.cpp Context-needsRedraw
+         */
+        bool needsRedraw() const { return _redrawFrames || _animating; }
+
+        /**
+         * @brief Statistics of the last frame
+         * @m_since_latest_{integration}
+         *
+         * Gathered in every @ref drawFrame() call, including the texture
+         * uploads done by it. Meant for profiling or setting up budget
+         * alarms, the overhead of gathering the statistics except for
+         * @ref Flag::GpuTimeQuery is negligible.
+         * @see @ref stateChangeStatistics()
+         */
+        FrameStatistics frameStatistics() const { return _frameStatistics; }
+
+        /**
+         * @brief State change statistics of the last frame
+         * @m_since_latest_{integration}
+         *
+         * The @ref drawFrame() function tracks the scissor rectangle, index
+         * buffer offset and texture used by the previous draw command and
+         * changes them only if they differ. This returns how many state
+         * changes were issued and how many were skipped in the last
+         * @ref drawFrame() call. The tracked state is discarded after every
+         * user callback, as it may change the state arbitrarily.
+         */
+        StateChangeStatistics stateChangeStatistics() const {
+            return _stateChangeStatistics;
+        }
+
         /**
          * @brief Handle pointer press event
          * @m_since_latest_{integration}
@@ -709,12 +1242,41 @@ class MAGNUM_IMGUIINTEGRATION_EXPORT Context {
         template<class Application> void connectApplicationClipboard(Application& application);
 
     private:
+        /* ImGui may need a few frames to process an input event */
+        static constexpr UnsignedInt RedrawFrameCount = 3;
+
+        explicit Context(ImGuiContext& context, SharedResources* sharedResources, const Vector2& size, const Vector2i& windowSize, const Vector2i& framebufferSize);
+
+        Implementation::ImGuiTextureStorage& textureStorage();
+        const Implementation::ImGuiTextureStorage& textureStorage() const;
+        void drawFrameInternal();
         void updateTexture(ImTextureData* tex);
+        void flushPendingPointerMove();
+        #ifndef MAGNUM_TARGET_GLES2
+        bool prepareClipShader();
+        RegisteredTexture registerTextureInternal(UnsignedInt id, Int layer, UnsignedInt sampler);
+        void prepareArrayShader(bool clipInShader, const Matrix3& projection);
+        void prepareDistanceFieldShader(bool clipInShader, const Matrix3& projection);
+        bool isFontTexture(UnsignedInt id) const;
+        #endif
+        #ifndef MAGNUM_TARGET_GLES
+        void destroyRingBuffers();
+        #endif
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        struct TextureUpload;
+        void uploadTextureAsync(GL::Texture2D& texture, ImTextureData& tex, const Range2Di& rect);
+        #endif
 
         template<class Application, class> friend struct Implementation::ApplicationClipboard;
 
         ImGuiContext* _context;
+        /* If set, the shader and the atlas textures are used from there and
+           _shader is NoCreate'd */
+        SharedResources* _sharedResources;
         Shaders::FlatGL2D _shader;
+        /* Set if the shader compilation isn't finished yet, _shader is
+           created from it in the first drawFrame() */
+        Containers::Optional<Shaders::FlatGL2D::CompileState> _shaderCompileState;
         GL::Texture2D _texture{NoCreate};
         GL::Buffer _vertexBuffer{GL::Buffer::TargetHint::Array};
         GL::Buffer _indexBuffer{GL::Buffer::TargetHint::ElementArray};
@@ -725,8 +1287,70 @@ class MAGNUM_IMGUIINTEGRATION_EXPORT Context {
         /* Optionally used by connectApplicationClipboard() */
         void* _application;
         Containers::String _lastClipboardText;
-
-        std::list<GL::Texture2D> _textures;
+        /* Staging memory for the combined vertex and index buffer upload,
+           kept across frames to avoid reallocations */
+        Containers::Array<char> _vertexData, _indexData;
+        Flags _flags;
+        StateChangeStatistics _stateChangeStatistics{};
+        /* Used by Flag::MultiDraw, kept across frames to avoid
+           reallocations */
+        Containers::Array<GL::MeshView> _drawViews;
+        /* Unused if _sharedResources is set */
+        Implementation::ImGuiTextureStorage _textureStorage;
+        FrameStatistics _frameStatistics{};
+        /* Size of data uploaded to _vertexBuffer and _indexBuffer from
+           _vertexData and _indexData, used by Flag::RetainedBuffers. All bits
+           set if the buffers don't match the staging memory. */
+        std::size_t _uploadedVertexDataSize{~std::size_t{}},
+            _uploadedIndexDataSize{~std::size_t{}};
+        /* Count of frames to draw after an input event, and whether the last
+           frame indicated there's something going on. Used by
+           needsRedraw(). */
+        UnsignedInt _redrawFrames{RedrawFrameCount};
+        bool _animating{};
+        /* Pointer move coalesced by Flag::CoalescePointerMoveEvents, not yet
+           submitted to ImGui, and WantCaptureMouse from the last newFrame()
+           returned for it */
+        bool _pointerMovePending{}, _wantCaptureMouse{};
+        Int _pendingPointerSource{};
+        Vector2 _pendingPointerPosition;
+        #ifndef MAGNUM_TARGET_WEBGL
+        /* Used by Flag::GpuTimeQuery, created on first use. The bitmask
+           marks queries that wait for a result. */
+        GL::TimeQuery _timeQueries[3]{GL::TimeQuery{NoCreate}, GL::TimeQuery{NoCreate}, GL::TimeQuery{NoCreate}};
+        UnsignedInt _timeQueryIndex{};
+        UnsignedByte _timeQueriesPending{};
+        #endif
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        /* Staging buffers used by Flag::AsyncTextureUploads */
+        Containers::Array<TextureUpload> _textureUploads;
+        #endif
+        #ifndef MAGNUM_TARGET_GLES
+        /* Persistently mapped memory of _vertexBuffer and _indexBuffer if
+           Flag::PersistentMappedBuffers is used, split into three segments
+           of given capacity. The fences are GLsync, stored as a void* to
+           avoid including GL headers here. */
+        Containers::ArrayView<char> _ringVertexData, _ringIndexData;
+        UnsignedInt _ringVertexCapacity{}, _ringIndexCapacity{}, _ringSegment{};
+        void* _ringFences[3]{};
+        #endif
+        #ifndef MAGNUM_TARGET_GLES2
+        /* Used by Flag::ShaderClipping, created on first use. The staging
+           memory is kept across frames to avoid reallocations. */
+        Containers::Pointer<Implementation::ClipShaderGL> _clipShader;
+        GL::Buffer _clipBuffer{NoCreate};
+        GL::Mesh _clipMesh{NoCreate};
+        Containers::Array<Vector4us> _clipData;
+
+        /* Used by registerTexture(), the shaders for drawing array layers
+           are created on first use */
+        Containers::Array<Implementation::RegisteredTextureData> _registeredTextures;
+        Shaders::FlatGL2D _arrayShader{NoCreate};
+        Containers::Pointer<Implementation::ClipShaderGL> _clipArrayShader;
+
+        /* Used by Flag::DistanceFieldFonts, created on first use */
+        Containers::Pointer<Implementation::DistanceFieldShaderGL> _distanceFieldShader, _clipDistanceFieldShader;
+        #endif
 
     private:
         template<class KeyEvent> bool handleKeyEvent(KeyEvent& event, bool value);
@@ -736,6 +1360,20 @@ class MAGNUM_IMGUIINTEGRATION_EXPORT Context {
         #endif
 };
 
+CORRADE_ENUMSET_OPERATORS(Context::Flags)
+
+/**
+ * @debugoperatorclassenum{Context,Context::Flag}
+ * @m_since_latest_{integration}
+ */
+MAGNUM_IMGUIINTEGRATION_EXPORT Debug& operator<<(Debug& debug, Context::Flag value);
+
+/**
+ * @debugoperatorclassenum{Context,Context::Flags}
+ * @m_since_latest_{integration}
+ */
+MAGNUM_IMGUIINTEGRATION_EXPORT Debug& operator<<(Debug& debug, Context::Flags value);
+
 }}
 
 #endif
@@ -52,6 +52,11 @@ template<class KeyEvent> bool Context::handleKeyEvent(KeyEvent& event, bool valu
     /* Ensure we use the context we're linked to */
     ImGui::SetCurrentContext(_context);
 
+    /* Input needs a few frames to be processed and reflected in the UI */
+    _redrawFrames = RedrawFrameCount;
+    /* Submit a coalesced pointer move first to preserve the event order */
+    flushPendingPointerMove();
+
     typedef decltype(event.modifiers()) Modifiers;
     typedef typename Modifiers::Type Modifier;
     typedef decltype(event.key()) Key;
@@ -238,6 +243,11 @@ template<class PointerEvent> bool Context::handlePointerEvent(PointerEvent& even
     /* Ensure we use the context we're linked to */
     ImGui::SetCurrentContext(_context);
 
+    /* Input needs a few frames to be processed and reflected in the UI */
+    _redrawFrames = RedrawFrameCount;
+    /* Submit a coalesced pointer move first to preserve the event order */
+    flushPendingPointerMove();
+
     ImGuiIO& io = ImGui::GetIO();
     const Vector2 position = event.position()*_eventScaling;
 
@@ -284,6 +294,11 @@ template<class MouseEvent> bool Context::handleMouseEvent(MouseEvent& event, boo
     /* Ensure we use the context we're linked to */
     ImGui::SetCurrentContext(_context);
 
+    /* Input needs a few frames to be processed and reflected in the UI */
+    _redrawFrames = RedrawFrameCount;
+    /* Submit a coalesced pointer move first to preserve the event order */
+    flushPendingPointerMove();
+
     ImGuiIO& io = ImGui::GetIO();
     const Vector2 position = Vector2(event.position())*_eventScaling;
 
@@ -323,6 +338,11 @@ template<class ScrollEvent> bool Context::handleScrollEvent(ScrollEvent& event)
     /* Ensure we use the context we're linked to */
     ImGui::SetCurrentContext(_context);
 
+    /* Input needs a few frames to be processed and reflected in the UI */
+    _redrawFrames = RedrawFrameCount;
+    /* Submit a coalesced pointer move first to preserve the event order */
+    flushPendingPointerMove();
+
     ImGuiIO& io = ImGui::GetIO();
     const Vector2 position = event.position()*_eventScaling;
 
@@ -338,6 +358,11 @@ template<class MouseScrollEvent> bool Context::handleMouseScrollEvent(MouseScrol
     /* Ensure we use the context we're linked to */
     ImGui::SetCurrentContext(_context);
 
+    /* Input needs a few frames to be processed and reflected in the UI */
+    _redrawFrames = RedrawFrameCount;
+    /* Submit a coalesced pointer move first to preserve the event order */
+    flushPendingPointerMove();
+
     ImGuiIO& io = ImGui::GetIO();
     const Vector2 position = Vector2(event.position())*_eventScaling;
 
@@ -354,10 +379,9 @@ template<class PointerMoveEvent> bool Context::handlePointerMoveEvent(PointerMov
     if(!event.isPrimary())
         return false;
 
-    /* Ensure we use the context we're linked to */
-    ImGui::SetCurrentContext(_context);
+    /* Input needs a few frames to be processed and reflected in the UI */
+    _redrawFrames = RedrawFrameCount;
 
-    ImGuiIO& io = ImGui::GetIO();
     const Vector2 position = event.position()*_eventScaling;
 
     /* If the event additionally changes the set of pressed buttons, try to
@@ -377,12 +401,34 @@ template<class PointerMoveEvent> bool Context::handlePointerMoveEvent(PointerMov
     }
 
     #if IMGUI_VERSION_NUM >= 18948
+    ImGuiMouseSource source;
     if(Implementation::isTouchPointerEventSource(event.source()))
-        io.AddMouseSourceEvent(ImGuiMouseSource_TouchScreen);
+        source = ImGuiMouseSource_TouchScreen;
     else if(Implementation::isPenPointerEventSource(event.source()))
-        io.AddMouseSourceEvent(ImGuiMouseSource_Pen);
+        source = ImGuiMouseSource_Pen;
     else
-        io.AddMouseSourceEvent(ImGuiMouseSource_Mouse);
+        source = ImGuiMouseSource_Mouse;
+    #endif
+
+    /* If coalescing, only remember the position, it gets submitted before
+       the next event that isn't a plain move or in newFrame(). That way even
+       the current context doesn't need to be switched. */
+    if((_flags & Flag::CoalescePointerMoveEvents) && !buttonId) {
+        _pointerMovePending = true;
+        _pendingPointerPosition = position;
+        #if IMGUI_VERSION_NUM >= 18948
+        _pendingPointerSource = source;
+        #endif
+        return _wantCaptureMouse;
+    }
+
+    /* Ensure we use the context we're linked to */
+    ImGui::SetCurrentContext(_context);
+    flushPendingPointerMove();
+
+    ImGuiIO& io = ImGui::GetIO();
+    #if IMGUI_VERSION_NUM >= 18948
+    io.AddMouseSourceEvent(source);
     #endif
     io.AddMousePosEvent(position.x(), position.y());
     /* The button is pressed if it's contained in the set of currently
@@ -400,6 +446,11 @@ template<class MouseMoveEvent> bool Context::handleMouseMoveEvent(MouseMoveEvent
     /* Ensure we use the context we're linked to */
     ImGui::SetCurrentContext(_context);
 
+    /* Input needs a few frames to be processed and reflected in the UI */
+    _redrawFrames = RedrawFrameCount;
+    /* Submit a coalesced pointer move first to preserve the event order */
+    flushPendingPointerMove();
+
     ImGuiIO& io = ImGui::GetIO();
     const Vector2 position = Vector2(event.position())*_eventScaling;
 
@@ -422,6 +473,11 @@ template<class TextInputEvent> bool Context::handleTextInputEvent(TextInputEvent
     /* Ensure we use the context we're linked to */
     ImGui::SetCurrentContext(_context);
 
+    /* Input needs a few frames to be processed and reflected in the UI */
+    _redrawFrames = RedrawFrameCount;
+    /* Submit a coalesced pointer move first to preserve the event order */
+    flushPendingPointerMove();
+
     ImGui::GetIO().AddInputCharactersUTF8(event.text().data());
     return false;
 }
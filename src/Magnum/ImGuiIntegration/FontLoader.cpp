@@ -0,0 +1,403 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "FontLoader.h"
+
+#include <new>
+#include <cstring>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Containers/String.h>
+#include <Corrade/Containers/Triple.h>
+#include <Corrade/PluginManager/Manager.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Format.h>
+#include <Corrade/Utility/Move.h>
+#include <Magnum/ImageView.h>
+#include <Magnum/PixelFormat.h>
+#include <Magnum/Math/Functions.h>
+#include <Magnum/Math/Color.h>
+#include <Magnum/Math/Range.h>
+#include <Magnum/Text/AbstractFont.h>
+#include <Magnum/Text/AbstractGlyphCache.h>
+
+#ifndef MAGNUM_TARGET_GLES2
+#include <Magnum/Image.h>
+#include <Magnum/GL/DefaultFramebuffer.h>
+#include <Magnum/GL/Framebuffer.h>
+#include <Magnum/GL/OpenGL.h>
+#include <Magnum/GL/Texture.h>
+#include <Magnum/GL/TextureFormat.h>
+#include <Magnum/TextureTools/DistanceFieldGL.h>
+#endif
+
+#include "Magnum/ImGuiIntegration/visibility.h" /* defines IMGUI_API */
+
+#include <imgui.h>
+#include <imgui_internal.h>
+
+namespace Magnum { namespace ImGuiIntegration {
+
+namespace {
+
+/* Glyph cache that only has the CPU-side copy, the pixels are copied from it
+   to the ImGui atlas */
+class CpuGlyphCache: public Text::AbstractGlyphCache {
+    public:
+        explicit CpuGlyphCache(const Vector2i& size): Text::AbstractGlyphCache{PixelFormat::R8Unorm, size} {}
+
+    private:
+        Text::GlyphCacheFeatures doFeatures() const override { return {}; }
+        void doSetImage(const Vector3i&, const ImageView3D&) override {}
+};
+
+/* Distance field glyphs are rasterized at this multiple of the baked size */
+constexpr Int DistanceFieldScale = 8;
+
+/* Set in ImFontConfig::FontLoaderFlags for distance field fonts, with the
+   radius in the lower byte */
+constexpr UnsignedInt DistanceFieldLoaderFlag = 1u << 31;
+
+}
+
+/* Derived from the ImGui loader so the callbacks can get back to the plugin
+   manager from the ImFontLoader pointer stored in the atlas or the font
+   config */
+struct FontLoader::State: ImFontLoader {
+    /* Stored in ImFontConfig::FontLoaderData, used for glyph lookup */
+    struct SourceData {
+        State* state;
+        Containers::Pointer<Text::AbstractFont> font;
+    };
+
+    /* Stored in the memory ImGui allocates for each ImFontBaked and source.
+       The font is opened at the baked size multiplied by the density and
+       scale, the radius is zero for fonts that aren't a distance field. */
+    struct BakedData {
+        Text::AbstractFont* font;
+        Float density;
+        Int scale;
+        UnsignedInt radius;
+    };
+
+    explicit State(PluginManager::Manager<Text::AbstractFont>& manager, Containers::StringView plugin);
+
+    Containers::Pointer<Text::AbstractFont> openFont(const ImFontConfig& src, Float size);
+    #ifndef MAGNUM_TARGET_GLES2
+    Containers::Array<UnsignedByte> distanceField(const Containers::StridedArrayView2D<const UnsignedByte>& glyph, UnsignedInt radius, Vector2i& outputSize);
+    #endif
+
+    static bool loaderInit(ImFontAtlas*) { return true; }
+    static void loaderShutdown(ImFontAtlas*) {}
+    static bool fontSrcInit(ImFontAtlas* atlas, ImFontConfig* src);
+    static void fontSrcDestroy(ImFontAtlas*, ImFontConfig* src);
+    static bool fontSrcContainsGlyph(ImFontAtlas*, ImFontConfig* src, ImWchar codepoint);
+    static bool fontBakedInit(ImFontAtlas*, ImFontConfig* src, ImFontBaked* baked, void* loaderDataForBakedSrc);
+    static void fontBakedDestroy(ImFontAtlas*, ImFontConfig*, ImFontBaked*, void* loaderDataForBakedSrc);
+    static bool fontBakedLoadGlyph(ImFontAtlas* atlas, ImFontConfig* src, ImFontBaked* baked, void* loaderDataForBakedSrc, ImWchar codepoint, ImFontGlyph* outGlyph
+        #if IMGUI_VERSION_NUM >= 19202
+        , float* outAdvanceX
+        #endif
+    );
+
+    PluginManager::Manager<Text::AbstractFont>& manager;
+    Containers::String plugin;
+    #ifndef MAGNUM_TARGET_GLES2
+    /* Created on first use, recreated if a font with a different radius is
+       processed */
+    Containers::Pointer<TextureTools::DistanceFieldGL> distanceFieldProcessor;
+    #endif
+};
+
+FontLoader::State::State(PluginManager::Manager<Text::AbstractFont>& manager, const Containers::StringView plugin): manager(manager), plugin{plugin} {
+    Name = "Magnum::Text::AbstractFont";
+    LoaderInit = loaderInit;
+    LoaderShutdown = loaderShutdown;
+    FontSrcInit = fontSrcInit;
+    FontSrcDestroy = fontSrcDestroy;
+    FontSrcContainsGlyph = fontSrcContainsGlyph;
+    FontBakedInit = fontBakedInit;
+    FontBakedDestroy = fontBakedDestroy;
+    FontBakedLoadGlyph = fontBakedLoadGlyph;
+    FontBakedSrcLoaderDataSize = sizeof(BakedData);
+}
+
+Containers::Pointer<Text::AbstractFont> FontLoader::State::openFont(const ImFontConfig& src, const Float size) {
+    Containers::Pointer<Text::AbstractFont> font = manager.loadAndInstantiate(plugin);
+    if(!font || !font->openData(Containers::ArrayView<const void>{src.FontData, std::size_t(src.FontDataSize)}, size))
+        return {};
+    return font;
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+Containers::Array<UnsignedByte> FontLoader::State::distanceField(const Containers::StridedArrayView2D<const UnsignedByte>& glyph, const UnsignedInt radius, Vector2i& outputSize) {
+    /* Leave space for the distance field around the glyph. The input is a
+       multiple of the output size as DistanceFieldGL expects, the glyph is
+       placed padding*DistanceFieldScale from the bottom left. */
+    const Int padding = radius + 1;
+    const Vector2i glyphSize{Int(glyph.size()[1]), Int(glyph.size()[0])};
+    outputSize = (glyphSize + Vector2i{DistanceFieldScale - 1})/DistanceFieldScale + Vector2i{2*padding};
+    const Vector2i inputSize = outputSize*DistanceFieldScale;
+    Containers::Array<UnsignedByte> input{ValueInit, std::size_t(inputSize.product())};
+    const Containers::StridedArrayView2D<UnsignedByte> inputPixels{input, {std::size_t(inputSize.y()), std::size_t(inputSize.x())}};
+    Utility::copy(glyph, inputPixels.sliceSize(
+        {std::size_t(padding*DistanceFieldScale), std::size_t(padding*DistanceFieldScale)},
+        glyph.size()));
+
+    if(!distanceFieldProcessor || distanceFieldProcessor->radius() != radius*DistanceFieldScale)
+        distanceFieldProcessor.emplace(radius*DistanceFieldScale);
+
+    /* The glyphs are loaded in the middle of the application frame, remember
+       the framebuffer binding to restore it after */
+    GLint previousFramebuffer, previousViewport[4];
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previousFramebuffer);
+    glGetIntegerv(GL_VIEWPORT, previousViewport);
+
+    GL::Texture2D inputTexture;
+    inputTexture.setMinificationFilter(GL::SamplerFilter::Linear)
+        .setMagnificationFilter(GL::SamplerFilter::Linear)
+        .setWrapping(GL::SamplerWrapping::ClampToEdge)
+        .setStorage(1, GL::TextureFormat::R8, inputSize)
+        .setSubImage(0, {}, ImageView2D{PixelStorage{}.setAlignment(1), PixelFormat::R8Unorm, inputSize, input});
+
+    GL::Texture2D outputTexture;
+    outputTexture.setStorage(1, GL::TextureFormat::RGBA8, outputSize);
+    GL::Framebuffer framebuffer{{{}, outputSize}};
+    framebuffer.attachTexture(GL::Framebuffer::ColorAttachment{0}, outputTexture, 0);
+    (*distanceFieldProcessor)(inputTexture, framebuffer, {{}, outputSize}, inputSize);
+    const Image2D output = framebuffer.read({{}, outputSize}, {PixelFormat::RGBA8Unorm});
+
+    const Range2Di viewport{{previousViewport[0], previousViewport[1]}, {previousViewport[0] + previousViewport[2], previousViewport[1] + previousViewport[3]}};
+    if(previousFramebuffer)
+        GL::Framebuffer::wrap(previousFramebuffer, viewport).bind();
+    else
+        GL::defaultFramebuffer.bind();
+
+    /* The distance is in the red channel. The output is Y up, ImGui wants Y
+       down. */
+    const Containers::StridedArrayView2D<const Color4ub> outputPixels = output.pixels<Color4ub>();
+    Containers::Array<UnsignedByte> out{NoInit, std::size_t(outputSize.product())};
+    for(Int y = 0; y != outputSize.y(); ++y)
+        for(Int x = 0; x != outputSize.x(); ++x)
+            out[y*outputSize.x() + x] = outputPixels[outputSize.y() - 1 - y][x].r();
+    return out;
+}
+#endif
+
+bool FontLoader::State::fontSrcInit(ImFontAtlas* const atlas, ImFontConfig* const src) {
+    /* The loader is either set for just this font or for the whole atlas */
+    const ImFontLoader* const loader = src->FontLoader ? src->FontLoader : atlas->FontLoader;
+    State& state = *static_cast<State*>(const_cast<ImFontLoader*>(loader));
+
+    /* Open the font once at the reference size to verify the data and to
+       have something to query glyph presence on */
+    Containers::Pointer<Text::AbstractFont> font = state.openFont(*src, src->SizePixels > 0.0f ? src->SizePixels : 16.0f);
+    if(!font) return false;
+
+    src->FontLoaderData = new SourceData{&state, Utility::move(font)};
+    return true;
+}
+
+void FontLoader::State::fontSrcDestroy(ImFontAtlas*, ImFontConfig* const src) {
+    delete static_cast<SourceData*>(src->FontLoaderData);
+    src->FontLoaderData = nullptr;
+}
+
+bool FontLoader::State::fontSrcContainsGlyph(ImFontAtlas*, ImFontConfig* const src, const ImWchar codepoint) {
+    return static_cast<SourceData*>(src->FontLoaderData)->font->glyphForCharacter(codepoint);
+}
+
+bool FontLoader::State::fontBakedInit(ImFontAtlas*, ImFontConfig* const src, ImFontBaked* const baked, void* const loaderDataForBakedSrc) {
+    SourceData& sourceData = *static_cast<SourceData*>(src->FontLoaderData);
+    const Float density = src->RasterizerDensity*baked->RasterizerDensity;
+    const UnsignedInt radius = src->FontLoaderFlags & DistanceFieldLoaderFlag ? src->FontLoaderFlags & 0xff : 0;
+    const Int scale = radius ? DistanceFieldScale : 1;
+    Containers::Pointer<Text::AbstractFont> font = sourceData.state->openFont(*src, baked->Size*density*scale);
+    if(!font) return false;
+
+    /* The descent is negative in Magnum fonts, same as ImGui expects */
+    if(!src->MergeMode) {
+        baked->Ascent = Math::ceil(font->ascent()/(density*scale));
+        baked->Descent = Math::floor(font->descent()/(density*scale));
+    }
+
+    new(loaderDataForBakedSrc) BakedData{font.release(), density, scale, radius};
+    return true;
+}
+
+void FontLoader::State::fontBakedDestroy(ImFontAtlas*, ImFontConfig*, ImFontBaked*, void* const loaderDataForBakedSrc) {
+    delete static_cast<BakedData*>(loaderDataForBakedSrc)->font;
+}
+
+bool FontLoader::State::fontBakedLoadGlyph(ImFontAtlas* const atlas, ImFontConfig* const src, ImFontBaked* const baked, void* const loaderDataForBakedSrc, const ImWchar codepoint, ImFontGlyph* const outGlyph
+    #if IMGUI_VERSION_NUM >= 19202
+    , float* const outAdvanceX
+    #endif
+) {
+    const BakedData& data = *static_cast<BakedData*>(loaderDataForBakedSrc);
+    Text::AbstractFont& font = *data.font;
+    const UnsignedInt glyph = font.glyphForCharacter(codepoint);
+    if(!glyph) return false;
+
+    const Float advance = font.glyphAdvance(glyph).x()/(data.density*data.scale);
+    #if IMGUI_VERSION_NUM >= 19202
+    /* Only the advance is queried, don't rasterize anything */
+    if(!outGlyph) {
+        *outAdvanceX = advance;
+        return true;
+    }
+    #endif
+    outGlyph->Codepoint = codepoint;
+    outGlyph->AdvanceX = advance;
+
+    /* Glyphs such as space have nothing to rasterize */
+    const Vector2i glyphSize{Math::ceil(font.glyphSize(glyph))};
+    if(!glyphSize.product()) return true;
+
+    /* Rasterize the glyph alone into a temporary cache, with space for the
+       cache padding around. Glyphs are requested one by one and only the
+       first time they're drawn at given size, so the overhead of a cache per
+       glyph is negligible compared to the rasterization itself. */
+    CpuGlyphCache cache{glyphSize + Vector2i{4}};
+    const UnsignedInt fontId = cache.addFont(font.glyphCount(), &font);
+    if(!font.fillGlyphCache(cache, {glyph})) return false;
+
+    const Containers::Triple<Vector2i, Int, Range2Di> cacheGlyph = cache.glyph(fontId, glyph);
+    const Range2Di rectangle = cacheGlyph.third();
+    if(!rectangle.size().product()) return true;
+
+    const Containers::StridedArrayView2D<const UnsignedByte> cachePixels = cache.image().pixels<UnsignedByte>()[0]
+        .sliceSize({std::size_t(rectangle.min().y()), std::size_t(rectangle.min().x())},
+                   {std::size_t(rectangle.sizeY()), std::size_t(rectangle.sizeX())});
+
+    /* Bottom left corner of the glyph relative to the pen position on the
+       baseline and its size, both in pixels of the baked size multiplied by
+       the density */
+    Vector2 bottomLeft;
+    Vector2i size;
+    Containers::Array<UnsignedByte> pixels;
+    #ifndef MAGNUM_TARGET_GLES2
+    if(data.radius) {
+        pixels = static_cast<SourceData*>(src->FontLoaderData)->state->distanceField(cachePixels, data.radius, size);
+        bottomLeft = Vector2{cacheGlyph.first()}/Float(DistanceFieldScale) - Vector2{Float(data.radius + 1)};
+    } else
+    #endif
+    {
+        /* The cache image is Y up while ImGui wants Y down, copy the rows
+           flipped */
+        size = rectangle.size();
+        bottomLeft = Vector2{cacheGlyph.first()};
+        pixels = Containers::Array<UnsignedByte>{NoInit, std::size_t(size.product())};
+        for(Int y = 0; y != size.y(); ++y)
+            Utility::copy(cachePixels[size.y() - 1 - y], pixels.sliceSize(y*size.x(), size.x()));
+    }
+
+    const ImFontAtlasRectId packId = ImFontAtlasPackAddRect(atlas, size.x(), size.y());
+    if(packId == ImFontAtlasRectId_Invalid) return false;
+    ImTextureRect* const r = ImFontAtlasPackGetRect(atlas, packId);
+
+    /* Offsets from the config are specified for the reference size, scale
+       them for the baked size like the builtin loaders do */
+    const Float referenceSize = baked->ContainerFont->Sources[0]->SizePixels;
+    const Float offsetScale = referenceSize != 0.0f ? baked->Size/referenceSize : 1.0f;
+    Vector2 offset{src->GlyphOffset.x*offsetScale, src->GlyphOffset.y*offsetScale};
+    if(src->PixelSnapH) offset.x() = Math::round(offset.x());
+    if(src->PixelSnapV) offset.y() = Math::round(offset.y());
+    offset.y() += Math::round(baked->Ascent);
+
+    /* ImGui wants the top left corner, Y down */
+    const Vector2 min = Vector2{bottomLeft.x(), -(bottomLeft.y() + size.y())}/data.density + offset;
+    const Vector2 max = min + Vector2{size}/data.density;
+    outGlyph->X0 = min.x();
+    outGlyph->Y0 = min.y();
+    outGlyph->X1 = max.x();
+    outGlyph->Y1 = max.y();
+    outGlyph->Visible = true;
+    outGlyph->PackId = packId;
+    ImFontAtlasBakedSetFontGlyphBitmap(atlas, baked, src, outGlyph, r, pixels.data(), ImTextureFormat_Alpha8, size.x());
+    return true;
+}
+
+FontLoader::FontLoader(PluginManager::Manager<Text::AbstractFont>& manager, const Containers::StringView plugin): _state{InPlaceInit, manager, plugin} {}
+
+FontLoader::~FontLoader() = default;
+
+PluginManager::Manager<Text::AbstractFont>& FontLoader::manager() {
+    return _state->manager;
+}
+
+Containers::StringView FontLoader::plugin() const {
+    return _state->plugin;
+}
+
+const ImFontLoader& FontLoader::imFontLoader() const {
+    return *_state;
+}
+
+ImFont* FontLoader::addFont(ImFontAtlas& atlas, const Containers::ArrayView<const void> data, const Float size, const ImFontConfig* const config) {
+    return addFontInternal(atlas, data, size, config, config ? config->FontLoaderFlags & ~DistanceFieldLoaderFlag : 0);
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+ImFont* FontLoader::addDistanceFieldFont(ImFontAtlas& atlas, const Containers::ArrayView<const void> data, const Float size, const UnsignedInt radius, const ImFontConfig* const config) {
+    CORRADE_ASSERT(radius >= 1 && radius <= 255,
+        "ImGuiIntegration::FontLoader::addDistanceFieldFont(): expected radius between 1 and 255, got" << radius, nullptr);
+
+    /* The antialiased line textures would get their edges sharpened by the
+       distance field shader, make ImGui draw the lines as geometry */
+    atlas.Flags |= ImFontAtlasFlags_NoBakedLines;
+
+    ImFont* const font = addFontInternal(atlas, data, size, config, DistanceFieldLoaderFlag|radius);
+    if(!font) return nullptr;
+
+    /* Bake just the one size, which gets scaled for all others */
+    font->Flags |= ImFontFlags_LockBakedSizes;
+    font->GetFontBaked(size, 1.0f);
+    return font;
+}
+#endif
+
+ImFont* FontLoader::addFontInternal(ImFontAtlas& atlas, const Containers::ArrayView<const void> data, const Float size, const ImFontConfig* const config, const UnsignedInt loaderFlags) {
+    ImFontConfig cfg = config ? *config : ImFontConfig{};
+    cfg.FontLoaderFlags = loaderFlags;
+
+    /* The atlas frees the data with IM_FREE() once it's not needed anymore,
+       including when adding the font fails */
+    void* const fontData = IM_ALLOC(data.size());
+    std::memcpy(fontData, data.data(), data.size());
+    cfg.FontData = fontData;
+    cfg.FontDataSize = data.size();
+    cfg.FontDataOwnedByAtlas = true;
+    cfg.SizePixels = size;
+    cfg.FontLoader = _state.get();
+    if(!cfg.Name[0])
+        ImStrncpy(cfg.Name, Utility::format("{}, {}px", _state->plugin, size).data(), IM_ARRAYSIZE(cfg.Name));
+
+    return atlas.AddFont(&cfg);
+}
+
+}}
@@ -0,0 +1,208 @@
+#ifndef Magnum_ImGuiIntegration_FontLoader_h
+#define Magnum_ImGuiIntegration_FontLoader_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::ImGuiIntegration::FontLoader
+ * @m_since_latest_{integration}
+ */
+
+#include <Corrade/Containers/Pointer.h>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/PluginManager/PluginManager.h>
+#include <Magnum/Magnum.h>
+#include <Magnum/Text/Text.h>
+
+#include "Magnum/ImGuiIntegration/visibility.h"
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+struct ImFont;
+struct ImFontAtlas;
+struct ImFontConfig;
+struct ImFontLoader;
+#endif
+
+namespace Magnum { namespace ImGuiIntegration {
+
+/**
+@brief Font loader using Magnum font plugins
+@m_since_latest_{integration}
+
+Makes ImGui rasterize glyphs through @ref Text::AbstractFont plugins such as
+@ref Text::FreeTypeFont "FreeTypeFont" or
+@ref Text::HarfBuzzFont "HarfBuzzFont", instead of the @cb{.sh} stb_truetype @ce
+loader bundled with ImGui. Apart from using the same rasterizer as the rest of
+the application, any font format supported by the plugins can be used.
+
+ImGui requests glyphs from the loader lazily, the first time each glyph is
+drawn at given size and rasterizer density, and packs them into its dynamic
+atlas. Only the changed parts are then uploaded by @ref Context::drawFrame().
+Because of that, a change of the framebuffer-to-window ratio in
+@ref Context::relayout() or a change of the font size doesn't re-rasterize
+the whole atlas, and fonts covering many scripts don't need to have all their
+glyphs prebaked upfront.
+
+@section ImGuiIntegration-FontLoader-usage Usage
+
+The loader is constructed with a font plugin manager and a plugin name,
+@cpp "TrueTypeFont" @ce by default. Then, fonts are added to an ImGui font
+atlas with @ref addFont(), which copies the font data to the atlas:
+
+@snippet ImGuiIntegration-text.cpp FontLoader-usage
+
+The fonts added this way reference the loader, so the loader instance has to
+outlive the atlas. Because of that, it's neither copyable nor movable.
+Alternatively, the ImGui loader returned by @ref imFontLoader() can be set
+with @cpp ImFontAtlas::SetFontLoader() @ce for all fonts in the atlas, or
+assigned to @cpp ImFontConfig::FontLoader @ce for particular fonts.
+
+@section ImGuiIntegration-FontLoader-sizes Font sizes
+
+A separate plugin instance is opened for every size and rasterizer density
+ImGui requests a font in. The size is interpreted by the plugin, which for
+@ref Text::FreeTypeFont "FreeTypeFont" means it's the em size. The ImGui
+@cb{.sh} stb_truetype @ce loader treats it as a height from the font descent
+to the font ascent instead, so text of the same size may look slightly larger
+with this loader.
+
+The glyphs are currently rasterized on the thread calling ImGui, as ImGui
+expects the glyph data to be available immediately.
+
+@section ImGuiIntegration-FontLoader-distance-field Distance field fonts
+
+Fonts added with @ref addDistanceFieldFont() are baked just once, at the
+size passed to the function, and stored in the atlas as a distance field.
+ImGui then scales the single bake for all other font sizes and rasterizer
+densities instead of baking new ones. Combined with
+@ref Context::Flag::DistanceFieldFonts, which makes the context draw the font
+atlas with a distance field shader, the text stays crisp at any scale while
+the atlas stays small. This is mainly useful for UIs drawn at high
+framebuffer-to-window ratios or in VR, where supersampling the font would
+need a large atlas:
+
+@snippet ImGuiIntegration-text.cpp FontLoader-distance-field
+
+@experimental
+*/
+class MAGNUM_IMGUIINTEGRATION_EXPORT FontLoader {
+    public:
+        /**
+         * @brief Constructor
+         * @param manager   Font plugin manager
+         * @param plugin    Font plugin name
+         *
+         * The plugin isn't loaded until the first font is added.
+         */
+        explicit FontLoader(PluginManager::Manager<Text::AbstractFont>& manager, Containers::StringView plugin = "TrueTypeFont");
+
+        /** @brief Copying is not allowed */
+        FontLoader(const FontLoader&) = delete;
+
+        /** @brief Moving is not allowed */
+        FontLoader(FontLoader&&) = delete;
+
+        ~FontLoader();
+
+        /** @brief Copying is not allowed */
+        FontLoader& operator=(const FontLoader&) = delete;
+
+        /** @brief Moving is not allowed */
+        FontLoader& operator=(FontLoader&&) = delete;
+
+        /** @brief Font plugin manager */
+        PluginManager::Manager<Text::AbstractFont>& manager();
+
+        /** @brief Font plugin name */
+        Containers::StringView plugin() const;
+
+        /**
+         * @brief ImGui font loader
+         *
+         * Can be passed to @cpp ImFontAtlas::SetFontLoader() @ce or assigned
+         * to @cpp ImFontConfig::FontLoader @ce.
+         */
+        const ImFontLoader& imFontLoader() const;
+
+        /**
+         * @brief Add a font
+         * @param atlas     ImGui font atlas
+         * @param data      Font file data
+         * @param size      Font size in pixels
+         * @param config    ImGui font configuration. If @cpp nullptr @ce,
+         *      defaults are used.
+         *
+         * Copies @p data to memory owned by the atlas and adds the font with
+         * this loader. Returns @cpp nullptr @ce if the plugin can't be
+         * loaded or the font can't be opened, a message is printed by the
+         * plugin in that case. The @cpp FontData @ce, @cpp FontDataSize @ce,
+         * @cpp SizePixels @ce and @cpp FontLoader @ce fields of @p config are
+         * ignored.
+         */
+        ImFont* addFont(ImFontAtlas& atlas, Containers::ArrayView<const void> data, Float size, const ImFontConfig* config = nullptr);
+
+        #if !defined(MAGNUM_TARGET_GLES2) || defined(DOXYGEN_GENERATING_OUTPUT)
+        /**
+         * @brief Add a distance field font
+         * @param atlas     ImGui font atlas
+         * @param data      Font file data
+         * @param size      Size the font is baked at, in pixels
+         * @param radius    Distance field radius, in pixels of @p size
+         * @param config    ImGui font configuration. If @cpp nullptr @ce,
+         *      defaults are used.
+         *
+         * Like @ref addFont(), but the glyphs are rasterized at 8 times
+         * @p size, converted to a distance field using
+         * @ref TextureTools::DistanceFieldGL and stored in the atlas at
+         * @p size. The font is marked with @cpp ImFontFlags_LockBakedSizes @ce
+         * and baked at @p size right away, so ImGui scales this bake for
+         * all other sizes. Additionally, @cpp ImFontAtlasFlags_NoBakedLines @ce
+         * is set on the atlas, as the line textures baked by ImGui would be
+         * distorted by the distance field shader. The @cpp FontLoaderFlags @ce
+         * field of @p config is ignored.
+         *
+         * Expects that @p radius is between @cpp 1 @ce and @cpp 255 @ce.
+         * Glyphs are processed on the GPU, so a GL context has to be
+         * current whenever ImGui loads new glyphs, which is usually the case
+         * for code between @ref Context::newFrame() and
+         * @ref Context::drawFrame(). The state of the framebuffer binding
+         * and viewport is preserved. The atlas is meant to be drawn with
+         * @ref Context::Flag::DistanceFieldFonts enabled.
+         * @requires_gles30 Not available in OpenGL ES 2.0 or WebGL 1.0.
+         */
+        ImFont* addDistanceFieldFont(ImFontAtlas& atlas, Containers::ArrayView<const void> data, Float size, UnsignedInt radius = 4, const ImFontConfig* config = nullptr);
+        #endif
+
+    private:
+        ImFont* addFontInternal(ImFontAtlas& atlas, Containers::ArrayView<const void> data, Float size, const ImFontConfig* config, UnsignedInt loaderFlags);
+
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+}}
+
+#endif
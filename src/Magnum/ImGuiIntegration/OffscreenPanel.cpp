@@ -0,0 +1,135 @@
+/*
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "OffscreenPanel.h"
+
+#include <chrono>
+#include <Corrade/Utility/Assert.h>
+#include <Magnum/Math/Color.h>
+#include <Magnum/Math/Range.h>
+#include <Magnum/GL/Renderer.h>
+#include <Magnum/GL/TextureFormat.h>
+
+#ifdef MAGNUM_TARGET_GLES2
+#include <Magnum/ImageView.h>
+#include <Magnum/GL/PixelFormat.h>
+#endif
+
+#include "Magnum/ImGuiIntegration/Context.h"
+
+namespace Magnum { namespace ImGuiIntegration {
+
+namespace {
+
+UnsignedLong now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+}
+
+OffscreenPanel::OffscreenPanel(const Vector2i& size): _size{size}, _framebuffer{{{}, size}} {
+    _texture.setMagnificationFilter(GL::SamplerFilter::Linear)
+        .setMinificationFilter(GL::SamplerFilter::Linear)
+        .setWrapping(GL::SamplerWrapping::ClampToEdge)
+        #ifndef MAGNUM_TARGET_GLES2
+        .setStorage(1, GL::TextureFormat::RGBA8, size);
+        #else
+        .setImage(0, GL::TextureFormat::RGBA, ImageView2D{GL::PixelFormat::RGBA, GL::PixelType::UnsignedByte, size});
+        #endif
+    _framebuffer.attachTexture(GL::Framebuffer::ColorAttachment{0}, _texture, 0);
+}
+
+OffscreenPanel::OffscreenPanel(NoCreateT) noexcept: _texture{NoCreate}, _framebuffer{NoCreate} {}
+
+OffscreenPanel::OffscreenPanel(OffscreenPanel&&) noexcept = default;
+
+OffscreenPanel::~OffscreenPanel() = default;
+
+OffscreenPanel& OffscreenPanel::operator=(OffscreenPanel&&) noexcept = default;
+
+OffscreenPanel& OffscreenPanel::setUpdateRate(const Float rate) {
+    CORRADE_ASSERT(rate >= 0.0f,
+        "ImGuiIntegration::OffscreenPanel::setUpdateRate(): expected a non-negative rate, got" << rate, *this);
+    _updateRate = rate;
+    return *this;
+}
+
+OffscreenPanel& OffscreenPanel::setNeedsUpdate() {
+    _needsUpdate = true;
+    return *this;
+}
+
+bool OffscreenPanel::beginFrame(Context& context) {
+    CORRADE_ASSERT(!_inFrame,
+        "ImGuiIntegration::OffscreenPanel::beginFrame(): previous frame not ended", {});
+
+    const UnsignedLong time = now();
+    if(!_needsUpdate) {
+        if(!context.needsRedraw())
+            return false;
+        if(_updateRate > 0.0f && time - _lastUpdate < UnsignedLong(1.0e9f/_updateRate))
+            return false;
+    }
+
+    _needsUpdate = false;
+    _lastUpdate = time;
+    _inFrame = true;
+    context.newFrame();
+    return true;
+}
+
+void OffscreenPanel::endFrame(Context& context) {
+    _framebuffer.attachTexture(GL::Framebuffer::ColorAttachment{0}, _texture, 0);
+    endFrameInternal(context);
+}
+
+void OffscreenPanel::endFrame(Context& context, GL::Texture2D& target) {
+    _framebuffer.attachTexture(GL::Framebuffer::ColorAttachment{0}, target, 0);
+    endFrameInternal(context);
+}
+
+void OffscreenPanel::endFrameInternal(Context& context) {
+    CORRADE_ASSERT(_inFrame,
+        "ImGuiIntegration::OffscreenPanel::endFrame(): no frame begun", );
+    _inFrame = false;
+
+    /* Clearing is affected by the scissor rectangle, which may be left over
+       from a different framebuffer */
+    GL::Renderer::setScissor({{}, _size});
+    _framebuffer.bind();
+    #ifndef MAGNUM_TARGET_GLES2
+    _framebuffer.clearColor(0, Color4{0.0f});
+    #else
+    GL::Renderer::setClearColor(Color4{0.0f});
+    _framebuffer.clear(GL::FramebufferClear::Color);
+    #endif
+
+    context.drawFrame();
+    ++_updateCount;
+}
+
+}}
@@ -0,0 +1,227 @@
+#ifndef Magnum_ImGuiIntegration_OffscreenPanel_h
+#define Magnum_ImGuiIntegration_OffscreenPanel_h
+/*
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::ImGuiIntegration::OffscreenPanel
+ * @m_since_latest_{integration}
+ */
+
+#include <Magnum/Magnum.h>
+#include <Magnum/GL/Framebuffer.h>
+#include <Magnum/GL/Texture.h>
+
+#include "Magnum/ImGuiIntegration/visibility.h"
+
+namespace Magnum { namespace ImGuiIntegration {
+
+class Context;
+
+/**
+@brief Offscreen panel
+@m_since_latest_{integration}
+
+Renders a @ref Context into a texture instead of the default framebuffer, for
+example to display ImGui panels in a 3D scene or in VR. The panel is updated at
+most at a configured @ref updateRate(), independently of the frame rate of the
+application, and only if @ref Context::needsRedraw() says the UI changed.
+Otherwise the previously rendered texture is reused as-is.
+
+@section ImGuiIntegration-OffscreenPanel-usage Usage
+
+Create the @ref Context with its framebuffer size matching the panel size and
+wrap the UI code in @ref beginFrame() and @ref endFrame(). Events are passed
+to the @ref Context as usual, with coordinates relative to the panel. The
+@ref texture() can be then used for drawing the panel in the scene:
+
+@snippet ImGuiIntegration.cpp OffscreenPanel-usage
+
+Because @ref endFrame() binds the panel framebuffer, the application is
+expected to bind its own framebuffer again afterwards. The GL state needed by
+@ref Context::drawFrame() described in @ref ImGuiIntegration-Context-usage
+applies here as well. As the panel is cleared to a transparent color, use a
+separate blend function for the alpha channel in order to get a correct alpha
+in the resulting texture:
+
+@snippet ImGuiIntegration.cpp OffscreenPanel-blending
+
+@section ImGuiIntegration-OffscreenPanel-external Rendering into an external texture
+
+Instead of the texture owned by the panel, the UI can be rendered into an
+arbitrary @ref GL::Texture2D of the same size using
+@ref endFrame(Context&, GL::Texture2D&), for example into
+@ref OvrIntegration::TextureSwapChain::activeTexture() that's then shown
+with @ref OvrIntegration::LayerQuad. If the panel isn't updated, the swap
+chain doesn't need to be committed and the compositor keeps showing the
+previous contents:
+
+@code{.cpp}
+OvrIntegration::TextureSwapChain& swapChain = …;
+OvrIntegration::LayerQuad& layer = …;
+layer.setColorTexture(swapChain)
+    .setViewport({{}, panel.size()});
+
+if(panel.beginFrame(imgui)) {
+    ImGui::Text("Hello from VR!");
+    panel.endFrame(imgui, swapChain.activeTexture());
+    swapChain.commit();
+}
+@endcode
+
+@experimental
+*/
+class MAGNUM_IMGUIINTEGRATION_EXPORT OffscreenPanel {
+    public:
+        /**
+         * @brief Constructor
+         * @param size      Panel size in pixels
+         *
+         * Creates a RGBA8 texture of given size and a framebuffer with it
+         * attached. The update rate is unlimited by default.
+         */
+        explicit OffscreenPanel(const Vector2i& size);
+
+        /**
+         * @brief Construct without creating the underlying OpenGL objects
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         */
+        explicit OffscreenPanel(NoCreateT) noexcept;
+
+        /** @brief Copying is not allowed */
+        OffscreenPanel(const OffscreenPanel&) = delete;
+
+        /** @brief Move constructor */
+        OffscreenPanel(OffscreenPanel&&) noexcept;
+
+        /** @brief Destructor */
+        ~OffscreenPanel();
+
+        /** @brief Copying is not allowed */
+        OffscreenPanel& operator=(const OffscreenPanel&) = delete;
+
+        /** @brief Move assignment */
+        OffscreenPanel& operator=(OffscreenPanel&&) noexcept;
+
+        /** @brief Panel size */
+        Vector2i size() const { return _size; }
+
+        /** @brief Texture the panel is rendered to */
+        GL::Texture2D& texture() { return _texture; }
+
+        /** @brief Framebuffer the panel is rendered to */
+        GL::Framebuffer& framebuffer() { return _framebuffer; }
+
+        /**
+         * @brief Update rate
+         *
+         * Maximal count of updates per second. @cpp 0.0f @ce means the
+         * update rate is unlimited.
+         */
+        Float updateRate() const { return _updateRate; }
+
+        /**
+         * @brief Set update rate
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that the rate is not negative. Set to @cpp 0.0f @ce to
+         * update the panel every time @ref Context::needsRedraw() is
+         * @cpp true @ce. Default is @cpp 0.0f @ce.
+         */
+        OffscreenPanel& setUpdateRate(Float rate);
+
+        /**
+         * @brief Mark the panel for an update
+         * @return Reference to self (for method chaining)
+         *
+         * Makes the next @ref beginFrame() return @cpp true @ce regardless of
+         * @ref updateRate() and @ref Context::needsRedraw(). Useful for
+         * example when the UI depends on application state that changed.
+         */
+        OffscreenPanel& setNeedsUpdate();
+
+        /**
+         * @brief Count of updates
+         *
+         * Count of @ref endFrame() calls, i.e. how many times the panel was
+         * actually rendered.
+         */
+        UnsignedLong updateCount() const { return _updateCount; }
+
+        /**
+         * @brief Begin a panel frame
+         *
+         * If the UI changed according to @ref Context::needsRedraw() and the
+         * time since the last update is at least the inverse of
+         * @ref updateRate(), or if @ref setNeedsUpdate() was called, calls
+         * @ref Context::newFrame() and returns @cpp true @ce. In that case
+         * the application is expected to submit the UI and call
+         * @ref endFrame() afterwards. Otherwise returns @cpp false @ce and
+         * the @ref texture() keeps its previous contents.
+         */
+        bool beginFrame(Context& context);
+
+        /**
+         * @brief End a panel frame
+         *
+         * Binds the @ref framebuffer() with @ref texture() attached, clears
+         * it to a transparent color and calls @ref Context::drawFrame(). The
+         * framebuffer stays bound afterwards. Expects to be called only after
+         * @ref beginFrame() returned @cpp true @ce.
+         */
+        void endFrame(Context& context);
+
+        /**
+         * @brief End a panel frame, rendering into an external texture
+         *
+         * Like @ref endFrame(Context&), but renders into @p target instead of
+         * @ref texture(). The @p target should be at least as large as
+         * @ref size(), only the @ref size() area of it is rendered to.
+         */
+        void endFrame(Context& context, GL::Texture2D& target);
+
+    private:
+        void endFrameInternal(Context& context);
+
+        Vector2i _size;
+        GL::Texture2D _texture;
+        GL::Framebuffer _framebuffer;
+        Float _updateRate{};
+        bool _needsUpdate{true},
+            _inFrame{};
+        /* Time of the last update in nanoseconds since the steady clock
+           epoch, as a plain integer to avoid including <chrono> here */
+        UnsignedLong _lastUpdate{};
+        UnsignedLong _updateCount{};
+};
+
+}}
+
+#endif
@@ -0,0 +1,65 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "SharedResources.h"
+
+#include <imgui.h>
+#include <Corrade/Utility/Move.h>
+
+namespace Magnum { namespace ImGuiIntegration {
+
+SharedResources::SharedResources():
+    _atlas{IM_NEW(ImFontAtlas)()},
+    _shader{NoCreate},
+    _shaderCompileState{InPlaceInit, Shaders::FlatGL2D::compile(Shaders::FlatGL2D::Configuration{}
+        .setFlags(Shaders::FlatGL2D::Flag::Textured|Shaders::FlatGL2D::Flag::VertexColor))} {}
+
+SharedResources::~SharedResources() {
+    /* The textures get deleted together with this instance, mark them as
+       destroyed for ImGui */
+    for(ImTextureData* tex: _atlas->TexList) {
+        if(!tex->BackendUserData) continue;
+        tex->BackendUserData = nullptr;
+        tex->SetTexID(ImTextureID_Invalid);
+        tex->SetStatus(ImTextureStatus_Destroyed);
+    }
+
+    IM_DELETE(_atlas);
+}
+
+Shaders::FlatGL2D& SharedResources::shader() {
+    if(_shaderCompileState) {
+        _shader = Shaders::FlatGL2D{Utility::move(*_shaderCompileState)};
+        _shaderCompileState = Containers::NullOpt;
+    }
+    return _shader;
+}
+
+bool SharedResources::isShaderLinkFinished() {
+    return !_shaderCompileState || _shaderCompileState->isLinkFinished();
+}
+
+}}
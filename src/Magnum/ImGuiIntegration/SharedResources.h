@@ -0,0 +1,140 @@
+#ifndef Magnum_ImGuiIntegration_SharedResources_h
+#define Magnum_ImGuiIntegration_SharedResources_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::ImGuiIntegration::SharedResources
+ * @m_since_latest_{integration}
+ */
+
+#include "Magnum/ImGuiIntegration/Context.h"
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+struct ImFontAtlas;
+#endif
+
+namespace Magnum { namespace ImGuiIntegration {
+
+/**
+@brief Resources shared between multiple contexts
+@m_since_latest_{integration}
+
+Owns a shader and an ImGui font atlas together with its GPU textures, which
+can be then used by any number of @ref Context instances created with
+@ref Context::Context(SharedResources&, const Vector2i&). Compared to creating
+each @ref Context on its own, this means the shader is compiled only once and
+the atlas is built and uploaded only once, regardless of how many contexts
+there are. See @ref ImGuiIntegration-Context-shared-resources for an example.
+
+All contexts using the resources are expected to be used with the same GL
+context, or GL contexts sharing objects, and the instance has to outlive all
+of them. Because the contexts reference it, the instance is neither copyable
+nor movable.
+
+@experimental
+*/
+class MAGNUM_IMGUIINTEGRATION_EXPORT SharedResources {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * Starts compiling the shader and creates an empty font atlas. If no
+         * fonts are added to @ref atlas() before the first context using it
+         * draws a frame, ImGui adds its default font. The shader compilation
+         * is finished on first call to @ref shader(), see
+         * @ref ImGuiIntegration-Context-async-shader for more information.
+         */
+        explicit SharedResources();
+
+        /** @brief Copying is not allowed */
+        SharedResources(const SharedResources&) = delete;
+
+        /** @brief Moving is not allowed */
+        SharedResources(SharedResources&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Deletes the atlas textures, marks them as destroyed for ImGui and
+         * deletes the font atlas.
+         */
+        ~SharedResources();
+
+        /** @brief Copying is not allowed */
+        SharedResources& operator=(const SharedResources&) = delete;
+
+        /** @brief Moving is not allowed */
+        SharedResources& operator=(SharedResources&&) = delete;
+
+        /**
+         * @brief Font atlas
+         *
+         * Add custom fonts here before creating the contexts, or call
+         * @ref Context::relayout() on each of them afterwards.
+         */
+        ImFontAtlas& atlas() { return *_atlas; }
+
+        /**
+         * @brief Shader used for drawing
+         *
+         * If the shader compilation isn't finished yet, waits for it.
+         * @see @ref isShaderLinkFinished()
+         */
+        Shaders::FlatGL2D& shader();
+
+        /**
+         * @brief Whether the shader is linked
+         *
+         * Returns @cpp false @ce if the driver is still compiling or linking
+         * the shader in the background, in which case @ref shader() and
+         * @ref Context::drawFrame() on any context using these resources will
+         * wait for it to finish.
+         */
+        bool isShaderLinkFinished();
+
+        /**
+         * @brief Memory used by the atlas textures
+         *
+         * Same as @ref Context::textureMemory() called on any context using
+         * these resources.
+         */
+        std::size_t textureMemory() const {
+            return _textureStorage.memory + _textureStorage.poolMemory;
+        }
+
+    private:
+        friend Context;
+
+        ImFontAtlas* _atlas;
+        Shaders::FlatGL2D _shader;
+        Containers::Optional<Shaders::FlatGL2D::CompileState> _shaderCompileState;
+        Implementation::ImGuiTextureStorage _textureStorage;
+};
+
+}}
+
+#endif
@@ -0,0 +1,276 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/* Explicitly disable deprecated functions on non-deprecated builds to catch
+   issues early. Doing this only in tests so the library itself can be used
+   with any newer version, but tests should be always run against the oldest
+   supported which is mentioned in doc/namespaces.dox, and which is downloaded
+   in all CI targets in package/ci/. The oldest supported version is tracked to
+   be roughly two years back. */
+#ifndef MAGNUM_BUILD_DEPRECATED
+#define IMGUI_DISABLE_OBSOLETE_FUNCTIONS
+#endif
+
+#include <cstdio>
+#include <imgui.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/String.h>
+#include <Corrade/Utility/Format.h>
+#include <Magnum/GL/Context.h>
+#include <Magnum/GL/Extensions.h>
+#include <Magnum/GL/Framebuffer.h>
+#include <Magnum/GL/OpenGLTester.h>
+#include <Magnum/GL/Renderbuffer.h>
+#include <Magnum/GL/RenderbufferFormat.h>
+#ifndef MAGNUM_TARGET_WEBGL
+#include <Magnum/GL/TimeQuery.h>
+#endif
+
+#include "Magnum/ImGuiIntegration/Context.h"
+
+namespace Magnum { namespace ImGuiIntegration { namespace Test { namespace {
+
+struct ContextGLBenchmark: GL::OpenGLTester {
+    explicit ContextGLBenchmark();
+
+    void setup();
+    void teardown();
+
+    void newFrame();
+    void drawFrame();
+    #ifndef MAGNUM_TARGET_WEBGL
+    void drawFrameGpu();
+
+    void timeQueryBegin();
+    std::uint64_t timeQueryEnd();
+    #endif
+
+    private:
+        void buildUi();
+
+        GL::Renderbuffer _color{NoCreate};
+        GL::Framebuffer _framebuffer{NoCreate};
+        Containers::Optional<Context> _context;
+        #ifndef MAGNUM_TARGET_WEBGL
+        GL::TimeQuery _timeQuery{NoCreate};
+        #endif
+        /* Incremented on every built frame, used to get a different font size
+           in the atlas growth case */
+        UnsignedInt _frame{};
+};
+
+constexpr Vector2i Size{1024, 1024};
+
+void uiTextLines(UnsignedInt) {
+    /* Drawn directly into a draw list to not have them culled by a window
+       clip rect */
+    ImDrawList* drawList = ImGui::GetForegroundDrawList();
+    const Float lineHeight = ImGui::GetTextLineHeight();
+    const Int rows = Int(Size.y()/lineHeight);
+    char text[32];
+    for(Int i = 0; i != 10000; ++i) {
+        std::snprintf(text, sizeof(text), "Line %d of the text", i);
+        drawList->AddText({(i/rows)%8*Size.x()/8.0f, i%rows*lineHeight},
+            IM_COL32_WHITE, text);
+    }
+}
+
+void uiTable(UnsignedInt) {
+    ImGui::SetNextWindowPos({0.0f, 0.0f});
+    ImGui::SetNextWindowSize({Float(Size.x()), Float(Size.y())});
+    ImGui::Begin("Table");
+    /* Each column is a separate clip rect, which means a lot of draw
+       commands unless they get merged */
+    if(ImGui::BeginTable("table", 16, ImGuiTableFlags_Borders|ImGuiTableFlags_RowBg|ImGuiTableFlags_Resizable)) {
+        for(Int row = 0; row != 500; ++row) {
+            ImGui::TableNextRow();
+            for(Int column = 0; column != 16; ++column) {
+                ImGui::TableSetColumnIndex(column);
+                ImGui::Text("%d:%d", row, column);
+            }
+        }
+        ImGui::EndTable();
+    }
+    ImGui::End();
+}
+
+void uiWindows(UnsignedInt) {
+    char title[32];
+    for(Int i = 0; i != 100; ++i) {
+        std::snprintf(title, sizeof(title), "Window %d", i);
+        ImGui::SetNextWindowPos({i%10*Size.x()/10.0f, i/10*Size.y()/10.0f});
+        ImGui::SetNextWindowSize({Size.x()/10.0f, Size.y()/10.0f});
+        ImGui::Begin(title);
+        ImGui::Text("Hello");
+        ImGui::Button("Button");
+        ImGui::End();
+    }
+}
+
+void uiAtlasGrowth(UnsignedInt frame) {
+    /* A font size not used before, causing new glyphs to be rasterized and
+       the atlas texture to be updated and eventually grown */
+    ImGui::PushFont(nullptr, 8.0f + (frame % 512)*0.25f);
+    ImGui::SetNextWindowPos({0.0f, 0.0f});
+    ImGui::Begin("Atlas");
+    ImGui::TextUnformatted("The quick brown fox jumps over the lazy dog 0123456789");
+    ImGui::End();
+    ImGui::PopFont();
+}
+
+const struct {
+    const char* name;
+    void(*ui)(UnsignedInt);
+} UiData[]{
+    {"10k text lines", uiTextLines},
+    {"large table", uiTable},
+    {"100 windows", uiWindows},
+    {"atlas growth", uiAtlasGrowth},
+};
+
+const struct {
+    const char* name;
+    Context::Flags flags;
+} FlagData[]{
+    {"", {}},
+    {"multi-draw", Context::Flag::MultiDraw},
+    {"retained buffers", Context::Flag::RetainedBuffers},
+    #ifndef MAGNUM_TARGET_GLES2
+    {"shader clipping", Context::Flag::ShaderClipping},
+    #endif
+};
+
+constexpr std::size_t InstanceCount = Containers::arraySize(UiData)*Containers::arraySize(FlagData);
+
+ContextGLBenchmark::ContextGLBenchmark() {
+    addInstancedBenchmarks({&ContextGLBenchmark::newFrame,
+                            &ContextGLBenchmark::drawFrame}, 50, InstanceCount,
+        &ContextGLBenchmark::setup,
+        &ContextGLBenchmark::teardown);
+
+    #ifndef MAGNUM_TARGET_WEBGL
+    addCustomInstancedBenchmarks({&ContextGLBenchmark::drawFrameGpu}, 50, InstanceCount,
+        &ContextGLBenchmark::setup,
+        &ContextGLBenchmark::teardown,
+        &ContextGLBenchmark::timeQueryBegin,
+        &ContextGLBenchmark::timeQueryEnd,
+        BenchmarkUnits::Nanoseconds);
+    #endif
+}
+
+void ContextGLBenchmark::buildUi() {
+    UiData[testCaseInstanceId() % Containers::arraySize(UiData)].ui(_frame++);
+}
+
+void ContextGLBenchmark::setup() {
+    const auto& ui = UiData[testCaseInstanceId() % Containers::arraySize(UiData)];
+    const auto& flags = FlagData[testCaseInstanceId() / Containers::arraySize(UiData)];
+    setTestCaseDescription(*flags.name ?
+        Utility::format("{}, {}", ui.name, flags.name) :
+        Containers::String{ui.name});
+
+    _color = GL::Renderbuffer{};
+    _color.setStorage(
+        #if !defined(MAGNUM_TARGET_GLES2) || !defined(MAGNUM_TARGET_WEBGL)
+        GL::RenderbufferFormat::RGBA8,
+        #else
+        GL::RenderbufferFormat::RGBA4,
+        #endif
+        Size);
+    _framebuffer = GL::Framebuffer{{{}, Size}};
+    _framebuffer
+        .attachRenderbuffer(GL::Framebuffer::ColorAttachment{0}, _color)
+        .bind();
+
+    _context.emplace(Vector2{Size}, Size, Size);
+    _context->setFlags(flags.flags);
+
+    /* ImGui doesn't draw anything the first frame, the second frame then
+       creates all buffers and uploads glyphs needed by the UI. The measured
+       frames are then in a steady state, except for the atlas growth
+       case. */
+    for(Int i = 0; i != 2; ++i) {
+        _context->newFrame();
+        buildUi();
+        _context->drawFrame();
+    }
+}
+
+void ContextGLBenchmark::teardown() {
+    _context = Containers::NullOpt;
+    _framebuffer = GL::Framebuffer{NoCreate};
+    _color = GL::Renderbuffer{NoCreate};
+}
+
+#ifndef MAGNUM_TARGET_WEBGL
+void ContextGLBenchmark::timeQueryBegin() {
+    _timeQuery = GL::TimeQuery{GL::TimeQuery::Target::TimeElapsed};
+    _timeQuery.begin();
+}
+
+std::uint64_t ContextGLBenchmark::timeQueryEnd() {
+    _timeQuery.end();
+    return _timeQuery.result<UnsignedLong>();
+}
+#endif
+
+void ContextGLBenchmark::newFrame() {
+    CORRADE_BENCHMARK(1)
+        _context->newFrame();
+
+    buildUi();
+    _context->drawFrame();
+}
+
+void ContextGLBenchmark::drawFrame() {
+    _context->newFrame();
+    buildUi();
+
+    CORRADE_BENCHMARK(1)
+        _context->drawFrame();
+}
+
+#ifndef MAGNUM_TARGET_WEBGL
+void ContextGLBenchmark::drawFrameGpu() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::timer_query>())
+        CORRADE_SKIP(GL::Extensions::ARB::timer_query::string() << "is not supported.");
+    #else
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::disjoint_timer_query>())
+        CORRADE_SKIP(GL::Extensions::EXT::disjoint_timer_query::string() << "is not supported.");
+    #endif
+
+    _context->newFrame();
+    buildUi();
+
+    CORRADE_BENCHMARK(1)
+        _context->drawFrame();
+}
+#endif
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::ImGuiIntegration::Test::ContextGLBenchmark)
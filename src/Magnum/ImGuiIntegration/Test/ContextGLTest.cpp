@@ -37,19 +37,28 @@
 #endif
 
 #include <limits>
+#include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Containers/String.h>
 #include <Corrade/PluginManager/Manager.h>
 #include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/Format.h>
 #include <Corrade/Utility/System.h>
 #include <Corrade/Utility/Path.h>
 #include <Magnum/Magnum.h>
 #include <Magnum/DebugTools/CompareImage.h>
+#include <Magnum/GL/Context.h>
+#include <Magnum/GL/Extensions.h>
 #include <Magnum/GL/Framebuffer.h>
 #include <Magnum/GL/Renderbuffer.h>
 #include <Magnum/GL/RenderbufferFormat.h>
+#include <Magnum/GL/OpenGL.h>
 #include <Magnum/GL/OpenGLTester.h>
 #include <Magnum/GL/Texture.h>
+#ifndef MAGNUM_TARGET_GLES2
+#include <Magnum/GL/TextureArray.h>
+#endif
 #include <Magnum/GL/TextureFormat.h>
 #include <Magnum/Math/Color.h>
 #include <Magnum/Math/Vector3.h>
@@ -60,6 +69,7 @@
 #include <Magnum/PixelFormat.h>
 
 #include "Magnum/ImGuiIntegration/Context.hpp"
+#include "Magnum/ImGuiIntegration/SharedResources.h"
 #include "Magnum/ImGuiIntegration/Widgets.h"
 
 #include "configure.h"
@@ -262,12 +272,14 @@ struct ContextGLTest: GL::OpenGLTester {
 
     void pointerInput();
     void pointerInputTooFast();
+    void pointerInputCoalesced();
     void scrollInput();
     #ifdef MAGNUM_BUILD_DEPRECATED
     void mouseInput();
     void mouseInputTooFast();
     #endif
     void keyInput();
+    void needsRedraw();
     void textInput();
     void updateCursor();
 
@@ -276,6 +288,13 @@ struct ContextGLTest: GL::OpenGLTester {
     void clipboardOwnedString();
 
     void multipleContexts();
+    void shaderCompilation();
+    void sharedResources();
+
+    void textureMemory();
+
+    void registerTexture();
+    void registerTextureInvalid();
 
     void drawSetup();
     void drawTeardown();
@@ -286,6 +305,17 @@ struct ContextGLTest: GL::OpenGLTester {
     void drawScissor();
     void drawVertexOffset();
     void drawIndexOffset();
+    void drawMultipleDrawLists();
+    void drawPersistentMappedBuffers();
+    void drawRedundantStateChanges();
+    void drawMultiDraw();
+    void drawAsyncTextureUploads();
+    void drawTextureUpdates();
+    void drawFrameStatistics();
+    void drawRetainedBuffers();
+    void drawShaderClipping();
+    void drawDistanceFieldFonts();
+    void drawRegisteredTexture();
 
     private:
         PluginManager::Manager<Trade::AbstractImporter> _manager;
@@ -314,12 +344,14 @@ ContextGLTest::ContextGLTest() {
 
               &ContextGLTest::pointerInput,
               &ContextGLTest::pointerInputTooFast,
+              &ContextGLTest::pointerInputCoalesced,
               &ContextGLTest::scrollInput,
               #ifdef MAGNUM_BUILD_DEPRECATED
               &ContextGLTest::mouseInput,
               &ContextGLTest::mouseInputTooFast,
               #endif
               &ContextGLTest::keyInput,
+              &ContextGLTest::needsRedraw,
               &ContextGLTest::textInput,
               &ContextGLTest::updateCursor,
 
@@ -327,14 +359,32 @@ ContextGLTest::ContextGLTest() {
               &ContextGLTest::clipboard,
               &ContextGLTest::clipboardOwnedString,
 
-              &ContextGLTest::multipleContexts});
+              &ContextGLTest::multipleContexts,
+              &ContextGLTest::shaderCompilation,
+              &ContextGLTest::sharedResources,
+
+              &ContextGLTest::textureMemory,
+
+              &ContextGLTest::registerTexture,
+              &ContextGLTest::registerTextureInvalid});
 
     addTests({&ContextGLTest::draw,
               &ContextGLTest::drawCallback,
               &ContextGLTest::drawTexture,
               &ContextGLTest::drawScissor,
               &ContextGLTest::drawVertexOffset,
-              &ContextGLTest::drawIndexOffset},
+              &ContextGLTest::drawIndexOffset,
+              &ContextGLTest::drawMultipleDrawLists,
+              &ContextGLTest::drawPersistentMappedBuffers,
+              &ContextGLTest::drawRedundantStateChanges,
+              &ContextGLTest::drawMultiDraw,
+              &ContextGLTest::drawAsyncTextureUploads,
+              &ContextGLTest::drawTextureUpdates,
+              &ContextGLTest::drawFrameStatistics,
+              &ContextGLTest::drawRetainedBuffers,
+              &ContextGLTest::drawShaderClipping,
+              &ContextGLTest::drawDistanceFieldFonts,
+              &ContextGLTest::drawRegisteredTexture},
         &ContextGLTest::drawSetup,
         &ContextGLTest::drawTeardown);
 
@@ -904,6 +954,53 @@ void ContextGLTest::pointerInputTooFast() {
     c.drawFrame();
 }
 
+void ContextGLTest::pointerInputCoalesced() {
+    Context c{{200, 200}};
+    c.setFlags(Context::Flag::CoalescePointerMoveEvents);
+    c.newFrame();
+    c.drawFrame();
+
+    /* Plain moves only remember the position, not even touching the current
+       context */
+    PointerMoveEvent move1{PointerEventSource::Mouse, {}, {}, {1.5f, 2.5f}, {}};
+    PointerMoveEvent move2{PointerEventSource::Mouse, {}, {}, {3.5f, 4.5f}, {}};
+    PointerMoveEvent move3{PointerEventSource::Mouse, {}, {}, {5.5f, 6.5f}, {}};
+    ImGui::SetCurrentContext(nullptr);
+    CORRADE_VERIFY(!c.handlePointerMoveEvent(move1));
+    CORRADE_VERIFY(!c.handlePointerMoveEvent(move2));
+    CORRADE_VERIFY(!c.handlePointerMoveEvent(move3));
+    CORRADE_COMPARE(ImGui::GetCurrentContext(), nullptr);
+
+    /* Only the last one is submitted in the next frame */
+    Utility::System::sleep(1);
+    c.newFrame();
+    /* ImGui floors the positions internally, so the fraction gets lost */
+    CORRADE_COMPARE(Vector2(ImGui::GetMousePos()), (Vector2{5.0f, 6.0f}));
+    c.drawFrame();
+
+    /* A pending move gets submitted before a press, preserving the order */
+    PointerMoveEvent move4{PointerEventSource::Mouse, {}, {}, {7.5f, 8.5f}, {}};
+    PointerEvent press{PointerEventSource::Mouse, Pointer::MouseLeft, {9.5f, 10.5f}, {}};
+    c.handlePointerMoveEvent(move4);
+    c.handlePointerPressEvent(press);
+    Utility::System::sleep(1);
+    c.newFrame();
+    CORRADE_VERIFY(ImGui::IsMouseDown(ImGuiMouseButton_Left));
+    CORRADE_COMPARE(Vector2(ImGui::GetMousePos()), (Vector2{9.0f, 10.0f}));
+    c.drawFrame();
+
+    /* Moves that change the set of pressed buttons aren't coalesced */
+    PointerMoveEvent moveRelease{PointerEventSource::Mouse, Pointer::MouseLeft, {}, {11.5f, 12.5f}, {}};
+    ImGui::SetCurrentContext(nullptr);
+    c.handlePointerMoveEvent(moveRelease);
+    CORRADE_COMPARE(ImGui::GetCurrentContext(), c.context());
+    Utility::System::sleep(1);
+    c.newFrame();
+    CORRADE_VERIFY(!ImGui::IsMouseDown(ImGuiMouseButton_Left));
+    CORRADE_COMPARE(Vector2(ImGui::GetMousePos()), (Vector2{11.0f, 12.0f}));
+    c.drawFrame();
+}
+
 void ContextGLTest::scrollInput() {
     Context c{{200, 200}};
 
@@ -1055,6 +1152,40 @@ void ContextGLTest::mouseInputTooFast() {
 }
 #endif
 
+void ContextGLTest::needsRedraw() {
+    Context c{{200, 200}};
+
+    /* A fresh context needs to be drawn */
+    CORRADE_VERIFY(c.needsRedraw());
+
+    /* After a few frames, the font atlas is uploaded and there's nothing
+       else to do */
+    std::size_t frames = 0;
+    for(; frames != 10 && c.needsRedraw(); ++frames) {
+        c.newFrame();
+        c.drawFrame();
+    }
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(!c.needsRedraw());
+    CORRADE_COMPARE_AS(frames, 10, TestSuite::Compare::Less);
+
+    /* An input event makes it need a redraw again */
+    KeyEvent keyTab{KeyEvent::Key::Tab, {}};
+    c.handleKeyPressEvent(keyTab);
+    CORRADE_VERIFY(c.needsRedraw());
+
+    /* Which goes away after a few frames again */
+    for(frames = 0; frames != 10 && c.needsRedraw(); ++frames) {
+        c.newFrame();
+        c.drawFrame();
+    }
+    CORRADE_VERIFY(!c.needsRedraw());
+
+    /* Relayout as well */
+    c.relayout({300, 300});
+    CORRADE_VERIFY(c.needsRedraw());
+}
+
 void ContextGLTest::keyInput() {
     Context c{{}};
 
@@ -1318,6 +1449,83 @@ void ContextGLTest::drawTeardown() {
     _color = GL::Renderbuffer{NoCreate};
 }
 
+void ContextGLTest::shaderCompilation() {
+    Context c{{200, 200}};
+
+    /* Depending on the driver, the shader may or may not be linked already */
+    CORRADE_INFO("Shader linked right after construction:" << c.isShaderLinkFinished());
+
+    /* The first frame waits for the compilation to finish */
+    c.newFrame();
+    c.drawFrame();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(c.isShaderLinkFinished());
+}
+
+void ContextGLTest::sharedResources() {
+    SharedResources resources;
+    CORRADE_COMPARE(resources.textureMemory(), 0);
+
+    Containers::Optional<Context> a{InPlaceInit, resources, Vector2i{200, 200}};
+    Context b{resources, {100, 100}};
+    CORRADE_COMPARE(a->sharedResources(), &resources);
+    CORRADE_COMPARE(b.sharedResources(), &resources);
+
+    /* Both use the same atlas */
+    ImGui::SetCurrentContext(a->context());
+    CORRADE_COMPARE(ImGui::GetIO().Fonts, &resources.atlas());
+    ImGui::SetCurrentContext(b.context());
+    CORRADE_COMPARE(ImGui::GetIO().Fonts, &resources.atlas());
+
+    /* The atlas gets uploaded only by the first context that draws */
+    a->newFrame();
+    a->drawFrame();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(resources.isShaderLinkFinished());
+    CORRADE_VERIFY(b.isShaderLinkFinished());
+    ImTextureData* atlas = resources.atlas().TexData;
+    CORRADE_VERIFY(atlas);
+    const std::size_t atlasSize = atlas->Width*atlas->Height*4;
+    CORRADE_COMPARE(resources.textureMemory(), atlasSize);
+    CORRADE_COMPARE(a->textureMemory(), atlasSize);
+    CORRADE_COMPARE(b.textureMemory(), atlasSize);
+
+    b.newFrame();
+    b.drawFrame();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(b.frameStatistics().textureUploadSize, 0);
+    CORRADE_COMPARE(resources.textureMemory(), atlasSize);
+
+    /* Destroying one context keeps the textures for the other */
+    a = Containers::NullOpt;
+    CORRADE_COMPARE(atlas->Status, ImTextureStatus_OK);
+    b.newFrame();
+    b.drawFrame();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(b.frameStatistics().textureUploadSize, 0);
+    CORRADE_COMPARE(resources.textureMemory(), atlasSize);
+}
+
+void ContextGLTest::textureMemory() {
+    Context c{{200, 200}};
+    CORRADE_COMPARE(c.textureMemory(), 0);
+    CORRADE_COMPARE(c.texturePoolMemory(), 0);
+    CORRADE_COMPARE(c.texturePoolCapacity(), 16*1024*1024);
+
+    /* The font atlas gets created in the first frame */
+    c.newFrame();
+    c.drawFrame();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    ImTextureData* atlas = ImGui::GetIO().Fonts->TexData;
+    CORRADE_VERIFY(atlas);
+    CORRADE_COMPARE(c.textureMemory(), std::size_t(atlas->Width*atlas->Height*4));
+    CORRADE_COMPARE(c.texturePoolMemory(), 0);
+
+    c.setTexturePoolCapacity(0);
+    CORRADE_COMPARE(c.texturePoolCapacity(), 0);
+}
+
 void ContextGLTest::draw() {
     Context c{{200, 200}, {70, 70}, _framebuffer.viewport().size()};
 
@@ -1631,6 +1839,686 @@ void ContextGLTest::drawIndexOffset() {
         (DebugTools::CompareImage{1.0f, 0.5f}));
 }
 
+void ContextGLTest::drawMultipleDrawLists() {
+    Context c{{200, 200}, {70, 70}, _framebuffer.viewport().size()};
+
+    /* ImGui doesn't draw anything the first frame */
+    c.newFrame();
+    c.drawFrame();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    Utility::System::sleep(1);
+
+    c.newFrame();
+
+    /* With base vertex support, all draw lists get uploaded into a single
+       buffer and drawn from there. The background one gets rendered first,
+       the foreground one last, each has to use its own vertex and index
+       offset. */
+    ImDrawList* backgroundDrawList = ImGui::GetBackgroundDrawList();
+    ImDrawList* foregroundDrawList = ImGui::GetForegroundDrawList();
+    const ImVec2& size = ImGui::GetIO().DisplaySize;
+
+    backgroundDrawList->AddRectFilled({0.0f, 0.0f}, size, IM_COL32(0, 0, 255, 255));
+    /* Force the creation of a new draw command */
+    backgroundDrawList->AddDrawCmd();
+    backgroundDrawList->AddRectFilled({0.0f, 0.0f}, size, IM_COL32(255, 0, 0, 255));
+    foregroundDrawList->AddRectFilled({0.0f, 0.0f}, {size.x*0.5f, size.y}, IM_COL32(0, 255, 0, 255));
+
+    c.drawFrame();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    const Vector2i framebufferSize = _framebuffer.viewport().size();
+    Containers::Array<Color4ub> pixels{NoInit, size_t(framebufferSize.product())};
+    for(Int y = 0; y != framebufferSize.y(); ++y)
+        for(Int x = 0; x != framebufferSize.x(); ++x)
+            pixels[y*framebufferSize.x() + x] = x < framebufferSize.x()/2 ?
+                Color4ub{0, 255, 0, 255} : Color4ub{255, 0, 0, 255};
+
+    CORRADE_COMPARE_WITH(
+        _framebuffer.read(_framebuffer.viewport(), {PixelFormat::RGBA8Unorm}),
+        (ImageView2D{PixelFormat::RGBA8Unorm, framebufferSize, pixels}),
+        (DebugTools::CompareImage{1.0f, 0.5f}));
+}
+
+void ContextGLTest::drawPersistentMappedBuffers() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::buffer_storage>())
+        CORRADE_SKIP(GL::Extensions::ARB::buffer_storage::string() << "is not supported.");
+
+    Context c{{200, 200}, {70, 70}, _framebuffer.viewport().size()};
+    if(!(ImGui::GetIO().BackendFlags & ImGuiBackendFlags_RendererHasVtxOffset))
+        CORRADE_SKIP("Vertex offset not supported");
+
+    c.setFlags(Context::Flag::PersistentMappedBuffers);
+    CORRADE_COMPARE(c.flags(), Context::Flag::PersistentMappedBuffers);
+
+    /* ImGui doesn't draw anything the first frame */
+    c.newFrame();
+    c.drawFrame();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* Draw more frames than there is ring buffer segments to verify the
+       wraparound, with a bigger mesh in the middle to trigger a reallocation.
+       The last one is expected to be in the output. */
+    const ImU32 colors[]{
+        IM_COL32(255, 0, 0, 255),
+        IM_COL32(0, 0, 255, 255),
+        IM_COL32(255, 255, 0, 255),
+        IM_COL32(0, 255, 255, 255),
+        IM_COL32(0, 255, 0, 255)
+    };
+    for(std::size_t i = 0; i != Containers::arraySize(colors); ++i) {
+        CORRADE_ITERATION(i);
+        Utility::System::sleep(1);
+
+        c.newFrame();
+
+        ImDrawList* drawList = ImGui::GetForegroundDrawList();
+        const ImVec2& size = ImGui::GetIO().DisplaySize;
+        for(std::size_t j = 0, jMax = i == 2 ? 5000 : 1; j != jMax; ++j)
+            drawList->AddRectFilled({0.0f, 0.0f}, size, colors[i]);
+
+        c.drawFrame();
+
+        MAGNUM_VERIFY_NO_GL_ERROR();
+    }
+
+    Containers::Array<Color4ub> pixels{NoInit, size_t(_framebuffer.viewport().size().product())};
+    for(Color4ub& p: pixels)
+        p = Color4ub{0, 255, 0, 255};
+
+    CORRADE_COMPARE_WITH(
+        _framebuffer.read(_framebuffer.viewport(), {PixelFormat::RGBA8Unorm}),
+        (ImageView2D{PixelFormat::RGBA8Unorm, _framebuffer.viewport().size(), pixels}),
+        (DebugTools::CompareImage{1.0f, 0.5f}));
+
+    /* Clearing the flag goes back to regular buffers */
+    c.setFlags({});
+    c.newFrame();
+    c.drawFrame();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    #else
+    CORRADE_SKIP("Persistently mapped buffers are not available in OpenGL ES or WebGL.");
+    #endif
+}
+
+void ContextGLTest::drawRedundantStateChanges() {
+    Context c{{200, 200}, {70, 70}, _framebuffer.viewport().size()};
+
+    /* ImGui doesn't draw anything the first frame */
+    c.newFrame();
+    c.drawFrame();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    Utility::System::sleep(1);
+
+    c.newFrame();
+
+    /* Last drawlist that gets rendered, covers the entire display */
+    ImDrawList* drawList = ImGui::GetForegroundDrawList();
+    const ImVec2& size = ImGui::GetIO().DisplaySize;
+
+    /* Three commands with the same texture and clip rect, differing only in
+       the index offset */
+    drawList->AddRectFilled({0.0f, 0.0f}, size, IM_COL32(255, 0, 0, 255));
+    drawList->AddDrawCmd();
+    drawList->AddRectFilled({0.0f, 0.0f}, size, IM_COL32(0, 0, 255, 255));
+    drawList->AddDrawCmd();
+    drawList->AddRectFilled({0.0f, 0.0f}, size, IM_COL32(0, 255, 0, 255));
+    CORRADE_COMPARE(drawList->CmdBuffer.Size, 3);
+
+    c.drawFrame();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* The first command sets everything, the other two only the index
+       buffer offset */
+    CORRADE_COMPARE(c.stateChangeStatistics().issued, 5);
+    CORRADE_COMPARE(c.stateChangeStatistics().skipped, 4);
+
+    Containers::Array<Color4ub> pixels{NoInit, size_t(_framebuffer.viewport().size().product())};
+    for(Color4ub& p: pixels)
+        p = Color4ub{0, 255, 0, 255};
+
+    CORRADE_COMPARE_WITH(
+        _framebuffer.read(_framebuffer.viewport(), {PixelFormat::RGBA8Unorm}),
+        (ImageView2D{PixelFormat::RGBA8Unorm, _framebuffer.viewport().size(), pixels}),
+        (DebugTools::CompareImage{1.0f, 0.5f}));
+}
+
+void ContextGLTest::drawMultiDraw() {
+    Context c{{200, 200}, {70, 70}, _framebuffer.viewport().size()};
+    c.setFlags(Context::Flag::MultiDraw);
+
+    /* ImGui doesn't draw anything the first frame */
+    c.newFrame();
+    c.drawFrame();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    Utility::System::sleep(1);
+
+    c.newFrame();
+
+    /* Last drawlist that gets rendered, covers the entire display */
+    ImDrawList* drawList = ImGui::GetForegroundDrawList();
+    const ImVec2& size = ImGui::GetIO().DisplaySize;
+
+    /* The first two commands share the same state and get drawn together,
+       the third has a different clip rect */
+    drawList->AddRectFilled({0.0f, 0.0f}, size, IM_COL32(255, 0, 0, 255));
+    drawList->AddDrawCmd();
+    drawList->AddRectFilled({0.0f, 0.0f}, size, IM_COL32(0, 255, 0, 255));
+    drawList->PushClipRect({0.0f, 0.0f}, {size.x*0.5f, size.y});
+    drawList->AddRectFilled({0.0f, 0.0f}, size, IM_COL32(0, 0, 255, 255));
+    CORRADE_COMPARE(drawList->CmdBuffer.Size, 3);
+
+    c.drawFrame();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* Index buffer offsets are not counted in the multi-draw mode */
+    CORRADE_COMPARE(c.stateChangeStatistics().issued, 3);
+    CORRADE_COMPARE(c.stateChangeStatistics().skipped, 3);
+
+    const Vector2i framebufferSize = _framebuffer.viewport().size();
+    Containers::Array<Color4ub> pixels{NoInit, size_t(framebufferSize.product())};
+    for(Int y = 0; y != framebufferSize.y(); ++y)
+        for(Int x = 0; x != framebufferSize.x(); ++x)
+            pixels[y*framebufferSize.x() + x] = x < framebufferSize.x()/2 ?
+                Color4ub{0, 0, 255, 255} : Color4ub{0, 255, 0, 255};
+
+    CORRADE_COMPARE_WITH(
+        _framebuffer.read(_framebuffer.viewport(), {PixelFormat::RGBA8Unorm}),
+        (ImageView2D{PixelFormat::RGBA8Unorm, framebufferSize, pixels}),
+        (DebugTools::CompareImage{1.0f, 0.5f}));
+}
+
+void ContextGLTest::drawAsyncTextureUploads() {
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    Context c{{200, 200}, {70, 70}, _framebuffer.viewport().size()};
+    c.setFlags(Context::Flag::AsyncTextureUploads);
+
+    /* ImGui doesn't draw anything the first frame, but it creates the font
+       atlas, which is now uploaded through a staging buffer */
+    c.newFrame();
+    c.drawFrame();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    Utility::System::sleep(1);
+
+    c.newFrame();
+
+    /* Last drawlist that gets rendered, covers the entire display. The rect
+       samples the white pixel of the font atlas, if the upload didn't
+       happen, it'd be black. */
+    ImDrawList* drawList = ImGui::GetForegroundDrawList();
+    const ImVec2& size = ImGui::GetIO().DisplaySize;
+    drawList->AddRectFilled({0.0f, 0.0f}, size, IM_COL32(0, 255, 0, 255));
+
+    c.drawFrame();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    Containers::Array<Color4ub> pixels{NoInit, size_t(_framebuffer.viewport().size().product())};
+    for(Color4ub& p: pixels)
+        p = Color4ub{0, 255, 0, 255};
+
+    CORRADE_COMPARE_WITH(
+        _framebuffer.read(_framebuffer.viewport(), {PixelFormat::RGBA8Unorm}),
+        (ImageView2D{PixelFormat::RGBA8Unorm, _framebuffer.viewport().size(), pixels}),
+        (DebugTools::CompareImage{1.0f, 0.5f}));
+
+    /* After the read the GPU is surely done, so the staging buffers should
+       get released in the next frame */
+    c.newFrame();
+    c.drawFrame();
+    CORRADE_COMPARE(c.pendingTextureUploadCount(), 0);
+    #else
+    CORRADE_SKIP("Asynchronous texture uploads are not available in OpenGL ES 2.0 or WebGL.");
+    #endif
+}
+
+void ContextGLTest::drawTextureUpdates() {
+    Context c{{200, 200}, {70, 70}, _framebuffer.viewport().size()};
+
+    /* ImGui doesn't draw anything the first frame, but it creates the font
+       atlas */
+    c.newFrame();
+    c.drawFrame();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    ImTextureData* atlas = ImGui::GetIO().Fonts->TexData;
+    CORRADE_VERIFY(atlas);
+    CORRADE_COMPARE(atlas->Status, ImTextureStatus_OK);
+    CORRADE_COMPARE_AS(atlas->Width, 18, TestSuite::Compare::GreaterOrEqual);
+    CORRADE_COMPARE_AS(atlas->Height, 10, TestSuite::Compare::GreaterOrEqual);
+    const Vector2i atlasSize{atlas->Width, atlas->Height};
+    const Containers::StridedArrayView2D<Color4ub> atlasPixels{
+        {reinterpret_cast<Color4ub*>(atlas->GetPixels()), std::size_t(atlasSize.product())},
+        {std::size_t(atlasSize.y()), std::size_t(atlasSize.x())}};
+
+    /* Updates in the atlas are cleared in newFrame(), so they have to be
+       queued after */
+    c.newFrame();
+
+    /* The first two rectangles overlap, the third one is adjacent to the
+       union of the first two and the last one is disjoint from all. The
+       texel in between isn't in any rectangle, so it shouldn't get uploaded
+       even though it's changed in the atlas as well. */
+    const ImTextureRect rects[]{
+        {0, 0, 4, 4},
+        {2, 0, 4, 4},
+        {6, 0, 2, 4},
+        {16, 8, 2, 2}
+    };
+    const Color4ub notUploaded = atlasPixels[0][10];
+    atlasPixels[0][10] = notUploaded + Color4ub{1, 1, 1, 1};
+    for(const ImTextureRect& rect: rects) {
+        for(std::size_t y = rect.y; y != std::size_t(rect.y + rect.h); ++y)
+            for(std::size_t x = rect.x; x != std::size_t(rect.x + rect.w); ++x)
+                atlasPixels[y][x] = Color4ub{UnsignedByte(x*13), UnsignedByte(y*29), 0x55, 0xff};
+        atlas->Updates.push_back(rect);
+    }
+    atlas->SetStatus(ImTextureStatus_WantUpdates);
+
+    c.drawFrame();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(atlas->Status, ImTextureStatus_OK);
+
+    /* The first three get merged to a 8x4 rectangle, the last stays
+       separate */
+    CORRADE_COMPARE(c.frameStatistics().textureUploadSize, std::size_t((8*4 + 2*2)*4));
+
+    /* Read the texture back through a framebuffer, as that works on ES as
+       well */
+    GL::Texture2D& texture = *reinterpret_cast<GL::Texture2D*>(atlas->BackendUserData);
+    GL::Framebuffer framebuffer{{{}, atlasSize}};
+    framebuffer.attachTexture(GL::Framebuffer::ColorAttachment{0}, texture, 0);
+    Image2D image = framebuffer.read(framebuffer.viewport(), {PixelFormat::RGBA8Unorm});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(image.pixels<Color4ub>()[0][10], notUploaded);
+
+    /* With the texel outside of the rectangles restored, the whole texture
+       matches the atlas */
+    atlasPixels[0][10] = notUploaded;
+    CORRADE_COMPARE_WITH(image,
+        (ImageView2D{PixelFormat::RGBA8Unorm, atlasSize, {atlas->GetPixels(), std::size_t(atlasSize.product()*4)}}),
+        (DebugTools::CompareImage{0.0f, 0.0f}));
+}
+
+void ContextGLTest::drawFrameStatistics() {
+    Context c{{200, 200}, {70, 70}, _framebuffer.viewport().size()};
+
+    /* Time queries are optional, enable only if supported */
+    #ifndef MAGNUM_TARGET_WEBGL
+    #ifndef MAGNUM_TARGET_GLES
+    if(GL::Context::current().isExtensionSupported<GL::Extensions::ARB::timer_query>())
+    #else
+    if(GL::Context::current().isExtensionSupported<GL::Extensions::EXT::disjoint_timer_query>())
+    #endif
+        c.setFlags(Context::Flag::GpuTimeQuery);
+    #endif
+
+    /* ImGui doesn't draw anything the first frame, but it uploads the font
+       atlas */
+    c.newFrame();
+    c.drawFrame();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    ImTextureData* atlas = ImGui::GetIO().Fonts->TexData;
+    CORRADE_VERIFY(atlas);
+    CORRADE_COMPARE(c.frameStatistics().textureUploadSize, std::size_t(atlas->Width*atlas->Height*4));
+    CORRADE_COMPARE(c.frameStatistics().drawCallCount, 0);
+
+    Utility::System::sleep(1);
+
+    c.newFrame();
+
+    /* Last drawlist that gets rendered, covers the entire display */
+    ImDrawList* drawList = ImGui::GetForegroundDrawList();
+    const ImVec2& size = ImGui::GetIO().DisplaySize;
+    drawList->AddRectFilled({0.0f, 0.0f}, size, IM_COL32(0, 255, 0, 255));
+    drawList->AddDrawCmd();
+    drawList->AddRectFilled({0.0f, 0.0f}, size, IM_COL32(0, 255, 0, 255));
+
+    c.drawFrame();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    Context::FrameStatistics statistics = c.frameStatistics();
+    CORRADE_COMPARE(statistics.drawListCount, 1);
+    CORRADE_COMPARE(statistics.commandCount, 2);
+    CORRADE_COMPARE(statistics.drawCallCount, 2);
+    CORRADE_COMPARE(statistics.vertexCount, 8);
+    CORRADE_COMPARE(statistics.indexCount, 12);
+    CORRADE_COMPARE(statistics.textureUploadSize, 0);
+    CORRADE_VERIFY(statistics.cpuTime > 0);
+}
+
+void ContextGLTest::drawRetainedBuffers() {
+    Context c{{200, 200}, {70, 70}, _framebuffer.viewport().size()};
+    if(!(ImGui::GetIO().BackendFlags & ImGuiBackendFlags_RendererHasVtxOffset))
+        CORRADE_SKIP("Vertex offset not supported");
+
+    c.setFlags(Context::Flag::RetainedBuffers);
+
+    /* ImGui doesn't draw anything the first frame */
+    c.newFrame();
+    c.drawFrame();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* The same data in the second and third frame, a change in the fourth */
+    const ImU32 colors[]{
+        IM_COL32(255, 0, 0, 255),
+        IM_COL32(255, 0, 0, 255),
+        IM_COL32(0, 255, 0, 255)
+    };
+    const UnsignedInt expectedVertexCounts[]{4, 0, 4};
+    for(std::size_t i = 0; i != Containers::arraySize(colors); ++i) {
+        CORRADE_ITERATION(i);
+        Utility::System::sleep(1);
+
+        c.newFrame();
+
+        ImDrawList* drawList = ImGui::GetForegroundDrawList();
+        const ImVec2& size = ImGui::GetIO().DisplaySize;
+        drawList->AddRectFilled({0.0f, 0.0f}, size, colors[i]);
+
+        c.drawFrame();
+
+        MAGNUM_VERIFY_NO_GL_ERROR();
+        CORRADE_COMPARE(c.frameStatistics().vertexCount, expectedVertexCounts[i]);
+        CORRADE_COMPARE(c.frameStatistics().drawCallCount, 1);
+    }
+
+    Containers::Array<Color4ub> pixels{NoInit, size_t(_framebuffer.viewport().size().product())};
+    for(Color4ub& p: pixels)
+        p = Color4ub{0, 255, 0, 255};
+
+    CORRADE_COMPARE_WITH(
+        _framebuffer.read(_framebuffer.viewport(), {PixelFormat::RGBA8Unorm}),
+        (ImageView2D{PixelFormat::RGBA8Unorm, _framebuffer.viewport().size(), pixels}),
+        (DebugTools::CompareImage{1.0f, 0.5f}));
+}
+
+void ContextGLTest::drawShaderClipping() {
+    #ifdef MAGNUM_TARGET_GLES2
+    CORRADE_SKIP("Clipping in the shader is not available on OpenGL ES 2.0.");
+    #else
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isVersionSupported(GL::Version::GL300))
+        CORRADE_SKIP(GL::Version::GL300 << "is not supported.");
+    #endif
+
+    Context c{{200, 200}, {70, 70}, _framebuffer.viewport().size()};
+    c.setFlags(Context::Flag::ShaderClipping);
+
+    /* ImGui doesn't draw anything the first frame */
+    c.newFrame();
+    c.drawFrame();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    Utility::System::sleep(1);
+
+    c.newFrame();
+
+    /* Last drawlist that gets rendered, covers the entire display */
+    ImDrawList* drawList = ImGui::GetForegroundDrawList();
+    const ImVec2& size = ImGui::GetIO().DisplaySize;
+
+    /* Same as in drawMultiDraw(), but as the clip rect is now applied in the
+       shader, all three commands get drawn together */
+    drawList->AddRectFilled({0.0f, 0.0f}, size, IM_COL32(255, 0, 0, 255));
+    drawList->AddDrawCmd();
+    drawList->AddRectFilled({0.0f, 0.0f}, size, IM_COL32(0, 255, 0, 255));
+    drawList->PushClipRect({0.0f, 0.0f}, {size.x*0.5f, size.y});
+    drawList->AddRectFilled({0.0f, 0.0f}, size, IM_COL32(0, 0, 255, 255));
+    CORRADE_COMPARE(drawList->CmdBuffer.Size, 3);
+
+    c.drawFrame();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* Only the texture gets bound, the scissor is never changed */
+    CORRADE_COMPARE(c.stateChangeStatistics().issued, 1);
+    CORRADE_COMPARE(c.stateChangeStatistics().skipped, 5);
+    CORRADE_COMPARE(c.frameStatistics().drawCallCount, 1);
+
+    const Vector2i framebufferSize = _framebuffer.viewport().size();
+    Containers::Array<Color4ub> pixels{NoInit, size_t(framebufferSize.product())};
+    for(Int y = 0; y != framebufferSize.y(); ++y)
+        for(Int x = 0; x != framebufferSize.x(); ++x)
+            pixels[y*framebufferSize.x() + x] = x < framebufferSize.x()/2 ?
+                Color4ub{0, 0, 255, 255} : Color4ub{0, 255, 0, 255};
+
+    CORRADE_COMPARE_WITH(
+        _framebuffer.read(_framebuffer.viewport(), {PixelFormat::RGBA8Unorm}),
+        (ImageView2D{PixelFormat::RGBA8Unorm, framebufferSize, pixels}),
+        (DebugTools::CompareImage{1.0f, 0.5f}));
+    #endif
+}
+
+void ContextGLTest::drawDistanceFieldFonts() {
+    #ifdef MAGNUM_TARGET_GLES2
+    CORRADE_SKIP("Distance field fonts are not available on OpenGL ES 2.0.");
+    #else
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isVersionSupported(GL::Version::GL300))
+        CORRADE_SKIP(GL::Version::GL300 << "is not supported.");
+    #endif
+
+    for(Context::Flags flags: {
+        Context::Flags{Context::Flag::DistanceFieldFonts},
+        Context::Flag::DistanceFieldFonts|Context::Flag::ShaderClipping
+    }) {
+        CORRADE_ITERATION(flags);
+
+        _framebuffer.clear(GL::FramebufferClear::Color);
+
+        Context c{{200, 200}, {70, 70}, _framebuffer.viewport().size()};
+        c.setFlags(flags);
+
+        /* ImGui doesn't draw anything the first frame */
+        c.newFrame();
+        c.drawFrame();
+
+        c.newFrame();
+
+        /* The rectangles sample the opaque white pixel of the font atlas,
+           which should stay opaque with the distance field shader as
+           well */
+        ImDrawList* drawList = ImGui::GetForegroundDrawList();
+        const ImVec2& size = ImGui::GetIO().DisplaySize;
+        drawList->AddRectFilled({0.0f, 0.0f}, size, IM_COL32(0, 255, 0, 255));
+        drawList->PushClipRect({0.0f, 0.0f}, {size.x*0.5f, size.y});
+        drawList->AddRectFilled({0.0f, 0.0f}, size, IM_COL32(0, 0, 255, 255));
+
+        c.drawFrame();
+
+        MAGNUM_VERIFY_NO_GL_ERROR();
+
+        const Vector2i framebufferSize = _framebuffer.viewport().size();
+        Containers::Array<Color4ub> pixels{NoInit, size_t(framebufferSize.product())};
+        for(Int y = 0; y != framebufferSize.y(); ++y)
+            for(Int x = 0; x != framebufferSize.x(); ++x)
+                pixels[y*framebufferSize.x() + x] = x < framebufferSize.x()/2 ?
+                    Color4ub{0, 0, 255, 255} : Color4ub{0, 255, 0, 255};
+
+        CORRADE_COMPARE_WITH(
+            _framebuffer.read(_framebuffer.viewport(), {PixelFormat::RGBA8Unorm}),
+            (ImageView2D{PixelFormat::RGBA8Unorm, framebufferSize, pixels}),
+            (DebugTools::CompareImage{1.0f, 0.5f}));
+    }
+    #endif
+}
+
+void ContextGLTest::registerTexture() {
+    #ifdef MAGNUM_TARGET_GLES2
+    CORRADE_SKIP("Texture registration is not available on OpenGL ES 2.0.");
+    #else
+    Context c{{200, 200}};
+    CORRADE_COMPARE(c.registeredTextureCount(), 0);
+
+    GL::Texture2D texture;
+    GL::Texture2DArray textureArray;
+    RegisteredTexture a = c.registerTexture(texture, 0);
+    RegisteredTexture b = c.registerTexture(textureArray, 3);
+    RegisteredTexture b2 = c.registerTexture(textureArray, 5);
+    CORRADE_COMPARE(c.registeredTextureCount(), 3);
+    CORRADE_VERIFY(a != b);
+    CORRADE_VERIFY(b != b2);
+
+    /* The IDs are distinct from plain texture IDs */
+    CORRADE_VERIFY(textureId(a) != textureId(texture));
+
+    /* A free slot gets reused */
+    c.unregisterTexture(b);
+    CORRADE_COMPARE(c.registeredTextureCount(), 2);
+    RegisteredTexture d = c.registerTexture(texture, 0);
+    CORRADE_COMPARE(UnsignedInt(d), UnsignedInt(b));
+    CORRADE_COMPARE(c.registeredTextureCount(), 3);
+
+    /* The registry is moved together with the context */
+    Context moved{Utility::move(c)};
+    CORRADE_COMPARE(moved.registeredTextureCount(), 3);
+    #endif
+}
+
+void ContextGLTest::registerTextureInvalid() {
+    #ifdef MAGNUM_TARGET_GLES2
+    CORRADE_SKIP("Texture registration is not available on OpenGL ES 2.0.");
+    #else
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Context c{{200, 200}};
+
+    GL::Texture2D texture{NoCreate};
+    GL::Texture2DArray textureArray;
+    RegisteredTexture a = c.registerTexture(textureArray, 0);
+    c.unregisterTexture(a);
+
+    Containers::String out;
+    Error redirectError{&out};
+    c.registerTexture(texture, 0);
+    c.registerTexture(textureArray, -1);
+    c.unregisterTexture(a);
+    c.unregisterTexture(RegisteredTexture(0x80000007u));
+    c.unregisterTexture(RegisteredTexture(textureArray.id()));
+    CORRADE_COMPARE(out, Utility::format(
+        "ImGuiIntegration::Context::registerTexture(): the texture is not created\n"
+        "ImGuiIntegration::Context::registerTexture(): expected a non-negative layer, got -1\n"
+        "ImGuiIntegration::Context::unregisterTexture(): texture 0x80000000 is not registered\n"
+        "ImGuiIntegration::Context::unregisterTexture(): texture 0x80000007 is not registered\n"
+        "ImGuiIntegration::Context::unregisterTexture(): texture 0x{:x} is not registered\n", textureArray.id()));
+    #endif
+}
+
+void ContextGLTest::drawRegisteredTexture() {
+    #ifdef MAGNUM_TARGET_GLES2
+    CORRADE_SKIP("Texture registration is not available on OpenGL ES 2.0.");
+    #else
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::sampler_objects>())
+        CORRADE_SKIP(GL::Extensions::ARB::sampler_objects::string() << "is not supported.");
+    #endif
+
+    /* Catch also ABI and interface mismatch errors */
+    if(!(_manager.load("PngImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("PngImporter plugin not found.");
+    if(!(_manager.load("AnyImageImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("AnyImageImporter plugin not found.");
+
+    Containers::Pointer<Trade::AbstractImporter> importer = _manager.instantiate("PngImporter");
+    CORRADE_VERIFY(importer->openFile(Utility::Path::join(IMGUIINTEGRATION_TEST_DIR, "ContextTestFiles/texture.png")));
+    auto image = importer->image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->format(), PixelFormat::RGB8Unorm);
+
+    /* Same output as drawTexture(), but the first texture is a layer of an
+       array and the second is a 2D texture that's incomplete on its own, as
+       the default minification filter needs mipmaps, and is made complete
+       only by the sampler */
+    GL::Texture2DArray texture1;
+    texture1.setStorage(1, GL::TextureFormat::RGB8, {image->size(), 3})
+        .setSubImage(0, {0, 0, 2}, ImageView3D{image->storage(), image->format(), {image->size(), 1}, image->data()})
+        .setMagnificationFilter(GL::SamplerFilter::Nearest)
+        .setMinificationFilter(GL::SamplerFilter::Nearest, GL::SamplerMipmap::Base);
+
+    for(auto row: image->mutablePixels<Color3ub>())
+    for(Color3ub& p: row)
+        p = Color3ub{255} - p;
+
+    GL::Texture2D texture2;
+    texture2.setImage(0, GL::TextureFormat::RGB8, *image);
+
+    GLuint sampler;
+    glGenSamplers(1, &sampler);
+    glSamplerParameteri(sampler, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glSamplerParameteri(sampler, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+    /* Registered textures are never drawn as a distance field */
+    for(Context::Flags flags: {
+        Context::Flags{},
+        Context::Flags{Context::Flag::ShaderClipping},
+        Context::Flags{Context::Flag::DistanceFieldFonts},
+        Context::Flag::DistanceFieldFonts|Context::Flag::ShaderClipping
+    }) {
+        CORRADE_ITERATION(flags);
+
+        #ifndef MAGNUM_TARGET_GLES
+        if((flags & (Context::Flag::ShaderClipping|Context::Flag::DistanceFieldFonts)) && !GL::Context::current().isVersionSupported(GL::Version::GL300))
+            continue;
+        #endif
+
+        _framebuffer.clear(GL::FramebufferClear::Color);
+
+        Context c{{200, 200}, {70, 70}, _framebuffer.viewport().size()};
+        c.setFlags(flags);
+        RegisteredTexture registered1 = c.registerTexture(texture1, 2);
+        RegisteredTexture registered2 = c.registerTexture(texture2, sampler);
+
+        /* ImGui doesn't draw anything the first frame */
+        c.newFrame();
+        c.drawFrame();
+
+        c.newFrame();
+
+        /* Last drawlist that gets rendered, covers the entire display */
+        ImDrawList* drawList = ImGui::GetForegroundDrawList();
+        const ImVec2& size = ImGui::GetIO().DisplaySize;
+
+        drawList->AddImage(textureId(registered1), {0.0f, 0.0f}, {size.x, size.y*0.5f});
+        drawList->AddImage(textureId(registered2), {0.0f, size.y*0.5f}, size,
+            {0.25f, 0.25f}, {1.0f, 0.75f});
+
+        c.drawFrame();
+
+        MAGNUM_VERIFY_NO_GL_ERROR();
+
+        CORRADE_COMPARE_WITH(
+            /* Dropping the alpha channel, as it's always 1.0 */
+            Containers::arrayCast<Color3ub>(_framebuffer.read(_framebuffer.viewport(), {PixelFormat::RGBA8Unorm}).pixels<Color4ub>()),
+            Utility::Path::join(IMGUIINTEGRATION_TEST_DIR, "ContextTestFiles/draw-texture.png"),
+            (DebugTools::CompareImageToFile{_manager, 1.0f, 0.5f}));
+    }
+
+    glDeleteSamplers(1, &sampler);
+    #endif
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::ImGuiIntegration::Test::ContextGLTest)
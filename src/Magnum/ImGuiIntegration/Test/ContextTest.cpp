@@ -34,7 +34,9 @@
 #define IMGUI_DISABLE_OBSOLETE_FUNCTIONS
 #endif
 
+#include <sstream>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
 
 #include "Magnum/ImGuiIntegration/Context.h"
 
@@ -45,11 +47,17 @@ struct ContextTest: TestSuite::Tester {
 
     void constructNoCreate();
     void constructCopy();
+
+    void debugFlag();
+    void debugFlags();
 };
 
 ContextTest::ContextTest() {
     addTests({&ContextTest::constructNoCreate,
-              &ContextTest::constructCopy});
+              &ContextTest::constructCopy,
+
+              &ContextTest::debugFlag,
+              &ContextTest::debugFlags});
 }
 
 void ContextTest::constructNoCreate() {
@@ -66,6 +74,18 @@ void ContextTest::constructCopy() {
     CORRADE_VERIFY(!std::is_assignable<Context, const Context&>{});
 }
 
+void ContextTest::debugFlag() {
+    std::ostringstream out;
+    Debug{&out} << Context::Flag::PersistentMappedBuffers << Context::Flag(0xcafedead);
+    CORRADE_COMPARE(out.str(), "ImGuiIntegration::Context::Flag::PersistentMappedBuffers ImGuiIntegration::Context::Flag(0xcafedead)\n");
+}
+
+void ContextTest::debugFlags() {
+    std::ostringstream out;
+    Debug{&out} << (Context::Flag::PersistentMappedBuffers|Context::Flag::MultiDraw|Context::Flag::AsyncTextureUploads|Context::Flag(0xf00)) << Context::Flags{};
+    CORRADE_COMPARE(out.str(), "ImGuiIntegration::Context::Flag::PersistentMappedBuffers|ImGuiIntegration::Context::Flag::MultiDraw|ImGuiIntegration::Context::Flag::AsyncTextureUploads|ImGuiIntegration::Context::Flag(0xf00) ImGuiIntegration::Context::Flags{}\n");
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::ImGuiIntegration::Test::ContextTest)
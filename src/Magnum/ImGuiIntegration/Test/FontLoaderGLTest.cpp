@@ -0,0 +1,152 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/* Explicitly disable deprecated functions on non-deprecated builds to catch
+   issues early. Doing this only in tests so the library itself can be used
+   with any newer version, but tests should be always run against the oldest
+   supported which is mentioned in doc/namespaces.dox, and which is downloaded
+   in all CI targets in package/ci/. The oldest supported version is tracked to
+   be roughly two years back. */
+#ifndef MAGNUM_BUILD_DEPRECATED
+#define IMGUI_DISABLE_OBSOLETE_FUNCTIONS
+#endif
+
+#include <sstream>
+#include <imgui.h>
+#include <imgui_internal.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/PluginManager/Manager.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Path.h>
+#include <Magnum/GL/DefaultFramebuffer.h>
+#include <Magnum/GL/Framebuffer.h>
+#include <Magnum/GL/OpenGL.h>
+#include <Magnum/GL/OpenGLTester.h>
+#include <Magnum/Math/Range.h>
+#include <Magnum/Text/AbstractFont.h>
+
+#include "Magnum/ImGuiIntegration/FontLoader.h"
+
+namespace Magnum { namespace ImGuiIntegration { namespace Test { namespace {
+
+struct FontLoaderGLTest: GL::OpenGLTester {
+    explicit FontLoaderGLTest();
+
+    void addDistanceFieldFont();
+    void addDistanceFieldFontInvalid();
+
+    private:
+        PluginManager::Manager<Text::AbstractFont> _manager;
+};
+
+FontLoaderGLTest::FontLoaderGLTest() {
+    addTests({&FontLoaderGLTest::addDistanceFieldFont,
+              &FontLoaderGLTest::addDistanceFieldFontInvalid});
+}
+
+void FontLoaderGLTest::addDistanceFieldFont() {
+    #ifdef MAGNUM_TARGET_GLES2
+    CORRADE_SKIP("Distance field fonts are not available on OpenGL ES 2.0.");
+    #elif !defined(IMGUI_FONTS_DIR)
+    CORRADE_SKIP("ImGui sources with bundled fonts not available, cannot test.");
+    #else
+    if(!(_manager.load("TrueTypeFont") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("TrueTypeFont plugin not found, cannot test.");
+
+    Containers::Optional<Containers::Array<char>> data = Utility::Path::read(Utility::Path::join(IMGUI_FONTS_DIR, "DroidSans.ttf"));
+    CORRADE_VERIFY(data);
+
+    FontLoader loader{_manager};
+    ImGuiContext* context = ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasTextures;
+    io.DisplaySize = {200.0f, 200.0f};
+    ImFont* font = loader.addDistanceFieldFont(*io.Fonts, *data, 32.0f, 4);
+    CORRADE_VERIFY(font);
+    CORRADE_VERIFY(font->Flags & ImFontFlags_LockBakedSizes);
+    CORRADE_VERIFY(io.Fonts->Flags & ImFontAtlasFlags_NoBakedLines);
+
+    ImGui::NewFrame();
+
+    /* Glyph processing shouldn't leave the distance field framebuffer
+       bound */
+    GL::Framebuffer framebuffer{{{}, {16, 16}}};
+    framebuffer.bind();
+
+    /* The font is baked just once, querying other sizes gives back the same
+       bake */
+    ImFontBaked* baked = font->GetFontBaked(32.0f);
+    CORRADE_COMPARE(baked->Size, 32.0f);
+    CORRADE_COMPARE(font->GetFontBaked(12.0f), baked);
+    CORRADE_COMPARE(font->GetFontBaked(64.0f), baked);
+
+    /* The glyph is larger than the original because of the distance field
+       padding, but still roughly at the same place */
+    ImFontGlyph* a = baked->FindGlyph('A');
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(a);
+    CORRADE_VERIFY(a->Visible);
+    CORRADE_COMPARE_AS(a->AdvanceX, 0.0f, TestSuite::Compare::Greater);
+    CORRADE_COMPARE_AS(a->AdvanceX, 32.0f, TestSuite::Compare::Less);
+    CORRADE_COMPARE_AS(a->X0, 0.0f, TestSuite::Compare::Less);
+    CORRADE_COMPARE_AS(a->Y1, baked->Ascent, TestSuite::Compare::Greater);
+    CORRADE_COMPARE_AS(a->Y1, baked->Ascent + 6.0f, TestSuite::Compare::Less);
+
+    GLint bound;
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &bound);
+    CORRADE_COMPARE(bound, framebuffer.id());
+    CORRADE_COMPARE(framebuffer.viewport(), (Range2Di{{}, {16, 16}}));
+
+    ImGui::EndFrame();
+    ImGui::DestroyContext(context);
+    GL::defaultFramebuffer.bind();
+    #endif
+}
+
+void FontLoaderGLTest::addDistanceFieldFontInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    #ifdef MAGNUM_TARGET_GLES2
+    CORRADE_SKIP("Distance field fonts are not available on OpenGL ES 2.0.");
+    #else
+    FontLoader loader{_manager};
+    ImFontAtlas atlas;
+
+    const char data[1]{};
+    std::ostringstream out;
+    Error redirectError{&out};
+    loader.addDistanceFieldFont(atlas, data, 32.0f, 0);
+    loader.addDistanceFieldFont(atlas, data, 32.0f, 256);
+    CORRADE_COMPARE(out.str(),
+        "ImGuiIntegration::FontLoader::addDistanceFieldFont(): expected radius between 1 and 255, got 0\n"
+        "ImGuiIntegration::FontLoader::addDistanceFieldFont(): expected radius between 1 and 255, got 256\n");
+    #endif
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::ImGuiIntegration::Test::FontLoaderGLTest)
@@ -0,0 +1,193 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/* Explicitly disable deprecated functions on non-deprecated builds to catch
+   issues early. Doing this only in tests so the library itself can be used
+   with any newer version, but tests should be always run against the oldest
+   supported which is mentioned in doc/namespaces.dox, and which is downloaded
+   in all CI targets in package/ci/. The oldest supported version is tracked to
+   be roughly two years back. */
+#ifndef MAGNUM_BUILD_DEPRECATED
+#define IMGUI_DISABLE_OBSOLETE_FUNCTIONS
+#endif
+
+#include <sstream>
+#include <cstring>
+#include <imgui.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/String.h>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/PluginManager/Manager.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Path.h>
+#include <Magnum/Text/AbstractFont.h>
+
+#include "Magnum/ImGuiIntegration/FontLoader.h"
+
+namespace Magnum { namespace ImGuiIntegration { namespace Test { namespace {
+
+using namespace Containers::Literals;
+
+struct FontLoaderTest: TestSuite::Tester {
+    explicit FontLoaderTest();
+
+    void construct();
+    void constructCopy();
+
+    void addFont();
+    void addFontInvalid();
+    void glyphs();
+
+    private:
+        PluginManager::Manager<Text::AbstractFont> _manager;
+};
+
+FontLoaderTest::FontLoaderTest() {
+    addTests({&FontLoaderTest::construct,
+              &FontLoaderTest::constructCopy,
+
+              &FontLoaderTest::addFont,
+              &FontLoaderTest::addFontInvalid,
+              &FontLoaderTest::glyphs});
+}
+
+void FontLoaderTest::construct() {
+    FontLoader loader{_manager, "StbTrueTypeFont"};
+    CORRADE_COMPARE(&loader.manager(), &_manager);
+    CORRADE_COMPARE(loader.plugin(), "StbTrueTypeFont");
+    CORRADE_COMPARE(loader.imFontLoader().Name, "Magnum::Text::AbstractFont"_s);
+}
+
+void FontLoaderTest::constructCopy() {
+    CORRADE_VERIFY(!std::is_constructible<FontLoader, const FontLoader&>{});
+    CORRADE_VERIFY(!std::is_constructible<FontLoader, FontLoader&&>{});
+    CORRADE_VERIFY(!std::is_assignable<FontLoader, const FontLoader&>{});
+    CORRADE_VERIFY(!std::is_assignable<FontLoader, FontLoader&&>{});
+}
+
+void FontLoaderTest::addFont() {
+    #ifndef IMGUI_FONTS_DIR
+    CORRADE_SKIP("ImGui sources with bundled fonts not available, cannot test.");
+    #else
+    if(!(_manager.load("TrueTypeFont") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("TrueTypeFont plugin not found, cannot test.");
+
+    Containers::Optional<Containers::Array<char>> data = Utility::Path::read(Utility::Path::join(IMGUI_FONTS_DIR, "DroidSans.ttf"));
+    CORRADE_VERIFY(data);
+
+    FontLoader loader{_manager};
+    ImFontAtlas atlas;
+    ImFont* font = loader.addFont(atlas, *data, 16.0f);
+    CORRADE_VERIFY(font);
+    CORRADE_COMPARE(atlas.Fonts.size(), 1);
+    CORRADE_COMPARE(atlas.Fonts[0], font);
+    CORRADE_COMPARE(font->GetDebugName(), "TrueTypeFont, 16px"_s);
+    CORRADE_COMPARE(font->Sources[0]->FontLoader, &loader.imFontLoader());
+
+    /* A custom name is preserved */
+    ImFontConfig config;
+    std::strcpy(config.Name, "Droid");
+    ImFont* named = loader.addFont(atlas, *data, 24.0f, &config);
+    CORRADE_VERIFY(named);
+    CORRADE_COMPARE(named->GetDebugName(), "Droid"_s);
+    #endif
+}
+
+void FontLoaderTest::addFontInvalid() {
+    if(!(_manager.load("TrueTypeFont") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("TrueTypeFont plugin not found, cannot test.");
+
+    FontLoader loader{_manager};
+    ImFontAtlas atlas;
+
+    const char data[]{'N', 'O', 'P', 'E'};
+    {
+        /* The plugin prints a message, which isn't important here */
+        std::ostringstream out;
+        Error redirectError{&out};
+        CORRADE_VERIFY(!loader.addFont(atlas, data, 16.0f));
+    }
+    CORRADE_COMPARE(atlas.Fonts.size(), 0);
+}
+
+void FontLoaderTest::glyphs() {
+    #ifndef IMGUI_FONTS_DIR
+    CORRADE_SKIP("ImGui sources with bundled fonts not available, cannot test.");
+    #else
+    if(!(_manager.load("TrueTypeFont") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("TrueTypeFont plugin not found, cannot test.");
+
+    Containers::Optional<Containers::Array<char>> data = Utility::Path::read(Utility::Path::join(IMGUI_FONTS_DIR, "DroidSans.ttf"));
+    CORRADE_VERIFY(data);
+
+    FontLoader loader{_manager};
+    ImGuiContext* context = ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasTextures;
+    io.DisplaySize = {200.0f, 200.0f};
+    ImFont* font = loader.addFont(*io.Fonts, *data, 16.0f);
+    CORRADE_VERIFY(font);
+
+    ImGui::NewFrame();
+
+    /* Glyphs are loaded on demand, with a separate bake for a different
+       size */
+    CORRADE_VERIFY(font->IsGlyphInFont('A'));
+    CORRADE_VERIFY(!font->IsGlyphInFont(0xe000));
+    for(Float size: {16.0f, 32.0f}) {
+        CORRADE_ITERATION(size);
+        ImFontBaked* baked = font->GetFontBaked(size);
+        CORRADE_VERIFY(baked);
+        CORRADE_COMPARE_AS(baked->Ascent, 0.0f, TestSuite::Compare::Greater);
+        CORRADE_COMPARE_AS(baked->Descent, 0.0f, TestSuite::Compare::Less);
+
+        ImFontGlyph* a = baked->FindGlyph('A');
+        CORRADE_VERIFY(a);
+        CORRADE_COMPARE(a->Codepoint, 'A');
+        CORRADE_VERIFY(a->Visible);
+        CORRADE_COMPARE_AS(a->AdvanceX, 0.0f, TestSuite::Compare::Greater);
+        CORRADE_COMPARE_AS(a->AdvanceX, size, TestSuite::Compare::Less);
+        /* The glyph is above the baseline */
+        CORRADE_COMPARE_AS(a->Y0, 0.0f, TestSuite::Compare::GreaterOrEqual);
+        CORRADE_COMPARE_AS(a->Y1, baked->Ascent + 1.0f, TestSuite::Compare::LessOrEqual);
+
+        /* Space has an advance but nothing to draw */
+        ImFontGlyph* space = baked->FindGlyph(' ');
+        CORRADE_VERIFY(space);
+        CORRADE_VERIFY(!space->Visible);
+        CORRADE_COMPARE_AS(space->AdvanceX, 0.0f, TestSuite::Compare::Greater);
+    }
+
+    ImGui::EndFrame();
+    ImGui::DestroyContext(context);
+    #endif
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::ImGuiIntegration::Test::FontLoaderTest)
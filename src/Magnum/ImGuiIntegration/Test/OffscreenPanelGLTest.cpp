@@ -0,0 +1,238 @@
+/*
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/* Explicitly disable deprecated functions on non-deprecated builds to catch
+   issues early. Doing this only in tests so the library itself can be used
+   with any newer version, but tests should be always run against the oldest
+   supported which is mentioned in doc/namespaces.dox, and which is downloaded
+   in all CI targets in package/ci/. The oldest supported version is tracked to
+   be roughly two years back. */
+#ifndef MAGNUM_BUILD_DEPRECATED
+#define IMGUI_DISABLE_OBSOLETE_FUNCTIONS
+#endif
+
+#include <sstream>
+#include <imgui.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Magnum/Image.h>
+#include <Magnum/PixelFormat.h>
+#include <Magnum/GL/OpenGLTester.h>
+#include <Magnum/GL/Renderer.h>
+#include <Magnum/GL/TextureFormat.h>
+#include <Magnum/Math/Color.h>
+
+#include "Magnum/ImGuiIntegration/Context.h"
+#include "Magnum/ImGuiIntegration/OffscreenPanel.h"
+
+namespace Magnum { namespace ImGuiIntegration { namespace Test { namespace {
+
+struct OffscreenPanelGLTest: GL::OpenGLTester {
+    explicit OffscreenPanelGLTest();
+
+    void construct();
+    void constructNoCreate();
+    void constructMove();
+
+    void setUpdateRateInvalid();
+
+    void draw();
+    void drawExternalTexture();
+    void updateRate();
+};
+
+OffscreenPanelGLTest::OffscreenPanelGLTest() {
+    addTests({&OffscreenPanelGLTest::construct,
+              &OffscreenPanelGLTest::constructNoCreate,
+              &OffscreenPanelGLTest::constructMove,
+
+              &OffscreenPanelGLTest::setUpdateRateInvalid,
+
+              &OffscreenPanelGLTest::draw,
+              &OffscreenPanelGLTest::drawExternalTexture,
+              &OffscreenPanelGLTest::updateRate});
+
+    GL::Renderer::enable(GL::Renderer::Feature::Blending);
+    GL::Renderer::setBlendEquation(GL::Renderer::BlendEquation::Add, GL::Renderer::BlendEquation::Add);
+    GL::Renderer::setBlendFunction(
+        GL::Renderer::BlendFunction::SourceAlpha,
+        GL::Renderer::BlendFunction::OneMinusSourceAlpha,
+        GL::Renderer::BlendFunction::One,
+        GL::Renderer::BlendFunction::OneMinusSourceAlpha);
+
+    GL::Renderer::disable(GL::Renderer::Feature::FaceCulling);
+    GL::Renderer::disable(GL::Renderer::Feature::DepthTest);
+    GL::Renderer::enable(GL::Renderer::Feature::ScissorTest);
+}
+
+void OffscreenPanelGLTest::construct() {
+    OffscreenPanel panel{{64, 32}};
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_COMPARE(panel.size(), (Vector2i{64, 32}));
+    CORRADE_VERIFY(panel.texture().id());
+    CORRADE_VERIFY(panel.framebuffer().id());
+    CORRADE_COMPARE(panel.framebuffer().viewport(), (Range2Di{{}, {64, 32}}));
+    CORRADE_COMPARE(panel.updateRate(), 0.0f);
+    CORRADE_COMPARE(panel.updateCount(), 0);
+}
+
+void OffscreenPanelGLTest::constructNoCreate() {
+    {
+        OffscreenPanel panel{NoCreate};
+        CORRADE_VERIFY(!panel.texture().id());
+        CORRADE_VERIFY(!panel.framebuffer().id());
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void OffscreenPanelGLTest::constructMove() {
+    OffscreenPanel a{{64, 32}};
+    a.setUpdateRate(15.0f);
+    const GLuint id = a.texture().id();
+
+    OffscreenPanel b{Utility::move(a)};
+    CORRADE_COMPARE(b.texture().id(), id);
+    CORRADE_COMPARE(b.size(), (Vector2i{64, 32}));
+    CORRADE_COMPARE(b.updateRate(), 15.0f);
+    CORRADE_VERIFY(!a.texture().id());
+
+    OffscreenPanel c{{16, 16}};
+    const GLuint cId = c.texture().id();
+    c = Utility::move(b);
+    CORRADE_COMPARE(c.texture().id(), id);
+    CORRADE_COMPARE(b.texture().id(), cId);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<OffscreenPanel>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<OffscreenPanel>::value);
+}
+
+void OffscreenPanelGLTest::setUpdateRateInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    OffscreenPanel panel{NoCreate};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    panel.setUpdateRate(-1.0f);
+    CORRADE_COMPARE(out.str(), "ImGuiIntegration::OffscreenPanel::setUpdateRate(): expected a non-negative rate, got -1\n");
+}
+
+void OffscreenPanelGLTest::draw() {
+    OffscreenPanel panel{{64, 64}};
+    Context c{Vector2{panel.size()}, panel.size(), panel.size()};
+
+    /* ImGui doesn't draw anything the first frame */
+    CORRADE_VERIFY(panel.beginFrame(c));
+    panel.endFrame(c);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_VERIFY(panel.beginFrame(c));
+    ImGui::GetForegroundDrawList()->AddRectFilled({16.0f, 16.0f}, {48.0f, 48.0f}, 0xff00ff00);
+    panel.endFrame(c);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(panel.updateCount(), 2);
+
+    /* The rectangle is drawn into the texture, the rest is transparent */
+    Image2D image = panel.framebuffer().read({{}, panel.size()}, {PixelFormat::RGBA8Unorm});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(image.pixels<Color4ub>()[32][32], (Color4ub{0, 255, 0, 255}));
+    CORRADE_COMPARE(image.pixels<Color4ub>()[4][4], (Color4ub{0, 0, 0, 0}));
+}
+
+void OffscreenPanelGLTest::drawExternalTexture() {
+    OffscreenPanel panel{{64, 64}};
+    Context c{Vector2{panel.size()}, panel.size(), panel.size()};
+
+    GL::Texture2D target;
+    target.setStorage(1,
+        #ifndef MAGNUM_TARGET_GLES2
+        GL::TextureFormat::RGBA8,
+        #else
+        GL::TextureFormat::RGBA,
+        #endif
+        panel.size());
+
+    CORRADE_VERIFY(panel.beginFrame(c));
+    panel.endFrame(c);
+
+    CORRADE_VERIFY(panel.beginFrame(c));
+    ImGui::GetForegroundDrawList()->AddRectFilled({16.0f, 16.0f}, {48.0f, 48.0f}, 0xff00ff00);
+    panel.endFrame(c, target);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* The external texture is attached now */
+    Image2D image = panel.framebuffer().read({{}, panel.size()}, {PixelFormat::RGBA8Unorm});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(image.pixels<Color4ub>()[32][32], (Color4ub{0, 255, 0, 255}));
+}
+
+void OffscreenPanelGLTest::updateRate() {
+    OffscreenPanel panel{{64, 64}};
+    /* Once in 1000 seconds, which is enough to never update twice during the
+       test */
+    panel.setUpdateRate(0.001f);
+    Context c{Vector2{panel.size()}, panel.size(), panel.size()};
+
+    /* The first frame is always drawn */
+    CORRADE_VERIFY(panel.beginFrame(c));
+    panel.endFrame(c);
+    CORRADE_COMPARE(panel.updateCount(), 1);
+
+    /* Even though the UI needs to be redrawn, it's too early */
+    CORRADE_VERIFY(c.needsRedraw());
+    CORRADE_VERIFY(!panel.beginFrame(c));
+    CORRADE_COMPARE(panel.updateCount(), 1);
+
+    /* Unless explicitly requested */
+    panel.setNeedsUpdate();
+    CORRADE_VERIFY(panel.beginFrame(c));
+    panel.endFrame(c);
+    CORRADE_COMPARE(panel.updateCount(), 2);
+
+    /* With no rate limit, it's updated only while the context needs a
+       redraw */
+    panel.setUpdateRate(0.0f);
+    std::size_t frames = 0;
+    for(; frames != 10 && panel.beginFrame(c); ++frames)
+        panel.endFrame(c);
+    CORRADE_COMPARE_AS(frames, 10, TestSuite::Compare::Less);
+    CORRADE_VERIFY(!c.needsRedraw());
+    CORRADE_VERIFY(!panel.beginFrame(c));
+
+    /* Relayout makes it update again, same as input events would */
+    c.relayout(panel.size());
+    CORRADE_VERIFY(panel.beginFrame(c));
+    panel.endFrame(c);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::ImGuiIntegration::Test::OffscreenPanelGLTest)
@@ -0,0 +1,443 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/* Explicitly disable deprecated functions on non-deprecated builds to catch
+   issues early. Doing this only in tests so the library itself can be used
+   with any newer version, but tests should be always run against the oldest
+   supported which is mentioned in doc/namespaces.dox, and which is downloaded
+   in all CI targets in package/ci/. The oldest supported version is tracked to
+   be roughly two years back. */
+#ifndef MAGNUM_BUILD_DEPRECATED
+#define IMGUI_DISABLE_OBSOLETE_FUNCTIONS
+#endif
+
+#include <sstream>
+#include <imgui.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Magnum/Image.h>
+#include <Magnum/ImageView.h>
+#include <Magnum/PixelFormat.h>
+#include <Magnum/GL/Framebuffer.h>
+#include <Magnum/GL/OpenGLTester.h>
+#include <Magnum/GL/Texture.h>
+#include <Magnum/Math/Color.h>
+
+#include "Magnum/ImGuiIntegration/Context.h"
+#include "Magnum/ImGuiIntegration/ThumbnailAtlas.h"
+
+namespace Magnum { namespace ImGuiIntegration { namespace Test { namespace {
+
+using namespace Math::Literals;
+
+struct ThumbnailAtlasGLTest: GL::OpenGLTester {
+    explicit ThumbnailAtlasGLTest();
+
+    void construct();
+    void constructInvalid();
+    void constructNoCreate();
+    void constructMove();
+
+    void add();
+    void addExisting();
+    void addClearEdges();
+    void addInvalid();
+    void addEvict();
+    void addFull();
+    void remove();
+    void removeInvalid();
+    void pageInvalid();
+
+    void image();
+};
+
+ThumbnailAtlasGLTest::ThumbnailAtlasGLTest() {
+    addTests({&ThumbnailAtlasGLTest::construct,
+              &ThumbnailAtlasGLTest::constructInvalid,
+              &ThumbnailAtlasGLTest::constructNoCreate,
+              &ThumbnailAtlasGLTest::constructMove,
+
+              &ThumbnailAtlasGLTest::add,
+              &ThumbnailAtlasGLTest::addExisting,
+              &ThumbnailAtlasGLTest::addClearEdges,
+              &ThumbnailAtlasGLTest::addInvalid,
+              &ThumbnailAtlasGLTest::addEvict,
+              &ThumbnailAtlasGLTest::addFull,
+              &ThumbnailAtlasGLTest::remove,
+              &ThumbnailAtlasGLTest::removeInvalid,
+              &ThumbnailAtlasGLTest::pageInvalid,
+
+              &ThumbnailAtlasGLTest::image});
+}
+
+template<std::size_t size> ImageView2D thumbnail(const Color4ub(&data)[size], const Vector2i& imageSize) {
+    return ImageView2D{PixelFormat::RGBA8Unorm, imageSize, Containers::arrayView(data)};
+}
+
+void ThumbnailAtlasGLTest::construct() {
+    /* 4x4 cells, with a pixel of padding two of them fit into a 9x4 page */
+    ThumbnailAtlas atlas{{4, 4}, {9, 4}, 3};
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_COMPARE(atlas.cellSize(), (Vector2i{4, 4}));
+    CORRADE_COMPARE(atlas.pageSize(), (Vector2i{9, 4}));
+    CORRADE_COMPARE(atlas.maxPageCount(), 3);
+    CORRADE_COMPARE(atlas.cellsPerPage(), 2);
+    /* Pages are created lazily */
+    CORRADE_COMPARE(atlas.pageCount(), 0);
+    CORRADE_COMPARE(atlas.thumbnailCount(), 0);
+    CORRADE_COMPARE(atlas.evictionCount(), 0);
+    CORRADE_VERIFY(!atlas.contains(0));
+}
+
+void ThumbnailAtlasGLTest::constructInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    ThumbnailAtlas{{4, 0}, {16, 16}};
+    ThumbnailAtlas{{4, 4}, {16, 16}, 0};
+    ThumbnailAtlas{{4, 8}, {16, 7}};
+    CORRADE_COMPARE(out.str(),
+        "ImGuiIntegration::ThumbnailAtlas: expected non-zero sizes and page count, got {4, 0}, {16, 16}, 4\n"
+        "ImGuiIntegration::ThumbnailAtlas: expected non-zero sizes and page count, got {4, 4}, {16, 16}, 0\n"
+        "ImGuiIntegration::ThumbnailAtlas: cell size {4, 8} doesn't fit into page size {16, 7}\n");
+}
+
+void ThumbnailAtlasGLTest::constructNoCreate() {
+    {
+        ThumbnailAtlas atlas{NoCreate};
+    }
+
+    CORRADE_VERIFY(true);
+}
+
+void ThumbnailAtlasGLTest::constructMove() {
+    const Color4ub data[]{0xff3366_rgb};
+
+    ThumbnailAtlas a{{4, 4}, {9, 4}};
+    CORRADE_VERIFY(a.add(7, thumbnail(data, {1, 1})));
+    const GLuint id = a.page(0).id();
+
+    ThumbnailAtlas b{Utility::move(a)};
+    CORRADE_COMPARE(b.page(0).id(), id);
+    CORRADE_VERIFY(b.contains(7));
+
+    ThumbnailAtlas c{{8, 8}, {16, 16}};
+    c = Utility::move(b);
+    CORRADE_COMPARE(c.page(0).id(), id);
+    CORRADE_COMPARE(c.cellSize(), (Vector2i{4, 4}));
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<ThumbnailAtlas>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<ThumbnailAtlas>::value);
+}
+
+void ThumbnailAtlasGLTest::add() {
+    ThumbnailAtlas atlas{{4, 4}, {9, 4}, 2};
+
+    const Color4ub red[]{
+        0xff0000_rgb, 0xff0000_rgb,
+        0xff0000_rgb, 0xff0000_rgb
+    };
+    const Color4ub green[]{
+        0x00ff00_rgb, 0x00ff00_rgb, 0x00ff00_rgb, 0x00ff00_rgb,
+        0x00ff00_rgb, 0x00ff00_rgb, 0x00ff00_rgb, 0x00ff00_rgb,
+        0x00ff00_rgb, 0x00ff00_rgb, 0x00ff00_rgb, 0x00ff00_rgb,
+        0x00ff00_rgb, 0x00ff00_rgb, 0x00ff00_rgb, 0x00ff00_rgb
+    };
+    const Color4ub blue[]{0x0000ff_rgb};
+    CORRADE_VERIFY(atlas.add(100, thumbnail(red, {2, 2})));
+    CORRADE_VERIFY(atlas.add(200, thumbnail(green, {4, 4})));
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(atlas.pageCount(), 1);
+    CORRADE_COMPARE(atlas.thumbnailCount(), 2);
+
+    /* Third thumbnail doesn't fit into the first page anymore */
+    CORRADE_VERIFY(atlas.add(300, thumbnail(blue, {1, 1})));
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(atlas.pageCount(), 2);
+    CORRADE_COMPARE(atlas.thumbnailCount(), 3);
+    CORRADE_COMPARE(atlas.evictionCount(), 0);
+
+    CORRADE_VERIFY(atlas.contains(100));
+    CORRADE_VERIFY(atlas.contains(200));
+    CORRADE_VERIFY(atlas.contains(300));
+    CORRADE_VERIFY(!atlas.contains(400));
+
+    /* Texture coordinates cover only the image, not the whole cell */
+    UnsignedInt page = ~UnsignedInt{};
+    Range2D textureCoordinates;
+    CORRADE_VERIFY(atlas.use(100, page, textureCoordinates));
+    CORRADE_COMPARE(page, 0);
+    CORRADE_COMPARE(textureCoordinates, (Range2D{{}, {2.0f/9.0f, 0.5f}}));
+    CORRADE_VERIFY(atlas.use(200, page, textureCoordinates));
+    CORRADE_COMPARE(page, 0);
+    CORRADE_COMPARE(textureCoordinates, (Range2D{{5.0f/9.0f, 0.0f}, {1.0f, 1.0f}}));
+    CORRADE_VERIFY(atlas.use(300, page, textureCoordinates));
+    CORRADE_COMPARE(page, 1);
+    CORRADE_COMPARE(textureCoordinates, (Range2D{{}, {1.0f/9.0f, 0.25f}}));
+
+    /* Unknown key leaves the outputs untouched */
+    CORRADE_VERIFY(!atlas.use(400, page, textureCoordinates));
+    CORRADE_COMPARE(page, 1);
+
+    /* Verify the data ended up in the right place */
+    GL::Framebuffer framebuffer{{{}, atlas.pageSize()}};
+    framebuffer.attachTexture(GL::Framebuffer::ColorAttachment{0}, atlas.page(0), 0);
+    Image2D image = framebuffer.read({{}, atlas.pageSize()}, {PixelFormat::RGBA8Unorm});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(image.pixels<Color4ub>()[1][1], 0xff0000ff_rgba);
+    CORRADE_COMPARE(image.pixels<Color4ub>()[3][8], 0x00ff00ff_rgba);
+}
+
+void ThumbnailAtlasGLTest::addExisting() {
+    ThumbnailAtlas atlas{{4, 4}, {9, 4}, 1};
+
+    const Color4ub red[]{0xff0000_rgb, 0xff0000_rgb};
+    const Color4ub blue[]{0x0000ff_rgb, 0x0000ff_rgb, 0x0000ff_rgb};
+    CORRADE_VERIFY(atlas.add(100, thumbnail(red, {2, 1})));
+    CORRADE_VERIFY(atlas.add(200, thumbnail(red, {2, 1})));
+
+    /* Replacing is done in place, even though the atlas is full */
+    CORRADE_VERIFY(atlas.add(200, thumbnail(blue, {1, 3})));
+    CORRADE_COMPARE(atlas.thumbnailCount(), 2);
+    CORRADE_COMPARE(atlas.evictionCount(), 0);
+
+    UnsignedInt page;
+    Range2D textureCoordinates;
+    CORRADE_VERIFY(atlas.use(200, page, textureCoordinates));
+    CORRADE_COMPARE(page, 0);
+    CORRADE_COMPARE(textureCoordinates, (Range2D{{5.0f/9.0f, 0.0f}, {6.0f/9.0f, 0.75f}}));
+
+    GL::Framebuffer framebuffer{{{}, atlas.pageSize()}};
+    framebuffer.attachTexture(GL::Framebuffer::ColorAttachment{0}, atlas.page(0), 0);
+    Image2D image = framebuffer.read({{}, atlas.pageSize()}, {PixelFormat::RGBA8Unorm});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(image.pixels<Color4ub>()[2][5], 0x0000ffff_rgba);
+}
+
+void ThumbnailAtlasGLTest::addClearEdges() {
+    ThumbnailAtlas atlas{{4, 4}, {9, 4}, 1};
+
+    const Color4ub green[]{
+        0x00ff00_rgb, 0x00ff00_rgb, 0x00ff00_rgb, 0x00ff00_rgb,
+        0x00ff00_rgb, 0x00ff00_rgb, 0x00ff00_rgb, 0x00ff00_rgb,
+        0x00ff00_rgb, 0x00ff00_rgb, 0x00ff00_rgb, 0x00ff00_rgb,
+        0x00ff00_rgb, 0x00ff00_rgb, 0x00ff00_rgb, 0x00ff00_rgb
+    };
+    const Color4ub red[]{
+        0xff0000_rgb, 0xff0000_rgb,
+        0xff0000_rgb, 0xff0000_rgb
+    };
+
+    /* The second cell gets a full-size thumbnail, which is then replaced with
+       a smaller one */
+    CORRADE_VERIFY(atlas.add(100, thumbnail(green, {4, 4})));
+    CORRADE_VERIFY(atlas.add(200, thumbnail(green, {4, 4})));
+    CORRADE_VERIFY(atlas.add(200, thumbnail(red, {2, 2})));
+
+    GL::Framebuffer framebuffer{{{}, atlas.pageSize()}};
+    framebuffer.attachTexture(GL::Framebuffer::ColorAttachment{0}, atlas.page(0), 0);
+    Image2D image = framebuffer.read({{}, atlas.pageSize()}, {PixelFormat::RGBA8Unorm});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    Containers::StridedArrayView2D<const Color4ub> pixels = image.pixels<Color4ub>();
+
+    /* The padding column between the cells is cleared when the page gets
+       created */
+    for(std::size_t y = 0; y != 4; ++y) {
+        CORRADE_ITERATION(y);
+        CORRADE_COMPARE(pixels[y][4], 0x00000000_rgba);
+    }
+
+    /* The smaller thumbnail is there */
+    CORRADE_COMPARE(pixels[0][5], 0xff0000ff_rgba);
+    CORRADE_COMPARE(pixels[1][6], 0xff0000ff_rgba);
+
+    /* The column and row right after it, including the corner, are cleared,
+       the rest of the cell still has the previous thumbnail */
+    CORRADE_COMPARE(pixels[0][7], 0x00000000_rgba);
+    CORRADE_COMPARE(pixels[1][7], 0x00000000_rgba);
+    CORRADE_COMPARE(pixels[2][7], 0x00000000_rgba);
+    CORRADE_COMPARE(pixels[2][5], 0x00000000_rgba);
+    CORRADE_COMPARE(pixels[2][6], 0x00000000_rgba);
+    CORRADE_COMPARE(pixels[3][8], 0x00ff00ff_rgba);
+    CORRADE_COMPARE(pixels[0][8], 0x00ff00ff_rgba);
+}
+
+void ThumbnailAtlasGLTest::addInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    ThumbnailAtlas atlas{{4, 4}, {9, 4}};
+
+    const char data[4*4*5]{};
+    std::ostringstream out;
+    Error redirectError{&out};
+    atlas.add(0, ImageView2D{PixelFormat::RGB8Unorm, {1, 1}, Containers::arrayView(data)});
+    atlas.add(0, ImageView2D{PixelFormat::RGBA8Unorm, {4, 5}, Containers::arrayView(data)});
+    CORRADE_COMPARE(out.str(),
+        "ImGuiIntegration::ThumbnailAtlas::add(): expected PixelFormat::RGBA8Unorm but got PixelFormat::RGB8Unorm\n"
+        "ImGuiIntegration::ThumbnailAtlas::add(): image size {4, 5} is larger than cell size {4, 4}\n");
+}
+
+void ThumbnailAtlasGLTest::addEvict() {
+    ThumbnailAtlas atlas{{4, 4}, {9, 4}, 1};
+
+    const Color4ub data[]{0xff3366_rgb};
+    CORRADE_VERIFY(atlas.add(100, thumbnail(data, {1, 1})));
+    atlas.nextFrame();
+    CORRADE_VERIFY(atlas.add(200, thumbnail(data, {1, 1})));
+    atlas.nextFrame();
+
+    /* Using the first makes the second least recently used */
+    UnsignedInt page;
+    Range2D textureCoordinates;
+    CORRADE_VERIFY(atlas.use(100, page, textureCoordinates));
+    atlas.nextFrame();
+
+    CORRADE_VERIFY(atlas.add(300, thumbnail(data, {1, 1})));
+    CORRADE_COMPARE(atlas.pageCount(), 1);
+    CORRADE_COMPARE(atlas.thumbnailCount(), 2);
+    CORRADE_COMPARE(atlas.evictionCount(), 1);
+    CORRADE_VERIFY(atlas.contains(100));
+    CORRADE_VERIFY(!atlas.contains(200));
+    CORRADE_VERIFY(atlas.contains(300));
+
+    /* The new thumbnail took the evicted cell */
+    CORRADE_VERIFY(atlas.use(300, page, textureCoordinates));
+    CORRADE_COMPARE(textureCoordinates.min(), (Vector2{5.0f/9.0f, 0.0f}));
+}
+
+void ThumbnailAtlasGLTest::addFull() {
+    ThumbnailAtlas atlas{{4, 4}, {9, 4}, 1};
+
+    const Color4ub data[]{0xff3366_rgb};
+    CORRADE_VERIFY(atlas.add(100, thumbnail(data, {1, 1})));
+    CORRADE_VERIFY(atlas.add(200, thumbnail(data, {1, 1})));
+
+    /* Both were used in this frame, so nothing can be evicted */
+    CORRADE_VERIFY(!atlas.add(300, thumbnail(data, {1, 1})));
+    CORRADE_COMPARE(atlas.thumbnailCount(), 2);
+    CORRADE_COMPARE(atlas.evictionCount(), 0);
+    CORRADE_VERIFY(!atlas.contains(300));
+
+    /* In the next frame it's possible */
+    atlas.nextFrame();
+    CORRADE_VERIFY(atlas.add(300, thumbnail(data, {1, 1})));
+    CORRADE_COMPARE(atlas.evictionCount(), 1);
+    CORRADE_VERIFY(atlas.contains(300));
+}
+
+void ThumbnailAtlasGLTest::remove() {
+    ThumbnailAtlas atlas{{4, 4}, {9, 4}, 1};
+
+    const Color4ub data[]{0xff3366_rgb};
+    CORRADE_VERIFY(atlas.add(100, thumbnail(data, {1, 1})));
+    CORRADE_VERIFY(atlas.add(200, thumbnail(data, {1, 1})));
+
+    atlas.remove(100);
+    CORRADE_COMPARE(atlas.thumbnailCount(), 1);
+    CORRADE_VERIFY(!atlas.contains(100));
+
+    /* The freed cell gets reused without evicting anything, even though
+       everything was used in this frame */
+    CORRADE_VERIFY(atlas.add(300, thumbnail(data, {1, 1})));
+    CORRADE_COMPARE(atlas.evictionCount(), 0);
+    CORRADE_COMPARE(atlas.thumbnailCount(), 2);
+
+    UnsignedInt page;
+    Range2D textureCoordinates;
+    CORRADE_VERIFY(atlas.use(300, page, textureCoordinates));
+    CORRADE_COMPARE(textureCoordinates.min(), Vector2{});
+}
+
+void ThumbnailAtlasGLTest::removeInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    ThumbnailAtlas atlas{{4, 4}, {9, 4}};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    atlas.remove(0xc0ffee);
+    CORRADE_COMPARE(out.str(), "ImGuiIntegration::ThumbnailAtlas::remove(): key 0xc0ffee not found\n");
+}
+
+void ThumbnailAtlasGLTest::pageInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    ThumbnailAtlas atlas{{4, 4}, {9, 4}};
+
+    const Color4ub data[]{0xff3366_rgb};
+    CORRADE_VERIFY(atlas.add(100, thumbnail(data, {1, 1})));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    atlas.page(1);
+    CORRADE_COMPARE(out.str(), "ImGuiIntegration::ThumbnailAtlas::page(): index 1 out of range for 1 pages\n");
+}
+
+void ThumbnailAtlasGLTest::image() {
+    Context c{{200, 200}};
+    ThumbnailAtlas atlas{{4, 4}, {64, 64}};
+
+    const Color4ub data[]{0xff3366_rgb};
+    for(UnsignedLong i = 0; i != 10; ++i)
+        CORRADE_VERIFY(atlas.add(i, thumbnail(data, {1, 1})));
+    CORRADE_COMPARE(atlas.pageCount(), 1);
+
+    c.newFrame();
+    atlas.nextFrame();
+
+    ImGui::Begin("Thumbnails");
+    const std::size_t commandCount = ImGui::GetWindowDrawList()->CmdBuffer.size();
+    for(UnsignedLong i = 0; i != 10; ++i)
+        CORRADE_VERIFY(ImGuiIntegration::image(atlas, i, {4.0f, 4.0f}));
+    CORRADE_VERIFY(!ImGuiIntegration::image(atlas, 10, {4.0f, 4.0f}));
+
+    /* All thumbnails are from the same page, so they're merged into a single
+       draw command */
+    CORRADE_COMPARE(ImGui::GetWindowDrawList()->CmdBuffer.size(), commandCount + 1);
+    ImGui::End();
+
+    c.drawFrame();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* Thumbnails drawn in this frame are not evicted */
+    ThumbnailAtlas full{{4, 4}, {9, 4}, 1};
+    CORRADE_VERIFY(full.add(0, thumbnail(data, {1, 1})));
+    CORRADE_VERIFY(full.add(1, thumbnail(data, {1, 1})));
+    full.nextFrame();
+    c.newFrame();
+    CORRADE_VERIFY(ImGuiIntegration::image(full, 0, {1.0f, 1.0f}));
+    CORRADE_VERIFY(full.add(2, thumbnail(data, {1, 1})));
+    CORRADE_VERIFY(full.contains(0));
+    CORRADE_VERIFY(!full.contains(1));
+    c.drawFrame();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::ImGuiIntegration::Test::ThumbnailAtlasGLTest)
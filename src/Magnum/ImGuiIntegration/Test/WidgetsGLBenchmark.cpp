@@ -0,0 +1,233 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/* Explicitly disable deprecated functions on non-deprecated builds to catch
+   issues early. Doing this only in tests so the library itself can be used
+   with any newer version, but tests should be always run against the oldest
+   supported which is mentioned in doc/namespaces.dox, and which is downloaded
+   in all CI targets in package/ci/. The oldest supported version is tracked to
+   be roughly two years back. */
+#ifndef MAGNUM_BUILD_DEPRECATED
+#define IMGUI_DISABLE_OBSOLETE_FUNCTIONS
+#endif
+
+#include <cstdio>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Magnum/ImageView.h>
+#include <Magnum/PixelFormat.h>
+#include <Magnum/GL/Context.h>
+#include <Magnum/GL/Extensions.h>
+#include <Magnum/GL/Framebuffer.h>
+#include <Magnum/GL/OpenGLTester.h>
+#include <Magnum/GL/Renderbuffer.h>
+#include <Magnum/GL/RenderbufferFormat.h>
+#include <Magnum/GL/Texture.h>
+#include <Magnum/GL/TextureFormat.h>
+#ifndef MAGNUM_TARGET_WEBGL
+#include <Magnum/GL/TimeQuery.h>
+#endif
+
+#include "Magnum/ImGuiIntegration/Context.h"
+#include "Magnum/ImGuiIntegration/Widgets.h"
+
+namespace Magnum { namespace ImGuiIntegration { namespace Test { namespace {
+
+struct WidgetsGLBenchmark: GL::OpenGLTester {
+    explicit WidgetsGLBenchmark();
+
+    void setup();
+    void teardown();
+
+    void drawFrame();
+    #ifndef MAGNUM_TARGET_WEBGL
+    void drawFrameGpu();
+
+    void timeQueryBegin();
+    std::uint64_t timeQueryEnd();
+    #endif
+
+    private:
+        void buildUi();
+
+        GL::Renderbuffer _color{NoCreate};
+        GL::Framebuffer _framebuffer{NoCreate};
+        Containers::Array<GL::Texture2D> _textures;
+        Containers::Optional<Context> _context;
+        #ifndef MAGNUM_TARGET_WEBGL
+        GL::TimeQuery _timeQuery{NoCreate};
+        #endif
+};
+
+constexpr Vector2i Size{1024, 1024};
+/* 10x10 pixel images, filling the whole framebuffer */
+constexpr Int ImageCount = 100*100;
+
+const struct {
+    const char* name;
+    std::size_t textureCount;
+    bool button;
+} Data[]{
+    /* All images share the texture, so the whole UI is a single draw */
+    {"images, shared texture", 1, false},
+    /* Each image has a different texture, which means a draw per image */
+    {"images, 64 textures", 64, false},
+    {"image buttons, shared texture", 1, true},
+};
+
+WidgetsGLBenchmark::WidgetsGLBenchmark() {
+    addInstancedBenchmarks({&WidgetsGLBenchmark::drawFrame}, 50,
+        Containers::arraySize(Data),
+        &WidgetsGLBenchmark::setup,
+        &WidgetsGLBenchmark::teardown);
+
+    #ifndef MAGNUM_TARGET_WEBGL
+    addCustomInstancedBenchmarks({&WidgetsGLBenchmark::drawFrameGpu}, 50,
+        Containers::arraySize(Data),
+        &WidgetsGLBenchmark::setup,
+        &WidgetsGLBenchmark::teardown,
+        &WidgetsGLBenchmark::timeQueryBegin,
+        &WidgetsGLBenchmark::timeQueryEnd,
+        BenchmarkUnits::Nanoseconds);
+    #endif
+}
+
+void WidgetsGLBenchmark::buildUi() {
+    auto&& data = Data[testCaseInstanceId()];
+
+    /* Drawn into a single window covering the whole framebuffer, without any
+       padding so the images are laid out densely */
+    ImGui::SetNextWindowPos({0.0f, 0.0f});
+    ImGui::SetNextWindowSize({Float(Size.x()), Float(Size.y())});
+    ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, {0.0f, 0.0f});
+    ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, {0.0f, 0.0f});
+    ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, {0.0f, 0.0f});
+    ImGui::Begin("Widgets", nullptr, ImGuiWindowFlags_NoDecoration);
+    char id[16];
+    for(Int i = 0; i != ImageCount; ++i) {
+        GL::Texture2D& texture = _textures[i % _textures.size()];
+        if(data.button) {
+            std::snprintf(id, sizeof(id), "##%d", i);
+            imageButton(id, texture, {10.0f, 10.0f});
+        } else image(texture, {10.0f, 10.0f});
+        if((i + 1) % 100) ImGui::SameLine();
+    }
+    ImGui::End();
+    ImGui::PopStyleVar(3);
+}
+
+void WidgetsGLBenchmark::setup() {
+    auto&& data = Data[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    _color = GL::Renderbuffer{};
+    _color.setStorage(
+        #if !defined(MAGNUM_TARGET_GLES2) || !defined(MAGNUM_TARGET_WEBGL)
+        GL::RenderbufferFormat::RGBA8,
+        #else
+        GL::RenderbufferFormat::RGBA4,
+        #endif
+        Size);
+    _framebuffer = GL::Framebuffer{{{}, Size}};
+    _framebuffer
+        .attachRenderbuffer(GL::Framebuffer::ColorAttachment{0}, _color)
+        .bind();
+
+    const UnsignedByte pixels[]{0xff, 0x33, 0x66, 0xff};
+    _textures = Containers::Array<GL::Texture2D>{data.textureCount};
+    for(GL::Texture2D& texture: _textures) {
+        #ifndef MAGNUM_TARGET_GLES2
+        texture.setStorage(1, GL::TextureFormat::RGBA8, {1, 1});
+        texture.setSubImage(0, {}, ImageView2D{PixelFormat::RGBA8Unorm, {1, 1}, pixels});
+        #else
+        texture.setImage(0, GL::TextureFormat::RGBA,
+            ImageView2D{PixelFormat::RGBA8Unorm, {1, 1}, pixels});
+        #endif
+    }
+
+    _context.emplace(Vector2{Size}, Size, Size);
+
+    /* ImGui doesn't draw anything the first frame, the second frame then
+       creates all buffers and uploads glyphs needed by the UI */
+    for(Int i = 0; i != 2; ++i) {
+        _context->newFrame();
+        buildUi();
+        _context->drawFrame();
+    }
+}
+
+void WidgetsGLBenchmark::teardown() {
+    _context = Containers::NullOpt;
+    _textures = nullptr;
+    _framebuffer = GL::Framebuffer{NoCreate};
+    _color = GL::Renderbuffer{NoCreate};
+}
+
+#ifndef MAGNUM_TARGET_WEBGL
+void WidgetsGLBenchmark::timeQueryBegin() {
+    _timeQuery = GL::TimeQuery{GL::TimeQuery::Target::TimeElapsed};
+    _timeQuery.begin();
+}
+
+std::uint64_t WidgetsGLBenchmark::timeQueryEnd() {
+    _timeQuery.end();
+    return _timeQuery.result<UnsignedLong>();
+}
+#endif
+
+void WidgetsGLBenchmark::drawFrame() {
+    _context->newFrame();
+    buildUi();
+
+    CORRADE_BENCHMARK(1)
+        _context->drawFrame();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+#ifndef MAGNUM_TARGET_WEBGL
+void WidgetsGLBenchmark::drawFrameGpu() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::timer_query>())
+        CORRADE_SKIP(GL::Extensions::ARB::timer_query::string() << "is not supported.");
+    #else
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::disjoint_timer_query>())
+        CORRADE_SKIP(GL::Extensions::EXT::disjoint_timer_query::string() << "is not supported.");
+    #endif
+
+    _context->newFrame();
+    buildUi();
+
+    CORRADE_BENCHMARK(1)
+        _context->drawFrame();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+#endif
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::ImGuiIntegration::Test::WidgetsGLBenchmark)
@@ -0,0 +1,266 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ThumbnailAtlas.h"
+
+#include <unordered_map>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Move.h>
+#include <Magnum/ImageView.h>
+#include <Magnum/PixelFormat.h>
+#include <Magnum/GL/Texture.h>
+#include <Magnum/GL/TextureFormat.h>
+#include <Magnum/Math/Functions.h>
+
+#ifdef MAGNUM_TARGET_GLES2
+#include <Magnum/GL/PixelFormat.h>
+#endif
+
+#include "Magnum/ImGuiIntegration/Widgets.h"
+
+namespace Magnum { namespace ImGuiIntegration {
+
+namespace {
+
+/* Space between cells so linear filtering doesn't pick up the neighbors. It's
+   zero-filled when a page is created and never written to afterwards. */
+constexpr Int Padding = 1;
+
+}
+
+struct ThumbnailAtlas::State {
+    struct Cell {
+        UnsignedLong key;
+        UnsignedLong lastUsedFrame;
+        Vector2i size;
+        bool used;
+    };
+
+    Vector2i cellSize, pageSize;
+    UnsignedInt maxPageCount;
+    Int columns;
+    UnsignedInt cellsPerPage;
+
+    Containers::Array<GL::Texture2D> pages;
+    /* Cells of all created pages, the page a cell is in is its index
+       divided by cellsPerPage */
+    Containers::Array<Cell> cells;
+    Containers::Array<UnsignedInt> freeCells;
+    std::unordered_map<UnsignedLong, UnsignedInt> keys;
+
+    /* Zeros for clearing the row and column next to a thumbnail smaller
+       than the cell, large enough for the longer cell side */
+    Containers::Array<char> zeros;
+
+    UnsignedLong frame{};
+    UnsignedLong evictionCount{};
+
+    Vector2i cellOffset(UnsignedInt cell) const {
+        const Int id = cell % cellsPerPage;
+        return Vector2i{id % columns, id/columns}*(cellSize + Vector2i{Padding});
+    }
+};
+
+ThumbnailAtlas::ThumbnailAtlas(const Vector2i& cellSize, const Vector2i& pageSize, const UnsignedInt maxPageCount): _state{InPlaceInit} {
+    CORRADE_ASSERT(cellSize.product() && pageSize.product() && maxPageCount,
+        "ImGuiIntegration::ThumbnailAtlas: expected non-zero sizes and page count, got" << Debug::packed << cellSize << Debug::nospace << "," << Debug::packed << pageSize << Debug::nospace << "," << maxPageCount, );
+    /* The padding is only between cells, not after the last one */
+    const Vector2i grid = (pageSize + Vector2i{Padding})/(cellSize + Vector2i{Padding});
+    CORRADE_ASSERT(grid.product(),
+        "ImGuiIntegration::ThumbnailAtlas: cell size" << Debug::packed << cellSize << "doesn't fit into page size" << Debug::packed << pageSize, );
+
+    _state->cellSize = cellSize;
+    _state->pageSize = pageSize;
+    _state->maxPageCount = maxPageCount;
+    _state->columns = grid.x();
+    _state->cellsPerPage = grid.product();
+    _state->zeros = Containers::Array<char>{ValueInit, 4*std::size_t(Math::max(cellSize.x(), cellSize.y()))};
+}
+
+ThumbnailAtlas::ThumbnailAtlas(NoCreateT) noexcept {}
+
+ThumbnailAtlas::ThumbnailAtlas(ThumbnailAtlas&&) noexcept = default;
+
+ThumbnailAtlas::~ThumbnailAtlas() = default;
+
+ThumbnailAtlas& ThumbnailAtlas::operator=(ThumbnailAtlas&&) noexcept = default;
+
+Vector2i ThumbnailAtlas::cellSize() const { return _state->cellSize; }
+
+Vector2i ThumbnailAtlas::pageSize() const { return _state->pageSize; }
+
+UnsignedInt ThumbnailAtlas::maxPageCount() const { return _state->maxPageCount; }
+
+UnsignedInt ThumbnailAtlas::cellsPerPage() const { return _state->cellsPerPage; }
+
+UnsignedInt ThumbnailAtlas::pageCount() const { return _state->pages.size(); }
+
+GL::Texture2D& ThumbnailAtlas::page(const UnsignedInt id) {
+    CORRADE_ASSERT(id < _state->pages.size(),
+        "ImGuiIntegration::ThumbnailAtlas::page(): index" << id << "out of range for" << _state->pages.size() << "pages", _state->pages[0]);
+    return _state->pages[id];
+}
+
+std::size_t ThumbnailAtlas::thumbnailCount() const { return _state->keys.size(); }
+
+UnsignedLong ThumbnailAtlas::evictionCount() const { return _state->evictionCount; }
+
+bool ThumbnailAtlas::contains(const UnsignedLong key) const {
+    return _state->keys.find(key) != _state->keys.end();
+}
+
+bool ThumbnailAtlas::add(const UnsignedLong key, const ImageView2D& image) {
+    State& state = *_state;
+    CORRADE_ASSERT(image.format() == PixelFormat::RGBA8Unorm,
+        "ImGuiIntegration::ThumbnailAtlas::add(): expected" << PixelFormat::RGBA8Unorm << "but got" << image.format(), false);
+    CORRADE_ASSERT((image.size() <= state.cellSize).all(),
+        "ImGuiIntegration::ThumbnailAtlas::add(): image size" << Debug::packed << image.size() << "is larger than cell size" << Debug::packed << state.cellSize, false);
+
+    UnsignedInt cell;
+    auto found = state.keys.find(key);
+
+    /* Replacing an existing thumbnail, reuse its cell */
+    if(found != state.keys.end()) {
+        cell = found->second;
+
+    /* A previously removed or evicted cell is available */
+    } else if(!state.freeCells.isEmpty()) {
+        cell = state.freeCells.back();
+        arrayRemoveSuffix(state.freeCells, 1);
+
+    /* Create a new page, put the first cell into use and the rest to the
+       free list in reverse so they get used in order */
+    } else if(state.pages.size() < state.maxPageCount) {
+        /* The page is cleared once so the padding between cells and the
+           unused parts of cells don't contain garbage that linear filtering
+           would blend in */
+        const Containers::Array<char> zeros{ValueInit, 4*std::size_t(state.pageSize.product())};
+        GL::Texture2D texture;
+        texture.setMagnificationFilter(GL::SamplerFilter::Linear)
+            .setMinificationFilter(GL::SamplerFilter::Linear)
+            .setWrapping(GL::SamplerWrapping::ClampToEdge)
+            #ifndef MAGNUM_TARGET_GLES2
+            .setStorage(1, GL::TextureFormat::RGBA8, state.pageSize)
+            .setSubImage(0, {}, ImageView2D{PixelFormat::RGBA8Unorm, state.pageSize, zeros});
+            #else
+            .setImage(0, GL::TextureFormat::RGBA, ImageView2D{GL::PixelFormat::RGBA, GL::PixelType::UnsignedByte, state.pageSize, zeros});
+            #endif
+        arrayAppend(state.pages, Utility::move(texture));
+
+        cell = state.cells.size();
+        arrayAppend(state.cells, NoInit, state.cellsPerPage);
+        for(UnsignedInt i = cell + state.cellsPerPage - 1; i != cell; --i) {
+            state.cells[i].used = false;
+            arrayAppend(state.freeCells, i);
+        }
+
+    /* Evict the least recently used thumbnail, except for ones used in this
+       frame. Linear search, but it's only done once per added image and
+       only once the atlas is full, which is negligible compared to the
+       upload. */
+    } else {
+        cell = ~UnsignedInt{};
+        UnsignedLong oldest = state.frame;
+        for(UnsignedInt i = 0; i != state.cells.size(); ++i) {
+            const State::Cell& c = state.cells[i];
+            if(c.used && c.lastUsedFrame < oldest) {
+                oldest = c.lastUsedFrame;
+                cell = i;
+            }
+        }
+        if(cell == ~UnsignedInt{}) return false;
+
+        state.keys.erase(state.cells[cell].key);
+        ++state.evictionCount;
+    }
+
+    State::Cell& c = state.cells[cell];
+    c.key = key;
+    c.lastUsedFrame = state.frame;
+    c.size = image.size();
+    c.used = true;
+    state.keys[key] = cell;
+
+    const Vector2i offset = state.cellOffset(cell);
+    GL::Texture2D& page = state.pages[cell/state.cellsPerPage];
+    page.setSubImage(0, offset, image);
+
+    /* If the thumbnail is smaller than the cell, clear the column and row
+       right after it, including the corner. Those may contain a previous
+       larger thumbnail, which would bleed into the edges with linear
+       filtering. The rest of the cell isn't sampled. */
+    const Vector2i size = image.size();
+    const bool smallerY = size.y() < state.cellSize.y();
+    if(size.x() < state.cellSize.x())
+        page.setSubImage(0, offset + Vector2i::xAxis(size.x()),
+            ImageView2D{PixelFormat::RGBA8Unorm, {1, size.y() + (smallerY ? 1 : 0)}, state.zeros});
+    if(smallerY)
+        page.setSubImage(0, offset + Vector2i::yAxis(size.y()),
+            ImageView2D{PixelFormat::RGBA8Unorm, {size.x(), 1}, state.zeros});
+    return true;
+}
+
+void ThumbnailAtlas::remove(const UnsignedLong key) {
+    State& state = *_state;
+    auto found = state.keys.find(key);
+    CORRADE_ASSERT(found != state.keys.end(),
+        "ImGuiIntegration::ThumbnailAtlas::remove(): key" << Debug::hex << key << "not found", );
+
+    state.cells[found->second].used = false;
+    arrayAppend(state.freeCells, found->second);
+    state.keys.erase(found);
+}
+
+bool ThumbnailAtlas::use(const UnsignedLong key, UnsignedInt& page, Range2D& textureCoordinates) {
+    State& state = *_state;
+    auto found = state.keys.find(key);
+    if(found == state.keys.end()) return false;
+
+    State::Cell& c = state.cells[found->second];
+    c.lastUsedFrame = state.frame;
+
+    const Vector2i offset = state.cellOffset(found->second);
+    const Vector2 pageSize{state.pageSize};
+    page = found->second/state.cellsPerPage;
+    textureCoordinates = {Vector2{offset}/pageSize, Vector2{offset + c.size}/pageSize};
+    return true;
+}
+
+void ThumbnailAtlas::nextFrame() {
+    ++_state->frame;
+}
+
+bool image(ThumbnailAtlas& atlas, const UnsignedLong key, const Vector2& size, const Color4& tintColor, const Color4& borderColor) {
+    UnsignedInt page;
+    Range2D textureCoordinates;
+    if(!atlas.use(key, page, textureCoordinates)) return false;
+
+    image(atlas.page(page), size, textureCoordinates, tintColor, borderColor);
+    return true;
+}
+
+}}
@@ -0,0 +1,234 @@
+#ifndef Magnum_ImGuiIntegration_ThumbnailAtlas_h
+#define Magnum_ImGuiIntegration_ThumbnailAtlas_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::ImGuiIntegration::ThumbnailAtlas, function @ref Magnum::ImGuiIntegration::image(ThumbnailAtlas&, UnsignedLong, const Vector2&, const Color4&, const Color4&)
+ * @m_since_latest_{integration}
+ */
+
+#include <Corrade/Containers/Pointer.h>
+#include <Magnum/Magnum.h>
+#include <Magnum/GL/GL.h>
+#include <Magnum/Math/Color.h>
+#include <Magnum/Math/Range.h>
+
+#include "Magnum/ImGuiIntegration/visibility.h"
+
+namespace Magnum { namespace ImGuiIntegration {
+
+/**
+@brief Thumbnail atlas
+@m_since_latest_{integration}
+
+Packs many small images into a few shared RGBA8 texture pages. Each
+@ref ImGuiIntegration::image() or @relativeref{ImGuiIntegration,imageButton()}
+call with a distinct @ref GL::Texture2D results in a separate ImGui draw
+command and a texture bind in @ref Context::drawFrame(). Thumbnails drawn from
+the same atlas page are merged by ImGui into a single command. An asset
+browser with hundreds of thumbnails then needs only as many binds as there
+are pages.
+
+@section ImGuiIntegration-ThumbnailAtlas-usage Usage
+
+Each page is split into a grid of cells of the same @ref cellSize(). Every
+thumbnail occupies one cell and can be at most as large as the cell. Images
+are identified by an arbitrary user-provided key, such as a hash of the asset
+path. Use @ref add() to upload an image, and the
+@ref image(ThumbnailAtlas&, UnsignedLong, const Vector2&, const Color4&, const Color4&)
+overload to draw it. It returns @cpp false @ce if the image isn't in the
+atlas, in which case the application can draw a placeholder and add the
+image once it's loaded:
+
+@snippet ImGuiIntegration.cpp ThumbnailAtlas-usage
+
+@section ImGuiIntegration-ThumbnailAtlas-eviction Eviction
+
+New pages are created as needed, up to @ref maxPageCount(). When all cells
+are used, @ref add() evicts the thumbnail that was used the least recently,
+as tracked by @ref use() and @ref nextFrame(). Thumbnails used in the current
+frame are never evicted. If all of them were used in the current frame,
+@ref add() fails.
+
+Cells are separated by a single pixel of zero-filled padding so the
+thumbnails can be drawn with linear filtering without neighbors bleeding in.
+The same is done for the row and column next to a thumbnail smaller than its
+cell. No mipmaps are
+generated, so thumbnails are meant to be drawn at roughly their original
+size.
+
+@experimental
+*/
+class MAGNUM_IMGUIINTEGRATION_EXPORT ThumbnailAtlas {
+    public:
+        /**
+         * @brief Constructor
+         * @param cellSize      Maximal thumbnail size
+         * @param pageSize      Size of a single atlas page
+         * @param maxPageCount  Max count of pages
+         *
+         * Expects that all sizes and the page count are non-zero and that
+         * at least one cell with padding fits into a page. The pages are
+         * created on first use.
+         */
+        explicit ThumbnailAtlas(const Vector2i& cellSize, const Vector2i& pageSize = Vector2i{2048}, UnsignedInt maxPageCount = 4);
+
+        /**
+         * @brief Construct without creating the internal state
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         */
+        explicit ThumbnailAtlas(NoCreateT) noexcept;
+
+        /** @brief Copying is not allowed */
+        ThumbnailAtlas(const ThumbnailAtlas&) = delete;
+
+        /** @brief Move constructor */
+        ThumbnailAtlas(ThumbnailAtlas&&) noexcept;
+
+        ~ThumbnailAtlas();
+
+        /** @brief Copying is not allowed */
+        ThumbnailAtlas& operator=(const ThumbnailAtlas&) = delete;
+
+        /** @brief Move assignment */
+        ThumbnailAtlas& operator=(ThumbnailAtlas&&) noexcept;
+
+        /** @brief Cell size */
+        Vector2i cellSize() const;
+
+        /** @brief Page size */
+        Vector2i pageSize() const;
+
+        /** @brief Max count of pages */
+        UnsignedInt maxPageCount() const;
+
+        /** @brief Count of cells in a single page */
+        UnsignedInt cellsPerPage() const;
+
+        /**
+         * @brief Count of created pages
+         *
+         * At most @ref maxPageCount().
+         */
+        UnsignedInt pageCount() const;
+
+        /**
+         * @brief Page texture
+         *
+         * Expects that @p id is less than @ref pageCount().
+         */
+        GL::Texture2D& page(UnsignedInt id);
+
+        /** @brief Count of thumbnails in the atlas */
+        std::size_t thumbnailCount() const;
+
+        /**
+         * @brief Count of evicted thumbnails
+         *
+         * Count of thumbnails evicted by @ref add() since the atlas was
+         * created.
+         */
+        UnsignedLong evictionCount() const;
+
+        /** @brief Whether a thumbnail is in the atlas */
+        bool contains(UnsignedLong key) const;
+
+        /**
+         * @brief Add a thumbnail
+         *
+         * Expects that @p image is @ref PixelFormat::RGBA8Unorm and at most
+         * @ref cellSize(). If a thumbnail with given @p key is already in
+         * the atlas, it's replaced in the same cell. Otherwise it's put
+         * into a free cell, creating a new page if all cells are used,
+         * or replacing the least recently used thumbnail if
+         * @ref maxPageCount() is reached. Returns @cpp false @ce if all
+         * thumbnails were used in the current frame and there's no cell to
+         * put the image to, @cpp true @ce otherwise. The thumbnail is marked
+         * as used in the current frame.
+         */
+        bool add(UnsignedLong key, const ImageView2D& image);
+
+        /**
+         * @brief Remove a thumbnail
+         *
+         * Expects that the thumbnail is in the atlas. Its cell is reused by
+         * subsequent @ref add() calls.
+         */
+        void remove(UnsignedLong key);
+
+        /**
+         * @brief Use a thumbnail
+         * @param[in]  key                  Thumbnail key
+         * @param[out] page                 Page the thumbnail is on
+         * @param[out] textureCoordinates   Texture coordinates of the
+         *      thumbnail on the page
+         *
+         * If the thumbnail is in the atlas, marks it as used in the current
+         * frame, fills @p page and @p textureCoordinates and returns
+         * @cpp true @ce. Otherwise returns @cpp false @ce and leaves the
+         * output parameters untouched. Called by
+         * @ref image(ThumbnailAtlas&, UnsignedLong, const Vector2&, const Color4&, const Color4&).
+         */
+        bool use(UnsignedLong key, UnsignedInt& page, Range2D& textureCoordinates);
+
+        /**
+         * @brief Advance to the next frame
+         *
+         * Thumbnails used in earlier frames can be evicted by @ref add()
+         * after this call, least recently used first. Meant to be called
+         * once per frame, for example right after @ref Context::newFrame().
+         */
+        void nextFrame();
+
+    private:
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+/**
+@brief Image widget displaying a thumbnail from an atlas
+@param atlas        Thumbnail atlas
+@param key          Thumbnail key
+@param size         Widget size
+@param tintColor    Tint color, default @cpp 0xffffffff_rgbaf @ce
+@param borderColor  Border color, default @cpp 0x00000000_rgbaf @ce
+@m_since_latest_{integration}
+
+If the thumbnail is in the atlas, marks it as used via
+@ref ThumbnailAtlas::use(), draws it and returns @cpp true @ce. Otherwise
+draws nothing and returns @cpp false @ce. Consecutive thumbnails from the same
+page get merged into a single draw command.
+@see @ref image(GL::Texture2D&, const Vector2&, const Range2D&, const Color4&, const Color4&)
+*/
+MAGNUM_IMGUIINTEGRATION_EXPORT bool image(ThumbnailAtlas& atlas, UnsignedLong key, const Vector2& size, const Color4& tintColor = Color4{1.0f}, const Color4& borderColor = {});
+
+}}
+
+#endif
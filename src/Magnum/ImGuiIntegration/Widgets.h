@@ -62,6 +62,54 @@ inline ImTextureID textureId(GL::Texture2D& texture) {
     #endif
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+#ifndef DOXYGEN_GENERATING_OUTPUT
+/* Defined in Context.h, declared here to not need to include it */
+enum class RegisteredTexture: UnsignedInt;
+#endif
+
+/**
+@brief Create an `ImTextureID` for a registered texture
+@m_since_latest_{integration}
+
+The @p texture is expected to be returned from
+@ref Context::registerTexture() of the context that draws the commands
+using it.
+@see @ref image(RegisteredTexture, const Vector2&, const Range2D&, const Color4&, const Color4&),
+    @ref imageButton(const char*, RegisteredTexture, const Vector2&, const Range2D&, const Color4&, const Color4&)
+@requires_gles30 Not available in OpenGL ES 2.0 and WebGL 1.0.
+*/
+inline ImTextureID textureId(RegisteredTexture texture) {
+    #if IMGUI_VERSION_NUM >= 19131
+    return UnsignedInt(texture);
+    #else
+    return reinterpret_cast<ImTextureID>(std::uintptr_t(UnsignedInt(texture)));
+    #endif
+}
+#endif
+
+namespace Implementation {
+
+inline bool imageButton(const char* id, ImTextureID textureId, const Vector2& size, const Range2D& uvRange, const Color4& backgroundColor, const Color4& tintColor) {
+    /* Old function generating an implicit ID and taking frame padding from an
+       explicit variable was deprecated in 1.89 and removed in 1.91.1 */
+    #if (IMGUI_VERSION_NUM >= 18900 && defined(IMGUI_DISABLE_OBSOLETE_FUNCTIONS)) || IMGUI_VERSION_NUM >= 19110
+    return ImGui::ImageButton(id, textureId, ImVec2(size), ImVec2(uvRange.topLeft()), ImVec2(uvRange.bottomRight()), ImColor(backgroundColor), ImColor(tintColor));
+    #else
+    /* This is not exactly the same since the old function pushes another ID
+       based on the texture ID, but we can't disable that. Just a best effort
+       to still use the user-provided widget ID. There is ImageButtonEx()
+       taking an explicit ID, but its signature doesn't seem stable. */
+    ImGui::PushID(id);
+    /* Negative padding uses the FramePadding style */
+    const bool ret = ImGui::ImageButton(textureId, ImVec2(size), ImVec2(uvRange.topLeft()), ImVec2(uvRange.bottomRight()), -1, ImColor(backgroundColor), ImColor(tintColor));
+    ImGui::PopID();
+    return ret;
+    #endif
+}
+
+}
+
 /**
 @brief Image widget displaying a @ref GL::Texture2D
 @param texture      Texture to display
@@ -99,23 +147,45 @@ inline bool imageButton(const char* id, GL::Texture2D& texture, const Vector2& s
     const Color4& backgroundColor = {},
     const Color4& tintColor = Color4{1.0f})
 {
-    /* Old function generating an implicit ID and taking frame padding from an
-       explicit variable was deprecated in 1.89 and removed in 1.91.1 */
-    #if (IMGUI_VERSION_NUM >= 18900 && defined(IMGUI_DISABLE_OBSOLETE_FUNCTIONS)) || IMGUI_VERSION_NUM >= 19110
-    return ImGui::ImageButton(id, textureId(texture), ImVec2(size), ImVec2(uvRange.topLeft()), ImVec2(uvRange.bottomRight()), ImColor(backgroundColor), ImColor(tintColor));
-    #else
-    /* This is not exactly the same since the old function pushes another ID
-       based on the texture ID, but we can't disable that. Just a best effort
-       to still use the user-provided widget ID. There is ImageButtonEx()
-       taking an explicit ID, but its signature doesn't seem stable. */
-    ImGui::PushID(id);
-    /* Negative padding uses the FramePadding style */
-    const bool ret = ImGui::ImageButton(textureId(texture), ImVec2(size), ImVec2(uvRange.topLeft()), ImVec2(uvRange.bottomRight()), -1, ImColor(backgroundColor), ImColor(tintColor));
-    ImGui::PopID();
-    return ret;
-    #endif
+    return Implementation::imageButton(id, textureId(texture), size, uvRange, backgroundColor, tintColor);
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+/**
+@brief Image widget displaying a registered texture
+@m_since_latest_{integration}
+
+Same as @ref image(GL::Texture2D&, const Vector2&, const Range2D&, const Color4&, const Color4&)
+but drawing a texture registered with @ref Context::registerTexture().
+@see @ref textureId(RegisteredTexture)
+@requires_gles30 Not available in OpenGL ES 2.0 and WebGL 1.0.
+*/
+inline void image(RegisteredTexture texture, const Vector2& size,
+    const Range2D& uvRange = {{}, Vector2{1.0f}},
+    const Color4& tintColor = Color4{1.0f},
+    const Color4& borderColor = {})
+{
+    ImGui::Image(textureId(texture), ImVec2(size), ImVec2(uvRange.topLeft()), ImVec2(uvRange.bottomRight()), ImColor(tintColor), ImColor(borderColor));
 }
 
+/**
+@brief ImageButton widget displaying a registered texture
+@m_since_latest_{integration}
+
+Same as @ref imageButton(const char*, GL::Texture2D&, const Vector2&, const Range2D&, const Color4&, const Color4&)
+but drawing a texture registered with @ref Context::registerTexture().
+@see @ref textureId(RegisteredTexture)
+@requires_gles30 Not available in OpenGL ES 2.0 and WebGL 1.0.
+*/
+inline bool imageButton(const char* id, RegisteredTexture texture, const Vector2& size,
+    const Range2D& uvRange = {{}, Vector2{1.0f}},
+    const Color4& backgroundColor = {},
+    const Color4& tintColor = Color4{1.0f})
+{
+    return Implementation::imageButton(id, textureId(texture), size, uvRange, backgroundColor, tintColor);
+}
+#endif
+
 #ifdef MAGNUM_BUILD_DEPRECATED
 /**
 @brief ImageButton widget displaying a @ref GL::Texture2D
@@ -27,6 +27,13 @@
 
 #include "Compositor.h"
 
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/instrumentationIntegration.h"
+#include "Magnum/OvrIntegration/Context.h"
 #include "Magnum/OvrIntegration/Integration.h"
 #include "Magnum/OvrIntegration/Session.h"
 
@@ -50,22 +57,40 @@ Layer& Layer::setEnabled(bool enabled) {
 
 LayerEyeFov::LayerEyeFov(): HeadLockableLayer(LayerType::EyeFov) {}
 
+LayerEyeFov::LayerEyeFov(const LayerType type): HeadLockableLayer(type) {}
+
 LayerEyeFov& LayerEyeFov::setColorTexture(const Int eye, const TextureSwapChain& swapChain) {
     _layer.EyeFov.ColorTexture[eye] = swapChain.ovrTextureSwapChain();
 
     return *this;
 }
 
+LayerEyeFov& LayerEyeFov::setColorTexture(const TextureSwapChain& swapChain) {
+    _layer.EyeFov.ColorTexture[0] = swapChain.ovrTextureSwapChain();
+    _layer.EyeFov.ColorTexture[1] = swapChain.ovrTextureSwapChain();
+
+    return *this;
+}
+
 LayerEyeFov& LayerEyeFov::setViewport(const Int eye, const Range2Di& viewport) {
     _layer.EyeFov.Viewport[eye] = ovrRecti(viewport);
 
     return *this;
 }
 
+LayerEyeFov& LayerEyeFov::setSideBySideViewports(const Vector2i& size) {
+    const Int half = size.x()/2;
+    _layer.EyeFov.Viewport[0] = ovrRecti(Range2Di{{}, {half, size.y()}});
+    _layer.EyeFov.Viewport[1] = ovrRecti(Range2Di{{half, 0}, size});
+
+    return *this;
+}
+
 LayerEyeFov& LayerEyeFov::setRenderPoses(const Session& session) {
     const ovrPosef* poses = session.ovrEyePoses();
     _layer.EyeFov.RenderPose[0] = poses[0];
     _layer.EyeFov.RenderPose[1] = poses[1];
+    _layer.EyeFov.SensorSampleTime = session.sensorSampleTime();
 
     return *this;
 }
@@ -78,6 +103,32 @@ LayerEyeFov& LayerEyeFov::setFov(const Session& session) {
     return *this;
 }
 
+/* ovrLayerEyeFovDepth has the same layout as ovrLayerEyeFov until
+   SensorSampleTime, so the LayerEyeFov setters work on it as well */
+static_assert(offsetof(ovrLayerEyeFovDepth, SensorSampleTime) == offsetof(ovrLayerEyeFov, SensorSampleTime),
+    "ovrLayerEyeFovDepth is not layout-compatible with ovrLayerEyeFov");
+
+LayerEyeFovDepth::LayerEyeFovDepth(): LayerEyeFov(LayerType::EyeFovDepth) {}
+
+LayerEyeFovDepth& LayerEyeFovDepth::setDepthTexture(const Int eye, const TextureSwapChain& swapChain) {
+    _layer.EyeFovDepth.DepthTexture[eye] = swapChain.ovrTextureSwapChain();
+
+    return *this;
+}
+
+LayerEyeFovDepth& LayerEyeFovDepth::setDepthTexture(const TextureSwapChain& swapChain) {
+    _layer.EyeFovDepth.DepthTexture[0] = swapChain.ovrTextureSwapChain();
+    _layer.EyeFovDepth.DepthTexture[1] = swapChain.ovrTextureSwapChain();
+
+    return *this;
+}
+
+LayerEyeFovDepth& LayerEyeFovDepth::setProjection(const Matrix4& projection) {
+    _layer.EyeFovDepth.ProjectionDesc = ovrTimewarpProjectionDesc_FromProjection(ovrMatrix4f(projection), ovrProjection_ClipRangeOpenGL);
+
+    return *this;
+}
+
 LayerQuad::LayerQuad(): HeadLockableLayer(LayerType::Quad) {}
 
 LayerQuad& LayerQuad::setColorTexture(const TextureSwapChain& swapChain) {
@@ -104,12 +155,21 @@ LayerQuad& LayerQuad::setQuadSize(const Vector2& size) {
     return *this;
 }
 
-Compositor::Compositor() = default;
+static_assert(sizeof(LayerEyeFov) == sizeof(Layer) &&
+              sizeof(LayerEyeFovDepth) == sizeof(Layer) &&
+              sizeof(LayerQuad) == sizeof(Layer),
+    "layer types are expected to have no additional members");
+static_assert(std::is_trivially_destructible<Layer>::value,
+    "layers are expected to be trivially destructible");
+
+Compositor::Compositor(): _layerCount{} {}
 
 Layer& Compositor::addLayer(const LayerType type) {
     switch (type) {
         case LayerType::EyeFov:
             return addLayerEyeFov();
+        case LayerType::EyeFovDepth:
+            return addLayerEyeFovDepth();
         case LayerType::EyeMatrix:
             CORRADE_ASSERT(false,
                            "Layer type EyeMatrix is currently not supported.",
@@ -120,23 +180,53 @@ Layer& Compositor::addLayer(const LayerType type) {
     CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
 }
 
-Layer& Compositor::addLayer(std::unique_ptr<Layer> layer) {
-    _wrappedLayers.push_back(std::move(layer));
-    _layers.emplace_back(&_wrappedLayers.back().get()->layerHeader());
+template<class T> T& Compositor::addLayerInternal() {
+    CORRADE_ASSERT(_layerCount < ovrMaxLayerCount,
+        "Compositor::addLayer(): at most" << ovrMaxLayerCount << "layers can be added",
+        *reinterpret_cast<T*>(_layerStorage[ovrMaxLayerCount - 1]));
 
-    return *_wrappedLayers.back().get();
+    return *new(_layerStorage[_layerCount++]) T{};
 }
 
 LayerEyeFov& Compositor::addLayerEyeFov() {
-    return static_cast<LayerEyeFov&>(addLayer(std::move(std::unique_ptr<Layer>(new LayerEyeFov()))));
+    return addLayerInternal<LayerEyeFov>();
+}
+
+LayerEyeFovDepth& Compositor::addLayerEyeFovDepth() {
+    return addLayerInternal<LayerEyeFovDepth>();
 }
 
 LayerQuad& Compositor::addLayerQuad() {
-    return static_cast<LayerQuad&>(addLayer(std::move(std::unique_ptr<Layer>(new LayerQuad()))));
+    return addLayerInternal<LayerQuad>();
+}
+
+std::size_t Compositor::gatherEnabledLayers() {
+    std::size_t count = 0;
+    for(std::size_t i = 0; i != _layerCount; ++i) {
+        const Layer& layer = *reinterpret_cast<const Layer*>(_layerStorage[i]);
+        if(layer.isEnabled()) _enabledLayers[count++] = &layer.layerHeader();
+    }
+
+    return count;
 }
 
 Compositor& Compositor::submitFrame(Session& session) {
-    ovr_SubmitFrame(session.ovrSession(), session.incFrameIndex(), &session.ovrViewScaleDesc(), _layers.data(), _layers.size());
+    MAGNUM_INTEGRATION_CPU_ZONE("OvrIntegration::Compositor::submitFrame()");
+
+    const std::size_t count = gatherEnabledLayers();
+    ovr_SubmitFrame(session.ovrSession(), session.incFrameIndex(), &session.ovrViewScaleDesc(), _enabledLayers, count);
+
+    return *this;
+}
+
+Compositor& Compositor::endFrame(Session& session) {
+    MAGNUM_INTEGRATION_CPU_ZONE("OvrIntegration::Compositor::endFrame()");
+
+    const std::size_t count = gatherEnabledLayers();
+    const Long frameIndex = session.incFrameIndex();
+    const ovrResult result = ovr_EndFrame(session.ovrSession(), frameIndex, &session.ovrViewScaleDesc(), _enabledLayers, count);
+    if(OVR_FAILURE(result))
+        Corrade::Utility::Error() << "Compositor::endFrame(): ending frame" << frameIndex << "failed:" << Context::get().error().message;
 
     return *this;
 }
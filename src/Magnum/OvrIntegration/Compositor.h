@@ -28,11 +28,10 @@
 */
 
 /** @file
- * @brief Class @ref Magnum::OvrIntegration::Layer, @ref Magnum::OvrIntegration::HeadLockableLayer, @ref Magnum::OvrIntegration::LayerEyeFov, @ref Magnum::OvrIntegration::LayerQuad, @ref Magnum::OvrIntegration::Compositor, enum @ref Magnum::OvrIntegration::LayerType
+ * @brief Class @ref Magnum::OvrIntegration::Layer, @ref Magnum::OvrIntegration::HeadLockableLayer, @ref Magnum::OvrIntegration::LayerEyeFov, @ref Magnum::OvrIntegration::LayerEyeFovDepth, @ref Magnum::OvrIntegration::LayerQuad, @ref Magnum::OvrIntegration::Compositor, enum @ref Magnum::OvrIntegration::LayerType
  */
 
-#include <memory>
-#include <vector>
+#include <cstddef>
 #include <Magnum/Magnum.h>
 #include <OVR_CAPI.h>
 
@@ -53,6 +52,13 @@ enum class LayerType: Int {
      */
     EyeFov = ovrLayerType_EyeFov,
 
+    /**
+     * Described by `ovrLayerEyeFovDepth`.
+     * @see @ref LayerEyeFovDepth, @ref Compositor::addLayerEyeFovDepth()
+     * @m_since_latest_{integration}
+     */
+    EyeFovDepth = ovrLayerType_EyeFovDepth,
+
     /**
      * Described by `ovrLayerQuad`.
      * @see @ref LayerQuad, @ref Compositor::addLayerQuad()
@@ -110,9 +116,20 @@ class MAGNUM_OVRINTEGRATION_EXPORT Layer {
         /**
          * @brief Enable/disable the layer
          * @return Reference to self (for method chaining)
+         *
+         * Disabled layers are not passed to the compositor. Toggling the
+         * layer doesn't allocate, so it can be done every frame.
          */
         Layer& setEnabled(bool enabled);
 
+        /**
+         * @brief Whether the layer is enabled
+         * @m_since_latest_{integration}
+         */
+        bool isEnabled() const {
+            return _layer.Header.Type != ovrLayerType_Disabled;
+        }
+
         /** @brief Type of this layer */
         LayerType layerType() const {
             return _type;
@@ -180,6 +197,18 @@ class MAGNUM_OVRINTEGRATION_EXPORT LayerEyeFov: public HeadLockableLayer {
          */
         LayerEyeFov& setColorTexture(Int eye, const TextureSwapChain& swapChain);
 
+        /**
+         * @brief Set color texture for both eyes
+         * @param swapChain     Texture swap chain to set as color texture
+         * @return Reference to self (for method chaining)
+         * @m_since_latest_{integration}
+         *
+         * Uses the same texture swap chain for both eyes, usually created
+         * with @ref Session::createStereoTextureSwapChain(). Combine with
+         * @ref setSideBySideViewports() so each eye samples its own half.
+         */
+        LayerEyeFov& setColorTexture(const TextureSwapChain& swapChain);
+
         /**
          * @brief Set the viewport
          * @param eye           Eye index to set the viewport for
@@ -188,10 +217,24 @@ class MAGNUM_OVRINTEGRATION_EXPORT LayerEyeFov: public HeadLockableLayer {
          */
         LayerEyeFov& setViewport(Int eye, const Range2Di& viewport);
 
+        /**
+         * @brief Set side-by-side viewports for both eyes
+         * @param size          Size of the texture shared by both eyes
+         * @return Reference to self (for method chaining)
+         * @m_since_latest_{integration}
+         *
+         * Sets the left eye viewport to the left half of @p size and the
+         * right eye viewport to the right half, matching the layout of
+         * @ref Session::stereoTextureSize().
+         */
+        LayerEyeFov& setSideBySideViewports(const Vector2i& size);
+
         /**
          * @brief Set the render pose
          * @param session       Session to get the render pose from
          * @return Reference to self (for method chaining)
+         *
+         * @see @ref LateLatchedPoses
          */
         LayerEyeFov& setRenderPoses(const Session& session);
 
@@ -201,6 +244,78 @@ class MAGNUM_OVRINTEGRATION_EXPORT LayerEyeFov: public HeadLockableLayer {
          * @return Reference to self (for method chaining)
          */
         LayerEyeFov& setFov(const Session& session);
+
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    protected:
+        explicit LayerEyeFov(LayerType type);
+    #endif
+};
+
+/**
+@brief Wrapper around `ovrLayerEyeFovDepth`
+@m_since_latest_{integration}
+
+An eye layer that additionally carries a depth buffer for each eye, which
+allows the compositor to do positional timewarp and Asynchronous Spacewarp
+with a correct reprojection when the application drops frames. The depth
+textures have to be rendered with the same projection that's passed to
+@ref setProjection().
+
+@code{.cpp}
+std::unique_ptr<TextureSwapChain> depthChain[2];
+for(Int eye = 0; eye < 2; ++eye)
+    depthChain[eye] = session.createTextureSwapChain(textureSize[eye],
+        TextureSwapChainFormat::Depth24Stencil8);
+
+LayerEyeFovDepth& layer = Context::get().compositor().addLayerEyeFovDepth();
+layer.setFov(session);
+for(Int eye = 0; eye < 2; ++eye) {
+    layer.setColorTexture(eye, *textureChain[eye])
+         .setViewport(eye, {{}, textureSize[eye]});
+    layer.setDepthTexture(eye, *depthChain[eye]);
+}
+layer.setProjection(session.projectionMatrix(0, near, far));
+@endcode
+*/
+class MAGNUM_OVRINTEGRATION_EXPORT LayerEyeFovDepth: public LayerEyeFov {
+    public:
+        /** @brief Constructor */
+        explicit LayerEyeFovDepth();
+
+        /**
+         * @brief Set depth texture
+         * @param eye           Index of the eye the depth texture is set for
+         * @param swapChain     Texture swap chain with a depth
+         *      @ref TextureSwapChainFormat
+         * @return Reference to self (for method chaining)
+         *
+         * The depth texture is expected to have the same size and viewport
+         * as the color texture of the same eye.
+         */
+        LayerEyeFovDepth& setDepthTexture(Int eye, const TextureSwapChain& swapChain);
+
+        /**
+         * @brief Set depth texture for both eyes
+         * @param swapChain     Texture swap chain with a depth
+         *      @ref TextureSwapChainFormat
+         * @return Reference to self (for method chaining)
+         *
+         * Counterpart to @ref LayerEyeFov::setColorTexture(const TextureSwapChain&)
+         * for single-pass stereo rendering.
+         */
+        LayerEyeFovDepth& setDepthTexture(const TextureSwapChain& swapChain);
+
+        /**
+         * @brief Set projection used to render the depth textures
+         * @param projection    Projection matrix, usually created by
+         *      @ref Session::projectionMatrix()
+         * @return Reference to self (for method chaining)
+         *
+         * Used by the compositor to convert the depth values back to
+         * distances. Only the depth mapping of the matrix is used, which is
+         * the same for both eyes.
+         */
+        LayerEyeFovDepth& setProjection(const Matrix4& projection);
 };
 
 /** @brief Wrapper around `ovrLayerQuad` */
@@ -251,7 +366,7 @@ The compositor handles distortion, chromatic abberation, timewarp and sending
 images to a HMD's display.
 
 The compositor may contain a set of layers with different sizes and different
-properties. See @ref LayerEyeFov and @ref LayerQuad.
+properties. See @ref LayerEyeFov, @ref LayerEyeFovDepth and @ref LayerQuad.
 
 Setup of a distortion layer may look as follows:
 
@@ -273,13 +388,49 @@ for(Int eye = 0; eye < 2; ++eye) {
 }
 @endcode
 
-After that you need to render every frame by first rendering to the texture
-swap chains and then submitting the compositor frame via @ref Compositor::submitFrame().
+After that you need to render every frame by first waiting for the compositor
+with @ref Session::waitToBeginFrame(), polling the eye poses predicted for
+the frame, beginning the frame with @ref Session::beginFrame(), rendering to
+the texture swap chains and then submitting the compositor frame via
+@ref Compositor::endFrame(). Work that doesn't depend on the poses, such as
+simulation, can be done between the wait and polling the poses, while the GPU
+still renders the previous frame.
 
 @code{.cpp}
+session.waitToBeginFrame();
+
+// ... simulate
+
+session.pollEyePoses()
+       .beginFrame();
+
+// ... render to the texture swap chains
+
 layer.setRenderPoses(session);
 
-Context::get().compositor().submitFrame(session);
+Context::get().compositor().endFrame(session);
+@endcode
+
+Alternatively, @ref Compositor::submitFrame() does all of that in a single
+call, at the cost of the CPU being blocked until the compositor accepts the
+frame.
+
+@subsection OvrIntegration-Compositor-usage-stereo Single-pass stereo rendering
+
+Instead of a texture swap chain per eye, both eyes can be rendered side by
+side into a single texture swap chain. The scene can be then drawn in one
+pass, with each draw instanced twice and the per-eye matrices from
+@ref Session::viewProjectionMatrices() selected in the shader, halving the
+draw call overhead:
+
+@code{.cpp}
+std::unique_ptr<TextureSwapChain> textureChain =
+    session.createStereoTextureSwapChain();
+
+LayerEyeFov& layer = Context::get().compositor().addLayerEyeFov();
+layer.setFov(session)
+     .setColorTexture(*textureChain)
+     .setSideBySideViewports(session.stereoTextureSize());
 @endcode
 
 @see @ref Session, @ref TextureSwapChain, @ref Context::compositor()
@@ -298,10 +449,32 @@ class MAGNUM_OVRINTEGRATION_EXPORT Compositor {
         /** @brief Moving is not allowed */
         Compositor& operator=(Compositor&&) = delete;
 
+        /**
+         * @brief Max count of layers
+         * @m_since_latest_{integration}
+         *
+         * Layers are stored in a fixed-capacity pool inside the compositor,
+         * so adding them doesn't allocate and references to them stay valid
+         * for the whole compositor lifetime.
+         */
+        static constexpr std::size_t maxLayerCount() { return ovrMaxLayerCount; }
+
+        /**
+         * @brief Count of added layers
+         * @m_since_latest_{integration}
+         *
+         * Includes disabled layers.
+         * @see @ref Layer::setEnabled()
+         */
+        std::size_t layerCount() const { return _layerCount; }
+
         /**
          * @brief Add a layer of specific type
          *
-         * @see @ref addLayerEyeFov(), @ref addLayerQuad()
+         * Expects that less than @ref maxLayerCount() layers were added so
+         * far.
+         * @see @ref addLayerEyeFov(), @ref addLayerEyeFovDepth(),
+         *      @ref addLayerQuad()
          */
         Layer& addLayer(LayerType type);
 
@@ -312,6 +485,14 @@ class MAGNUM_OVRINTEGRATION_EXPORT Compositor {
          */
         LayerEyeFov& addLayerEyeFov();
 
+        /**
+         * @brief Create a @ref LayerEyeFovDepth
+         * @m_since_latest_{integration}
+         *
+         * @see @ref addLayer()
+         */
+        LayerEyeFovDepth& addLayerEyeFovDepth();
+
         /**
          * @brief Create a @ref LayerQuad
          *
@@ -323,9 +504,27 @@ class MAGNUM_OVRINTEGRATION_EXPORT Compositor {
          * @brief Submit the frame to the compositor
          * @param session       Session of the HMD to render to
          * @return Reference to self (for method chaining)
+         *
+         * Waits for, begins and ends the frame in a single call, which means
+         * the CPU can't start working on the next frame until the compositor
+         * accepts this one. Prefer to use @ref Session::waitToBeginFrame(),
+         * @ref Session::beginFrame() and @ref endFrame() instead.
          */
         Compositor& submitFrame(Session& session);
 
+        /**
+         * @brief End the frame and submit it to the compositor
+         * @param session       Session of the HMD to render to
+         * @return Reference to self (for method chaining)
+         * @m_since_latest_{integration}
+         *
+         * Submits the frame with index @ref Session::currentFrameIndex(),
+         * started with @ref Session::beginFrame(), and increments the frame
+         * index. Unlike @ref submitFrame() doesn't wait for the compositor,
+         * that's done by the next @ref Session::waitToBeginFrame() call.
+         */
+        Compositor& endFrame(Session& session);
+
     private:
         #ifndef DOXYGEN_GENERATING_OUTPUT
         /* Doxygen copies the description from Magnum::Context here. Ugh. */
@@ -334,10 +533,15 @@ class MAGNUM_OVRINTEGRATION_EXPORT Compositor {
 
         explicit Compositor();
 
-        Layer& addLayer(std::unique_ptr<Layer> layer);
+        template<class T> T& addLayerInternal();
+        std::size_t gatherEnabledLayers();
 
-        std::vector<const ovrLayerHeader*> _layers;
-        std::vector<std::unique_ptr<Layer>> _wrappedLayers;
+        /* All layer types have the same size, so they can be placed into a
+           fixed-size storage. Layer is trivially destructible, so the
+           storage doesn't need any explicit destruction. */
+        alignas(Layer) char _layerStorage[ovrMaxLayerCount][sizeof(Layer)];
+        std::size_t _layerCount;
+        const ovrLayerHeader* _enabledLayers[ovrMaxLayerCount];
 };
 
 }}
@@ -226,6 +226,20 @@ Debug& operator<<(Debug& debug, const LayerHudMode value) {
     return debug << "OvrIntegration::LayerHudMode::(invalid)";
 }
 
+Debug& operator<<(Debug& debug, const TextureSwapChainFormat value) {
+    switch(value) {
+        #define _c(value) case TextureSwapChainFormat::value: return debug << "OvrIntegration::TextureSwapChainFormat::" #value;
+        _c(RGBA8Srgb)
+        _c(RGBA8)
+        _c(Depth16)
+        _c(Depth24Stencil8)
+        _c(Depth32F)
+        #undef _c
+    }
+
+    return debug << "OvrIntegration::TextureSwapChainFormat::(invalid)";
+}
+
 Debug& operator<<(Debug& debug, const ErrorType value) {
     switch(value) {
         #define _c(value) case ErrorType::value: return debug << "OvrIntegration::ErrorType::" #value;
@@ -484,6 +484,32 @@ enum class LayerHudMode: Int {
 /** @debugoperatorenum{Magnum::OvrIntegration::LayerHudMode} */
 MAGNUM_OVRINTEGRATION_EXPORT Debug& operator<<(Debug& debug, LayerHudMode value);
 
+/**
+@brief Texture swap chain format
+@m_since_latest_{integration}
+
+@see @ref TextureSwapChain, @ref Session::createTextureSwapChain()
+*/
+enum class TextureSwapChainFormat: Int {
+    /** Four-component sRGB color */
+    RGBA8Srgb = OVR_FORMAT_R8G8B8A8_UNORM_SRGB,
+
+    /** Four-component linear color */
+    RGBA8 = OVR_FORMAT_R8G8B8A8_UNORM,
+
+    /** 16-bit normalized depth */
+    Depth16 = OVR_FORMAT_D16_UNORM,
+
+    /** 24-bit normalized depth with an 8-bit stencil */
+    Depth24Stencil8 = OVR_FORMAT_D24_UNORM_S8_UINT,
+
+    /** 32-bit floating-point depth */
+    Depth32F = OVR_FORMAT_D32_FLOAT
+};
+
+/** @debugoperatorenum{Magnum::OvrIntegration::TextureSwapChainFormat} */
+MAGNUM_OVRINTEGRATION_EXPORT Debug& operator<<(Debug& debug, TextureSwapChainFormat value);
+
 /**
 @brief Error type
 
@@ -0,0 +1,86 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "LateLatchedPoses.h"
+
+#include <array>
+#include <cstring>
+#include <Corrade/Utility/Assert.h>
+#include <Magnum/Math/DualQuaternion.h>
+#include <Magnum/Math/Matrix4.h>
+
+#include "Magnum/OvrIntegration/Session.h"
+
+namespace Magnum { namespace OvrIntegration {
+
+namespace {
+    /* Two view and two view projection matrices */
+    constexpr std::size_t PosesSize = 4*sizeof(Matrix4);
+}
+
+LateLatchedPoses::LateLatchedPoses(Session& session, const Float near, const Float far, const UnsignedInt framesInFlight): _session(session), _near{near}, _far{far}, _framesInFlight{framesInFlight} {
+    CORRADE_ASSERT(framesInFlight,
+        "LateLatchedPoses: expected a non-zero count of frames in flight", );
+
+    const std::size_t alignment = GL::Buffer::uniformOffsetAlignment();
+    _rangeSize = (PosesSize + alignment - 1)/alignment*alignment;
+
+    const std::size_t size = _rangeSize*_framesInFlight;
+    _buffer.setStorage(size, GL::Buffer::StorageFlag::MapWrite|GL::Buffer::StorageFlag::MapPersistent|GL::Buffer::StorageFlag::MapCoherent);
+    _mapped = _buffer.map(0, size, GL::Buffer::MapFlag::Write|GL::Buffer::MapFlag::Persistent|GL::Buffer::MapFlag::Coherent);
+    CORRADE_INTERNAL_ASSERT(_mapped.data());
+}
+
+std::size_t LateLatchedPoses::currentRangeOffset() const {
+    return std::size_t(_session.currentFrameIndex() % _framesInFlight)*_rangeSize;
+}
+
+void LateLatchedPoses::write() {
+    const std::array<DualQuaternion, 2> eyePoses = _session.eyePoses();
+    const std::array<Matrix4, 2> viewProjections = _session.viewProjectionMatrices(_near, _far);
+    const Matrix4 matrices[]{
+        eyePoses[0].toMatrix().invertedRigid(),
+        eyePoses[1].toMatrix().invertedRigid(),
+        viewProjections[0],
+        viewProjections[1]
+    };
+    static_assert(sizeof(matrices) == PosesSize, "");
+    std::memcpy(_mapped.data() + currentRangeOffset(), matrices, PosesSize);
+}
+
+LateLatchedPoses& LateLatchedPoses::bind(const UnsignedInt index) {
+    write();
+    _buffer.bind(GL::Buffer::Target::Uniform, index, currentRangeOffset(), PosesSize);
+    return *this;
+}
+
+LateLatchedPoses& LateLatchedPoses::latch() {
+    _session.pollEyePoses();
+    write();
+    return *this;
+}
+
+}}
@@ -0,0 +1,168 @@
+#ifndef Magnum_OvrIntegration_LateLatchedPoses_h
+#define Magnum_OvrIntegration_LateLatchedPoses_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::OvrIntegration::LateLatchedPoses
+ * @m_since_latest_{integration}
+ */
+
+#include <Corrade/Containers/ArrayView.h>
+#include <Magnum/GL/Buffer.h>
+
+#include "Magnum/OvrIntegration/OvrIntegration.h"
+#include "Magnum/OvrIntegration/visibility.h"
+
+namespace Magnum { namespace OvrIntegration {
+
+/**
+@brief Late-latched eye poses
+@m_since_latest_{integration}
+
+Keeps per-eye view and view projection matrices in a persistently mapped
+uniform buffer, so the eye poses can be refreshed with @ref latch() right
+before the frame is submitted to the @ref Compositor, after all draws reading
+them were already recorded. Draws the GPU didn't execute yet then render with
+the newer poses, which reduces the motion-to-photon latency without any
+change to how the draws are recorded.
+
+Each frame uses its own range of the buffer, cycling through
+@p framesInFlight ranges, so the poses of a frame aren't overwritten while the
+GPU still renders the previous one. One range has the following layout,
+matching a std140 uniform block:
+
+@code{.glsl}
+layout(std140) uniform EyePoses {
+    mat4 viewMatrix[2];
+    mat4 viewProjectionMatrix[2];
+};
+@endcode
+
+Call @ref bind() after @ref Session::pollEyePoses() before recording the
+draws, which also fills the range with the current poses, and @ref latch()
+right before @ref LayerEyeFov::setRenderPoses(), so the compositor gets the
+same poses as the latched ones:
+
+@code{.cpp}
+LateLatchedPoses poses{session, 0.01f, 100.0f};
+
+// every frame
+session.waitToBeginFrame()
+       .pollEyePoses()
+       .beginFrame();
+poses.bind(0);
+
+// ... record draws, taking the matrices from the EyePoses uniform block
+
+poses.latch();
+layer.setRenderPoses(session);
+Context::get().compositor().endFrame(session);
+@endcode
+
+Draws the GPU already executed before @ref latch() was called use the poses
+written by @ref bind(), so in a frame where the GPU catches up with the CPU a
+part of the scene may lag by the few milliseconds between the two calls. The
+compositor timewarp corrects only the whole image, so this is a trade-off
+between lower latency and consistency across draws.
+
+@requires_gl44 Extension @gl_extension{ARB,buffer_storage} for persistently
+    mapped buffers.
+*/
+class MAGNUM_OVRINTEGRATION_EXPORT LateLatchedPoses {
+    public:
+        /**
+         * @brief Constructor
+         * @param session           Session to get the poses from
+         * @param near              Distance to near frustum plane
+         * @param far               Distance to far frustum plane
+         * @param framesInFlight    Count of frames the GPU may have queued
+         *
+         * Allocates and persistently maps the uniform buffer. Expects that
+         * @p framesInFlight is not zero.
+         */
+        explicit LateLatchedPoses(Session& session, Float near, Float far, UnsignedInt framesInFlight = 3);
+
+        /** @brief Copying is not allowed */
+        LateLatchedPoses(const LateLatchedPoses&) = delete;
+
+        /** @brief Copying is not allowed */
+        LateLatchedPoses& operator=(const LateLatchedPoses&) = delete;
+
+        /** @brief Uniform buffer */
+        GL::Buffer& buffer() { return _buffer; }
+
+        /**
+         * @brief Size of a single frame range in the buffer
+         *
+         * At least 256 bytes, rounded up to
+         * @ref GL::Buffer::uniformOffsetAlignment().
+         */
+        std::size_t rangeSize() const { return _rangeSize; }
+
+        /**
+         * @brief Offset of the current frame range in the buffer
+         *
+         * Based on @ref Session::currentFrameIndex().
+         */
+        std::size_t currentRangeOffset() const;
+
+        /**
+         * @brief Write current poses and bind the current frame range
+         * @param index     Uniform buffer binding index
+         * @return Reference to self (for method chaining)
+         *
+         * Writes the poses since the last @ref Session::pollEyePoses() call
+         * to the range of the current frame and binds it to the uniform
+         * buffer binding @p index.
+         */
+        LateLatchedPoses& bind(UnsignedInt index);
+
+        /**
+         * @brief Refresh the poses in the current frame range
+         * @return Reference to self (for method chaining)
+         *
+         * Calls @ref Session::pollEyePoses() and writes the new poses to the
+         * range bound by the last @ref bind() call. As the buffer is mapped
+         * coherently, the GPU sees the new values without any additional
+         * synchronization.
+         */
+        LateLatchedPoses& latch();
+
+    private:
+        void write();
+
+        Session& _session;
+        Float _near, _far;
+        UnsignedInt _framesInFlight;
+        std::size_t _rangeSize;
+        GL::Buffer _buffer;
+        Containers::ArrayView<char> _mapped;
+};
+
+}}
+
+#endif
@@ -42,7 +42,11 @@ class Context;
 class Compositor;
 class Layer;
 class LayerEyeFov;
+class LayerEyeFovDepth;
+class LateLatchedPoses;
 class LayerQuad;
+class CompositorFrameStats;
+class PerformanceStats;
 
 enum class StatusFlag: Int;
 enum class HmdType: Int;
@@ -58,6 +62,7 @@ enum class PerformanceHudMode: Int;
 enum class DebugHudStereoMode: Int;
 enum class DetectResult: UnsignedByte;
 enum class LayerHudMode: Int;
+enum class TextureSwapChainFormat: Int;
 enum class LayerType: Int;
 enum class ErrorType: Int;
 
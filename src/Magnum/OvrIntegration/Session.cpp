@@ -27,6 +27,9 @@
 
 #include "Session.h"
 
+#include <Magnum/GL/Framebuffer.h>
+#include <Magnum/Math/Functions.h>
+
 #include <OVR_CAPI_GL.h>
 #undef near
 #undef far
@@ -65,11 +68,17 @@ Buttons InputState::buttons() const {
     return Buttons{static_cast<Button>(_state.Buttons)};
 }
 
+const CompositorFrameStats& PerformanceStats::frameStats(const Int i) const {
+    CORRADE_ASSERT(i >= 0 && i < _stats.FrameStatsCount,
+        "PerformanceStats::frameStats(): index" << i << "out of range for" << _stats.FrameStatsCount << "frames", CompositorFrameStats::wrap(_stats.FrameStats[0]));
+    return CompositorFrameStats::wrap(_stats.FrameStats[i]);
+}
+
 Touches InputState::touches() const {
      return Touches{static_cast<Touch>(_state.Touches)};
 }
 
-TextureSwapChain::TextureSwapChain(const Session& session, const Vector2i& size):
+TextureSwapChain::TextureSwapChain(const Session& session, const Vector2i& size, const TextureSwapChainFormat format):
     _session(session),
     _size(size),
     _curIndex(0)
@@ -78,13 +87,16 @@ TextureSwapChain::TextureSwapChain(const Session& session, const Vector2i& size)
     desc.Type = ovrTexture_2D;
     desc.Width = size.x();
     desc.Height = size.y();
-    desc.Format = OVR_FORMAT_R8G8B8A8_UNORM_SRGB;
+    desc.Format = ovrTextureFormat(Int(format));
     desc.ArraySize = 1;
     desc.MipLevels = 1;
     desc.SampleCount = 1;
     desc.StaticImage = ovrFalse;
     desc.MiscFlags = ovrTextureMisc_None;
-    desc.BindFlags = ovrTextureBind_None;
+    desc.BindFlags = format == TextureSwapChainFormat::Depth16 ||
+                     format == TextureSwapChainFormat::Depth24Stencil8 ||
+                     format == TextureSwapChainFormat::Depth32F ?
+        ovrTextureBind_DX_DepthStencil : ovrTextureBind_None;
 
     ovrResult result = ovr_CreateTextureSwapChainGL(_session.ovrSession(), &desc, &_textureSwapChain);
 
@@ -127,7 +139,14 @@ GL::Texture2D& TextureSwapChain::activeTexture() {
 Session::Session(::ovrSession session):
     _session(session),
     _hmdDesc(ovr_GetHmdDesc(_session)),
+    _predictedDisplayTime{},
+    _sensorSampleTime{},
+    _resolutionScale{1.0f},
+    _minResolutionScale{0.5f},
+    _frameIndex{},
     _ovrMirrorTexture(nullptr),
+    _mirrorInterval{1},
+    _mirrorEnabled{true},
     /* _hmdDesc.AvailableHmdCaps is either 0 or ovrHmdCap_DebugDevice
        and therefore can be simply cast to HmdStatusFlag */
     _flags(Implementation::HmdStatusFlag(_hmdDesc.AvailableHmdCaps)) {}
@@ -151,8 +170,13 @@ Session& Session::configureRendering() {
     return *this;
 }
 
-Vector2i Session::fovTextureSize(const Int eye) {
-    return Vector2i(ovr_GetFovTextureSize(_session, ovrEyeType(eye), _hmdDesc.DefaultEyeFov[eye], 1.0));
+Vector2i Session::fovTextureSize(const Int eye, const Float pixelDensity) {
+    return Vector2i(ovr_GetFovTextureSize(_session, ovrEyeType(eye), _hmdDesc.DefaultEyeFov[eye], pixelDensity));
+}
+
+Vector2i Session::stereoTextureSize(const Float pixelDensity) {
+    const Vector2i size = Math::max(fovTextureSize(0, pixelDensity), fovTextureSize(1, pixelDensity));
+    return {size.x()*2, size.y()};
 }
 
 GL::Texture2D& Session::createMirrorTexture(const Vector2i& size, const MirrorOptions mirrorOptions) {
@@ -180,16 +204,51 @@ GL::Texture2D& Session::createMirrorTexture(const Vector2i& size, const MirrorOp
     UnsignedInt id;
     ovr_GetMirrorTextureBufferGL(_session, _ovrMirrorTexture, &id);
     _mirrorTexture.reset(new GL::Texture2D(GL::Texture2D::wrap(id)));
+    _flags |= Implementation::HmdStatusFlag::HasMirrorTexture;
 
     return *_mirrorTexture;
 }
 
+bool Session::blitMirror(GL::AbstractFramebuffer& destination, const Range2Di& destinationRectangle) {
+    CORRADE_ASSERT(_flags & Implementation::HmdStatusFlag::HasMirrorTexture,
+        "Session::blitMirror(): no mirror texture created", false);
+
+    if(!_mirrorEnabled || destinationRectangle.sizeX() <= 0 || destinationRectangle.sizeY() <= 0 || _frameIndex % _mirrorInterval)
+        return false;
+
+    const Vector2i size = _mirrorTexture->imageSize(0);
+    if(!_mirrorFramebuffer) {
+        _mirrorFramebuffer.reset(new GL::Framebuffer{{{}, size}});
+        _mirrorFramebuffer->attachTexture(GL::Framebuffer::ColorAttachment(0), *_mirrorTexture, 0)
+            .mapForRead(GL::Framebuffer::ColorAttachment(0));
+    }
+
+    /* The mirror texture is upside down compared to GL conventions */
+    GL::AbstractFramebuffer::blit(*_mirrorFramebuffer, destination,
+        {{0, size.y()}, {size.x(), 0}}, destinationRectangle,
+        GL::FramebufferBlit::Color,
+        destinationRectangle.size() == size ?
+            GL::FramebufferBlitFilter::Nearest : GL::FramebufferBlitFilter::Linear);
+    return true;
+}
+
+Session& Session::setMirrorInterval(const UnsignedInt interval) {
+    CORRADE_ASSERT(interval,
+        "Session::setMirrorInterval(): expected a non-zero interval", *this);
+    _mirrorInterval = interval;
+    return *this;
+}
+
 std::unique_ptr<TextureSwapChain> Session::createTextureSwapChain(const Int eye) {
     return std::unique_ptr<TextureSwapChain>(new TextureSwapChain(*this, fovTextureSize(eye)));
 }
 
-std::unique_ptr<TextureSwapChain> Session::createTextureSwapChain(const Vector2i& size) {
-    return std::unique_ptr<TextureSwapChain>(new TextureSwapChain(*this, size));
+std::unique_ptr<TextureSwapChain> Session::createTextureSwapChain(const Vector2i& size, const TextureSwapChainFormat format) {
+    return std::unique_ptr<TextureSwapChain>(new TextureSwapChain(*this, size, format));
+}
+
+std::unique_ptr<TextureSwapChain> Session::createStereoTextureSwapChain() {
+    return createTextureSwapChain(stereoTextureSize());
 }
 
 Matrix4 Session::projectionMatrix(const Int eye, Float near, Float far) const {
@@ -204,6 +263,69 @@ Matrix4 Session::orthoSubProjectionMatrix(const Int eye, const Matrix4& proj, co
     return Matrix4(sub);
 }
 
+std::array<Matrix4, 2> Session::viewProjectionMatrices(const Float near, const Float far) const {
+    std::array<Matrix4, 2> out;
+    for(Int eye = 0; eye < 2; ++eye)
+        out[eye] = projectionMatrix(eye, near, far)*DualQuaternion(_ovrPoses[eye]).toMatrix().invertedRigid();
+    return out;
+}
+
+Session& Session::waitToBeginFrame() {
+    const ovrResult result = ovr_WaitToBeginFrame(_session, _frameIndex);
+    if(OVR_FAILURE(result))
+        Corrade::Utility::Error() << "Session::waitToBeginFrame(): waiting for frame" << _frameIndex << "failed:" << Context::get().error().message;
+
+    /* Only now the prediction is accurate for this frame */
+    _predictedDisplayTime = ovr_GetPredictedDisplayTime(_session, _frameIndex);
+    return *this;
+}
+
+Session& Session::beginFrame() {
+    const ovrResult result = ovr_BeginFrame(_session, _frameIndex);
+    if(OVR_FAILURE(result))
+        Corrade::Utility::Error() << "Session::beginFrame(): beginning frame" << _frameIndex << "failed:" << Context::get().error().message;
+
+    return *this;
+}
+
+Session& Session::pollPerformanceStats() {
+    const ovrResult result = ovr_GetPerfStats(_session, &_performanceStats.ovrPerfStats());
+    if(OVR_FAILURE(result)) {
+        Corrade::Utility::Error() << "Session::pollPerformanceStats(): querying performance stats failed:" << Context::get().error().message;
+        _performanceStats = PerformanceStats{};
+    }
+
+    return *this;
+}
+
+Session& Session::updateResolutionScale() {
+    pollPerformanceStats();
+
+    /* No frames since the last call, nothing to react to */
+    if(!_performanceStats.frameStatsCount()) return *this;
+
+    /* The performance scale is relative to the pixel count, while the
+       resolution scale is applied to both dimensions */
+    return setResolutionScale(_resolutionScale*Math::sqrt(_performanceStats.adaptiveGpuPerformanceScale()));
+}
+
+Session& Session::setResolutionScale(const Float scale) {
+    _resolutionScale = Math::clamp(scale, _minResolutionScale, 1.0f);
+    return *this;
+}
+
+Session& Session::setMinResolutionScale(const Float scale) {
+    CORRADE_ASSERT(scale > 0.0f && scale <= 1.0f,
+        "Session::setMinResolutionScale(): expected a scale in range (0, 1], got" << scale, *this);
+    _minResolutionScale = scale;
+    return setResolutionScale(_resolutionScale);
+}
+
+Range2Di Session::scaleViewport(const Range2Di& viewport) const {
+    return Range2Di::fromSize(viewport.min(),
+        Math::max(Vector2i{Math::round(Vector2{viewport.size()}*_resolutionScale)}, Vector2i{1}));
+}
+
 Session& Session::pollTrackers() {
     _predictedDisplayTime = ovr_GetPredictedDisplayTime(_session, _frameIndex);
     _trackingState = ovr_GetTrackingState(_session, _predictedDisplayTime, true);
@@ -211,6 +333,7 @@ Session& Session::pollTrackers() {
 }
 
 Session& Session::pollEyePoses() {
+    _sensorSampleTime = ovr_GetTimeInSeconds();
     pollTrackers();
     ovr_CalcEyePoses(_trackingState.HeadPose.ThePose, _hmdToEyePose, _ovrPoses);
     return *this;
@@ -221,6 +344,35 @@ Session& Session::pollController(const ControllerType types, InputState& state)
     return *this;
 }
 
+Session& Session::pollInput(const ControllerType types) {
+    _previousInputState = _inputState;
+    return pollController(types, _inputState);
+}
+
+Buttons Session::changedButtons() const {
+    return Buttons{static_cast<Button>(_inputState.ovrInputState().Buttons ^ _previousInputState.ovrInputState().Buttons)};
+}
+
+Buttons Session::pressedButtons() const {
+    return Buttons{static_cast<Button>(_inputState.ovrInputState().Buttons & ~_previousInputState.ovrInputState().Buttons)};
+}
+
+Buttons Session::releasedButtons() const {
+    return Buttons{static_cast<Button>(~_inputState.ovrInputState().Buttons & _previousInputState.ovrInputState().Buttons)};
+}
+
+Touches Session::changedTouches() const {
+    return Touches{static_cast<Touch>(_inputState.ovrInputState().Touches ^ _previousInputState.ovrInputState().Touches)};
+}
+
+Touches Session::touchesBegan() const {
+    return Touches{static_cast<Touch>(_inputState.ovrInputState().Touches & ~_previousInputState.ovrInputState().Touches)};
+}
+
+Touches Session::touchesEnded() const {
+    return Touches{static_cast<Touch>(~_inputState.ovrInputState().Touches & _previousInputState.ovrInputState().Touches)};
+}
+
 SessionStatusFlags Session::status() const {
     ovrSessionStatus status;
     ovr_GetSessionStatus(_session, &status);
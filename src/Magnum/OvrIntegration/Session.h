@@ -28,7 +28,7 @@
 */
 
 /** @file
- * @brief Class @ref Magnum::OvrIntegration::PoseState, @ref Magnum::OvrIntegration::InputState, @ref Magnum::OvrIntegration::TextureSwapChain, @ref Magnum::OvrIntegration::Session,
+ * @brief Class @ref Magnum::OvrIntegration::PoseState, @ref Magnum::OvrIntegration::InputState, @ref Magnum::OvrIntegration::CompositorFrameStats, @ref Magnum::OvrIntegration::PerformanceStats, @ref Magnum::OvrIntegration::TextureSwapChain, @ref Magnum::OvrIntegration::Session,
  */
 
 #include <array>
@@ -38,6 +38,7 @@
 #include <OVR_CAPI.h>
 #include <OVR_CAPI_Keys.h>
 
+#include "Magnum/OvrIntegration/Enums.h"
 #include "Magnum/OvrIntegration/Integration.h"
 #include "Magnum/OvrIntegration/OvrIntegration.h"
 #include "Magnum/OvrIntegration/visibility.h"
@@ -188,10 +189,202 @@ class MAGNUM_OVRINTEGRATION_EXPORT InputState {
             return _state;
         }
 
+        /**
+         * @overload
+         * @m_since_latest_{integration}
+         */
+        const ::ovrInputState& ovrInputState() const {
+            return _state;
+        }
+
     private:
         ::ovrInputState _state;
 };
 
+/**
+@brief Performance statistics of a single compositor frame
+@m_since_latest_{integration}
+
+Wraps `ovrPerfStatsPerCompositorFrame`. All times are in seconds.
+@see @ref PerformanceStats::frameStats()
+*/
+class MAGNUM_OVRINTEGRATION_EXPORT CompositorFrameStats {
+    public:
+        /**
+         * @brief Wrap a `ovrPerfStatsPerCompositorFrame` as @ref CompositorFrameStats
+         * @return @p stats as @ref CompositorFrameStats reference
+         */
+        static const CompositorFrameStats& wrap(const ::ovrPerfStatsPerCompositorFrame& stats) {
+            return reinterpret_cast<const CompositorFrameStats&>(stats);
+        }
+
+        /**
+         * @brief Constructor
+         *
+         * Default initializes underlying `ovrPerfStatsPerCompositorFrame`.
+         */
+        CompositorFrameStats(): _stats() {}
+
+        /**
+         * @brief Constructor with initial `ovrPerfStatsPerCompositorFrame`
+         *
+         * Initializes underlying `ovrPerfStatsPerCompositorFrame` with
+         * given @p stats.
+         */
+        CompositorFrameStats(const ovrPerfStatsPerCompositorFrame& stats): _stats(stats) {}
+
+        /** @brief Index of the HMD vertical sync this frame was shown at */
+        Int hmdVsyncIndex() const { return _stats.HmdVsyncIndex; }
+
+        /**
+         * @brief Index of the last application frame submitted
+         *
+         * Corresponds to @ref Session::currentFrameIndex() at the time the
+         * frame was submitted.
+         */
+        Int appFrameIndex() const { return _stats.AppFrameIndex; }
+
+        /** @brief Count of application frames that missed their vertical sync */
+        Int appDroppedFrameCount() const { return _stats.AppDroppedFrameCount; }
+
+        /** @brief Motion-to-photon latency of the application */
+        Float appMotionToPhotonLatency() const { return _stats.AppMotionToPhotonLatency; }
+
+        /** @brief Amount of time the application queued ahead */
+        Float appQueueAheadTime() const { return _stats.AppQueueAheadTime; }
+
+        /** @brief CPU time the application spent on the frame */
+        Float appCpuElapsedTime() const { return _stats.AppCpuElapsedTime; }
+
+        /** @brief GPU time the application spent on the frame */
+        Float appGpuElapsedTime() const { return _stats.AppGpuElapsedTime; }
+
+        /** @brief Index of the compositor frame */
+        Int compositorFrameIndex() const { return _stats.CompositorFrameIndex; }
+
+        /** @brief Count of compositor frames that missed their vertical sync */
+        Int compositorDroppedFrameCount() const { return _stats.CompositorDroppedFrameCount; }
+
+        /** @brief Latency from compositor sampling the pose to photons */
+        Float compositorLatency() const { return _stats.CompositorLatency; }
+
+        /** @brief CPU time the compositor spent on the frame */
+        Float compositorCpuElapsedTime() const { return _stats.CompositorCpuElapsedTime; }
+
+        /** @brief GPU time the compositor spent on the frame */
+        Float compositorGpuElapsedTime() const { return _stats.CompositorGpuElapsedTime; }
+
+        /** @brief Time from compositor CPU start to the end of its GPU work */
+        Float compositorCpuStartToGpuEndElapsedTime() const { return _stats.CompositorCpuStartToGpuEndElapsedTime; }
+
+        /** @brief Time from the end of compositor GPU work to vertical sync */
+        Float compositorGpuEndToVsyncElapsedTime() const { return _stats.CompositorGpuEndToVsyncElapsedTime; }
+
+        /** @brief Whether Asynchronous Spacewarp was active for the frame */
+        bool isAswActive() const { return _stats.AswIsActive; }
+
+        /** @brief Count of times Asynchronous Spacewarp got toggled on */
+        Int aswActivatedToggleCount() const { return _stats.AswActivatedToggleCount; }
+
+        /** @brief Count of frames presented by Asynchronous Spacewarp */
+        Int aswPresentedFrameCount() const { return _stats.AswPresentedFrameCount; }
+
+        /** @brief Count of frames Asynchronous Spacewarp failed to present */
+        Int aswFailedFrameCount() const { return _stats.AswFailedFrameCount; }
+
+        /** @brief The underlying `ovrPerfStatsPerCompositorFrame` */
+        const ::ovrPerfStatsPerCompositorFrame& ovrPerfStatsPerCompositorFrame() const {
+            return _stats;
+        }
+
+    private:
+        ::ovrPerfStatsPerCompositorFrame _stats;
+};
+
+/**
+@brief Performance statistics
+@m_since_latest_{integration}
+
+Wraps `ovrPerfStats`, containing statistics of compositor frames since the
+previous @ref Session::pollPerformanceStats() call. Example logging of dropped
+frames:
+
+@code{.cpp}
+const PerformanceStats& stats = session.pollPerformanceStats().performanceStats();
+for(Int i = 0; i != stats.frameStatsCount(); ++i) {
+    const CompositorFrameStats& frame = stats.frameStats(i);
+    if(frame.appDroppedFrameCount())
+        Debug{} << "Frame" << frame.appFrameIndex() << "dropped, GPU time"
+            << frame.appGpuElapsedTime();
+}
+@endcode
+*/
+class MAGNUM_OVRINTEGRATION_EXPORT PerformanceStats {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * Default initializes underlying `ovrPerfStats`.
+         */
+        PerformanceStats(): _stats() {}
+
+        /**
+         * @brief Constructor with initial `ovrPerfStats`
+         *
+         * Initializes underlying `ovrPerfStats` with given @p stats.
+         */
+        PerformanceStats(const ovrPerfStats& stats): _stats(stats) {}
+
+        /**
+         * @brief Count of available compositor frame statistics
+         *
+         * At most `ovrMaxProvidedFrameStats`.
+         */
+        Int frameStatsCount() const { return _stats.FrameStatsCount; }
+
+        /**
+         * @brief Statistics of a compositor frame
+         *
+         * Index @cpp 0 @ce is the most recent frame. Expects that @p i is
+         * less than @ref frameStatsCount().
+         */
+        const CompositorFrameStats& frameStats(Int i) const;
+
+        /**
+         * @brief Whether some frame statistics were dropped
+         *
+         * Happens when more than `ovrMaxProvidedFrameStats` compositor frames
+         * were shown since the previous query.
+         */
+        bool anyFrameStatsDropped() const { return _stats.AnyFrameStatsDropped; }
+
+        /**
+         * @brief Recommended GPU performance scale
+         *
+         * Values below @cpp 1.0f @ce mean the application should reduce the
+         * pixel count to hit the display refresh rate, values above mean
+         * there is headroom.
+         * @see @ref Session::updateResolutionScale()
+         */
+        Float adaptiveGpuPerformanceScale() const { return _stats.AdaptiveGpuPerformanceScale; }
+
+        /** @brief Whether Asynchronous Spacewarp is available */
+        bool isAswAvailable() const { return _stats.AswIsAvailable; }
+
+        /** @brief The underlying `ovrPerfStats` */
+        ::ovrPerfStats& ovrPerfStats() {
+            return _stats;
+        }
+
+        /** @overload */
+        const ::ovrPerfStats& ovrPerfStats() const {
+            return _stats;
+        }
+
+    private:
+        ::ovrPerfStats _stats;
+};
+
 /**
 @brief Texture swap chain
 
@@ -205,8 +398,11 @@ class MAGNUM_OVRINTEGRATION_EXPORT TextureSwapChain {
          * @brief Constructor
          * @param session   HMD for which this texture swap chain is created
          * @param size      Size for the textures
+         * @param format    Texture format. Use one of the depth formats for
+         *      depth textures passed to
+         *      @ref LayerEyeFovDepth::setDepthTexture().
          */
-        explicit TextureSwapChain(const Session& session,  const Vector2i& size);
+        explicit TextureSwapChain(const Session& session,  const Vector2i& size, TextureSwapChainFormat format = TextureSwapChainFormat::RGBA8Srgb);
         ~TextureSwapChain();
 
         /** @brief Currently active texture in the set */
@@ -321,6 +517,23 @@ GL::Framebuffer::blit(mirrorFramebuffer,
                       GL::FramebufferBlit::Color, GL::FramebufferBlitFilter::Nearest);
 @endcode
 
+Alternatively, @ref blitMirror() does the above with a framebuffer managed by
+the session. To reduce the cost of the mirror, create the mirror texture at a
+smaller size than the window --- the compositor then renders a downscaled
+copy directly --- mirror only every n-th frame using @ref setMirrorInterval()
+and disable it with @ref setMirrorEnabled() while the window is minimized or
+hidden:
+
+@code{.cpp}
+session->createMirrorTexture(windowSize()/2);
+session->setMirrorInterval(2);
+
+// ...
+
+if(session->blitMirror(GL::defaultFramebuffer, GL::defaultFramebuffer.viewport()))
+    swapBuffers();
+@endcode
+
 @see @ref Context, @ref TextureSwapChain, @ref Compositor
 */
 class MAGNUM_OVRINTEGRATION_EXPORT Session {
@@ -338,8 +551,31 @@ class MAGNUM_OVRINTEGRATION_EXPORT Session {
         /**
          * @brief Get preferred size for textures used for rendering to this HMD
          * @param eye       Eye index to get the texture size for
+         * @param pixelDensity  Ratio of render target pixels to display
+         *      pixels in the center of the eye field of view
+         *
+         * With @p pixelDensity above @cpp 1.0f @ce the texture is
+         * supersampled, below @cpp 1.0f @ce it's rendered at a lower
+         * resolution. When using dynamic resolution, allocate the texture
+         * with the largest density the application ever needs and scale
+         * just the viewports via @ref scaleViewport().
+         */
+        Vector2i fovTextureSize(Int eye, Float pixelDensity = 1.0f);
+
+        /**
+         * @brief Get preferred size for a texture shared by both eyes
+         * @param pixelDensity  Ratio of render target pixels to display
+         *      pixels, see @ref fovTextureSize() for details
+         * @m_since_latest_{integration}
+         *
+         * Size of a texture that fits the @ref fovTextureSize() of both eyes
+         * side by side, with the left eye in the left half and the right eye
+         * in the right half. Both halves have the same size, which is the
+         * larger of the two preferred eye sizes.
+         * @see @ref createStereoTextureSwapChain(),
+         *      @ref LayerEyeFov::setSideBySideViewports()
          */
-        Vector2i fovTextureSize(Int eye);
+        Vector2i stereoTextureSize(Float pixelDensity = 1.0f);
 
         /**
          * @brief Create a mirror texture
@@ -362,13 +598,87 @@ class MAGNUM_OVRINTEGRATION_EXPORT Session {
          */
         std::unique_ptr<TextureSwapChain> createTextureSwapChain(Int eye);
 
+        /**
+         * @brief Blit the mirror texture to a framebuffer
+         * @param destination           Framebuffer to blit to, usually
+         *      @ref GL::defaultFramebuffer
+         * @param destinationRectangle  Area of the framebuffer to blit to
+         * @return @cpp true @ce if the mirror was blitted, @cpp false @ce
+         *      if it was skipped
+         * @m_since_latest_{integration}
+         *
+         * Expects that @ref createMirrorTexture() was called. Copies the
+         * mirror texture flipped to the destination using a framebuffer
+         * blit, with linear filtering if the sizes differ. The blit is
+         * skipped if the mirror is disabled with @ref setMirrorEnabled(),
+         * if @p destinationRectangle is empty, for example because the
+         * window is minimized, or if @ref currentFrameIndex() isn't a
+         * multiple of @ref mirrorInterval(). In that case the destination is
+         * left untouched and the application can skip swapping its buffers.
+         */
+        bool blitMirror(GL::AbstractFramebuffer& destination, const Range2Di& destinationRectangle);
+
+        /**
+         * @brief Whether the mirror is enabled
+         * @m_since_latest_{integration}
+         *
+         * Enabled by default.
+         * @see @ref blitMirror()
+         */
+        bool isMirrorEnabled() const { return _mirrorEnabled; }
+
+        /**
+         * @brief Enable or disable the mirror
+         * @return Reference to self (for method chaining)
+         * @m_since_latest_{integration}
+         *
+         * Disable the mirror for example while the window is minimized or
+         * occluded, so @ref blitMirror() doesn't waste GPU time.
+         */
+        Session& setMirrorEnabled(bool enabled) {
+            _mirrorEnabled = enabled;
+            return *this;
+        }
+
+        /**
+         * @brief Mirror interval
+         * @m_since_latest_{integration}
+         *
+         * Default is @cpp 1 @ce, i.e. mirroring every frame.
+         * @see @ref blitMirror()
+         */
+        UnsignedInt mirrorInterval() const { return _mirrorInterval; }
+
+        /**
+         * @brief Set mirror interval
+         * @return Reference to self (for method chaining)
+         * @m_since_latest_{integration}
+         *
+         * With @p interval set to @cpp n @ce, @ref blitMirror() blits only
+         * every @cpp n @ce-th frame. Expects that @p interval is not zero.
+         */
+        Session& setMirrorInterval(UnsignedInt interval);
+
         /**
          * @brief Create a @ref TextureSwapChain for this HMD
          * @param size      Size for the textures in the created set
+         * @param format    Texture format
          *
          * @see @ref createTextureSwapChain(Int)
          */
-        std::unique_ptr<TextureSwapChain> createTextureSwapChain(const Vector2i& size);
+        std::unique_ptr<TextureSwapChain> createTextureSwapChain(const Vector2i& size, TextureSwapChainFormat format = TextureSwapChainFormat::RGBA8Srgb);
+
+        /**
+         * @brief Create a @ref TextureSwapChain shared by both eyes
+         * @m_since_latest_{integration}
+         *
+         * Equivalent to calling @ref createTextureSwapChain(const Vector2i&)
+         * with @ref stereoTextureSize(). Use together with
+         * @ref LayerEyeFov::setColorTexture(const TextureSwapChain&) and
+         * @ref LayerEyeFov::setSideBySideViewports() to render both eyes in a
+         * single pass.
+         */
+        std::unique_ptr<TextureSwapChain> createStereoTextureSwapChain();
 
         /**
          * @brief Get the current tracked head pose as a PoseState.
@@ -410,11 +720,165 @@ class MAGNUM_OVRINTEGRATION_EXPORT Session {
                     PoseState::wrap(_trackingState.HandPoses[1])}};
         }
 
+        /**
+         * @brief Wait until a new frame can be started
+         * @return Reference to self (for method chaining)
+         * @m_since_latest_{integration}
+         *
+         * Blocks until the compositor is ready to accept a new frame with
+         * index @ref currentFrameIndex() and then updates the
+         * @ref predictedDisplayTime() for it, so a subsequent
+         * @ref pollTrackers() or @ref pollEyePoses() predicts the poses for
+         * the time the frame will be actually displayed. Should be called
+         * before any simulation work for the frame, followed by
+         * @ref beginFrame() immediately before rendering starts and
+         * @ref Compositor::endFrame() once the frame is rendered. Separating
+         * the wait from the compositor submission allows the CPU to
+         * simulate the next frame while the GPU still renders the previous
+         * one.
+         * @see @ref Compositor::submitFrame()
+         */
+        Session& waitToBeginFrame();
+
+        /**
+         * @brief Begin rendering a frame
+         * @return Reference to self (for method chaining)
+         * @m_since_latest_{integration}
+         *
+         * Tells the compositor that rendering of the frame with index
+         * @ref currentFrameIndex() starts. Has to be called after
+         * @ref waitToBeginFrame() and before any rendering into texture swap
+         * chains of the frame.
+         * @see @ref Compositor::endFrame()
+         */
+        Session& beginFrame();
+
+        /**
+         * @brief Predicted display time of the current frame
+         * @m_since_latest_{integration}
+         *
+         * Absolute time in seconds at which the frame with index
+         * @ref currentFrameIndex() is predicted to be displayed, as queried by
+         * the last @ref waitToBeginFrame() or @ref pollTrackers() call.
+         */
+        Double predictedDisplayTime() const { return _predictedDisplayTime; }
+
+        /**
+         * @brief Time at which the eye poses were sampled
+         * @m_since_latest_{integration}
+         *
+         * Absolute time in seconds at which the last @ref pollEyePoses() call
+         * sampled the tracking state. Passed to the compositor by
+         * @ref LayerEyeFov::setRenderPoses() to calculate the motion-to-photon
+         * latency.
+         */
+        Double sensorSampleTime() const { return _sensorSampleTime; }
+
+        /**
+         * @brief Update the dynamic resolution scale
+         * @return Reference to self (for method chaining)
+         * @m_since_latest_{integration}
+         *
+         * Calls @ref pollPerformanceStats() and adjusts
+         * @ref resolutionScale() by the GPU performance scale
+         * recommended by the compositor, clamped to the range between
+         * @ref minResolutionScale() and @cpp 1.0f @ce. As the scale is
+         * applied to both viewport dimensions, the pixel count changes with
+         * the square of it. If no frames were rendered since the last call,
+         * the scale is left unchanged. Call once per frame, for example right
+         * after @ref waitToBeginFrame(), and pass the viewports through
+         * @ref scaleViewport():
+         *
+         * @code{.cpp}
+         * // allocated once at the maximal size
+         * std::unique_ptr<TextureSwapChain> swapChain =
+         *     session.createStereoTextureSwapChain();
+         * const Vector2i size = session.stereoTextureSize();
+         *
+         * // every frame
+         * session.waitToBeginFrame()
+         *        .updateResolutionScale();
+         * const Range2Di left = session.scaleViewport({{}, {size.x()/2, size.y()}});
+         * const Range2Di right = session.scaleViewport({{size.x()/2, 0}, size});
+         * layer.setViewport(0, left)
+         *      .setViewport(1, right);
+         * // ... render each eye into its viewport
+         * @endcode
+         */
+        Session& updateResolutionScale();
+
+        /**
+         * @brief Refresh cached performance statistics
+         * @return Reference to self (for method chaining)
+         * @m_since_latest_{integration}
+         *
+         * Use @ref performanceStats() to access the result. The statistics
+         * cover compositor frames since the previous call, so call this
+         * function once per frame and from a single place only. Called
+         * implicitly by @ref updateResolutionScale().
+         */
+        Session& pollPerformanceStats();
+
+        /**
+         * @brief Performance statistics since last @ref pollPerformanceStats() call
+         * @m_since_latest_{integration}
+         */
+        const PerformanceStats& performanceStats() const { return _performanceStats; }
+
+        /**
+         * @brief Dynamic resolution scale
+         * @m_since_latest_{integration}
+         *
+         * Initially @cpp 1.0f @ce.
+         * @see @ref updateResolutionScale(), @ref setResolutionScale()
+         */
+        Float resolutionScale() const { return _resolutionScale; }
+
+        /**
+         * @brief Set the dynamic resolution scale
+         * @return Reference to self (for method chaining)
+         * @m_since_latest_{integration}
+         *
+         * The value is clamped to the range between
+         * @ref minResolutionScale() and @cpp 1.0f @ce.
+         */
+        Session& setResolutionScale(Float scale);
+
+        /**
+         * @brief Minimal dynamic resolution scale
+         * @m_since_latest_{integration}
+         *
+         * Default is @cpp 0.5f @ce.
+         */
+        Float minResolutionScale() const { return _minResolutionScale; }
+
+        /**
+         * @brief Set the minimal dynamic resolution scale
+         * @return Reference to self (for method chaining)
+         * @m_since_latest_{integration}
+         *
+         * Expected to be in range @f$ (0, 1] @f$. The current
+         * @ref resolutionScale() is clamped to the new range.
+         */
+        Session& setMinResolutionScale(Float scale);
+
+        /**
+         * @brief Scale a viewport by the dynamic resolution scale
+         * @m_since_latest_{integration}
+         *
+         * Returns @p viewport with the same origin and size multiplied by
+         * @ref resolutionScale(), rounded to whole pixels.
+         * @see @ref LayerEyeFov::setViewport()
+         */
+        Range2Di scaleViewport(const Range2Di& viewport) const;
+
         /**
          * @brief Refresh cached tracking state
          * @return Reference to self (for method chaining)
          *
-         * Use @ref eyePoses() to access the result.
+         * Use @ref eyePoses() to access the result. Predicts the state for
+         * the @ref predictedDisplayTime() of the frame with index
+         * @ref currentFrameIndex().
          */
         Session& pollTrackers();
 
@@ -436,6 +900,81 @@ class MAGNUM_OVRINTEGRATION_EXPORT Session {
          */
         Session& pollController(ControllerType types, InputState& state);
 
+        /**
+         * @brief Refresh cached input state
+         * @param types Controller type to get the input state of
+         * @return Reference to self (for method chaining)
+         * @m_since_latest_{integration}
+         *
+         * Meant to be called once per frame. Moves the current
+         * @ref inputState() to @ref previousInputState() and queries a new
+         * one with @ref pollController(). Systems interested in input then
+         * read the cached snapshot and the change masks such as
+         * @ref pressedButtons() instead of querying the runtime each on
+         * their own:
+         *
+         * @code{.cpp}
+         * session.pollInput();
+         *
+         * // ... anywhere in the frame
+         * if(session.pressedButtons() & Button::A)
+         *     jump();
+         * @endcode
+         */
+        Session& pollInput(ControllerType types = ControllerType::Active);
+
+        /**
+         * @brief Input state since last @ref pollInput() call
+         * @m_since_latest_{integration}
+         */
+        const InputState& inputState() const { return _inputState; }
+
+        /**
+         * @brief Input state before last @ref pollInput() call
+         * @m_since_latest_{integration}
+         */
+        const InputState& previousInputState() const { return _previousInputState; }
+
+        /**
+         * @brief Buttons that changed state in last @ref pollInput() call
+         * @m_since_latest_{integration}
+         *
+         * Union of @ref pressedButtons() and @ref releasedButtons().
+         */
+        Buttons changedButtons() const;
+
+        /**
+         * @brief Buttons pressed in last @ref pollInput() call
+         * @m_since_latest_{integration}
+         */
+        Buttons pressedButtons() const;
+
+        /**
+         * @brief Buttons released in last @ref pollInput() call
+         * @m_since_latest_{integration}
+         */
+        Buttons releasedButtons() const;
+
+        /**
+         * @brief Touches that changed state in last @ref pollInput() call
+         * @m_since_latest_{integration}
+         *
+         * Union of @ref touchesBegan() and @ref touchesEnded().
+         */
+        Touches changedTouches() const;
+
+        /**
+         * @brief Touches that began in last @ref pollInput() call
+         * @m_since_latest_{integration}
+         */
+        Touches touchesBegan() const;
+
+        /**
+         * @brief Touches that ended in last @ref pollInput() call
+         * @m_since_latest_{integration}
+         */
+        Touches touchesEnded() const;
+
         /** @brief Resolution of the HMD's display */
         Vector2i resolution() const {
             return Vector2i(_hmdDesc.Resolution);
@@ -481,6 +1020,28 @@ class MAGNUM_OVRINTEGRATION_EXPORT Session {
          */
         Matrix4 orthoSubProjectionMatrix(Int eye, const Matrix4& proj, const Vector2& scale, Float distance) const;
 
+        /**
+         * @brief Get view projection matrices for both eyes
+         * @param near      Distance to near frustum plane
+         * @param far       Distance to far frustum plane
+         * @m_since_latest_{integration}
+         *
+         * Combines @ref projectionMatrix() of each eye with the inverse of
+         * its pose since the last @ref pollEyePoses() call. The matrices are
+         * contiguous and match the std140 layout of a @glsl mat4[2] @ce
+         * uniform block member, so they can be uploaded to a uniform buffer
+         * directly and indexed using for example @glsl gl_InstanceID % 2 @ce
+         * for instanced stereo or @glsl gl_ViewID_OVR @ce with the
+         * @gl_extension{OVR,multiview} extension:
+         *
+         * @code{.cpp}
+         * std::array<Matrix4, 2> viewProjections =
+         *     session.pollEyePoses().viewProjectionMatrices(0.001f, 100.0f);
+         * uniforms.setSubData(0, Containers::arrayView(viewProjections.data(), 2));
+         * @endcode
+         */
+        std::array<Matrix4, 2> viewProjectionMatrices(Float near, Float far) const;
+
         /** @brief Get the underlying `ovrSession` */
         ::ovrSession ovrSession() const { return _session; }
 
@@ -581,7 +1142,7 @@ class MAGNUM_OVRINTEGRATION_EXPORT Session {
          * @brief Increment the frame index
          *
          * Returns the previous index value. This method is called by
-         * @ref Compositor::submitFrame().
+         * @ref Compositor::submitFrame() and @ref Compositor::endFrame().
          */
         Long incFrameIndex() {
             return _frameIndex++;
@@ -678,12 +1239,20 @@ class MAGNUM_OVRINTEGRATION_EXPORT Session {
         ::ovrViewScaleDesc _viewScale;
 
         Double _predictedDisplayTime;
+        Double _sensorSampleTime;
+        Float _resolutionScale;
+        Float _minResolutionScale;
+        PerformanceStats _performanceStats;
+        InputState _inputState, _previousInputState;
         ovrTrackingState _trackingState;
 
         Long _frameIndex;
 
         ovrMirrorTexture _ovrMirrorTexture;
         std::unique_ptr<GL::Texture2D> _mirrorTexture;
+        std::unique_ptr<GL::Framebuffer> _mirrorFramebuffer;
+        UnsignedInt _mirrorInterval;
+        bool _mirrorEnabled;
 
         Implementation::HmdStatusFlags _flags;
 };
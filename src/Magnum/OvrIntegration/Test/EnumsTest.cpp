@@ -51,6 +51,7 @@ struct EnumTest: TestSuite::Tester {
     void performanceHudMode();
     void debugHudStereoMode();
     void layerHudMode();
+    void textureSwapChainFormat();
     void errorType();
     void detectResult();
     void sessionStatusFlag();
@@ -68,6 +69,7 @@ EnumTest::EnumTest() {
               &EnumTest::performanceHudMode,
               &EnumTest::debugHudStereoMode,
               &EnumTest::layerHudMode,
+              &EnumTest::textureSwapChainFormat,
               &EnumTest::errorType,
               &EnumTest::detectResult,
               &EnumTest::sessionStatusFlag});
@@ -192,6 +194,16 @@ void EnumTest::layerHudMode() {
     CORRADE_COMPARE(out, "OvrIntegration::LayerHudMode::(invalid)\n");
 }
 
+void EnumTest::textureSwapChainFormat() {
+    Containers::String out;
+    Debug(&out) << TextureSwapChainFormat::Depth24Stencil8;
+    CORRADE_COMPARE(out, "OvrIntegration::TextureSwapChainFormat::Depth24Stencil8\n");
+
+    out = {};
+    Debug(&out) << TextureSwapChainFormat(-1);
+    CORRADE_COMPARE(out, "OvrIntegration::TextureSwapChainFormat::(invalid)\n");
+}
+
 void EnumTest::errorType() {
     Containers::String out;
     Debug(&out) << ErrorType::LeakingResources;
@@ -0,0 +1,300 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <chrono>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/String.h>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/Utility/Arguments.h>
+#include <Corrade/Utility/Format.h>
+#include <Corrade/Utility/Path.h>
+#include <Magnum/GL/Context.h>
+#include <Magnum/GL/Extensions.h>
+#include <Magnum/GL/Framebuffer.h>
+#include <Magnum/GL/OpenGLTester.h>
+#include <Magnum/GL/Renderbuffer.h>
+#include <Magnum/GL/RenderbufferFormat.h>
+#include <Magnum/GL/TimeQuery.h>
+#include <Magnum/Math/Functions.h>
+#include <Magnum/Math/Range.h>
+
+#include "Magnum/OvrIntegration/Compositor.h"
+#include "Magnum/OvrIntegration/Context.h"
+#include "Magnum/OvrIntegration/Session.h"
+
+namespace Magnum { namespace OvrIntegration { namespace Test { namespace {
+
+/* Needs a connected HMD, otherwise all cases are skipped. Meant to be run
+   manually as an acceptance test for new hardware, optionally with
+   --ovr-histogram-file to save the frame timing histograms to a CSV file. */
+struct FramePacingGLBenchmark: GL::OpenGLTester {
+    explicit FramePacingGLBenchmark();
+
+    void setup();
+    void teardown();
+
+    void cpuFrame();
+    void gpuEye();
+    void framePacing();
+
+    void timeQueryBegin();
+    std::uint64_t timeQueryEnd();
+
+    private:
+        void renderEye(Int eye);
+
+        Containers::Optional<Context> _context;
+        std::unique_ptr<Session> _session;
+        std::unique_ptr<TextureSwapChain> _swapChain[2];
+        Vector2i _textureSize[2];
+        LayerEyeFov* _layer{};
+        GL::Renderbuffer _depth{NoCreate};
+        GL::Framebuffer _framebuffer{NoCreate};
+        GL::TimeQuery _timeQuery{NoCreate};
+        Containers::String _histogramFile;
+};
+
+constexpr UnsignedInt FrameCount = 900;
+constexpr UnsignedInt HistogramBinCount = 64;
+constexpr Float HistogramBinSize = 0.5f;
+/* Has to be larger than the count of frames the compositor can report stats
+   for at once */
+constexpr UnsignedInt FrameHistory = 4*ovrMaxProvidedFrameStats;
+
+struct Histogram {
+    explicit Histogram(const char* name, Float min): name{name}, min{min} {}
+
+    void add(Float milliseconds) {
+        const Int bin = Int(Math::floor((milliseconds - min)/HistogramBinSize));
+        ++counts[Math::clamp(bin, 0, Int(HistogramBinCount) - 1)];
+        sum += milliseconds;
+        ++count;
+    }
+
+    Double mean() const { return count ? sum/count : 0.0; }
+
+    const char* name;
+    Float min;
+    UnsignedInt counts[HistogramBinCount]{};
+    Double sum{};
+    UnsignedInt count{};
+};
+
+const char* EyeNames[]{"left eye", "right eye"};
+
+FramePacingGLBenchmark::FramePacingGLBenchmark(): GL::OpenGLTester{TesterConfiguration{}.setSkippedArgumentPrefixes({"ovr"})} {
+    Utility::Arguments args{"ovr"};
+    args.addOption("histogram-file").setHelp("histogram-file", "save frame timing histograms to a CSV file", "PATH")
+        .parse(arguments().first, arguments().second);
+    _histogramFile = args.value<Containers::String>("histogram-file");
+
+    addBenchmarks({&FramePacingGLBenchmark::cpuFrame}, 100,
+        &FramePacingGLBenchmark::setup,
+        &FramePacingGLBenchmark::teardown);
+
+    addCustomInstancedBenchmarks({&FramePacingGLBenchmark::gpuEye}, 100,
+        Containers::arraySize(EyeNames),
+        &FramePacingGLBenchmark::setup,
+        &FramePacingGLBenchmark::teardown,
+        &FramePacingGLBenchmark::timeQueryBegin,
+        &FramePacingGLBenchmark::timeQueryEnd,
+        BenchmarkUnits::Nanoseconds);
+
+    addTests({&FramePacingGLBenchmark::framePacing},
+        &FramePacingGLBenchmark::setup,
+        &FramePacingGLBenchmark::teardown);
+}
+
+void FramePacingGLBenchmark::setup() {
+    _context.emplace();
+    _session = _context->createSession();
+    if(!_session) return;
+
+    _session->configureRendering();
+
+    _layer = &_context->compositor().addLayerEyeFov();
+    _layer->setFov(*_session);
+    for(Int eye = 0; eye != 2; ++eye) {
+        _textureSize[eye] = _session->fovTextureSize(eye);
+        _swapChain[eye] = _session->createTextureSwapChain(_textureSize[eye]);
+        _layer->setColorTexture(eye, *_swapChain[eye])
+               .setViewport(eye, {{}, _textureSize[eye]});
+    }
+
+    const Vector2i size = Math::max(_textureSize[0], _textureSize[1]);
+    _depth = GL::Renderbuffer{};
+    _depth.setStorage(GL::RenderbufferFormat::DepthComponent24, size);
+    _framebuffer = GL::Framebuffer{{{}, size}};
+    _framebuffer.attachRenderbuffer(GL::Framebuffer::BufferAttachment::Depth, _depth);
+}
+
+void FramePacingGLBenchmark::teardown() {
+    _framebuffer = GL::Framebuffer{NoCreate};
+    _depth = GL::Renderbuffer{NoCreate};
+    /* The swap chains reference the session, destroy them first */
+    for(std::unique_ptr<TextureSwapChain>& swapChain: _swapChain)
+        swapChain = nullptr;
+    _layer = nullptr;
+    _session = nullptr;
+    _context = Containers::NullOpt;
+}
+
+void FramePacingGLBenchmark::timeQueryBegin() {
+    _timeQuery = GL::TimeQuery{GL::TimeQuery::Target::TimeElapsed};
+    _timeQuery.begin();
+}
+
+std::uint64_t FramePacingGLBenchmark::timeQueryEnd() {
+    _timeQuery.end();
+    return _timeQuery.result<UnsignedLong>();
+}
+
+void FramePacingGLBenchmark::renderEye(const Int eye) {
+    /* Only a clear, so the measured times are the runtime and compositor
+       overhead of a minimal frame */
+    _framebuffer
+        .attachTexture(GL::Framebuffer::ColorAttachment{0}, _swapChain[eye]->activeTexture(), 0)
+        .setViewport({{}, _textureSize[eye]})
+        .clear(GL::FramebufferClear::Color|GL::FramebufferClear::Depth);
+    _swapChain[eye]->commit();
+}
+
+void FramePacingGLBenchmark::cpuFrame() {
+    if(!_session) CORRADE_SKIP("No HMD connected.");
+
+    /* Waiting for the compositor isn't included, only the time from polling
+       the poses to submitting the frame */
+    _session->waitToBeginFrame();
+
+    CORRADE_BENCHMARK(1) {
+        _session->pollEyePoses()
+            .beginFrame();
+        renderEye(0);
+        renderEye(1);
+        _layer->setRenderPoses(*_session);
+        _context->compositor().endFrame(*_session);
+    }
+}
+
+void FramePacingGLBenchmark::gpuEye() {
+    const Int eye = testCaseInstanceId();
+    setTestCaseDescription(EyeNames[eye]);
+
+    if(!_session) CORRADE_SKIP("No HMD connected.");
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::timer_query>())
+        CORRADE_SKIP(GL::Extensions::ARB::timer_query::string() << "is not supported.");
+
+    _session->waitToBeginFrame()
+        .pollEyePoses()
+        .beginFrame();
+
+    CORRADE_BENCHMARK(1)
+        renderEye(eye);
+
+    renderEye(1 - eye);
+    _layer->setRenderPoses(*_session);
+    _context->compositor().endFrame(*_session);
+}
+
+void FramePacingGLBenchmark::framePacing() {
+    if(!_session) CORRADE_SKIP("No HMD connected.");
+
+    Histogram cpuTime{"cpu-frame-time", 0.0f};
+    Histogram gpuTime{"app-gpu-time", 0.0f};
+    Histogram latency{"motion-to-photon-latency", 0.0f};
+    /* The prediction can be both too early and too late */
+    Histogram predictionError{"prediction-error", -HistogramBinCount*HistogramBinSize*0.5f};
+
+    struct {
+        Long frameIndex;
+        Double predictedDisplayTime;
+        Double sensorSampleTime;
+    } timings[FrameHistory]{};
+
+    /* Discard statistics of frames before the measurement */
+    _session->pollPerformanceStats();
+    Int firstDroppedFrameCount = -1;
+    Int lastDroppedFrameCount = 0;
+
+    for(UnsignedInt i = 0; i != FrameCount; ++i) {
+        const Long frameIndex = _session->currentFrameIndex();
+        _session->waitToBeginFrame();
+
+        const auto start = std::chrono::steady_clock::now();
+        _session->pollEyePoses()
+            .beginFrame();
+        renderEye(0);
+        renderEye(1);
+        _layer->setRenderPoses(*_session);
+        _context->compositor().endFrame(*_session);
+        cpuTime.add(std::chrono::duration<Float, std::milli>(std::chrono::steady_clock::now() - start).count());
+
+        auto& timing = timings[frameIndex % FrameHistory];
+        timing.frameIndex = frameIndex;
+        timing.predictedDisplayTime = _session->predictedDisplayTime();
+        timing.sensorSampleTime = _session->sensorSampleTime();
+
+        /* The statistics arrive only once the compositor shows the frame,
+           i.e. a few frames later */
+        const PerformanceStats& stats = _session->pollPerformanceStats().performanceStats();
+        for(Int j = 0; j != stats.frameStatsCount(); ++j) {
+            const CompositorFrameStats& frame = stats.frameStats(j);
+            gpuTime.add(frame.appGpuElapsedTime()*1000.0f);
+            latency.add(frame.appMotionToPhotonLatency()*1000.0f);
+
+            /* The photons hit the display motion-to-photon latency after the
+               poses were sampled, compare that to the prediction */
+            const auto& frameTiming = timings[frame.appFrameIndex() % FrameHistory];
+            if(frameTiming.frameIndex == frame.appFrameIndex() && frameTiming.sensorSampleTime != 0.0)
+                predictionError.add(Float((frameTiming.sensorSampleTime + frame.appMotionToPhotonLatency() - frameTiming.predictedDisplayTime)*1000.0));
+        }
+
+        /* The dropped frame count is cumulative, frame index 0 is the most
+           recent */
+        if(stats.frameStatsCount()) {
+            lastDroppedFrameCount = stats.frameStats(0).appDroppedFrameCount();
+            if(firstDroppedFrameCount == -1)
+                firstDroppedFrameCount = stats.frameStats(stats.frameStatsCount() - 1).appDroppedFrameCount();
+        }
+    }
+
+    CORRADE_INFO("Dropped" << (firstDroppedFrameCount == -1 ? 0 : lastDroppedFrameCount - firstDroppedFrameCount) << "of" << FrameCount << "frames");
+    for(const Histogram* histogram: {&cpuTime, &gpuTime, &latency, &predictionError})
+        CORRADE_INFO("Mean" << histogram->name << Debug::nospace << ":" << histogram->mean() << "ms over" << histogram->count << "samples");
+
+    if(!_histogramFile.isEmpty()) {
+        Containers::String csv = "histogram,bin_start_ms,count\n";
+        for(const Histogram* histogram: {&cpuTime, &gpuTime, &latency, &predictionError})
+            for(UnsignedInt bin = 0; bin != HistogramBinCount; ++bin)
+                csv = csv + Utility::format("{},{},{}\n", histogram->name, histogram->min + bin*HistogramBinSize, histogram->counts[bin]);
+        CORRADE_VERIFY(Utility::Path::write(_histogramFile, Containers::ArrayView<const char>{csv.data(), csv.size()}));
+        CORRADE_INFO("Histograms saved to" << _histogramFile);
+    }
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::OvrIntegration::Test::FramePacingGLBenchmark)
@@ -0,0 +1,108 @@
+#
+#   This file is part of Magnum.
+#
+#   Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+#               2020, 2021, 2022, 2023, 2024, 2025
+#             Vladimír Vondruš <mosra@centrum.cz>
+#
+#   Permission is hereby granted, free of charge, to any person obtaining a
+#   copy of this software and associated documentation files (the "Software"),
+#   to deal in the Software without restriction, including without limitation
+#   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+#   and/or sell copies of the Software, and to permit persons to whom the
+#   Software is furnished to do so, subject to the following conditions:
+#
+#   The above copyright notice and this permission notice shall be included
+#   in all copies or substantial portions of the Software.
+#
+#   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+#   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+#   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+#   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+#   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+#   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+#   DEALINGS IN THE SOFTWARE.
+#
+
+# Runs benchmark executables and converts the Corrade TestSuite benchmark
+# output into CSV and JSON files that can be diffed across releases. Invoked
+# by the MagnumIntegrationBenchmarkResults target, or directly as
+#
+#   cmake -DBENCHMARK_LIST=<file> -DOUTPUT_DIR=<dir> [-DARGUMENTS=<args>] \
+#       -P BenchmarkResults.cmake
+#
+# where BENCHMARK_LIST is a file with one `name=path/to/executable` per line
+# and ARGUMENTS is a semicolon-separated list of extra arguments passed to
+# each executable, such as `--benchmark;cpu-time`. Raw output of each
+# benchmark is saved to OUTPUT_DIR/<name>.log, the parsed results to
+# OUTPUT_DIR/results.csv and OUTPUT_DIR/results.json.
+
+if(NOT BENCHMARK_LIST OR NOT OUTPUT_DIR)
+    message(FATAL_ERROR "BenchmarkResults.cmake: BENCHMARK_LIST and OUTPUT_DIR have to be set")
+endif()
+
+file(MAKE_DIRECTORY ${OUTPUT_DIR})
+file(STRINGS ${BENCHMARK_LIST} _benchmarks)
+
+set(_csv "benchmark,test_case,mean,stddev,unit,iterations,batch_size,measurement\n")
+set(_json )
+set(_failed )
+foreach(_benchmark ${_benchmarks})
+    if(NOT _benchmark MATCHES "^([^=]+)=(.+)$")
+        continue()
+    endif()
+    set(_name ${CMAKE_MATCH_1})
+    set(_executable ${CMAKE_MATCH_2})
+
+    message(STATUS "Running ${_name}")
+    # Colors would put escape sequences into the output, making it harder to
+    # parse
+    execute_process(COMMAND ${_executable} --color off ${ARGUMENTS}
+        OUTPUT_VARIABLE _output
+        ERROR_VARIABLE _output
+        RESULT_VARIABLE _result)
+    file(WRITE ${OUTPUT_DIR}/${_name}.log "${_output}")
+    if(NOT _result EQUAL 0)
+        list(APPEND _failed ${_name})
+    endif()
+
+    # The output is turned into a list, so escape any semicolons first
+    string(REPLACE ";" "\;" _output "${_output}")
+    string(REPLACE "\r" "" _output "${_output}")
+    string(REPLACE "\n" ";" _lines "${_output}")
+    foreach(_line ${_lines})
+        # The format is
+        #   BENCH [01]   1.59 ± 0.03   ns name(description)@9x1000000 (wall time)
+        # where the description is present only for instanced test cases
+        if(NOT _line MATCHES "^ *BENCH \\[ *[0-9]+\\] +([0-9.e+-]+) ± ([0-9.e+-]+) +([^ ]+) (.+)@([0-9]+)x([0-9]+) \\((.+)\\)$")
+            continue()
+        endif()
+        set(_mean ${CMAKE_MATCH_1})
+        set(_stddev ${CMAKE_MATCH_2})
+        set(_unit ${CMAKE_MATCH_3})
+        set(_case "${CMAKE_MATCH_4}")
+        set(_iterations ${CMAKE_MATCH_5})
+        set(_batch ${CMAKE_MATCH_6})
+        set(_measurement "${CMAKE_MATCH_7}")
+
+        string(REPLACE "\"" "\"\"" _csvCase "${_case}")
+        string(APPEND _csv "${_name},\"${_csvCase}\",${_mean},${_stddev},${_unit},${_iterations},${_batch},${_measurement}\n")
+
+        string(REPLACE "\\" "\\\\" _jsonCase "${_case}")
+        string(REPLACE "\"" "\\\"" _jsonCase "${_jsonCase}")
+        if(_json)
+            string(APPEND _json ",\n")
+        endif()
+        string(APPEND _json "  {\"benchmark\": \"${_name}\", \"test_case\": \"${_jsonCase}\", \"mean\": ${_mean}, \"stddev\": ${_stddev}, \"unit\": \"${_unit}\", \"iterations\": ${_iterations}, \"batch_size\": ${_batch}, \"measurement\": \"${_measurement}\"}")
+    endforeach()
+endforeach()
+
+file(WRITE ${OUTPUT_DIR}/results.csv "${_csv}")
+file(WRITE ${OUTPUT_DIR}/results.json "[\n${_json}\n]\n")
+message(STATUS "Benchmark results written to ${OUTPUT_DIR}")
+
+# Not fatal, a GL benchmark failing due to a missing context shouldn't
+# prevent the results of the others from being saved
+if(_failed)
+    message(WARNING "Some benchmarks failed, see their logs in ${OUTPUT_DIR}: ${_failed}")
+endif()
@@ -0,0 +1,81 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/String.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/instrumentationIntegration.h"
+
+namespace Magnum { namespace Test { namespace {
+
+struct InstrumentationTest: TestSuite::Tester {
+    explicit InstrumentationTest();
+
+    void config();
+    void zones();
+};
+
+InstrumentationTest::InstrumentationTest() {
+    addTests({&InstrumentationTest::config,
+              &InstrumentationTest::zones});
+}
+
+void InstrumentationTest::config() {
+    bool included =
+        #ifdef Magnum_Test_InstrumentationTestConfig_h
+        true
+        #else
+        false
+        #endif
+        ;
+    CORRADE_FAIL_IF(!included, "InstrumentationTestConfig.h not included");
+}
+
+void InstrumentationTest::zones() {
+    Containers::String out;
+    {
+        Debug redirectOutput{&out};
+        MAGNUM_INTEGRATION_CPU_ZONE("outer");
+        {
+            MAGNUM_INTEGRATION_CPU_ZONE("inner");
+            MAGNUM_INTEGRATION_GPU_ZONE("draw");
+            Debug{} << "work";
+        }
+    }
+    CORRADE_COMPARE(out,
+        "begin CPU outer\n"
+        "begin CPU inner\n"
+        "begin GPU draw\n"
+        "work\n"
+        "end GPU draw\n"
+        "end CPU inner\n"
+        "end CPU outer\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Test::InstrumentationTest)
@@ -0,0 +1,51 @@
+#ifndef Magnum_Test_InstrumentationTestConfig_h
+#define Magnum_Test_InstrumentationTestConfig_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/* This gets included via MAGNUM_INTEGRATION_INSTRUMENTATION_CONFIG (passed
+   via CMake) to InstrumentationTest.cpp, which then verifies the zones are
+   entered and left in the right order */
+
+#include <Corrade/Utility/Debug.h>
+
+struct InstrumentationTestZone {
+    explicit InstrumentationTestZone(const char* type, const char* name): type{type}, name{name} {
+        Corrade::Utility::Debug{} << "begin" << type << name;
+    }
+
+    ~InstrumentationTestZone() {
+        Corrade::Utility::Debug{} << "end" << type << name;
+    }
+
+    const char* type;
+    const char* name;
+};
+
+#define MAGNUM_INTEGRATION_CPU_ZONE(name) InstrumentationTestZone _cpuZone{"CPU", name}
+#define MAGNUM_INTEGRATION_GPU_ZONE(name) InstrumentationTestZone _gpuZone{"GPU", name}
+
+#endif
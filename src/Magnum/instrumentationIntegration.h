@@ -0,0 +1,127 @@
+#ifndef Magnum_instrumentationIntegration_h
+#define Magnum_instrumentationIntegration_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Macro @ref MAGNUM_INTEGRATION_CPU_ZONE(), @ref MAGNUM_INTEGRATION_GPU_ZONE()
+ * @m_since_latest_{integration}
+ *
+ * Instrumentation hooks shared by all integration libraries. Hot paths such as
+ * @ref Magnum::ImGuiIntegration::Context::drawFrame() "ImGuiIntegration::Context::drawFrame()",
+ * @ref Magnum::BulletIntegration::DebugDraw::flushLines() "BulletIntegration::DebugDraw::flushLines()",
+ * @ref Magnum::DartIntegration::World::refresh() "DartIntegration::World::refresh()"
+ * or @ref Magnum::OvrIntegration::Compositor::submitFrame() "OvrIntegration::Compositor::submitFrame()"
+ * are wrapped in CPU and GPU zones, which are by default compiled out to
+ * nothing.
+ *
+ * To enable them, point the `MAGNUM_INSTRUMENTATION_CONFIG` CMake option to a
+ * header that defines @ref MAGNUM_INTEGRATION_CPU_ZONE() and
+ * @ref MAGNUM_INTEGRATION_GPU_ZONE(). It gets included via the
+ * `MAGNUM_INTEGRATION_INSTRUMENTATION_CONFIG` preprocessor macro when building
+ * all the libraries, so all of them report to the same profiler. Any include
+ * paths and libraries the header needs have to be supplied to the library
+ * targets as well. For example, with [Tracy](https://github.com/wolfpld/tracy):
+ *
+ * @code{.cpp}
+ * #include <tracy/Tracy.hpp>
+ * #include <tracy/TracyOpenGL.hpp>
+ *
+ * #define MAGNUM_INTEGRATION_CPU_ZONE(name) ZoneScopedN(name)
+ * #define MAGNUM_INTEGRATION_GPU_ZONE(name) TracyGpuZone(name)
+ * @endcode
+ *
+ * A simple in-process collector can be implemented with RAII types, measuring
+ * CPU zones with @ref std::chrono::steady_clock and GPU zones with
+ * @ref Magnum::GL::TimeQuery "GL::TimeQuery". As time elapsed queries can't be
+ * nested, the GPU zones are placed only around code that doesn't call into
+ * other instrumented code. The zone in
+ * @ref Magnum::ImGuiIntegration::Context::drawFrame() "ImGuiIntegration::Context::drawFrame()"
+ * is omitted if @ref Magnum::ImGuiIntegration::Context::Flag::GpuTimeQuery "ImGuiIntegration::Context::Flag::GpuTimeQuery"
+ * is set, as the context measures the time with its own query in that case.
+ * Time elapsed queries issued by the application itself around
+ * integration library calls have to be avoided as well.
+ *
+ * @code{.cpp}
+ * #include <Magnum/GL/TimeQuery.h>
+ *
+ * namespace MyProfiler {
+ *     struct CpuZone {
+ *         explicit CpuZone(const char* name);
+ *         ~CpuZone(); // records the time elapsed since construction
+ *         // ...
+ *     };
+ *
+ *     struct GpuZone {
+ *         explicit GpuZone(const char* name);
+ *         ~GpuZone(); // ends the query, reads the result a few frames later
+ *         Magnum::GL::TimeQuery query;
+ *         // ...
+ *     };
+ * }
+ *
+ * #define MAGNUM_INTEGRATION_CPU_ZONE(name) MyProfiler::CpuZone _myProfilerCpuZone{name}
+ * #define MAGNUM_INTEGRATION_GPU_ZONE(name) MyProfiler::GpuZone _myProfilerGpuZone{name}
+ * @endcode
+ */
+
+#ifdef MAGNUM_INTEGRATION_INSTRUMENTATION_CONFIG
+#include MAGNUM_INTEGRATION_INSTRUMENTATION_CONFIG
+#endif
+
+#if !defined(MAGNUM_INTEGRATION_CPU_ZONE) || defined(DOXYGEN_GENERATING_OUTPUT)
+/**
+@brief CPU instrumentation zone
+@param name         Zone name, a string literal
+@m_since_latest_{integration}
+
+Measures the CPU time spent from the point of the macro to the end of the
+enclosing scope. Expands to nothing, unless defined by a header supplied via
+`MAGNUM_INTEGRATION_INSTRUMENTATION_CONFIG`. Only one zone can be placed in a
+single scope.
+*/
+#define MAGNUM_INTEGRATION_CPU_ZONE(name)
+#endif
+
+#if !defined(MAGNUM_INTEGRATION_GPU_ZONE) || defined(DOXYGEN_GENERATING_OUTPUT)
+/**
+@brief GPU instrumentation zone
+@param name         Zone name, a string literal
+@m_since_latest_{integration}
+
+Measures the GPU time spent on commands issued from the point of the macro to
+the end of the enclosing scope. Expands to nothing, unless defined by a header
+supplied via `MAGNUM_INTEGRATION_INSTRUMENTATION_CONFIG`. Only one zone can be
+placed in a single scope. The integration libraries never nest GPU zones into
+each other, however a GPU zone may be omitted if the library issues its own
+time elapsed query in the same place, such as
+@ref Magnum::ImGuiIntegration::Context::drawFrame() "ImGuiIntegration::Context::drawFrame()"
+with @ref Magnum::ImGuiIntegration::Context::Flag::GpuTimeQuery "ImGuiIntegration::Context::Flag::GpuTimeQuery".
+*/
+#define MAGNUM_INTEGRATION_GPU_ZONE(name)
+#endif
+
+#endif